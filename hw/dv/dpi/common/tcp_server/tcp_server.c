@@ -15,6 +15,7 @@
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,12 +26,17 @@
 
 /**
  * Simple buffer for passing data between TCP sockets and DPI modules
+ *
+ * Each buffer has exactly one producer and one consumer, one of which is the
+ * server thread and the other the simulation thread that owns the DPI module.
+ * The producer only writes `wptr` and the consumer only writes `rptr`; the
+ * release/acquire pairs on them order the accesses to `buf`.
  */
 #define BUFSIZE_BYTE 256
 
 struct tcp_buf {
-  unsigned int rptr;
-  unsigned int wptr;
+  atomic_uint rptr;
+  atomic_uint wptr;
   char buf[BUFSIZE_BYTE];
 };
 
@@ -41,52 +47,50 @@ struct tcp_server_ctx {
   // Writeable by the host thread
   char *display_name;
   uint16_t listen_port;
-  volatile bool socket_run;
+  atomic_bool socket_run;
+  // Set by the host thread to ask the server thread to drop the client
+  atomic_bool client_close_req;
   // Writeable by the server thread
   struct tcp_buf *buf_in;
   struct tcp_buf *buf_out;
   int sfd;  // socket fd
   int cfd;  // client fd
   pthread_t sock_thread;
+  bool sock_thread_started;
 };
 
 static bool tcp_buffer_is_full(struct tcp_buf *buf) {
-  if (buf->wptr >= buf->rptr) {
-    return (buf->wptr - buf->rptr) == (BUFSIZE_BYTE - 1);
-  } else {
-    return (buf->rptr - buf->wptr) == 1;
-  }
-}
-
-static bool tcp_buffer_is_empty(struct tcp_buf *buf) {
-  return (buf->wptr == buf->rptr);
+  unsigned int wptr = atomic_load_explicit(&buf->wptr, memory_order_relaxed);
+  unsigned int rptr = atomic_load_explicit(&buf->rptr, memory_order_acquire);
+  return (wptr + 1) % BUFSIZE_BYTE == rptr;
 }
 
 static void tcp_buffer_put_byte(struct tcp_buf *buf, char dat) {
-  bool done = false;
-  while (!done) {
-    if (!tcp_buffer_is_full(buf)) {
-      buf->buf[buf->wptr++] = dat;
-      buf->wptr %= BUFSIZE_BYTE;
-      done = true;
-    }
+  // Spin until the consumer makes room.
+  while (tcp_buffer_is_full(buf)) {
   }
+  unsigned int wptr = atomic_load_explicit(&buf->wptr, memory_order_relaxed);
+  buf->buf[wptr] = dat;
+  atomic_store_explicit(&buf->wptr, (wptr + 1) % BUFSIZE_BYTE,
+                        memory_order_release);
 }
 
 static bool tcp_buffer_get_byte(struct tcp_buf *buf, char *dat) {
-  if (tcp_buffer_is_empty(buf)) {
+  unsigned int rptr = atomic_load_explicit(&buf->rptr, memory_order_relaxed);
+  if (rptr == atomic_load_explicit(&buf->wptr, memory_order_acquire)) {
     return false;
   }
-  *dat = buf->buf[buf->rptr++];
-  buf->rptr %= BUFSIZE_BYTE;
+  *dat = buf->buf[rptr];
+  atomic_store_explicit(&buf->rptr, (rptr + 1) % BUFSIZE_BYTE,
+                        memory_order_release);
   return true;
 }
 
 static struct tcp_buf *tcp_buffer_new(void) {
   struct tcp_buf *buf_new;
   buf_new = (struct tcp_buf *)malloc(sizeof(struct tcp_buf));
-  buf_new->rptr = 0;
-  buf_new->wptr = 0;
+  atomic_init(&buf_new->rptr, 0);
+  atomic_init(&buf_new->wptr, 0);
   return buf_new;
 }
 
@@ -99,7 +103,9 @@ static void tcp_buffer_free(struct tcp_buf **buf) {
  * Start a TCP server
  *
  * This function creates attempts to create a new TCP socket instance. The
- * socket is a non-blocking stream socket, with buffering disabled.
+ * socket is a non-blocking stream socket, with buffering disabled. If
+ * `listen_port` is 0, the kernel picks a free port, and `listen_port` is
+ * updated to match.
  *
  * @param ctx context object
  * @return 0 on success, -1 in case of an error
@@ -165,12 +171,55 @@ static int start(struct tcp_server_ctx *ctx) {
     return -1;
   }
 
+  // find out which port was bound, in case the kernel picked it
+  socklen_t addr_len = sizeof(addr);
+  rv = getsockname(sfd, (struct sockaddr *)&addr, &addr_len);
+  if (rv != 0) {
+    fprintf(stderr, "%s: Unable to get socket address: %s (%d)\n",
+            ctx->display_name, strerror(errno), errno);
+    return -1;
+  }
+  ctx->listen_port = ntohs(addr.sin_port);
+
   ctx->sfd = sfd;
   assert(ctx->sfd > 0);
 
   return 0;
 }
 
+/**
+ * Record the listening port in the rendezvous file, if there is one
+ *
+ * The file is named by the TCP_SERVER_RENDEZVOUS_ENV environment variable and
+ * gets one "tcp <display name> <port>" line per server.
+ *
+ * @param ctx context object
+ */
+static void publish_port(struct tcp_server_ctx *ctx) {
+  const char *path = getenv(TCP_SERVER_RENDEZVOUS_ENV);
+  if (path == NULL || *path == '\0') {
+    return;
+  }
+
+  char line[128];
+  int len = snprintf(line, sizeof(line), "tcp %s %d\n", ctx->display_name,
+                     ctx->listen_port);
+  assert(len > 0 && (size_t)len < sizeof(line));
+
+  // Servers may start concurrently; a single append keeps each line whole.
+  int fd = open(path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    fprintf(stderr, "%s: Unable to open rendezvous file %s: %s (%d)\n",
+            ctx->display_name, path, strerror(errno), errno);
+    return;
+  }
+  if (write(fd, line, (size_t)len) != len) {
+    fprintf(stderr, "%s: Unable to write rendezvous file %s: %s (%d)\n",
+            ctx->display_name, path, strerror(errno), errno);
+  }
+  close(fd);
+}
+
 /**
  * Accept an incoming connection from a client (nonblocking)
  *
@@ -219,6 +268,24 @@ static int client_tryaccept(struct tcp_server_ctx *ctx) {
   return 0;
 }
 
+/**
+ * Disconnect the current client, if any
+ *
+ * Only called from the server thread, which owns the client fd.
+ *
+ * @param ctx context object
+ */
+static void client_close(struct tcp_server_ctx *ctx) {
+  assert(ctx);
+
+  if (!ctx->cfd) {
+    return;
+  }
+
+  close(ctx->cfd);
+  ctx->cfd = 0;
+}
+
 /**
  * Stop the TCP server
  *
@@ -254,7 +321,7 @@ static bool get_byte(struct tcp_server_ctx *ctx, char *cmd) {
     } else if (errno == EBADF) {
       // Possibly client went away? Accept a new connection.
       fprintf(stderr, "%s: Client disappeared.\n", ctx->display_name);
-      tcp_server_client_close(ctx);
+      client_close(ctx);
       return false;
     } else {
       fprintf(stderr, "%s: Error while reading from client: %s (%d)\n",
@@ -280,7 +347,7 @@ static void put_byte(struct tcp_server_ctx *ctx, char cmd) {
         continue;
       } else if (errno == EPIPE) {
         printf("%s: Remote disconnected.\n", ctx->display_name);
-        tcp_server_client_close(ctx);
+        client_close(ctx);
         break;
       } else {
         fprintf(stderr, "%s: Error while writing to client: %s (%d)\n",
@@ -311,7 +378,7 @@ static void ctx_free(struct tcp_server_ctx *ctx) {
 }
 
 /**
- * Thread function to create a new server instance
+ * Thread function to run a started server instance
  *
  * @param ctx_void context object
  * @return Always returns NULL
@@ -320,20 +387,11 @@ static void *server_create(void *ctx_void) {
   // Cast to a server struct
   struct tcp_server_ctx *ctx = (struct tcp_server_ctx *)ctx_void;
   struct timeval timeout;
-
-  // Start the server
-  int rv = start(ctx);
-  if (rv != 0) {
-    fprintf(stderr, "%s: Unable to create TCP server on port %d\n",
-            ctx->display_name, ctx->listen_port);
-    goto err_cleanup_return;
-  }
-
-  // Initialise fd_set
+  int rv;
 
   // Start waiting for connection / data
   char xfer_data;
-  while (ctx->socket_run) {
+  while (atomic_load(&ctx->socket_run)) {
     // Initialise structure of fds
     fd_set read_fds;
     FD_ZERO(&read_fds);
@@ -362,7 +420,7 @@ static void *server_create(void *ctx_void) {
 
       printf("%s: Socket read failed, port: %d\n", ctx->display_name,
              ctx->listen_port);
-      tcp_server_client_close(ctx);
+      client_close(ctx);
     }
 
     // New connection
@@ -377,17 +435,23 @@ static void *server_create(void *ctx_void) {
       }
     }
 
+    // Take a close request before draining, so that all output written
+    // before the request is sent before the client is dropped.
+    bool close_req = atomic_exchange(&ctx->client_close_req, false);
+
     if (ctx->cfd != 0) {
       while (tcp_buffer_get_byte(ctx->buf_out, &xfer_data)) {
         put_byte(ctx, xfer_data);
       }
     }
-  }
 
-err_cleanup_return:
+    if (close_req) {
+      client_close(ctx);
+    }
+  }
 
   // Simulation done - clean up
-  tcp_server_client_close(ctx);
+  client_close(ctx);
   stop(ctx);
 
   return NULL;
@@ -411,22 +475,38 @@ struct tcp_server_ctx *tcp_server_create(const char *display_name,
   ctx->buf_out = buf_out;
 
   // Set up socket details
-  ctx->socket_run = true;
+  atomic_init(&ctx->socket_run, true);
+  atomic_init(&ctx->client_close_req, false);
   ctx->listen_port = listen_port;
   ctx->display_name = strdup(display_name);
   assert(ctx->display_name);
 
+  // Bind before returning so that the caller can report the port, even when
+  // the kernel picks it. Without a socket the server never receives anything.
+  if (start(ctx) != 0) {
+    fprintf(stderr, "%s: Unable to create TCP server on port %d\n",
+            ctx->display_name, listen_port);
+    return ctx;
+  }
+  publish_port(ctx);
+
   if (pthread_create(&ctx->sock_thread, NULL, server_create, (void *)ctx) !=
       0) {
     fprintf(stderr, "%s: Unable to create TCP socket thread\n",
             ctx->display_name);
+    stop(ctx);
     ctx_free(ctx);
-    free(ctx);
     return NULL;
   }
+  ctx->sock_thread_started = true;
   return ctx;
 }
 
+int tcp_server_port(const struct tcp_server_ctx *ctx) {
+  assert(ctx);
+  return ctx->sfd ? ctx->listen_port : -1;
+}
+
 bool tcp_server_read(struct tcp_server_ctx *ctx, char *dat) {
   return tcp_buffer_get_byte(ctx->buf_in, dat);
 }
@@ -437,18 +517,14 @@ void tcp_server_write(struct tcp_server_ctx *ctx, char dat) {
 
 void tcp_server_close(struct tcp_server_ctx *ctx) {
   // Shut down the socket thread
-  ctx->socket_run = false;
-  pthread_join(ctx->sock_thread, NULL);
+  atomic_store(&ctx->socket_run, false);
+  if (ctx->sock_thread_started) {
+    pthread_join(ctx->sock_thread, NULL);
+  }
   ctx_free(ctx);
 }
 
 void tcp_server_client_close(struct tcp_server_ctx *ctx) {
   assert(ctx);
-
-  if (!ctx->cfd) {
-    return;
-  }
-
-  close(ctx->cfd);
-  ctx->cfd = 0;
+  atomic_store(&ctx->client_close_req, true);
 }
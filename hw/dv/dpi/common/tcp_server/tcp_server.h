@@ -10,6 +10,10 @@
  *
  * This is intended to be used by simulation add-on DPI modules to provide
  * basic TCP socket communication between a host and simulated peripherals.
+ *
+ * Each server runs its own socket thread. The functions below may be called
+ * from any one simulation thread at a time per server, so a model driving a
+ * server from a single DPI call site is safe in a multi-threaded simulation.
  */
 
 #ifdef __cplusplus
@@ -21,6 +25,16 @@ extern "C" {
 
 struct tcp_server_ctx;
 
+/**
+ * Environment variable naming the simulation's rendezvous file
+ *
+ * If set, each server appends a line "tcp <display name> <port>" to the file
+ * once it is listening. Tools that run many simulations side by side can give
+ * each one its own file, start the servers on port 0 and read back the ports
+ * the kernel picked.
+ */
+#define TCP_SERVER_RENDEZVOUS_ENV "DPI_RENDEZVOUS_FILE"
+
 /**
  * Non-blocking read of a byte from a connected client
  *
@@ -44,13 +58,25 @@ void tcp_server_write(struct tcp_server_ctx *ctx, char dat);
 /**
  * Create a new TCP server instance
  *
- * @param display_name C string description of server
- * @param listen_port On which port the server should listen
+ * The server is listening by the time this returns. If it cannot listen, it
+ * reports the error and behaves as if no client ever connects.
+ *
+ * @param display_name C string description of server, without spaces
+ * @param listen_port On which port the server should listen, or 0 to let the
+ *                    kernel pick a free one
  * @return A pointer to the created context struct
  */
 struct tcp_server_ctx *tcp_server_create(const char *display_name,
                                          int listen_port);
 
+/**
+ * Get the port the server is listening on
+ *
+ * @param ctx tcp server context object
+ * @return The port, or -1 if the server could not listen
+ */
+int tcp_server_port(const struct tcp_server_ctx *ctx);
+
 /**
  * Shut down the server and free all reserved memory
  *
@@ -61,6 +87,9 @@ void tcp_server_close(struct tcp_server_ctx *ctx);
 /**
  * Instruct the server to disconnect a client
  *
+ * The server thread drops the client once the data already written with
+ * `tcp_server_write()` has been sent.
+ *
  * @param ctx tcp server context object
  */
 void tcp_server_client_close(struct tcp_server_ctx *ctx);
@@ -383,6 +383,8 @@ void *dmidpi_create(const char *display_name, int listen_port) {
   // Set up socket details
   ctx->sock = tcp_server_create(display_name, listen_port);
 
+  // The port differs from listen_port if that was 0.
+  int port = tcp_server_port(ctx->sock);
   printf(
       "\n"
       "JTAG: Virtual JTAG interface %s is listening on port %d. Use\n"
@@ -390,7 +392,7 @@ void *dmidpi_create(const char *display_name, int listen_port) {
       "  interface remote_bitbang\n"
       "  remote_bitbang_host localhost\n"
       "  remote_bitbang_port %d\n",
-      display_name, listen_port, listen_port);
+      display_name, port, port);
 
   return (void *)ctx;
 }
@@ -38,7 +38,14 @@ module dmidpi #(
   chandle ctx;
 
   initial begin
-    ctx = dmidpi_create(Name, ListenPort);
+    int port;
+
+    // The listening socket port can be customized at runtime; 0 lets the
+    // kernel pick a free one
+    port = ListenPort;
+    void'($value$plusargs("dmidpi_port=%0d", port));
+
+    ctx = dmidpi_create(Name, port);
   end
 
   final begin
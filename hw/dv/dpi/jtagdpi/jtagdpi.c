@@ -152,6 +152,8 @@ void *jtagdpi_create(const char *display_name, int listen_port,
 
   reset_jtag_signals(ctx, assert_srst != 0);
 
+  // The port differs from listen_port if that was 0.
+  int port = tcp_server_port(ctx->sock);
   printf(
       "\n"
       "JTAG: Virtual JTAG interface %s is listening on port %d. Use\n"
@@ -159,7 +161,7 @@ void *jtagdpi_create(const char *display_name, int listen_port,
       "  adapter driver remote_bitbang\n"
       "  remote_bitbang host localhost\n"
       "  remote_bitbang port %d\n",
-      display_name, listen_port, listen_port);
+      display_name, port, port);
 
   return (void *)ctx;
 }
@@ -37,7 +37,8 @@ module jtagdpi #(
 
     assert (ctx == null);
 
-    // The listening socket port can be customized at runtime
+    // The listening socket port can be customized at runtime; 0 lets the
+    // kernel pick a free one
     port = ListenPort;
     void'($value$plusargs("jtagdpi_port=%0d", port));
 
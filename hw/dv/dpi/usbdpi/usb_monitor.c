@@ -134,8 +134,12 @@ void usb_monitor_log(usb_monitor_ctx_t *ctx, const char *fmt, ...) {
 }
 
 #define DR_SIZE 128
-static char dr[DR_SIZE];
-char *pid_2data(int pid, unsigned char d0, unsigned char d1) {
+
+/**
+ * Describe a short packet in `dr`, which must hold at least DR_SIZE chars
+ */
+static const char *pid_2data(char *dr, int pid, unsigned char d0,
+                             unsigned char d1) {
   int comp_crc = CRC5((d1 & 7) << 8 | d0, 11);
   const char *crcok = (comp_crc == d1 >> 3) ? "OK" : "BAD";
 
@@ -267,9 +271,10 @@ void usb_monitor(usb_monitor_ctx_t *mon, int loglevel, uint32_t tick_bits,
       uint32_t pkt_crc16, comp_crc16;
 
       if (compact && mon->byte == 2) {
+        char dr[DR_SIZE];
         fprintf(mon->file, "mon: %8d -- %8d: (%c) SOP, PID %s, EOP\n",
                 mon->sopAt, tick_bits, mon->driver == M_HOST ? 'H' : 'D',
-                pid_2data(mon->lastpid, mon->bytes[0], mon->bytes[1]));
+                pid_2data(dr, mon->lastpid, mon->bytes[0], mon->bytes[1]));
       } else if (compact && mon->byte == 1) {
         fprintf(mon->file, "mon: %8d -- %8d: (%c) SOP, PID %s %02x EOP\n",
                 mon->sopAt, tick_bits, mon->driver == M_HOST ? 'H' : 'D',
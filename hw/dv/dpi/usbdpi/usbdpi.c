@@ -102,6 +102,30 @@ static void bus_reset(usbdpi_ctx_t *ctx) {
 static void usbdpi_data_callback(void *ctx_v, usbmon_data_type_t type,
                                  uint8_t d);
 
+/**
+ * Publish the diagnostic words read by usbdpi_diags()
+ *
+ * usbdpi_diags() runs in its own always block and may therefore be called from
+ * another simulation thread, so it only sees this snapshot.
+ */
+static void diags_publish(usbdpi_ctx_t *ctx) {
+  // Check for overflow, which would cause confusion in waveform interpretation.
+  assert(ctx->state <= 0xfU);
+  assert(ctx->hostSt <= 0x1fU);
+  assert(ctx->bus_state <= 0x3fU);
+  assert(ctx->step <= 0x7fU);
+
+  uint32_t diags[3];
+  diags[2] = usb_monitor_diags(ctx->mon);
+  diags[1] =
+      (ctx->step << 25) | (ctx->bus_state << 20) | (ctx->tick_bits >> 12);
+  diags[0] = (ctx->tick_bits << 20) | ((ctx->frame & 0x7ffU) << 9) |
+             ((ctx->hostSt & 0x1fU) << 4) | (ctx->state & 0xfU);
+  for (unsigned i = 0U; i < 3U; ++i) {
+    __atomic_store_n(&ctx->diags[i], diags[i], __ATOMIC_RELAXED);
+  }
+}
+
 /**
  * Create a USB DPI instance, returning a 'chandle' for later use
  */
@@ -137,6 +161,8 @@ void *usbdpi_create(const char *name, int loglevel) {
   // Prepare the transfer descriptors for use
   usb_transfer_setup(ctx);
 
+  diags_publish(ctx);
+
   return (void *)ctx;
 }
 
@@ -300,6 +326,8 @@ void usbdpi_device_to_host(void *ctx_void, const svBitVecVal *usb_d2p) {
         break;
     }
   }
+
+  diags_publish(ctx);
 }
 
 // Callback for USB data detection
@@ -1112,9 +1140,8 @@ uint32_t inv_driving(usbdpi_ctx_t *ctx, uint32_t d2p) {
   return ctx->driving ^ (P2D_DP | P2D_DN | P2D_D);
 }
 
-uint8_t usbdpi_host_to_device(void *ctx_void, const svBitVecVal *usb_d2p) {
-  usbdpi_ctx_t *ctx = (usbdpi_ctx_t *)ctx_void;
-  assert(ctx);
+static uint8_t host_to_device(usbdpi_ctx_t *ctx,
+                              const svBitVecVal *usb_d2p) {
   int d2p = usb_d2p[0];
   uint32_t last_driving = ctx->driving;
   int force_stat = 0;
@@ -1450,21 +1477,22 @@ uint8_t usbdpi_host_to_device(void *ctx_void, const svBitVecVal *usb_d2p) {
   return ctx->driving;
 }
 
+uint8_t usbdpi_host_to_device(void *ctx_void, const svBitVecVal *usb_d2p) {
+  usbdpi_ctx_t *ctx = (usbdpi_ctx_t *)ctx_void;
+  assert(ctx);
+  uint8_t driving = host_to_device(ctx, usb_d2p);
+  diags_publish(ctx);
+  return driving;
+}
+
 // Export some internal diagnostic state for visibility in waveforms
 void usbdpi_diags(void *ctx_void, svBitVecVal *diags) {
   usbdpi_ctx_t *ctx = (usbdpi_ctx_t *)ctx_void;
+  assert(ctx);
 
-  // Check for overflow, which would cause confusion in waveform interpretation.
-  assert(ctx->state <= 0xfU);
-  assert(ctx->hostSt <= 0x1fU);
-  assert(ctx->bus_state <= 0x3fU);
-  assert(ctx->step <= 0x7fU);
-
-  diags[2] = usb_monitor_diags(ctx->mon);
-  diags[1] =
-      (ctx->step << 25) | (ctx->bus_state << 20) | (ctx->tick_bits >> 12);
-  diags[0] = (ctx->tick_bits << 20) | ((ctx->frame & 0x7ffU) << 9) |
-             ((ctx->hostSt & 0x1fU) << 4) | (ctx->state & 0xfU);
+  for (unsigned i = 0U; i < 3U; ++i) {
+    diags[i] = __atomic_load_n(&ctx->diags[i], __ATOMIC_RELAXED);
+  }
 }
 
 // Close the USBDPI model and release resources
@@ -393,6 +393,12 @@ struct usbdpi_ctx {
    * Small pool of transfer descriptors
    */
   usbdpi_transfer_t transfer_pool[USBDPI_MAX_TRANSFERS];
+
+  /**
+   * Snapshot of the diagnostic information, accessed atomically because
+   * usbdpi_diags() may run on a different simulation thread
+   */
+  uint32_t diags[3];
 };
 
 /**
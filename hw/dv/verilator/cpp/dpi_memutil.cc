@@ -4,13 +4,17 @@
 
 #include "dpi_memutil.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
+#include <exception>
 #include <fcntl.h>
 #include <iostream>
 #include <libelf.h>
 #include <sstream>
 #include <sys/stat.h>
+#include <thread>
 #include <unistd.h>
 #include <vector>
 
@@ -32,14 +36,21 @@ class ElfError : public std::exception {
   std::string msg_;
 };
 
+// Initialise libelf. elf_version() sets library-wide state, so it is called
+// only once, before any ELF file is opened, rather than by each worker.
+static void InitLibElf() {
+  static const bool ok = elf_version(EV_CURRENT) != EV_NONE;
+  if (!ok) {
+    throw std::runtime_error("libelf does not support EV_CURRENT.");
+  }
+}
+
 // Class wrapping an open ELF file
 class ElfFile {
  public:
   ElfFile(const std::string &path) : path_(path) {
+    InitLibElf();
     (void)elf_errno();
-    if (elf_version(EV_CURRENT) == EV_NONE) {
-      throw std::runtime_error(elf_errmsg(-1));
-    }
 
     fd_ = open(path.c_str(), O_RDONLY, 0);
     if (fd_ < 0) {
@@ -83,6 +94,27 @@ class ElfFile {
   int fd_;
   Elf *ptr_;
 };
+
+// A write to a memory area that is part of DpiMemUtil::LoadFiles. The writes
+// are listed in the order in which they must reach the simulation.
+struct PendingWrite {
+  size_t mem_idx;
+  MemImageType type;
+  // The file being loaded. This is used directly for vmem files and for ELF
+  // files that are loaded into a named memory.
+  std::string path;
+  // True if the data came from an ELF file placed by LMA, in which case lma is
+  // the address of its first byte.
+  bool by_lma;
+  uint32_t lma;
+  // The data to write at word_offset. For an ELF file that is loaded into a
+  // named memory, this is filled in by a worker thread.
+  uint32_t word_offset;
+  std::vector<uint8_t> data;
+  // Computed by a worker thread, together with any exception that it threw
+  MemArea::PreparedWrite prepared;
+  std::exception_ptr error;
+};
 }  // namespace
 
 // Convert a string to a MemImageType, throwing a std::runtime_error
@@ -372,6 +404,16 @@ void DpiMemUtil::PrintMemRegions() const {
   }
 }
 
+// Build the message for a failure to set the scope of a memory area while
+// loading data into the memory called mem_name.
+static std::string NoScopeMessage(const SVScoped::Error &err,
+                                  const std::string &mem_name) {
+  std::ostringstream oss;
+  oss << "No memory found at `" << err.scope_name_
+      << "' (the scope associated with region `" << mem_name << "').";
+  return oss.str();
+}
+
 void DpiMemUtil::LoadFileToNamedMem(bool verbose, const std::string &name,
                                     const std::string &filepath,
                                     MemImageType type) {
@@ -382,21 +424,14 @@ void DpiMemUtil::LoadFileToNamedMem(bool verbose, const std::string &name,
   assert(type != kMemImageUnknown);
 
   // Search for corresponding registered memory based on the name
-  auto it = name_to_mem_.find(name);
-  if (it == name_to_mem_.end()) {
-    std::ostringstream oss;
-    oss << "`" << name
-        << ("' is not the name of a known memory region. "
-            "Run with --meminit=list to get a list.");
-    throw std::runtime_error(oss.str());
-  }
+  size_t mem_idx = GetRegionByName(name);
 
   if (verbose) {
     std::cout << "Loading data from file `" << filepath << "' into memory `"
               << name << "'." << std::endl;
   }
 
-  const MemArea &m = *mem_areas_[it->second];
+  const MemArea &m = *mem_areas_[mem_idx];
 
   try {
     switch (type) {
@@ -410,10 +445,7 @@ void DpiMemUtil::LoadFileToNamedMem(bool verbose, const std::string &name,
         assert(0);
     }
   } catch (const SVScoped::Error &err) {
-    std::ostringstream oss;
-    oss << "No memory found at `" << err.scope_name_
-        << "' (the scope associated with region `" << name << "').";
-    throw std::runtime_error(oss.str());
+    throw std::runtime_error(NoScopeMessage(err, name));
   }
 }
 
@@ -451,6 +483,134 @@ void DpiMemUtil::LoadElfToMemories(bool verbose, const std::string &filepath) {
   }
 }
 
+void DpiMemUtil::LoadFiles(bool verbose,
+                           const std::vector<LoadRequest> &requests,
+                           unsigned num_threads) {
+  // Work out every write, in order. ELF files that are placed by LMA are
+  // staged here, because StageElf replaces the staging area and runs the
+  // OnElfLoaded hook.
+  std::vector<PendingWrite> writes;
+  for (const LoadRequest &req : requests) {
+    if (req.name.empty()) {
+      assert(req.type == kMemImageElf);
+      StageElf(verbose, req.filepath);
+
+      for (const auto &pr : staging_area_) {
+        size_t mem_idx = name_to_mem_.at(pr.first);
+        const MemArea &mem_area = *mem_areas_[mem_idx];
+
+        for (const auto &seg_pr : pr.second.GetSegs()) {
+          const AddrRange<uint32_t> &seg_rng = seg_pr.first;
+
+          assert(seg_rng.lo % mem_area.GetWidthByte() == 0);
+          PendingWrite write;
+          write.mem_idx = mem_idx;
+          write.type = kMemImageElf;
+          write.path = req.filepath;
+          write.by_lma = true;
+          write.lma = base_addrs_[mem_idx] + seg_rng.lo;
+          write.word_offset = seg_rng.lo / mem_area.GetWidthByte();
+          write.data = seg_pr.second;
+          writes.push_back(std::move(write));
+        }
+      }
+      continue;
+    }
+
+    PendingWrite write;
+    write.mem_idx = GetRegionByName(req.name);
+    write.type = (req.type == kMemImageUnknown)
+                     ? DetectMemImageType(req.filepath)
+                     : req.type;
+    write.path = req.filepath;
+    write.by_lma = false;
+    write.lma = 0;
+    write.word_offset = 0;
+
+    if (verbose) {
+      std::cout << "Loading data from file `" << req.filepath
+                << "' into memory `" << req.name << "'." << std::endl;
+    }
+
+    writes.push_back(std::move(write));
+  }
+
+  // Read any state needed to encode the writes (such as scrambling keys) from
+  // the simulation. This has to happen on this thread.
+  std::vector<bool> captured(mem_areas_.size(), false);
+  for (const PendingWrite &write : writes) {
+    if (write.type == kMemImageVmem || captured[write.mem_idx])
+      continue;
+
+    try {
+      mem_areas_[write.mem_idx]->CaptureDesignState();
+    } catch (const SVScoped::Error &err) {
+      throw std::runtime_error(NoScopeMessage(err, names_[write.mem_idx]));
+    }
+    captured[write.mem_idx] = true;
+  }
+
+  // Read ELF files and compute the physical words for each write. This doesn't
+  // touch the simulation, so it can run on several threads. Each thread takes
+  // the next write that nobody has started on; the calling thread joins in.
+  InitLibElf();
+  std::atomic<size_t> next_write(0);
+  auto prepare = [&]() {
+    for (size_t i = next_write++; i < writes.size(); i = next_write++) {
+      PendingWrite &write = writes[i];
+      if (write.type == kMemImageVmem)
+        continue;
+
+      try {
+        if (!write.by_lma) {
+          write.data = FlattenElfFile(write.path);
+        }
+        write.prepared = mem_areas_[write.mem_idx]->PrepareWrite(
+            write.word_offset, write.data);
+      } catch (...) {
+        write.error = std::current_exception();
+      }
+    }
+  };
+
+  size_t num_workers = std::min((size_t)std::max(num_threads, 1u),
+                                std::max(writes.size(), (size_t)1));
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < num_workers; ++i) {
+    workers.emplace_back(prepare);
+  }
+  prepare();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  // Send everything to the simulation, in order.
+  for (const PendingWrite &write : writes) {
+    if (write.error) {
+      std::rethrow_exception(write.error);
+    }
+
+    const MemArea &mem_area = *mem_areas_[write.mem_idx];
+    try {
+      if (write.type == kMemImageVmem) {
+        mem_area.LoadVmem(write.path);
+      } else {
+        mem_area.WritePrepared(write.prepared);
+      }
+    } catch (const SVScoped::Error &err) {
+      if (!write.by_lma) {
+        throw std::runtime_error(NoScopeMessage(err, names_[write.mem_idx]));
+      }
+      std::ostringstream oss;
+      oss << "No memory found at `" << err.scope_name_
+          << "' (the scope associated with region `" << names_[write.mem_idx]
+          << "', used by a segment that starts at LMA 0x" << std::hex
+          << write.lma << ").";
+      throw std::runtime_error(oss.str());
+    }
+  }
+}
+
 void DpiMemUtil::StageElf(bool verbose, const std::string &path) {
   // Clear out anything that was in the staging area before
   staging_area_.clear();
@@ -571,3 +731,15 @@ size_t DpiMemUtil::GetRegionForSegment(const std::string &path, int seg_idx,
 
   return mem_area_it->second;
 }
+
+size_t DpiMemUtil::GetRegionByName(const std::string &name) const {
+  auto it = name_to_mem_.find(name);
+  if (it == name_to_mem_.end()) {
+    std::ostringstream oss;
+    oss << "`" << name
+        << ("' is not the name of a known memory region. "
+            "Run with --meminit=list to get a list.");
+    throw std::runtime_error(oss.str());
+  }
+  return it->second;
+}
@@ -119,6 +119,34 @@ class DpiMemUtil {
    */
   void LoadElfToMemories(bool verbose, const std::string &filepath);
 
+  /**
+   * A request to load the file at |filepath|. If |name| is empty, |type| must
+   * be kMemImageElf and segments are placed in memories by LMA, as with
+   * LoadElfToMemories(). Otherwise, the file is loaded into the named memory,
+   * as with LoadFileToNamedMem().
+   */
+  struct LoadRequest {
+    std::string name;
+    std::string filepath;
+    MemImageType type;
+  };
+
+  /**
+   * Perform a list of loads, using up to |num_threads| threads to prepare the
+   * data.
+   *
+   * The result is the same as performing the loads in order. ELF files are
+   * read, and the physical words for each write (with ECC and scrambling) are
+   * computed, on a pool of worker threads. Writing to the simulation over DPI,
+   * staging ELF files that are placed by LMA and loading vmem files all happen
+   * on the calling thread, which must be the simulation thread.
+   *
+   * If a load fails, raises a std::exception with information about what
+   * happened. In that case, memories may have been partly written.
+   */
+  void LoadFiles(bool verbose, const std::vector<LoadRequest> &requests,
+                 unsigned num_threads);
+
   /**
    * Load an ELF file into a staging area in this object, which can then be
    * accessed with GetMemoryData().
@@ -165,6 +193,12 @@ class DpiMemUtil {
    */
   size_t GetRegionForSegment(const std::string &path, int seg_idx, uint32_t lma,
                              uint32_t mem_sz) const;
+
+  /**
+   * Find the index of the memory area called |name|. Raises a
+   * std::runtime_error if there is no such memory.
+   */
+  size_t GetRegionByName(const std::string &name) const;
 };
 
 #endif  // OPENTITAN_HW_DV_VERILATOR_CPP_DPI_MEMUTIL_H_
@@ -34,7 +34,9 @@ Ecc32MemArea::EccWords Ecc32MemArea::ReadWithIntegrity(
     uint32_t word_offset, uint32_t num_words) const {
   assert(word_offset + num_words <= num_words_);
 
-  // See MemArea::Write for an explanation for this buffer.
+  CaptureDesignState();
+
+  // See MemArea::PrepareWrite for an explanation for this buffer.
   uint8_t minibuf[SV_MEM_WIDTH_BYTES];
   memset(minibuf, 0, sizeof minibuf);
   assert(width_byte_ <= sizeof minibuf);
@@ -55,7 +57,9 @@ Ecc32MemArea::EccWords Ecc32MemArea::ReadWithIntegrity(
 
 void Ecc32MemArea::WriteWithIntegrity(uint32_t word_offset,
                                       const EccWords &data) const {
-  // See MemArea::Write for an explanation for this buffer.
+  CaptureDesignState();
+
+  // See MemArea::PrepareWrite for an explanation for this buffer.
   uint8_t minibuf[SV_MEM_WIDTH_BYTES];
   memset(minibuf, 0, sizeof minibuf);
   assert(width_byte_ <= sizeof minibuf);
@@ -157,10 +161,14 @@ static uint8_t extract_bits(const uint8_t *buf, unsigned bit_idx,
 void Ecc32MemArea::WriteBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES],
                                const std::vector<uint8_t> &data,
                                size_t start_idx, uint32_t dst_word) const {
+  uint32_t num_words = width_byte_ / 4;
+  uint8_t check_bits[SV_MEM_WIDTH_BYTES / 4];
+  const uint8_t *src_data = &data[start_idx];
+  enc_secded_inv_39_32_buf(src_data, check_bits, num_words);
+
   zero_buffer(buf, width_byte_);
-  for (uint32_t i = 0; i < width_byte_ / 4; ++i) {
-    const uint8_t *src_data = &data[start_idx + 4 * i];
-    insert_word(buf, 39 * i, src_data, enc_secded_inv_39_32(src_data));
+  for (uint32_t i = 0; i < num_words; ++i) {
+    insert_word(buf, 39 * i, &src_data[4 * i], check_bits[i]);
   }
 }
 
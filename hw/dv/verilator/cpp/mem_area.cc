@@ -27,26 +27,45 @@ MemArea::MemArea(const std::string &scope, uint32_t num_words,
 
 void MemArea::Write(uint32_t word_offset,
                     const std::vector<uint8_t> &data) const {
-  // This "mini buffer" is used to transfer each write to SystemVerilog.
-  // `simutil_set_mem` takes a fixed SV_MEM_WIDTH_BITS-bit vector but it will
-  // only use the bits required for the RAM width. As an example, for a 32-bit
-  // wide RAM only elements 3:0 of `minibuf` will be written to memory. Since
-  // the simulator may still read bits from minibuf it does not use, we must
-  // use a fixed allocation of the full bit vector size to avoid an out of
-  // bounds access.
-  uint8_t minibuf[SV_MEM_WIDTH_BYTES];
-  memset(minibuf, 0, sizeof minibuf);
-  assert(width_byte_ <= sizeof minibuf);
+  CaptureDesignState();
+  WritePrepared(PrepareWrite(word_offset, data));
+}
+
+MemArea::PreparedWrite MemArea::PrepareWrite(
+    uint32_t word_offset, const std::vector<uint8_t> &data) const {
+  assert(width_byte_ <= SV_MEM_WIDTH_BYTES);
 
   uint32_t data_words = (data.size() + width_byte_ - 1) / width_byte_;
   assert(word_offset + data_words <= num_words_);
 
+  // Each word gets a "mini buffer" that is used to transfer it to
+  // SystemVerilog. `simutil_set_mem` takes a fixed SV_MEM_WIDTH_BITS-bit
+  // vector but it will only use the bits required for the RAM width. As an
+  // example, for a 32-bit wide RAM only elements 3:0 of a minibuf will be
+  // written to memory. Since the simulator may still read bits from minibuf
+  // it does not use, we must use a fixed allocation of the full bit vector
+  // size to avoid an out of bounds access.
+  PreparedWrite ret;
+  ret.word_offset = word_offset;
+  ret.phys_addrs.resize(data_words);
+  ret.bufs.resize((size_t)data_words * SV_MEM_WIDTH_BYTES);
+
   for (uint32_t i = 0; i < data_words; ++i) {
     uint32_t dst_word = word_offset + i;
-    uint32_t phys_addr = ToPhysAddr(dst_word);
+    ret.phys_addrs[i] = ToPhysAddr(dst_word);
+    WriteBuffer(&ret.bufs[(size_t)i * SV_MEM_WIDTH_BYTES], data,
+                i * width_byte_, dst_word);
+  }
+
+  return ret;
+}
+
+void MemArea::WritePrepared(const PreparedWrite &write) const {
+  assert(write.bufs.size() == write.phys_addrs.size() * SV_MEM_WIDTH_BYTES);
 
-    WriteBuffer(minibuf, data, i * width_byte_, dst_word);
-    WriteFromMinibuf(phys_addr, minibuf, dst_word);
+  for (size_t i = 0; i < write.phys_addrs.size(); ++i) {
+    WriteFromMinibuf(write.phys_addrs[i], &write.bufs[i * SV_MEM_WIDTH_BYTES],
+                     write.word_offset + i);
   }
 }
 
@@ -57,7 +76,9 @@ std::vector<uint8_t> MemArea::Read(uint32_t word_offset,
   uint32_t num_bytes = width_byte_ * num_words;
   assert(num_words <= num_bytes);
 
-  // See Write for an explanation for this buffer.
+  CaptureDesignState();
+
+  // See PrepareWrite for an explanation for this buffer.
   uint8_t minibuf[SV_MEM_WIDTH_BYTES];
   memset(minibuf, 0, sizeof minibuf);
   assert(width_byte_ <= sizeof minibuf);
@@ -39,6 +39,18 @@ class MemArea {
 
   virtual ~MemArea() {}
 
+  /** The physical contents of a write, ready to be sent to the simulation.
+   *
+   * See PrepareWrite() and WritePrepared().
+   */
+  struct PreparedWrite {
+    uint32_t word_offset;  ///< Logical address of the first word
+    /// Physical address of each word
+    std::vector<uint32_t> phys_addrs;
+    /// SV_MEM_WIDTH_BYTES bytes of physical data for each word
+    std::vector<uint8_t> bufs;
+  };
+
   /** Write data to this memory area at the given word offset
    *
    * This assumes that the result will fit in the memory. If the scope cannot
@@ -55,6 +67,33 @@ class MemArea {
   virtual void Write(uint32_t word_offset,
                      const std::vector<uint8_t> &data) const;
 
+  /** Read any state from the design that is needed to encode or decode the
+   * contents of this memory, such as scrambling keys.
+   *
+   * This must be called on the simulation thread before PrepareWrite(). The
+   * other accessors call it themselves. The default implementation does
+   * nothing. If the scope cannot be set, this throws an SVScoped::Error.
+   */
+  virtual void CaptureDesignState() const {}
+
+  /** Compute the physical words that Write() would send to the simulation
+   *
+   * This doesn't touch the simulation, so it may run on any thread, using the
+   * state read by the last call to CaptureDesignState(). Calls may run
+   * concurrently with each other, but not with anything else on this object.
+   *
+   * The arguments are as for Write().
+   */
+  PreparedWrite PrepareWrite(uint32_t word_offset,
+                             const std::vector<uint8_t> &data) const;
+
+  /** Send a write computed by PrepareWrite() to the simulation
+   *
+   * This must be called on the simulation thread and throws the same
+   * exceptions as Write().
+   */
+  void WritePrepared(const PreparedWrite &write) const;
+
   /** Read data from this memory area, starting at the given offset.
    *
    * This assumes that there are <tt>word_offset + num_words</tt> words in the
@@ -134,14 +173,14 @@ class MemArea {
   /** Read the memory word at phys_addr into minibuf
    *
    * minibuf should be at least SV_MEM_WIDTH_BYTES in size. See the
-   * implementation of MemArea::Write() for the details.
+   * implementation of MemArea::PrepareWrite() for the details.
    */
   void ReadToMinibuf(uint8_t *minibuf, uint32_t phys_addr) const;
 
   /** Write from minibuf to the memory word at phys_addr
    *
    * minibuf should be at least SV_MEM_WIDTH_BYTES in size. See the
-   * implementation of MemArea::Write() for the details.
+   * implementation of MemArea::PrepareWrite() for the details.
    */
   void WriteFromMinibuf(uint32_t phys_addr, const uint8_t *minibuf,
                         uint32_t dst_word) const;
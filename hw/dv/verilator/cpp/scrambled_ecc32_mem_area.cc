@@ -126,6 +126,11 @@ ScrambledEcc32MemArea::ScrambledEcc32MemArea(const std::string &scope,
   repeat_keystream_ = repeat_keystream;
 }
 
+void ScrambledEcc32MemArea::CaptureDesignState() const {
+  key_ = GetScrambleKey();
+  nonce_ = GetScrambleNonce();
+}
+
 uint32_t ScrambledEcc32MemArea::GetPhysWidth() const {
   return (GetWidthByte() / 4) * 39;
 }
@@ -164,8 +169,8 @@ std::vector<uint8_t> ScrambledEcc32MemArea::ReadUnscrambled(
   std::vector<uint8_t> scrambled_data(buf, buf + GetPhysWidthByte());
   return scramble_decrypt_data(scrambled_data, GetPhysWidth(), 39,
                                AddrIntToBytes(src_word, addr_width_),
-                               addr_width_, GetScrambleNonce(),
-                               GetScrambleKey(), repeat_keystream_, false);
+                               addr_width_, nonce_, key_, repeat_keystream_,
+                               false);
 }
 
 void ScrambledEcc32MemArea::ReadBuffer(std::vector<uint8_t> &data,
@@ -197,8 +202,7 @@ void ScrambledEcc32MemArea::ScrambleBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES],
   // Scramble data with integrity
   scramble_buf = scramble_encrypt_data(
       scramble_buf, GetPhysWidth(), 39, AddrIntToBytes(dst_word, addr_width_),
-      addr_width_, GetScrambleNonce(), GetScrambleKey(), repeat_keystream_,
-      false);
+      addr_width_, nonce_, key_, repeat_keystream_, false);
 
   // Copy scrambled data to write buffer
   std::copy(scramble_buf.begin(), scramble_buf.end(), &buf[0]);
@@ -207,6 +211,5 @@ void ScrambledEcc32MemArea::ScrambleBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES],
 uint32_t ScrambledEcc32MemArea::ToPhysAddr(uint32_t logical_addr) const {
   // Scramble logical address to get physical address
   return AddrBytesToInt(scramble_addr(AddrIntToBytes(logical_addr, addr_width_),
-                                      addr_width_, GetScrambleNonce(),
-                                      GetNonceWidth()));
+                                      addr_width_, nonce_, GetNonceWidth()));
 }
@@ -32,6 +32,13 @@ class ScrambledEcc32MemArea : public Ecc32MemArea {
   ScrambledEcc32MemArea(const std::string &scope, uint32_t size,
                         uint32_t width_32, bool repeat_keystream = true);
 
+  /** Read the scrambling key and nonce from the design over DPI.
+   *
+   * Scrambling and unscrambling words uses the values read by the last call,
+   * rather than going back to the design for each word.
+   */
+  void CaptureDesignState() const override;
+
  private:
   void WriteBuffer(uint8_t buf[SV_MEM_WIDTH_BYTES],
                    const std::vector<uint8_t> &data, size_t start_idx,
@@ -68,6 +75,10 @@ class ScrambledEcc32MemArea : public Ecc32MemArea {
   std::string scr_scope_;
   uint32_t addr_width_;
   bool repeat_keystream_;
+
+  // Scrambling key and nonce, as read by CaptureDesignState()
+  mutable std::vector<uint8_t> key_;
+  mutable std::vector<uint8_t> nonce_;
 };
 
 #endif  // OPENTITAN_HW_DV_VERILATOR_CPP_SCRAMBLED_ECC32_MEM_AREA_H_
@@ -4,25 +4,22 @@
 
 #include "verilator_memutil.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstring>
+#include <cstdlib>
 #include <getopt.h>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
-namespace {
 // An instruction to load the file at filepath to the memory called name. If
 // name is the empty string then type must be kMemImageElf and this is an
 // instruction to load an ELF file, picking memories by LMA.
-struct LoadArg {
-  std::string name;
-  std::string filepath;
-  MemImageType type;
-};
-}  // namespace
+typedef DpiMemUtil::LoadRequest LoadArg;
 
 // Parse a meminit command-line argument and write the result to the
 // mem_arg output pointer. The command-line argument should be of the
@@ -92,6 +89,9 @@ static void PrintHelp() {
                "  Print registered memory regions\n\n"
                "--verbose-mem-load\n"
                "  Print a message for each memory load\n\n"
+               "--parallel-mem-load[=N]\n"
+               "  Read ELF files and compute ECC and scrambling for memory\n"
+               "  loads on N threads (default: one per CPU)\n\n"
                "-h|--help\n"
                "  Show help\n\n";
 }
@@ -113,12 +113,14 @@ bool VerilatorMemUtil::ParseCLIArguments(int argc, char **argv,
       {"otpinit", required_argument, nullptr, 'o'},
       {"meminit", required_argument, nullptr, 'l'},
       {"verbose-mem-load", no_argument, nullptr, 'V'},
+      {"parallel-mem-load", optional_argument, nullptr, 'P'},
       {"load-elf", required_argument, nullptr, 'E'},
       {"help", no_argument, nullptr, 'h'},
       {nullptr, no_argument, nullptr, 0}};
 
   std::vector<LoadArg> load_args;
   bool verbose = false;
+  unsigned num_threads = 1;
 
   // Reset the command parsing index in-case other utils have already parsed
   // some arguments
@@ -173,6 +175,21 @@ bool VerilatorMemUtil::ParseCLIArguments(int argc, char **argv,
       case 'V':
         verbose = true;
         break;
+      case 'P': {
+        if (!optarg) {
+          num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+          break;
+        }
+        char *end;
+        unsigned long n = strtoul(optarg, &end, 10);
+        if (*optarg == '\0' || *end != '\0' || n == 0 || n > 256) {
+          std::cerr << "ERROR: Bad thread count for --parallel-mem-load: `"
+                    << optarg << "'." << std::endl;
+          return false;
+        }
+        num_threads = n;
+        break;
+      }
       case 'E':
         load_args.push_back(
             {.name = "", .filepath = optarg, .type = kMemImageElf});
@@ -190,19 +207,11 @@ bool VerilatorMemUtil::ParseCLIArguments(int argc, char **argv,
     }
   }
 
-  for (const LoadArg &arg : load_args) {
-    try {
-      if (!arg.name.empty()) {
-        mem_util_->LoadFileToNamedMem(verbose, arg.name, arg.filepath,
-                                      arg.type);
-      } else {
-        assert(arg.type == kMemImageElf);
-        mem_util_->LoadElfToMemories(verbose, arg.filepath);
-      }
-    } catch (const std::exception &err) {
-      std::cerr << "ERROR: " << err.what() << std::endl;
-      return false;
-    }
+  try {
+    mem_util_->LoadFiles(verbose, load_args, num_threads);
+  } catch (const std::exception &err) {
+    std::cerr << "ERROR: " << err.what() << std::endl;
+    return false;
   }
 
   return true;
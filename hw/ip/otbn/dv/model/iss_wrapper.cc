@@ -13,12 +13,14 @@
 #ifdef __MACH__
 #include <libproc.h>
 #endif
+#include <map>
 #include <memory>
 #include <regex>
 #include <signal.h>
 #include <sstream>
 #include <sys/stat.h>
 #include <sys/wait.h>
+#include <utility>
 
 #include "otbn_trace_checker.h"
 
@@ -210,41 +212,56 @@ static uint32_t read_hex_32(const char *str) {
   return strtoul(buf, nullptr, 16);
 }
 
-// Read through trace output (in the lines argument) to pick up any write to
-// the named CSR register, updating *dest.
-static void read_ext_reg(const std::string &reg_name,
-                         const std::vector<std::string> &lines,
-                         uint32_t *dest) {
+// Read through trace output (in the lines argument) to pick up any writes to
+// external registers, storing the last value written to each in *dest.
+static void read_ext_regs(const std::vector<std::string> &lines,
+                          std::map<std::string, uint32_t> *dest) {
   assert(dest);
 
-  // We're interested in lines that show an update to the external register
-  // called reg_name. These look something like this:
+  // We're interested in lines that show an update to an external register.
+  // These look something like this:
   //
   //   ! otbn.$REG_NAME: 0x00000000
-  std::regex re("! otbn\\." + reg_name + ": 0x([0-9a-f]{8})");
+  std::regex re("! otbn\\.([^:]+): 0x([0-9a-f]{8})");
   std::smatch match;
 
   for (const auto &line : lines) {
+    if (line.empty() || line[0] != '!')
+      continue;
     if (std::regex_match(line, match, re)) {
       // Ahah! We have a match. We have captured exactly 8 hex digits, so know
       // that we can safely parse them to a uint32_t without risking a parse
       // failure or overflow.
-      assert(match.size() == 2);
-      *dest = (uint32_t)strtoul(match[1].str().c_str(), nullptr, 16);
+      assert(match.size() == 3);
+      (*dest)[match[1].str()] =
+          (uint32_t)strtoul(match[2].str().c_str(), nullptr, 16);
     }
   }
 }
 
+// Update *dest if there was a write to the named external register.
+static void read_ext_reg(const std::string &reg_name,
+                         const std::map<std::string, uint32_t> &ext_regs,
+                         uint32_t *dest) {
+  assert(dest);
+
+  auto it = ext_regs.find(reg_name);
+  if (it != ext_regs.end()) {
+    *dest = it->second;
+  }
+}
+
 // A specialized version of read_ext_reg that updates a boolean flag
 // (assuming that the ISS will always signal the register as having
 // value 0 or 1). Prints a message to stderr and returns false on
 // error.
 static bool read_ext_flag(const std::string &reg_name,
-                          const std::vector<std::string> &lines, bool *dest) {
+                          const std::map<std::string, uint32_t> &ext_regs,
+                          bool *dest) {
   assert(dest);
 
   uint32_t dest32 = *dest ? 1 : 0;
-  read_ext_reg(reg_name, lines, &dest32);
+  read_ext_reg(reg_name, ext_regs, &dest32);
 
   if (dest32 > 1) {
     std::cerr << "ERROR: Unexpected update to " << reg_name << " with value 0x"
@@ -266,9 +283,22 @@ void MirroredRegs::reset() {
   wipe_start = false;
 }
 
-ISSWrapper::ISSWrapper() : tmpdir(new TmpDir()) {
+ISSWrapper::ISSWrapper()
+    : bin_trace_(false), trace_sink_(nullptr), tmpdir(new TmpDir()) {
   std::string model_path(find_otbn_model());
 
+  // Ask the ISS for binary trace entries, which are much cheaper to produce
+  // and to parse than the text ones, unless OTBN_MODEL_TEXT_TRACE=1. If
+  // OTBN_MODEL_ISS_TRACE names a file, we keep a copy of the binary entries
+  // there, which can be converted to text with otbnsim/decode_trace.py.
+  const char *text_str = getenv("OTBN_MODEL_TEXT_TRACE");
+  bin_trace_ = !(text_str && strcmp(text_str, "1") == 0);
+
+  const char *sink_path = getenv("OTBN_MODEL_ISS_TRACE");
+  if (bin_trace_ && sink_path && sink_path[0]) {
+    open_trace_sink(sink_path);
+  }
+
   // We want two pipes: one for writing to the child process, and the other for
   // reading from it. We set the O_CLOEXEC flag so that the child process will
   // drop all the fds when it execs.
@@ -335,6 +365,10 @@ ISSWrapper::ISSWrapper() : tmpdir(new TmpDir()) {
   // valid). Add an assertion to make sure nothing weird happens.
   assert(child_write_file);
   assert(child_read_file);
+
+  if (bin_trace_) {
+    run_command("set_trace_format binary\n", nullptr);
+  }
 }
 
 ISSWrapper::~ISSWrapper() {
@@ -349,6 +383,11 @@ ISSWrapper::~ISSWrapper() {
   // Close the child file handles.
   fclose(child_write_file);
   fclose(child_read_file);
+
+  if (trace_sink_ && fclose(trace_sink_) != 0) {
+    std::cerr << "ERROR: Failed to write ISS trace file: " << strerror(errno)
+              << "\n";
+  }
 }
 
 void ISSWrapper::load_d(const std::string &path) {
@@ -451,19 +490,39 @@ void ISSWrapper::set_keymgr_value(const std::array<uint32_t, 12> &key0_arr,
 }
 
 int ISSWrapper::step(bool gen_trace) {
-  std::vector<std::string> lines;
+  std::map<std::string, uint32_t> ext_regs;
+
+  if (bin_trace_) {
+    std::string entry_data;
+    run_command("step\n", nullptr, &entry_data);
+    if (entry_data.size()) {
+      if (!write_trace_sink(entry_data)) {
+        return -1;
+      }
 
-  run_command("step\n", &lines);
-  if (gen_trace && lines.size()) {
-    if (!OtbnTraceChecker::get().OnIssTrace(lines)) {
-      return -1;
+      OtbnIssTraceEntry entry;
+      if (!entry.from_iss_bin_trace(entry_data, &ext_regs)) {
+        return -1;
+      }
+      if (gen_trace && !OtbnTraceChecker::get().OnIssTrace(std::move(entry))) {
+        return -1;
+      }
+    }
+  } else {
+    std::vector<std::string> lines;
+    run_command("step\n", &lines);
+    if (gen_trace && lines.size()) {
+      if (!OtbnTraceChecker::get().OnIssTrace(lines)) {
+        return -1;
+      }
     }
+    read_ext_regs(lines, &ext_regs);
   }
 
   // Try to read STATUS, which is written when execution ends. Execution has
   // finished if status_ is either 0 (IDLE) or 0xff (LOCKED)
   bool was_stopped = mirrored_.stopped();
-  read_ext_reg("STATUS", lines, &mirrored_.status);
+  read_ext_reg("STATUS", ext_regs, &mirrored_.status);
   bool is_stopped = mirrored_.stopped();
   bool done = is_stopped && !was_stopped;
 
@@ -471,13 +530,13 @@ int ISSWrapper::step(bool gen_trace) {
   // flags. Some of these flags only get updated around the end of an operation
   // but the precise timing is slightly fiddly, so it's easiest to just allow
   // updates whenever they arrive.
-  read_ext_reg("INSN_CNT", lines, &mirrored_.insn_cnt);
-  read_ext_reg("ERR_BITS", lines, &mirrored_.err_bits);
-  read_ext_reg("STOP_PC", lines, &mirrored_.stop_pc);
+  read_ext_reg("INSN_CNT", ext_regs, &mirrored_.insn_cnt);
+  read_ext_reg("ERR_BITS", ext_regs, &mirrored_.err_bits);
+  read_ext_reg("STOP_PC", ext_regs, &mirrored_.stop_pc);
 
-  if (!read_ext_flag("RND_REQ", lines, &mirrored_.rnd_req))
+  if (!read_ext_flag("RND_REQ", ext_regs, &mirrored_.rnd_req))
     return -1;
-  if (!read_ext_flag("WIPE_START", lines, &mirrored_.wipe_start))
+  if (!read_ext_flag("WIPE_START", ext_regs, &mirrored_.wipe_start))
     return -1;
 
   return done ? 1 : 0;
@@ -515,7 +574,9 @@ uint32_t ISSWrapper::step_crc(const std::array<uint8_t, 6> &item,
   oss << " 0x" << std::setw(8) << state << "\n";
   run_command(oss.str(), &lines);
 
-  read_ext_reg("LOAD_CHECKSUM", lines, &state);
+  std::map<std::string, uint32_t> ext_regs;
+  read_ext_regs(lines, &ext_regs);
+  read_ext_reg("LOAD_CHECKSUM", ext_regs, &state);
   return state;
 }
 
@@ -664,7 +725,8 @@ std::string ISSWrapper::make_tmp_path(const std::string &relative) const {
   return tmpdir->path + "/" + relative;
 }
 
-bool ISSWrapper::read_child_response(std::vector<std::string> *dst) const {
+bool ISSWrapper::read_child_response(std::vector<std::string> *dst,
+                                     std::string *bin) const {
   char buf[256];
   bool continuation = false;
 
@@ -686,6 +748,29 @@ bool ISSWrapper::read_child_response(std::vector<std::string> *dst) const {
       return true;
     }
 
+    // In binary trace mode, a line "B <length>" is followed by that many
+    // bytes of a binary trace entry.
+    if (bin_trace_ && !continuation && 0 == strncmp(buf, "B ", 2)) {
+      char *end;
+      unsigned long len = strtoul(buf + 2, &end, 10);
+      if (end == buf + 2 || *end != '\n' ||
+          len > kMaxBinTraceEntryBytes) {
+        std::ostringstream oss;
+        oss << "Bad binary trace frame header from ISS: '"
+            << std::string(buf, strcspn(buf, "\n")) << "'.";
+        throw std::runtime_error(oss.str());
+      }
+      std::string data(len, '\0');
+      if (data.size() &&
+          fread(&data[0], 1, data.size(), child_read_file) != data.size()) {
+        return false;
+      }
+      if (bin) {
+        *bin = std::move(data);
+      }
+      continue;
+    }
+
     // Have we read an entire line? If not, fgets will have written something
     // other than \0 or \n to the second last entry in buf.
     char canary = buf[sizeof buf - 2];
@@ -714,16 +799,58 @@ bool ISSWrapper::read_child_response(std::vector<std::string> *dst) const {
 }
 
 void ISSWrapper::run_command(const std::string &cmd,
-                             std::vector<std::string> *dst) const {
+                             std::vector<std::string> *dst,
+                             std::string *bin) const {
   assert(cmd.size() > 0);
   assert(cmd.back() == '\n');
 
   fputs(cmd.c_str(), child_write_file);
   fflush(child_write_file);
-  if (!read_child_response(dst)) {
+  if (!read_child_response(dst, bin)) {
     std::ostringstream oss;
     std::string cmd_line = cmd.substr(0, cmd.size() - 1);
     oss << "Failed to run command '" << cmd_line << "': EOF from ISS.";
     throw std::runtime_error(oss.str());
   }
 }
+
+void ISSWrapper::open_trace_sink(const std::string &path) {
+  trace_sink_ = fopen(path.c_str(), "wb");
+  if (!trace_sink_) {
+    std::ostringstream oss;
+    oss << "Cannot open ISS trace file " << path << ": " << strerror(errno);
+    throw std::runtime_error(oss.str());
+  }
+  // Entries are small and there are a lot of them, so give the stream a big
+  // buffer to keep the number of writes down.
+  setvbuf(trace_sink_, nullptr, _IOFBF, 1 << 20);
+
+  // This must match FILE_MAGIC in otbnsim/sim/bintrace.py
+  static const char magic[] = "OTBNTRC\x01";
+  if (fwrite(magic, 1, sizeof magic - 1, trace_sink_) != sizeof magic - 1) {
+    std::ostringstream oss;
+    oss << "Cannot write ISS trace file " << path << ": " << strerror(errno);
+    throw std::runtime_error(oss.str());
+  }
+}
+
+bool ISSWrapper::write_trace_sink(const std::string &data) {
+  if (!trace_sink_)
+    return true;
+
+  uint8_t len[4];
+  for (int i = 0; i < 4; ++i) {
+    len[i] = (uint8_t)(data.size() >> (8 * i));
+  }
+  if (fwrite(len, 1, sizeof len, trace_sink_) != sizeof len ||
+      fwrite(data.data(), 1, data.size(), trace_sink_) != data.size()) {
+    std::cerr << "ERROR: Failed to write ISS trace file: " << strerror(errno)
+              << "\n";
+    // Stop tracing so that we don't leave a file with a torn entry in the
+    // middle, and don't report the same error again when closing it.
+    fclose(trace_sink_);
+    trace_sink_ = nullptr;
+    return false;
+  }
+  return true;
+}
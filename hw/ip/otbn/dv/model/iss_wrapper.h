@@ -157,17 +157,38 @@ struct ISSWrapper {
  private:
   // Read line by line from the child process until we get ".\n".
   // Return true if we got the ".\n" terminator, false if EOF. If dst
-  // is not null, append to it each line that was read.
-  bool read_child_response(std::vector<std::string> *dst) const;
+  // is not null, append to it each line that was read. If bin is not
+  // null, store in it any binary trace entry that was read.
+  bool read_child_response(std::vector<std::string> *dst,
+                           std::string *bin) const;
 
   // Send a command to the child and wait for its response. If no
   // response, raise a runtime_error.
-  void run_command(const std::string &cmd, std::vector<std::string> *dst) const;
+  void run_command(const std::string &cmd, std::vector<std::string> *dst,
+                   std::string *bin = nullptr) const;
+
+  // Open a file at path to keep a copy of binary trace entries in. If the
+  // file cannot be opened, raise a runtime_error.
+  void open_trace_sink(const std::string &path);
+
+  // Append a binary trace entry to the trace file, if there is one. Prints a
+  // message to stderr and returns false on error.
+  bool write_trace_sink(const std::string &data);
+
+  // The largest binary trace entry we accept from the child. Real entries
+  // are a few hundred bytes, so anything bigger means the stream is corrupt.
+  static const size_t kMaxBinTraceEntryBytes = 1 << 16;
 
   pid_t child_pid;
   FILE *child_write_file;
   FILE *child_read_file;
 
+  // True if the child sends trace entries in binary form
+  bool bin_trace_;
+
+  // If not null, a file that gets a copy of each binary trace entry
+  FILE *trace_sink_;
+
   // A temporary directory for communicating with the child process
   std::unique_ptr<TmpDir> tmpdir;
 
@@ -8,6 +8,7 @@
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <utility>
 
 #include "otbn_trace_source.h"
 #include "sv_utils.h"
@@ -154,8 +155,6 @@ void OtbnTraceChecker::AcceptTraceString(const std::string &trace,
 }
 
 bool OtbnTraceChecker::OnIssTrace(const std::vector<std::string> &lines) {
-  assert(!(rtl_pending_ && iss_pending_));
-
   if (seen_err_) {
     return false;
   }
@@ -167,6 +166,16 @@ bool OtbnTraceChecker::OnIssTrace(const std::vector<std::string> &lines) {
     return false;
   }
 
+  return OnIssTrace(std::move(trace_entry));
+}
+
+bool OtbnTraceChecker::OnIssTrace(OtbnIssTraceEntry trace_entry) {
+  assert(!(rtl_pending_ && iss_pending_));
+
+  if (seen_err_) {
+    return false;
+  }
+
   done_ = false;
 
   if (iss_pending_) {
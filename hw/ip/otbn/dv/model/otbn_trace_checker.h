@@ -60,6 +60,12 @@ class OtbnTraceChecker : public OtbnTraceListener {
   // Prints an error message to stderr and returns false on mismatch.
   bool OnIssTrace(const std::vector<std::string> &lines);
 
+  // Take a trace entry from the wrapped ISS that has already been parsed (for
+  // example, from the binary trace format).
+  //
+  // Prints an error message to stderr and returns false on mismatch.
+  bool OnIssTrace(OtbnIssTraceEntry trace_entry);
+
   // Flush any pending entries. We need to do this on reset, to handle
   // the case where we reset the processor in the middle of a stall.
   void Flush();
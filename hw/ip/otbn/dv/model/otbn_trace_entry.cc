@@ -4,11 +4,107 @@
 
 #include "otbn_trace_entry.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
 #include <iostream>
 #include <regex>
 #include <sstream>
 
+namespace {
+// Record types in a binary ISS trace entry. These must match the values in
+// otbnsim/sim/bintrace.py.
+enum bin_record_t {
+  kBinHdrExec = 0x01,
+  kBinHdrFetchErr = 0x02,
+  kBinHdrStall = 0x03,
+  kBinHdrWipe = 0x04,
+  kBinHdrWipeDone = 0x05,
+  kBinReg = 0x10,
+  kBinRegUnknown = 0x11,
+  kBinFlags = 0x12,
+  kBinExtReg = 0x13,
+};
+
+// A cursor over the bytes of a binary trace entry. Reads past the end set the
+// truncated flag and return zeros, so callers can check once at the end of
+// each record.
+struct BinReader {
+  const std::string &data;
+  size_t pos;
+  bool truncated;
+
+  explicit BinReader(const std::string &data)
+      : data(data), pos(0), truncated(false) {}
+
+  bool done() const { return pos >= data.size(); }
+
+  const uint8_t *take(size_t count) {
+    if (truncated || data.size() - pos < count) {
+      truncated = true;
+      return nullptr;
+    }
+    const uint8_t *ret = reinterpret_cast<const uint8_t *>(data.data()) + pos;
+    pos += count;
+    return ret;
+  }
+
+  uint32_t uint(size_t count) {
+    const uint8_t *bytes = take(count);
+    uint32_t ret = 0;
+    for (size_t i = 0; bytes && i < count; ++i) {
+      ret |= (uint32_t)bytes[i] << (8 * i);
+    }
+    return ret;
+  }
+
+  std::string name() {
+    size_t len = uint(1);
+    const uint8_t *bytes = take(len);
+    return bytes ? std::string(reinterpret_cast<const char *>(bytes), len)
+                 : std::string();
+  }
+};
+
+// Format a 32-bit value as the ISS does, with a 0x prefix and 8 digits.
+std::string hex32(uint32_t value) {
+  char buf[11];
+  snprintf(buf, sizeof buf, "0x%08x", value);
+  return buf;
+}
+
+// Format a register value of width bits as Trace.hex_value in the ISS does:
+// 32-bit words separated by underscores, with 'x' digits if bytes is null
+// (meaning the value is unknown).
+std::string hex_value(const uint8_t *bytes, unsigned width) {
+  static const char digits[] = "0123456789abcdef";
+  unsigned num_words = (width + 31) / 32;
+  unsigned num_bytes = (width + 7) / 8;
+  std::string ret = "0x";
+  for (unsigned idx = num_words; idx-- > 0;) {
+    unsigned lsb = 32 * idx;
+    unsigned num_digits = std::min(8u, (width - lsb + 3) / 4);
+    if (!bytes) {
+      ret.append(8, 'x');
+    } else {
+      for (unsigned d = num_digits; d-- > 0;) {
+        unsigned bit = lsb + 4 * d;
+        unsigned byte = bit / 8;
+        uint8_t nibble = 0;
+        if (byte < num_bytes) {
+          nibble = (bytes[byte] >> (bit % 8)) & 0xf;
+        }
+        ret += digits[nibble];
+      }
+    }
+    if (idx) {
+      ret += '_';
+    }
+  }
+  return ret;
+}
+}  // namespace
+
 bool OtbnTraceBodyLine::fill_from_string(const std::string &src,
                                          const std::string &line) {
   // A valid line matches the following regex
@@ -30,6 +126,19 @@ bool OtbnTraceBodyLine::fill_from_string(const std::string &src,
   return true;
 }
 
+void OtbnTraceBodyLine::fill(char type, const std::string &loc,
+                             const std::string &value) {
+  raw_.clear();
+  raw_ += type;
+  raw_ += ' ';
+  raw_ += loc;
+  raw_ += ": ";
+  raw_ += value;
+  type_ = type;
+  loc_ = loc;
+  value_ = value;
+}
+
 bool OtbnTraceBodyLine::operator==(const OtbnTraceBodyLine &other) const {
   // If the raw lines are identical, the two objects are identical and no
   // further checks are required.
@@ -357,3 +466,94 @@ bool OtbnIssTraceEntry::from_iss_trace(const std::vector<std::string> &lines) {
 
   return true;
 }
+
+bool OtbnIssTraceEntry::from_iss_bin_trace(
+    const std::string &data, std::map<std::string, uint32_t> *ext_regs) {
+  assert(ext_regs);
+  BinReader rd(data);
+
+  uint32_t kind = rd.uint(1);
+  switch (kind) {
+    case kBinHdrExec:
+    case kBinHdrFetchErr: {
+      uint32_t pc = rd.uint(4);
+      hdr_ = "E PC: " + hex32(pc) + ", insn: ";
+      data_.insn_addr = pc;
+      if (kind == kBinHdrExec) {
+        hdr_ += hex32(rd.uint(4));
+        data_.mnemonic = rd.name();
+      } else {
+        hdr_ += "??";
+        data_.mnemonic = "??";
+      }
+      break;
+    }
+    case kBinHdrStall:
+      hdr_ = "STALL";
+      break;
+    case kBinHdrWipe:
+      hdr_ = "U ";
+      break;
+    case kBinHdrWipeDone:
+      hdr_ = "V ";
+      break;
+    default:
+      std::cerr << "Bad header record type 0x" << std::hex << kind << std::dec
+                << " in binary ISS trace entry.\n";
+      return false;
+  }
+  trace_type_ = hdr_to_trace_type(hdr_);
+
+  while (!rd.truncated && !rd.done()) {
+    OtbnTraceBodyLine line;
+    kind = rd.uint(1);
+    switch (kind) {
+      case kBinReg:
+      case kBinRegUnknown: {
+        std::string loc = rd.name();
+        unsigned width = rd.uint(2);
+        const uint8_t *value =
+            kind == kBinReg ? rd.take((width + 7) / 8) : nullptr;
+        if (rd.truncated) {
+          break;
+        }
+        line.fill('>', loc, hex_value(value, width));
+        writes_[loc].push_back(line);
+        break;
+      }
+      case kBinFlags: {
+        unsigned group = rd.uint(1);
+        unsigned bits = rd.uint(1);
+        std::ostringstream value;
+        value << "{C: " << (bits & 1) << ", M: " << ((bits >> 1) & 1)
+              << ", L: " << ((bits >> 2) & 1) << ", Z: " << ((bits >> 3) & 1)
+              << "}";
+        std::string loc = "FLAGS" + std::to_string(group);
+        line.fill('>', loc, value.str());
+        writes_[loc].push_back(line);
+        break;
+      }
+      case kBinExtReg: {
+        std::string name = rd.name();
+        uint32_t value = rd.uint(4);
+        if (!rd.truncated) {
+          (*ext_regs)[name] = value;
+        }
+        break;
+      }
+      default:
+        std::cerr << "Bad body record type 0x" << std::hex << kind << std::dec
+                  << " in binary ISS trace entry with header `" << hdr_
+                  << "'.\n";
+        return false;
+    }
+  }
+
+  if (rd.truncated) {
+    std::cerr << "Truncated binary ISS trace entry with header `" << hdr_
+              << "'.\n";
+    return false;
+  }
+
+  return true;
+}
@@ -24,6 +24,9 @@ class OtbnTraceBodyLine {
   // say where the line came from) and return false.
   bool fill_from_string(const std::string &src, const std::string &line);
 
+  // Fill this object from its parts, without any parsing.
+  void fill(char type, const std::string &loc, const std::string &value);
+
   bool operator==(const OtbnTraceBodyLine &other) const;
 
   // Return the location that is being read or written
@@ -95,6 +98,16 @@ class OtbnIssTraceEntry : public OtbnTraceEntry {
  public:
   bool from_iss_trace(const std::vector<std::string> &lines);
 
+  // Parse an ISS trace entry in the binary format described in
+  // otbnsim/sim/bintrace.py. This holds the same information as the text
+  // lines, so the result is as if from_iss_trace had been called with them.
+  // The RTL trace doesn't track external registers, so changes to them are
+  // written to ext_regs instead (with later changes replacing earlier ones).
+  //
+  // On an error, print a message to stderr and return false.
+  bool from_iss_bin_trace(const std::string &data,
+                          std::map<std::string, uint32_t> *ext_regs);
+
   // Fields that are populated from the "special" line for ISS entries
   struct IssData {
     uint32_t insn_addr;
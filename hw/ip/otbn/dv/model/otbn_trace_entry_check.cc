@@ -0,0 +1,165 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// A test driver that checks OtbnIssTraceEntry::from_iss_bin_trace against
+// from_iss_trace. This is run by otbnsim/test/bintrace_model_test.py, which
+// generates the input. It is not part of the OTBN model.
+//
+// Usage: otbn_trace_entry_check BIN_FILE TEXT_FILE
+//
+// BIN_FILE is a binary trace file, in the layout that ISSWrapper writes.
+// TEXT_FILE holds the text form of the same entries, as printed by the ISS,
+// with an empty line after each entry. Each binary entry must decode to the
+// same entry and external register values as its text form, and must be
+// rejected if its last byte is missing.
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "otbn_trace_entry.h"
+
+namespace {
+
+const char kFileMagic[] = "OTBNTRC\x01";
+const size_t kFileMagicLen = sizeof(kFileMagic) - 1;
+
+// Read the entries of a binary trace file. Returns false if the file is
+// malformed.
+bool read_bin_entries(const char *path, std::vector<std::string> *entries) {
+  std::ifstream in(path, std::ios::binary);
+  std::string magic(kFileMagicLen, '\0');
+  if (!in.read(&magic[0], kFileMagicLen) ||
+      magic != std::string(kFileMagic, kFileMagicLen)) {
+    std::cerr << "Bad magic in `" << path << "'.\n";
+    return false;
+  }
+  for (;;) {
+    uint8_t len_bytes[4];
+    if (!in.read(reinterpret_cast<char *>(len_bytes), sizeof len_bytes)) {
+      return in.gcount() == 0;
+    }
+    uint32_t len = 0;
+    for (int i = 0; i < 4; ++i) {
+      len |= (uint32_t)len_bytes[i] << (8 * i);
+    }
+    std::string data(len, '\0');
+    if (len && !in.read(&data[0], len)) {
+      std::cerr << "Truncated entry in `" << path << "'.\n";
+      return false;
+    }
+    entries->push_back(data);
+  }
+}
+
+// Read the entries of a text trace, each followed by an empty line.
+std::vector<std::vector<std::string>> read_text_entries(const char *path) {
+  std::ifstream in(path);
+  std::vector<std::vector<std::string>> entries;
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty()) {
+      entries.push_back(lines);
+      lines.clear();
+    } else {
+      lines.push_back(line);
+    }
+  }
+  return entries;
+}
+
+// Pick out the external register changes in a text entry, as ISSWrapper does
+// in text mode.
+std::map<std::string, uint32_t> text_ext_regs(
+    const std::vector<std::string> &lines) {
+  std::map<std::string, uint32_t> ext_regs;
+  for (const std::string &line : lines) {
+    char name[64];
+    unsigned value;
+    if (sscanf(line.c_str(), "! otbn.%63[^:]: 0x%x", name, &value) == 2) {
+      ext_regs[name] = value;
+    }
+  }
+  return ext_regs;
+}
+
+std::string describe(const OtbnIssTraceEntry &entry,
+                     const std::map<std::string, uint32_t> &ext_regs) {
+  std::ostringstream oss;
+  entry.print("  ", oss);
+  if (entry.trace_type() == OtbnTraceEntry::Exec) {
+    oss << "  @" << entry.data_.insn_addr << ": " << entry.data_.mnemonic
+        << "\n";
+  }
+  for (const auto &pr : ext_regs) {
+    oss << "  ! " << pr.first << " = " << pr.second << "\n";
+  }
+  return oss.str();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " BIN_FILE TEXT_FILE\n";
+    return 2;
+  }
+
+  std::vector<std::string> bin_entries;
+  if (!read_bin_entries(argv[1], &bin_entries)) {
+    return 1;
+  }
+  std::vector<std::vector<std::string>> text_entries =
+      read_text_entries(argv[2]);
+  if (bin_entries.size() != text_entries.size()) {
+    std::cerr << bin_entries.size() << " binary entries but "
+              << text_entries.size() << " text entries.\n";
+    return 1;
+  }
+
+  int failures = 0;
+  for (size_t i = 0; i < bin_entries.size(); ++i) {
+    OtbnIssTraceEntry from_bin, from_text;
+    std::map<std::string, uint32_t> bin_ext_regs;
+    if (!from_bin.from_iss_bin_trace(bin_entries[i], &bin_ext_regs) ||
+        !from_text.from_iss_trace(text_entries[i])) {
+      std::cerr << "Entry " << i << " failed to parse.\n";
+      ++failures;
+      continue;
+    }
+    std::string bin_desc = describe(from_bin, bin_ext_regs);
+    std::string text_desc =
+        describe(from_text, text_ext_regs(text_entries[i]));
+    if (from_bin.trace_type() != from_text.trace_type() ||
+        bin_desc != text_desc) {
+      std::cerr << "Entry " << i << " differs. From binary:\n"
+                << bin_desc << "From text:\n"
+                << text_desc;
+      ++failures;
+    }
+
+    OtbnIssTraceEntry truncated;
+    std::map<std::string, uint32_t> ignored;
+    const std::string &data = bin_entries[i];
+    if (truncated.from_iss_bin_trace(data.substr(0, data.size() - 1),
+                                     &ignored)) {
+      std::cerr << "Entry " << i << " accepted without its last byte.\n";
+      ++failures;
+    }
+  }
+
+  if (failures) {
+    std::cerr << failures << " of " << bin_entries.size()
+              << " entries failed.\n";
+    return 1;
+  }
+  std::cout << bin_entries.size() << " entries match.\n";
+  return 0;
+}
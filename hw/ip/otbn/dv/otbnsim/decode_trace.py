@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+'''Convert a binary ISS trace file to the text trace
+
+A binary trace file is written by the OTBN model when the OTBN_MODEL_ISS_TRACE
+environment variable names a path for it. This prints each entry in the same
+form that the stepped ISS uses for its text trace, with entries separated by
+blank lines.
+
+'''
+
+import argparse
+import sys
+
+from sim.bintrace import decode_entry, read_trace_file
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser()
+    parser.add_argument('trace',
+                        type=argparse.FileType('rb'),
+                        help="Binary trace file. Use '-' to read STDIN.")
+    parser.add_argument('-o', '--output',
+                        type=argparse.FileType('w'),
+                        default=sys.stdout,
+                        metavar='FILE',
+                        help='Where to write the text trace (default STDOUT).')
+    args = parser.parse_args()
+
+    try:
+        for entry in read_trace_file(args.trace):
+            args.output.write('\n'.join(decode_entry(entry)) + '\n\n')
+    except ValueError as err:
+        print(f'Failed to decode {args.trace.name}: {err}', file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,211 @@
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+'''A compact binary encoding of the RTL-style trace
+
+The stepped ISS normally sends trace entries to the RTL model as text (see
+Trace.rtl_trace). For long programs, formatting and then parsing that text
+takes a sizeable fraction of the simulation time, so the ISS can instead send
+each entry as a frame of binary records. The records carry exactly the
+information that is in the text form, which can be recovered with
+decode_entry() (and with decode_trace.py for a trace file).
+
+All integers are little-endian. Each entry is a header record followed by zero
+or more body records, in the order that the text lines would appear:
+
+    HDR_EXEC      u32 pc, u32 insn, u8 len, mnemonic (len bytes)
+    HDR_FETCH_ERR u32 pc
+    HDR_STALL
+    HDR_WIPE
+    HDR_WIPE_DONE
+    REG           u8 len, name (len bytes), u16 width, value (width / 8 bytes,
+                  rounded up)
+    REG_UNKNOWN   u8 len, name (len bytes), u16 width
+    FLAGS         u8 group, u8 flags (C, M, L, Z in bits 0 to 3)
+    EXT_REG       u8 len, name (len bytes), u32 value
+
+Over the stepped interface, an entry is sent as a line "B <length>" followed
+by the records. A trace file, as written by ISSWrapper in the RTL model, starts
+with FILE_MAGIC. After that, each entry is stored as a u32 length followed by
+that many bytes of records.
+
+'''
+
+import struct
+from typing import BinaryIO, Iterator, List, Optional
+
+from .trace import Trace
+
+FILE_MAGIC = b'OTBNTRC\x01'
+
+HDR_EXEC = 0x01
+HDR_FETCH_ERR = 0x02
+HDR_STALL = 0x03
+HDR_WIPE = 0x04
+HDR_WIPE_DONE = 0x05
+REG = 0x10
+REG_UNKNOWN = 0x11
+FLAGS = 0x12
+EXT_REG = 0x13
+
+_U32 = struct.Struct('<I')
+_U16 = struct.Struct('<H')
+_HDR_EXEC = struct.Struct('<BII')
+_HDR_FETCH_ERR = struct.Struct('<BI')
+
+STALL_RECORD = bytes([HDR_STALL])
+WIPE_RECORD = bytes([HDR_WIPE])
+WIPE_DONE_RECORD = bytes([HDR_WIPE_DONE])
+
+
+def _name(name: str) -> bytes:
+    raw = name.encode('ascii')
+    assert len(raw) < 256
+    return bytes([len(raw)]) + raw
+
+
+def exec_record(pc: int, insn: Optional[int], mnemonic: str) -> bytes:
+    '''Encode the header for an executed instruction
+
+    If insn is None, the instruction could not be fetched.
+
+    '''
+    if insn is None:
+        return _HDR_FETCH_ERR.pack(HDR_FETCH_ERR, pc)
+    return _HDR_EXEC.pack(HDR_EXEC, pc, insn) + _name(mnemonic)
+
+
+def reg_record(name: str, width: int, value: Optional[int]) -> bytes:
+    '''Encode a write of value to a register that is width bits wide
+
+    A value of None means the written value is unknown.
+
+    '''
+    assert 0 < width < (1 << 16)
+    if value is None:
+        return bytes([REG_UNKNOWN]) + _name(name) + _U16.pack(width)
+    return (bytes([REG]) + _name(name) + _U16.pack(width) +
+            value.to_bytes((width + 7) // 8, 'little'))
+
+
+def flags_record(group: int, flags: List[bool]) -> bytes:
+    '''Encode a write to flag group group
+
+    flags holds the values of the C, M, L and Z flags, in that order.
+
+    '''
+    bits = 0
+    for idx, flag in enumerate(flags):
+        bits |= int(flag) << idx
+    return bytes([FLAGS, group, bits])
+
+
+def ext_reg_record(name: str, value: int) -> bytes:
+    '''Encode a change to an external register'''
+    return bytes([EXT_REG]) + _name(name) + _U32.pack(value)
+
+
+class _Reader:
+    def __init__(self, data: bytes):
+        self.data = data
+        self.pos = 0
+
+    def done(self) -> bool:
+        return self.pos == len(self.data)
+
+    def take(self, count: int) -> bytes:
+        if self.pos + count > len(self.data):
+            raise ValueError('Truncated binary trace entry.')
+        ret = self.data[self.pos:self.pos + count]
+        self.pos += count
+        return ret
+
+    def u8(self) -> int:
+        return self.take(1)[0]
+
+    def u16(self) -> int:
+        return int(_U16.unpack(self.take(2))[0])
+
+    def u32(self) -> int:
+        return int(_U32.unpack(self.take(4))[0])
+
+    def name(self) -> str:
+        return self.take(self.u8()).decode('ascii')
+
+
+def decode_entry(data: bytes) -> List[str]:
+    '''Convert a binary trace entry to the lines of its text form'''
+    rd = _Reader(data)
+    lines = []  # type: List[str]
+
+    kind = rd.u8()
+    if kind == HDR_EXEC:
+        pc = rd.u32()
+        insn = rd.u32()
+        lines.append(f'E PC: {pc:#010x}, insn: {insn:#010x}')
+        lines.append(f'# @{pc:#010x}: {rd.name()}')
+    elif kind == HDR_FETCH_ERR:
+        pc = rd.u32()
+        lines.append(f'E PC: {pc:#010x}, insn: ??')
+        lines.append(f'# @{pc:#010x}: ??')
+    elif kind == HDR_STALL:
+        lines.append('STALL')
+    elif kind == HDR_WIPE:
+        lines.append('U ')
+    elif kind == HDR_WIPE_DONE:
+        lines.append('V ')
+    else:
+        raise ValueError(f'Unknown header record type {kind:#04x}.')
+
+    while not rd.done():
+        kind = rd.u8()
+        if kind in [REG, REG_UNKNOWN]:
+            name = rd.name()
+            width = rd.u16()
+            value = None  # type: Optional[int]
+            if kind == REG:
+                value = int.from_bytes(rd.take((width + 7) // 8), 'little')
+            lines.append(f'> {name}: {Trace.hex_value(value, width)}')
+        elif kind == FLAGS:
+            group = rd.u8()
+            bits = rd.u8()
+            lines.append(f'> FLAGS{group}: {{C: {bits & 1}, '
+                         f'M: {(bits >> 1) & 1}, L: {(bits >> 2) & 1}, '
+                         f'Z: {(bits >> 3) & 1}}}')
+        elif kind == EXT_REG:
+            name = rd.name()
+            lines.append(f'! otbn.{name}: {rd.u32():#010x}')
+        else:
+            raise ValueError(f'Unknown body record type {kind:#04x}.')
+
+    return lines
+
+
+class BinTraceWriter:
+    '''A writer for binary trace entries over the stepped interface'''
+    def __init__(self, stream: BinaryIO):
+        self.stream = stream
+
+    def write_entry(self, records: List[bytes]) -> None:
+        '''Send one entry, framed as "B <length>", in a single write'''
+        length = sum(len(r) for r in records)
+        self.stream.write(b''.join([b'B %d\n' % length] + records))
+        self.stream.flush()
+
+
+def read_trace_file(stream: BinaryIO) -> Iterator[bytes]:
+    '''Yield the entries in a binary trace file'''
+    if stream.read(len(FILE_MAGIC)) != FILE_MAGIC:
+        raise ValueError('Not a binary OTBN trace file.')
+    while True:
+        hdr = stream.read(4)
+        if not hdr:
+            return
+        if len(hdr) != 4:
+            raise ValueError('Truncated binary trace file.')
+        length = int(_U32.unpack(hdr)[0])
+        data = stream.read(length)
+        if len(data) != length:
+            raise ValueError('Truncated binary trace file.')
+        yield data
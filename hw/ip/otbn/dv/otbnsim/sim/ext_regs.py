@@ -10,6 +10,7 @@ from reggen.reg_block import RegBlock
 
 from shared.otbn_reggen import load_registers
 
+from . import bintrace
 from .edn_client import EdnClient
 from .trace import Trace
 
@@ -41,6 +42,9 @@ class TraceExtRegChange(Trace):
     def rtl_trace(self) -> str:
         return '! otbn.{}: {:#010x}'.format(self.name, self.erc.new_value)
 
+    def rtl_trace_bin(self) -> bytes:
+        return bintrace.ext_reg_record(self.name, self.erc.new_value)
+
 
 class RGField:
     '''A wrapper around a field in a register as parsed by reggen'''
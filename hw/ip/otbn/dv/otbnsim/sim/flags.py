@@ -4,6 +4,7 @@
 
 from typing import List, Optional, cast
 
+from . import bintrace
 from .trace import Trace
 
 
@@ -28,6 +29,11 @@ class TraceFlags(Trace):
                         int(self.value.L),
                         int(self.value.Z)))
 
+    def rtl_trace_bin(self) -> bytes:
+        return bintrace.flags_record(self.group,
+                                     [self.value.C, self.value.M,
+                                      self.value.L, self.value.Z])
+
 
 class FlagReg:
     FLAG_NAMES = ['C', 'M', 'L', 'Z']
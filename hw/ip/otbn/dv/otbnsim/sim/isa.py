@@ -7,6 +7,7 @@ from typing import Dict, Iterator, Optional, Tuple
 
 from shared.insn_yaml import Insn, DummyInsn, load_insns_yaml
 
+from . import bintrace
 from .state import OTBNState
 
 
@@ -113,6 +114,12 @@ class OTBNInsn:
             return (f'E PC: {pc:#010x}, insn: ??\n'
                     f'# @{pc:#010x}: ??')
 
+    def rtl_trace_bin(self, pc: int) -> bytes:
+        '''Return the RTL trace header for this insn as a binary record'''
+        return bintrace.exec_record(pc,
+                                    self.raw if self.has_bits else None,
+                                    self.insn.mnemonic)
+
 
 class RV32RegReg(OTBNInsn):
     '''A general class for register-register insns from the RV32I ISA'''
@@ -4,6 +4,7 @@
 
 from typing import List, Optional, Set
 
+from . import bintrace
 from .trace import Trace
 
 
@@ -24,6 +25,9 @@ class TraceRegister(Trace):
         return '> {}: {}'.format(self.name,
                                  Trace.hex_value(self.new_value, self.width))
 
+    def rtl_trace_bin(self) -> bytes:
+        return bintrace.reg_record(self.name, self.width, self.new_value)
+
 
 class Reg:
     def __init__(self,
@@ -26,6 +26,15 @@ class Trace:
         '''
         return None
 
+    def rtl_trace_bin(self) -> Optional[bytes]:
+        '''Return the entry for RTL tracing as a binary record
+
+        This encodes the same information as rtl_trace() in the format
+        described in bintrace.py.
+
+        '''
+        return None
+
     @staticmethod
     def hex_value(value: Optional[int], bit_width: int) -> str:
         '''Render a hex value in the format expected by RTL tracing'''
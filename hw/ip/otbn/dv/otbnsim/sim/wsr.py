@@ -4,6 +4,7 @@
 
 from typing import List, Optional, Sequence, Tuple
 
+from . import bintrace
 from .trace import Trace
 
 from .ext_regs import OTBNExtRegs
@@ -26,6 +27,9 @@ class TraceWSR(Trace):
         return '> {}: {}'.format(self.wsr_name,
                                  Trace.hex_value(self.new_value, 256))
 
+    def rtl_trace_bin(self) -> bytes:
+        return bintrace.reg_record(self.wsr_name, 256, self.new_value)
+
 
 class WSR:
     '''Models a Wide Status Register'''
@@ -70,15 +70,25 @@ prefixed with "0x" if they are hexadecimal.
     send_err_escalation     React to an injected error.
 
     set_software_errs_fatal Set software_errs_fatal bit.
+
+    set_trace_format <fmt>  Choose how step prints trace information. <fmt> is
+                            either "text" (the default) or "binary" (the
+                            format described in sim/bintrace.py).
 '''
 
 import binascii
 import sys
 from typing import List, Optional
 
+from sim import bintrace
 from sim.decode import decode_file
+from sim.isa import OTBNInsn
 from sim.load_elf import load_elf
 from sim.sim import OTBNSim
+from sim.trace import Trace
+
+# If this is not None, step sends trace entries through it in binary form.
+_BIN_TRACE = None  # type: Optional[bintrace.BinTraceWriter]
 
 
 def read_word(arg_name: str, word_data: str, bits: int) -> int:
@@ -143,21 +153,14 @@ def on_step(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
 
     insn, changes = sim.step(verbose=False)
 
+    if _BIN_TRACE is not None:
+        _bin_trace_step(_BIN_TRACE, sim, pc, was_wiping, insn, changes)
+        return None
+
     if insn is not None:
         hdr = insn.rtl_trace(pc)  # type: Optional[str]
-    elif was_wiping:
-        # The trailing space is a bit naff but matches the behaviour in the RTL
-        # tracer, where it's rather difficult to change.
-        done_last_round = (sim.state.wipe_rounds_done == 2)
-        hdr = 'V ' if done_last_round else 'U '
-    elif sim.state.executing():
-        hdr = 'STALL'
     else:
-        hdr = None
-
-    # When locking immediately, drop headers that get cancelled by RTL.
-    if sim.state.lock_immediately and hdr in ['V ', 'STALL']:
-        hdr = None
+        hdr = _no_insn_header(sim, was_wiping)
 
     rtl_changes = []
     for c in changes:
@@ -182,6 +185,65 @@ def on_step(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
     return None
 
 
+def _no_insn_header(sim: OTBNSim, was_wiping: bool) -> Optional[str]:
+    '''Get the trace header for a step that executed no instruction'''
+    if was_wiping:
+        # The trailing space is a bit naff but matches the behaviour in the RTL
+        # tracer, where it's rather difficult to change.
+        done_last_round = (sim.state.wipe_rounds_done == 2)
+        hdr = 'V ' if done_last_round else 'U '  # type: Optional[str]
+    elif sim.state.executing():
+        hdr = 'STALL'
+    else:
+        hdr = None
+
+    # When locking immediately, drop headers that get cancelled by RTL.
+    if sim.state.lock_immediately and hdr in ['V ', 'STALL']:
+        hdr = None
+
+    return hdr
+
+
+# Binary header records for the headers returned by _no_insn_header
+_BIN_HEADERS = {
+    'U ': bintrace.WIPE_RECORD,
+    'V ': bintrace.WIPE_DONE_RECORD,
+    'STALL': bintrace.STALL_RECORD
+}
+
+
+def _bin_trace_step(writer: bintrace.BinTraceWriter, sim: OTBNSim, pc: int,
+                    was_wiping: bool, insn: Optional[OTBNInsn],
+                    changes: List[Trace]) -> None:
+    '''Send the trace entry for a step in binary form
+
+    This follows the same rules as the text trace in on_step.
+
+    '''
+    if insn is not None:
+        hdr = insn.rtl_trace_bin(pc)  # type: Optional[bytes]
+    else:
+        text_hdr = _no_insn_header(sim, was_wiping)
+        hdr = _BIN_HEADERS[text_hdr] if text_hdr is not None else None
+
+    records = []
+    for c in changes:
+        rt = c.rtl_trace_bin()
+        if rt is not None:
+            records.append(rt)
+
+    # See the comment about STALL in on_step.
+    if hdr is None and records:
+        hdr = bintrace.STALL_RECORD
+
+    if hdr is None:
+        return
+
+    # Anything printed earlier in this command must come first.
+    sys.stdout.flush()
+    writer.write_entry([hdr] + records)
+
+
 def on_load_elf(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
     '''Load contents of ELF at path given by only argument'''
     check_arg_count('load_elf', 1, args)
@@ -342,6 +404,21 @@ def on_invalidate_dmem(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
     return None
 
 
+def on_set_trace_format(sim: OTBNSim, args: List[str]) -> Optional[OTBNSim]:
+    '''Choose between text and binary trace output for step'''
+    global _BIN_TRACE
+    check_arg_count('set_trace_format', 1, args)
+
+    if args[0] == 'text':
+        _BIN_TRACE = None
+    elif args[0] == 'binary':
+        _BIN_TRACE = bintrace.BinTraceWriter(sys.stdout.buffer)
+    else:
+        raise ValueError(f'Invalid trace format: {args[0]}.')
+
+    return None
+
+
 def on_set_software_errs_fatal(sim: OTBNSim,
                                args: List[str]) -> Optional[OTBNSim]:
     check_arg_count('set_software_errs_fatal', 1, args)
@@ -428,7 +505,8 @@ _HANDLERS = {
     'send_err_escalation': on_send_err_escalation,
     'set_rma_req': on_set_rma_req,
     'initial_secure_wipe': on_initial_secure_wipe,
-    'set_software_errs_fatal': on_set_software_errs_fatal
+    'set_software_errs_fatal': on_set_software_errs_fatal,
+    'set_trace_format': on_set_trace_format
 }
 
 
@@ -0,0 +1,121 @@
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+'''Cross-check the binary trace decoder in the RTL model against this one.
+
+ISSWrapper decodes binary trace entries with
+OtbnIssTraceEntry::from_iss_bin_trace, which must build the same entry as
+from_iss_trace does from the text form. This test writes random entries to a
+trace file and their text form (from decode_entry) to another, then runs
+model/otbn_trace_entry_check.cc over both.
+
+'''
+
+import os
+import random
+import shutil
+import subprocess
+from pathlib import Path
+from typing import List
+
+import pytest
+
+from sim import bintrace
+
+NUM_ENTRIES = 500
+
+_MODEL_DIR = os.path.normpath(
+    os.path.join(os.path.dirname(__file__), '..', '..', 'model'))
+
+_MNEMONICS = ['addi', 'lw', 'sw', 'bn.add', 'bn.mulqacc.wo', 'bn.sid',
+              'loopi', 'ecall']
+_WSRS = ['MOD', 'RND', 'URND', 'ACC', 'KEY_S0_L', 'KEY_S1_H']
+_EXT_REGS = ['INSN_CNT', 'STATUS', 'ERR_BITS', 'STOP_PC', 'RND_REQ',
+             'WIPE_START']
+
+
+def _random_value(rng: random.Random, width: int) -> int:
+    # Mix in some all-zero and all-one values, which are easy to get wrong.
+    choice = rng.randrange(4)
+    if choice == 0:
+        return 0
+    if choice == 1:
+        return (1 << width) - 1
+    return rng.getrandbits(width)
+
+
+def _random_entry(rng: random.Random) -> bytes:
+    hdr = rng.choice([bintrace.HDR_EXEC, bintrace.HDR_FETCH_ERR,
+                      bintrace.HDR_STALL, bintrace.HDR_WIPE,
+                      bintrace.HDR_WIPE_DONE])
+    records = []  # type: List[bytes]
+    if hdr == bintrace.HDR_EXEC:
+        records.append(bintrace.exec_record(rng.getrandbits(32),
+                                            rng.getrandbits(32),
+                                            rng.choice(_MNEMONICS)))
+    elif hdr == bintrace.HDR_FETCH_ERR:
+        records.append(bintrace.exec_record(rng.getrandbits(32), None, '??'))
+    else:
+        records.append(bytes([hdr]))
+
+    for _ in range(rng.randrange(8)):
+        kind = rng.randrange(5)
+        unknown = rng.randrange(8) == 0
+        if kind == 0:
+            name = f'x{rng.randrange(32):02}'
+            value = None if unknown else _random_value(rng, 32)
+            records.append(bintrace.reg_record(name, 32, value))
+        elif kind == 1:
+            name = f'w{rng.randrange(32):02}'
+            value = None if unknown else _random_value(rng, 256)
+            records.append(bintrace.reg_record(name, 256, value))
+        elif kind == 2:
+            value = None if unknown else _random_value(rng, 256)
+            records.append(bintrace.reg_record(rng.choice(_WSRS), 256, value))
+        elif kind == 3:
+            records.append(bintrace.flags_record(
+                rng.randrange(2), [rng.random() < 0.5 for _ in range(4)]))
+        else:
+            records.append(bintrace.ext_reg_record(rng.choice(_EXT_REGS),
+                                                   rng.getrandbits(32)))
+    return b''.join(records)
+
+
+@pytest.fixture(scope='module')
+def checker(tmp_path_factory: pytest.TempPathFactory) -> str:
+    '''Build otbn_trace_entry_check with the host C++ compiler'''
+    cxx = os.environ.get('CXX') or shutil.which('c++') or shutil.which('g++')
+    if cxx is None:
+        pytest.skip('No C++ compiler to build the RTL model decoder.')
+    out = str(tmp_path_factory.mktemp('model') / 'otbn_trace_entry_check')
+    subprocess.run([cxx, '-std=c++14', '-Wall', '-Werror',
+                    '-I', _MODEL_DIR, '-o', out,
+                    os.path.join(_MODEL_DIR, 'otbn_trace_entry_check.cc'),
+                    os.path.join(_MODEL_DIR, 'otbn_trace_entry.cc')],
+                   check=True)
+    return out
+
+
+def test_bintrace_model_decoder(checker: str, tmp_path: Path) -> None:
+    '''Check that the RTL model decodes random entries as the text form.'''
+    rng = random.Random(1)
+    entries = [_random_entry(rng) for _ in range(NUM_ENTRIES)]
+
+    bin_path = str(tmp_path / 'trace.bin')
+    text_path = str(tmp_path / 'trace.txt')
+    with open(bin_path, 'wb') as bin_file:
+        bin_file.write(bintrace.FILE_MAGIC)
+        for entry in entries:
+            bin_file.write(len(entry).to_bytes(4, 'little') + entry)
+    with open(text_path, 'w') as text_file:
+        for entry in entries:
+            for line in bintrace.decode_entry(entry):
+                text_file.write(line + '\n')
+            text_file.write('\n')
+
+    result = subprocess.run([checker, bin_path, text_path],
+                            stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                            universal_newlines=True)
+    assert result.returncode == 0, result.stderr
+    assert result.stdout == f'{NUM_ENTRIES} entries match.\n'
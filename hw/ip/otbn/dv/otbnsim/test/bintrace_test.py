@@ -0,0 +1,88 @@
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+'''Test the binary trace encoding against the text trace.'''
+
+import io
+
+import pytest
+
+from sim import bintrace
+from sim.flags import FlagReg, TraceFlags
+from sim.reg import TraceRegister
+
+
+def test_bintrace_exec() -> None:
+    '''Check instruction headers decode to the text form.'''
+    rec = bintrace.exec_record(0x1c, 0x00107db8, 'bn.add')
+    assert bintrace.decode_entry(rec) == [
+        'E PC: 0x0000001c, insn: 0x00107db8',
+        '# @0x0000001c: bn.add',
+    ]
+
+    rec = bintrace.exec_record(0x20, None, '??')
+    assert bintrace.decode_entry(rec) == [
+        'E PC: 0x00000020, insn: ??',
+        '# @0x00000020: ??',
+    ]
+
+    for rec, hdr in [(bintrace.STALL_RECORD, 'STALL'),
+                     (bintrace.WIPE_RECORD, 'U '),
+                     (bintrace.WIPE_DONE_RECORD, 'V ')]:
+        assert bintrace.decode_entry(rec) == [hdr]
+
+
+def test_bintrace_body() -> None:
+    '''Check body records decode to what rtl_trace() prints.'''
+    changes = [
+        TraceRegister('x05', 32, 0xdeadbeef),
+        TraceRegister('x06', 32, None),
+        TraceRegister('w02', 256, (1 << 255) | 0x1234),
+        TraceRegister('w03', 256, None),
+        TraceFlags(1, FlagReg(True, False, True, False)),
+    ]
+    records = [bintrace.STALL_RECORD] + [c.rtl_trace_bin() for c in changes]
+    records.append(bintrace.ext_reg_record('INSN_CNT', 42))
+
+    expected = ['STALL'] + [c.rtl_trace() for c in changes]
+    expected.append('! otbn.INSN_CNT: 0x0000002a')
+    assert bintrace.decode_entry(b''.join(records)) == expected
+
+
+def test_bintrace_stepped() -> None:
+    '''Check that entries are framed for the stepped interface.'''
+    records = [bintrace.WIPE_RECORD,
+               TraceRegister('x01', 32, 1).rtl_trace_bin()]
+    data = b''.join(records)
+
+    buf = io.BytesIO()
+    bintrace.BinTraceWriter(buf).write_entry(records)
+    assert buf.getvalue() == b'B %d\n' % len(data) + data
+
+
+def test_bintrace_file() -> None:
+    '''Check entries can be read back from a trace file.'''
+    entries = [
+        [bintrace.exec_record(0, 0x13, 'addi'),
+         TraceRegister('x01', 32, 1).rtl_trace_bin()],
+        [bintrace.WIPE_RECORD],
+    ]
+    # This is the layout that ISSWrapper writes.
+    buf = io.BytesIO()
+    buf.write(bintrace.FILE_MAGIC)
+    for entry in entries:
+        data = b''.join(entry)
+        buf.write(len(data).to_bytes(4, 'little') + data)
+
+    buf.seek(0)
+    read_back = list(bintrace.read_trace_file(buf))
+    assert read_back == [b''.join(entry) for entry in entries]
+
+    with pytest.raises(ValueError):
+        bintrace.decode_entry(read_back[0][:-1])
+
+    buf.truncate(len(buf.getvalue()) - 1)
+    buf.seek(0)
+    with pytest.raises(ValueError):
+        list(bintrace.read_trace_file(buf))
@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 #include <svdpi.h>
+#include <vector>
 
 #include "Votbn_top_sim__Syms.h"
 #include "log_trace_listener.h"
@@ -99,6 +100,234 @@ class OtbnTraceUtil : public SimCtrlExtension {
 static otbn_top_sim *verilator_top;
 static OtbnMemUtil otbn_memutil("TOP.otbn_top_sim");
 
+// The RTL's loop stack, as tracked by OtbnTopApplyLoopWarp. This must be
+// cleared when the design is reset.
+static std::vector<uint32_t> loop_count_stack;
+
+// Check the outcome of the program that has just finished: the RTL and model
+// must have agreed and, if the ELF file gave an expected end address, the
+// model must have stopped there. Prints a message to stderr on failure.
+static bool check_program_result() {
+  svSetScope(svGetScopeFromName("TOP.otbn_top_sim"));
+
+  svBit model_err = otbn_err_get();
+  if (model_err) {
+    return false;
+  }
+
+  int exp_stop_pc = otbn_memutil.GetExpEndAddr();
+  if (exp_stop_pc >= 0) {
+    SVScoped core_scope("TOP.otbn_top_sim.u_otbn_core_model");
+    int act_stop_pc = otbn_core_get_stop_pc();
+    if (exp_stop_pc != act_stop_pc) {
+      std::cerr << "ERROR: Expected stop PC from ELF file was 0x" << std::hex
+                << exp_stop_pc << ", but simulation actually stopped at 0x"
+                << act_stop_pc << std::dec << ".\n";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * SimCtrlExtension that adds a '--otbn-batch' command line option.
+ *
+ * The option names a file listing ELF files, one per line. They are run one
+ * after the other in a single simulation, so that Verilator model construction
+ * and ISS startup are only paid once. Between programs, the next ELF is
+ * backdoor loaded through OtbnMemUtil and the design (and with it, the ISS) is
+ * reset. Memory that the next ELF doesn't cover keeps its old contents, which
+ * the RTL and the model see alike.
+ *
+ * A program passes under the same conditions as in a single run. A mismatch
+ * fails the program rather than stopping the simulation. Note that
+ * --term-after-cycles applies to the whole batch.
+ */
+class OtbnBatchUtil : public SimCtrlExtension {
+ private:
+  // Number of cycles to hold reset between programs
+  static const unsigned kResetCycles = 2;
+
+  CData *sig_rst_n_;
+  std::vector<std::string> elf_paths_;
+  std::vector<bool> passed_;
+  size_t current_;
+  bool program_ended_;
+  unsigned reset_cycles_left_;
+
+  bool ReadList(const std::string &list_path) {
+    std::ifstream list(list_path);
+    if (!list) {
+      std::cerr << "ERROR: Cannot open batch list `" << list_path << "'.\n";
+      return false;
+    }
+    std::string line;
+    while (std::getline(list, line)) {
+      size_t start = line.find_first_not_of(" \t");
+      if (start == std::string::npos || line[start] == '#') {
+        continue;
+      }
+      size_t end = line.find_last_not_of(" \t\r");
+      elf_paths_.push_back(line.substr(start, end - start + 1));
+    }
+    if (elf_paths_.empty()) {
+      std::cerr << "ERROR: Batch list `" << list_path
+                << "' names no ELF files.\n";
+      return false;
+    }
+    return true;
+  }
+
+  // Try to load the ELF at index current_ and return true on success. On
+  // failure, print a message and mark the program as failed.
+  bool LoadCurrent() {
+    const std::string &path = elf_paths_[current_];
+    std::cout << "\nBatch program " << current_ + 1 << "/"
+              << elf_paths_.size() << ": " << path << std::endl;
+    try {
+      otbn_memutil.LoadElf(path);
+      return true;
+    } catch (const std::exception &err) {
+      std::cerr << "ERROR: Failed to load `" << path << "': " << err.what()
+                << "\n";
+      passed_.push_back(false);
+      return false;
+    }
+  }
+
+  void PrintHelp() {
+    std::cout << "Batch mode:\n\n"
+                 "--otbn-batch=FILE\n"
+                 "  Run each ELF file listed in FILE (one per line), resetting "
+                 "between them\n\n";
+  }
+
+ public:
+  explicit OtbnBatchUtil(CData *sig_rst_n)
+      : sig_rst_n_(sig_rst_n),
+        current_(0),
+        program_ended_(false),
+        reset_cycles_left_(0) {}
+
+  virtual bool ParseCLIArguments(int argc, char **argv, bool &exit_app) {
+    const struct option long_options[] = {
+        {"otbn-batch", required_argument, nullptr, 'b'},
+        {"load-elf", required_argument, nullptr, 'E'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, no_argument, nullptr, 0}};
+
+    std::string list_path;
+    bool has_load_elf = false;
+
+    // Reset the command parsing index in-case other utils have already parsed
+    // some arguments
+    optind = 1;
+    while (1) {
+      int c = getopt_long(argc, argv, "-h", long_options, nullptr);
+      if (c == -1) {
+        break;
+      }
+
+      switch (c) {
+        case 0:
+        case 1:
+          break;
+        case 'b':
+          list_path = optarg;
+          break;
+        case 'E':
+          has_load_elf = true;
+          break;
+        case 'h':
+          PrintHelp();
+          break;
+      }
+    }
+
+    if (list_path.empty()) {
+      return true;
+    }
+    if (has_load_elf) {
+      std::cerr << "ERROR: --otbn-batch cannot be combined with --load-elf.\n";
+      return false;
+    }
+    if (!ReadList(list_path)) {
+      return false;
+    }
+
+    // Load the first program that can be loaded. The rest are loaded as the
+    // simulation goes along.
+    for (; current_ < elf_paths_.size(); ++current_) {
+      if (LoadCurrent()) {
+        return true;
+      }
+    }
+    std::cerr << "ERROR: No ELF file in the batch could be loaded.\n";
+    return false;
+  }
+
+  bool Enabled() const { return !elf_paths_.empty(); }
+
+  // Called (over DPI) when the current program has ended
+  void ProgramEnded() { program_ended_ = true; }
+
+  virtual void OnClock(unsigned long sim_time) {
+    if (reset_cycles_left_ > 0) {
+      if (--reset_cycles_left_ == 0) {
+        *sig_rst_n_ = 1;
+      }
+      return;
+    }
+    if (!program_ended_) {
+      return;
+    }
+    program_ended_ = false;
+
+    bool passed = check_program_result();
+    std::cout << "Batch program " << current_ + 1 << ": "
+              << (passed ? "PASS" : "FAIL") << std::endl;
+    passed_.push_back(passed);
+
+    // Move on to the next program that can be loaded.
+    for (++current_; current_ < elf_paths_.size(); ++current_) {
+      if (LoadCurrent()) {
+        break;
+      }
+    }
+    if (current_ == elf_paths_.size()) {
+      VerilatorSimCtrl::GetInstance().RequestStop(true);
+      return;
+    }
+
+    loop_count_stack.clear();
+    *sig_rst_n_ = 0;
+    reset_cycles_left_ = kResetCycles;
+  }
+
+  // Print per-program results and return a main()-compatible exit code. Any
+  // program that didn't get to run (because the simulation stopped early)
+  // counts as a failure.
+  int Report() const {
+    size_t num_passed = 0;
+    std::cout << "\nBatch results\n"
+              << "=============\n";
+    for (size_t i = 0; i < elf_paths_.size(); ++i) {
+      const char *result = "NOT RUN";
+      if (i < passed_.size()) {
+        result = passed_[i] ? "PASS" : "FAIL";
+        num_passed += passed_[i];
+      }
+      std::cout << result << ": " << elf_paths_[i] << "\n";
+    }
+    std::cout << num_passed << "/" << elf_paths_.size() << " passed"
+              << std::endl;
+    return num_passed == elf_paths_.size() ? 0 : 1;
+  }
+};
+
+static OtbnBatchUtil *batch_util;
+
 int main(int argc, char **argv) {
   VerilatorMemUtil memutil(&otbn_memutil);
   OtbnTraceUtil traceutil;
@@ -113,8 +342,12 @@ int main(int argc, char **argv) {
   VerilatorSimCtrl &simctrl = VerilatorSimCtrl::GetInstance();
   simctrl.SetTop(&top, &top.IO_CLK, &top.IO_RST_N,
                  VerilatorSimCtrlFlags::ResetPolarityNegative);
+  OtbnBatchUtil batchutil(&top.IO_RST_N);
+  batch_util = &batchutil;
+
   simctrl.RegisterExtension(&memutil);
   simctrl.RegisterExtension(&traceutil);
+  simctrl.RegisterExtension(&batchutil);
 
   std::cout << "Simulation of OTBN" << std::endl
             << "==================" << std::endl
@@ -124,30 +357,29 @@ int main(int argc, char **argv) {
   int ret_code = pr.first;
   bool ran_simulation = pr.second;
 
+  if (ran_simulation && batchutil.Enabled()) {
+    int batch_ret_code = batchutil.Report();
+    return ret_code != 0 ? ret_code : batch_ret_code;
+  }
+
   if (ret_code != 0 || !ran_simulation) {
     return ret_code;
   }
 
-  svSetScope(svGetScopeFromName("TOP.otbn_top_sim"));
-
-  svBit model_err = otbn_err_get();
-  if (model_err) {
-    return 1;
-  }
+  return check_program_result() ? 0 : 1;
+}
 
-  int exp_stop_pc = otbn_memutil.GetExpEndAddr();
-  if (exp_stop_pc >= 0) {
-    SVScoped core_scope("TOP.otbn_top_sim.u_otbn_core_model");
-    int act_stop_pc = otbn_core_get_stop_pc();
-    if (exp_stop_pc != act_stop_pc) {
-      std::cerr << "ERROR: Expected stop PC from ELF file was 0x" << std::hex
-                << exp_stop_pc << ", but simulation actually stopped at 0x"
-                << act_stop_pc << ".\n";
-      return 1;
-    }
-  }
+// This is executed over DPI when the design's initial blocks run. It tells the
+// design whether it is running a batch of programs (see OtbnBatchUtil).
+extern "C" svBit OtbnTopBatchMode() {
+  return batch_util && batch_util->Enabled();
+}
 
-  return 0;
+// This is executed over DPI in batch mode, a few cycles after the current
+// program has finished (or after a mismatch between RTL and model).
+extern "C" void OtbnTopProgramEnd() {
+  assert(batch_util);
+  batch_util->ProgramEnded();
 }
 
 // This is executed over DPI on the first posedge of the clock after each
@@ -231,8 +463,6 @@ auto get_loop_counter(LoopControllerT *loop_controller, uint32_t counter_idx)
 // updating the top of the loop stack if necessary to match loop warp symbols
 // in the ELF file.
 extern "C" void OtbnTopApplyLoopWarp() {
-  static std::vector<uint32_t> loop_count_stack;
-
   // See not in OtbnTopInstallLoopWarps for why this upcast is needed.
   Votbn_top_sim &top = *verilator_top;
 
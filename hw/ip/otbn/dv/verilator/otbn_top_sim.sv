@@ -332,6 +332,17 @@ module otbn_top_sim (
     .alert_o          (                         )
   );
 
+  // Defined in otbn_top_sim.cc. In batch mode, the testbench runs a list of programs: the end of
+  // each one is reported with OtbnTopProgramEnd() instead of $finish or $error, and the C++ side
+  // then loads the next program and resets the design.
+  import "DPI-C" function bit OtbnTopBatchMode();
+  import "DPI-C" function void OtbnTopProgramEnd();
+
+  bit batch_mode;
+  initial begin
+    batch_mode = OtbnTopBatchMode();
+  end
+
   // When OTBN is done let a few more cycles run then finish simulation
   logic [1:0] finish_counter;
 
@@ -348,7 +359,11 @@ module otbn_top_sim (
       end
 
       if (finish_counter == 2'd3) begin
-        $finish;
+        if (batch_mode) begin
+          OtbnTopProgramEnd();
+        end else begin
+          $finish;
+        end
       end
     end
   end
@@ -454,7 +469,15 @@ module otbn_top_sim (
         bad_cycles <= bad_cycles + 1;
       end
       if (bad_cycles >= 3) begin
-        $error("Mismatch or model error (see message above)");
+        if (batch_mode) begin
+          // End the program (which might otherwise never finish). The mismatch is picked up by
+          // otbn_err_get().
+          if (bad_cycles == 3) begin
+            OtbnTopProgramEnd();
+          end
+        end else begin
+          $error("Mismatch or model error (see message above)");
+        end
       end
     end
   end
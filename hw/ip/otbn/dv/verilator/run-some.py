@@ -46,6 +46,9 @@ def main() -> int:
                         help='Number of binaries to generate and run')
     parser.add_argument('--seed', type=int, default=1)
     parser.add_argument('--size', type=int, default=100)
+    parser.add_argument('--batch', action='store_true',
+                        help=('Run all binaries in a single simulation '
+                              '(see --otbn-batch in otbn_top_sim.cc)'))
     parser.add_argument('destdir', help='Destination directory')
 
     args = parser.parse_args()
@@ -68,7 +71,8 @@ def main() -> int:
     # Next, we make our own build.ninja, which says how to compile and run the
     # verilated testbench
     with open(os.path.join(args.destdir, 'build.ninja'), 'w') as ninja_handle:
-        write_ninja(ninja_handle, args.destdir, args.seed, args.count)
+        write_ninja(ninja_handle, args.destdir, args.seed, args.count,
+                    args.batch)
 
     # Finally, use ninja to run everything, continuing on error (so that you
     # can run 100 seeds and see what proportion fails).
@@ -79,7 +83,8 @@ def main() -> int:
 def write_ninja(handle: TextIO,
                 destdir: str,
                 seed: int,
-                count: int) -> None:
+                count: int,
+                batch: bool) -> None:
     handle.write('include build.ninja.gen\n\n')
 
     # Find the project directory, as viewed from destdir
@@ -99,6 +104,20 @@ def write_ninja(handle: TextIO,
     # Collect up all the generated files
     basenames = [str(seed + off) for off in range(count)]
 
+    if batch:
+        # List the binaries in a file and run them all in one simulation
+        with open(os.path.join(destdir, 'batch.list'), 'w') as list_handle:
+            for name in basenames:
+                list_handle.write(f'{name}.elf\n')
+
+        handle.write(f'rule run_batch\n'
+                     f'  command = REPO_TOP={projdir_from_destdir} '
+                     f'$tb --otbn-batch=batch.list >$out\n\n')
+        elfs = ' '.join([f'{name}.elf' for name in basenames])
+        handle.write(f'build batch.out: run_batch batch.list | $tb {elfs}\n\n')
+        handle.write('build run: phony batch.out\n\n')
+        return
+
     # Rules to run them
     handle.write(f'rule run\n'
                  f'  command = REPO_TOP={projdir_from_destdir} '
@@ -5,156 +5,1790 @@
 // SECDED encode code generated by
 // util/design/secded_gen.py from util/design/data/secded_cfg.hjson
 
+
 #include "secded_enc.h"
 
-#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
-// Calculates even parity for a 64-bit word
-static uint8_t calc_parity(uint64_t word, bool invert) {
-  bool parity = false;
+// The check bits are computed a byte at a time: entry [i][b] of an encode
+// table holds the check bits contributed by value `b` in byte `i` of the data
+// word. The codes are linear, so the check bits of a word are the XOR of the
+// contributions of its bytes. Inverted codes share the tables of the plain
+// codes and XOR a constant into the result, as the RTL does.
+static inline uint8_t encode(const uint8_t (*table)[256], const uint8_t *bytes,
+                             size_t len) {
+  uint8_t ecc = 0;
+  for (size_t i = 0; i < len; ++i) {
+    ecc ^= table[i][bytes[i]];
+  }
+  return ecc;
+}
 
-  while (word) {
-    if (word & 1) {
-      parity = !parity;
+// Flips the data bit whose column of the parity check matrix matches
+// `syndrome`, if there is one.
+static void correct(uint8_t *bytes, uint8_t syndrome, const uint8_t *columns,
+                    size_t k) {
+  for (size_t i = 0; i < k; ++i) {
+    if (columns[i] == syndrome) {
+      bytes[i / 8] ^= (uint8_t)(1 << (i % 8));
+      return;
     }
-
-    word >>= 1;
   }
+}
+
+// Error flags for a non-zero Hsiao syndrome: odd weight is a single error.
+static inline uint8_t hsiao_err(uint8_t syndrome) {
+  return __builtin_parity(syndrome) ? 1 : 2;
+}
 
-  return parity ^ invert;
+// Error flags for a non-zero Hamming syndrome of `m` bits: the last bit is
+// the overall parity.
+static inline uint8_t hamming_err(uint8_t syndrome, unsigned m) {
+  return (syndrome >> (m - 1)) & 1 ? 1 : 2;
 }
 
+static const uint8_t kEncHsiao22_16[2][256] = {
+    {0x00, 0x32, 0x23, 0x11, 0x19, 0x2b, 0x3a, 0x08, 0x07, 0x35, 0x24, 0x16,
+     0x1e, 0x2c, 0x3d, 0x0f, 0x2c, 0x1e, 0x0f, 0x3d, 0x35, 0x07, 0x16, 0x24,
+     0x2b, 0x19, 0x08, 0x3a, 0x32, 0x00, 0x11, 0x23, 0x31, 0x03, 0x12, 0x20,
+     0x28, 0x1a, 0x0b, 0x39, 0x36, 0x04, 0x15, 0x27, 0x2f, 0x1d, 0x0c, 0x3e,
+     0x1d, 0x2f, 0x3e, 0x0c, 0x04, 0x36, 0x27, 0x15, 0x1a, 0x28, 0x39, 0x0b,
+     0x03, 0x31, 0x20, 0x12, 0x25, 0x17, 0x06, 0x34, 0x3c, 0x0e, 0x1f, 0x2d,
+     0x22, 0x10, 0x01, 0x33, 0x3b, 0x09, 0x18, 0x2a, 0x09, 0x3b, 0x2a, 0x18,
+     0x10, 0x22, 0x33, 0x01, 0x0e, 0x3c, 0x2d, 0x1f, 0x17, 0x25, 0x34, 0x06,
+     0x14, 0x26, 0x37, 0x05, 0x0d, 0x3f, 0x2e, 0x1c, 0x13, 0x21, 0x30, 0x02,
+     0x0a, 0x38, 0x29, 0x1b, 0x38, 0x0a, 0x1b, 0x29, 0x21, 0x13, 0x02, 0x30,
+     0x3f, 0x0d, 0x1c, 0x2e, 0x26, 0x14, 0x05, 0x37, 0x34, 0x06, 0x17, 0x25,
+     0x2d, 0x1f, 0x0e, 0x3c, 0x33, 0x01, 0x10, 0x22, 0x2a, 0x18, 0x09, 0x3b,
+     0x18, 0x2a, 0x3b, 0x09, 0x01, 0x33, 0x22, 0x10, 0x1f, 0x2d, 0x3c, 0x0e,
+     0x06, 0x34, 0x25, 0x17, 0x05, 0x37, 0x26, 0x14, 0x1c, 0x2e, 0x3f, 0x0d,
+     0x02, 0x30, 0x21, 0x13, 0x1b, 0x29, 0x38, 0x0a, 0x29, 0x1b, 0x0a, 0x38,
+     0x30, 0x02, 0x13, 0x21, 0x2e, 0x1c, 0x0d, 0x3f, 0x37, 0x05, 0x14, 0x26,
+     0x11, 0x23, 0x32, 0x00, 0x08, 0x3a, 0x2b, 0x19, 0x16, 0x24, 0x35, 0x07,
+     0x0f, 0x3d, 0x2c, 0x1e, 0x3d, 0x0f, 0x1e, 0x2c, 0x24, 0x16, 0x07, 0x35,
+     0x3a, 0x08, 0x19, 0x2b, 0x23, 0x11, 0x00, 0x32, 0x20, 0x12, 0x03, 0x31,
+     0x39, 0x0b, 0x1a, 0x28, 0x27, 0x15, 0x04, 0x36, 0x3e, 0x0c, 0x1d, 0x2f,
+     0x0c, 0x3e, 0x2f, 0x1d, 0x15, 0x27, 0x36, 0x04, 0x0b, 0x39, 0x28, 0x1a,
+     0x12, 0x20, 0x31, 0x03},
+    {0x00, 0x29, 0x0e, 0x27, 0x1c, 0x35, 0x12, 0x3b, 0x15, 0x3c, 0x1b, 0x32,
+     0x09, 0x20, 0x07, 0x2e, 0x2a, 0x03, 0x24, 0x0d, 0x36, 0x1f, 0x38, 0x11,
+     0x3f, 0x16, 0x31, 0x18, 0x23, 0x0a, 0x2d, 0x04, 0x1a, 0x33, 0x14, 0x3d,
+     0x06, 0x2f, 0x08, 0x21, 0x0f, 0x26, 0x01, 0x28, 0x13, 0x3a, 0x1d, 0x34,
+     0x30, 0x19, 0x3e, 0x17, 0x2c, 0x05, 0x22, 0x0b, 0x25, 0x0c, 0x2b, 0x02,
+     0x39, 0x10, 0x37, 0x1e, 0x0b, 0x22, 0x05, 0x2c, 0x17, 0x3e, 0x19, 0x30,
+     0x1e, 0x37, 0x10, 0x39, 0x02, 0x2b, 0x0c, 0x25, 0x21, 0x08, 0x2f, 0x06,
+     0x3d, 0x14, 0x33, 0x1a, 0x34, 0x1d, 0x3a, 0x13, 0x28, 0x01, 0x26, 0x0f,
+     0x11, 0x38, 0x1f, 0x36, 0x0d, 0x24, 0x03, 0x2a, 0x04, 0x2d, 0x0a, 0x23,
+     0x18, 0x31, 0x16, 0x3f, 0x3b, 0x12, 0x35, 0x1c, 0x27, 0x0e, 0x29, 0x00,
+     0x2e, 0x07, 0x20, 0x09, 0x32, 0x1b, 0x3c, 0x15, 0x16, 0x3f, 0x18, 0x31,
+     0x0a, 0x23, 0x04, 0x2d, 0x03, 0x2a, 0x0d, 0x24, 0x1f, 0x36, 0x11, 0x38,
+     0x3c, 0x15, 0x32, 0x1b, 0x20, 0x09, 0x2e, 0x07, 0x29, 0x00, 0x27, 0x0e,
+     0x35, 0x1c, 0x3b, 0x12, 0x0c, 0x25, 0x02, 0x2b, 0x10, 0x39, 0x1e, 0x37,
+     0x19, 0x30, 0x17, 0x3e, 0x05, 0x2c, 0x0b, 0x22, 0x26, 0x0f, 0x28, 0x01,
+     0x3a, 0x13, 0x34, 0x1d, 0x33, 0x1a, 0x3d, 0x14, 0x2f, 0x06, 0x21, 0x08,
+     0x1d, 0x34, 0x13, 0x3a, 0x01, 0x28, 0x0f, 0x26, 0x08, 0x21, 0x06, 0x2f,
+     0x14, 0x3d, 0x1a, 0x33, 0x37, 0x1e, 0x39, 0x10, 0x2b, 0x02, 0x25, 0x0c,
+     0x22, 0x0b, 0x2c, 0x05, 0x3e, 0x17, 0x30, 0x19, 0x07, 0x2e, 0x09, 0x20,
+     0x1b, 0x32, 0x15, 0x3c, 0x12, 0x3b, 0x1c, 0x35, 0x0e, 0x27, 0x00, 0x29,
+     0x2d, 0x04, 0x23, 0x0a, 0x31, 0x18, 0x3f, 0x16, 0x38, 0x11, 0x36, 0x1f,
+     0x24, 0x0d, 0x2a, 0x03},
+};
+
+static const uint8_t kColsHsiao22_16[16] = {
+    0x32, 0x23, 0x19, 0x07, 0x2c, 0x31, 0x25, 0x34, 0x29, 0x0e, 0x1c, 0x15,
+    0x2a, 0x1a, 0x0b, 0x16,
+};
+
 uint8_t enc_secded_22_16(const uint8_t bytes[2]) {
-  uint16_t word = ((uint16_t)bytes[0] << 0) | ((uint16_t)bytes[1] << 8);
+  return encode(kEncHsiao22_16, bytes, 2);
+}
 
-  return (calc_parity(word & 0x496e, false) << 0) |
-         (calc_parity(word & 0xf20b, false) << 1) |
-         (calc_parity(word & 0x8ed8, false) << 2) |
-         (calc_parity(word & 0x7714, false) << 3) |
-         (calc_parity(word & 0xaca5, false) << 4) |
-         (calc_parity(word & 0x11f3, false) << 5);
+uint8_t dec_secded_22_16(uint8_t bytes[2], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_22_16(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  correct(bytes, syndrome, kColsHsiao22_16, 16);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_22_16_buf(const uint8_t *data, uint8_t *ecc, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_22_16(&data[2 * i]);
+  }
 }
 
+uint8_t dec_secded_22_16_buf(uint8_t *data, const uint8_t *ecc, size_t count,
+                             uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_22_16(&data[2 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
+}
+
+static const uint8_t kEncHsiao28_22[3][256] = {
+    {0x00, 0x07, 0x0b, 0x0c, 0x13, 0x14, 0x18, 0x1f, 0x23, 0x24, 0x28, 0x2f,
+     0x30, 0x37, 0x3b, 0x3c, 0x0d, 0x0a, 0x06, 0x01, 0x1e, 0x19, 0x15, 0x12,
+     0x2e, 0x29, 0x25, 0x22, 0x3d, 0x3a, 0x36, 0x31, 0x15, 0x12, 0x1e, 0x19,
+     0x06, 0x01, 0x0d, 0x0a, 0x36, 0x31, 0x3d, 0x3a, 0x25, 0x22, 0x2e, 0x29,
+     0x18, 0x1f, 0x13, 0x14, 0x0b, 0x0c, 0x00, 0x07, 0x3b, 0x3c, 0x30, 0x37,
+     0x28, 0x2f, 0x23, 0x24, 0x25, 0x22, 0x2e, 0x29, 0x36, 0x31, 0x3d, 0x3a,
+     0x06, 0x01, 0x0d, 0x0a, 0x15, 0x12, 0x1e, 0x19, 0x28, 0x2f, 0x23, 0x24,
+     0x3b, 0x3c, 0x30, 0x37, 0x0b, 0x0c, 0x00, 0x07, 0x18, 0x1f, 0x13, 0x14,
+     0x30, 0x37, 0x3b, 0x3c, 0x23, 0x24, 0x28, 0x2f, 0x13, 0x14, 0x18, 0x1f,
+     0x00, 0x07, 0x0b, 0x0c, 0x3d, 0x3a, 0x36, 0x31, 0x2e, 0x29, 0x25, 0x22,
+     0x1e, 0x19, 0x15, 0x12, 0x0d, 0x0a, 0x06, 0x01, 0x19, 0x1e, 0x12, 0x15,
+     0x0a, 0x0d, 0x01, 0x06, 0x3a, 0x3d, 0x31, 0x36, 0x29, 0x2e, 0x22, 0x25,
+     0x14, 0x13, 0x1f, 0x18, 0x07, 0x00, 0x0c, 0x0b, 0x37, 0x30, 0x3c, 0x3b,
+     0x24, 0x23, 0x2f, 0x28, 0x0c, 0x0b, 0x07, 0x00, 0x1f, 0x18, 0x14, 0x13,
+     0x2f, 0x28, 0x24, 0x23, 0x3c, 0x3b, 0x37, 0x30, 0x01, 0x06, 0x0a, 0x0d,
+     0x12, 0x15, 0x19, 0x1e, 0x22, 0x25, 0x29, 0x2e, 0x31, 0x36, 0x3a, 0x3d,
+     0x3c, 0x3b, 0x37, 0x30, 0x2f, 0x28, 0x24, 0x23, 0x1f, 0x18, 0x14, 0x13,
+     0x0c, 0x0b, 0x07, 0x00, 0x31, 0x36, 0x3a, 0x3d, 0x22, 0x25, 0x29, 0x2e,
+     0x12, 0x15, 0x19, 0x1e, 0x01, 0x06, 0x0a, 0x0d, 0x29, 0x2e, 0x22, 0x25,
+     0x3a, 0x3d, 0x31, 0x36, 0x0a, 0x0d, 0x01, 0x06, 0x19, 0x1e, 0x12, 0x15,
+     0x24, 0x23, 0x2f, 0x28, 0x37, 0x30, 0x3c, 0x3b, 0x07, 0x00, 0x0c, 0x0b,
+     0x14, 0x13, 0x1f, 0x18},
+    {0x00, 0x29, 0x31, 0x18, 0x0e, 0x27, 0x3f, 0x16, 0x16, 0x3f, 0x27, 0x0e,
+     0x18, 0x31, 0x29, 0x00, 0x26, 0x0f, 0x17, 0x3e, 0x28, 0x01, 0x19, 0x30,
+     0x30, 0x19, 0x01, 0x28, 0x3e, 0x17, 0x0f, 0x26, 0x1a, 0x33, 0x2b, 0x02,
+     0x14, 0x3d, 0x25, 0x0c, 0x0c, 0x25, 0x3d, 0x14, 0x02, 0x2b, 0x33, 0x1a,
+     0x3c, 0x15, 0x0d, 0x24, 0x32, 0x1b, 0x03, 0x2a, 0x2a, 0x03, 0x1b, 0x32,
+     0x24, 0x0d, 0x15, 0x3c, 0x2a, 0x03, 0x1b, 0x32, 0x24, 0x0d, 0x15, 0x3c,
+     0x3c, 0x15, 0x0d, 0x24, 0x32, 0x1b, 0x03, 0x2a, 0x0c, 0x25, 0x3d, 0x14,
+     0x02, 0x2b, 0x33, 0x1a, 0x1a, 0x33, 0x2b, 0x02, 0x14, 0x3d, 0x25, 0x0c,
+     0x30, 0x19, 0x01, 0x28, 0x3e, 0x17, 0x0f, 0x26, 0x26, 0x0f, 0x17, 0x3e,
+     0x28, 0x01, 0x19, 0x30, 0x16, 0x3f, 0x27, 0x0e, 0x18, 0x31, 0x29, 0x00,
+     0x00, 0x29, 0x31, 0x18, 0x0e, 0x27, 0x3f, 0x16, 0x32, 0x1b, 0x03, 0x2a,
+     0x3c, 0x15, 0x0d, 0x24, 0x24, 0x0d, 0x15, 0x3c, 0x2a, 0x03, 0x1b, 0x32,
+     0x14, 0x3d, 0x25, 0x0c, 0x1a, 0x33, 0x2b, 0x02, 0x02, 0x2b, 0x33, 0x1a,
+     0x0c, 0x25, 0x3d, 0x14, 0x28, 0x01, 0x19, 0x30, 0x26, 0x0f, 0x17, 0x3e,
+     0x3e, 0x17, 0x0f, 0x26, 0x30, 0x19, 0x01, 0x28, 0x0e, 0x27, 0x3f, 0x16,
+     0x00, 0x29, 0x31, 0x18, 0x18, 0x31, 0x29, 0x00, 0x16, 0x3f, 0x27, 0x0e,
+     0x18, 0x31, 0x29, 0x00, 0x16, 0x3f, 0x27, 0x0e, 0x0e, 0x27, 0x3f, 0x16,
+     0x00, 0x29, 0x31, 0x18, 0x3e, 0x17, 0x0f, 0x26, 0x30, 0x19, 0x01, 0x28,
+     0x28, 0x01, 0x19, 0x30, 0x26, 0x0f, 0x17, 0x3e, 0x02, 0x2b, 0x33, 0x1a,
+     0x0c, 0x25, 0x3d, 0x14, 0x14, 0x3d, 0x25, 0x0c, 0x1a, 0x33, 0x2b, 0x02,
+     0x24, 0x0d, 0x15, 0x3c, 0x2a, 0x03, 0x1b, 0x32, 0x32, 0x1b, 0x03, 0x2a,
+     0x3c, 0x15, 0x0d, 0x24},
+    {0x00, 0x1c, 0x2c, 0x30, 0x34, 0x28, 0x18, 0x04, 0x38, 0x24, 0x14, 0x08,
+     0x0c, 0x10, 0x20, 0x3c, 0x3b, 0x27, 0x17, 0x0b, 0x0f, 0x13, 0x23, 0x3f,
+     0x03, 0x1f, 0x2f, 0x33, 0x37, 0x2b, 0x1b, 0x07, 0x3d, 0x21, 0x11, 0x0d,
+     0x09, 0x15, 0x25, 0x39, 0x05, 0x19, 0x29, 0x35, 0x31, 0x2d, 0x1d, 0x01,
+     0x06, 0x1a, 0x2a, 0x36, 0x32, 0x2e, 0x1e, 0x02, 0x3e, 0x22, 0x12, 0x0e,
+     0x0a, 0x16, 0x26, 0x3a, 0x00, 0x1c, 0x2c, 0x30, 0x34, 0x28, 0x18, 0x04,
+     0x38, 0x24, 0x14, 0x08, 0x0c, 0x10, 0x20, 0x3c, 0x3b, 0x27, 0x17, 0x0b,
+     0x0f, 0x13, 0x23, 0x3f, 0x03, 0x1f, 0x2f, 0x33, 0x37, 0x2b, 0x1b, 0x07,
+     0x3d, 0x21, 0x11, 0x0d, 0x09, 0x15, 0x25, 0x39, 0x05, 0x19, 0x29, 0x35,
+     0x31, 0x2d, 0x1d, 0x01, 0x06, 0x1a, 0x2a, 0x36, 0x32, 0x2e, 0x1e, 0x02,
+     0x3e, 0x22, 0x12, 0x0e, 0x0a, 0x16, 0x26, 0x3a, 0x00, 0x1c, 0x2c, 0x30,
+     0x34, 0x28, 0x18, 0x04, 0x38, 0x24, 0x14, 0x08, 0x0c, 0x10, 0x20, 0x3c,
+     0x3b, 0x27, 0x17, 0x0b, 0x0f, 0x13, 0x23, 0x3f, 0x03, 0x1f, 0x2f, 0x33,
+     0x37, 0x2b, 0x1b, 0x07, 0x3d, 0x21, 0x11, 0x0d, 0x09, 0x15, 0x25, 0x39,
+     0x05, 0x19, 0x29, 0x35, 0x31, 0x2d, 0x1d, 0x01, 0x06, 0x1a, 0x2a, 0x36,
+     0x32, 0x2e, 0x1e, 0x02, 0x3e, 0x22, 0x12, 0x0e, 0x0a, 0x16, 0x26, 0x3a,
+     0x00, 0x1c, 0x2c, 0x30, 0x34, 0x28, 0x18, 0x04, 0x38, 0x24, 0x14, 0x08,
+     0x0c, 0x10, 0x20, 0x3c, 0x3b, 0x27, 0x17, 0x0b, 0x0f, 0x13, 0x23, 0x3f,
+     0x03, 0x1f, 0x2f, 0x33, 0x37, 0x2b, 0x1b, 0x07, 0x3d, 0x21, 0x11, 0x0d,
+     0x09, 0x15, 0x25, 0x39, 0x05, 0x19, 0x29, 0x35, 0x31, 0x2d, 0x1d, 0x01,
+     0x06, 0x1a, 0x2a, 0x36, 0x32, 0x2e, 0x1e, 0x02, 0x3e, 0x22, 0x12, 0x0e,
+     0x0a, 0x16, 0x26, 0x3a},
+};
+
+static const uint8_t kColsHsiao28_22[22] = {
+    0x07, 0x0b, 0x13, 0x23, 0x0d, 0x15, 0x25, 0x19, 0x29, 0x31, 0x0e, 0x16,
+    0x26, 0x1a, 0x2a, 0x32, 0x1c, 0x2c, 0x34, 0x38, 0x3b, 0x3d,
+};
+
 uint8_t enc_secded_28_22(const uint8_t bytes[3]) {
-  uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
-                  ((uint32_t)bytes[2] << 16);
+  return encode(kEncHsiao28_22, bytes, 3);
+}
 
-  return (calc_parity(word & 0x3003ff, false) << 0) |
-         (calc_parity(word & 0x10fc0f, false) << 1) |
-         (calc_parity(word & 0x271c71, false) << 2) |
-         (calc_parity(word & 0x3b6592, false) << 3) |
-         (calc_parity(word & 0x3daaa4, false) << 4) |
-         (calc_parity(word & 0x3ed348, false) << 5);
+uint8_t dec_secded_28_22(uint8_t bytes[3], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_28_22(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  correct(bytes, syndrome, kColsHsiao28_22, 22);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_28_22_buf(const uint8_t *data, uint8_t *ecc, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_28_22(&data[3 * i]);
+  }
 }
 
+uint8_t dec_secded_28_22_buf(uint8_t *data, const uint8_t *ecc, size_t count,
+                             uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_28_22(&data[3 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
+}
+
+static const uint8_t kEncHsiao39_32[4][256] = {
+    {0x00, 0x19, 0x54, 0x4d, 0x61, 0x78, 0x35, 0x2c, 0x34, 0x2d, 0x60, 0x79,
+     0x55, 0x4c, 0x01, 0x18, 0x1a, 0x03, 0x4e, 0x57, 0x7b, 0x62, 0x2f, 0x36,
+     0x2e, 0x37, 0x7a, 0x63, 0x4f, 0x56, 0x1b, 0x02, 0x15, 0x0c, 0x41, 0x58,
+     0x74, 0x6d, 0x20, 0x39, 0x21, 0x38, 0x75, 0x6c, 0x40, 0x59, 0x14, 0x0d,
+     0x0f, 0x16, 0x5b, 0x42, 0x6e, 0x77, 0x3a, 0x23, 0x3b, 0x22, 0x6f, 0x76,
+     0x5a, 0x43, 0x0e, 0x17, 0x2a, 0x33, 0x7e, 0x67, 0x4b, 0x52, 0x1f, 0x06,
+     0x1e, 0x07, 0x4a, 0x53, 0x7f, 0x66, 0x2b, 0x32, 0x30, 0x29, 0x64, 0x7d,
+     0x51, 0x48, 0x05, 0x1c, 0x04, 0x1d, 0x50, 0x49, 0x65, 0x7c, 0x31, 0x28,
+     0x3f, 0x26, 0x6b, 0x72, 0x5e, 0x47, 0x0a, 0x13, 0x0b, 0x12, 0x5f, 0x46,
+     0x6a, 0x73, 0x3e, 0x27, 0x25, 0x3c, 0x71, 0x68, 0x44, 0x5d, 0x10, 0x09,
+     0x11, 0x08, 0x45, 0x5c, 0x70, 0x69, 0x24, 0x3d, 0x4c, 0x55, 0x18, 0x01,
+     0x2d, 0x34, 0x79, 0x60, 0x78, 0x61, 0x2c, 0x35, 0x19, 0x00, 0x4d, 0x54,
+     0x56, 0x4f, 0x02, 0x1b, 0x37, 0x2e, 0x63, 0x7a, 0x62, 0x7b, 0x36, 0x2f,
+     0x03, 0x1a, 0x57, 0x4e, 0x59, 0x40, 0x0d, 0x14, 0x38, 0x21, 0x6c, 0x75,
+     0x6d, 0x74, 0x39, 0x20, 0x0c, 0x15, 0x58, 0x41, 0x43, 0x5a, 0x17, 0x0e,
+     0x22, 0x3b, 0x76, 0x6f, 0x77, 0x6e, 0x23, 0x3a, 0x16, 0x0f, 0x42, 0x5b,
+     0x66, 0x7f, 0x32, 0x2b, 0x07, 0x1e, 0x53, 0x4a, 0x52, 0x4b, 0x06, 0x1f,
+     0x33, 0x2a, 0x67, 0x7e, 0x7c, 0x65, 0x28, 0x31, 0x1d, 0x04, 0x49, 0x50,
+     0x48, 0x51, 0x1c, 0x05, 0x29, 0x30, 0x7d, 0x64, 0x73, 0x6a, 0x27, 0x3e,
+     0x12, 0x0b, 0x46, 0x5f, 0x47, 0x5e, 0x13, 0x0a, 0x26, 0x3f, 0x72, 0x6b,
+     0x69, 0x70, 0x3d, 0x24, 0x08, 0x11, 0x5c, 0x45, 0x5d, 0x44, 0x09, 0x10,
+     0x3c, 0x25, 0x68, 0x71},
+    {0x00, 0x45, 0x38, 0x7d, 0x49, 0x0c, 0x71, 0x34, 0x0d, 0x48, 0x35, 0x70,
+     0x44, 0x01, 0x7c, 0x39, 0x51, 0x14, 0x69, 0x2c, 0x18, 0x5d, 0x20, 0x65,
+     0x5c, 0x19, 0x64, 0x21, 0x15, 0x50, 0x2d, 0x68, 0x31, 0x74, 0x09, 0x4c,
+     0x78, 0x3d, 0x40, 0x05, 0x3c, 0x79, 0x04, 0x41, 0x75, 0x30, 0x4d, 0x08,
+     0x60, 0x25, 0x58, 0x1d, 0x29, 0x6c, 0x11, 0x54, 0x6d, 0x28, 0x55, 0x10,
+     0x24, 0x61, 0x1c, 0x59, 0x68, 0x2d, 0x50, 0x15, 0x21, 0x64, 0x19, 0x5c,
+     0x65, 0x20, 0x5d, 0x18, 0x2c, 0x69, 0x14, 0x51, 0x39, 0x7c, 0x01, 0x44,
+     0x70, 0x35, 0x48, 0x0d, 0x34, 0x71, 0x0c, 0x49, 0x7d, 0x38, 0x45, 0x00,
+     0x59, 0x1c, 0x61, 0x24, 0x10, 0x55, 0x28, 0x6d, 0x54, 0x11, 0x6c, 0x29,
+     0x1d, 0x58, 0x25, 0x60, 0x08, 0x4d, 0x30, 0x75, 0x41, 0x04, 0x79, 0x3c,
+     0x05, 0x40, 0x3d, 0x78, 0x4c, 0x09, 0x74, 0x31, 0x07, 0x42, 0x3f, 0x7a,
+     0x4e, 0x0b, 0x76, 0x33, 0x0a, 0x4f, 0x32, 0x77, 0x43, 0x06, 0x7b, 0x3e,
+     0x56, 0x13, 0x6e, 0x2b, 0x1f, 0x5a, 0x27, 0x62, 0x5b, 0x1e, 0x63, 0x26,
+     0x12, 0x57, 0x2a, 0x6f, 0x36, 0x73, 0x0e, 0x4b, 0x7f, 0x3a, 0x47, 0x02,
+     0x3b, 0x7e, 0x03, 0x46, 0x72, 0x37, 0x4a, 0x0f, 0x67, 0x22, 0x5f, 0x1a,
+     0x2e, 0x6b, 0x16, 0x53, 0x6a, 0x2f, 0x52, 0x17, 0x23, 0x66, 0x1b, 0x5e,
+     0x6f, 0x2a, 0x57, 0x12, 0x26, 0x63, 0x1e, 0x5b, 0x62, 0x27, 0x5a, 0x1f,
+     0x2b, 0x6e, 0x13, 0x56, 0x3e, 0x7b, 0x06, 0x43, 0x77, 0x32, 0x4f, 0x0a,
+     0x33, 0x76, 0x0b, 0x4e, 0x7a, 0x3f, 0x42, 0x07, 0x5e, 0x1b, 0x66, 0x23,
+     0x17, 0x52, 0x2f, 0x6a, 0x53, 0x16, 0x6b, 0x2e, 0x1a, 0x5f, 0x22, 0x67,
+     0x0f, 0x4a, 0x37, 0x72, 0x46, 0x03, 0x7e, 0x3b, 0x02, 0x47, 0x3a, 0x7f,
+     0x4b, 0x0e, 0x73, 0x36},
+    {0x00, 0x1c, 0x0b, 0x17, 0x25, 0x39, 0x2e, 0x32, 0x26, 0x3a, 0x2d, 0x31,
+     0x03, 0x1f, 0x08, 0x14, 0x46, 0x5a, 0x4d, 0x51, 0x63, 0x7f, 0x68, 0x74,
+     0x60, 0x7c, 0x6b, 0x77, 0x45, 0x59, 0x4e, 0x52, 0x0e, 0x12, 0x05, 0x19,
+     0x2b, 0x37, 0x20, 0x3c, 0x28, 0x34, 0x23, 0x3f, 0x0d, 0x11, 0x06, 0x1a,
+     0x48, 0x54, 0x43, 0x5f, 0x6d, 0x71, 0x66, 0x7a, 0x6e, 0x72, 0x65, 0x79,
+     0x4b, 0x57, 0x40, 0x5c, 0x70, 0x6c, 0x7b, 0x67, 0x55, 0x49, 0x5e, 0x42,
+     0x56, 0x4a, 0x5d, 0x41, 0x73, 0x6f, 0x78, 0x64, 0x36, 0x2a, 0x3d, 0x21,
+     0x13, 0x0f, 0x18, 0x04, 0x10, 0x0c, 0x1b, 0x07, 0x35, 0x29, 0x3e, 0x22,
+     0x7e, 0x62, 0x75, 0x69, 0x5b, 0x47, 0x50, 0x4c, 0x58, 0x44, 0x53, 0x4f,
+     0x7d, 0x61, 0x76, 0x6a, 0x38, 0x24, 0x33, 0x2f, 0x1d, 0x01, 0x16, 0x0a,
+     0x1e, 0x02, 0x15, 0x09, 0x3b, 0x27, 0x30, 0x2c, 0x32, 0x2e, 0x39, 0x25,
+     0x17, 0x0b, 0x1c, 0x00, 0x14, 0x08, 0x1f, 0x03, 0x31, 0x2d, 0x3a, 0x26,
+     0x74, 0x68, 0x7f, 0x63, 0x51, 0x4d, 0x5a, 0x46, 0x52, 0x4e, 0x59, 0x45,
+     0x77, 0x6b, 0x7c, 0x60, 0x3c, 0x20, 0x37, 0x2b, 0x19, 0x05, 0x12, 0x0e,
+     0x1a, 0x06, 0x11, 0x0d, 0x3f, 0x23, 0x34, 0x28, 0x7a, 0x66, 0x71, 0x6d,
+     0x5f, 0x43, 0x54, 0x48, 0x5c, 0x40, 0x57, 0x4b, 0x79, 0x65, 0x72, 0x6e,
+     0x42, 0x5e, 0x49, 0x55, 0x67, 0x7b, 0x6c, 0x70, 0x64, 0x78, 0x6f, 0x73,
+     0x41, 0x5d, 0x4a, 0x56, 0x04, 0x18, 0x0f, 0x13, 0x21, 0x3d, 0x2a, 0x36,
+     0x22, 0x3e, 0x29, 0x35, 0x07, 0x1b, 0x0c, 0x10, 0x4c, 0x50, 0x47, 0x5b,
+     0x69, 0x75, 0x62, 0x7e, 0x6a, 0x76, 0x61, 0x7d, 0x4f, 0x53, 0x44, 0x58,
+     0x0a, 0x16, 0x01, 0x1d, 0x2f, 0x33, 0x24, 0x38, 0x2c, 0x30, 0x27, 0x3b,
+     0x09, 0x15, 0x02, 0x1e},
+    {0x00, 0x2c, 0x13, 0x3f, 0x23, 0x0f, 0x30, 0x1c, 0x62, 0x4e, 0x71, 0x5d,
+     0x41, 0x6d, 0x52, 0x7e, 0x4a, 0x66, 0x59, 0x75, 0x69, 0x45, 0x7a, 0x56,
+     0x28, 0x04, 0x3b, 0x17, 0x0b, 0x27, 0x18, 0x34, 0x29, 0x05, 0x3a, 0x16,
+     0x0a, 0x26, 0x19, 0x35, 0x4b, 0x67, 0x58, 0x74, 0x68, 0x44, 0x7b, 0x57,
+     0x63, 0x4f, 0x70, 0x5c, 0x40, 0x6c, 0x53, 0x7f, 0x01, 0x2d, 0x12, 0x3e,
+     0x22, 0x0e, 0x31, 0x1d, 0x16, 0x3a, 0x05, 0x29, 0x35, 0x19, 0x26, 0x0a,
+     0x74, 0x58, 0x67, 0x4b, 0x57, 0x7b, 0x44, 0x68, 0x5c, 0x70, 0x4f, 0x63,
+     0x7f, 0x53, 0x6c, 0x40, 0x3e, 0x12, 0x2d, 0x01, 0x1d, 0x31, 0x0e, 0x22,
+     0x3f, 0x13, 0x2c, 0x00, 0x1c, 0x30, 0x0f, 0x23, 0x5d, 0x71, 0x4e, 0x62,
+     0x7e, 0x52, 0x6d, 0x41, 0x75, 0x59, 0x66, 0x4a, 0x56, 0x7a, 0x45, 0x69,
+     0x17, 0x3b, 0x04, 0x28, 0x34, 0x18, 0x27, 0x0b, 0x52, 0x7e, 0x41, 0x6d,
+     0x71, 0x5d, 0x62, 0x4e, 0x30, 0x1c, 0x23, 0x0f, 0x13, 0x3f, 0x00, 0x2c,
+     0x18, 0x34, 0x0b, 0x27, 0x3b, 0x17, 0x28, 0x04, 0x7a, 0x56, 0x69, 0x45,
+     0x59, 0x75, 0x4a, 0x66, 0x7b, 0x57, 0x68, 0x44, 0x58, 0x74, 0x4b, 0x67,
+     0x19, 0x35, 0x0a, 0x26, 0x3a, 0x16, 0x29, 0x05, 0x31, 0x1d, 0x22, 0x0e,
+     0x12, 0x3e, 0x01, 0x2d, 0x53, 0x7f, 0x40, 0x6c, 0x70, 0x5c, 0x63, 0x4f,
+     0x44, 0x68, 0x57, 0x7b, 0x67, 0x4b, 0x74, 0x58, 0x26, 0x0a, 0x35, 0x19,
+     0x05, 0x29, 0x16, 0x3a, 0x0e, 0x22, 0x1d, 0x31, 0x2d, 0x01, 0x3e, 0x12,
+     0x6c, 0x40, 0x7f, 0x53, 0x4f, 0x63, 0x5c, 0x70, 0x6d, 0x41, 0x7e, 0x52,
+     0x4e, 0x62, 0x5d, 0x71, 0x0f, 0x23, 0x1c, 0x30, 0x2c, 0x00, 0x3f, 0x13,
+     0x27, 0x0b, 0x34, 0x18, 0x04, 0x28, 0x17, 0x3b, 0x45, 0x69, 0x56, 0x7a,
+     0x66, 0x4a, 0x75, 0x59},
+};
+
+static const uint8_t kColsHsiao39_32[32] = {
+    0x19, 0x54, 0x61, 0x34, 0x1a, 0x15, 0x2a, 0x4c, 0x45, 0x38, 0x49, 0x0d,
+    0x51, 0x31, 0x68, 0x07, 0x1c, 0x0b, 0x25, 0x26, 0x46, 0x0e, 0x70, 0x32,
+    0x2c, 0x13, 0x23, 0x62, 0x4a, 0x29, 0x16, 0x52,
+};
+
 uint8_t enc_secded_39_32(const uint8_t bytes[4]) {
-  uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
-                  ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+  return encode(kEncHsiao39_32, bytes, 4);
+}
 
-  return (calc_parity(word & 0x2606bd25, false) << 0) |
-         (calc_parity(word & 0xdeba8050, false) << 1) |
-         (calc_parity(word & 0x413d89aa, false) << 2) |
-         (calc_parity(word & 0x31234ed1, false) << 3) |
-         (calc_parity(word & 0xc2c1323b, false) << 4) |
-         (calc_parity(word & 0x2dcc624c, false) << 5) |
-         (calc_parity(word & 0x98505586, false) << 6);
+uint8_t dec_secded_39_32(uint8_t bytes[4], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_39_32(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  correct(bytes, syndrome, kColsHsiao39_32, 32);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_39_32_buf(const uint8_t *data, uint8_t *ecc, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_39_32(&data[4 * i]);
+  }
+}
+
+uint8_t dec_secded_39_32_buf(uint8_t *data, const uint8_t *ecc, size_t count,
+                             uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_39_32(&data[4 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
 }
 
+static const uint8_t kEncHsiao64_57[8][256] = {
+    {0x00, 0x07, 0x0b, 0x0c, 0x13, 0x14, 0x18, 0x1f, 0x23, 0x24, 0x28, 0x2f,
+     0x30, 0x37, 0x3b, 0x3c, 0x43, 0x44, 0x48, 0x4f, 0x50, 0x57, 0x5b, 0x5c,
+     0x60, 0x67, 0x6b, 0x6c, 0x73, 0x74, 0x78, 0x7f, 0x0d, 0x0a, 0x06, 0x01,
+     0x1e, 0x19, 0x15, 0x12, 0x2e, 0x29, 0x25, 0x22, 0x3d, 0x3a, 0x36, 0x31,
+     0x4e, 0x49, 0x45, 0x42, 0x5d, 0x5a, 0x56, 0x51, 0x6d, 0x6a, 0x66, 0x61,
+     0x7e, 0x79, 0x75, 0x72, 0x15, 0x12, 0x1e, 0x19, 0x06, 0x01, 0x0d, 0x0a,
+     0x36, 0x31, 0x3d, 0x3a, 0x25, 0x22, 0x2e, 0x29, 0x56, 0x51, 0x5d, 0x5a,
+     0x45, 0x42, 0x4e, 0x49, 0x75, 0x72, 0x7e, 0x79, 0x66, 0x61, 0x6d, 0x6a,
+     0x18, 0x1f, 0x13, 0x14, 0x0b, 0x0c, 0x00, 0x07, 0x3b, 0x3c, 0x30, 0x37,
+     0x28, 0x2f, 0x23, 0x24, 0x5b, 0x5c, 0x50, 0x57, 0x48, 0x4f, 0x43, 0x44,
+     0x78, 0x7f, 0x73, 0x74, 0x6b, 0x6c, 0x60, 0x67, 0x25, 0x22, 0x2e, 0x29,
+     0x36, 0x31, 0x3d, 0x3a, 0x06, 0x01, 0x0d, 0x0a, 0x15, 0x12, 0x1e, 0x19,
+     0x66, 0x61, 0x6d, 0x6a, 0x75, 0x72, 0x7e, 0x79, 0x45, 0x42, 0x4e, 0x49,
+     0x56, 0x51, 0x5d, 0x5a, 0x28, 0x2f, 0x23, 0x24, 0x3b, 0x3c, 0x30, 0x37,
+     0x0b, 0x0c, 0x00, 0x07, 0x18, 0x1f, 0x13, 0x14, 0x6b, 0x6c, 0x60, 0x67,
+     0x78, 0x7f, 0x73, 0x74, 0x48, 0x4f, 0x43, 0x44, 0x5b, 0x5c, 0x50, 0x57,
+     0x30, 0x37, 0x3b, 0x3c, 0x23, 0x24, 0x28, 0x2f, 0x13, 0x14, 0x18, 0x1f,
+     0x00, 0x07, 0x0b, 0x0c, 0x73, 0x74, 0x78, 0x7f, 0x60, 0x67, 0x6b, 0x6c,
+     0x50, 0x57, 0x5b, 0x5c, 0x43, 0x44, 0x48, 0x4f, 0x3d, 0x3a, 0x36, 0x31,
+     0x2e, 0x29, 0x25, 0x22, 0x1e, 0x19, 0x15, 0x12, 0x0d, 0x0a, 0x06, 0x01,
+     0x7e, 0x79, 0x75, 0x72, 0x6d, 0x6a, 0x66, 0x61, 0x5d, 0x5a, 0x56, 0x51,
+     0x4e, 0x49, 0x45, 0x42},
+    {0x00, 0x45, 0x19, 0x5c, 0x29, 0x6c, 0x30, 0x75, 0x49, 0x0c, 0x50, 0x15,
+     0x60, 0x25, 0x79, 0x3c, 0x31, 0x74, 0x28, 0x6d, 0x18, 0x5d, 0x01, 0x44,
+     0x78, 0x3d, 0x61, 0x24, 0x51, 0x14, 0x48, 0x0d, 0x51, 0x14, 0x48, 0x0d,
+     0x78, 0x3d, 0x61, 0x24, 0x18, 0x5d, 0x01, 0x44, 0x31, 0x74, 0x28, 0x6d,
+     0x60, 0x25, 0x79, 0x3c, 0x49, 0x0c, 0x50, 0x15, 0x29, 0x6c, 0x30, 0x75,
+     0x00, 0x45, 0x19, 0x5c, 0x61, 0x24, 0x78, 0x3d, 0x48, 0x0d, 0x51, 0x14,
+     0x28, 0x6d, 0x31, 0x74, 0x01, 0x44, 0x18, 0x5d, 0x50, 0x15, 0x49, 0x0c,
+     0x79, 0x3c, 0x60, 0x25, 0x19, 0x5c, 0x00, 0x45, 0x30, 0x75, 0x29, 0x6c,
+     0x30, 0x75, 0x29, 0x6c, 0x19, 0x5c, 0x00, 0x45, 0x79, 0x3c, 0x60, 0x25,
+     0x50, 0x15, 0x49, 0x0c, 0x01, 0x44, 0x18, 0x5d, 0x28, 0x6d, 0x31, 0x74,
+     0x48, 0x0d, 0x51, 0x14, 0x61, 0x24, 0x78, 0x3d, 0x0e, 0x4b, 0x17, 0x52,
+     0x27, 0x62, 0x3e, 0x7b, 0x47, 0x02, 0x5e, 0x1b, 0x6e, 0x2b, 0x77, 0x32,
+     0x3f, 0x7a, 0x26, 0x63, 0x16, 0x53, 0x0f, 0x4a, 0x76, 0x33, 0x6f, 0x2a,
+     0x5f, 0x1a, 0x46, 0x03, 0x5f, 0x1a, 0x46, 0x03, 0x76, 0x33, 0x6f, 0x2a,
+     0x16, 0x53, 0x0f, 0x4a, 0x3f, 0x7a, 0x26, 0x63, 0x6e, 0x2b, 0x77, 0x32,
+     0x47, 0x02, 0x5e, 0x1b, 0x27, 0x62, 0x3e, 0x7b, 0x0e, 0x4b, 0x17, 0x52,
+     0x6f, 0x2a, 0x76, 0x33, 0x46, 0x03, 0x5f, 0x1a, 0x26, 0x63, 0x3f, 0x7a,
+     0x0f, 0x4a, 0x16, 0x53, 0x5e, 0x1b, 0x47, 0x02, 0x77, 0x32, 0x6e, 0x2b,
+     0x17, 0x52, 0x0e, 0x4b, 0x3e, 0x7b, 0x27, 0x62, 0x3e, 0x7b, 0x27, 0x62,
+     0x17, 0x52, 0x0e, 0x4b, 0x77, 0x32, 0x6e, 0x2b, 0x5e, 0x1b, 0x47, 0x02,
+     0x0f, 0x4a, 0x16, 0x53, 0x26, 0x63, 0x3f, 0x7a, 0x46, 0x03, 0x5f, 0x1a,
+     0x6f, 0x2a, 0x76, 0x33},
+    {0x00, 0x16, 0x26, 0x30, 0x46, 0x50, 0x60, 0x76, 0x1a, 0x0c, 0x3c, 0x2a,
+     0x5c, 0x4a, 0x7a, 0x6c, 0x2a, 0x3c, 0x0c, 0x1a, 0x6c, 0x7a, 0x4a, 0x5c,
+     0x30, 0x26, 0x16, 0x00, 0x76, 0x60, 0x50, 0x46, 0x4a, 0x5c, 0x6c, 0x7a,
+     0x0c, 0x1a, 0x2a, 0x3c, 0x50, 0x46, 0x76, 0x60, 0x16, 0x00, 0x30, 0x26,
+     0x60, 0x76, 0x46, 0x50, 0x26, 0x30, 0x00, 0x16, 0x7a, 0x6c, 0x5c, 0x4a,
+     0x3c, 0x2a, 0x1a, 0x0c, 0x32, 0x24, 0x14, 0x02, 0x74, 0x62, 0x52, 0x44,
+     0x28, 0x3e, 0x0e, 0x18, 0x6e, 0x78, 0x48, 0x5e, 0x18, 0x0e, 0x3e, 0x28,
+     0x5e, 0x48, 0x78, 0x6e, 0x02, 0x14, 0x24, 0x32, 0x44, 0x52, 0x62, 0x74,
+     0x78, 0x6e, 0x5e, 0x48, 0x3e, 0x28, 0x18, 0x0e, 0x62, 0x74, 0x44, 0x52,
+     0x24, 0x32, 0x02, 0x14, 0x52, 0x44, 0x74, 0x62, 0x14, 0x02, 0x32, 0x24,
+     0x48, 0x5e, 0x6e, 0x78, 0x0e, 0x18, 0x28, 0x3e, 0x52, 0x44, 0x74, 0x62,
+     0x14, 0x02, 0x32, 0x24, 0x48, 0x5e, 0x6e, 0x78, 0x0e, 0x18, 0x28, 0x3e,
+     0x78, 0x6e, 0x5e, 0x48, 0x3e, 0x28, 0x18, 0x0e, 0x62, 0x74, 0x44, 0x52,
+     0x24, 0x32, 0x02, 0x14, 0x18, 0x0e, 0x3e, 0x28, 0x5e, 0x48, 0x78, 0x6e,
+     0x02, 0x14, 0x24, 0x32, 0x44, 0x52, 0x62, 0x74, 0x32, 0x24, 0x14, 0x02,
+     0x74, 0x62, 0x52, 0x44, 0x28, 0x3e, 0x0e, 0x18, 0x6e, 0x78, 0x48, 0x5e,
+     0x60, 0x76, 0x46, 0x50, 0x26, 0x30, 0x00, 0x16, 0x7a, 0x6c, 0x5c, 0x4a,
+     0x3c, 0x2a, 0x1a, 0x0c, 0x4a, 0x5c, 0x6c, 0x7a, 0x0c, 0x1a, 0x2a, 0x3c,
+     0x50, 0x46, 0x76, 0x60, 0x16, 0x00, 0x30, 0x26, 0x2a, 0x3c, 0x0c, 0x1a,
+     0x6c, 0x7a, 0x4a, 0x5c, 0x30, 0x26, 0x16, 0x00, 0x76, 0x60, 0x50, 0x46,
+     0x00, 0x16, 0x26, 0x30, 0x46, 0x50, 0x60, 0x76, 0x1a, 0x0c, 0x3c, 0x2a,
+     0x5c, 0x4a, 0x7a, 0x6c},
+    {0x00, 0x62, 0x1c, 0x7e, 0x2c, 0x4e, 0x30, 0x52, 0x4c, 0x2e, 0x50, 0x32,
+     0x60, 0x02, 0x7c, 0x1e, 0x34, 0x56, 0x28, 0x4a, 0x18, 0x7a, 0x04, 0x66,
+     0x78, 0x1a, 0x64, 0x06, 0x54, 0x36, 0x48, 0x2a, 0x54, 0x36, 0x48, 0x2a,
+     0x78, 0x1a, 0x64, 0x06, 0x18, 0x7a, 0x04, 0x66, 0x34, 0x56, 0x28, 0x4a,
+     0x60, 0x02, 0x7c, 0x1e, 0x4c, 0x2e, 0x50, 0x32, 0x2c, 0x4e, 0x30, 0x52,
+     0x00, 0x62, 0x1c, 0x7e, 0x64, 0x06, 0x78, 0x1a, 0x48, 0x2a, 0x54, 0x36,
+     0x28, 0x4a, 0x34, 0x56, 0x04, 0x66, 0x18, 0x7a, 0x50, 0x32, 0x4c, 0x2e,
+     0x7c, 0x1e, 0x60, 0x02, 0x1c, 0x7e, 0x00, 0x62, 0x30, 0x52, 0x2c, 0x4e,
+     0x30, 0x52, 0x2c, 0x4e, 0x1c, 0x7e, 0x00, 0x62, 0x7c, 0x1e, 0x60, 0x02,
+     0x50, 0x32, 0x4c, 0x2e, 0x04, 0x66, 0x18, 0x7a, 0x28, 0x4a, 0x34, 0x56,
+     0x48, 0x2a, 0x54, 0x36, 0x64, 0x06, 0x78, 0x1a, 0x38, 0x5a, 0x24, 0x46,
+     0x14, 0x76, 0x08, 0x6a, 0x74, 0x16, 0x68, 0x0a, 0x58, 0x3a, 0x44, 0x26,
+     0x0c, 0x6e, 0x10, 0x72, 0x20, 0x42, 0x3c, 0x5e, 0x40, 0x22, 0x5c, 0x3e,
+     0x6c, 0x0e, 0x70, 0x12, 0x6c, 0x0e, 0x70, 0x12, 0x40, 0x22, 0x5c, 0x3e,
+     0x20, 0x42, 0x3c, 0x5e, 0x0c, 0x6e, 0x10, 0x72, 0x58, 0x3a, 0x44, 0x26,
+     0x74, 0x16, 0x68, 0x0a, 0x14, 0x76, 0x08, 0x6a, 0x38, 0x5a, 0x24, 0x46,
+     0x5c, 0x3e, 0x40, 0x22, 0x70, 0x12, 0x6c, 0x0e, 0x10, 0x72, 0x0c, 0x6e,
+     0x3c, 0x5e, 0x20, 0x42, 0x68, 0x0a, 0x74, 0x16, 0x44, 0x26, 0x58, 0x3a,
+     0x24, 0x46, 0x38, 0x5a, 0x08, 0x6a, 0x14, 0x76, 0x08, 0x6a, 0x14, 0x76,
+     0x24, 0x46, 0x38, 0x5a, 0x44, 0x26, 0x58, 0x3a, 0x68, 0x0a, 0x74, 0x16,
+     0x3c, 0x5e, 0x20, 0x42, 0x10, 0x72, 0x0c, 0x6e, 0x70, 0x12, 0x6c, 0x0e,
+     0x5c, 0x3e, 0x40, 0x22},
+    {0x00, 0x58, 0x68, 0x30, 0x70, 0x28, 0x18, 0x40, 0x1f, 0x47, 0x77, 0x2f,
+     0x6f, 0x37, 0x07, 0x5f, 0x2f, 0x77, 0x47, 0x1f, 0x5f, 0x07, 0x37, 0x6f,
+     0x30, 0x68, 0x58, 0x00, 0x40, 0x18, 0x28, 0x70, 0x4f, 0x17, 0x27, 0x7f,
+     0x3f, 0x67, 0x57, 0x0f, 0x50, 0x08, 0x38, 0x60, 0x20, 0x78, 0x48, 0x10,
+     0x60, 0x38, 0x08, 0x50, 0x10, 0x48, 0x78, 0x20, 0x7f, 0x27, 0x17, 0x4f,
+     0x0f, 0x57, 0x67, 0x3f, 0x37, 0x6f, 0x5f, 0x07, 0x47, 0x1f, 0x2f, 0x77,
+     0x28, 0x70, 0x40, 0x18, 0x58, 0x00, 0x30, 0x68, 0x18, 0x40, 0x70, 0x28,
+     0x68, 0x30, 0x00, 0x58, 0x07, 0x5f, 0x6f, 0x37, 0x77, 0x2f, 0x1f, 0x47,
+     0x78, 0x20, 0x10, 0x48, 0x08, 0x50, 0x60, 0x38, 0x67, 0x3f, 0x0f, 0x57,
+     0x17, 0x4f, 0x7f, 0x27, 0x57, 0x0f, 0x3f, 0x67, 0x27, 0x7f, 0x4f, 0x17,
+     0x48, 0x10, 0x20, 0x78, 0x38, 0x60, 0x50, 0x08, 0x57, 0x0f, 0x3f, 0x67,
+     0x27, 0x7f, 0x4f, 0x17, 0x48, 0x10, 0x20, 0x78, 0x38, 0x60, 0x50, 0x08,
+     0x78, 0x20, 0x10, 0x48, 0x08, 0x50, 0x60, 0x38, 0x67, 0x3f, 0x0f, 0x57,
+     0x17, 0x4f, 0x7f, 0x27, 0x18, 0x40, 0x70, 0x28, 0x68, 0x30, 0x00, 0x58,
+     0x07, 0x5f, 0x6f, 0x37, 0x77, 0x2f, 0x1f, 0x47, 0x37, 0x6f, 0x5f, 0x07,
+     0x47, 0x1f, 0x2f, 0x77, 0x28, 0x70, 0x40, 0x18, 0x58, 0x00, 0x30, 0x68,
+     0x60, 0x38, 0x08, 0x50, 0x10, 0x48, 0x78, 0x20, 0x7f, 0x27, 0x17, 0x4f,
+     0x0f, 0x57, 0x67, 0x3f, 0x4f, 0x17, 0x27, 0x7f, 0x3f, 0x67, 0x57, 0x0f,
+     0x50, 0x08, 0x38, 0x60, 0x20, 0x78, 0x48, 0x10, 0x2f, 0x77, 0x47, 0x1f,
+     0x5f, 0x07, 0x37, 0x6f, 0x30, 0x68, 0x58, 0x00, 0x40, 0x18, 0x28, 0x70,
+     0x00, 0x58, 0x68, 0x30, 0x70, 0x28, 0x18, 0x40, 0x1f, 0x47, 0x77, 0x2f,
+     0x6f, 0x37, 0x07, 0x5f},
+    {0x00, 0x67, 0x3b, 0x5c, 0x5b, 0x3c, 0x60, 0x07, 0x6b, 0x0c, 0x50, 0x37,
+     0x30, 0x57, 0x0b, 0x6c, 0x73, 0x14, 0x48, 0x2f, 0x28, 0x4f, 0x13, 0x74,
+     0x18, 0x7f, 0x23, 0x44, 0x43, 0x24, 0x78, 0x1f, 0x3d, 0x5a, 0x06, 0x61,
+     0x66, 0x01, 0x5d, 0x3a, 0x56, 0x31, 0x6d, 0x0a, 0x0d, 0x6a, 0x36, 0x51,
+     0x4e, 0x29, 0x75, 0x12, 0x15, 0x72, 0x2e, 0x49, 0x25, 0x42, 0x1e, 0x79,
+     0x7e, 0x19, 0x45, 0x22, 0x5d, 0x3a, 0x66, 0x01, 0x06, 0x61, 0x3d, 0x5a,
+     0x36, 0x51, 0x0d, 0x6a, 0x6d, 0x0a, 0x56, 0x31, 0x2e, 0x49, 0x15, 0x72,
+     0x75, 0x12, 0x4e, 0x29, 0x45, 0x22, 0x7e, 0x19, 0x1e, 0x79, 0x25, 0x42,
+     0x60, 0x07, 0x5b, 0x3c, 0x3b, 0x5c, 0x00, 0x67, 0x0b, 0x6c, 0x30, 0x57,
+     0x50, 0x37, 0x6b, 0x0c, 0x13, 0x74, 0x28, 0x4f, 0x48, 0x2f, 0x73, 0x14,
+     0x78, 0x1f, 0x43, 0x24, 0x23, 0x44, 0x18, 0x7f, 0x6d, 0x0a, 0x56, 0x31,
+     0x36, 0x51, 0x0d, 0x6a, 0x06, 0x61, 0x3d, 0x5a, 0x5d, 0x3a, 0x66, 0x01,
+     0x1e, 0x79, 0x25, 0x42, 0x45, 0x22, 0x7e, 0x19, 0x75, 0x12, 0x4e, 0x29,
+     0x2e, 0x49, 0x15, 0x72, 0x50, 0x37, 0x6b, 0x0c, 0x0b, 0x6c, 0x30, 0x57,
+     0x3b, 0x5c, 0x00, 0x67, 0x60, 0x07, 0x5b, 0x3c, 0x23, 0x44, 0x18, 0x7f,
+     0x78, 0x1f, 0x43, 0x24, 0x48, 0x2f, 0x73, 0x14, 0x13, 0x74, 0x28, 0x4f,
+     0x30, 0x57, 0x0b, 0x6c, 0x6b, 0x0c, 0x50, 0x37, 0x5b, 0x3c, 0x60, 0x07,
+     0x00, 0x67, 0x3b, 0x5c, 0x43, 0x24, 0x78, 0x1f, 0x18, 0x7f, 0x23, 0x44,
+     0x28, 0x4f, 0x13, 0x74, 0x73, 0x14, 0x48, 0x2f, 0x0d, 0x6a, 0x36, 0x51,
+     0x56, 0x31, 0x6d, 0x0a, 0x66, 0x01, 0x5d, 0x3a, 0x3d, 0x5a, 0x06, 0x61,
+     0x7e, 0x19, 0x45, 0x22, 0x25, 0x42, 0x1e, 0x79, 0x15, 0x72, 0x2e, 0x49,
+     0x4e, 0x29, 0x75, 0x12},
+    {0x00, 0x75, 0x79, 0x0c, 0x3e, 0x4b, 0x47, 0x32, 0x5e, 0x2b, 0x27, 0x52,
+     0x60, 0x15, 0x19, 0x6c, 0x6e, 0x1b, 0x17, 0x62, 0x50, 0x25, 0x29, 0x5c,
+     0x30, 0x45, 0x49, 0x3c, 0x0e, 0x7b, 0x77, 0x02, 0x76, 0x03, 0x0f, 0x7a,
+     0x48, 0x3d, 0x31, 0x44, 0x28, 0x5d, 0x51, 0x24, 0x16, 0x63, 0x6f, 0x1a,
+     0x18, 0x6d, 0x61, 0x14, 0x26, 0x53, 0x5f, 0x2a, 0x46, 0x33, 0x3f, 0x4a,
+     0x78, 0x0d, 0x01, 0x74, 0x7a, 0x0f, 0x03, 0x76, 0x44, 0x31, 0x3d, 0x48,
+     0x24, 0x51, 0x5d, 0x28, 0x1a, 0x6f, 0x63, 0x16, 0x14, 0x61, 0x6d, 0x18,
+     0x2a, 0x5f, 0x53, 0x26, 0x4a, 0x3f, 0x33, 0x46, 0x74, 0x01, 0x0d, 0x78,
+     0x0c, 0x79, 0x75, 0x00, 0x32, 0x47, 0x4b, 0x3e, 0x52, 0x27, 0x2b, 0x5e,
+     0x6c, 0x19, 0x15, 0x60, 0x62, 0x17, 0x1b, 0x6e, 0x5c, 0x29, 0x25, 0x50,
+     0x3c, 0x49, 0x45, 0x30, 0x02, 0x77, 0x7b, 0x0e, 0x7c, 0x09, 0x05, 0x70,
+     0x42, 0x37, 0x3b, 0x4e, 0x22, 0x57, 0x5b, 0x2e, 0x1c, 0x69, 0x65, 0x10,
+     0x12, 0x67, 0x6b, 0x1e, 0x2c, 0x59, 0x55, 0x20, 0x4c, 0x39, 0x35, 0x40,
+     0x72, 0x07, 0x0b, 0x7e, 0x0a, 0x7f, 0x73, 0x06, 0x34, 0x41, 0x4d, 0x38,
+     0x54, 0x21, 0x2d, 0x58, 0x6a, 0x1f, 0x13, 0x66, 0x64, 0x11, 0x1d, 0x68,
+     0x5a, 0x2f, 0x23, 0x56, 0x3a, 0x4f, 0x43, 0x36, 0x04, 0x71, 0x7d, 0x08,
+     0x06, 0x73, 0x7f, 0x0a, 0x38, 0x4d, 0x41, 0x34, 0x58, 0x2d, 0x21, 0x54,
+     0x66, 0x13, 0x1f, 0x6a, 0x68, 0x1d, 0x11, 0x64, 0x56, 0x23, 0x2f, 0x5a,
+     0x36, 0x43, 0x4f, 0x3a, 0x08, 0x7d, 0x71, 0x04, 0x70, 0x05, 0x09, 0x7c,
+     0x4e, 0x3b, 0x37, 0x42, 0x2e, 0x5b, 0x57, 0x22, 0x10, 0x65, 0x69, 0x1c,
+     0x1e, 0x6b, 0x67, 0x12, 0x20, 0x55, 0x59, 0x2c, 0x40, 0x35, 0x39, 0x4c,
+     0x7e, 0x0b, 0x07, 0x72},
+    {0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f,
+     0x00, 0x7f, 0x00, 0x7f},
+};
+
+static const uint8_t kColsHsiao64_57[57] = {
+    0x07, 0x0b, 0x13, 0x23, 0x43, 0x0d, 0x15, 0x25, 0x45, 0x19, 0x29, 0x49,
+    0x31, 0x51, 0x61, 0x0e, 0x16, 0x26, 0x46, 0x1a, 0x2a, 0x4a, 0x32, 0x52,
+    0x62, 0x1c, 0x2c, 0x4c, 0x34, 0x54, 0x64, 0x38, 0x58, 0x68, 0x70, 0x1f,
+    0x2f, 0x4f, 0x37, 0x57, 0x67, 0x3b, 0x5b, 0x6b, 0x73, 0x3d, 0x5d, 0x6d,
+    0x75, 0x79, 0x3e, 0x5e, 0x6e, 0x76, 0x7a, 0x7c, 0x7f,
+};
+
 uint8_t enc_secded_64_57(const uint8_t bytes[8]) {
-  uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
-                  ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
-                  ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
-                  ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+  return encode(kEncHsiao64_57, bytes, 8);
+}
 
-  return (calc_parity(word & 0x103fff800007fff, false) << 0) |
-         (calc_parity(word & 0x17c1ff801ff801f, false) << 1) |
-         (calc_parity(word & 0x1bde1f87e0781e1, false) << 2) |
-         (calc_parity(word & 0x1deee3b8e388e22, false) << 3) |
-         (calc_parity(word & 0x1ef76cdb2c93244, false) << 4) |
-         (calc_parity(word & 0x1f7bb56d5525488, false) << 5) |
-         (calc_parity(word & 0x1fbdda769a46910, false) << 6);
+uint8_t dec_secded_64_57(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_64_57(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  correct(bytes, syndrome, kColsHsiao64_57, 57);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_64_57_buf(const uint8_t *data, uint8_t *ecc, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_64_57(&data[8 * i]);
+  }
 }
 
+uint8_t dec_secded_64_57_buf(uint8_t *data, const uint8_t *ecc, size_t count,
+                             uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_64_57(&data[8 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
+}
+
+static const uint8_t kEncHsiao72_64[8][256] = {
+    {0x00, 0x07, 0x0b, 0x0c, 0x13, 0x14, 0x18, 0x1f, 0x23, 0x24, 0x28, 0x2f,
+     0x30, 0x37, 0x3b, 0x3c, 0x43, 0x44, 0x48, 0x4f, 0x50, 0x57, 0x5b, 0x5c,
+     0x60, 0x67, 0x6b, 0x6c, 0x73, 0x74, 0x78, 0x7f, 0x83, 0x84, 0x88, 0x8f,
+     0x90, 0x97, 0x9b, 0x9c, 0xa0, 0xa7, 0xab, 0xac, 0xb3, 0xb4, 0xb8, 0xbf,
+     0xc0, 0xc7, 0xcb, 0xcc, 0xd3, 0xd4, 0xd8, 0xdf, 0xe3, 0xe4, 0xe8, 0xef,
+     0xf0, 0xf7, 0xfb, 0xfc, 0x0d, 0x0a, 0x06, 0x01, 0x1e, 0x19, 0x15, 0x12,
+     0x2e, 0x29, 0x25, 0x22, 0x3d, 0x3a, 0x36, 0x31, 0x4e, 0x49, 0x45, 0x42,
+     0x5d, 0x5a, 0x56, 0x51, 0x6d, 0x6a, 0x66, 0x61, 0x7e, 0x79, 0x75, 0x72,
+     0x8e, 0x89, 0x85, 0x82, 0x9d, 0x9a, 0x96, 0x91, 0xad, 0xaa, 0xa6, 0xa1,
+     0xbe, 0xb9, 0xb5, 0xb2, 0xcd, 0xca, 0xc6, 0xc1, 0xde, 0xd9, 0xd5, 0xd2,
+     0xee, 0xe9, 0xe5, 0xe2, 0xfd, 0xfa, 0xf6, 0xf1, 0x15, 0x12, 0x1e, 0x19,
+     0x06, 0x01, 0x0d, 0x0a, 0x36, 0x31, 0x3d, 0x3a, 0x25, 0x22, 0x2e, 0x29,
+     0x56, 0x51, 0x5d, 0x5a, 0x45, 0x42, 0x4e, 0x49, 0x75, 0x72, 0x7e, 0x79,
+     0x66, 0x61, 0x6d, 0x6a, 0x96, 0x91, 0x9d, 0x9a, 0x85, 0x82, 0x8e, 0x89,
+     0xb5, 0xb2, 0xbe, 0xb9, 0xa6, 0xa1, 0xad, 0xaa, 0xd5, 0xd2, 0xde, 0xd9,
+     0xc6, 0xc1, 0xcd, 0xca, 0xf6, 0xf1, 0xfd, 0xfa, 0xe5, 0xe2, 0xee, 0xe9,
+     0x18, 0x1f, 0x13, 0x14, 0x0b, 0x0c, 0x00, 0x07, 0x3b, 0x3c, 0x30, 0x37,
+     0x28, 0x2f, 0x23, 0x24, 0x5b, 0x5c, 0x50, 0x57, 0x48, 0x4f, 0x43, 0x44,
+     0x78, 0x7f, 0x73, 0x74, 0x6b, 0x6c, 0x60, 0x67, 0x9b, 0x9c, 0x90, 0x97,
+     0x88, 0x8f, 0x83, 0x84, 0xb8, 0xbf, 0xb3, 0xb4, 0xab, 0xac, 0xa0, 0xa7,
+     0xd8, 0xdf, 0xd3, 0xd4, 0xcb, 0xcc, 0xc0, 0xc7, 0xfb, 0xfc, 0xf0, 0xf7,
+     0xe8, 0xef, 0xe3, 0xe4},
+    {0x00, 0x25, 0x45, 0x60, 0x85, 0xa0, 0xc0, 0xe5, 0x19, 0x3c, 0x5c, 0x79,
+     0x9c, 0xb9, 0xd9, 0xfc, 0x29, 0x0c, 0x6c, 0x49, 0xac, 0x89, 0xe9, 0xcc,
+     0x30, 0x15, 0x75, 0x50, 0xb5, 0x90, 0xf0, 0xd5, 0x49, 0x6c, 0x0c, 0x29,
+     0xcc, 0xe9, 0x89, 0xac, 0x50, 0x75, 0x15, 0x30, 0xd5, 0xf0, 0x90, 0xb5,
+     0x60, 0x45, 0x25, 0x00, 0xe5, 0xc0, 0xa0, 0x85, 0x79, 0x5c, 0x3c, 0x19,
+     0xfc, 0xd9, 0xb9, 0x9c, 0x89, 0xac, 0xcc, 0xe9, 0x0c, 0x29, 0x49, 0x6c,
+     0x90, 0xb5, 0xd5, 0xf0, 0x15, 0x30, 0x50, 0x75, 0xa0, 0x85, 0xe5, 0xc0,
+     0x25, 0x00, 0x60, 0x45, 0xb9, 0x9c, 0xfc, 0xd9, 0x3c, 0x19, 0x79, 0x5c,
+     0xc0, 0xe5, 0x85, 0xa0, 0x45, 0x60, 0x00, 0x25, 0xd9, 0xfc, 0x9c, 0xb9,
+     0x5c, 0x79, 0x19, 0x3c, 0xe9, 0xcc, 0xac, 0x89, 0x6c, 0x49, 0x29, 0x0c,
+     0xf0, 0xd5, 0xb5, 0x90, 0x75, 0x50, 0x30, 0x15, 0x31, 0x14, 0x74, 0x51,
+     0xb4, 0x91, 0xf1, 0xd4, 0x28, 0x0d, 0x6d, 0x48, 0xad, 0x88, 0xe8, 0xcd,
+     0x18, 0x3d, 0x5d, 0x78, 0x9d, 0xb8, 0xd8, 0xfd, 0x01, 0x24, 0x44, 0x61,
+     0x84, 0xa1, 0xc1, 0xe4, 0x78, 0x5d, 0x3d, 0x18, 0xfd, 0xd8, 0xb8, 0x9d,
+     0x61, 0x44, 0x24, 0x01, 0xe4, 0xc1, 0xa1, 0x84, 0x51, 0x74, 0x14, 0x31,
+     0xd4, 0xf1, 0x91, 0xb4, 0x48, 0x6d, 0x0d, 0x28, 0xcd, 0xe8, 0x88, 0xad,
+     0xb8, 0x9d, 0xfd, 0xd8, 0x3d, 0x18, 0x78, 0x5d, 0xa1, 0x84, 0xe4, 0xc1,
+     0x24, 0x01, 0x61, 0x44, 0x91, 0xb4, 0xd4, 0xf1, 0x14, 0x31, 0x51, 0x74,
+     0x88, 0xad, 0xcd, 0xe8, 0x0d, 0x28, 0x48, 0x6d, 0xf1, 0xd4, 0xb4, 0x91,
+     0x74, 0x51, 0x31, 0x14, 0xe8, 0xcd, 0xad, 0x88, 0x6d, 0x48, 0x28, 0x0d,
+     0xd8, 0xfd, 0x9d, 0xb8, 0x5d, 0x78, 0x18, 0x3d, 0xc1, 0xe4, 0x84, 0xa1,
+     0x44, 0x61, 0x01, 0x24},
+    {0x00, 0x51, 0x91, 0xc0, 0x61, 0x30, 0xf0, 0xa1, 0xa1, 0xf0, 0x30, 0x61,
+     0xc0, 0x91, 0x51, 0x00, 0xc1, 0x90, 0x50, 0x01, 0xa0, 0xf1, 0x31, 0x60,
+     0x60, 0x31, 0xf1, 0xa0, 0x01, 0x50, 0x90, 0xc1, 0x0e, 0x5f, 0x9f, 0xce,
+     0x6f, 0x3e, 0xfe, 0xaf, 0xaf, 0xfe, 0x3e, 0x6f, 0xce, 0x9f, 0x5f, 0x0e,
+     0xcf, 0x9e, 0x5e, 0x0f, 0xae, 0xff, 0x3f, 0x6e, 0x6e, 0x3f, 0xff, 0xae,
+     0x0f, 0x5e, 0x9e, 0xcf, 0x16, 0x47, 0x87, 0xd6, 0x77, 0x26, 0xe6, 0xb7,
+     0xb7, 0xe6, 0x26, 0x77, 0xd6, 0x87, 0x47, 0x16, 0xd7, 0x86, 0x46, 0x17,
+     0xb6, 0xe7, 0x27, 0x76, 0x76, 0x27, 0xe7, 0xb6, 0x17, 0x46, 0x86, 0xd7,
+     0x18, 0x49, 0x89, 0xd8, 0x79, 0x28, 0xe8, 0xb9, 0xb9, 0xe8, 0x28, 0x79,
+     0xd8, 0x89, 0x49, 0x18, 0xd9, 0x88, 0x48, 0x19, 0xb8, 0xe9, 0x29, 0x78,
+     0x78, 0x29, 0xe9, 0xb8, 0x19, 0x48, 0x88, 0xd9, 0x26, 0x77, 0xb7, 0xe6,
+     0x47, 0x16, 0xd6, 0x87, 0x87, 0xd6, 0x16, 0x47, 0xe6, 0xb7, 0x77, 0x26,
+     0xe7, 0xb6, 0x76, 0x27, 0x86, 0xd7, 0x17, 0x46, 0x46, 0x17, 0xd7, 0x86,
+     0x27, 0x76, 0xb6, 0xe7, 0x28, 0x79, 0xb9, 0xe8, 0x49, 0x18, 0xd8, 0x89,
+     0x89, 0xd8, 0x18, 0x49, 0xe8, 0xb9, 0x79, 0x28, 0xe9, 0xb8, 0x78, 0x29,
+     0x88, 0xd9, 0x19, 0x48, 0x48, 0x19, 0xd9, 0x88, 0x29, 0x78, 0xb8, 0xe9,
+     0x30, 0x61, 0xa1, 0xf0, 0x51, 0x00, 0xc0, 0x91, 0x91, 0xc0, 0x00, 0x51,
+     0xf0, 0xa1, 0x61, 0x30, 0xf1, 0xa0, 0x60, 0x31, 0x90, 0xc1, 0x01, 0x50,
+     0x50, 0x01, 0xc1, 0x90, 0x31, 0x60, 0xa0, 0xf1, 0x3e, 0x6f, 0xaf, 0xfe,
+     0x5f, 0x0e, 0xce, 0x9f, 0x9f, 0xce, 0x0e, 0x5f, 0xfe, 0xaf, 0x6f, 0x3e,
+     0xff, 0xae, 0x6e, 0x3f, 0x9e, 0xcf, 0x0f, 0x5e, 0x5e, 0x0f, 0xcf, 0x9e,
+     0x3f, 0x6e, 0xae, 0xff},
+    {0x00, 0x46, 0x86, 0xc0, 0x1a, 0x5c, 0x9c, 0xda, 0x2a, 0x6c, 0xac, 0xea,
+     0x30, 0x76, 0xb6, 0xf0, 0x4a, 0x0c, 0xcc, 0x8a, 0x50, 0x16, 0xd6, 0x90,
+     0x60, 0x26, 0xe6, 0xa0, 0x7a, 0x3c, 0xfc, 0xba, 0x8a, 0xcc, 0x0c, 0x4a,
+     0x90, 0xd6, 0x16, 0x50, 0xa0, 0xe6, 0x26, 0x60, 0xba, 0xfc, 0x3c, 0x7a,
+     0xc0, 0x86, 0x46, 0x00, 0xda, 0x9c, 0x5c, 0x1a, 0xea, 0xac, 0x6c, 0x2a,
+     0xf0, 0xb6, 0x76, 0x30, 0x32, 0x74, 0xb4, 0xf2, 0x28, 0x6e, 0xae, 0xe8,
+     0x18, 0x5e, 0x9e, 0xd8, 0x02, 0x44, 0x84, 0xc2, 0x78, 0x3e, 0xfe, 0xb8,
+     0x62, 0x24, 0xe4, 0xa2, 0x52, 0x14, 0xd4, 0x92, 0x48, 0x0e, 0xce, 0x88,
+     0xb8, 0xfe, 0x3e, 0x78, 0xa2, 0xe4, 0x24, 0x62, 0x92, 0xd4, 0x14, 0x52,
+     0x88, 0xce, 0x0e, 0x48, 0xf2, 0xb4, 0x74, 0x32, 0xe8, 0xae, 0x6e, 0x28,
+     0xd8, 0x9e, 0x5e, 0x18, 0xc2, 0x84, 0x44, 0x02, 0x52, 0x14, 0xd4, 0x92,
+     0x48, 0x0e, 0xce, 0x88, 0x78, 0x3e, 0xfe, 0xb8, 0x62, 0x24, 0xe4, 0xa2,
+     0x18, 0x5e, 0x9e, 0xd8, 0x02, 0x44, 0x84, 0xc2, 0x32, 0x74, 0xb4, 0xf2,
+     0x28, 0x6e, 0xae, 0xe8, 0xd8, 0x9e, 0x5e, 0x18, 0xc2, 0x84, 0x44, 0x02,
+     0xf2, 0xb4, 0x74, 0x32, 0xe8, 0xae, 0x6e, 0x28, 0x92, 0xd4, 0x14, 0x52,
+     0x88, 0xce, 0x0e, 0x48, 0xb8, 0xfe, 0x3e, 0x78, 0xa2, 0xe4, 0x24, 0x62,
+     0x60, 0x26, 0xe6, 0xa0, 0x7a, 0x3c, 0xfc, 0xba, 0x4a, 0x0c, 0xcc, 0x8a,
+     0x50, 0x16, 0xd6, 0x90, 0x2a, 0x6c, 0xac, 0xea, 0x30, 0x76, 0xb6, 0xf0,
+     0x00, 0x46, 0x86, 0xc0, 0x1a, 0x5c, 0x9c, 0xda, 0xea, 0xac, 0x6c, 0x2a,
+     0xf0, 0xb6, 0x76, 0x30, 0xc0, 0x86, 0x46, 0x00, 0xda, 0x9c, 0x5c, 0x1a,
+     0xa0, 0xe6, 0x26, 0x60, 0xba, 0xfc, 0x3c, 0x7a, 0x8a, 0xcc, 0x0c, 0x4a,
+     0x90, 0xd6, 0x16, 0x50},
+    {0x00, 0x92, 0x62, 0xf0, 0xa2, 0x30, 0xc0, 0x52, 0xc2, 0x50, 0xa0, 0x32,
+     0x60, 0xf2, 0x02, 0x90, 0x1c, 0x8e, 0x7e, 0xec, 0xbe, 0x2c, 0xdc, 0x4e,
+     0xde, 0x4c, 0xbc, 0x2e, 0x7c, 0xee, 0x1e, 0x8c, 0x2c, 0xbe, 0x4e, 0xdc,
+     0x8e, 0x1c, 0xec, 0x7e, 0xee, 0x7c, 0x8c, 0x1e, 0x4c, 0xde, 0x2e, 0xbc,
+     0x30, 0xa2, 0x52, 0xc0, 0x92, 0x00, 0xf0, 0x62, 0xf2, 0x60, 0x90, 0x02,
+     0x50, 0xc2, 0x32, 0xa0, 0x4c, 0xde, 0x2e, 0xbc, 0xee, 0x7c, 0x8c, 0x1e,
+     0x8e, 0x1c, 0xec, 0x7e, 0x2c, 0xbe, 0x4e, 0xdc, 0x50, 0xc2, 0x32, 0xa0,
+     0xf2, 0x60, 0x90, 0x02, 0x92, 0x00, 0xf0, 0x62, 0x30, 0xa2, 0x52, 0xc0,
+     0x60, 0xf2, 0x02, 0x90, 0xc2, 0x50, 0xa0, 0x32, 0xa2, 0x30, 0xc0, 0x52,
+     0x00, 0x92, 0x62, 0xf0, 0x7c, 0xee, 0x1e, 0x8c, 0xde, 0x4c, 0xbc, 0x2e,
+     0xbe, 0x2c, 0xdc, 0x4e, 0x1c, 0x8e, 0x7e, 0xec, 0x8c, 0x1e, 0xee, 0x7c,
+     0x2e, 0xbc, 0x4c, 0xde, 0x4e, 0xdc, 0x2c, 0xbe, 0xec, 0x7e, 0x8e, 0x1c,
+     0x90, 0x02, 0xf2, 0x60, 0x32, 0xa0, 0x50, 0xc2, 0x52, 0xc0, 0x30, 0xa2,
+     0xf0, 0x62, 0x92, 0x00, 0xa0, 0x32, 0xc2, 0x50, 0x02, 0x90, 0x60, 0xf2,
+     0x62, 0xf0, 0x00, 0x92, 0xc0, 0x52, 0xa2, 0x30, 0xbc, 0x2e, 0xde, 0x4c,
+     0x1e, 0x8c, 0x7c, 0xee, 0x7e, 0xec, 0x1c, 0x8e, 0xdc, 0x4e, 0xbe, 0x2c,
+     0xc0, 0x52, 0xa2, 0x30, 0x62, 0xf0, 0x00, 0x92, 0x02, 0x90, 0x60, 0xf2,
+     0xa0, 0x32, 0xc2, 0x50, 0xdc, 0x4e, 0xbe, 0x2c, 0x7e, 0xec, 0x1c, 0x8e,
+     0x1e, 0x8c, 0x7c, 0xee, 0xbc, 0x2e, 0xde, 0x4c, 0xec, 0x7e, 0x8e, 0x1c,
+     0x4e, 0xdc, 0x2c, 0xbe, 0x2e, 0xbc, 0x4c, 0xde, 0x8c, 0x1e, 0xee, 0x7c,
+     0xf0, 0x62, 0x92, 0x00, 0x52, 0xc0, 0x30, 0xa2, 0x32, 0xa0, 0x50, 0xc2,
+     0x90, 0x02, 0xf2, 0x60},
+    {0x00, 0x34, 0x54, 0x60, 0x94, 0xa0, 0xc0, 0xf4, 0x64, 0x50, 0x30, 0x04,
+     0xf0, 0xc4, 0xa4, 0x90, 0xa4, 0x90, 0xf0, 0xc4, 0x30, 0x04, 0x64, 0x50,
+     0xc0, 0xf4, 0x94, 0xa0, 0x54, 0x60, 0x00, 0x34, 0xc4, 0xf0, 0x90, 0xa4,
+     0x50, 0x64, 0x04, 0x30, 0xa0, 0x94, 0xf4, 0xc0, 0x34, 0x00, 0x60, 0x54,
+     0x60, 0x54, 0x34, 0x00, 0xf4, 0xc0, 0xa0, 0x94, 0x04, 0x30, 0x50, 0x64,
+     0x90, 0xa4, 0xc4, 0xf0, 0x38, 0x0c, 0x6c, 0x58, 0xac, 0x98, 0xf8, 0xcc,
+     0x5c, 0x68, 0x08, 0x3c, 0xc8, 0xfc, 0x9c, 0xa8, 0x9c, 0xa8, 0xc8, 0xfc,
+     0x08, 0x3c, 0x5c, 0x68, 0xf8, 0xcc, 0xac, 0x98, 0x6c, 0x58, 0x38, 0x0c,
+     0xfc, 0xc8, 0xa8, 0x9c, 0x68, 0x5c, 0x3c, 0x08, 0x98, 0xac, 0xcc, 0xf8,
+     0x0c, 0x38, 0x58, 0x6c, 0x58, 0x6c, 0x0c, 0x38, 0xcc, 0xf8, 0x98, 0xac,
+     0x3c, 0x08, 0x68, 0x5c, 0xa8, 0x9c, 0xfc, 0xc8, 0x58, 0x6c, 0x0c, 0x38,
+     0xcc, 0xf8, 0x98, 0xac, 0x3c, 0x08, 0x68, 0x5c, 0xa8, 0x9c, 0xfc, 0xc8,
+     0xfc, 0xc8, 0xa8, 0x9c, 0x68, 0x5c, 0x3c, 0x08, 0x98, 0xac, 0xcc, 0xf8,
+     0x0c, 0x38, 0x58, 0x6c, 0x9c, 0xa8, 0xc8, 0xfc, 0x08, 0x3c, 0x5c, 0x68,
+     0xf8, 0xcc, 0xac, 0x98, 0x6c, 0x58, 0x38, 0x0c, 0x38, 0x0c, 0x6c, 0x58,
+     0xac, 0x98, 0xf8, 0xcc, 0x5c, 0x68, 0x08, 0x3c, 0xc8, 0xfc, 0x9c, 0xa8,
+     0x60, 0x54, 0x34, 0x00, 0xf4, 0xc0, 0xa0, 0x94, 0x04, 0x30, 0x50, 0x64,
+     0x90, 0xa4, 0xc4, 0xf0, 0xc4, 0xf0, 0x90, 0xa4, 0x50, 0x64, 0x04, 0x30,
+     0xa0, 0x94, 0xf4, 0xc0, 0x34, 0x00, 0x60, 0x54, 0xa4, 0x90, 0xf0, 0xc4,
+     0x30, 0x04, 0x64, 0x50, 0xc0, 0xf4, 0x94, 0xa0, 0x54, 0x60, 0x00, 0x34,
+     0x00, 0x34, 0x54, 0x60, 0x94, 0xa0, 0xc0, 0xf4, 0x64, 0x50, 0x30, 0x04,
+     0xf0, 0xc4, 0xa4, 0x90},
+    {0x00, 0x98, 0x68, 0xf0, 0xa8, 0x30, 0xc0, 0x58, 0xc8, 0x50, 0xa0, 0x38,
+     0x60, 0xf8, 0x08, 0x90, 0x70, 0xe8, 0x18, 0x80, 0xd8, 0x40, 0xb0, 0x28,
+     0xb8, 0x20, 0xd0, 0x48, 0x10, 0x88, 0x78, 0xe0, 0xb0, 0x28, 0xd8, 0x40,
+     0x18, 0x80, 0x70, 0xe8, 0x78, 0xe0, 0x10, 0x88, 0xd0, 0x48, 0xb8, 0x20,
+     0xc0, 0x58, 0xa8, 0x30, 0x68, 0xf0, 0x00, 0x98, 0x08, 0x90, 0x60, 0xf8,
+     0xa0, 0x38, 0xc8, 0x50, 0xd0, 0x48, 0xb8, 0x20, 0x78, 0xe0, 0x10, 0x88,
+     0x18, 0x80, 0x70, 0xe8, 0xb0, 0x28, 0xd8, 0x40, 0xa0, 0x38, 0xc8, 0x50,
+     0x08, 0x90, 0x60, 0xf8, 0x68, 0xf0, 0x00, 0x98, 0xc0, 0x58, 0xa8, 0x30,
+     0x60, 0xf8, 0x08, 0x90, 0xc8, 0x50, 0xa0, 0x38, 0xa8, 0x30, 0xc0, 0x58,
+     0x00, 0x98, 0x68, 0xf0, 0x10, 0x88, 0x78, 0xe0, 0xb8, 0x20, 0xd0, 0x48,
+     0xd8, 0x40, 0xb0, 0x28, 0x70, 0xe8, 0x18, 0x80, 0xe0, 0x78, 0x88, 0x10,
+     0x48, 0xd0, 0x20, 0xb8, 0x28, 0xb0, 0x40, 0xd8, 0x80, 0x18, 0xe8, 0x70,
+     0x90, 0x08, 0xf8, 0x60, 0x38, 0xa0, 0x50, 0xc8, 0x58, 0xc0, 0x30, 0xa8,
+     0xf0, 0x68, 0x98, 0x00, 0x50, 0xc8, 0x38, 0xa0, 0xf8, 0x60, 0x90, 0x08,
+     0x98, 0x00, 0xf0, 0x68, 0x30, 0xa8, 0x58, 0xc0, 0x20, 0xb8, 0x48, 0xd0,
+     0x88, 0x10, 0xe0, 0x78, 0xe8, 0x70, 0x80, 0x18, 0x40, 0xd8, 0x28, 0xb0,
+     0x30, 0xa8, 0x58, 0xc0, 0x98, 0x00, 0xf0, 0x68, 0xf8, 0x60, 0x90, 0x08,
+     0x50, 0xc8, 0x38, 0xa0, 0x40, 0xd8, 0x28, 0xb0, 0xe8, 0x70, 0x80, 0x18,
+     0x88, 0x10, 0xe0, 0x78, 0x20, 0xb8, 0x48, 0xd0, 0x80, 0x18, 0xe8, 0x70,
+     0x28, 0xb0, 0x40, 0xd8, 0x48, 0xd0, 0x20, 0xb8, 0xe0, 0x78, 0x88, 0x10,
+     0xf0, 0x68, 0x98, 0x00, 0x58, 0xc0, 0x30, 0xa8, 0x38, 0xa0, 0x50, 0xc8,
+     0x90, 0x08, 0xf8, 0x60},
+    {0x00, 0x6d, 0xd6, 0xbb, 0x3e, 0x53, 0xe8, 0x85, 0xcb, 0xa6, 0x1d, 0x70,
+     0xf5, 0x98, 0x23, 0x4e, 0xb3, 0xde, 0x65, 0x08, 0x8d, 0xe0, 0x5b, 0x36,
+     0x78, 0x15, 0xae, 0xc3, 0x46, 0x2b, 0x90, 0xfd, 0xb5, 0xd8, 0x63, 0x0e,
+     0x8b, 0xe6, 0x5d, 0x30, 0x7e, 0x13, 0xa8, 0xc5, 0x40, 0x2d, 0x96, 0xfb,
+     0x06, 0x6b, 0xd0, 0xbd, 0x38, 0x55, 0xee, 0x83, 0xcd, 0xa0, 0x1b, 0x76,
+     0xf3, 0x9e, 0x25, 0x48, 0xce, 0xa3, 0x18, 0x75, 0xf0, 0x9d, 0x26, 0x4b,
+     0x05, 0x68, 0xd3, 0xbe, 0x3b, 0x56, 0xed, 0x80, 0x7d, 0x10, 0xab, 0xc6,
+     0x43, 0x2e, 0x95, 0xf8, 0xb6, 0xdb, 0x60, 0x0d, 0x88, 0xe5, 0x5e, 0x33,
+     0x7b, 0x16, 0xad, 0xc0, 0x45, 0x28, 0x93, 0xfe, 0xb0, 0xdd, 0x66, 0x0b,
+     0x8e, 0xe3, 0x58, 0x35, 0xc8, 0xa5, 0x1e, 0x73, 0xf6, 0x9b, 0x20, 0x4d,
+     0x03, 0x6e, 0xd5, 0xb8, 0x3d, 0x50, 0xeb, 0x86, 0x79, 0x14, 0xaf, 0xc2,
+     0x47, 0x2a, 0x91, 0xfc, 0xb2, 0xdf, 0x64, 0x09, 0x8c, 0xe1, 0x5a, 0x37,
+     0xca, 0xa7, 0x1c, 0x71, 0xf4, 0x99, 0x22, 0x4f, 0x01, 0x6c, 0xd7, 0xba,
+     0x3f, 0x52, 0xe9, 0x84, 0xcc, 0xa1, 0x1a, 0x77, 0xf2, 0x9f, 0x24, 0x49,
+     0x07, 0x6a, 0xd1, 0xbc, 0x39, 0x54, 0xef, 0x82, 0x7f, 0x12, 0xa9, 0xc4,
+     0x41, 0x2c, 0x97, 0xfa, 0xb4, 0xd9, 0x62, 0x0f, 0x8a, 0xe7, 0x5c, 0x31,
+     0xb7, 0xda, 0x61, 0x0c, 0x89, 0xe4, 0x5f, 0x32, 0x7c, 0x11, 0xaa, 0xc7,
+     0x42, 0x2f, 0x94, 0xf9, 0x04, 0x69, 0xd2, 0xbf, 0x3a, 0x57, 0xec, 0x81,
+     0xcf, 0xa2, 0x19, 0x74, 0xf1, 0x9c, 0x27, 0x4a, 0x02, 0x6f, 0xd4, 0xb9,
+     0x3c, 0x51, 0xea, 0x87, 0xc9, 0xa4, 0x1f, 0x72, 0xf7, 0x9a, 0x21, 0x4c,
+     0xb1, 0xdc, 0x67, 0x0a, 0x8f, 0xe2, 0x59, 0x34, 0x7a, 0x17, 0xac, 0xc1,
+     0x44, 0x29, 0x92, 0xff},
+};
+
+static const uint8_t kColsHsiao72_64[64] = {
+    0x07, 0x0b, 0x13, 0x23, 0x43, 0x83, 0x0d, 0x15, 0x25, 0x45, 0x85, 0x19,
+    0x29, 0x49, 0x89, 0x31, 0x51, 0x91, 0x61, 0xa1, 0xc1, 0x0e, 0x16, 0x26,
+    0x46, 0x86, 0x1a, 0x2a, 0x4a, 0x8a, 0x32, 0x52, 0x92, 0x62, 0xa2, 0xc2,
+    0x1c, 0x2c, 0x4c, 0x8c, 0x34, 0x54, 0x94, 0x64, 0xa4, 0xc4, 0x38, 0x58,
+    0x98, 0x68, 0xa8, 0xc8, 0x70, 0xb0, 0xd0, 0xe0, 0x6d, 0xd6, 0x3e, 0xcb,
+    0xb3, 0xb5, 0xce, 0x79,
+};
+
 uint8_t enc_secded_72_64(const uint8_t bytes[8]) {
-  uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
-                  ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
-                  ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
-                  ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+  return encode(kEncHsiao72_64, bytes, 8);
+}
+
+uint8_t dec_secded_72_64(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_72_64(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  correct(bytes, syndrome, kColsHsiao72_64, 64);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_72_64_buf(const uint8_t *data, uint8_t *ecc, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_72_64(&data[8 * i]);
+  }
+}
+
+uint8_t dec_secded_72_64_buf(uint8_t *data, const uint8_t *ecc, size_t count,
+                             uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_72_64(&data[8 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
+}
+
+static const uint8_t kEncHamming22_16[2][256] = {
+    {0x00, 0x23, 0x25, 0x06, 0x26, 0x05, 0x03, 0x20, 0x07, 0x24, 0x22, 0x01,
+     0x21, 0x02, 0x04, 0x27, 0x29, 0x0a, 0x0c, 0x2f, 0x0f, 0x2c, 0x2a, 0x09,
+     0x2e, 0x0d, 0x0b, 0x28, 0x08, 0x2b, 0x2d, 0x0e, 0x2a, 0x09, 0x0f, 0x2c,
+     0x0c, 0x2f, 0x29, 0x0a, 0x2d, 0x0e, 0x08, 0x2b, 0x0b, 0x28, 0x2e, 0x0d,
+     0x03, 0x20, 0x26, 0x05, 0x25, 0x06, 0x00, 0x23, 0x04, 0x27, 0x21, 0x02,
+     0x22, 0x01, 0x07, 0x24, 0x0b, 0x28, 0x2e, 0x0d, 0x2d, 0x0e, 0x08, 0x2b,
+     0x0c, 0x2f, 0x29, 0x0a, 0x2a, 0x09, 0x0f, 0x2c, 0x22, 0x01, 0x07, 0x24,
+     0x04, 0x27, 0x21, 0x02, 0x25, 0x06, 0x00, 0x23, 0x03, 0x20, 0x26, 0x05,
+     0x21, 0x02, 0x04, 0x27, 0x07, 0x24, 0x22, 0x01, 0x26, 0x05, 0x03, 0x20,
+     0x00, 0x23, 0x25, 0x06, 0x08, 0x2b, 0x2d, 0x0e, 0x2e, 0x0d, 0x0b, 0x28,
+     0x0f, 0x2c, 0x2a, 0x09, 0x29, 0x0a, 0x0c, 0x2f, 0x2c, 0x0f, 0x09, 0x2a,
+     0x0a, 0x29, 0x2f, 0x0c, 0x2b, 0x08, 0x0e, 0x2d, 0x0d, 0x2e, 0x28, 0x0b,
+     0x05, 0x26, 0x20, 0x03, 0x23, 0x00, 0x06, 0x25, 0x02, 0x21, 0x27, 0x04,
+     0x24, 0x07, 0x01, 0x22, 0x06, 0x25, 0x23, 0x00, 0x20, 0x03, 0x05, 0x26,
+     0x01, 0x22, 0x24, 0x07, 0x27, 0x04, 0x02, 0x21, 0x2f, 0x0c, 0x0a, 0x29,
+     0x09, 0x2a, 0x2c, 0x0f, 0x28, 0x0b, 0x0d, 0x2e, 0x0e, 0x2d, 0x2b, 0x08,
+     0x27, 0x04, 0x02, 0x21, 0x01, 0x22, 0x24, 0x07, 0x20, 0x03, 0x05, 0x26,
+     0x06, 0x25, 0x23, 0x00, 0x0e, 0x2d, 0x2b, 0x08, 0x28, 0x0b, 0x0d, 0x2e,
+     0x09, 0x2a, 0x2c, 0x0f, 0x2f, 0x0c, 0x0a, 0x29, 0x0d, 0x2e, 0x28, 0x0b,
+     0x2b, 0x08, 0x0e, 0x2d, 0x0a, 0x29, 0x2f, 0x0c, 0x2c, 0x0f, 0x09, 0x2a,
+     0x24, 0x07, 0x01, 0x22, 0x02, 0x21, 0x27, 0x04, 0x23, 0x00, 0x06, 0x25,
+     0x05, 0x26, 0x20, 0x03},
+    {0x00, 0x0d, 0x0e, 0x03, 0x2f, 0x22, 0x21, 0x2c, 0x31, 0x3c, 0x3f, 0x32,
+     0x1e, 0x13, 0x10, 0x1d, 0x32, 0x3f, 0x3c, 0x31, 0x1d, 0x10, 0x13, 0x1e,
+     0x03, 0x0e, 0x0d, 0x00, 0x2c, 0x21, 0x22, 0x2f, 0x13, 0x1e, 0x1d, 0x10,
+     0x3c, 0x31, 0x32, 0x3f, 0x22, 0x2f, 0x2c, 0x21, 0x0d, 0x00, 0x03, 0x0e,
+     0x21, 0x2c, 0x2f, 0x22, 0x0e, 0x03, 0x00, 0x0d, 0x10, 0x1d, 0x1e, 0x13,
+     0x3f, 0x32, 0x31, 0x3c, 0x34, 0x39, 0x3a, 0x37, 0x1b, 0x16, 0x15, 0x18,
+     0x05, 0x08, 0x0b, 0x06, 0x2a, 0x27, 0x24, 0x29, 0x06, 0x0b, 0x08, 0x05,
+     0x29, 0x24, 0x27, 0x2a, 0x37, 0x3a, 0x39, 0x34, 0x18, 0x15, 0x16, 0x1b,
+     0x27, 0x2a, 0x29, 0x24, 0x08, 0x05, 0x06, 0x0b, 0x16, 0x1b, 0x18, 0x15,
+     0x39, 0x34, 0x37, 0x3a, 0x15, 0x18, 0x1b, 0x16, 0x3a, 0x37, 0x34, 0x39,
+     0x24, 0x29, 0x2a, 0x27, 0x0b, 0x06, 0x05, 0x08, 0x15, 0x18, 0x1b, 0x16,
+     0x3a, 0x37, 0x34, 0x39, 0x24, 0x29, 0x2a, 0x27, 0x0b, 0x06, 0x05, 0x08,
+     0x27, 0x2a, 0x29, 0x24, 0x08, 0x05, 0x06, 0x0b, 0x16, 0x1b, 0x18, 0x15,
+     0x39, 0x34, 0x37, 0x3a, 0x06, 0x0b, 0x08, 0x05, 0x29, 0x24, 0x27, 0x2a,
+     0x37, 0x3a, 0x39, 0x34, 0x18, 0x15, 0x16, 0x1b, 0x34, 0x39, 0x3a, 0x37,
+     0x1b, 0x16, 0x15, 0x18, 0x05, 0x08, 0x0b, 0x06, 0x2a, 0x27, 0x24, 0x29,
+     0x21, 0x2c, 0x2f, 0x22, 0x0e, 0x03, 0x00, 0x0d, 0x10, 0x1d, 0x1e, 0x13,
+     0x3f, 0x32, 0x31, 0x3c, 0x13, 0x1e, 0x1d, 0x10, 0x3c, 0x31, 0x32, 0x3f,
+     0x22, 0x2f, 0x2c, 0x21, 0x0d, 0x00, 0x03, 0x0e, 0x32, 0x3f, 0x3c, 0x31,
+     0x1d, 0x10, 0x13, 0x1e, 0x03, 0x0e, 0x0d, 0x00, 0x2c, 0x21, 0x22, 0x2f,
+     0x00, 0x0d, 0x0e, 0x03, 0x2f, 0x22, 0x21, 0x2c, 0x31, 0x3c, 0x3f, 0x32,
+     0x1e, 0x13, 0x10, 0x1d},
+};
+
+static const uint8_t kColsHamming22_16[16] = {
+    0x23, 0x25, 0x26, 0x27, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x31,
+    0x32, 0x33, 0x34, 0x35,
+};
+
+uint8_t enc_secded_hamming_22_16(const uint8_t bytes[2]) {
+  return encode(kEncHamming22_16, bytes, 2);
+}
+
+uint8_t dec_secded_hamming_22_16(uint8_t bytes[2], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_hamming_22_16(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  // The last check bit also covers the other check bits.
+  syndrome ^= (uint8_t)(__builtin_parity(syndrome & 0x1f) << 5);
+  correct(bytes, syndrome, kColsHamming22_16, 16);
+  return hamming_err(syndrome, 6);
+}
+
+void enc_secded_hamming_22_16_buf(const uint8_t *data, uint8_t *ecc,
+                                  size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_hamming_22_16(&data[2 * i]);
+  }
+}
+
+uint8_t dec_secded_hamming_22_16_buf(uint8_t *data, const uint8_t *ecc,
+                                     size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_hamming_22_16(&data[2 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
+}
+
+static const uint8_t kEncHamming39_32[4][256] = {
+    {0x00, 0x43, 0x45, 0x06, 0x46, 0x05, 0x03, 0x40, 0x07, 0x44, 0x42, 0x01,
+     0x41, 0x02, 0x04, 0x47, 0x49, 0x0a, 0x0c, 0x4f, 0x0f, 0x4c, 0x4a, 0x09,
+     0x4e, 0x0d, 0x0b, 0x48, 0x08, 0x4b, 0x4d, 0x0e, 0x4a, 0x09, 0x0f, 0x4c,
+     0x0c, 0x4f, 0x49, 0x0a, 0x4d, 0x0e, 0x08, 0x4b, 0x0b, 0x48, 0x4e, 0x0d,
+     0x03, 0x40, 0x46, 0x05, 0x45, 0x06, 0x00, 0x43, 0x04, 0x47, 0x41, 0x02,
+     0x42, 0x01, 0x07, 0x44, 0x0b, 0x48, 0x4e, 0x0d, 0x4d, 0x0e, 0x08, 0x4b,
+     0x0c, 0x4f, 0x49, 0x0a, 0x4a, 0x09, 0x0f, 0x4c, 0x42, 0x01, 0x07, 0x44,
+     0x04, 0x47, 0x41, 0x02, 0x45, 0x06, 0x00, 0x43, 0x03, 0x40, 0x46, 0x05,
+     0x41, 0x02, 0x04, 0x47, 0x07, 0x44, 0x42, 0x01, 0x46, 0x05, 0x03, 0x40,
+     0x00, 0x43, 0x45, 0x06, 0x08, 0x4b, 0x4d, 0x0e, 0x4e, 0x0d, 0x0b, 0x48,
+     0x0f, 0x4c, 0x4a, 0x09, 0x49, 0x0a, 0x0c, 0x4f, 0x4c, 0x0f, 0x09, 0x4a,
+     0x0a, 0x49, 0x4f, 0x0c, 0x4b, 0x08, 0x0e, 0x4d, 0x0d, 0x4e, 0x48, 0x0b,
+     0x05, 0x46, 0x40, 0x03, 0x43, 0x00, 0x06, 0x45, 0x02, 0x41, 0x47, 0x04,
+     0x44, 0x07, 0x01, 0x42, 0x06, 0x45, 0x43, 0x00, 0x40, 0x03, 0x05, 0x46,
+     0x01, 0x42, 0x44, 0x07, 0x47, 0x04, 0x02, 0x41, 0x4f, 0x0c, 0x0a, 0x49,
+     0x09, 0x4a, 0x4c, 0x0f, 0x48, 0x0b, 0x0d, 0x4e, 0x0e, 0x4d, 0x4b, 0x08,
+     0x47, 0x04, 0x02, 0x41, 0x01, 0x42, 0x44, 0x07, 0x40, 0x03, 0x05, 0x46,
+     0x06, 0x45, 0x43, 0x00, 0x0e, 0x4d, 0x4b, 0x08, 0x48, 0x0b, 0x0d, 0x4e,
+     0x09, 0x4a, 0x4c, 0x0f, 0x4f, 0x0c, 0x0a, 0x49, 0x0d, 0x4e, 0x48, 0x0b,
+     0x4b, 0x08, 0x0e, 0x4d, 0x0a, 0x49, 0x4f, 0x0c, 0x4c, 0x0f, 0x09, 0x4a,
+     0x44, 0x07, 0x01, 0x42, 0x02, 0x41, 0x47, 0x04, 0x43, 0x00, 0x06, 0x45,
+     0x05, 0x46, 0x40, 0x03},
+    {0x00, 0x0d, 0x0e, 0x03, 0x4f, 0x42, 0x41, 0x4c, 0x51, 0x5c, 0x5f, 0x52,
+     0x1e, 0x13, 0x10, 0x1d, 0x52, 0x5f, 0x5c, 0x51, 0x1d, 0x10, 0x13, 0x1e,
+     0x03, 0x0e, 0x0d, 0x00, 0x4c, 0x41, 0x42, 0x4f, 0x13, 0x1e, 0x1d, 0x10,
+     0x5c, 0x51, 0x52, 0x5f, 0x42, 0x4f, 0x4c, 0x41, 0x0d, 0x00, 0x03, 0x0e,
+     0x41, 0x4c, 0x4f, 0x42, 0x0e, 0x03, 0x00, 0x0d, 0x10, 0x1d, 0x1e, 0x13,
+     0x5f, 0x52, 0x51, 0x5c, 0x54, 0x59, 0x5a, 0x57, 0x1b, 0x16, 0x15, 0x18,
+     0x05, 0x08, 0x0b, 0x06, 0x4a, 0x47, 0x44, 0x49, 0x06, 0x0b, 0x08, 0x05,
+     0x49, 0x44, 0x47, 0x4a, 0x57, 0x5a, 0x59, 0x54, 0x18, 0x15, 0x16, 0x1b,
+     0x47, 0x4a, 0x49, 0x44, 0x08, 0x05, 0x06, 0x0b, 0x16, 0x1b, 0x18, 0x15,
+     0x59, 0x54, 0x57, 0x5a, 0x15, 0x18, 0x1b, 0x16, 0x5a, 0x57, 0x54, 0x59,
+     0x44, 0x49, 0x4a, 0x47, 0x0b, 0x06, 0x05, 0x08, 0x15, 0x18, 0x1b, 0x16,
+     0x5a, 0x57, 0x54, 0x59, 0x44, 0x49, 0x4a, 0x47, 0x0b, 0x06, 0x05, 0x08,
+     0x47, 0x4a, 0x49, 0x44, 0x08, 0x05, 0x06, 0x0b, 0x16, 0x1b, 0x18, 0x15,
+     0x59, 0x54, 0x57, 0x5a, 0x06, 0x0b, 0x08, 0x05, 0x49, 0x44, 0x47, 0x4a,
+     0x57, 0x5a, 0x59, 0x54, 0x18, 0x15, 0x16, 0x1b, 0x54, 0x59, 0x5a, 0x57,
+     0x1b, 0x16, 0x15, 0x18, 0x05, 0x08, 0x0b, 0x06, 0x4a, 0x47, 0x44, 0x49,
+     0x41, 0x4c, 0x4f, 0x42, 0x0e, 0x03, 0x00, 0x0d, 0x10, 0x1d, 0x1e, 0x13,
+     0x5f, 0x52, 0x51, 0x5c, 0x13, 0x1e, 0x1d, 0x10, 0x5c, 0x51, 0x52, 0x5f,
+     0x42, 0x4f, 0x4c, 0x41, 0x0d, 0x00, 0x03, 0x0e, 0x52, 0x5f, 0x5c, 0x51,
+     0x1d, 0x10, 0x13, 0x1e, 0x03, 0x0e, 0x0d, 0x00, 0x4c, 0x41, 0x42, 0x4f,
+     0x00, 0x0d, 0x0e, 0x03, 0x4f, 0x42, 0x41, 0x4c, 0x51, 0x5c, 0x5f, 0x52,
+     0x1e, 0x13, 0x10, 0x1d},
+    {0x00, 0x16, 0x57, 0x41, 0x58, 0x4e, 0x0f, 0x19, 0x19, 0x0f, 0x4e, 0x58,
+     0x41, 0x57, 0x16, 0x00, 0x1a, 0x0c, 0x4d, 0x5b, 0x42, 0x54, 0x15, 0x03,
+     0x03, 0x15, 0x54, 0x42, 0x5b, 0x4d, 0x0c, 0x1a, 0x5b, 0x4d, 0x0c, 0x1a,
+     0x03, 0x15, 0x54, 0x42, 0x42, 0x54, 0x15, 0x03, 0x1a, 0x0c, 0x4d, 0x5b,
+     0x41, 0x57, 0x16, 0x00, 0x19, 0x0f, 0x4e, 0x58, 0x58, 0x4e, 0x0f, 0x19,
+     0x00, 0x16, 0x57, 0x41, 0x1c, 0x0a, 0x4b, 0x5d, 0x44, 0x52, 0x13, 0x05,
+     0x05, 0x13, 0x52, 0x44, 0x5d, 0x4b, 0x0a, 0x1c, 0x06, 0x10, 0x51, 0x47,
+     0x5e, 0x48, 0x09, 0x1f, 0x1f, 0x09, 0x48, 0x5e, 0x47, 0x51, 0x10, 0x06,
+     0x47, 0x51, 0x10, 0x06, 0x1f, 0x09, 0x48, 0x5e, 0x5e, 0x48, 0x09, 0x1f,
+     0x06, 0x10, 0x51, 0x47, 0x5d, 0x4b, 0x0a, 0x1c, 0x05, 0x13, 0x52, 0x44,
+     0x44, 0x52, 0x13, 0x05, 0x1c, 0x0a, 0x4b, 0x5d, 0x5d, 0x4b, 0x0a, 0x1c,
+     0x05, 0x13, 0x52, 0x44, 0x44, 0x52, 0x13, 0x05, 0x1c, 0x0a, 0x4b, 0x5d,
+     0x47, 0x51, 0x10, 0x06, 0x1f, 0x09, 0x48, 0x5e, 0x5e, 0x48, 0x09, 0x1f,
+     0x06, 0x10, 0x51, 0x47, 0x06, 0x10, 0x51, 0x47, 0x5e, 0x48, 0x09, 0x1f,
+     0x1f, 0x09, 0x48, 0x5e, 0x47, 0x51, 0x10, 0x06, 0x1c, 0x0a, 0x4b, 0x5d,
+     0x44, 0x52, 0x13, 0x05, 0x05, 0x13, 0x52, 0x44, 0x5d, 0x4b, 0x0a, 0x1c,
+     0x41, 0x57, 0x16, 0x00, 0x19, 0x0f, 0x4e, 0x58, 0x58, 0x4e, 0x0f, 0x19,
+     0x00, 0x16, 0x57, 0x41, 0x5b, 0x4d, 0x0c, 0x1a, 0x03, 0x15, 0x54, 0x42,
+     0x42, 0x54, 0x15, 0x03, 0x1a, 0x0c, 0x4d, 0x5b, 0x1a, 0x0c, 0x4d, 0x5b,
+     0x42, 0x54, 0x15, 0x03, 0x03, 0x15, 0x54, 0x42, 0x5b, 0x4d, 0x0c, 0x1a,
+     0x00, 0x16, 0x57, 0x41, 0x58, 0x4e, 0x0f, 0x19, 0x19, 0x0f, 0x4e, 0x58,
+     0x41, 0x57, 0x16, 0x00},
+    {0x00, 0x5e, 0x1f, 0x41, 0x61, 0x3f, 0x7e, 0x20, 0x62, 0x3c, 0x7d, 0x23,
+     0x03, 0x5d, 0x1c, 0x42, 0x23, 0x7d, 0x3c, 0x62, 0x42, 0x1c, 0x5d, 0x03,
+     0x41, 0x1f, 0x5e, 0x00, 0x20, 0x7e, 0x3f, 0x61, 0x64, 0x3a, 0x7b, 0x25,
+     0x05, 0x5b, 0x1a, 0x44, 0x06, 0x58, 0x19, 0x47, 0x67, 0x39, 0x78, 0x26,
+     0x47, 0x19, 0x58, 0x06, 0x26, 0x78, 0x39, 0x67, 0x25, 0x7b, 0x3a, 0x64,
+     0x44, 0x1a, 0x5b, 0x05, 0x25, 0x7b, 0x3a, 0x64, 0x44, 0x1a, 0x5b, 0x05,
+     0x47, 0x19, 0x58, 0x06, 0x26, 0x78, 0x39, 0x67, 0x06, 0x58, 0x19, 0x47,
+     0x67, 0x39, 0x78, 0x26, 0x64, 0x3a, 0x7b, 0x25, 0x05, 0x5b, 0x1a, 0x44,
+     0x41, 0x1f, 0x5e, 0x00, 0x20, 0x7e, 0x3f, 0x61, 0x23, 0x7d, 0x3c, 0x62,
+     0x42, 0x1c, 0x5d, 0x03, 0x62, 0x3c, 0x7d, 0x23, 0x03, 0x5d, 0x1c, 0x42,
+     0x00, 0x5e, 0x1f, 0x41, 0x61, 0x3f, 0x7e, 0x20, 0x26, 0x78, 0x39, 0x67,
+     0x47, 0x19, 0x58, 0x06, 0x44, 0x1a, 0x5b, 0x05, 0x25, 0x7b, 0x3a, 0x64,
+     0x05, 0x5b, 0x1a, 0x44, 0x64, 0x3a, 0x7b, 0x25, 0x67, 0x39, 0x78, 0x26,
+     0x06, 0x58, 0x19, 0x47, 0x42, 0x1c, 0x5d, 0x03, 0x23, 0x7d, 0x3c, 0x62,
+     0x20, 0x7e, 0x3f, 0x61, 0x41, 0x1f, 0x5e, 0x00, 0x61, 0x3f, 0x7e, 0x20,
+     0x00, 0x5e, 0x1f, 0x41, 0x03, 0x5d, 0x1c, 0x42, 0x62, 0x3c, 0x7d, 0x23,
+     0x03, 0x5d, 0x1c, 0x42, 0x62, 0x3c, 0x7d, 0x23, 0x61, 0x3f, 0x7e, 0x20,
+     0x00, 0x5e, 0x1f, 0x41, 0x20, 0x7e, 0x3f, 0x61, 0x41, 0x1f, 0x5e, 0x00,
+     0x42, 0x1c, 0x5d, 0x03, 0x23, 0x7d, 0x3c, 0x62, 0x67, 0x39, 0x78, 0x26,
+     0x06, 0x58, 0x19, 0x47, 0x05, 0x5b, 0x1a, 0x44, 0x64, 0x3a, 0x7b, 0x25,
+     0x44, 0x1a, 0x5b, 0x05, 0x25, 0x7b, 0x3a, 0x64, 0x26, 0x78, 0x39, 0x67,
+     0x47, 0x19, 0x58, 0x06},
+};
+
+static const uint8_t kColsHamming39_32[32] = {
+    0x43, 0x45, 0x46, 0x47, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x51,
+    0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d,
+    0x5e, 0x5f, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66,
+};
+
+uint8_t enc_secded_hamming_39_32(const uint8_t bytes[4]) {
+  return encode(kEncHamming39_32, bytes, 4);
+}
+
+uint8_t dec_secded_hamming_39_32(uint8_t bytes[4], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_hamming_39_32(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  // The last check bit also covers the other check bits.
+  syndrome ^= (uint8_t)(__builtin_parity(syndrome & 0x3f) << 6);
+  correct(bytes, syndrome, kColsHamming39_32, 32);
+  return hamming_err(syndrome, 7);
+}
+
+void enc_secded_hamming_39_32_buf(const uint8_t *data, uint8_t *ecc,
+                                  size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_hamming_39_32(&data[4 * i]);
+  }
+}
+
+uint8_t dec_secded_hamming_39_32_buf(uint8_t *data, const uint8_t *ecc,
+                                     size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_hamming_39_32(&data[4 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
+}
+
+static const uint8_t kEncHamming72_64[8][256] = {
+    {0x00, 0x83, 0x85, 0x06, 0x86, 0x05, 0x03, 0x80, 0x07, 0x84, 0x82, 0x01,
+     0x81, 0x02, 0x04, 0x87, 0x89, 0x0a, 0x0c, 0x8f, 0x0f, 0x8c, 0x8a, 0x09,
+     0x8e, 0x0d, 0x0b, 0x88, 0x08, 0x8b, 0x8d, 0x0e, 0x8a, 0x09, 0x0f, 0x8c,
+     0x0c, 0x8f, 0x89, 0x0a, 0x8d, 0x0e, 0x08, 0x8b, 0x0b, 0x88, 0x8e, 0x0d,
+     0x03, 0x80, 0x86, 0x05, 0x85, 0x06, 0x00, 0x83, 0x04, 0x87, 0x81, 0x02,
+     0x82, 0x01, 0x07, 0x84, 0x0b, 0x88, 0x8e, 0x0d, 0x8d, 0x0e, 0x08, 0x8b,
+     0x0c, 0x8f, 0x89, 0x0a, 0x8a, 0x09, 0x0f, 0x8c, 0x82, 0x01, 0x07, 0x84,
+     0x04, 0x87, 0x81, 0x02, 0x85, 0x06, 0x00, 0x83, 0x03, 0x80, 0x86, 0x05,
+     0x81, 0x02, 0x04, 0x87, 0x07, 0x84, 0x82, 0x01, 0x86, 0x05, 0x03, 0x80,
+     0x00, 0x83, 0x85, 0x06, 0x08, 0x8b, 0x8d, 0x0e, 0x8e, 0x0d, 0x0b, 0x88,
+     0x0f, 0x8c, 0x8a, 0x09, 0x89, 0x0a, 0x0c, 0x8f, 0x8c, 0x0f, 0x09, 0x8a,
+     0x0a, 0x89, 0x8f, 0x0c, 0x8b, 0x08, 0x0e, 0x8d, 0x0d, 0x8e, 0x88, 0x0b,
+     0x05, 0x86, 0x80, 0x03, 0x83, 0x00, 0x06, 0x85, 0x02, 0x81, 0x87, 0x04,
+     0x84, 0x07, 0x01, 0x82, 0x06, 0x85, 0x83, 0x00, 0x80, 0x03, 0x05, 0x86,
+     0x01, 0x82, 0x84, 0x07, 0x87, 0x04, 0x02, 0x81, 0x8f, 0x0c, 0x0a, 0x89,
+     0x09, 0x8a, 0x8c, 0x0f, 0x88, 0x0b, 0x0d, 0x8e, 0x0e, 0x8d, 0x8b, 0x08,
+     0x87, 0x04, 0x02, 0x81, 0x01, 0x82, 0x84, 0x07, 0x80, 0x03, 0x05, 0x86,
+     0x06, 0x85, 0x83, 0x00, 0x0e, 0x8d, 0x8b, 0x08, 0x88, 0x0b, 0x0d, 0x8e,
+     0x09, 0x8a, 0x8c, 0x0f, 0x8f, 0x0c, 0x0a, 0x89, 0x0d, 0x8e, 0x88, 0x0b,
+     0x8b, 0x08, 0x0e, 0x8d, 0x0a, 0x89, 0x8f, 0x0c, 0x8c, 0x0f, 0x09, 0x8a,
+     0x84, 0x07, 0x01, 0x82, 0x02, 0x81, 0x87, 0x04, 0x83, 0x00, 0x06, 0x85,
+     0x05, 0x86, 0x80, 0x03},
+    {0x00, 0x0d, 0x0e, 0x03, 0x8f, 0x82, 0x81, 0x8c, 0x91, 0x9c, 0x9f, 0x92,
+     0x1e, 0x13, 0x10, 0x1d, 0x92, 0x9f, 0x9c, 0x91, 0x1d, 0x10, 0x13, 0x1e,
+     0x03, 0x0e, 0x0d, 0x00, 0x8c, 0x81, 0x82, 0x8f, 0x13, 0x1e, 0x1d, 0x10,
+     0x9c, 0x91, 0x92, 0x9f, 0x82, 0x8f, 0x8c, 0x81, 0x0d, 0x00, 0x03, 0x0e,
+     0x81, 0x8c, 0x8f, 0x82, 0x0e, 0x03, 0x00, 0x0d, 0x10, 0x1d, 0x1e, 0x13,
+     0x9f, 0x92, 0x91, 0x9c, 0x94, 0x99, 0x9a, 0x97, 0x1b, 0x16, 0x15, 0x18,
+     0x05, 0x08, 0x0b, 0x06, 0x8a, 0x87, 0x84, 0x89, 0x06, 0x0b, 0x08, 0x05,
+     0x89, 0x84, 0x87, 0x8a, 0x97, 0x9a, 0x99, 0x94, 0x18, 0x15, 0x16, 0x1b,
+     0x87, 0x8a, 0x89, 0x84, 0x08, 0x05, 0x06, 0x0b, 0x16, 0x1b, 0x18, 0x15,
+     0x99, 0x94, 0x97, 0x9a, 0x15, 0x18, 0x1b, 0x16, 0x9a, 0x97, 0x94, 0x99,
+     0x84, 0x89, 0x8a, 0x87, 0x0b, 0x06, 0x05, 0x08, 0x15, 0x18, 0x1b, 0x16,
+     0x9a, 0x97, 0x94, 0x99, 0x84, 0x89, 0x8a, 0x87, 0x0b, 0x06, 0x05, 0x08,
+     0x87, 0x8a, 0x89, 0x84, 0x08, 0x05, 0x06, 0x0b, 0x16, 0x1b, 0x18, 0x15,
+     0x99, 0x94, 0x97, 0x9a, 0x06, 0x0b, 0x08, 0x05, 0x89, 0x84, 0x87, 0x8a,
+     0x97, 0x9a, 0x99, 0x94, 0x18, 0x15, 0x16, 0x1b, 0x94, 0x99, 0x9a, 0x97,
+     0x1b, 0x16, 0x15, 0x18, 0x05, 0x08, 0x0b, 0x06, 0x8a, 0x87, 0x84, 0x89,
+     0x81, 0x8c, 0x8f, 0x82, 0x0e, 0x03, 0x00, 0x0d, 0x10, 0x1d, 0x1e, 0x13,
+     0x9f, 0x92, 0x91, 0x9c, 0x13, 0x1e, 0x1d, 0x10, 0x9c, 0x91, 0x92, 0x9f,
+     0x82, 0x8f, 0x8c, 0x81, 0x0d, 0x00, 0x03, 0x0e, 0x92, 0x9f, 0x9c, 0x91,
+     0x1d, 0x10, 0x13, 0x1e, 0x03, 0x0e, 0x0d, 0x00, 0x8c, 0x81, 0x82, 0x8f,
+     0x00, 0x0d, 0x0e, 0x03, 0x8f, 0x82, 0x81, 0x8c, 0x91, 0x9c, 0x9f, 0x92,
+     0x1e, 0x13, 0x10, 0x1d},
+    {0x00, 0x16, 0x97, 0x81, 0x98, 0x8e, 0x0f, 0x19, 0x19, 0x0f, 0x8e, 0x98,
+     0x81, 0x97, 0x16, 0x00, 0x1a, 0x0c, 0x8d, 0x9b, 0x82, 0x94, 0x15, 0x03,
+     0x03, 0x15, 0x94, 0x82, 0x9b, 0x8d, 0x0c, 0x1a, 0x9b, 0x8d, 0x0c, 0x1a,
+     0x03, 0x15, 0x94, 0x82, 0x82, 0x94, 0x15, 0x03, 0x1a, 0x0c, 0x8d, 0x9b,
+     0x81, 0x97, 0x16, 0x00, 0x19, 0x0f, 0x8e, 0x98, 0x98, 0x8e, 0x0f, 0x19,
+     0x00, 0x16, 0x97, 0x81, 0x1c, 0x0a, 0x8b, 0x9d, 0x84, 0x92, 0x13, 0x05,
+     0x05, 0x13, 0x92, 0x84, 0x9d, 0x8b, 0x0a, 0x1c, 0x06, 0x10, 0x91, 0x87,
+     0x9e, 0x88, 0x09, 0x1f, 0x1f, 0x09, 0x88, 0x9e, 0x87, 0x91, 0x10, 0x06,
+     0x87, 0x91, 0x10, 0x06, 0x1f, 0x09, 0x88, 0x9e, 0x9e, 0x88, 0x09, 0x1f,
+     0x06, 0x10, 0x91, 0x87, 0x9d, 0x8b, 0x0a, 0x1c, 0x05, 0x13, 0x92, 0x84,
+     0x84, 0x92, 0x13, 0x05, 0x1c, 0x0a, 0x8b, 0x9d, 0x9d, 0x8b, 0x0a, 0x1c,
+     0x05, 0x13, 0x92, 0x84, 0x84, 0x92, 0x13, 0x05, 0x1c, 0x0a, 0x8b, 0x9d,
+     0x87, 0x91, 0x10, 0x06, 0x1f, 0x09, 0x88, 0x9e, 0x9e, 0x88, 0x09, 0x1f,
+     0x06, 0x10, 0x91, 0x87, 0x06, 0x10, 0x91, 0x87, 0x9e, 0x88, 0x09, 0x1f,
+     0x1f, 0x09, 0x88, 0x9e, 0x87, 0x91, 0x10, 0x06, 0x1c, 0x0a, 0x8b, 0x9d,
+     0x84, 0x92, 0x13, 0x05, 0x05, 0x13, 0x92, 0x84, 0x9d, 0x8b, 0x0a, 0x1c,
+     0x81, 0x97, 0x16, 0x00, 0x19, 0x0f, 0x8e, 0x98, 0x98, 0x8e, 0x0f, 0x19,
+     0x00, 0x16, 0x97, 0x81, 0x9b, 0x8d, 0x0c, 0x1a, 0x03, 0x15, 0x94, 0x82,
+     0x82, 0x94, 0x15, 0x03, 0x1a, 0x0c, 0x8d, 0x9b, 0x1a, 0x0c, 0x8d, 0x9b,
+     0x82, 0x94, 0x15, 0x03, 0x03, 0x15, 0x94, 0x82, 0x9b, 0x8d, 0x0c, 0x1a,
+     0x00, 0x16, 0x97, 0x81, 0x98, 0x8e, 0x0f, 0x19, 0x19, 0x0f, 0x8e, 0x98,
+     0x81, 0x97, 0x16, 0x00},
+    {0x00, 0x9e, 0x1f, 0x81, 0xa1, 0x3f, 0xbe, 0x20, 0xa2, 0x3c, 0xbd, 0x23,
+     0x03, 0x9d, 0x1c, 0x82, 0x23, 0xbd, 0x3c, 0xa2, 0x82, 0x1c, 0x9d, 0x03,
+     0x81, 0x1f, 0x9e, 0x00, 0x20, 0xbe, 0x3f, 0xa1, 0xa4, 0x3a, 0xbb, 0x25,
+     0x05, 0x9b, 0x1a, 0x84, 0x06, 0x98, 0x19, 0x87, 0xa7, 0x39, 0xb8, 0x26,
+     0x87, 0x19, 0x98, 0x06, 0x26, 0xb8, 0x39, 0xa7, 0x25, 0xbb, 0x3a, 0xa4,
+     0x84, 0x1a, 0x9b, 0x05, 0x25, 0xbb, 0x3a, 0xa4, 0x84, 0x1a, 0x9b, 0x05,
+     0x87, 0x19, 0x98, 0x06, 0x26, 0xb8, 0x39, 0xa7, 0x06, 0x98, 0x19, 0x87,
+     0xa7, 0x39, 0xb8, 0x26, 0xa4, 0x3a, 0xbb, 0x25, 0x05, 0x9b, 0x1a, 0x84,
+     0x81, 0x1f, 0x9e, 0x00, 0x20, 0xbe, 0x3f, 0xa1, 0x23, 0xbd, 0x3c, 0xa2,
+     0x82, 0x1c, 0x9d, 0x03, 0xa2, 0x3c, 0xbd, 0x23, 0x03, 0x9d, 0x1c, 0x82,
+     0x00, 0x9e, 0x1f, 0x81, 0xa1, 0x3f, 0xbe, 0x20, 0x26, 0xb8, 0x39, 0xa7,
+     0x87, 0x19, 0x98, 0x06, 0x84, 0x1a, 0x9b, 0x05, 0x25, 0xbb, 0x3a, 0xa4,
+     0x05, 0x9b, 0x1a, 0x84, 0xa4, 0x3a, 0xbb, 0x25, 0xa7, 0x39, 0xb8, 0x26,
+     0x06, 0x98, 0x19, 0x87, 0x82, 0x1c, 0x9d, 0x03, 0x23, 0xbd, 0x3c, 0xa2,
+     0x20, 0xbe, 0x3f, 0xa1, 0x81, 0x1f, 0x9e, 0x00, 0xa1, 0x3f, 0xbe, 0x20,
+     0x00, 0x9e, 0x1f, 0x81, 0x03, 0x9d, 0x1c, 0x82, 0xa2, 0x3c, 0xbd, 0x23,
+     0x03, 0x9d, 0x1c, 0x82, 0xa2, 0x3c, 0xbd, 0x23, 0xa1, 0x3f, 0xbe, 0x20,
+     0x00, 0x9e, 0x1f, 0x81, 0x20, 0xbe, 0x3f, 0xa1, 0x81, 0x1f, 0x9e, 0x00,
+     0x82, 0x1c, 0x9d, 0x03, 0x23, 0xbd, 0x3c, 0xa2, 0xa7, 0x39, 0xb8, 0x26,
+     0x06, 0x98, 0x19, 0x87, 0x05, 0x9b, 0x1a, 0x84, 0xa4, 0x3a, 0xbb, 0x25,
+     0x84, 0x1a, 0x9b, 0x05, 0x25, 0xbb, 0x3a, 0xa4, 0x26, 0xb8, 0x39, 0xa7,
+     0x87, 0x19, 0x98, 0x06},
+    {0x00, 0xa7, 0xa8, 0x0f, 0x29, 0x8e, 0x81, 0x26, 0x2a, 0x8d, 0x82, 0x25,
+     0x03, 0xa4, 0xab, 0x0c, 0xab, 0x0c, 0x03, 0xa4, 0x82, 0x25, 0x2a, 0x8d,
+     0x81, 0x26, 0x29, 0x8e, 0xa8, 0x0f, 0x00, 0xa7, 0x2c, 0x8b, 0x84, 0x23,
+     0x05, 0xa2, 0xad, 0x0a, 0x06, 0xa1, 0xae, 0x09, 0x2f, 0x88, 0x87, 0x20,
+     0x87, 0x20, 0x2f, 0x88, 0xae, 0x09, 0x06, 0xa1, 0xad, 0x0a, 0x05, 0xa2,
+     0x84, 0x23, 0x2c, 0x8b, 0xad, 0x0a, 0x05, 0xa2, 0x84, 0x23, 0x2c, 0x8b,
+     0x87, 0x20, 0x2f, 0x88, 0xae, 0x09, 0x06, 0xa1, 0x06, 0xa1, 0xae, 0x09,
+     0x2f, 0x88, 0x87, 0x20, 0x2c, 0x8b, 0x84, 0x23, 0x05, 0xa2, 0xad, 0x0a,
+     0x81, 0x26, 0x29, 0x8e, 0xa8, 0x0f, 0x00, 0xa7, 0xab, 0x0c, 0x03, 0xa4,
+     0x82, 0x25, 0x2a, 0x8d, 0x2a, 0x8d, 0x82, 0x25, 0x03, 0xa4, 0xab, 0x0c,
+     0x00, 0xa7, 0xa8, 0x0f, 0x29, 0x8e, 0x81, 0x26, 0xae, 0x09, 0x06, 0xa1,
+     0x87, 0x20, 0x2f, 0x88, 0x84, 0x23, 0x2c, 0x8b, 0xad, 0x0a, 0x05, 0xa2,
+     0x05, 0xa2, 0xad, 0x0a, 0x2c, 0x8b, 0x84, 0x23, 0x2f, 0x88, 0x87, 0x20,
+     0x06, 0xa1, 0xae, 0x09, 0x82, 0x25, 0x2a, 0x8d, 0xab, 0x0c, 0x03, 0xa4,
+     0xa8, 0x0f, 0x00, 0xa7, 0x81, 0x26, 0x29, 0x8e, 0x29, 0x8e, 0x81, 0x26,
+     0x00, 0xa7, 0xa8, 0x0f, 0x03, 0xa4, 0xab, 0x0c, 0x2a, 0x8d, 0x82, 0x25,
+     0x03, 0xa4, 0xab, 0x0c, 0x2a, 0x8d, 0x82, 0x25, 0x29, 0x8e, 0x81, 0x26,
+     0x00, 0xa7, 0xa8, 0x0f, 0xa8, 0x0f, 0x00, 0xa7, 0x81, 0x26, 0x29, 0x8e,
+     0x82, 0x25, 0x2a, 0x8d, 0xab, 0x0c, 0x03, 0xa4, 0x2f, 0x88, 0x87, 0x20,
+     0x06, 0xa1, 0xae, 0x09, 0x05, 0xa2, 0xad, 0x0a, 0x2c, 0x8b, 0x84, 0x23,
+     0x84, 0x23, 0x2c, 0x8b, 0xad, 0x0a, 0x05, 0xa2, 0xae, 0x09, 0x06, 0xa1,
+     0x87, 0x20, 0x2f, 0x88},
+    {0x00, 0x2f, 0xb0, 0x9f, 0x31, 0x1e, 0x81, 0xae, 0x32, 0x1d, 0x82, 0xad,
+     0x03, 0x2c, 0xb3, 0x9c, 0xb3, 0x9c, 0x03, 0x2c, 0x82, 0xad, 0x32, 0x1d,
+     0x81, 0xae, 0x31, 0x1e, 0xb0, 0x9f, 0x00, 0x2f, 0x34, 0x1b, 0x84, 0xab,
+     0x05, 0x2a, 0xb5, 0x9a, 0x06, 0x29, 0xb6, 0x99, 0x37, 0x18, 0x87, 0xa8,
+     0x87, 0xa8, 0x37, 0x18, 0xb6, 0x99, 0x06, 0x29, 0xb5, 0x9a, 0x05, 0x2a,
+     0x84, 0xab, 0x34, 0x1b, 0xb5, 0x9a, 0x05, 0x2a, 0x84, 0xab, 0x34, 0x1b,
+     0x87, 0xa8, 0x37, 0x18, 0xb6, 0x99, 0x06, 0x29, 0x06, 0x29, 0xb6, 0x99,
+     0x37, 0x18, 0x87, 0xa8, 0x34, 0x1b, 0x84, 0xab, 0x05, 0x2a, 0xb5, 0x9a,
+     0x81, 0xae, 0x31, 0x1e, 0xb0, 0x9f, 0x00, 0x2f, 0xb3, 0x9c, 0x03, 0x2c,
+     0x82, 0xad, 0x32, 0x1d, 0x32, 0x1d, 0x82, 0xad, 0x03, 0x2c, 0xb3, 0x9c,
+     0x00, 0x2f, 0xb0, 0x9f, 0x31, 0x1e, 0x81, 0xae, 0xb6, 0x99, 0x06, 0x29,
+     0x87, 0xa8, 0x37, 0x18, 0x84, 0xab, 0x34, 0x1b, 0xb5, 0x9a, 0x05, 0x2a,
+     0x05, 0x2a, 0xb5, 0x9a, 0x34, 0x1b, 0x84, 0xab, 0x37, 0x18, 0x87, 0xa8,
+     0x06, 0x29, 0xb6, 0x99, 0x82, 0xad, 0x32, 0x1d, 0xb3, 0x9c, 0x03, 0x2c,
+     0xb0, 0x9f, 0x00, 0x2f, 0x81, 0xae, 0x31, 0x1e, 0x31, 0x1e, 0x81, 0xae,
+     0x00, 0x2f, 0xb0, 0x9f, 0x03, 0x2c, 0xb3, 0x9c, 0x32, 0x1d, 0x82, 0xad,
+     0x03, 0x2c, 0xb3, 0x9c, 0x32, 0x1d, 0x82, 0xad, 0x31, 0x1e, 0x81, 0xae,
+     0x00, 0x2f, 0xb0, 0x9f, 0xb0, 0x9f, 0x00, 0x2f, 0x81, 0xae, 0x31, 0x1e,
+     0x82, 0xad, 0x32, 0x1d, 0xb3, 0x9c, 0x03, 0x2c, 0x37, 0x18, 0x87, 0xa8,
+     0x06, 0x29, 0xb6, 0x99, 0x05, 0x2a, 0xb5, 0x9a, 0x34, 0x1b, 0x84, 0xab,
+     0x84, 0xab, 0x34, 0x1b, 0xb5, 0x9a, 0x05, 0x2a, 0xb6, 0x99, 0x06, 0x29,
+     0x87, 0xa8, 0x37, 0x18},
+    {0x00, 0x37, 0x38, 0x0f, 0xb9, 0x8e, 0x81, 0xb6, 0xba, 0x8d, 0x82, 0xb5,
+     0x03, 0x34, 0x3b, 0x0c, 0x3b, 0x0c, 0x03, 0x34, 0x82, 0xb5, 0xba, 0x8d,
+     0x81, 0xb6, 0xb9, 0x8e, 0x38, 0x0f, 0x00, 0x37, 0xbc, 0x8b, 0x84, 0xb3,
+     0x05, 0x32, 0x3d, 0x0a, 0x06, 0x31, 0x3e, 0x09, 0xbf, 0x88, 0x87, 0xb0,
+     0x87, 0xb0, 0xbf, 0x88, 0x3e, 0x09, 0x06, 0x31, 0x3d, 0x0a, 0x05, 0x32,
+     0x84, 0xb3, 0xbc, 0x8b, 0x3d, 0x0a, 0x05, 0x32, 0x84, 0xb3, 0xbc, 0x8b,
+     0x87, 0xb0, 0xbf, 0x88, 0x3e, 0x09, 0x06, 0x31, 0x06, 0x31, 0x3e, 0x09,
+     0xbf, 0x88, 0x87, 0xb0, 0xbc, 0x8b, 0x84, 0xb3, 0x05, 0x32, 0x3d, 0x0a,
+     0x81, 0xb6, 0xb9, 0x8e, 0x38, 0x0f, 0x00, 0x37, 0x3b, 0x0c, 0x03, 0x34,
+     0x82, 0xb5, 0xba, 0x8d, 0xba, 0x8d, 0x82, 0xb5, 0x03, 0x34, 0x3b, 0x0c,
+     0x00, 0x37, 0x38, 0x0f, 0xb9, 0x8e, 0x81, 0xb6, 0x3e, 0x09, 0x06, 0x31,
+     0x87, 0xb0, 0xbf, 0x88, 0x84, 0xb3, 0xbc, 0x8b, 0x3d, 0x0a, 0x05, 0x32,
+     0x05, 0x32, 0x3d, 0x0a, 0xbc, 0x8b, 0x84, 0xb3, 0xbf, 0x88, 0x87, 0xb0,
+     0x06, 0x31, 0x3e, 0x09, 0x82, 0xb5, 0xba, 0x8d, 0x3b, 0x0c, 0x03, 0x34,
+     0x38, 0x0f, 0x00, 0x37, 0x81, 0xb6, 0xb9, 0x8e, 0xb9, 0x8e, 0x81, 0xb6,
+     0x00, 0x37, 0x38, 0x0f, 0x03, 0x34, 0x3b, 0x0c, 0xba, 0x8d, 0x82, 0xb5,
+     0x03, 0x34, 0x3b, 0x0c, 0xba, 0x8d, 0x82, 0xb5, 0xb9, 0x8e, 0x81, 0xb6,
+     0x00, 0x37, 0x38, 0x0f, 0x38, 0x0f, 0x00, 0x37, 0x81, 0xb6, 0xb9, 0x8e,
+     0x82, 0xb5, 0xba, 0x8d, 0x3b, 0x0c, 0x03, 0x34, 0xbf, 0x88, 0x87, 0xb0,
+     0x06, 0x31, 0x3e, 0x09, 0x05, 0x32, 0x3d, 0x0a, 0xbc, 0x8b, 0x84, 0xb3,
+     0x84, 0xb3, 0xbc, 0x8b, 0x3d, 0x0a, 0x05, 0x32, 0x3e, 0x09, 0x06, 0x31,
+     0x87, 0xb0, 0xbf, 0x88},
+    {0x00, 0xbf, 0xc1, 0x7e, 0xc2, 0x7d, 0x03, 0xbc, 0x43, 0xfc, 0x82, 0x3d,
+     0x81, 0x3e, 0x40, 0xff, 0xc4, 0x7b, 0x05, 0xba, 0x06, 0xb9, 0xc7, 0x78,
+     0x87, 0x38, 0x46, 0xf9, 0x45, 0xfa, 0x84, 0x3b, 0x45, 0xfa, 0x84, 0x3b,
+     0x87, 0x38, 0x46, 0xf9, 0x06, 0xb9, 0xc7, 0x78, 0xc4, 0x7b, 0x05, 0xba,
+     0x81, 0x3e, 0x40, 0xff, 0x43, 0xfc, 0x82, 0x3d, 0xc2, 0x7d, 0x03, 0xbc,
+     0x00, 0xbf, 0xc1, 0x7e, 0x46, 0xf9, 0x87, 0x38, 0x84, 0x3b, 0x45, 0xfa,
+     0x05, 0xba, 0xc4, 0x7b, 0xc7, 0x78, 0x06, 0xb9, 0x82, 0x3d, 0x43, 0xfc,
+     0x40, 0xff, 0x81, 0x3e, 0xc1, 0x7e, 0x00, 0xbf, 0x03, 0xbc, 0xc2, 0x7d,
+     0x03, 0xbc, 0xc2, 0x7d, 0xc1, 0x7e, 0x00, 0xbf, 0x40, 0xff, 0x81, 0x3e,
+     0x82, 0x3d, 0x43, 0xfc, 0xc7, 0x78, 0x06, 0xb9, 0x05, 0xba, 0xc4, 0x7b,
+     0x84, 0x3b, 0x45, 0xfa, 0x46, 0xf9, 0x87, 0x38, 0xc7, 0x78, 0x06, 0xb9,
+     0x05, 0xba, 0xc4, 0x7b, 0x84, 0x3b, 0x45, 0xfa, 0x46, 0xf9, 0x87, 0x38,
+     0x03, 0xbc, 0xc2, 0x7d, 0xc1, 0x7e, 0x00, 0xbf, 0x40, 0xff, 0x81, 0x3e,
+     0x82, 0x3d, 0x43, 0xfc, 0x82, 0x3d, 0x43, 0xfc, 0x40, 0xff, 0x81, 0x3e,
+     0xc1, 0x7e, 0x00, 0xbf, 0x03, 0xbc, 0xc2, 0x7d, 0x46, 0xf9, 0x87, 0x38,
+     0x84, 0x3b, 0x45, 0xfa, 0x05, 0xba, 0xc4, 0x7b, 0xc7, 0x78, 0x06, 0xb9,
+     0x81, 0x3e, 0x40, 0xff, 0x43, 0xfc, 0x82, 0x3d, 0xc2, 0x7d, 0x03, 0xbc,
+     0x00, 0xbf, 0xc1, 0x7e, 0x45, 0xfa, 0x84, 0x3b, 0x87, 0x38, 0x46, 0xf9,
+     0x06, 0xb9, 0xc7, 0x78, 0xc4, 0x7b, 0x05, 0xba, 0xc4, 0x7b, 0x05, 0xba,
+     0x06, 0xb9, 0xc7, 0x78, 0x87, 0x38, 0x46, 0xf9, 0x45, 0xfa, 0x84, 0x3b,
+     0x00, 0xbf, 0xc1, 0x7e, 0xc2, 0x7d, 0x03, 0xbc, 0x43, 0xfc, 0x82, 0x3d,
+     0x81, 0x3e, 0x40, 0xff},
+};
+
+static const uint8_t kColsHamming72_64[64] = {
+    0x83, 0x85, 0x86, 0x87, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f, 0x91,
+    0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d,
+    0x9e, 0x9f, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa,
+    0xab, 0xac, 0xad, 0xae, 0xaf, 0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6,
+    0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf, 0xc1, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7,
+};
+
+uint8_t enc_secded_hamming_72_64(const uint8_t bytes[8]) {
+  return encode(kEncHamming72_64, bytes, 8);
+}
+
+uint8_t dec_secded_hamming_72_64(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_hamming_72_64(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  // The last check bit also covers the other check bits.
+  syndrome ^= (uint8_t)(__builtin_parity(syndrome & 0x7f) << 7);
+  correct(bytes, syndrome, kColsHamming72_64, 64);
+  return hamming_err(syndrome, 8);
+}
+
+void enc_secded_hamming_72_64_buf(const uint8_t *data, uint8_t *ecc,
+                                  size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_hamming_72_64(&data[8 * i]);
+  }
+}
+
+uint8_t dec_secded_hamming_72_64_buf(uint8_t *data, const uint8_t *ecc,
+                                     size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_hamming_72_64(&data[8 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
+}
 
-  return (calc_parity(word & 0xb9000000001fffff, false) << 0) |
-         (calc_parity(word & 0x5e00000fffe0003f, false) << 1) |
-         (calc_parity(word & 0x67003ff003e007c1, false) << 2) |
-         (calc_parity(word & 0xcd0fc0f03c207842, false) << 3) |
-         (calc_parity(word & 0xb671c711c4438884, false) << 4) |
-         (calc_parity(word & 0xb5b65926488c9108, false) << 5) |
-         (calc_parity(word & 0xcbdaaa4a91152210, false) << 6) |
-         (calc_parity(word & 0x7aed348d221a4420, false) << 7);
+static const uint8_t kEncHamming76_68[9][256] = {
+    {0x00, 0x83, 0x85, 0x06, 0x86, 0x05, 0x03, 0x80, 0x07, 0x84, 0x82, 0x01,
+     0x81, 0x02, 0x04, 0x87, 0x89, 0x0a, 0x0c, 0x8f, 0x0f, 0x8c, 0x8a, 0x09,
+     0x8e, 0x0d, 0x0b, 0x88, 0x08, 0x8b, 0x8d, 0x0e, 0x8a, 0x09, 0x0f, 0x8c,
+     0x0c, 0x8f, 0x89, 0x0a, 0x8d, 0x0e, 0x08, 0x8b, 0x0b, 0x88, 0x8e, 0x0d,
+     0x03, 0x80, 0x86, 0x05, 0x85, 0x06, 0x00, 0x83, 0x04, 0x87, 0x81, 0x02,
+     0x82, 0x01, 0x07, 0x84, 0x0b, 0x88, 0x8e, 0x0d, 0x8d, 0x0e, 0x08, 0x8b,
+     0x0c, 0x8f, 0x89, 0x0a, 0x8a, 0x09, 0x0f, 0x8c, 0x82, 0x01, 0x07, 0x84,
+     0x04, 0x87, 0x81, 0x02, 0x85, 0x06, 0x00, 0x83, 0x03, 0x80, 0x86, 0x05,
+     0x81, 0x02, 0x04, 0x87, 0x07, 0x84, 0x82, 0x01, 0x86, 0x05, 0x03, 0x80,
+     0x00, 0x83, 0x85, 0x06, 0x08, 0x8b, 0x8d, 0x0e, 0x8e, 0x0d, 0x0b, 0x88,
+     0x0f, 0x8c, 0x8a, 0x09, 0x89, 0x0a, 0x0c, 0x8f, 0x8c, 0x0f, 0x09, 0x8a,
+     0x0a, 0x89, 0x8f, 0x0c, 0x8b, 0x08, 0x0e, 0x8d, 0x0d, 0x8e, 0x88, 0x0b,
+     0x05, 0x86, 0x80, 0x03, 0x83, 0x00, 0x06, 0x85, 0x02, 0x81, 0x87, 0x04,
+     0x84, 0x07, 0x01, 0x82, 0x06, 0x85, 0x83, 0x00, 0x80, 0x03, 0x05, 0x86,
+     0x01, 0x82, 0x84, 0x07, 0x87, 0x04, 0x02, 0x81, 0x8f, 0x0c, 0x0a, 0x89,
+     0x09, 0x8a, 0x8c, 0x0f, 0x88, 0x0b, 0x0d, 0x8e, 0x0e, 0x8d, 0x8b, 0x08,
+     0x87, 0x04, 0x02, 0x81, 0x01, 0x82, 0x84, 0x07, 0x80, 0x03, 0x05, 0x86,
+     0x06, 0x85, 0x83, 0x00, 0x0e, 0x8d, 0x8b, 0x08, 0x88, 0x0b, 0x0d, 0x8e,
+     0x09, 0x8a, 0x8c, 0x0f, 0x8f, 0x0c, 0x0a, 0x89, 0x0d, 0x8e, 0x88, 0x0b,
+     0x8b, 0x08, 0x0e, 0x8d, 0x0a, 0x89, 0x8f, 0x0c, 0x8c, 0x0f, 0x09, 0x8a,
+     0x84, 0x07, 0x01, 0x82, 0x02, 0x81, 0x87, 0x04, 0x83, 0x00, 0x06, 0x85,
+     0x05, 0x86, 0x80, 0x03},
+    {0x00, 0x0d, 0x0e, 0x03, 0x8f, 0x82, 0x81, 0x8c, 0x91, 0x9c, 0x9f, 0x92,
+     0x1e, 0x13, 0x10, 0x1d, 0x92, 0x9f, 0x9c, 0x91, 0x1d, 0x10, 0x13, 0x1e,
+     0x03, 0x0e, 0x0d, 0x00, 0x8c, 0x81, 0x82, 0x8f, 0x13, 0x1e, 0x1d, 0x10,
+     0x9c, 0x91, 0x92, 0x9f, 0x82, 0x8f, 0x8c, 0x81, 0x0d, 0x00, 0x03, 0x0e,
+     0x81, 0x8c, 0x8f, 0x82, 0x0e, 0x03, 0x00, 0x0d, 0x10, 0x1d, 0x1e, 0x13,
+     0x9f, 0x92, 0x91, 0x9c, 0x94, 0x99, 0x9a, 0x97, 0x1b, 0x16, 0x15, 0x18,
+     0x05, 0x08, 0x0b, 0x06, 0x8a, 0x87, 0x84, 0x89, 0x06, 0x0b, 0x08, 0x05,
+     0x89, 0x84, 0x87, 0x8a, 0x97, 0x9a, 0x99, 0x94, 0x18, 0x15, 0x16, 0x1b,
+     0x87, 0x8a, 0x89, 0x84, 0x08, 0x05, 0x06, 0x0b, 0x16, 0x1b, 0x18, 0x15,
+     0x99, 0x94, 0x97, 0x9a, 0x15, 0x18, 0x1b, 0x16, 0x9a, 0x97, 0x94, 0x99,
+     0x84, 0x89, 0x8a, 0x87, 0x0b, 0x06, 0x05, 0x08, 0x15, 0x18, 0x1b, 0x16,
+     0x9a, 0x97, 0x94, 0x99, 0x84, 0x89, 0x8a, 0x87, 0x0b, 0x06, 0x05, 0x08,
+     0x87, 0x8a, 0x89, 0x84, 0x08, 0x05, 0x06, 0x0b, 0x16, 0x1b, 0x18, 0x15,
+     0x99, 0x94, 0x97, 0x9a, 0x06, 0x0b, 0x08, 0x05, 0x89, 0x84, 0x87, 0x8a,
+     0x97, 0x9a, 0x99, 0x94, 0x18, 0x15, 0x16, 0x1b, 0x94, 0x99, 0x9a, 0x97,
+     0x1b, 0x16, 0x15, 0x18, 0x05, 0x08, 0x0b, 0x06, 0x8a, 0x87, 0x84, 0x89,
+     0x81, 0x8c, 0x8f, 0x82, 0x0e, 0x03, 0x00, 0x0d, 0x10, 0x1d, 0x1e, 0x13,
+     0x9f, 0x92, 0x91, 0x9c, 0x13, 0x1e, 0x1d, 0x10, 0x9c, 0x91, 0x92, 0x9f,
+     0x82, 0x8f, 0x8c, 0x81, 0x0d, 0x00, 0x03, 0x0e, 0x92, 0x9f, 0x9c, 0x91,
+     0x1d, 0x10, 0x13, 0x1e, 0x03, 0x0e, 0x0d, 0x00, 0x8c, 0x81, 0x82, 0x8f,
+     0x00, 0x0d, 0x0e, 0x03, 0x8f, 0x82, 0x81, 0x8c, 0x91, 0x9c, 0x9f, 0x92,
+     0x1e, 0x13, 0x10, 0x1d},
+    {0x00, 0x16, 0x97, 0x81, 0x98, 0x8e, 0x0f, 0x19, 0x19, 0x0f, 0x8e, 0x98,
+     0x81, 0x97, 0x16, 0x00, 0x1a, 0x0c, 0x8d, 0x9b, 0x82, 0x94, 0x15, 0x03,
+     0x03, 0x15, 0x94, 0x82, 0x9b, 0x8d, 0x0c, 0x1a, 0x9b, 0x8d, 0x0c, 0x1a,
+     0x03, 0x15, 0x94, 0x82, 0x82, 0x94, 0x15, 0x03, 0x1a, 0x0c, 0x8d, 0x9b,
+     0x81, 0x97, 0x16, 0x00, 0x19, 0x0f, 0x8e, 0x98, 0x98, 0x8e, 0x0f, 0x19,
+     0x00, 0x16, 0x97, 0x81, 0x1c, 0x0a, 0x8b, 0x9d, 0x84, 0x92, 0x13, 0x05,
+     0x05, 0x13, 0x92, 0x84, 0x9d, 0x8b, 0x0a, 0x1c, 0x06, 0x10, 0x91, 0x87,
+     0x9e, 0x88, 0x09, 0x1f, 0x1f, 0x09, 0x88, 0x9e, 0x87, 0x91, 0x10, 0x06,
+     0x87, 0x91, 0x10, 0x06, 0x1f, 0x09, 0x88, 0x9e, 0x9e, 0x88, 0x09, 0x1f,
+     0x06, 0x10, 0x91, 0x87, 0x9d, 0x8b, 0x0a, 0x1c, 0x05, 0x13, 0x92, 0x84,
+     0x84, 0x92, 0x13, 0x05, 0x1c, 0x0a, 0x8b, 0x9d, 0x9d, 0x8b, 0x0a, 0x1c,
+     0x05, 0x13, 0x92, 0x84, 0x84, 0x92, 0x13, 0x05, 0x1c, 0x0a, 0x8b, 0x9d,
+     0x87, 0x91, 0x10, 0x06, 0x1f, 0x09, 0x88, 0x9e, 0x9e, 0x88, 0x09, 0x1f,
+     0x06, 0x10, 0x91, 0x87, 0x06, 0x10, 0x91, 0x87, 0x9e, 0x88, 0x09, 0x1f,
+     0x1f, 0x09, 0x88, 0x9e, 0x87, 0x91, 0x10, 0x06, 0x1c, 0x0a, 0x8b, 0x9d,
+     0x84, 0x92, 0x13, 0x05, 0x05, 0x13, 0x92, 0x84, 0x9d, 0x8b, 0x0a, 0x1c,
+     0x81, 0x97, 0x16, 0x00, 0x19, 0x0f, 0x8e, 0x98, 0x98, 0x8e, 0x0f, 0x19,
+     0x00, 0x16, 0x97, 0x81, 0x9b, 0x8d, 0x0c, 0x1a, 0x03, 0x15, 0x94, 0x82,
+     0x82, 0x94, 0x15, 0x03, 0x1a, 0x0c, 0x8d, 0x9b, 0x1a, 0x0c, 0x8d, 0x9b,
+     0x82, 0x94, 0x15, 0x03, 0x03, 0x15, 0x94, 0x82, 0x9b, 0x8d, 0x0c, 0x1a,
+     0x00, 0x16, 0x97, 0x81, 0x98, 0x8e, 0x0f, 0x19, 0x19, 0x0f, 0x8e, 0x98,
+     0x81, 0x97, 0x16, 0x00},
+    {0x00, 0x9e, 0x1f, 0x81, 0xa1, 0x3f, 0xbe, 0x20, 0xa2, 0x3c, 0xbd, 0x23,
+     0x03, 0x9d, 0x1c, 0x82, 0x23, 0xbd, 0x3c, 0xa2, 0x82, 0x1c, 0x9d, 0x03,
+     0x81, 0x1f, 0x9e, 0x00, 0x20, 0xbe, 0x3f, 0xa1, 0xa4, 0x3a, 0xbb, 0x25,
+     0x05, 0x9b, 0x1a, 0x84, 0x06, 0x98, 0x19, 0x87, 0xa7, 0x39, 0xb8, 0x26,
+     0x87, 0x19, 0x98, 0x06, 0x26, 0xb8, 0x39, 0xa7, 0x25, 0xbb, 0x3a, 0xa4,
+     0x84, 0x1a, 0x9b, 0x05, 0x25, 0xbb, 0x3a, 0xa4, 0x84, 0x1a, 0x9b, 0x05,
+     0x87, 0x19, 0x98, 0x06, 0x26, 0xb8, 0x39, 0xa7, 0x06, 0x98, 0x19, 0x87,
+     0xa7, 0x39, 0xb8, 0x26, 0xa4, 0x3a, 0xbb, 0x25, 0x05, 0x9b, 0x1a, 0x84,
+     0x81, 0x1f, 0x9e, 0x00, 0x20, 0xbe, 0x3f, 0xa1, 0x23, 0xbd, 0x3c, 0xa2,
+     0x82, 0x1c, 0x9d, 0x03, 0xa2, 0x3c, 0xbd, 0x23, 0x03, 0x9d, 0x1c, 0x82,
+     0x00, 0x9e, 0x1f, 0x81, 0xa1, 0x3f, 0xbe, 0x20, 0x26, 0xb8, 0x39, 0xa7,
+     0x87, 0x19, 0x98, 0x06, 0x84, 0x1a, 0x9b, 0x05, 0x25, 0xbb, 0x3a, 0xa4,
+     0x05, 0x9b, 0x1a, 0x84, 0xa4, 0x3a, 0xbb, 0x25, 0xa7, 0x39, 0xb8, 0x26,
+     0x06, 0x98, 0x19, 0x87, 0x82, 0x1c, 0x9d, 0x03, 0x23, 0xbd, 0x3c, 0xa2,
+     0x20, 0xbe, 0x3f, 0xa1, 0x81, 0x1f, 0x9e, 0x00, 0xa1, 0x3f, 0xbe, 0x20,
+     0x00, 0x9e, 0x1f, 0x81, 0x03, 0x9d, 0x1c, 0x82, 0xa2, 0x3c, 0xbd, 0x23,
+     0x03, 0x9d, 0x1c, 0x82, 0xa2, 0x3c, 0xbd, 0x23, 0xa1, 0x3f, 0xbe, 0x20,
+     0x00, 0x9e, 0x1f, 0x81, 0x20, 0xbe, 0x3f, 0xa1, 0x81, 0x1f, 0x9e, 0x00,
+     0x82, 0x1c, 0x9d, 0x03, 0x23, 0xbd, 0x3c, 0xa2, 0xa7, 0x39, 0xb8, 0x26,
+     0x06, 0x98, 0x19, 0x87, 0x05, 0x9b, 0x1a, 0x84, 0xa4, 0x3a, 0xbb, 0x25,
+     0x84, 0x1a, 0x9b, 0x05, 0x25, 0xbb, 0x3a, 0xa4, 0x26, 0xb8, 0x39, 0xa7,
+     0x87, 0x19, 0x98, 0x06},
+    {0x00, 0xa7, 0xa8, 0x0f, 0x29, 0x8e, 0x81, 0x26, 0x2a, 0x8d, 0x82, 0x25,
+     0x03, 0xa4, 0xab, 0x0c, 0xab, 0x0c, 0x03, 0xa4, 0x82, 0x25, 0x2a, 0x8d,
+     0x81, 0x26, 0x29, 0x8e, 0xa8, 0x0f, 0x00, 0xa7, 0x2c, 0x8b, 0x84, 0x23,
+     0x05, 0xa2, 0xad, 0x0a, 0x06, 0xa1, 0xae, 0x09, 0x2f, 0x88, 0x87, 0x20,
+     0x87, 0x20, 0x2f, 0x88, 0xae, 0x09, 0x06, 0xa1, 0xad, 0x0a, 0x05, 0xa2,
+     0x84, 0x23, 0x2c, 0x8b, 0xad, 0x0a, 0x05, 0xa2, 0x84, 0x23, 0x2c, 0x8b,
+     0x87, 0x20, 0x2f, 0x88, 0xae, 0x09, 0x06, 0xa1, 0x06, 0xa1, 0xae, 0x09,
+     0x2f, 0x88, 0x87, 0x20, 0x2c, 0x8b, 0x84, 0x23, 0x05, 0xa2, 0xad, 0x0a,
+     0x81, 0x26, 0x29, 0x8e, 0xa8, 0x0f, 0x00, 0xa7, 0xab, 0x0c, 0x03, 0xa4,
+     0x82, 0x25, 0x2a, 0x8d, 0x2a, 0x8d, 0x82, 0x25, 0x03, 0xa4, 0xab, 0x0c,
+     0x00, 0xa7, 0xa8, 0x0f, 0x29, 0x8e, 0x81, 0x26, 0xae, 0x09, 0x06, 0xa1,
+     0x87, 0x20, 0x2f, 0x88, 0x84, 0x23, 0x2c, 0x8b, 0xad, 0x0a, 0x05, 0xa2,
+     0x05, 0xa2, 0xad, 0x0a, 0x2c, 0x8b, 0x84, 0x23, 0x2f, 0x88, 0x87, 0x20,
+     0x06, 0xa1, 0xae, 0x09, 0x82, 0x25, 0x2a, 0x8d, 0xab, 0x0c, 0x03, 0xa4,
+     0xa8, 0x0f, 0x00, 0xa7, 0x81, 0x26, 0x29, 0x8e, 0x29, 0x8e, 0x81, 0x26,
+     0x00, 0xa7, 0xa8, 0x0f, 0x03, 0xa4, 0xab, 0x0c, 0x2a, 0x8d, 0x82, 0x25,
+     0x03, 0xa4, 0xab, 0x0c, 0x2a, 0x8d, 0x82, 0x25, 0x29, 0x8e, 0x81, 0x26,
+     0x00, 0xa7, 0xa8, 0x0f, 0xa8, 0x0f, 0x00, 0xa7, 0x81, 0x26, 0x29, 0x8e,
+     0x82, 0x25, 0x2a, 0x8d, 0xab, 0x0c, 0x03, 0xa4, 0x2f, 0x88, 0x87, 0x20,
+     0x06, 0xa1, 0xae, 0x09, 0x05, 0xa2, 0xad, 0x0a, 0x2c, 0x8b, 0x84, 0x23,
+     0x84, 0x23, 0x2c, 0x8b, 0xad, 0x0a, 0x05, 0xa2, 0xae, 0x09, 0x06, 0xa1,
+     0x87, 0x20, 0x2f, 0x88},
+    {0x00, 0x2f, 0xb0, 0x9f, 0x31, 0x1e, 0x81, 0xae, 0x32, 0x1d, 0x82, 0xad,
+     0x03, 0x2c, 0xb3, 0x9c, 0xb3, 0x9c, 0x03, 0x2c, 0x82, 0xad, 0x32, 0x1d,
+     0x81, 0xae, 0x31, 0x1e, 0xb0, 0x9f, 0x00, 0x2f, 0x34, 0x1b, 0x84, 0xab,
+     0x05, 0x2a, 0xb5, 0x9a, 0x06, 0x29, 0xb6, 0x99, 0x37, 0x18, 0x87, 0xa8,
+     0x87, 0xa8, 0x37, 0x18, 0xb6, 0x99, 0x06, 0x29, 0xb5, 0x9a, 0x05, 0x2a,
+     0x84, 0xab, 0x34, 0x1b, 0xb5, 0x9a, 0x05, 0x2a, 0x84, 0xab, 0x34, 0x1b,
+     0x87, 0xa8, 0x37, 0x18, 0xb6, 0x99, 0x06, 0x29, 0x06, 0x29, 0xb6, 0x99,
+     0x37, 0x18, 0x87, 0xa8, 0x34, 0x1b, 0x84, 0xab, 0x05, 0x2a, 0xb5, 0x9a,
+     0x81, 0xae, 0x31, 0x1e, 0xb0, 0x9f, 0x00, 0x2f, 0xb3, 0x9c, 0x03, 0x2c,
+     0x82, 0xad, 0x32, 0x1d, 0x32, 0x1d, 0x82, 0xad, 0x03, 0x2c, 0xb3, 0x9c,
+     0x00, 0x2f, 0xb0, 0x9f, 0x31, 0x1e, 0x81, 0xae, 0xb6, 0x99, 0x06, 0x29,
+     0x87, 0xa8, 0x37, 0x18, 0x84, 0xab, 0x34, 0x1b, 0xb5, 0x9a, 0x05, 0x2a,
+     0x05, 0x2a, 0xb5, 0x9a, 0x34, 0x1b, 0x84, 0xab, 0x37, 0x18, 0x87, 0xa8,
+     0x06, 0x29, 0xb6, 0x99, 0x82, 0xad, 0x32, 0x1d, 0xb3, 0x9c, 0x03, 0x2c,
+     0xb0, 0x9f, 0x00, 0x2f, 0x81, 0xae, 0x31, 0x1e, 0x31, 0x1e, 0x81, 0xae,
+     0x00, 0x2f, 0xb0, 0x9f, 0x03, 0x2c, 0xb3, 0x9c, 0x32, 0x1d, 0x82, 0xad,
+     0x03, 0x2c, 0xb3, 0x9c, 0x32, 0x1d, 0x82, 0xad, 0x31, 0x1e, 0x81, 0xae,
+     0x00, 0x2f, 0xb0, 0x9f, 0xb0, 0x9f, 0x00, 0x2f, 0x81, 0xae, 0x31, 0x1e,
+     0x82, 0xad, 0x32, 0x1d, 0xb3, 0x9c, 0x03, 0x2c, 0x37, 0x18, 0x87, 0xa8,
+     0x06, 0x29, 0xb6, 0x99, 0x05, 0x2a, 0xb5, 0x9a, 0x34, 0x1b, 0x84, 0xab,
+     0x84, 0xab, 0x34, 0x1b, 0xb5, 0x9a, 0x05, 0x2a, 0xb6, 0x99, 0x06, 0x29,
+     0x87, 0xa8, 0x37, 0x18},
+    {0x00, 0x37, 0x38, 0x0f, 0xb9, 0x8e, 0x81, 0xb6, 0xba, 0x8d, 0x82, 0xb5,
+     0x03, 0x34, 0x3b, 0x0c, 0x3b, 0x0c, 0x03, 0x34, 0x82, 0xb5, 0xba, 0x8d,
+     0x81, 0xb6, 0xb9, 0x8e, 0x38, 0x0f, 0x00, 0x37, 0xbc, 0x8b, 0x84, 0xb3,
+     0x05, 0x32, 0x3d, 0x0a, 0x06, 0x31, 0x3e, 0x09, 0xbf, 0x88, 0x87, 0xb0,
+     0x87, 0xb0, 0xbf, 0x88, 0x3e, 0x09, 0x06, 0x31, 0x3d, 0x0a, 0x05, 0x32,
+     0x84, 0xb3, 0xbc, 0x8b, 0x3d, 0x0a, 0x05, 0x32, 0x84, 0xb3, 0xbc, 0x8b,
+     0x87, 0xb0, 0xbf, 0x88, 0x3e, 0x09, 0x06, 0x31, 0x06, 0x31, 0x3e, 0x09,
+     0xbf, 0x88, 0x87, 0xb0, 0xbc, 0x8b, 0x84, 0xb3, 0x05, 0x32, 0x3d, 0x0a,
+     0x81, 0xb6, 0xb9, 0x8e, 0x38, 0x0f, 0x00, 0x37, 0x3b, 0x0c, 0x03, 0x34,
+     0x82, 0xb5, 0xba, 0x8d, 0xba, 0x8d, 0x82, 0xb5, 0x03, 0x34, 0x3b, 0x0c,
+     0x00, 0x37, 0x38, 0x0f, 0xb9, 0x8e, 0x81, 0xb6, 0x3e, 0x09, 0x06, 0x31,
+     0x87, 0xb0, 0xbf, 0x88, 0x84, 0xb3, 0xbc, 0x8b, 0x3d, 0x0a, 0x05, 0x32,
+     0x05, 0x32, 0x3d, 0x0a, 0xbc, 0x8b, 0x84, 0xb3, 0xbf, 0x88, 0x87, 0xb0,
+     0x06, 0x31, 0x3e, 0x09, 0x82, 0xb5, 0xba, 0x8d, 0x3b, 0x0c, 0x03, 0x34,
+     0x38, 0x0f, 0x00, 0x37, 0x81, 0xb6, 0xb9, 0x8e, 0xb9, 0x8e, 0x81, 0xb6,
+     0x00, 0x37, 0x38, 0x0f, 0x03, 0x34, 0x3b, 0x0c, 0xba, 0x8d, 0x82, 0xb5,
+     0x03, 0x34, 0x3b, 0x0c, 0xba, 0x8d, 0x82, 0xb5, 0xb9, 0x8e, 0x81, 0xb6,
+     0x00, 0x37, 0x38, 0x0f, 0x38, 0x0f, 0x00, 0x37, 0x81, 0xb6, 0xb9, 0x8e,
+     0x82, 0xb5, 0xba, 0x8d, 0x3b, 0x0c, 0x03, 0x34, 0xbf, 0x88, 0x87, 0xb0,
+     0x06, 0x31, 0x3e, 0x09, 0x05, 0x32, 0x3d, 0x0a, 0xbc, 0x8b, 0x84, 0xb3,
+     0x84, 0xb3, 0xbc, 0x8b, 0x3d, 0x0a, 0x05, 0x32, 0x3e, 0x09, 0x06, 0x31,
+     0x87, 0xb0, 0xbf, 0x88},
+    {0x00, 0xbf, 0xc1, 0x7e, 0xc2, 0x7d, 0x03, 0xbc, 0x43, 0xfc, 0x82, 0x3d,
+     0x81, 0x3e, 0x40, 0xff, 0xc4, 0x7b, 0x05, 0xba, 0x06, 0xb9, 0xc7, 0x78,
+     0x87, 0x38, 0x46, 0xf9, 0x45, 0xfa, 0x84, 0x3b, 0x45, 0xfa, 0x84, 0x3b,
+     0x87, 0x38, 0x46, 0xf9, 0x06, 0xb9, 0xc7, 0x78, 0xc4, 0x7b, 0x05, 0xba,
+     0x81, 0x3e, 0x40, 0xff, 0x43, 0xfc, 0x82, 0x3d, 0xc2, 0x7d, 0x03, 0xbc,
+     0x00, 0xbf, 0xc1, 0x7e, 0x46, 0xf9, 0x87, 0x38, 0x84, 0x3b, 0x45, 0xfa,
+     0x05, 0xba, 0xc4, 0x7b, 0xc7, 0x78, 0x06, 0xb9, 0x82, 0x3d, 0x43, 0xfc,
+     0x40, 0xff, 0x81, 0x3e, 0xc1, 0x7e, 0x00, 0xbf, 0x03, 0xbc, 0xc2, 0x7d,
+     0x03, 0xbc, 0xc2, 0x7d, 0xc1, 0x7e, 0x00, 0xbf, 0x40, 0xff, 0x81, 0x3e,
+     0x82, 0x3d, 0x43, 0xfc, 0xc7, 0x78, 0x06, 0xb9, 0x05, 0xba, 0xc4, 0x7b,
+     0x84, 0x3b, 0x45, 0xfa, 0x46, 0xf9, 0x87, 0x38, 0xc7, 0x78, 0x06, 0xb9,
+     0x05, 0xba, 0xc4, 0x7b, 0x84, 0x3b, 0x45, 0xfa, 0x46, 0xf9, 0x87, 0x38,
+     0x03, 0xbc, 0xc2, 0x7d, 0xc1, 0x7e, 0x00, 0xbf, 0x40, 0xff, 0x81, 0x3e,
+     0x82, 0x3d, 0x43, 0xfc, 0x82, 0x3d, 0x43, 0xfc, 0x40, 0xff, 0x81, 0x3e,
+     0xc1, 0x7e, 0x00, 0xbf, 0x03, 0xbc, 0xc2, 0x7d, 0x46, 0xf9, 0x87, 0x38,
+     0x84, 0x3b, 0x45, 0xfa, 0x05, 0xba, 0xc4, 0x7b, 0xc7, 0x78, 0x06, 0xb9,
+     0x81, 0x3e, 0x40, 0xff, 0x43, 0xfc, 0x82, 0x3d, 0xc2, 0x7d, 0x03, 0xbc,
+     0x00, 0xbf, 0xc1, 0x7e, 0x45, 0xfa, 0x84, 0x3b, 0x87, 0x38, 0x46, 0xf9,
+     0x06, 0xb9, 0xc7, 0x78, 0xc4, 0x7b, 0x05, 0xba, 0xc4, 0x7b, 0x05, 0xba,
+     0x06, 0xb9, 0xc7, 0x78, 0x87, 0x38, 0x46, 0xf9, 0x45, 0xfa, 0x84, 0x3b,
+     0x00, 0xbf, 0xc1, 0x7e, 0xc2, 0x7d, 0x03, 0xbc, 0x43, 0xfc, 0x82, 0x3d,
+     0x81, 0x3e, 0x40, 0xff},
+    {0x00, 0xc8, 0x49, 0x81, 0x4a, 0x82, 0x03, 0xcb, 0xcb, 0x03, 0x82, 0x4a,
+     0x81, 0x49, 0xc8, 0x00, 0x00, 0xc8, 0x49, 0x81, 0x4a, 0x82, 0x03, 0xcb,
+     0xcb, 0x03, 0x82, 0x4a, 0x81, 0x49, 0xc8, 0x00, 0x00, 0xc8, 0x49, 0x81,
+     0x4a, 0x82, 0x03, 0xcb, 0xcb, 0x03, 0x82, 0x4a, 0x81, 0x49, 0xc8, 0x00,
+     0x00, 0xc8, 0x49, 0x81, 0x4a, 0x82, 0x03, 0xcb, 0xcb, 0x03, 0x82, 0x4a,
+     0x81, 0x49, 0xc8, 0x00, 0x00, 0xc8, 0x49, 0x81, 0x4a, 0x82, 0x03, 0xcb,
+     0xcb, 0x03, 0x82, 0x4a, 0x81, 0x49, 0xc8, 0x00, 0x00, 0xc8, 0x49, 0x81,
+     0x4a, 0x82, 0x03, 0xcb, 0xcb, 0x03, 0x82, 0x4a, 0x81, 0x49, 0xc8, 0x00,
+     0x00, 0xc8, 0x49, 0x81, 0x4a, 0x82, 0x03, 0xcb, 0xcb, 0x03, 0x82, 0x4a,
+     0x81, 0x49, 0xc8, 0x00, 0x00, 0xc8, 0x49, 0x81, 0x4a, 0x82, 0x03, 0xcb,
+     0xcb, 0x03, 0x82, 0x4a, 0x81, 0x49, 0xc8, 0x00, 0x00, 0xc8, 0x49, 0x81,
+     0x4a, 0x82, 0x03, 0xcb, 0xcb, 0x03, 0x82, 0x4a, 0x81, 0x49, 0xc8, 0x00,
+     0x00, 0xc8, 0x49, 0x81, 0x4a, 0x82, 0x03, 0xcb, 0xcb, 0x03, 0x82, 0x4a,
+     0x81, 0x49, 0xc8, 0x00, 0x00, 0xc8, 0x49, 0x81, 0x4a, 0x82, 0x03, 0xcb,
+     0xcb, 0x03, 0x82, 0x4a, 0x81, 0x49, 0xc8, 0x00, 0x00, 0xc8, 0x49, 0x81,
+     0x4a, 0x82, 0x03, 0xcb, 0xcb, 0x03, 0x82, 0x4a, 0x81, 0x49, 0xc8, 0x00,
+     0x00, 0xc8, 0x49, 0x81, 0x4a, 0x82, 0x03, 0xcb, 0xcb, 0x03, 0x82, 0x4a,
+     0x81, 0x49, 0xc8, 0x00, 0x00, 0xc8, 0x49, 0x81, 0x4a, 0x82, 0x03, 0xcb,
+     0xcb, 0x03, 0x82, 0x4a, 0x81, 0x49, 0xc8, 0x00, 0x00, 0xc8, 0x49, 0x81,
+     0x4a, 0x82, 0x03, 0xcb, 0xcb, 0x03, 0x82, 0x4a, 0x81, 0x49, 0xc8, 0x00,
+     0x00, 0xc8, 0x49, 0x81, 0x4a, 0x82, 0x03, 0xcb, 0xcb, 0x03, 0x82, 0x4a,
+     0x81, 0x49, 0xc8, 0x00},
+};
+
+static const uint8_t kColsHamming76_68[68] = {
+    0x83, 0x85, 0x86, 0x87, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f, 0x91,
+    0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d,
+    0x9e, 0x9f, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa,
+    0xab, 0xac, 0xad, 0xae, 0xaf, 0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6,
+    0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf, 0xc1, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb,
+};
+
+uint8_t enc_secded_hamming_76_68(const uint8_t bytes[9]) {
+  return encode(kEncHamming76_68, bytes, 9);
+}
+
+uint8_t dec_secded_hamming_76_68(uint8_t bytes[9], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_hamming_76_68(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  // The last check bit also covers the other check bits.
+  syndrome ^= (uint8_t)(__builtin_parity(syndrome & 0x7f) << 7);
+  correct(bytes, syndrome, kColsHamming76_68, 68);
+  return hamming_err(syndrome, 8);
+}
+
+void enc_secded_hamming_76_68_buf(const uint8_t *data, uint8_t *ecc,
+                                  size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_hamming_76_68(&data[9 * i]);
+  }
+}
+
+uint8_t dec_secded_hamming_76_68_buf(uint8_t *data, const uint8_t *ecc,
+                                     size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_hamming_76_68(&data[9 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
 }
 
 uint8_t enc_secded_inv_22_16(const uint8_t bytes[2]) {
-  uint16_t word = ((uint16_t)bytes[0] << 0) | ((uint16_t)bytes[1] << 8);
+  return encode(kEncHsiao22_16, bytes, 2) ^ 0x2a;
+}
 
-  return (calc_parity(word & 0x496e, false) << 0) |
-         (calc_parity(word & 0xf20b, true) << 1) |
-         (calc_parity(word & 0x8ed8, false) << 2) |
-         (calc_parity(word & 0x7714, true) << 3) |
-         (calc_parity(word & 0xaca5, false) << 4) |
-         (calc_parity(word & 0x11f3, true) << 5);
+uint8_t dec_secded_inv_22_16(uint8_t bytes[2], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_inv_22_16(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  correct(bytes, syndrome, kColsHsiao22_16, 16);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_inv_22_16_buf(const uint8_t *data, uint8_t *ecc, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_inv_22_16(&data[2 * i]);
+  }
+}
+
+uint8_t dec_secded_inv_22_16_buf(uint8_t *data, const uint8_t *ecc,
+                                 size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_inv_22_16(&data[2 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
 }
 
 uint8_t enc_secded_inv_28_22(const uint8_t bytes[3]) {
-  uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
-                  ((uint32_t)bytes[2] << 16);
+  return encode(kEncHsiao28_22, bytes, 3) ^ 0x2a;
+}
+
+uint8_t dec_secded_inv_28_22(uint8_t bytes[3], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_inv_28_22(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  correct(bytes, syndrome, kColsHsiao28_22, 22);
+  return hsiao_err(syndrome);
+}
 
-  return (calc_parity(word & 0x3003ff, false) << 0) |
-         (calc_parity(word & 0x10fc0f, true) << 1) |
-         (calc_parity(word & 0x271c71, false) << 2) |
-         (calc_parity(word & 0x3b6592, true) << 3) |
-         (calc_parity(word & 0x3daaa4, false) << 4) |
-         (calc_parity(word & 0x3ed348, true) << 5);
+void enc_secded_inv_28_22_buf(const uint8_t *data, uint8_t *ecc, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_inv_28_22(&data[3 * i]);
+  }
+}
+
+uint8_t dec_secded_inv_28_22_buf(uint8_t *data, const uint8_t *ecc,
+                                 size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_inv_28_22(&data[3 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
 }
 
 uint8_t enc_secded_inv_39_32(const uint8_t bytes[4]) {
-  uint32_t word = ((uint32_t)bytes[0] << 0) | ((uint32_t)bytes[1] << 8) |
-                  ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+  return encode(kEncHsiao39_32, bytes, 4) ^ 0x2a;
+}
 
-  return (calc_parity(word & 0x2606bd25, false) << 0) |
-         (calc_parity(word & 0xdeba8050, true) << 1) |
-         (calc_parity(word & 0x413d89aa, false) << 2) |
-         (calc_parity(word & 0x31234ed1, true) << 3) |
-         (calc_parity(word & 0xc2c1323b, false) << 4) |
-         (calc_parity(word & 0x2dcc624c, true) << 5) |
-         (calc_parity(word & 0x98505586, false) << 6);
+uint8_t dec_secded_inv_39_32(uint8_t bytes[4], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_inv_39_32(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  correct(bytes, syndrome, kColsHsiao39_32, 32);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_inv_39_32_buf(const uint8_t *data, uint8_t *ecc, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_inv_39_32(&data[4 * i]);
+  }
+}
+
+uint8_t dec_secded_inv_39_32_buf(uint8_t *data, const uint8_t *ecc,
+                                 size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_inv_39_32(&data[4 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
 }
 
 uint8_t enc_secded_inv_64_57(const uint8_t bytes[8]) {
-  uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
-                  ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
-                  ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
-                  ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+  return encode(kEncHsiao64_57, bytes, 8) ^ 0x2a;
+}
 
-  return (calc_parity(word & 0x103fff800007fff, false) << 0) |
-         (calc_parity(word & 0x17c1ff801ff801f, true) << 1) |
-         (calc_parity(word & 0x1bde1f87e0781e1, false) << 2) |
-         (calc_parity(word & 0x1deee3b8e388e22, true) << 3) |
-         (calc_parity(word & 0x1ef76cdb2c93244, false) << 4) |
-         (calc_parity(word & 0x1f7bb56d5525488, true) << 5) |
-         (calc_parity(word & 0x1fbdda769a46910, false) << 6);
+uint8_t dec_secded_inv_64_57(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_inv_64_57(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  correct(bytes, syndrome, kColsHsiao64_57, 57);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_inv_64_57_buf(const uint8_t *data, uint8_t *ecc, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_inv_64_57(&data[8 * i]);
+  }
+}
+
+uint8_t dec_secded_inv_64_57_buf(uint8_t *data, const uint8_t *ecc,
+                                 size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_inv_64_57(&data[8 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
 }
 
 uint8_t enc_secded_inv_72_64(const uint8_t bytes[8]) {
-  uint64_t word = ((uint64_t)bytes[0] << 0) | ((uint64_t)bytes[1] << 8) |
-                  ((uint64_t)bytes[2] << 16) | ((uint64_t)bytes[3] << 24) |
-                  ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
-                  ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
-
-  return (calc_parity(word & 0xb9000000001fffff, false) << 0) |
-         (calc_parity(word & 0x5e00000fffe0003f, true) << 1) |
-         (calc_parity(word & 0x67003ff003e007c1, false) << 2) |
-         (calc_parity(word & 0xcd0fc0f03c207842, true) << 3) |
-         (calc_parity(word & 0xb671c711c4438884, false) << 4) |
-         (calc_parity(word & 0xb5b65926488c9108, true) << 5) |
-         (calc_parity(word & 0xcbdaaa4a91152210, false) << 6) |
-         (calc_parity(word & 0x7aed348d221a4420, true) << 7);
+  return encode(kEncHsiao72_64, bytes, 8) ^ 0xaa;
+}
+
+uint8_t dec_secded_inv_72_64(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_inv_72_64(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  correct(bytes, syndrome, kColsHsiao72_64, 64);
+  return hsiao_err(syndrome);
+}
+
+void enc_secded_inv_72_64_buf(const uint8_t *data, uint8_t *ecc, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_inv_72_64(&data[8 * i]);
+  }
+}
+
+uint8_t dec_secded_inv_72_64_buf(uint8_t *data, const uint8_t *ecc,
+                                 size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_inv_72_64(&data[8 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
+}
+
+uint8_t enc_secded_inv_hamming_22_16(const uint8_t bytes[2]) {
+  return encode(kEncHamming22_16, bytes, 2) ^ 0x2a;
+}
+
+uint8_t dec_secded_inv_hamming_22_16(uint8_t bytes[2], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_inv_hamming_22_16(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  // The last check bit also covers the other check bits.
+  syndrome ^= (uint8_t)(__builtin_parity(syndrome & 0x1f) << 5);
+  correct(bytes, syndrome, kColsHamming22_16, 16);
+  return hamming_err(syndrome, 6);
+}
+
+void enc_secded_inv_hamming_22_16_buf(const uint8_t *data, uint8_t *ecc,
+                                      size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_inv_hamming_22_16(&data[2 * i]);
+  }
+}
+
+uint8_t dec_secded_inv_hamming_22_16_buf(uint8_t *data, const uint8_t *ecc,
+                                         size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_inv_hamming_22_16(&data[2 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
+}
+
+uint8_t enc_secded_inv_hamming_39_32(const uint8_t bytes[4]) {
+  return encode(kEncHamming39_32, bytes, 4) ^ 0x2a;
+}
+
+uint8_t dec_secded_inv_hamming_39_32(uint8_t bytes[4], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_inv_hamming_39_32(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  // The last check bit also covers the other check bits.
+  syndrome ^= (uint8_t)(__builtin_parity(syndrome & 0x3f) << 6);
+  correct(bytes, syndrome, kColsHamming39_32, 32);
+  return hamming_err(syndrome, 7);
+}
+
+void enc_secded_inv_hamming_39_32_buf(const uint8_t *data, uint8_t *ecc,
+                                      size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_inv_hamming_39_32(&data[4 * i]);
+  }
+}
+
+uint8_t dec_secded_inv_hamming_39_32_buf(uint8_t *data, const uint8_t *ecc,
+                                         size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_inv_hamming_39_32(&data[4 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
+}
+
+uint8_t enc_secded_inv_hamming_72_64(const uint8_t bytes[8]) {
+  return encode(kEncHamming72_64, bytes, 8) ^ 0xaa;
+}
+
+uint8_t dec_secded_inv_hamming_72_64(uint8_t bytes[8], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_inv_hamming_72_64(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  // The last check bit also covers the other check bits.
+  syndrome ^= (uint8_t)(__builtin_parity(syndrome & 0x7f) << 7);
+  correct(bytes, syndrome, kColsHamming72_64, 64);
+  return hamming_err(syndrome, 8);
+}
+
+void enc_secded_inv_hamming_72_64_buf(const uint8_t *data, uint8_t *ecc,
+                                      size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_inv_hamming_72_64(&data[8 * i]);
+  }
+}
+
+uint8_t dec_secded_inv_hamming_72_64_buf(uint8_t *data, const uint8_t *ecc,
+                                         size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_inv_hamming_72_64(&data[8 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
+}
+
+uint8_t enc_secded_inv_hamming_76_68(const uint8_t bytes[9]) {
+  return encode(kEncHamming76_68, bytes, 9) ^ 0xaa;
+}
+
+uint8_t dec_secded_inv_hamming_76_68(uint8_t bytes[9], uint8_t ecc) {
+  uint8_t syndrome = enc_secded_inv_hamming_76_68(bytes) ^ ecc;
+  if (syndrome == 0) {
+    return 0;
+  }
+  // The last check bit also covers the other check bits.
+  syndrome ^= (uint8_t)(__builtin_parity(syndrome & 0x7f) << 7);
+  correct(bytes, syndrome, kColsHamming76_68, 68);
+  return hamming_err(syndrome, 8);
+}
+
+void enc_secded_inv_hamming_76_68_buf(const uint8_t *data, uint8_t *ecc,
+                                      size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ecc[i] = enc_secded_inv_hamming_76_68(&data[9 * i]);
+  }
+}
+
+uint8_t dec_secded_inv_hamming_76_68_buf(uint8_t *data, const uint8_t *ecc,
+                                         size_t count, uint8_t *err) {
+  uint8_t all = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t word_err = dec_secded_inv_hamming_76_68(&data[9 * i], ecc[i]);
+    if (err != NULL) {
+      err[i] = word_err;
+    }
+    all |= word_err;
+  }
+  return all;
 }
@@ -8,26 +8,123 @@
 #ifndef OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 #define OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif  // __cplusplus
 
-// Integrity encode functions for varying bit widths matching the functionality
-// of the RTL modules of the same name. Each takes an array of bytes in
-// little-endian order and returns the calculated integrity bits.
+// Integrity functions for varying bit widths matching the functionality of the
+// RTL modules of the same name. Each data word is an array of bytes in
+// little-endian order.
+//
+// - `enc_*` returns the calculated integrity bits.
+// - `dec_*` corrects a single-bit error in `bytes` in place and returns the
+//   RTL `err_o` value: bit 0 flags a single (corrected) error and bit 1 an
+//   uncorrectable error.
+// - `*_buf` process `count` consecutive data words and integrity bytes. The
+//   decoder returns the OR of every word's `err_o` and, if `err` is not NULL,
+//   stores each of them there.
 
 uint8_t enc_secded_22_16(const uint8_t bytes[2]);
+uint8_t dec_secded_22_16(uint8_t bytes[2], uint8_t ecc);
+void enc_secded_22_16_buf(const uint8_t *data, uint8_t *ecc, size_t count);
+uint8_t dec_secded_22_16_buf(uint8_t *data, const uint8_t *ecc, size_t count,
+                             uint8_t *err);
 uint8_t enc_secded_28_22(const uint8_t bytes[3]);
+uint8_t dec_secded_28_22(uint8_t bytes[3], uint8_t ecc);
+void enc_secded_28_22_buf(const uint8_t *data, uint8_t *ecc, size_t count);
+uint8_t dec_secded_28_22_buf(uint8_t *data, const uint8_t *ecc, size_t count,
+                             uint8_t *err);
 uint8_t enc_secded_39_32(const uint8_t bytes[4]);
+uint8_t dec_secded_39_32(uint8_t bytes[4], uint8_t ecc);
+void enc_secded_39_32_buf(const uint8_t *data, uint8_t *ecc, size_t count);
+uint8_t dec_secded_39_32_buf(uint8_t *data, const uint8_t *ecc, size_t count,
+                             uint8_t *err);
 uint8_t enc_secded_64_57(const uint8_t bytes[8]);
+uint8_t dec_secded_64_57(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_64_57_buf(const uint8_t *data, uint8_t *ecc, size_t count);
+uint8_t dec_secded_64_57_buf(uint8_t *data, const uint8_t *ecc, size_t count,
+                             uint8_t *err);
 uint8_t enc_secded_72_64(const uint8_t bytes[8]);
+uint8_t dec_secded_72_64(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_72_64_buf(const uint8_t *data, uint8_t *ecc, size_t count);
+uint8_t dec_secded_72_64_buf(uint8_t *data, const uint8_t *ecc, size_t count,
+                             uint8_t *err);
+uint8_t enc_secded_hamming_22_16(const uint8_t bytes[2]);
+uint8_t dec_secded_hamming_22_16(uint8_t bytes[2], uint8_t ecc);
+void enc_secded_hamming_22_16_buf(const uint8_t *data, uint8_t *ecc,
+                                  size_t count);
+uint8_t dec_secded_hamming_22_16_buf(uint8_t *data, const uint8_t *ecc,
+                                     size_t count, uint8_t *err);
+uint8_t enc_secded_hamming_39_32(const uint8_t bytes[4]);
+uint8_t dec_secded_hamming_39_32(uint8_t bytes[4], uint8_t ecc);
+void enc_secded_hamming_39_32_buf(const uint8_t *data, uint8_t *ecc,
+                                  size_t count);
+uint8_t dec_secded_hamming_39_32_buf(uint8_t *data, const uint8_t *ecc,
+                                     size_t count, uint8_t *err);
+uint8_t enc_secded_hamming_72_64(const uint8_t bytes[8]);
+uint8_t dec_secded_hamming_72_64(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_hamming_72_64_buf(const uint8_t *data, uint8_t *ecc,
+                                  size_t count);
+uint8_t dec_secded_hamming_72_64_buf(uint8_t *data, const uint8_t *ecc,
+                                     size_t count, uint8_t *err);
+uint8_t enc_secded_hamming_76_68(const uint8_t bytes[9]);
+uint8_t dec_secded_hamming_76_68(uint8_t bytes[9], uint8_t ecc);
+void enc_secded_hamming_76_68_buf(const uint8_t *data, uint8_t *ecc,
+                                  size_t count);
+uint8_t dec_secded_hamming_76_68_buf(uint8_t *data, const uint8_t *ecc,
+                                     size_t count, uint8_t *err);
 uint8_t enc_secded_inv_22_16(const uint8_t bytes[2]);
+uint8_t dec_secded_inv_22_16(uint8_t bytes[2], uint8_t ecc);
+void enc_secded_inv_22_16_buf(const uint8_t *data, uint8_t *ecc, size_t count);
+uint8_t dec_secded_inv_22_16_buf(uint8_t *data, const uint8_t *ecc,
+                                 size_t count, uint8_t *err);
 uint8_t enc_secded_inv_28_22(const uint8_t bytes[3]);
+uint8_t dec_secded_inv_28_22(uint8_t bytes[3], uint8_t ecc);
+void enc_secded_inv_28_22_buf(const uint8_t *data, uint8_t *ecc, size_t count);
+uint8_t dec_secded_inv_28_22_buf(uint8_t *data, const uint8_t *ecc,
+                                 size_t count, uint8_t *err);
 uint8_t enc_secded_inv_39_32(const uint8_t bytes[4]);
+uint8_t dec_secded_inv_39_32(uint8_t bytes[4], uint8_t ecc);
+void enc_secded_inv_39_32_buf(const uint8_t *data, uint8_t *ecc, size_t count);
+uint8_t dec_secded_inv_39_32_buf(uint8_t *data, const uint8_t *ecc,
+                                 size_t count, uint8_t *err);
 uint8_t enc_secded_inv_64_57(const uint8_t bytes[8]);
+uint8_t dec_secded_inv_64_57(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_inv_64_57_buf(const uint8_t *data, uint8_t *ecc, size_t count);
+uint8_t dec_secded_inv_64_57_buf(uint8_t *data, const uint8_t *ecc,
+                                 size_t count, uint8_t *err);
 uint8_t enc_secded_inv_72_64(const uint8_t bytes[8]);
+uint8_t dec_secded_inv_72_64(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_inv_72_64_buf(const uint8_t *data, uint8_t *ecc, size_t count);
+uint8_t dec_secded_inv_72_64_buf(uint8_t *data, const uint8_t *ecc,
+                                 size_t count, uint8_t *err);
+uint8_t enc_secded_inv_hamming_22_16(const uint8_t bytes[2]);
+uint8_t dec_secded_inv_hamming_22_16(uint8_t bytes[2], uint8_t ecc);
+void enc_secded_inv_hamming_22_16_buf(const uint8_t *data, uint8_t *ecc,
+                                      size_t count);
+uint8_t dec_secded_inv_hamming_22_16_buf(uint8_t *data, const uint8_t *ecc,
+                                         size_t count, uint8_t *err);
+uint8_t enc_secded_inv_hamming_39_32(const uint8_t bytes[4]);
+uint8_t dec_secded_inv_hamming_39_32(uint8_t bytes[4], uint8_t ecc);
+void enc_secded_inv_hamming_39_32_buf(const uint8_t *data, uint8_t *ecc,
+                                      size_t count);
+uint8_t dec_secded_inv_hamming_39_32_buf(uint8_t *data, const uint8_t *ecc,
+                                         size_t count, uint8_t *err);
+uint8_t enc_secded_inv_hamming_72_64(const uint8_t bytes[8]);
+uint8_t dec_secded_inv_hamming_72_64(uint8_t bytes[8], uint8_t ecc);
+void enc_secded_inv_hamming_72_64_buf(const uint8_t *data, uint8_t *ecc,
+                                      size_t count);
+uint8_t dec_secded_inv_hamming_72_64_buf(uint8_t *data, const uint8_t *ecc,
+                                         size_t count, uint8_t *err);
+uint8_t enc_secded_inv_hamming_76_68(const uint8_t bytes[9]);
+uint8_t dec_secded_inv_hamming_76_68(uint8_t bytes[9], uint8_t ecc);
+void enc_secded_inv_hamming_76_68_buf(const uint8_t *data, uint8_t *ecc,
+                                      size_t count);
+uint8_t dec_secded_inv_hamming_76_68_buf(uint8_t *data, const uint8_t *ecc,
+                                         size_t count, uint8_t *err);
 
 #ifdef __cplusplus
 }  // extern "C"
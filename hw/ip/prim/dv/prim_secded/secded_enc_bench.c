@@ -0,0 +1,404 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Self-check and microbenchmark for the generated SECDED library.
+//
+// For every code in secded_cfg.hjson, checks the table-driven encoder against
+// the bit-serial parity computation of the RTL, checks that the decoder
+// corrects every single-bit error and flags double-bit errors, and checks the
+// batch functions against the per-word ones. Then times the 39_32 and 72_64
+// encoders and decoders. Built and run as `//hw/ip/prim:secded_enc_bench`;
+// rerun it after regenerating secded_enc.c.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "secded_enc.h"
+
+enum {
+  kRoundTrips = 2000,
+  kExhaustiveWords = 8,
+  kBufWords = 256,
+  kBenchBytes = 1 << 20,
+  kBenchRounds = 8,
+  kMaxWordBytes = 9,
+};
+
+// A parity mask over a codeword of up to 128 bits, data bits first.
+typedef struct mask {
+  uint64_t lo;
+  uint64_t hi;
+} mask_t;
+
+// Parity masks of the RTL encoders, one per check bit, as computed by
+// util/design/secded_gen.py. The Hamming masks cover the check bits before
+// them, so they are applied to the codeword as it is built.
+static const mask_t kMasksHsiao22_16[6] = {
+    {0x496e, 0x0}, {0xf20b, 0x0}, {0x8ed8, 0x0},
+    {0x7714, 0x0}, {0xaca5, 0x0}, {0x11f3, 0x0},
+};
+
+static const mask_t kMasksHsiao28_22[6] = {
+    {0x3003ff, 0x0}, {0x10fc0f, 0x0}, {0x271c71, 0x0},
+    {0x3b6592, 0x0}, {0x3daaa4, 0x0}, {0x3ed348, 0x0},
+};
+
+static const mask_t kMasksHsiao39_32[7] = {
+    {0x2606bd25, 0x0}, {0xdeba8050, 0x0}, {0x413d89aa, 0x0},
+    {0x31234ed1, 0x0}, {0xc2c1323b, 0x0}, {0x2dcc624c, 0x0},
+    {0x98505586, 0x0},
+};
+
+static const mask_t kMasksHsiao64_57[7] = {
+    {0x103fff800007fff, 0x0}, {0x17c1ff801ff801f, 0x0},
+    {0x1bde1f87e0781e1, 0x0}, {0x1deee3b8e388e22, 0x0},
+    {0x1ef76cdb2c93244, 0x0}, {0x1f7bb56d5525488, 0x0},
+    {0x1fbdda769a46910, 0x0},
+};
+
+static const mask_t kMasksHsiao72_64[8] = {
+    {0xb9000000001fffff, 0x0}, {0x5e00000fffe0003f, 0x0},
+    {0x67003ff003e007c1, 0x0}, {0xcd0fc0f03c207842, 0x0},
+    {0xb671c711c4438884, 0x0}, {0xb5b65926488c9108, 0x0},
+    {0xcbdaaa4a91152210, 0x0}, {0x7aed348d221a4420, 0x0},
+};
+
+static const mask_t kMasksHamming22_16[6] = {
+    {0xad5b, 0x0}, {0x366d, 0x0}, {0xc78e, 0x0},
+    {0x7f0, 0x0},  {0xf800, 0x0}, {0x1fffff, 0x0},
+};
+
+static const mask_t kMasksHamming39_32[7] = {
+    {0x56aaad5b, 0x0}, {0x9b33366d, 0x0}, {0xe3c3c78e, 0x0},
+    {0x3fc07f0, 0x0},  {0x3fff800, 0x0},  {0xfc000000, 0x0},
+    {0x3fffffffff, 0x0},
+};
+
+static const mask_t kMasksHamming72_64[8] = {
+    {0xab55555556aaad5b, 0x0}, {0xcd9999999b33366d, 0x0},
+    {0xf1e1e1e1e3c3c78e, 0x0}, {0x1fe01fe03fc07f0, 0x0},
+    {0x1fffe0003fff800, 0x0},  {0x1fffffffc000000, 0x0},
+    {0xfe00000000000000, 0x0}, {0xffffffffffffffff, 0x7f},
+};
+
+static const mask_t kMasksHamming76_68[8] = {
+    {0xab55555556aaad5b, 0xa}, {0xcd9999999b33366d, 0xc},
+    {0xf1e1e1e1e3c3c78e, 0x0}, {0x1fe01fe03fc07f0, 0xf},
+    {0x1fffe0003fff800, 0x0},  {0x1fffffffc000000, 0x0},
+    {0xfe00000000000000, 0xf}, {0xffffffffffffffff, 0x7ff},
+};
+
+typedef struct secded_code {
+  const char *name;
+  unsigned k;
+  unsigned m;
+  const mask_t *masks;
+  bool inverted;
+  uint8_t (*enc)(const uint8_t *);
+  uint8_t (*dec)(uint8_t *, uint8_t);
+  void (*enc_buf)(const uint8_t *, uint8_t *, size_t);
+  uint8_t (*dec_buf)(uint8_t *, const uint8_t *, size_t, uint8_t *);
+} secded_code_t;
+
+#define CODE(suffix_, type_, inv_, n_, k_)                            \
+  {                                                                   \
+    "secded" #suffix_ "_" #n_ "_" #k_, k_, n_ - k_,                   \
+        kMasks##type_##n_##_##k_, inv_,                               \
+        enc_secded##suffix_##_##n_##_##k_,                            \
+        dec_secded##suffix_##_##n_##_##k_,                            \
+        enc_secded##suffix_##_##n_##_##k_##_buf,                      \
+        dec_secded##suffix_##_##n_##_##k_##_buf,                      \
+  }
+
+static const secded_code_t kCodes[] = {
+    CODE(, Hsiao, false, 22, 16),
+    CODE(, Hsiao, false, 28, 22),
+    CODE(, Hsiao, false, 39, 32),
+    CODE(, Hsiao, false, 64, 57),
+    CODE(, Hsiao, false, 72, 64),
+    CODE(_hamming, Hamming, false, 22, 16),
+    CODE(_hamming, Hamming, false, 39, 32),
+    CODE(_hamming, Hamming, false, 72, 64),
+    CODE(_hamming, Hamming, false, 76, 68),
+    CODE(_inv, Hsiao, true, 22, 16),
+    CODE(_inv, Hsiao, true, 28, 22),
+    CODE(_inv, Hsiao, true, 39, 32),
+    CODE(_inv, Hsiao, true, 64, 57),
+    CODE(_inv, Hsiao, true, 72, 64),
+    CODE(_inv_hamming, Hamming, true, 22, 16),
+    CODE(_inv_hamming, Hamming, true, 39, 32),
+    CODE(_inv_hamming, Hamming, true, 72, 64),
+    CODE(_inv_hamming, Hamming, true, 76, 68),
+};
+
+static int failures;
+
+#define EXPECT(cond, ...)           \
+  do {                              \
+    if (!(cond)) {                  \
+      fprintf(stderr, __VA_ARGS__); \
+      fputc('\n', stderr);          \
+      ++failures;                   \
+    }                               \
+  } while (false)
+
+static size_t word_bytes(const secded_code_t *code) {
+  return (code->k + 7) / 8;
+}
+
+static bool parity64(uint64_t bits) {
+  bool parity = false;
+  while (bits) {
+    parity = !parity;
+    bits &= bits - 1;
+  }
+  return parity;
+}
+
+// The encoder the tables replaced: one parity reduction per check bit, over
+// the data and the check bits computed so far, as in the RTL.
+static uint8_t ref_encode(const secded_code_t *code, const uint8_t *bytes) {
+  mask_t word = {0, 0};
+  for (size_t i = 0; i < word_bytes(code); ++i) {
+    if (i < 8) {
+      word.lo |= (uint64_t)bytes[i] << (8 * i);
+    } else {
+      word.hi |= (uint64_t)bytes[i] << (8 * (i - 8));
+    }
+  }
+  uint8_t ecc = 0;
+  for (unsigned j = 0; j < code->m; ++j) {
+    const mask_t *mask = &code->masks[j];
+    bool bit = parity64(word.lo & mask->lo) ^ parity64(word.hi & mask->hi);
+    ecc |= (uint8_t)(bit << j);
+    unsigned pos = code->k + j;
+    if (pos < 64) {
+      word.lo |= (uint64_t)bit << pos;
+    } else {
+      word.hi |= (uint64_t)bit << (pos - 64);
+    }
+  }
+  if (code->inverted) {
+    // Every odd check bit is inverted.
+    ecc ^= (uint8_t)(0xaa & ((1u << code->m) - 1));
+  }
+  return ecc;
+}
+
+static void random_word(uint8_t *bytes, unsigned k) {
+  for (unsigned i = 0; i < (k + 7) / 8; ++i) {
+    bytes[i] = (uint8_t)rand();
+  }
+  if (k % 8 != 0) {
+    bytes[k / 8] &= (uint8_t)((1 << (k % 8)) - 1);
+  }
+}
+
+// Flips bit `bit` of the codeword formed by `bytes` and `ecc`.
+static void flip(uint8_t *bytes, uint8_t *ecc, unsigned k, unsigned bit) {
+  if (bit < k) {
+    bytes[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+  } else {
+    *ecc ^= (uint8_t)(1 << (bit - k));
+  }
+}
+
+static void check_encode(const secded_code_t *code) {
+  uint8_t bytes[kMaxWordBytes];
+  for (int i = 0; i < kRoundTrips; ++i) {
+    random_word(bytes, code->k);
+    EXPECT(code->enc(bytes) == ref_encode(code, bytes),
+           "%s: encoder differs from reference", code->name);
+  }
+}
+
+// Decodes `orig` with bits `a` and `b` of its codeword flipped, or only `a` if
+// `b` is `a`, and checks the error flags and the corrected data.
+static void check_flips(const secded_code_t *code, const uint8_t *orig,
+                        uint8_t ecc, unsigned a, unsigned b) {
+  size_t len = word_bytes(code);
+  uint8_t bytes[kMaxWordBytes];
+  memcpy(bytes, orig, len);
+  flip(bytes, &ecc, code->k, a);
+  if (a == b) {
+    EXPECT(code->dec(bytes, ecc) == 1, "%s: bit %u not a single error",
+           code->name, a);
+    EXPECT(memcmp(bytes, orig, len) == 0, "%s: bit %u not corrected",
+           code->name, a);
+  } else {
+    flip(bytes, &ecc, code->k, b);
+    EXPECT(code->dec(bytes, ecc) == 2, "%s: bits %u and %u not a double error",
+           code->name, a, b);
+  }
+}
+
+static void check_decode(const secded_code_t *code) {
+  unsigned n = code->k + code->m;
+  size_t len = word_bytes(code);
+  uint8_t orig[kMaxWordBytes];
+  uint8_t bytes[kMaxWordBytes];
+  for (int i = 0; i < kRoundTrips; ++i) {
+    random_word(orig, code->k);
+    uint8_t ecc = code->enc(orig);
+
+    memcpy(bytes, orig, len);
+    EXPECT(code->dec(bytes, ecc) == 0, "%s: error in clean word", code->name);
+    EXPECT(memcmp(bytes, orig, len) == 0, "%s: clean word changed",
+           code->name);
+
+    if (i < kExhaustiveWords) {
+      // Every single and double error of a few words.
+      for (unsigned a = 0; a < n; ++a) {
+        for (unsigned b = a; b < n; ++b) {
+          check_flips(code, orig, ecc, a, b);
+        }
+      }
+    } else {
+      unsigned a = (unsigned)rand() % n;
+      unsigned b = (a + 1 + (unsigned)rand() % (n - 1)) % n;
+      check_flips(code, orig, ecc, a, a);
+      check_flips(code, orig, ecc, a, b);
+    }
+  }
+}
+
+static void check_buf(const secded_code_t *code) {
+  size_t len = word_bytes(code);
+  uint8_t orig[kBufWords * kMaxWordBytes];
+  uint8_t data[kBufWords * kMaxWordBytes];
+  uint8_t ecc[kBufWords];
+  uint8_t err[kBufWords];
+  uint8_t expected_err[kBufWords];
+  for (size_t i = 0; i < kBufWords; ++i) {
+    random_word(&orig[len * i], code->k);
+  }
+
+  code->enc_buf(orig, ecc, kBufWords);
+  for (size_t i = 0; i < kBufWords; ++i) {
+    EXPECT(ecc[i] == code->enc(&orig[len * i]),
+           "%s: enc_buf differs at word %zu", code->name, i);
+  }
+
+  memcpy(data, orig, sizeof(data));
+  EXPECT(code->dec_buf(data, ecc, kBufWords, NULL) == 0,
+         "%s: dec_buf error in clean buffer", code->name);
+
+  // Single errors in every third word and double errors in every fifth.
+  uint8_t expected_all = 0;
+  for (size_t i = 0; i < kBufWords; ++i) {
+    unsigned n = code->k + code->m;
+    unsigned a = (unsigned)(i * 7) % n;
+    expected_err[i] = 0;
+    if (i % 5 == 0) {
+      flip(&data[len * i], &ecc[i], code->k, a);
+      flip(&data[len * i], &ecc[i], code->k, (a + 1) % n);
+      expected_err[i] = 2;
+    } else if (i % 3 == 0) {
+      flip(&data[len * i], &ecc[i], code->k, a);
+      expected_err[i] = 1;
+    }
+    expected_all |= expected_err[i];
+  }
+  uint8_t all = code->dec_buf(data, ecc, kBufWords, err);
+  EXPECT(all == expected_all, "%s: dec_buf returned %u", code->name, all);
+  for (size_t i = 0; i < kBufWords; ++i) {
+    EXPECT(err[i] == expected_err[i], "%s: dec_buf err %u at word %zu",
+           code->name, err[i], i);
+    if (expected_err[i] != 2) {
+      EXPECT(memcmp(&data[len * i], &orig[len * i], len) == 0,
+             "%s: dec_buf did not correct word %zu", code->name, i);
+    }
+  }
+}
+
+static double seconds(void) { return (double)clock() / CLOCKS_PER_SEC; }
+
+static void report(const char *name, double elapsed) {
+  double bytes = (double)kBenchBytes * kBenchRounds;
+  if (elapsed > 0) {
+    printf("%-24s %8.1f MiB/s\n", name, bytes / elapsed / (1 << 20));
+  } else {
+    printf("%-24s too fast to time\n", name);
+  }
+}
+
+static void bench(const secded_code_t *code, const uint8_t *data,
+                  uint8_t *copy, uint8_t *ecc) {
+  size_t len = word_bytes(code);
+  size_t count = kBenchBytes / len;
+  char name[40];
+  uint32_t acc = 0;
+
+  double start = seconds();
+  for (int r = 0; r < kBenchRounds; ++r) {
+    for (size_t i = 0; i < count; ++i) {
+      acc += ref_encode(code, &data[len * i]);
+    }
+  }
+  snprintf(name, sizeof(name), "reference %u_%u", code->k + code->m, code->k);
+  report(name, seconds() - start);
+
+  start = seconds();
+  for (int r = 0; r < kBenchRounds; ++r) {
+    for (size_t i = 0; i < count; ++i) {
+      acc += code->enc(&data[len * i]);
+    }
+  }
+  snprintf(name, sizeof(name), "enc_%s", code->name);
+  report(name, seconds() - start);
+
+  start = seconds();
+  for (int r = 0; r < kBenchRounds; ++r) {
+    code->enc_buf(data, ecc, count);
+  }
+  snprintf(name, sizeof(name), "enc_%s_buf", code->name);
+  report(name, seconds() - start);
+
+  memcpy(copy, data, kBenchBytes);
+  start = seconds();
+  for (int r = 0; r < kBenchRounds; ++r) {
+    acc += code->dec_buf(copy, ecc, count, NULL);
+  }
+  snprintf(name, sizeof(name), "dec_%s_buf", code->name);
+  report(name, seconds() - start);
+
+  // Keeps the timed loops from being optimized away.
+  printf("(check %08x)\n", (unsigned)acc);
+}
+
+int main(void) {
+  srand(1);
+
+  for (size_t i = 0; i < sizeof(kCodes) / sizeof(kCodes[0]); ++i) {
+    check_encode(&kCodes[i]);
+    check_decode(&kCodes[i]);
+    check_buf(&kCodes[i]);
+  }
+  if (failures != 0) {
+    fprintf(stderr, "%d failures\n", failures);
+    return 1;
+  }
+  printf("self-check passed\n");
+
+  uint8_t *data = malloc(kBenchBytes);
+  uint8_t *copy = malloc(kBenchBytes);
+  uint8_t *ecc = malloc(kBenchBytes / 4);
+  if (data == NULL || copy == NULL || ecc == NULL) {
+    return 1;
+  }
+  for (size_t i = 0; i < kBenchBytes; ++i) {
+    data[i] = (uint8_t)rand();
+  }
+  bench(&kCodes[2], data, copy, ecc);
+  bench(&kCodes[4], data, copy, ecc);
+  free(data);
+  free(copy);
+  free(ecc);
+  return 0;
+}
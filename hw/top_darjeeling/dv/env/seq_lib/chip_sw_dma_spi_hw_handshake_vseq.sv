@@ -28,6 +28,7 @@ class chip_sw_dma_spi_hw_handshake_vseq extends chip_sw_base_vseq;
     bit[7:0] sha_mode_arr[1];
     bit [7:0] kSoftwareBarrier[] = '{0};
     bit abort = 1'b0;
+    int sha_mode = $urandom_range(0, 2);
     int retval;
     bit [$bits(dma_pkg::dma_ctrl_state_e)-1:0] dma_state;
     time dma_busy_timeout = 120_000_000; // 120ms
@@ -38,6 +39,7 @@ class chip_sw_dma_spi_hw_handshake_vseq extends chip_sw_base_vseq;
     `uvm_info(`gfn, "Testing with spi host 0", UVM_LOW)
 
     void'($value$plusargs("abort=%0d", abort));
+    void'($value$plusargs("sha_mode=%0d", sha_mode));
 
     if (abort) begin
       `uvm_info(`gfn, "Testing abort mode", UVM_LOW)
@@ -56,8 +58,9 @@ class chip_sw_dma_spi_hw_handshake_vseq extends chip_sw_base_vseq;
     m_device_dma_seq = spi_device_dma_seq::type_id::create("m_device_dma_seq");
     msg = m_device_dma_seq.get_data();
 
-    // Randomize the SHA mode and compute the expected hash of the source data
-    unique case($urandom_range(0, 2))
+    // Randomize the SHA mode, unless the test fixes it, and compute the
+    // expected hash of the source data
+    unique case(sha_mode)
       0: begin
         cryptoc_dpi_pkg::sv_dpi_get_sha256_digest(msg, exp_digest[0:7]);
         sha_mode_arr = {dma_pkg::OpcSha256};
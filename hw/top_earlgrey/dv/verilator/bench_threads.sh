@@ -0,0 +1,83 @@
+#!/bin/bash
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+# Compare how long a Verilator test takes with models built for different
+# numbers of simulation threads.
+#
+# Each thread count builds its own Verilated model (the first build of each
+# takes a while), then runs the test, which boots the test ROM and the test
+# program from flash, with cached results disabled. The time reported is the
+# one Bazel measures for the test itself, so it excludes the model build.
+#
+# With -d, each thread count gets a second row for a model built with
+# `--threads-dpi all`, which lets Verilator call the DPI models from any
+# simulation thread instead of serializing the calls.
+#
+# Usage:
+#   hw/top_earlgrey/dv/verilator/bench_threads.sh [-d] [-t TEST] [-r RUNS] \
+#     [N ...]
+#
+# TEST defaults to //sw/device/tests:uart_smoketest_sim_verilator, RUNS to 3
+# and the thread counts to 1 and 4.
+
+set -e
+
+TEST=//sw/device/tests:uart_smoketest_sim_verilator
+RUNS=3
+DPI_MODES=(none)
+
+while getopts "dt:r:" opt; do
+  case "${opt}" in
+    d) DPI_MODES=(none all) ;;
+    t) TEST="${OPTARG}" ;;
+    r) RUNS="${OPTARG}" ;;
+    *)
+      echo "Usage: $0 [-d] [-t TEST] [-r RUNS] [THREADS ...]" >&2
+      exit 1
+      ;;
+  esac
+done
+shift $((OPTIND - 1))
+
+THREADS=("$@")
+if [[ ${#THREADS[@]} -eq 0 ]]; then
+  THREADS=(1 4)
+fi
+
+REPO_TOP="$(git rev-parse --show-toplevel)"
+cd "${REPO_TOP}"
+
+for n in "${THREADS[@]}"; do
+  for dpi in "${DPI_MODES[@]}"; do
+    options="--threads,${n}"
+    label="$(printf '%2d thread(s)' "${n}")"
+    if [[ "${dpi}" == all ]]; then
+      options+=",--threads-dpi,all"
+      label+=", DPI on all"
+    fi
+    flags=(
+      "--//hw:verilator_options=${options}"
+      "--test_output=summary"
+      "--nocache_test_results"
+    )
+    # Build the model up front so that its build time is not mixed in with
+    # the first run.
+    ./bazelisk.sh build "${flags[@]}" "${TEST}" >/dev/null 2>&1
+    times=()
+    for ((run = 0; run < RUNS; run++)); do
+      seconds="$(./bazelisk.sh test "${flags[@]}" "${TEST}" 2>&1 |
+        sed -n 's/.*PASSED in \([0-9.]*\)s.*/\1/p')"
+      if [[ -z "${seconds}" ]]; then
+        echo "${TEST} did not pass with ${label# }" >&2
+        exit 1
+      fi
+      times+=("${seconds}")
+    done
+    printf '%-28s %s\n' "${label}:" "${times[*]}" |
+      awk -v runs="${RUNS}" '{ s = 0;
+        for (i = NF - runs + 1; i <= NF; i++) s += $i;
+        printf "%s  mean %.1fs\n", $0, s / runs }'
+  done
+done
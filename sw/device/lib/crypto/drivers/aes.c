@@ -28,6 +28,11 @@ enum {
   kAesKeyWordLenMax = kAesKeyWordLen256,
 };
 
+/**
+ * Whether a streaming operation has reserved the AES block.
+ */
+static hardened_bool_t aes_reserved = kHardenedBoolFalse;
+
 /**
  * Spins until the AES hardware reports a specific status bit.
  */
@@ -99,6 +104,9 @@ static status_t aes_write_key(aes_key_t key) {
  */
 static status_t aes_begin(aes_key_t key, const aes_block_t *iv,
                           hardened_bool_t encrypt) {
+  // Do not disturb an operation that has reserved the block.
+  HARDENED_TRY(aes_reservation_check());
+
   // Ensure the entropy complex is in an appropriate state. The AES block seeds
   // its PRNG from EDN for masking every time a new key is provided.
   HARDENED_TRY(entropy_complex_check());
@@ -243,6 +251,20 @@ static status_t aes_begin(aes_key_t key, const aes_block_t *iv,
   return OTCRYPTO_OK;
 }
 
+status_t aes_reservation_check(void) {
+  if (launder32(aes_reserved) != kHardenedBoolFalse) {
+    return OTCRYPTO_ASYNC_INCOMPLETE;
+  }
+  HARDENED_CHECK_EQ(aes_reserved, kHardenedBoolFalse);
+  return OTCRYPTO_OK;
+}
+
+status_t aes_reserve(void) {
+  HARDENED_TRY(aes_reservation_check());
+  aes_reserved = kHardenedBoolTrue;
+  return OTCRYPTO_OK;
+}
+
 status_t aes_encrypt_begin(const aes_key_t key, const aes_block_t *iv) {
   return aes_begin(key, iv, kHardenedBoolTrue);
 }
@@ -283,6 +305,8 @@ status_t aes_update(aes_block_t *dest, const aes_block_t *src) {
 }
 
 status_t aes_end(aes_block_t *iv) {
+  aes_reserved = kHardenedBoolFalse;
+
   uint32_t ctrl_reg = AES_CTRL_SHADOWED_REG_RESVAL;
   ctrl_reg = bitfield_bit32_write(ctrl_reg,
                                   AES_CTRL_SHADOWED_MANUAL_OPERATION_BIT, true);
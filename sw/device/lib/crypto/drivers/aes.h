@@ -109,6 +109,30 @@ status_t aes_encrypt_begin(const aes_key_t key, const aes_block_t *iv);
 OT_WARN_UNUSED_RESULT
 status_t aes_decrypt_begin(const aes_key_t key, const aes_block_t *iv);
 
+/**
+ * Check that no operation has reserved the AES block.
+ *
+ * Callers that make the key manager sideload an AES key should check this
+ * first, since the new key would replace the one in use.
+ *
+ * @return OK, or `OTCRYPTO_ASYNC_INCOMPLETE` if the block is reserved.
+ */
+OT_WARN_UNUSED_RESULT
+status_t aes_reservation_check(void);
+
+/**
+ * Reserve the AES block for the operation that was just started.
+ *
+ * Call after `aes_encrypt_begin` or `aes_decrypt_begin` when the operation
+ * will span multiple calls into the cryptolib. Until `aes_end` is called, the
+ * begin functions return `OTCRYPTO_ASYNC_INCOMPLETE` so that other users do
+ * not reconfigure the block in the middle of the operation.
+ *
+ * @return OK, or `OTCRYPTO_ASYNC_INCOMPLETE` if the block is already reserved.
+ */
+OT_WARN_UNUSED_RESULT
+status_t aes_reserve(void);
+
 /**
  * Advances the AES state by a single block.
  *
@@ -143,6 +167,8 @@ status_t aes_update(aes_block_t *dest, const aes_block_t *src);
 /**
  * Completes an AES session by clearing control settings and key material.
  *
+ * Also releases the reservation made by `aes_reserve`, if any.
+ *
  * If `iv` is non-null, reads back the final IV block and returns it to the
  * caller.
  *
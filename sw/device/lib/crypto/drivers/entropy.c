@@ -828,8 +828,165 @@ static status_t edn_check(const edn_config_t *config) {
   return OTCRYPTO_RECOV_ERR;
 }
 
+/**
+ * State of the SW CSRNG application interface.
+ *
+ * CSRNG does not accept another command on the SW application interface until
+ * every block requested by a generate command has been read from the genbits
+ * buffer. The driver keeps track of the blocks still to be read, so that it
+ * can drain them before it sends the next command instead of hanging.
+ */
+static struct {
+  /**
+   * Number of 128-bit blocks of the last generate command that have not been
+   * read yet.
+   */
+  uint32_t pending_blocks;
+  /**
+   * Whether the pending blocks are a refill of `entropy_csrng_pool`, rather
+   * than output requested with `entropy_csrng_generate_start()`.
+   */
+  hardened_bool_t pending_refill;
+} entropy_csrng_state = {
+    .pending_blocks = 0,
+    .pending_refill = kHardenedBoolFalse,
+};
+
+/**
+ * Prefetched SW CSRNG output for `entropy_csrng_pool_read()`.
+ */
+static struct {
+  /**
+   * Output words; words [0, `avail`) have not been handed out yet.
+   */
+  uint32_t words[kEntropyCsrngPoolWords];
+  size_t avail;
+  /**
+   * Whether every block in `words` was flagged as FIPS-compatible.
+   */
+  hardened_bool_t fips;
+} entropy_csrng_pool = {
+    .avail = 0,
+    .fips = kHardenedBoolFalse,
+};
+
+/**
+ * Reads blocks from the CSRNG genbits buffer.
+ *
+ * Blocks until each block is available. The first `len` words are written to
+ * `buf` (which may be NULL if `len` is zero); the rest are discarded.
+ *
+ * @param nblocks Number of 128-bit blocks to read.
+ * @param[out] buf Destination buffer.
+ * @param len Number of words to keep.
+ * @param[out] fips Whether every block was flagged as FIPS-compatible.
+ */
+static void csrng_genbits_read(size_t nblocks, uint32_t *buf, size_t len,
+                               hardened_bool_t *fips) {
+  static_assert(kEntropyCsrngBitsBufferNumWords == 4,
+                "kEntropyCsrngBitsBufferNumWords must be 4.");
+  *fips = kHardenedBoolTrue;
+  for (size_t block_idx = 0; block_idx < nblocks; ++block_idx) {
+    // Block until there is more data available in the genbits buffer. CSRNG
+    // generates data in 128bit chunks (i.e. 4 words).
+    uint32_t reg;
+    do {
+      reg = abs_mmio_read32(kBaseCsrng + CSRNG_GENBITS_VLD_REG_OFFSET);
+    } while (!bitfield_bit32_read(reg, CSRNG_GENBITS_VLD_GENBITS_VLD_BIT));
+
+    if (!bitfield_bit32_read(reg, CSRNG_GENBITS_VLD_GENBITS_FIPS_BIT)) {
+      *fips = kHardenedBoolFalse;
+    }
+
+    // Read the full 128-bit block, in reverse word order to match known-answer
+    // tests. To clear the FIFO, we need to read all blocks generated by the
+    // request even if we don't use them.
+    for (size_t offset = 0; offset < kEntropyCsrngBitsBufferNumWords;
+         ++offset) {
+      uint32_t word = abs_mmio_read32(kBaseCsrng + CSRNG_GENBITS_REG_OFFSET);
+      size_t word_idx = (block_idx * kEntropyCsrngBitsBufferNumWords) +
+                        kEntropyCsrngBitsBufferNumWords - 1 - offset;
+      if (word_idx < len) {
+        buf[word_idx] = word;
+      }
+    }
+  }
+}
+
+/**
+ * Reads any blocks left over from the last generate command.
+ *
+ * A pool refill goes into the pool; anything else is discarded.
+ */
+static void csrng_settle(void) {
+  if (entropy_csrng_state.pending_blocks == 0) {
+    return;
+  }
+  if (launder32(entropy_csrng_state.pending_refill) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(entropy_csrng_state.pending_blocks,
+                      kEntropyCsrngPoolBlocks);
+    csrng_genbits_read(kEntropyCsrngPoolBlocks, entropy_csrng_pool.words,
+                       kEntropyCsrngPoolWords, &entropy_csrng_pool.fips);
+    entropy_csrng_pool.avail = kEntropyCsrngPoolWords;
+  } else {
+    hardened_bool_t fips;
+    csrng_genbits_read(entropy_csrng_state.pending_blocks, NULL, 0, &fips);
+  }
+  entropy_csrng_state.pending_blocks = 0;
+  entropy_csrng_state.pending_refill = kHardenedBoolFalse;
+}
+
+/**
+ * Drops any prefetched output.
+ *
+ * Called before commands that change the SW CSRNG state, so that output from
+ * before the change is not handed out afterwards.
+ */
+static void csrng_pool_discard(void) {
+  csrng_settle();
+  memset(entropy_csrng_pool.words, 0, sizeof(entropy_csrng_pool.words));
+  entropy_csrng_pool.avail = 0;
+  entropy_csrng_pool.fips = kHardenedBoolFalse;
+}
+
+/**
+ * Forgets about the SW CSRNG state, which is lost when CSRNG is disabled.
+ */
+static void csrng_state_reset(void) {
+  entropy_csrng_state.pending_blocks = 0;
+  entropy_csrng_state.pending_refill = kHardenedBoolFalse;
+  csrng_pool_discard();
+}
+
+/**
+ * Sends a generate command without waiting for its output.
+ *
+ * @param seed_material Additional data used in the CSRNG generate operation.
+ * @param nblocks Number of 128-bit blocks to generate.
+ * @param refill Whether the output is a refill of the pool.
+ * @return Operation status in `status_t` format.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t csrng_generate_send(
+    const entropy_seed_material_t *seed_material, uint32_t nblocks,
+    hardened_bool_t refill) {
+  csrng_settle();
+  HARDENED_TRY(csrng_send_app_cmd(kBaseCsrng,
+                                  (entropy_csrng_cmd_t){
+                                      .id = kEntropyDrbgOpGenerate,
+                                      .seed_material = seed_material,
+                                      .generate_len = nblocks,
+                                  },
+                                  kEntropyCsrngSendAppCmdTypeCsrng,
+                                  /*check_completion=*/false));
+  entropy_csrng_state.pending_blocks = nblocks;
+  entropy_csrng_state.pending_refill = refill;
+  return OTCRYPTO_OK;
+}
+
 status_t entropy_complex_init(void) {
   entropy_complex_stop_all();
+  csrng_state_reset();
 
   const entropy_complex_config_t *config =
       &kEntropyComplexConfigs[kEntropyComplexConfigIdContinuous];
@@ -859,6 +1016,7 @@ status_t entropy_complex_check(void) {
 status_t entropy_csrng_instantiate(
     hardened_bool_t disable_trng_input,
     const entropy_seed_material_t *seed_material) {
+  csrng_pool_discard();
   return csrng_send_app_cmd(kBaseCsrng,
                             (entropy_csrng_cmd_t){
                                 .id = kEntropyDrbgOpInstantiate,
@@ -871,6 +1029,7 @@ status_t entropy_csrng_instantiate(
 
 status_t entropy_csrng_reseed(hardened_bool_t disable_trng_input,
                               const entropy_seed_material_t *seed_material) {
+  csrng_pool_discard();
   return csrng_send_app_cmd(kBaseCsrng,
                             (entropy_csrng_cmd_t){
                                 .id = kEntropyDrbgOpReseed,
@@ -882,6 +1041,7 @@ status_t entropy_csrng_reseed(hardened_bool_t disable_trng_input,
 }
 
 status_t entropy_csrng_update(const entropy_seed_material_t *seed_material) {
+  csrng_pool_discard();
   return csrng_send_app_cmd(kBaseCsrng,
                             (entropy_csrng_cmd_t){
                                 .id = kEntropyDrbgOpUpdate,
@@ -896,51 +1056,30 @@ status_t entropy_csrng_generate_start(
   // Round up the number of 128bit blocks. Aligning with respect to uint32_t.
   // TODO(#6112): Consider using a canonical reference for alignment operations.
   const uint32_t num_128bit_blocks = ceil_div(len, 4);
-  return csrng_send_app_cmd(kBaseCsrng,
-                            (entropy_csrng_cmd_t){
-                                .id = kEntropyDrbgOpGenerate,
-                                .seed_material = seed_material,
-                                .generate_len = num_128bit_blocks,
-                            },
-                            kEntropyCsrngSendAppCmdTypeCsrng, true);
+  return csrng_generate_send(seed_material, num_128bit_blocks,
+                             /*refill=*/kHardenedBoolFalse);
 }
 
 status_t entropy_csrng_generate_data_get(uint32_t *buf, size_t len,
                                          hardened_bool_t fips_check) {
-  static_assert(kEntropyCsrngBitsBufferNumWords == 4,
-                "kEntropyCsrngBitsBufferNumWords must be 4.");
   size_t nblocks = ceil_div(len, 4);
-  status_t res = OTCRYPTO_OK;
-  for (size_t block_idx = 0; block_idx < nblocks; ++block_idx) {
-    // Block until there is more data available in the genbits buffer. CSRNG
-    // generates data in 128bit chunks (i.e. 4 words).
-    uint32_t reg;
-    do {
-      reg = abs_mmio_read32(kBaseCsrng + CSRNG_GENBITS_VLD_REG_OFFSET);
-    } while (!bitfield_bit32_read(reg, CSRNG_GENBITS_VLD_GENBITS_VLD_BIT));
+  if (launder32(entropy_csrng_state.pending_refill) != kHardenedBoolFalse ||
+      nblocks > entropy_csrng_state.pending_blocks) {
+    // The output was not requested with `entropy_csrng_generate_start()`, or
+    // has already been read or discarded.
+    return OTCRYPTO_BAD_ARGS;
+  }
 
-    if (fips_check != kHardenedBoolFalse &&
-        !bitfield_bit32_read(reg, CSRNG_GENBITS_VLD_GENBITS_FIPS_BIT)) {
-      // Entropy isn't FIPS-compatible, so we should return an error when
-      // done. However, we still need to read the result to clear CSRNG's FIFO.
-      res = OTCRYPTO_RECOV_ERR;
-    }
+  hardened_bool_t fips;
+  csrng_genbits_read(nblocks, buf, len, &fips);
+  entropy_csrng_state.pending_blocks -= nblocks;
 
-    // Read the full 128-bit block, in reverse word order to match known-answer
-    // tests. To clear the FIFO, we need to read all blocks generated by the
-    // request even if we don't use them.
-    for (size_t offset = 0; offset < kEntropyCsrngBitsBufferNumWords;
-         ++offset) {
-      uint32_t word = abs_mmio_read32(kBaseCsrng + CSRNG_GENBITS_REG_OFFSET);
-      size_t word_idx = (block_idx * kEntropyCsrngBitsBufferNumWords) +
-                        kEntropyCsrngBitsBufferNumWords - 1 - offset;
-      if (word_idx < len) {
-        buf[word_idx] = word;
-      }
-    }
+  if (fips_check != kHardenedBoolFalse && fips != kHardenedBoolTrue) {
+    // Entropy isn't FIPS-compatible. The output has been read anyway, to clear
+    // CSRNG's FIFO.
+    return OTCRYPTO_RECOV_ERR;
   }
-
-  return res;
+  return OTCRYPTO_OK;
 }
 
 status_t entropy_csrng_generate(const entropy_seed_material_t *seed_material,
@@ -950,7 +1089,59 @@ status_t entropy_csrng_generate(const entropy_seed_material_t *seed_material,
   return entropy_csrng_generate_data_get(buf, len, fips_check);
 }
 
+status_t entropy_csrng_pool_read(uint32_t *buf, size_t len,
+                                 hardened_bool_t fips_check) {
+  if (launder32(entropy_csrng_state.pending_refill) != kHardenedBoolTrue &&
+      entropy_csrng_state.pending_blocks != 0) {
+    // Refilling the pool would discard output that the caller has requested
+    // with `entropy_csrng_generate_start()` but not read yet.
+    return OTCRYPTO_RECOV_ERR;
+  }
+
+  status_t res = OTCRYPTO_OK;
+  while (len > 0) {
+    if (entropy_csrng_pool.avail == 0) {
+      if (launder32(entropy_csrng_state.pending_refill) != kHardenedBoolTrue) {
+        HARDENED_TRY(csrng_generate_send(&kEntropyEmptySeed,
+                                         kEntropyCsrngPoolBlocks,
+                                         /*refill=*/kHardenedBoolTrue));
+      }
+      // Waits for the refill and moves it into the pool.
+      csrng_settle();
+    }
+    if (fips_check != kHardenedBoolFalse &&
+        entropy_csrng_pool.fips != kHardenedBoolTrue) {
+      res = OTCRYPTO_RECOV_ERR;
+    }
+
+    // Hand out words from the top of the pool and clear them.
+    size_t n = len < entropy_csrng_pool.avail ? len : entropy_csrng_pool.avail;
+    entropy_csrng_pool.avail -= n;
+    uint32_t *words = &entropy_csrng_pool.words[entropy_csrng_pool.avail];
+    memcpy(buf, words, n * sizeof(uint32_t));
+    memset(words, 0, n * sizeof(uint32_t));
+    buf += n;
+    len -= n;
+  }
+
+  // Start the next refill now, so that CSRNG works on it while the caller
+  // does something else.
+  if (entropy_csrng_pool.avail == 0 &&
+      entropy_csrng_state.pending_blocks == 0) {
+    HARDENED_TRY(csrng_generate_send(&kEntropyEmptySeed,
+                                     kEntropyCsrngPoolBlocks,
+                                     /*refill=*/kHardenedBoolTrue));
+  }
+  return res;
+}
+
+status_t entropy_csrng_release(void) {
+  csrng_pool_discard();
+  return OTCRYPTO_OK;
+}
+
 status_t entropy_csrng_uninstantiate(void) {
+  csrng_pool_discard();
   return csrng_send_app_cmd(kBaseCsrng,
                             (entropy_csrng_cmd_t){
                                 .id = kEntropyDrbgOpUninstantiate,
@@ -33,6 +33,15 @@ enum {
    * Number of words in an entropy seed.
    */
   kEntropySeedWords = kEntropySeedBytes / sizeof(uint32_t),
+  /**
+   * Number of 128-bit blocks that `entropy_csrng_pool_read()` generates at a
+   * time.
+   */
+  kEntropyCsrngPoolBlocks = 4,
+  /**
+   * Number of words that `entropy_csrng_pool_read()` generates at a time.
+   */
+  kEntropyCsrngPoolWords = kEntropyCsrngPoolBlocks * 4,
 };
 
 /**
@@ -160,7 +169,12 @@ status_t entropy_csrng_update(const entropy_seed_material_t *seed_material);
  * Request data from the SW CSRNG.
  *
  * Use `entropy_csrng_generate_data_get()` to read the data from the CSRNG
- * output buffer.
+ * output buffer. This function returns as soon as CSRNG has accepted the
+ * command, so the caller can do other work while the data is generated.
+ *
+ * CSRNG accepts no other SW commands until all of the output has been read.
+ * If another command is sent through this driver first, the driver reads and
+ * discards the output that is left.
  *
  * See `entropy_csrng_generate()` for requesting and reading the CSRNG output in
  * a single call.
@@ -178,12 +192,13 @@ status_t entropy_csrng_generate_start(
  * Read SW CSRNG output.
  *
  * Requires the `entropy_csrng_generate_start()` function to be called in
- * advance, otherwise the function will block indefinitely.
+ * advance, for at least `len` words. Blocks until the data is available.
  *
  * @param buf A buffer to fill with words from the CSRNG output buffer.
  * @param len The number of words to read into `buf`.
  * @param fips_check Whether to expect FIPS-compatible entropy.
- * @return Operation status in `status_t` format.
+ * @return Operation status in `status_t` format. `OTCRYPTO_BAD_ARGS` if fewer
+ * than `len` words of requested output remain.
  */
 OT_WARN_UNUSED_RESULT
 status_t entropy_csrng_generate_data_get(uint32_t *buf, size_t len,
@@ -205,6 +220,51 @@ status_t entropy_csrng_generate(const entropy_seed_material_t *seed_material,
                                 uint32_t *buf, size_t len,
                                 hardened_bool_t fips_check);
 
+/**
+ * Read data from a pool of prefetched SW CSRNG output.
+ *
+ * Serves small requests without additional input from a buffer of
+ * `kEntropyCsrngPoolWords` words. When the buffer runs out, the next
+ * `kEntropyCsrngPoolBlocks` blocks are requested from CSRNG straight away, so
+ * they are being generated while the caller does other work, and are read in
+ * when they are needed. Words are cleared from the buffer as they are handed
+ * out.
+ *
+ * Prefetched output is generated before it is used, so the SW CSRNG state
+ * update that follows a generate command does not protect it. Only use the
+ * pool where that is acceptable, e.g. for masks. The pool is discarded when
+ * the SW CSRNG is instantiated, reseeded, updated or uninstantiated, so it
+ * never serves output from before such a command.
+ *
+ * A refill leaves a generate command pending on the SW CSRNG application
+ * interface after this function returns, and CSRNG accepts no other command
+ * on that interface until its output has been read. This driver must
+ * therefore own the interface exclusively: code that sends SW CSRNG commands
+ * by other means, e.g. through the CSRNG DIF, must call
+ * `entropy_csrng_release()` first.
+ *
+ * @param buf A buffer to fill with CSRNG output.
+ * @param len The number of words to read into `buf`.
+ * @param fips_check Whether to expect FIPS-compatible entropy.
+ * @return Operation status in `status_t` format. `OTCRYPTO_RECOV_ERR` if
+ * output requested with `entropy_csrng_generate_start()` has not been read.
+ */
+OT_WARN_UNUSED_RESULT
+status_t entropy_csrng_pool_read(uint32_t *buf, size_t len,
+                                 hardened_bool_t fips_check);
+
+/**
+ * Hand the SW CSRNG application interface back in an idle state.
+ *
+ * Reads and discards the output of any pending generate command, including a
+ * pool refill and output requested with `entropy_csrng_generate_start()`, and
+ * clears the pool. Afterwards CSRNG accepts a new SW command.
+ *
+ * @return Operation status in `status_t` format.
+ */
+OT_WARN_UNUSED_RESULT
+status_t entropy_csrng_release(void);
+
 /**
  * Uninstantiate the SW CSRNG.
  *
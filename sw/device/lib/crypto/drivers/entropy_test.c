@@ -3,15 +3,19 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "sw/device/lib/crypto/drivers/entropy.h"
 
+#include "sw/device/lib/base/abs_mmio.h"
+#include "sw/device/lib/base/bitfield.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/crypto/drivers/entropy_kat.h"
 #include "sw/device/lib/dif/dif_otbn.h"
 #include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/profile.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 #include "sw/device/lib/testing/test_framework/ottf_main.h"
 #include "sw/device/tests/otbn_randomness_impl.h"
 
+#include "csrng_regs.h"  // Generated
 #include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
 
 #define MODULE_ID MAKE_MODULE_ID('e', 'n', 't')
@@ -33,10 +37,127 @@ static status_t entropy_complex_init_test(void) {
   return OK_STATUS();
 }
 
+enum {
+  kAsyncTestWords = 32,
+  kPoolTestReads = 16,
+  kPoolTestWords = 4,
+};
+
+static const entropy_seed_material_t kAsyncTestSeed = {
+    .len = kEntropySeedWords,
+    .data = {0x73bec010, 0x9262474c, 0x16a30f76, 0x531b51de, 0x2ee494e5,
+             0xdfec9db3, 0xcb7a879d, 0x5600419c, 0xca79b0b0, 0xdda33b5c,
+             0xa468649e, 0xdf5d73fa},
+};
+
+/**
+ * Stands in for work that a caller does while CSRNG generates its output.
+ */
+static uint32_t other_work(void) {
+  uint32_t acc = 0x12345678;
+  for (size_t i = 0; i < 256; ++i) {
+    acc = (acc << 5 | acc >> 27) ^ (uint32_t)i;
+  }
+  return acc;
+}
+
+static status_t entropy_csrng_async_generate_test(void) {
+  uint32_t expected[kAsyncTestWords];
+  uint32_t actual[kAsyncTestWords];
+
+  uint64_t t_start = profile_start();
+  volatile uint32_t sink = other_work();
+  uint32_t work_cycles = profile_end(t_start);
+
+  // Blocking generate, followed by the other work.
+  TRY(entropy_csrng_uninstantiate());
+  TRY(entropy_csrng_instantiate(/*disable_trng_input=*/kHardenedBoolTrue,
+                                &kAsyncTestSeed));
+  t_start = profile_start();
+  TRY(entropy_csrng_generate(&kEntropyEmptySeed, expected, kAsyncTestWords,
+                             /*fips_check=*/kHardenedBoolFalse));
+  sink = other_work();
+  uint32_t sync_cycles = profile_end(t_start);
+
+  // The same generate, with the other work done while CSRNG runs.
+  TRY(entropy_csrng_uninstantiate());
+  TRY(entropy_csrng_instantiate(/*disable_trng_input=*/kHardenedBoolTrue,
+                                &kAsyncTestSeed));
+  t_start = profile_start();
+  TRY(entropy_csrng_generate_start(&kEntropyEmptySeed, kAsyncTestWords));
+  sink = other_work();
+  TRY(entropy_csrng_generate_data_get(actual, kAsyncTestWords,
+                                      /*fips_check=*/kHardenedBoolFalse));
+  uint32_t async_cycles = profile_end(t_start);
+  (void)sink;
+
+  TRY_CHECK_ARRAYS_EQ(actual, expected, kAsyncTestWords);
+  LOG_INFO("generate %d words + %d cycles of work: %d cycles (blocking), %d "
+           "(async)",
+           kAsyncTestWords, work_cycles, sync_cycles, async_cycles);
+
+  // Reading more than was requested fails instead of hanging.
+  TRY(entropy_csrng_generate_start(&kEntropyEmptySeed, 4));
+  TRY_CHECK(!status_ok(entropy_csrng_generate_data_get(
+      actual, 8, /*fips_check=*/kHardenedBoolFalse)));
+  // Unread output is drained by the next command.
+  return entropy_csrng_uninstantiate();
+}
+
+static status_t entropy_csrng_pool_test(void) {
+  uint32_t words[kPoolTestReads][kPoolTestWords];
+
+  TRY(entropy_csrng_instantiate(/*disable_trng_input=*/kHardenedBoolFalse,
+                                &kEntropyEmptySeed));
+  uint64_t t_start = profile_start();
+  for (size_t i = 0; i < kPoolTestReads; ++i) {
+    TRY(entropy_csrng_generate(&kEntropyEmptySeed, words[i], kPoolTestWords,
+                               /*fips_check=*/kHardenedBoolTrue));
+  }
+  uint32_t generate_cycles = profile_end(t_start);
+
+  t_start = profile_start();
+  for (size_t i = 0; i < kPoolTestReads; ++i) {
+    TRY(entropy_csrng_pool_read(words[i], kPoolTestWords,
+                                /*fips_check=*/kHardenedBoolTrue));
+  }
+  uint32_t pool_cycles = profile_end(t_start);
+  LOG_INFO("%d reads of %d words: %d cycles (generate), %d (pool)",
+           kPoolTestReads, kPoolTestWords, generate_cycles, pool_cycles);
+
+  // Every read from the pool must be fresh output.
+  for (size_t i = 0; i < kPoolTestReads; ++i) {
+    for (size_t j = 0; j < i; ++j) {
+      TRY_CHECK(memcmp(words[i], words[j], sizeof(words[i])) != 0);
+    }
+  }
+
+  // The pool does not discard output that the caller has requested.
+  TRY(entropy_csrng_generate_start(&kEntropyEmptySeed, kPoolTestWords));
+  TRY_CHECK(!status_ok(entropy_csrng_pool_read(
+      words[0], kPoolTestWords, /*fips_check=*/kHardenedBoolTrue)));
+  TRY(entropy_csrng_generate_data_get(words[0], kPoolTestWords,
+                                      /*fips_check=*/kHardenedBoolTrue));
+
+  // Releasing the interface drains the refill that the last read started.
+  TRY(entropy_csrng_pool_read(words[0], kPoolTestWords,
+                              /*fips_check=*/kHardenedBoolTrue));
+  TRY(entropy_csrng_release());
+  uint32_t reg = abs_mmio_read32(TOP_EARLGREY_CSRNG_BASE_ADDR +
+                                 CSRNG_GENBITS_VLD_REG_OFFSET);
+  TRY_CHECK(!bitfield_bit32_read(reg, CSRNG_GENBITS_VLD_GENBITS_VLD_BIT));
+  reg = abs_mmio_read32(TOP_EARLGREY_CSRNG_BASE_ADDR +
+                        CSRNG_SW_CMD_STS_REG_OFFSET);
+  TRY_CHECK(bitfield_bit32_read(reg, CSRNG_SW_CMD_STS_CMD_RDY_BIT));
+  return entropy_csrng_uninstantiate();
+}
+
 bool test_main(void) {
   status_t result = OK_STATUS();
 
   EXECUTE_TEST(result, entropy_complex_init_test);
   EXECUTE_TEST(result, entropy_csrng_kat);
+  EXECUTE_TEST(result, entropy_csrng_async_generate_test);
+  EXECUTE_TEST(result, entropy_csrng_pool_test);
   return status_ok(result);
 }
@@ -81,6 +81,14 @@ enum {
   kNumIterTimeout = 200,
 };
 
+/**
+ * Context that currently owns the HMAC block in session mode, if any.
+ *
+ * When non-NULL, the hardware holds this context's live state and the
+ * context's saved `H`/`lower`/`upper` fields are stale.
+ */
+static hmac_ctx_t *session_owner = NULL;
+
 /**
  * Digest size selector values.
  *
@@ -288,6 +296,7 @@ static status_t hmac_context_wipe(hmac_ctx_t *ctx) {
   hardened_memshred((uint32_t *)(ctx->partial_block),
                     kHmacMaxBlockBytes / sizeof(uint32_t));
   // Zero the remaining ctx fields.
+  ctx->session = kHardenedBoolFalse;
   ctx->cfg_reg = 0;
   ctx->key_wordlen = 0;
   ctx->msg_block_wordlen = 0;
@@ -327,6 +336,33 @@ static void msg_fifo_write(const uint8_t *message, size_t message_len) {
   }
 }
 
+/**
+ * Saves the state of the session owner, if any, and releases the HMAC block.
+ *
+ * Every driver operation that is not a session update by the owner itself must
+ * call this before touching the hardware.
+ *
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t session_preempt(void) {
+  hmac_ctx_t *owner = session_owner;
+  if (owner == NULL) {
+    return OTCRYPTO_OK;
+  }
+  session_owner = NULL;
+
+  // The owner only ever writes whole blocks to the FIFO, so the STOP command
+  // takes effect once the blocks already written are processed.
+  uint32_t cmd =
+      bitfield_bit32_write(HMAC_CMD_REG_RESVAL, HMAC_CMD_HASH_STOP_BIT, 1);
+  abs_mmio_write32(kHmacBaseAddr + HMAC_CMD_REG_OFFSET, cmd);
+  HARDENED_TRY(hmac_idle_wait());
+  context_save(owner);
+  clear();
+  return OTCRYPTO_OK;
+}
+
 /**
  * Determine the HMAC block configuration register.
  *
@@ -384,6 +420,9 @@ static status_t ensure_idle(void) {
 static status_t oneshot(const uint32_t cfg, const uint32_t *key,
                         size_t key_wordlen, const uint8_t *msg, size_t msg_len,
                         size_t digest_wordlen, uint32_t *digest) {
+  // Hand the block back from any session that currently owns it.
+  HARDENED_TRY(session_preempt());
+
   // Check that the block is idle.
   HARDENED_TRY(ensure_idle());
 
@@ -464,6 +503,22 @@ status_t hmac_hmac_sha512(const uint32_t *key_block, const uint8_t *msg,
                  kHmacSha512DigestWords, tag);
 }
 
+/**
+ * Releases the HMAC block if `ctx` is the session owner.
+ *
+ * Called when `ctx` is re-initialized, so that the driver does not keep a
+ * session for a context whose state is about to be overwritten. The init
+ * functions cannot report errors; if the block does not go idle, the next
+ * operation on it reports the failure.
+ *
+ * @param ctx Context being re-initialized.
+ */
+static void session_drop(hmac_ctx_t *ctx) {
+  if (session_owner == ctx) {
+    OT_DISCARD(status_ok(session_preempt()));
+  }
+}
+
 /**
  * Initialize the context for a hashing operation.
  *
@@ -476,8 +531,10 @@ status_t hmac_hmac_sha512(const uint32_t *key_block, const uint8_t *msg,
  * @param[out] ctx Initialized context object.
  */
 static void sha2_init(hmac_digest_length_t digest_len, hmac_ctx_t *ctx) {
+  session_drop(ctx);
   ctx->cfg_reg = cfg_get(/*hmac_en=*/false, digest_len, kKeyLengthNone);
   ctx->key_wordlen = 0;
+  ctx->session = kHardenedBoolFalse;
   ctx->lower = 0;
   ctx->upper = 0;
   ctx->partial_block_bytelen = 0;
@@ -495,7 +552,9 @@ static void sha2_init(hmac_digest_length_t digest_len, hmac_ctx_t *ctx) {
  */
 static void hmac_init(hmac_key_length_t key_len,
                       hmac_digest_length_t digest_len, hmac_ctx_t *ctx) {
+  session_drop(ctx);
   ctx->cfg_reg = cfg_get(/*hmac_en=*/true, digest_len, key_len);
+  ctx->session = kHardenedBoolFalse;
   ctx->lower = 0;
   ctx->upper = 0;
   ctx->partial_block_bytelen = 0;
@@ -543,9 +602,32 @@ void hmac_hmac_sha512_init(const uint32_t *key_block, hmac_ctx_t *ctx) {
   hmac_init(kKeyLength1024, kDigestLengthSha512, ctx);
 }
 
-status_t hmac_update(hmac_ctx_t *ctx, const uint8_t *data, size_t len) {
-  // Make sure that the entropy complex is configured correctly.
+status_t hmac_session_start(hmac_ctx_t *ctx) {
+  // The entropy complex is checked once here instead of on every update.
   HARDENED_TRY(entropy_complex_check());
+  ctx->session = kHardenedBoolTrue;
+  return OTCRYPTO_OK;
+}
+
+status_t hmac_session_release(hmac_ctx_t *ctx) {
+  if (session_owner == ctx) {
+    HARDENED_TRY(session_preempt());
+  }
+  ctx->session = kHardenedBoolFalse;
+  return OTCRYPTO_OK;
+}
+
+status_t hmac_update(hmac_ctx_t *ctx, const uint8_t *data, size_t len) {
+  // A session owner's entropy check was done when the session started.
+  hardened_bool_t is_owner = kHardenedBoolFalse;
+  if (session_owner == ctx &&
+      launder32(ctx->session) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(ctx->session, kHardenedBoolTrue);
+    is_owner = kHardenedBoolTrue;
+  } else {
+    // Make sure that the entropy complex is configured correctly.
+    HARDENED_TRY(entropy_complex_check());
+  }
 
   // If we don't have enough new bytes to fill a block, just update the partial
   // block and return.
@@ -563,15 +645,32 @@ status_t hmac_update(hmac_ctx_t *ctx, const uint8_t *data, size_t len) {
   size_t len_rem = len % block_bytelen;
   size_t leftover_len = (ctx->partial_block_bytelen + len_rem) % block_bytelen;
 
-  // Retore context will restore the context and also hit start or continue
-  // button as necessary.
-  context_restore(ctx);
+  if (is_owner != kHardenedBoolTrue) {
+    // Save whichever session currently owns the block.
+    HARDENED_TRY(session_preempt());
+
+    // Retore context will restore the context and also hit start or continue
+    // button as necessary.
+    context_restore(ctx);
+  }
 
   // Write the partial block, then the new bytes.
   msg_fifo_write((unsigned char *)ctx->partial_block,
                  ctx->partial_block_bytelen);
   msg_fifo_write(data, len - leftover_len);
 
+  // Write leftover bytes to `partial_block`, so that future update/final call
+  // can feed them to HMAC HWIP.
+  memcpy(ctx->partial_block, data + (len - leftover_len), leftover_len);
+  ctx->partial_block_bytelen = leftover_len;
+
+  // A session keeps the block running until it is preempted or finalized.
+  if (launder32(ctx->session) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(ctx->session, kHardenedBoolTrue);
+    session_owner = ctx;
+    return OTCRYPTO_OK;
+  }
+
   // Send the STOP command.
   uint32_t cmd =
       bitfield_bit32_write(HMAC_CMD_REG_RESVAL, HMAC_CMD_HASH_STOP_BIT, 1);
@@ -581,11 +680,6 @@ status_t hmac_update(hmac_ctx_t *ctx, const uint8_t *data, size_t len) {
   HARDENED_TRY(hmac_idle_wait());
   context_save(ctx);
 
-  // Write leftover bytes to `partial_block`, so that future update/final call
-  // can feed them to HMAC HWIP.
-  memcpy(ctx->partial_block, data + (len - leftover_len), leftover_len);
-  ctx->partial_block_bytelen = leftover_len;
-
   // Clean up.
   clear();
   return OTCRYPTO_OK;
@@ -595,9 +689,17 @@ status_t hmac_final(hmac_ctx_t *ctx, uint32_t *digest) {
   // Make sure that the entropy complex is configured correctly.
   HARDENED_TRY(entropy_complex_check());
 
-  // Retore context will restore the context and also hit start or continue
-  // button as necessary.
-  context_restore(ctx);
+  if (session_owner == ctx) {
+    // The hardware already holds this context's state.
+    session_owner = NULL;
+  } else {
+    // Save whichever session currently owns the block.
+    HARDENED_TRY(session_preempt());
+
+    // Retore context will restore the context and also hit start or continue
+    // button as necessary.
+    context_restore(ctx);
+  }
 
   // Feed the final leftover bytes to HMAC HWIP.
   msg_fifo_write((unsigned char *)ctx->partial_block,
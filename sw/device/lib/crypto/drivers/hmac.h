@@ -71,6 +71,9 @@ typedef struct hmac_ctx {
   uint32_t partial_block[kHmacMaxBlockWords];
   // The number of valid bytes in `partial_block`.
   size_t partial_block_bytelen;
+  // Whether this context may keep the HMAC block between calls (see
+  // `hmac_session_start`).
+  hardened_bool_t session;
 } hmac_ctx_t;
 
 /**
@@ -219,6 +222,45 @@ void hmac_hmac_sha384_init(const uint32_t *key_block, hmac_ctx_t *ctx);
  */
 void hmac_hmac_sha512_init(const uint32_t *key_block, hmac_ctx_t *ctx);
 
+/**
+ * Switches an initialized context to exclusive session mode.
+ *
+ * In session mode the context keeps ownership of the HMAC block between
+ * `hmac_update()` calls: the hardware state stays live, full blocks are
+ * written straight to the message FIFO, and neither the context restore/save
+ * sequence nor the entropy complex check is repeated per call. Only the
+ * trailing partial block is buffered in the context, so that the FIFO always
+ * holds whole blocks and the engine can be stopped at any time.
+ *
+ * If any other HMAC driver operation runs while a session context owns the
+ * block (a one-shot call or another streaming context), the session is
+ * preempted: its state is saved into the context and restored transparently
+ * on its next update.
+ *
+ * While a session context owns the block, it must not be moved, copied or
+ * discarded; it must be finished with `hmac_final()`, handed back with
+ * `hmac_session_release()`, or re-initialized with one of the init functions,
+ * which also releases the block.
+ *
+ * @param ctx Context object, initialized by one of the init functions.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t hmac_session_start(hmac_ctx_t *ctx);
+
+/**
+ * Ends session mode for a context without finalizing it.
+ *
+ * If the context currently owns the HMAC block, its state is saved and the
+ * block is released. The context can then be used in normal streaming mode or
+ * passed to `hmac_session_start()` again.
+ *
+ * @param ctx Context object referring to a particular stream.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t hmac_session_release(hmac_ctx_t *ctx);
+
 /**
  * Update the context with additional messsage data.
  *
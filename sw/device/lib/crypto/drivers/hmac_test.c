@@ -0,0 +1,144 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/drivers/hmac.h"
+
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/impl/status.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/profile.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+enum {
+  /* Length of the test message in bytes. */
+  kMsgBytes = 4096,
+  /* Size of each streamed chunk; deliberately not a multiple of the block. */
+  kChunkBytes = 40,
+};
+
+static uint8_t msg[kMsgBytes];
+
+/**
+ * Fills the message with a simple deterministic pattern.
+ */
+static void msg_init(void) {
+  uint32_t x = 0x12345678;
+  for (size_t i = 0; i < kMsgBytes; ++i) {
+    x = x * 1103515245 + 12345;
+    msg[i] = (uint8_t)(x >> 24);
+  }
+}
+
+/**
+ * Streams `msg[start:end]` into `ctx` in `kChunkBytes` chunks.
+ */
+static status_t stream(hmac_ctx_t *ctx, size_t start, size_t end) {
+  for (size_t i = start; i < end; i += kChunkBytes) {
+    size_t len = end - i < kChunkBytes ? end - i : kChunkBytes;
+    TRY(hmac_update(ctx, &msg[i], len));
+  }
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Streams the whole message with and without session mode and checks both
+ * against the one-shot digest.
+ */
+static status_t session_streaming_test(void) {
+  uint32_t expected[kHmacSha256DigestWords];
+  TRY(hmac_hash_sha256(msg, sizeof(msg), expected));
+
+  hmac_ctx_t ctx;
+  uint32_t digest[kHmacSha256DigestWords];
+  hmac_hash_sha256_init(&ctx);
+  uint64_t t_start = profile_start();
+  TRY(stream(&ctx, 0, sizeof(msg)));
+  TRY(hmac_final(&ctx, digest));
+  uint32_t cycles_normal = profile_end(t_start);
+  TRY_CHECK_ARRAYS_EQ(digest, expected, ARRAYSIZE(expected));
+
+  hmac_hash_sha256_init(&ctx);
+  TRY(hmac_session_start(&ctx));
+  t_start = profile_start();
+  TRY(stream(&ctx, 0, sizeof(msg)));
+  TRY(hmac_final(&ctx, digest));
+  uint32_t cycles_session = profile_end(t_start);
+  TRY_CHECK_ARRAYS_EQ(digest, expected, ARRAYSIZE(expected));
+
+  LOG_INFO("Streaming %d bytes in %d-byte updates: %u cycles", kMsgBytes,
+           kChunkBytes, cycles_normal);
+  LOG_INFO("Same in session mode: %u cycles", cycles_session);
+  TRY_CHECK(cycles_session < cycles_normal);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Interleaves a session with a one-shot call, a second session and a normal
+ * streaming context, so that the session is preempted and restored.
+ */
+static status_t session_preemption_test(void) {
+  uint32_t expected256[kHmacSha256DigestWords];
+  uint32_t expected512[kHmacSha512DigestWords];
+  TRY(hmac_hash_sha256(msg, sizeof(msg), expected256));
+  TRY(hmac_hash_sha512(msg, sizeof(msg), expected512));
+
+  hmac_ctx_t session_a, session_b, normal;
+  hmac_hash_sha256_init(&session_a);
+  hmac_hash_sha512_init(&session_b);
+  hmac_hash_sha256_init(&normal);
+  TRY(hmac_session_start(&session_a));
+  TRY(hmac_session_start(&session_b));
+
+  const size_t kThird = kMsgBytes / 3;
+  TRY(stream(&session_a, 0, kThird));
+  TRY(stream(&session_b, 0, kThird));
+  TRY(stream(&normal, 0, kThird));
+
+  // A one-shot operation in the middle of the sessions.
+  uint32_t oneshot[kHmacSha256DigestWords];
+  TRY(hmac_hash_sha256(msg, sizeof(msg), oneshot));
+  TRY_CHECK_ARRAYS_EQ(oneshot, expected256, ARRAYSIZE(expected256));
+
+  TRY(stream(&session_a, kThird, 2 * kThird));
+  TRY(hmac_session_release(&session_a));
+  TRY(stream(&session_a, 2 * kThird, kMsgBytes));
+  TRY(stream(&normal, kThird, kMsgBytes));
+  TRY(stream(&session_b, kThird, kMsgBytes));
+
+  uint32_t digest256[kHmacSha256DigestWords];
+  uint32_t digest512[kHmacSha512DigestWords];
+  TRY(hmac_final(&session_a, digest256));
+  TRY_CHECK_ARRAYS_EQ(digest256, expected256, ARRAYSIZE(expected256));
+  TRY(hmac_final(&normal, digest256));
+  TRY_CHECK_ARRAYS_EQ(digest256, expected256, ARRAYSIZE(expected256));
+  TRY(hmac_final(&session_b, digest512));
+  TRY_CHECK_ARRAYS_EQ(digest512, expected512, ARRAYSIZE(expected512));
+
+  // Re-initializing a context that owns the block must release it, so that a
+  // later operation does not save state into the reused context.
+  hmac_hash_sha256_init(&session_a);
+  TRY(hmac_session_start(&session_a));
+  TRY(stream(&session_a, 0, kThird));
+  hmac_hash_sha256_init(&session_a);
+  TRY(hmac_hash_sha256(msg, sizeof(msg), oneshot));
+  TRY_CHECK_ARRAYS_EQ(oneshot, expected256, ARRAYSIZE(expected256));
+  TRY(stream(&session_a, 0, kMsgBytes));
+  TRY(hmac_final(&session_a, digest256));
+  TRY_CHECK_ARRAYS_EQ(digest256, expected256, ARRAYSIZE(expected256));
+  return OTCRYPTO_OK;
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  CHECK_STATUS_OK(entropy_complex_init());
+  msg_init();
+
+  status_t test_result = OK_STATUS();
+  EXECUTE_TEST(test_result, session_streaming_test);
+  EXECUTE_TEST(test_result, session_preemption_test);
+  return status_ok(test_result);
+}
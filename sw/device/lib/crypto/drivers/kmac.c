@@ -85,6 +85,20 @@ static const uint32_t prefix_offsets[] = {
     KMAC_PREFIX_10_REG_OFFSET,
 };
 
+/**
+ * Context of the streaming operation that currently holds the KMAC block.
+ *
+ * NULL if no streaming operation is in progress.
+ */
+static kmac_ctx_t *stream_owner = NULL;
+
+status_t kmac_stream_idle_check(void) {
+  if (stream_owner != NULL) {
+    return OTCRYPTO_ASYNC_INCOMPLETE;
+  }
+  return OTCRYPTO_OK;
+}
+
 // Check that KEY_SHARE registers form a continuous address space
 OT_ASSERT_ENUM_VALUE(KMAC_KEY_SHARE0_1_REG_OFFSET,
                      KMAC_KEY_SHARE0_0_REG_OFFSET + 4);
@@ -233,6 +247,9 @@ status_t kmac_key_length_check(size_t key_len) {
 }
 
 status_t kmac_hwip_default_configure(void) {
+  // Leave the configuration alone while a streaming operation is in progress.
+  HARDENED_TRY(kmac_stream_idle_check());
+
   // Ensure that the entropy complex is initialized.
   HARDENED_TRY(entropy_complex_check());
 
@@ -477,6 +494,7 @@ OT_WARN_UNUSED_RESULT
 static status_t kmac_init(kmac_operation_t operation,
                           kmac_security_str_t security_str,
                           hardened_bool_t hw_backed) {
+  HARDENED_TRY(kmac_stream_idle_check());
   HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_IDLE_BIT, 1));
 
   // If the operation is KMAC, ensure that the entropy complex has been
@@ -569,49 +587,41 @@ static status_t kmac_write_key_block(kmac_blinded_key_t *key) {
 }
 
 /**
- * Common routine for feeding message blocks during SHA/SHAKE/cSHAKE/KMAC.
- *
- * Before running this, the operation type must be configured with kmac_init.
- * Then, we can use this function to feed various bytes of data to the KMAC
- * core. Note that this is a one-shot implementation, and it does not support
- * streaming mode.
+ * Issue a command to the KMAC block.
  *
- * This routine does not check input parameters for consistency. For instance,
- * one can invoke SHA-3_224 with digest_len=32, which will produce 256 bits of
- * digest. The caller is responsible for ensuring that the digest length and
- * mode are consistent.
- *
- * The caller must ensure that `message_len` bytes (rounded up to the next 32b
- * word) are allocated at the location pointed to by `message`, and similarly
- * that `digest_len_words` 32-bit words are allocated at the location pointed
- * to by `digest`. If `masked_digest` is set, then `digest` must contain 2x
- * `digest_len_words` to fit both shares.
+ * @param cmd One of the `KMAC_CMD_CMD_VALUE_*` values.
+ */
+static void issue_cmd(uint32_t cmd) {
+  uint32_t cmd_reg = KMAC_CMD_REG_RESVAL;
+  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD, cmd);
+  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
+}
+
+/**
+ * Start the absorb phase of an operation configured with `kmac_init`.
  *
- * @param operation The operation type.
- * @param message Input message string.
- * @param message_len Message length in bytes.
- * @param digest The struct to which the result will be written.
- * @param digest_len_words Requested digest length in 32-bit words.
- * @param masked_digest Whether to return the digest in two shares.
  * @return Error code.
  */
 OT_WARN_UNUSED_RESULT
-static status_t kmac_process_msg_blocks(kmac_operation_t operation,
-                                        const uint8_t *message,
-                                        size_t message_len, uint32_t *digest,
-                                        size_t digest_len_words,
-                                        hardened_bool_t masked_digest) {
+static status_t absorb_start(void) {
   // Block until KMAC is idle.
   HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_IDLE_BIT, 1));
 
   // Issue the start command, so that messages written to MSG_FIFO are forwarded
   // to Keccak
-  uint32_t cmd_reg = KMAC_CMD_REG_RESVAL;
-  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                   KMAC_CMD_CMD_VALUE_START);
-  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
-  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_ABSORB_BIT, 1));
+  issue_cmd(KMAC_CMD_CMD_VALUE_START);
+  return wait_status_bit(KMAC_STATUS_SHA3_ABSORB_BIT, 1);
+}
 
+/**
+ * Write message bytes to the message FIFO during the absorb phase.
+ *
+ * @param message Input message string.
+ * @param message_len Message length in bytes.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t msg_fifo_write(const uint8_t *message, size_t message_len) {
   // Begin by writing a one byte at a time until the data is aligned.
   size_t i = 0;
   for (; misalignment32_of((uintptr_t)(&message[i])) > 0 && i < message_len;
@@ -632,7 +642,22 @@ static status_t kmac_process_msg_blocks(kmac_operation_t operation,
     HARDENED_TRY(wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0));
     abs_mmio_write8(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET, message[i]);
   }
+  return OTCRYPTO_OK;
+}
 
+/**
+ * End the absorb phase and start squeezing.
+ *
+ * For KMAC, this first appends `right_encode(digest_len_words * 32)` to the
+ * message.
+ *
+ * @param operation The operation type.
+ * @param digest_len_words Total digest length in words (KMAC only).
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t squeeze_start(kmac_operation_t operation,
+                              size_t digest_len_words) {
   // If operation=KMAC, then we need to write `right_encode(digest->len)`
   if (operation == kKmacOperationKmac) {
     uint32_t digest_len_bits = 8 * sizeof(uint32_t) * digest_len_words;
@@ -654,52 +679,83 @@ static status_t kmac_process_msg_blocks(kmac_operation_t operation,
   }
 
   // Issue the process command, so that squeezing phase can start
-  cmd_reg = KMAC_CMD_REG_RESVAL;
-  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                   KMAC_CMD_CMD_VALUE_PROCESS);
-  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
+  issue_cmd(KMAC_CMD_CMD_VALUE_PROCESS);
 
   // Wait until squeezing is done
-  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1));
+  return wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1);
+}
 
+/**
+ * Read the Keccak rate (in words) of the currently configured operation.
+ *
+ * @param[out] keccak_rate_words The keccak rate in 32-bit words.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t keccak_rate_words_get(size_t *keccak_rate_words) {
   uint32_t cfg_reg =
       abs_mmio_read32(kKmacBaseAddr + KMAC_CFG_SHADOWED_REG_OFFSET);
   uint32_t keccak_str =
       bitfield_field32_read(cfg_reg, KMAC_CFG_SHADOWED_KSTRENGTH_FIELD);
-  size_t keccak_rate_words;
-  HARDENED_TRY(kmac_get_keccak_rate_words(keccak_str, &keccak_rate_words));
+  return kmac_get_keccak_rate_words(keccak_str, keccak_rate_words);
+}
 
-  // Finally, we can read the two shares of digest and XOR them.
+/**
+ * Read digest words from the state during the squeeze phase.
+ *
+ * `state_offset` is the number of words of the current state block that have
+ * already been read; it is updated so that successive calls continue the same
+ * output stream. A new block is only requested (with `CMD.RUN`) once the
+ * current one is used up and more output is needed.
+ *
+ * If `masked_digest` is set, then `digest` must contain 2x `digest_len_words`
+ * to fit both shares.
+ *
+ * @param[out] digest Buffer to which the output is written.
+ * @param digest_len_words Number of words to read.
+ * @param masked_digest Whether to return the digest in two shares.
+ * @param keccak_rate_words The keccak rate in 32-bit words.
+ * @param[in,out] state_offset Words already read from the current block.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t squeeze_words(uint32_t *digest, size_t digest_len_words,
+                              hardened_bool_t masked_digest,
+                              size_t keccak_rate_words, size_t *state_offset) {
   size_t idx = 0;
-
   while (launder32(idx) < digest_len_words) {
-    // Since we always read in increments of the Keccak rate, the index at
-    // start should always be a multiple of the rate.
-    HARDENED_CHECK_EQ(idx % keccak_rate_words, 0);
+    // If the current block is used up, issue `CMD.RUN` to generate more state.
+    if (launder32(*state_offset) == keccak_rate_words) {
+      HARDENED_CHECK_EQ(*state_offset, keccak_rate_words);
+      issue_cmd(KMAC_CMD_CMD_VALUE_RUN);
+      *state_offset = 0;
+    }
+    HARDENED_CHECK_LT(*state_offset, keccak_rate_words);
 
     // Poll the status register until in the 'squeeze' state.
     HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1));
 
-    // Read words from the state registers (either `digest_len_words` or the
+    // Read words from the state registers (either the remaining words or the
     // maximum number of words available).
-    size_t offset = 0;
+    size_t offset = *state_offset;
     if (launder32(masked_digest) == kHardenedBoolTrue) {
       HARDENED_CHECK_EQ(masked_digest, kHardenedBoolTrue);
       // Read the digest into each share in turn. Do this in separate loops so
       // corresponding shares aren't handled close together.
-      for (offset = 0; launder32(idx + offset) < digest_len_words &&
-                       offset < keccak_rate_words;
-           offset++) {
-        digest[idx + offset] =
+      size_t i = idx;
+      for (; launder32(i) < digest_len_words && offset < keccak_rate_words;
+           offset++, i++) {
+        digest[i] =
             abs_mmio_read32(kKmacStateShare0Addr + offset * sizeof(uint32_t));
       }
-      for (offset = 0; launder32(idx + offset) < digest_len_words &&
-                       offset < keccak_rate_words;
-           offset++) {
-        digest[idx + offset + digest_len_words] =
+      offset = *state_offset;
+      i = idx;
+      for (; launder32(i) < digest_len_words && offset < keccak_rate_words;
+           offset++, i++) {
+        digest[i + digest_len_words] =
             abs_mmio_read32(kKmacStateShare1Addr + offset * sizeof(uint32_t));
       }
-      idx += offset;
+      idx = i;
     } else {
       // Skip right to the hardened check here instead of returning
       // `OTCRYPTO_BAD_ARGS` if the value is not `kHardenedBoolFalse`; this
@@ -716,27 +772,61 @@ static status_t kmac_process_msg_blocks(kmac_operation_t operation,
         idx++;
       }
     }
-
-    // If we read all the remaining words and still need more digest, issue
-    // `CMD.RUN` to generate more state.
-    if (launder32(offset) == keccak_rate_words && idx < digest_len_words) {
-      HARDENED_CHECK_EQ(offset, keccak_rate_words);
-      cmd_reg = KMAC_CMD_REG_RESVAL;
-      cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                       KMAC_CMD_CMD_VALUE_RUN);
-      abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
-    }
+    *state_offset = offset;
   }
   HARDENED_CHECK_EQ(idx, digest_len_words);
 
   // Poll the status register until in the 'squeeze' state.
-  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1));
+  return wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1);
+}
+
+/**
+ * Common routine for feeding message blocks during SHA/SHAKE/cSHAKE/KMAC.
+ *
+ * Before running this, the operation type must be configured with kmac_init.
+ * Then, we can use this function to feed various bytes of data to the KMAC
+ * core. Note that this is a one-shot implementation; streaming operations use
+ * the `kmac_stream_*` functions built from the same helpers.
+ *
+ * This routine does not check input parameters for consistency. For instance,
+ * one can invoke SHA-3_224 with digest_len=32, which will produce 256 bits of
+ * digest. The caller is responsible for ensuring that the digest length and
+ * mode are consistent.
+ *
+ * The caller must ensure that `message_len` bytes (rounded up to the next 32b
+ * word) are allocated at the location pointed to by `message`, and similarly
+ * that `digest_len_words` 32-bit words are allocated at the location pointed
+ * to by `digest`. If `masked_digest` is set, then `digest` must contain 2x
+ * `digest_len_words` to fit both shares.
+ *
+ * @param operation The operation type.
+ * @param message Input message string.
+ * @param message_len Message length in bytes.
+ * @param digest The struct to which the result will be written.
+ * @param digest_len_words Requested digest length in 32-bit words.
+ * @param masked_digest Whether to return the digest in two shares.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_process_msg_blocks(kmac_operation_t operation,
+                                        const uint8_t *message,
+                                        size_t message_len, uint32_t *digest,
+                                        size_t digest_len_words,
+                                        hardened_bool_t masked_digest) {
+  HARDENED_TRY(absorb_start());
+  HARDENED_TRY(msg_fifo_write(message, message_len));
+  HARDENED_TRY(squeeze_start(operation, digest_len_words));
+
+  size_t keccak_rate_words;
+  HARDENED_TRY(keccak_rate_words_get(&keccak_rate_words));
+
+  // Finally, we can read the two shares of digest and XOR them.
+  size_t state_offset = 0;
+  HARDENED_TRY(squeeze_words(digest, digest_len_words, masked_digest,
+                             keccak_rate_words, &state_offset));
 
   // Release the KMAC core, so that it goes back to idle mode
-  cmd_reg = KMAC_CMD_REG_RESVAL;
-  cmd_reg = bitfield_field32_write(cmd_reg, KMAC_CMD_CMD_FIELD,
-                                   KMAC_CMD_CMD_VALUE_DONE);
-  abs_mmio_write32(kKmacBaseAddr + KMAC_CMD_REG_OFFSET, cmd_reg);
+  issue_cmd(KMAC_CMD_CMD_VALUE_DONE);
 
   return OTCRYPTO_OK;
 }
@@ -812,6 +902,7 @@ status_t kmac_cshake_128(const uint8_t *message, size_t message_len,
                          const unsigned char *func_name, size_t func_name_len,
                          const unsigned char *cust_str, size_t cust_str_len,
                          uint32_t *digest, size_t digest_len) {
+  HARDENED_TRY(kmac_stream_idle_check());
   HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_IDLE_BIT, 1));
   HARDENED_TRY(
       kmac_set_prefix_regs(func_name, func_name_len, cust_str, cust_str_len));
@@ -823,6 +914,7 @@ status_t kmac_cshake_256(const uint8_t *message, size_t message_len,
                          const unsigned char *func_name, size_t func_name_len,
                          const unsigned char *cust_str, size_t cust_str_len,
                          uint32_t *digest, size_t digest_len) {
+  HARDENED_TRY(kmac_stream_idle_check());
   HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_IDLE_BIT, 1));
   HARDENED_TRY(
       kmac_set_prefix_regs(func_name, func_name_len, cust_str, cust_str_len));
@@ -859,3 +951,332 @@ status_t kmac_kmac_256(kmac_blinded_key_t *key, hardened_bool_t masked_digest,
   return kmac_process_msg_blocks(kKmacOperationKmac, message, message_len,
                                  digest, digest_len, masked_digest);
 }
+
+/**
+ * Look up the hardware parameters of a streaming mode.
+ *
+ * @param mode Streaming mode.
+ * @param[out] operation Hardware operation.
+ * @param[out] strength Security strength.
+ * @param[out] digest_wordlen Fixed digest length in words, or 0 for XOFs and
+ *                            KMAC.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t stream_mode_params(kmac_mode_t mode,
+                                   kmac_operation_t *operation,
+                                   kmac_security_str_t *strength,
+                                   size_t *digest_wordlen) {
+  *digest_wordlen = 0;
+  switch (mode) {
+    case kKmacModeSha3_224:
+      *operation = kKmacOperationSha3;
+      *strength = kKmacSecurityStrength224;
+      *digest_wordlen = kKmacSha3224DigestWords;
+      break;
+    case kKmacModeSha3_256:
+      *operation = kKmacOperationSha3;
+      *strength = kKmacSecurityStrength256;
+      *digest_wordlen = kKmacSha3256DigestWords;
+      break;
+    case kKmacModeSha3_384:
+      *operation = kKmacOperationSha3;
+      *strength = kKmacSecurityStrength384;
+      *digest_wordlen = kKmacSha3384DigestWords;
+      break;
+    case kKmacModeSha3_512:
+      *operation = kKmacOperationSha3;
+      *strength = kKmacSecurityStrength512;
+      *digest_wordlen = kKmacSha3512DigestWords;
+      break;
+    case kKmacModeShake128:
+      *operation = kKmacOperationShake;
+      *strength = kKmacSecurityStrength128;
+      break;
+    case kKmacModeShake256:
+      *operation = kKmacOperationShake;
+      *strength = kKmacSecurityStrength256;
+      break;
+    case kKmacModeCshake128:
+      *operation = kKmacOperationCshake;
+      *strength = kKmacSecurityStrength128;
+      break;
+    case kKmacModeCshake256:
+      *operation = kKmacOperationCshake;
+      *strength = kKmacSecurityStrength256;
+      break;
+    case kKmacModeKmac128:
+      *operation = kKmacOperationKmac;
+      *strength = kKmacSecurityStrength128;
+      break;
+    case kKmacModeKmac256:
+      *operation = kKmacOperationKmac;
+      *strength = kKmacSecurityStrength256;
+      break;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Start the absorb phase of a streaming operation and take the lock.
+ *
+ * The hardware must already be configured with `kmac_init` (and the key and
+ * prefix registers written, if needed).
+ *
+ * @param[out] ctx Context to initialize.
+ * @param operation Hardware operation.
+ * @param strength Security strength.
+ * @param digest_wordlen Fixed digest length in words, or 0 for XOFs.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t stream_start(kmac_ctx_t *ctx, kmac_operation_t operation,
+                             kmac_security_str_t strength,
+                             size_t digest_wordlen) {
+  HARDENED_TRY(kmac_get_keccak_rate_words(strength, &ctx->rate_words));
+  ctx->operation = operation;
+  ctx->digest_wordlen = digest_wordlen;
+  ctx->state_offset = 0;
+  ctx->squeezing = kHardenedBoolFalse;
+  HARDENED_TRY(absorb_start());
+  stream_owner = ctx;
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Check that `ctx` holds the lock on the KMAC block.
+ *
+ * @param ctx Context of the streaming operation.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t stream_owner_check(const kmac_ctx_t *ctx) {
+  if (ctx == NULL || stream_owner != ctx) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  return OTCRYPTO_OK;
+}
+
+/**
+ * End the absorb phase of a streaming operation, if not done already.
+ *
+ * @param ctx Context of the streaming operation.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t stream_squeeze_start(kmac_ctx_t *ctx) {
+  if (launder32(ctx->squeezing) == kHardenedBoolTrue) {
+    return OTCRYPTO_OK;
+  }
+  HARDENED_CHECK_EQ(ctx->squeezing, kHardenedBoolFalse);
+  // Mark the context first so that `kmac_stream_abort` does not issue a
+  // second `CMD.PROCESS` if waiting for the squeeze state fails.
+  ctx->squeezing = kHardenedBoolTrue;
+  ctx->state_offset = 0;
+  return squeeze_start(ctx->operation, ctx->digest_wordlen);
+}
+
+status_t kmac_stream_hash_init(kmac_ctx_t *ctx, kmac_mode_t mode) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  kmac_operation_t operation;
+  kmac_security_str_t strength;
+  size_t digest_wordlen;
+  HARDENED_TRY(
+      stream_mode_params(mode, &operation, &strength, &digest_wordlen));
+  if (operation != kKmacOperationSha3 && operation != kKmacOperationShake) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  HARDENED_TRY(kmac_init(operation, strength,
+                         /*hw_backed=*/kHardenedBoolFalse));
+  return stream_start(ctx, operation, strength, digest_wordlen);
+}
+
+status_t kmac_stream_cshake_init(kmac_ctx_t *ctx, kmac_mode_t mode,
+                                 const unsigned char *func_name,
+                                 size_t func_name_len,
+                                 const unsigned char *cust_str,
+                                 size_t cust_str_len) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  kmac_operation_t operation;
+  kmac_security_str_t strength;
+  size_t digest_wordlen;
+  HARDENED_TRY(
+      stream_mode_params(mode, &operation, &strength, &digest_wordlen));
+  if (operation != kKmacOperationCshake) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  HARDENED_TRY(kmac_stream_idle_check());
+  HARDENED_TRY(wait_status_bit(KMAC_STATUS_SHA3_IDLE_BIT, 1));
+  HARDENED_TRY(
+      kmac_set_prefix_regs(func_name, func_name_len, cust_str, cust_str_len));
+  HARDENED_TRY(kmac_init(operation, strength,
+                         /*hw_backed=*/kHardenedBoolFalse));
+  return stream_start(ctx, operation, strength, digest_wordlen);
+}
+
+status_t kmac_stream_kmac_init(kmac_ctx_t *ctx, kmac_mode_t mode,
+                               kmac_blinded_key_t *key,
+                               const unsigned char *cust_str,
+                               size_t cust_str_len, size_t digest_len) {
+  if (ctx == NULL || key == NULL || digest_len == 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  kmac_operation_t operation;
+  kmac_security_str_t strength;
+  size_t digest_wordlen;
+  HARDENED_TRY(
+      stream_mode_params(mode, &operation, &strength, &digest_wordlen));
+  if (operation != kKmacOperationKmac) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  // Reject lengths that `right_encode` cannot represent now, so that ending
+  // the absorb phase cannot fail on the arguments later.
+  if (digest_len > UINT32_MAX / (8 * sizeof(uint32_t))) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  HARDENED_TRY(kmac_init(operation, strength, key->hw_backed));
+  HARDENED_TRY(kmac_write_key_block(key));
+  HARDENED_TRY(kmac_set_prefix_regs(
+      kKmacFuncNameKMAC, sizeof(kKmacFuncNameKMAC), cust_str, cust_str_len));
+  return stream_start(ctx, operation, strength, digest_len);
+}
+
+/**
+ * Release the KMAC block if a streaming step failed.
+ *
+ * @param ctx Context of the streaming operation.
+ * @param result Result of the streaming step.
+ * @return `result`.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t stream_release_on_error(kmac_ctx_t *ctx, status_t result) {
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+    // Report the original error rather than any error from releasing.
+    status_t abort_result = kmac_stream_abort(ctx);
+    (void)abort_result;
+  }
+  return result;
+}
+
+/**
+ * Absorb message data; see `kmac_stream_update`.
+ *
+ * @param ctx Context of the streaming operation.
+ * @param message The input message.
+ * @param message_len The input message length in bytes.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t stream_absorb(kmac_ctx_t *ctx, const uint8_t *message,
+                              size_t message_len) {
+  if (message == NULL && message_len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  // No more data can be absorbed once squeezing has started.
+  if (launder32(ctx->squeezing) != kHardenedBoolFalse) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(ctx->squeezing, kHardenedBoolFalse);
+  return msg_fifo_write(message, message_len);
+}
+
+status_t kmac_stream_update(kmac_ctx_t *ctx, const uint8_t *message,
+                            size_t message_len) {
+  HARDENED_TRY(stream_owner_check(ctx));
+  return stream_release_on_error(ctx,
+                                 stream_absorb(ctx, message, message_len));
+}
+
+/**
+ * Squeeze XOF output; see `kmac_stream_squeeze`.
+ *
+ * @param ctx Context of the streaming operation.
+ * @param[out] digest Output buffer.
+ * @param digest_len Number of 32-bit words to squeeze.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t stream_squeeze(kmac_ctx_t *ctx, uint32_t *digest,
+                               size_t digest_len) {
+  if (digest == NULL && digest_len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  // Only XOFs can be squeezed incrementally.
+  if (ctx->operation != kKmacOperationShake &&
+      ctx->operation != kKmacOperationCshake) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  HARDENED_TRY(stream_squeeze_start(ctx));
+  return squeeze_words(digest, digest_len,
+                       /*masked_digest=*/kHardenedBoolFalse, ctx->rate_words,
+                       &ctx->state_offset);
+}
+
+status_t kmac_stream_squeeze(kmac_ctx_t *ctx, uint32_t *digest,
+                             size_t digest_len) {
+  HARDENED_TRY(stream_owner_check(ctx));
+  return stream_release_on_error(ctx,
+                                 stream_squeeze(ctx, digest, digest_len));
+}
+
+/**
+ * Produce the final output of a streaming operation.
+ *
+ * Does not release the lock; see `kmac_stream_final`.
+ *
+ * @param ctx Context of the streaming operation.
+ * @param masked_digest Whether to return the digest in concatenated shares.
+ * @param[out] digest Output buffer.
+ * @param digest_len Number of 32-bit words to output.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t stream_output(kmac_ctx_t *ctx, hardened_bool_t masked_digest,
+                              uint32_t *digest, size_t digest_len) {
+  if (digest == NULL && digest_len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  if (ctx->digest_wordlen != 0 && digest_len != ctx->digest_wordlen) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_TRY(stream_squeeze_start(ctx));
+  return squeeze_words(digest, digest_len, masked_digest, ctx->rate_words,
+                       &ctx->state_offset);
+}
+
+status_t kmac_stream_final(kmac_ctx_t *ctx, hardened_bool_t masked_digest,
+                           uint32_t *digest, size_t digest_len) {
+  HARDENED_TRY(stream_owner_check(ctx));
+  status_t result = stream_output(ctx, masked_digest, digest, digest_len);
+  // Release the block even if producing the output failed.
+  HARDENED_TRY(kmac_stream_abort(ctx));
+  return result;
+}
+
+status_t kmac_stream_abort(kmac_ctx_t *ctx) {
+  HARDENED_TRY(stream_owner_check(ctx));
+
+  // `CMD.DONE` is only accepted in the squeeze phase, so finish absorbing
+  // first if needed. The output is discarded.
+  status_t result = OTCRYPTO_OK;
+  if (launder32(ctx->squeezing) != kHardenedBoolTrue) {
+    issue_cmd(KMAC_CMD_CMD_VALUE_PROCESS);
+    result = wait_status_bit(KMAC_STATUS_SHA3_SQUEEZE_BIT, 1);
+  }
+
+  // Release the KMAC core, so that it goes back to idle mode
+  issue_cmd(KMAC_CMD_CMD_VALUE_DONE);
+  stream_owner = NULL;
+  memset(ctx, 0, sizeof(kmac_ctx_t));
+  return result;
+}
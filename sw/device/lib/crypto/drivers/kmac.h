@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "sw/device/lib/base/hardened.h"
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/crypto/impl/status.h"
 
@@ -57,6 +58,50 @@ typedef struct kmac_blinded_key {
   hardened_bool_t hw_backed;
 } kmac_blinded_key_t;
 
+/**
+ * Keccak-based modes supported by the streaming interface.
+ */
+typedef enum kmac_mode {
+  kKmacModeSha3_224,
+  kKmacModeSha3_256,
+  kKmacModeSha3_384,
+  kKmacModeSha3_512,
+  kKmacModeShake128,
+  kKmacModeShake256,
+  kKmacModeCshake128,
+  kKmacModeCshake256,
+  kKmacModeKmac128,
+  kKmacModeKmac256,
+} kmac_mode_t;
+
+/**
+ * Context for a streaming SHA-3, SHAKE, cSHAKE or KMAC operation.
+ *
+ * The KMAC block cannot save and restore the Keccak state, so a streaming
+ * operation keeps the hardware locked from `kmac_stream_*_init` until
+ * `kmac_stream_final` or `kmac_stream_abort`. While the block is locked, all
+ * other operations that use it (the one-shot functions in this driver and
+ * `kmac_hwip_default_configure`) return `OTCRYPTO_ASYNC_INCOMPLETE` without
+ * touching the hardware. Key manager operations that use the KMAC block
+ * through its application interface stall until the lock is released; see
+ * `kmac_stream_idle_check`.
+ *
+ * The fields of this struct are internal to the driver; callers should treat
+ * it as opaque.
+ */
+typedef struct kmac_ctx {
+  // Hardware operation (internal `kmac_operation_t` value).
+  uint32_t operation;
+  // Keccak rate in 32-bit words.
+  size_t rate_words;
+  // Fixed output length in words (SHA-3 and KMAC), or 0 for XOFs.
+  size_t digest_wordlen;
+  // Number of words already read from the current state block.
+  size_t state_offset;
+  // Whether the absorb phase has finished.
+  hardened_bool_t squeezing;
+} kmac_ctx_t;
+
 /**
  * Check whether given key length is valid for KMAC.
 
@@ -293,6 +338,138 @@ status_t kmac_kmac_256(kmac_blinded_key_t *key, hardened_bool_t masked_digest,
                        const unsigned char *cust_str, size_t cust_str_len,
                        uint32_t *digest, size_t digest_len);
 
+/**
+ * Check that no streaming operation holds the KMAC block.
+ *
+ * Callers that make the key manager use the KMAC block (e.g. to generate a
+ * sideloaded key) should check this first, since the key manager would
+ * otherwise stall.
+ *
+ * @return OK, or `OTCRYPTO_ASYNC_INCOMPLETE` if the block is locked.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_idle_check(void);
+
+/**
+ * Start a streaming SHA-3 or SHAKE operation.
+ *
+ * Locks the KMAC block until `kmac_stream_final` or `kmac_stream_abort` is
+ * called with the same context; see `kmac_ctx_t`. Returns
+ * `OTCRYPTO_ASYNC_INCOMPLETE` if another streaming operation already holds
+ * the lock.
+ *
+ * @param[out] ctx Context to initialize.
+ * @param mode SHA-3 or SHAKE mode.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_hash_init(kmac_ctx_t *ctx, kmac_mode_t mode);
+
+/**
+ * Start a streaming cSHAKE operation.
+ *
+ * Locks the KMAC block; see `kmac_stream_hash_init`. The combined length of
+ * `func_name` and `cust_str` must not exceed `kKmacPrefixMaxSize`.
+ *
+ * @param[out] ctx Context to initialize.
+ * @param mode cSHAKE mode.
+ * @param func_name The function name.
+ * @param func_name_len The function name length in bytes.
+ * @param cust_str The customization string.
+ * @param cust_str_len The customization string length in bytes.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_cshake_init(kmac_ctx_t *ctx, kmac_mode_t mode,
+                                 const unsigned char *func_name,
+                                 size_t func_name_len,
+                                 const unsigned char *cust_str,
+                                 size_t cust_str_len);
+
+/**
+ * Start a streaming KMAC operation.
+ *
+ * Locks the KMAC block; see `kmac_stream_hash_init`. The key requirements are
+ * the same as for `kmac_kmac_128`. KMAC encodes the output length into the
+ * message, so it must be fixed here and passed again to `kmac_stream_final`.
+ *
+ * @param[out] ctx Context to initialize.
+ * @param mode KMAC mode.
+ * @param key The KMAC key.
+ * @param cust_str The customization string.
+ * @param cust_str_len The customization string length in bytes.
+ * @param digest_len Output length in 32-bit words.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_kmac_init(kmac_ctx_t *ctx, kmac_mode_t mode,
+                               kmac_blinded_key_t *key,
+                               const unsigned char *cust_str,
+                               size_t cust_str_len, size_t digest_len);
+
+/**
+ * Absorb more message data into a streaming operation.
+ *
+ * May be called any number of times, with any lengths, before the first call
+ * to `kmac_stream_squeeze` or `kmac_stream_final`. On error, the operation
+ * is abandoned and the KMAC block released, as for `kmac_stream_abort`.
+ *
+ * @param ctx Context of the streaming operation.
+ * @param message The input message.
+ * @param message_len The input message length in bytes.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_update(kmac_ctx_t *ctx, const uint8_t *message,
+                            size_t message_len);
+
+/**
+ * Squeeze more output from a streaming SHAKE or cSHAKE operation.
+ *
+ * The first call ends the absorb phase. Successive calls continue the same
+ * output stream, so squeezing `a` and then `b` words yields the same data as
+ * squeezing `a + b` words at once. The KMAC block stays locked; call
+ * `kmac_stream_final` to release it. On error, the operation is abandoned and
+ * the KMAC block released, as for `kmac_stream_abort`.
+ *
+ * @param ctx Context of the streaming operation.
+ * @param[out] digest Output buffer.
+ * @param digest_len Number of 32-bit words to squeeze.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_squeeze(kmac_ctx_t *ctx, uint32_t *digest,
+                             size_t digest_len);
+
+/**
+ * Finish a streaming operation and release the KMAC block.
+ *
+ * For SHA-3 and KMAC, `digest_len` must match the fixed output length. For
+ * XOFs, `digest_len` more words are squeezed (may be 0). If `masked_digest`
+ * is true, the `digest` buffer must have enough space for 2x `digest_len`
+ * words.
+ *
+ * The KMAC block is released and the context cleared also on error.
+ *
+ * @param ctx Context of the streaming operation.
+ * @param masked_digest Whether to return the digest in concatenated shares.
+ * @param[out] digest Output buffer.
+ * @param digest_len Number of 32-bit words to output.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_final(kmac_ctx_t *ctx, hardened_bool_t masked_digest,
+                           uint32_t *digest, size_t digest_len);
+
+/**
+ * Abandon a streaming operation and release the KMAC block.
+ *
+ * @param ctx Context of the streaming operation.
+ * @return Error status.
+ */
+OT_WARN_UNUSED_RESULT
+status_t kmac_stream_abort(kmac_ctx_t *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,6 +56,14 @@ status_t entropy_csrng_generate(const entropy_seed_material_t *seed_material,
   return OTCRYPTO_NOT_IMPLEMENTED;
 }
 
+status_t entropy_csrng_pool_read(uint32_t *buf, size_t len,
+                                 hardened_bool_t fips_check) {
+  // This mock does not support actually generating random values.
+  return OTCRYPTO_NOT_IMPLEMENTED;
+}
+
+status_t entropy_csrng_release(void) { return OTCRYPTO_OK; }
+
 status_t entropy_csrng_uninstantiate(void) { return OTCRYPTO_OK; }
 }
 }  // namespace test
@@ -62,6 +62,47 @@ typedef enum otbn_status {
   kOtbnStatusLocked = 0xFF,
 } otbn_status_t;
 
+/**
+ * Bookkeeping for the application that is resident in IMEM.
+ *
+ * An application is identified by its IMEM image location and length as well
+ * as its checksum; the checksum alone is only a CRC and may collide.
+ */
+typedef struct otbn_resident_app {
+  /**
+   * Whether residency is allowed at all.
+   */
+  hardened_bool_t policy;
+  /**
+   * Whether the fields below describe the current contents of IMEM.
+   */
+  hardened_bool_t valid;
+  /**
+   * Start of the resident application's IMEM image in Ibex memory.
+   */
+  const uint32_t *imem_start;
+  /**
+   * End of the resident application's IMEM image in Ibex memory.
+   */
+  const uint32_t *imem_end;
+  /**
+   * Expected `LOAD_CHECKSUM` value after loading the whole application.
+   */
+  uint32_t app_checksum;
+  /**
+   * `LOAD_CHECKSUM` value observed after writing IMEM only.
+   *
+   * Restoring this value into `LOAD_CHECKSUM` before rewriting the `.data`
+   * section lets a resident load be checked against `app_checksum`.
+   */
+  uint32_t imem_checksum;
+} otbn_resident_app_t;
+
+static otbn_resident_app_t resident_app = {
+    .policy = kHardenedBoolFalse,
+    .valid = kHardenedBoolFalse,
+};
+
 /**
  * Ensures that a memory access fits within the given memory size.
  *
@@ -201,6 +242,10 @@ status_t otbn_busy_wait_for_done(void) {
     return res;
   }
 
+  // Any error makes the IMEM contents suspect; force the next load to be a
+  // full one.
+  otbn_resident_app_invalidate();
+
   // If OTBN is idle (not locked), then return a recoverable error.
   if (launder32(status) == kOtbnStatusIdle) {
     HARDENED_CHECK_EQ(status, kOtbnStatusIdle);
@@ -212,6 +257,25 @@ status_t otbn_busy_wait_for_done(void) {
   return OTCRYPTO_FATAL_ERR;
 }
 
+status_t otbn_done_check(void) {
+  uint32_t status = abs_mmio_read32(kBase + OTBN_STATUS_REG_OFFSET);
+  if (launder32(status) == kOtbnStatusIdle ||
+      launder32(status) == kOtbnStatusLocked) {
+    return OTCRYPTO_OK;
+  }
+  return OTCRYPTO_ASYNC_INCOMPLETE;
+}
+
+void otbn_irq_done_enable(bool enable) {
+  abs_mmio_write32(kBase + OTBN_INTR_ENABLE_REG_OFFSET,
+                   bitfield_bit32_write(0, OTBN_INTR_ENABLE_DONE_BIT, enable));
+}
+
+void otbn_irq_done_acknowledge(void) {
+  abs_mmio_write32(kBase + OTBN_INTR_STATE_REG_OFFSET,
+                   bitfield_bit32_write(0, OTBN_INTR_STATE_DONE_BIT, true));
+}
+
 uint32_t otbn_err_bits_get(void) {
   return abs_mmio_read32(kBase + OTBN_ERR_BITS_REG_OFFSET);
 }
@@ -222,6 +286,7 @@ uint32_t otbn_instruction_count_get(void) {
 
 status_t otbn_imem_sec_wipe(void) {
   HARDENED_TRY(otbn_assert_idle());
+  otbn_resident_app_invalidate();
   abs_mmio_write32(kBase + OTBN_CMD_REG_OFFSET, kOtbnCmdSecWipeImem);
   HARDENED_TRY(otbn_busy_wait_for_done());
   return OTCRYPTO_OK;
@@ -279,6 +344,53 @@ static status_t check_app_address_ranges(const otbn_app_t *app) {
   return OTCRYPTO_OK;
 }
 
+status_t otbn_resident_app_policy_set(hardened_bool_t allow) {
+  if (launder32(allow) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(allow, kHardenedBoolTrue);
+    resident_app.policy = kHardenedBoolTrue;
+    return OTCRYPTO_OK;
+  }
+  if (launder32(allow) != kHardenedBoolFalse) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(allow, kHardenedBoolFalse);
+  resident_app.policy = kHardenedBoolFalse;
+  otbn_resident_app_invalidate();
+  return OTCRYPTO_OK;
+}
+
+void otbn_resident_app_invalidate(void) {
+  resident_app.valid = kHardenedBoolFalse;
+  resident_app.imem_start = NULL;
+  resident_app.imem_end = NULL;
+  resident_app.app_checksum = 0;
+  resident_app.imem_checksum = 0;
+}
+
+/**
+ * Checks whether the given application is resident in IMEM.
+ *
+ * Fails closed: any inconsistency results in `kHardenedBoolFalse`.
+ *
+ * @param app the OTBN application to check.
+ * @return `kHardenedBoolTrue` if the IMEM reload may be skipped.
+ */
+static hardened_bool_t resident_app_matches(const otbn_app_t *app) {
+  if (launder32(resident_app.policy) != kHardenedBoolTrue ||
+      launder32(resident_app.valid) != kHardenedBoolTrue) {
+    return kHardenedBoolFalse;
+  }
+  if (resident_app.imem_start != app->imem_start ||
+      resident_app.imem_end != app->imem_end ||
+      launder32(resident_app.app_checksum) != app->checksum) {
+    return kHardenedBoolFalse;
+  }
+  HARDENED_CHECK_EQ(resident_app.policy, kHardenedBoolTrue);
+  HARDENED_CHECK_EQ(resident_app.valid, kHardenedBoolTrue);
+  HARDENED_CHECK_EQ(resident_app.app_checksum, app->checksum);
+  return kHardenedBoolTrue;
+}
+
 status_t otbn_load_app(const otbn_app_t app) {
   HARDENED_TRY(check_app_address_ranges(&app));
 
@@ -289,33 +401,46 @@ status_t otbn_load_app(const otbn_app_t app) {
   const size_t data_num_words =
       (size_t)(app.dmem_data_end - app.dmem_data_start);
 
-  HARDENED_TRY(otbn_imem_sec_wipe());
-  HARDENED_TRY(otbn_dmem_sec_wipe());
-
-  // Reset the LOAD_CHECKSUM register.
-  abs_mmio_write32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET, 0);
-
   // Ensure that the IMEM section fits in IMEM and the data section fits in
   // DMEM.
   HARDENED_TRY(check_offset_len(app.dmem_data_start_addr, data_num_words,
                                 kOtbnDMemSizeBytes));
-
-  // Write to IMEM. Always starts at zero on the OTBN side.
   otbn_addr_t imem_offset = 0;
   HARDENED_TRY(
       check_offset_len(imem_offset, imem_num_words, kOtbnIMemSizeBytes));
-  uint32_t imem_start_addr = kBase + OTBN_IMEM_REG_OFFSET + imem_offset;
+
   uint32_t i = 0;
-  for (; launder32(i) < imem_num_words; i++) {
-    HARDENED_CHECK_LT(i, imem_num_words);
-    abs_mmio_write32(imem_start_addr + i * sizeof(uint32_t), app.imem_start[i]);
+  if (launder32(resident_app_matches(&app)) == kHardenedBoolTrue) {
+    // The program is already in IMEM. DMEM may still hold secrets from the
+    // previous run, so it is always wiped.
+    HARDENED_CHECK_EQ(resident_app.policy, kHardenedBoolTrue);
+    HARDENED_TRY(otbn_dmem_sec_wipe());
+
+    // Resume the checksum as if IMEM had just been written.
+    abs_mmio_write32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET,
+                     resident_app.imem_checksum);
+  } else {
+    // `otbn_imem_sec_wipe()` also invalidates any resident application.
+    HARDENED_TRY(otbn_imem_sec_wipe());
+    HARDENED_TRY(otbn_dmem_sec_wipe());
+
+    // Reset the LOAD_CHECKSUM register.
+    abs_mmio_write32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET, 0);
+
+    // Write to IMEM. Always starts at zero on the OTBN side.
+    uint32_t imem_start_addr = kBase + OTBN_IMEM_REG_OFFSET + imem_offset;
+    for (; launder32(i) < imem_num_words; i++) {
+      HARDENED_CHECK_LT(i, imem_num_words);
+      abs_mmio_write32(imem_start_addr + i * sizeof(uint32_t),
+                       app.imem_start[i]);
+    }
+    HARDENED_CHECK_EQ(i, imem_num_words);
+    resident_app.imem_checksum =
+        abs_mmio_read32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET);
   }
-  HARDENED_CHECK_EQ(i, imem_num_words);
 
   // Write the data portion to DMEM.
   otbn_addr_t data_offset = app.dmem_data_start_addr;
-  HARDENED_TRY(
-      check_offset_len(data_offset, data_num_words, kOtbnDMemSizeBytes));
   uint32_t data_start_addr = kBase + OTBN_DMEM_REG_OFFSET + data_offset;
   i = 0;
   for (; launder32(i) < data_num_words; i++) {
@@ -328,9 +453,21 @@ status_t otbn_load_app(const otbn_app_t app) {
   // Ensure that the checksum matches expectations.
   uint32_t checksum = abs_mmio_read32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET);
   if (launder32(checksum) != app.checksum) {
+    otbn_resident_app_invalidate();
     return OTCRYPTO_FATAL_ERR;
   }
   HARDENED_CHECK_EQ(checksum, app.checksum);
 
+  // Remember the application only if the policy allows it.
+  if (launder32(resident_app.policy) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(resident_app.policy, kHardenedBoolTrue);
+    resident_app.imem_start = app.imem_start;
+    resident_app.imem_end = app.imem_end;
+    resident_app.app_checksum = app.checksum;
+    resident_app.valid = kHardenedBoolTrue;
+  } else {
+    otbn_resident_app_invalidate();
+  }
+
   return OTCRYPTO_OK;
 }
@@ -9,6 +9,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "sw/device/lib/base/hardened.h"
 #include "sw/device/lib/crypto/impl/status.h"
 
 #ifdef __cplusplus
@@ -260,6 +261,33 @@ status_t otbn_execute(void);
  */
 status_t otbn_busy_wait_for_done(void);
 
+/**
+ * Checks whether OTBN has finished its current operation, without blocking.
+ *
+ * Call `otbn_busy_wait_for_done()` afterwards to collect the result of the
+ * operation; it returns immediately once this function has reported that the
+ * operation is finished.
+ *
+ * @return `OTCRYPTO_OK` if OTBN is idle or locked, or
+ *         `OTCRYPTO_ASYNC_INCOMPLETE` if it is still busy.
+ */
+status_t otbn_done_check(void);
+
+/**
+ * Enables or disables the OTBN `done` interrupt.
+ *
+ * OTBN raises `done` whenever it finishes a command, including the secure
+ * wipes that `otbn_load_app()` issues before an application runs.
+ *
+ * @param enable Whether to enable the interrupt.
+ */
+void otbn_irq_done_enable(bool enable);
+
+/**
+ * Clears the OTBN `done` interrupt.
+ */
+void otbn_irq_done_acknowledge(void);
+
 /**
  * Get the error bits set by the device if the operation failed.
  *
@@ -324,6 +352,35 @@ status_t otbn_dmem_sec_wipe(void);
  */
 status_t otbn_set_ctrl_software_errs_fatal(bool enable);
 
+/**
+ * Sets the policy for keeping the last loaded application resident in IMEM.
+ *
+ * Residency is disabled by default. When it is enabled, `otbn_load_app()`
+ * remembers which application was last written to IMEM, and a subsequent load
+ * of the same application skips the IMEM secure wipe and reload. DMEM is still
+ * securely wiped and the `.data` section is rewritten on every load, and
+ * `LOAD_CHECKSUM` is still compared against the application checksum.
+ *
+ * IMEM only ever holds public program code, so residency does not retain
+ * secrets across operations; it does, however, rely on no other agent writing
+ * to IMEM behind this driver's back. Callers that access OTBN through other
+ * drivers must call `otbn_resident_app_invalidate()` afterwards.
+ *
+ * Disabling residency invalidates the currently resident application.
+ *
+ * @param allow `kHardenedBoolTrue` to allow residency, `kHardenedBoolFalse`
+ * to disable it.
+ * @return Result of the operation.
+ */
+status_t otbn_resident_app_policy_set(hardened_bool_t allow);
+
+/**
+ * Forgets the resident application, if any.
+ *
+ * The next call to `otbn_load_app()` will perform a full IMEM wipe and reload.
+ */
+void otbn_resident_app_invalidate(void);
+
 /**
  * (Re-)loads the provided application into OTBN.
  *
@@ -335,6 +392,9 @@ status_t otbn_set_ctrl_software_errs_fatal(bool enable);
  * Because this function uses the OTBN secure wipe functionality before
  * loading, it will lock OTBN if the entropy complex is not initialized.
  *
+ * If residency is allowed (see `otbn_resident_app_policy_set()`) and `app` is
+ * already resident in IMEM, only DMEM is wiped and reloaded.
+ *
  * @param ctx The context object.
  * @param app The application to load into OTBN.
  * @return The result of the operation.
@@ -0,0 +1,179 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/drivers/otbn_queue.h"
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+// Module ID for status codes.
+#define MODULE_ID MAKE_MODULE_ID('d', 'b', 'q')
+
+/**
+ * Progress of a job through the queue.
+ */
+typedef enum otbn_job_state {
+  /** Submitted, but not yet prepared. */
+  kOtbnJobStatePending = 0x4c1bb2e6,
+  /** Prepared; `result` holds the result of `prepare`. */
+  kOtbnJobStatePrepared = 0x93e5d871,
+  /** Running on OTBN. */
+  kOtbnJobStateRunning = 0x2a7c0f9d,
+  /** Done; `result` holds the result of the job. */
+  kOtbnJobStateDone = 0xe5920b3a,
+} otbn_job_state_t;
+
+/**
+ * Oldest job that is not yet done; it is running if OTBN is busy.
+ */
+static otbn_job_t *queue_head;
+
+/**
+ * Newest job in the queue.
+ */
+static otbn_job_t *queue_tail;
+
+/**
+ * Whether the queue is advanced by `otbn_queue_irq()`.
+ */
+static bool irq_enabled;
+
+/**
+ * Masks the OTBN `done` interrupt while the queue is edited or advanced
+ * outside of `otbn_queue_irq()`, so that the handler never sees the queue
+ * half-updated.
+ */
+static void irq_mask(void) {
+  if (irq_enabled) {
+    otbn_irq_done_enable(false);
+  }
+}
+
+/**
+ * Unmasks the OTBN `done` interrupt after `irq_mask()`.
+ *
+ * If OTBN finished in the meantime, the pending interrupt fires now.
+ */
+static void irq_unmask(void) {
+  if (irq_enabled) {
+    otbn_irq_done_enable(true);
+  }
+}
+
+/**
+ * Runs the `prepare` phase of `job`, if it has not run yet.
+ */
+static void job_prepare(otbn_job_t *job) {
+  if (job == NULL || job->state != kOtbnJobStatePending) {
+    return;
+  }
+  job->result = job->prepare != NULL ? job->prepare(job->ctx) : OTCRYPTO_OK;
+  job->state = kOtbnJobStatePrepared;
+}
+
+/**
+ * Marks the job at the head of the queue as done and removes it.
+ *
+ * @param job The job at the head of the queue.
+ * @param result Result of the job.
+ * @param ran Whether the job got as far as writing to OTBN.
+ */
+static void job_complete(otbn_job_t *job, status_t result, bool ran) {
+  if (ran && !status_ok(result)) {
+    // Do not leave inputs or partial results of a failed job in DMEM. If OTBN
+    // is locked the wipe fails too, and the error already reports that.
+    OT_DISCARD(status_ok(otbn_dmem_sec_wipe()));
+  }
+  job->result = result;
+  queue_head = job->next;
+  if (queue_head == NULL) {
+    queue_tail = NULL;
+  }
+  job->next = NULL;
+  job->state = kOtbnJobStateDone;
+}
+
+status_t otbn_queue_poll(void) {
+  while (queue_head != NULL) {
+    otbn_job_t *job = queue_head;
+    if (job->state == kOtbnJobStateRunning) {
+      if (!status_ok(otbn_done_check())) {
+        // OTBN is still busy; use the time to get the next job ready.
+        job_prepare(job->next);
+        return OTCRYPTO_OK;
+      }
+      job_complete(job, job->finalize(job->ctx), /*ran=*/true);
+      continue;
+    }
+
+    job_prepare(job);
+    if (!status_ok(job->result)) {
+      job_complete(job, job->result, /*ran=*/false);
+      continue;
+    }
+    status_t result = job->start(job->ctx);
+    if (!status_ok(result)) {
+      job_complete(job, result, /*ran=*/true);
+      continue;
+    }
+    job->state = kOtbnJobStateRunning;
+    // The secure wipes issued while loading the application also raise
+    // `done`, so clear it now that the job runs. A job that is already
+    // finished is caught by the status check on the next pass.
+    otbn_irq_done_acknowledge();
+  }
+  return OTCRYPTO_OK;
+}
+
+status_t otbn_queue_submit(otbn_job_t *job) {
+  if (job == NULL || job->start == NULL || job->finalize == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  job->next = NULL;
+  job->state = kOtbnJobStatePending;
+  job->result = OTCRYPTO_ASYNC_INCOMPLETE;
+  irq_mask();
+  if (queue_tail == NULL) {
+    queue_head = job;
+  } else {
+    queue_tail->next = job;
+  }
+  queue_tail = job;
+  status_t result = otbn_queue_poll();
+  irq_unmask();
+  return result;
+}
+
+hardened_bool_t otbn_job_done(const otbn_job_t *job) {
+  if (launder32(job->state) == kOtbnJobStateDone) {
+    HARDENED_CHECK_EQ(job->state, kOtbnJobStateDone);
+    return kHardenedBoolTrue;
+  }
+  return kHardenedBoolFalse;
+}
+
+status_t otbn_queue_wait(otbn_job_t *job) {
+  while (launder32(otbn_job_done(job)) != kHardenedBoolTrue) {
+    irq_mask();
+    status_t result = otbn_queue_poll();
+    irq_unmask();
+    HARDENED_TRY(result);
+  }
+  HARDENED_CHECK_EQ(job->state, kOtbnJobStateDone);
+  return job->result;
+}
+
+void otbn_queue_irq_enable(bool enable) {
+  otbn_irq_done_acknowledge();
+  irq_enabled = enable;
+  otbn_irq_done_enable(enable);
+}
+
+void otbn_queue_irq(void) {
+  otbn_irq_done_acknowledge();
+  // Errors are reported through the jobs.
+  OT_DISCARD(status_ok(otbn_queue_poll()));
+}
@@ -0,0 +1,149 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_OTBN_QUEUE_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_OTBN_QUEUE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+/**
+ * @file
+ * @brief Queue of OTBN jobs that overlaps Ibex work with OTBN execution.
+ *
+ * Each job is split into the phases that the asymmetric implementations
+ * already expose as `*_start()` and `*_finalize()`, plus an optional
+ * `prepare` phase for input processing that does not touch OTBN, such as
+ * hashing a message or encoding a padded block. While OTBN runs one job, the
+ * queue runs the `prepare` phase of the next one, and as soon as OTBN is done
+ * it finalizes the job and starts the next one.
+ *
+ * The queue is advanced by `otbn_queue_poll()`, `otbn_queue_wait()` or, with
+ * the OTBN `done` interrupt enabled, `otbn_queue_irq()` called from the
+ * interrupt handler. `otbn_queue_submit()` and `otbn_queue_wait()` mask the
+ * interrupt while they edit or advance the queue, so they can be used
+ * alongside the handler; `otbn_queue_poll()` cannot. While the queue holds
+ * jobs, OTBN must not be used by anything else.
+ *
+ * Completion is decided from the OTBN status register only, and every job
+ * that reaches OTBN is completed by `finalize`, followed by a DMEM wipe if it
+ * failed, so the point at which a job is reported done does not depend on its
+ * data.
+ *
+ * Jobs that run the same application back to back avoid reloading IMEM when
+ * residency is allowed; see `otbn_resident_app_policy_set()`.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * One phase of an OTBN job.
+ *
+ * @param ctx The `ctx` field of the job.
+ * @return Result of the phase.
+ */
+typedef status_t (*otbn_job_fn_t)(void *ctx);
+
+/**
+ * State of one queued OTBN job.
+ *
+ * Callers set `prepare`, `start`, `finalize` and `ctx` before submitting the
+ * job, and must keep the struct alive until it is done. The remaining fields
+ * are private to the queue.
+ */
+typedef struct otbn_job {
+  /**
+   * Prepares the job's inputs without using OTBN; may be NULL.
+   *
+   * This may run while OTBN executes the previous job.
+   */
+  otbn_job_fn_t prepare;
+  /**
+   * Loads the application, writes its inputs and starts OTBN, e.g. with
+   * `p256_ecdsa_sign_start()`.
+   */
+  otbn_job_fn_t start;
+  /**
+   * Reads the results and wipes DMEM once OTBN is done, e.g. with
+   * `p256_ecdsa_sign_finalize()`.
+   */
+  otbn_job_fn_t finalize;
+  void *ctx;
+
+  /** Next job in the queue. */
+  struct otbn_job *next;
+  /** Progress of the job through the queue. */
+  uint32_t state;
+  /** Result of the job; only meaningful once it is done. */
+  status_t result;
+} otbn_job_t;
+
+/**
+ * Adds a job to the end of the queue and advances the queue.
+ *
+ * @param job The job to add.
+ * @return `OTCRYPTO_BAD_ARGS` if `start` or `finalize` is NULL, otherwise the
+ *         result of advancing the queue.
+ */
+status_t otbn_queue_submit(otbn_job_t *job);
+
+/**
+ * Advances the queue without waiting for OTBN.
+ *
+ * Finalizes the running job if OTBN is done, starts the next job if OTBN is
+ * idle, and prepares the job after that while OTBN runs. Errors from a job's
+ * phases are reported through that job.
+ *
+ * This does not mask the OTBN `done` interrupt, so it must not be called
+ * while `otbn_queue_irq()` is in use.
+ *
+ * @return Result of the operation.
+ */
+status_t otbn_queue_poll(void);
+
+/**
+ * Advances the queue until a job is done.
+ *
+ * @param job A job that has been submitted to the queue.
+ * @return The result of the job.
+ */
+status_t otbn_queue_wait(otbn_job_t *job);
+
+/**
+ * Checks whether a job is done.
+ *
+ * @param job A job that has been submitted to the queue.
+ * @return `kHardenedBoolTrue` once the job is done.
+ */
+hardened_bool_t otbn_job_done(const otbn_job_t *job);
+
+/**
+ * Enables or disables the OTBN `done` interrupt for the queue.
+ *
+ * With the interrupt enabled, call `otbn_queue_irq()` from its handler and
+ * wait for `otbn_job_done()` (e.g. with `wait_for_interrupt()`) instead of
+ * polling.
+ *
+ * @param enable Whether to enable the interrupt.
+ */
+void otbn_queue_irq_enable(bool enable);
+
+/**
+ * Acknowledges the OTBN `done` interrupt and advances the queue.
+ *
+ * Call this from the handler for the OTBN `done` interrupt. The caller remains
+ * responsible for acknowledging the interrupt at the PLIC.
+ */
+void otbn_queue_irq(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_DRIVERS_OTBN_QUEUE_H_
@@ -27,6 +27,47 @@ OT_ASSERT_ENUM_VALUE(kAesCipherModeCfb, (uint32_t)kOtcryptoAesModeCfb);
 OT_ASSERT_ENUM_VALUE(kAesCipherModeOfb, (uint32_t)kOtcryptoAesModeOfb);
 OT_ASSERT_ENUM_VALUE(kAesCipherModeCtr, (uint32_t)kOtcryptoAesModeCtr);
 
+enum {
+  /**
+   * Maximum number of blocks kept in the AES pipeline by streaming operations.
+   *
+   * Same as `block_offset` in `otcrypto_aes` for long inputs: software reads
+   * block x-1 while the hardware processes block x and software writes block
+   * x+1.
+   */
+  kAesStreamMaxBlocksInFlight = 2,
+};
+
+/**
+ * Internal representation of `otcrypto_aes_context_t`.
+ */
+typedef struct aes_ctx {
+  // Block cipher mode.
+  otcrypto_aes_mode_t mode;
+  // Encrypt or decrypt.
+  otcrypto_aes_operation_t operation;
+  // Padding mode (encryption only).
+  otcrypto_aes_padding_t padding;
+  // Whether the key is sideloaded and must be cleared at the end.
+  hardened_bool_t sideload;
+  // Whether the operation still owns the AES block. Cleared by
+  // `otcrypto_aes_final` and whenever the operation is abandoned.
+  hardened_bool_t active;
+  // Number of blocks fed to the hardware whose output has not been read.
+  size_t blocks_in_flight;
+  // Number of bytes buffered in `partial`.
+  size_t partial_len;
+  // Input bytes that do not yet form a full block.
+  aes_block_t partial;
+} aes_ctx_t;
+
+// Ensure that the AES context is large enough for the internal struct.
+static_assert(sizeof(otcrypto_aes_context_t) == sizeof(aes_ctx_t),
+              "`otcrypto_aes_context_t` must be the same size as `aes_ctx_t`.");
+static_assert(kOtcryptoAesCtxStructWords * sizeof(uint32_t) ==
+                  sizeof(aes_ctx_t),
+              "`kOtcryptoAesCtxStructWords` must match `aes_ctx_t`.");
+
 /**
  * Extract an AES key from the blinded key struct.
  *
@@ -54,7 +95,9 @@ static status_t aes_key_construct(otcrypto_blinded_key_t *blinded_key,
                     kHardenedBoolTrue);
 
   if (blinded_key->config.hw_backed == kHardenedBoolTrue) {
-    // Call keymgr to sideload the key into AES.
+    // Call keymgr to sideload the key into AES, unless that would replace the
+    // key of a reserved AES operation.
+    HARDENED_TRY(aes_reservation_check());
     keymgr_diversification_t diversification;
     HARDENED_TRY(
         keyblob_to_keymgr_diversification(blinded_key, &diversification));
@@ -398,3 +441,305 @@ otcrypto_status_t otcrypto_aes(otcrypto_blinded_key_t *key,
   // In case the key was sideloaded, clear it.
   return keymgr_sideload_clear_aes();
 }
+
+otcrypto_status_t otcrypto_aes_init(otcrypto_blinded_key_t *key,
+                                    otcrypto_const_word32_buf_t iv,
+                                    otcrypto_aes_mode_t aes_mode,
+                                    otcrypto_aes_operation_t aes_operation,
+                                    otcrypto_aes_padding_t aes_padding,
+                                    otcrypto_aes_context_t *ctx) {
+  // Check for NULL pointers in input pointers and data buffers.
+  if (key == NULL || ctx == NULL ||
+      (aes_mode != kOtcryptoAesModeEcb && iv.data == NULL)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check the padding mode early so that `final` cannot fail on it.
+  switch (aes_padding) {
+    case kOtcryptoAesPaddingPkcs7:
+    case kOtcryptoAesPaddingIso9797M2:
+    case kOtcryptoAesPaddingNull:
+      break;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Ensure the entropy complex is initialized.
+  HARDENED_TRY(entropy_complex_check());
+
+  // Construct the IV and check its length. ECB mode will ignore the IV, so in
+  // this case it is left uninitialized.
+  aes_block_t aes_iv;
+  if (aes_mode == launder32(kAesCipherModeEcb)) {
+    HARDENED_CHECK_EQ(aes_mode, kAesCipherModeEcb);
+  } else {
+    HARDENED_CHECK_NE(aes_mode, kAesCipherModeEcb);
+
+    // The IV must be exactly one block long.
+    if (launder32(iv.len) != kAesBlockNumWords) {
+      return OTCRYPTO_BAD_ARGS;
+    }
+    HARDENED_CHECK_EQ(iv.len, kAesBlockNumWords);
+    hardened_memcpy(aes_iv.data, iv.data, kAesBlockNumWords);
+  }
+
+  // Parse the AES key.
+  aes_key_t aes_key;
+  HARDENED_TRY(aes_key_construct(key, aes_mode, &aes_key));
+
+  // Start the operation (encryption or decryption) and keep the hardware for
+  // this context until `otcrypto_aes_final`.
+  switch (aes_operation) {
+    case kOtcryptoAesOperationEncrypt:
+      HARDENED_TRY(aes_encrypt_begin(aes_key, &aes_iv));
+      break;
+    case kOtcryptoAesOperationDecrypt:
+      HARDENED_TRY(aes_decrypt_begin(aes_key, &aes_iv));
+      break;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_TRY(aes_reserve());
+
+  aes_ctx_t *aes_ctx = (aes_ctx_t *)ctx->data;
+  aes_ctx->mode = aes_mode;
+  aes_ctx->operation = aes_operation;
+  aes_ctx->padding = aes_padding;
+  aes_ctx->sideload = aes_key.sideload;
+  aes_ctx->blocks_in_flight = 0;
+  aes_ctx->partial_len = 0;
+  hardened_memshred(aes_ctx->partial.data, ARRAYSIZE(aes_ctx->partial.data));
+  aes_ctx->active = kHardenedBoolTrue;
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Check that a streaming operation has not ended.
+ *
+ * An ended context no longer owns the AES block, so it must not drive the
+ * hardware or release a reservation made by another operation.
+ *
+ * @param ctx Streaming context.
+ * @return OK, or `OTCRYPTO_BAD_ARGS` if the operation has ended.
+ */
+static status_t aes_stream_active_check(const aes_ctx_t *ctx) {
+  if (launder32(ctx->active) != kHardenedBoolTrue) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(ctx->active, kHardenedBoolTrue);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Feed one full block to the AES pipeline.
+ *
+ * Keeps up to `kAesStreamMaxBlocksInFlight` blocks in the hardware; once the
+ * pipeline is full, each new block produces the output of the oldest one.
+ *
+ * @param ctx Streaming context.
+ * @param block_in Input block.
+ * @param[out] output Output buffer.
+ * @param[in,out] output_len Bytes written to `output` so far.
+ * @return Result of the operation.
+ */
+static status_t aes_stream_block(aes_ctx_t *ctx, const aes_block_t *block_in,
+                                 otcrypto_byte_buf_t output,
+                                 size_t *output_len) {
+  if (launder32(ctx->blocks_in_flight) < kAesStreamMaxBlocksInFlight) {
+    HARDENED_CHECK_LT(ctx->blocks_in_flight, kAesStreamMaxBlocksInFlight);
+    HARDENED_TRY(aes_update(/*dest=*/NULL, block_in));
+    ctx->blocks_in_flight++;
+    return OTCRYPTO_OK;
+  }
+  HARDENED_CHECK_EQ(ctx->blocks_in_flight, kAesStreamMaxBlocksInFlight);
+
+  if (*output_len + kAesBlockNumBytes > output.len) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  aes_block_t block_out;
+  hardened_memshred(block_out.data, ARRAYSIZE(block_out.data));
+  HARDENED_TRY(aes_update(&block_out, block_in));
+  // TODO(#17711) Change to `hardened_memcpy`.
+  memcpy(&output.data[*output_len], block_out.data, kAesBlockNumBytes);
+  *output_len += kAesBlockNumBytes;
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Feed message bytes to the AES pipeline, buffering any partial block.
+ *
+ * @param ctx Streaming context.
+ * @param input Input data.
+ * @param[out] output Output buffer.
+ * @param[out] output_len Number of bytes written to `output`.
+ * @return Result of the operation.
+ */
+static status_t aes_stream_absorb(aes_ctx_t *ctx,
+                                  otcrypto_const_byte_buf_t input,
+                                  otcrypto_byte_buf_t output,
+                                  size_t *output_len) {
+  *output_len = 0;
+  if (input.data == NULL && input.len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  if (output.data == NULL && output.len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_LT(ctx->partial_len, kAesBlockNumBytes);
+
+  // Top up the buffered partial block first.
+  size_t offset = 0;
+  if (ctx->partial_len != 0) {
+    size_t fill = kAesBlockNumBytes - ctx->partial_len;
+    if (fill > input.len) {
+      fill = input.len;
+    }
+    memcpy((unsigned char *)ctx->partial.data + ctx->partial_len, input.data,
+           fill);
+    ctx->partial_len += fill;
+    offset = fill;
+    if (ctx->partial_len < kAesBlockNumBytes) {
+      return OTCRYPTO_OK;
+    }
+    HARDENED_TRY(aes_stream_block(ctx, &ctx->partial, output, output_len));
+    ctx->partial_len = 0;
+  }
+
+  // Stream full blocks straight from the input.
+  aes_block_t block_in;
+  for (; offset + kAesBlockNumBytes <= input.len;
+       offset += kAesBlockNumBytes) {
+    // TODO(#17711) Change to `hardened_memcpy`.
+    memcpy(block_in.data, &input.data[offset], kAesBlockNumBytes);
+    HARDENED_TRY(aes_stream_block(ctx, &block_in, output, output_len));
+  }
+
+  // Keep the tail for the next call.
+  ctx->partial_len = input.len - offset;
+  memcpy(ctx->partial.data, &input.data[offset], ctx->partial_len);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Abandon a streaming operation and release the AES block.
+ *
+ * @param ctx Streaming context.
+ * @return Result of the operation.
+ */
+static status_t aes_stream_abort(aes_ctx_t *ctx) {
+  ctx->active = kHardenedBoolFalse;
+  HARDENED_TRY(aes_end(NULL));
+  hardened_memshred(ctx->partial.data, ARRAYSIZE(ctx->partial.data));
+  ctx->partial_len = 0;
+  ctx->blocks_in_flight = 0;
+  if (launder32(ctx->sideload) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(ctx->sideload, kHardenedBoolTrue);
+    return keymgr_sideload_clear_aes();
+  }
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_aes_update(otcrypto_aes_context_t *ctx,
+                                      otcrypto_const_byte_buf_t cipher_input,
+                                      otcrypto_byte_buf_t cipher_output,
+                                      size_t *output_bytes_written) {
+  if (ctx == NULL || output_bytes_written == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  aes_ctx_t *aes_ctx = (aes_ctx_t *)ctx->data;
+  HARDENED_TRY(aes_stream_active_check(aes_ctx));
+  status_t result = aes_stream_absorb(aes_ctx, cipher_input, cipher_output,
+                                      output_bytes_written);
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+    // The pipeline state is unknown after an error, so end the operation.
+    HARDENED_TRY(aes_stream_abort(aes_ctx));
+  }
+  return result;
+}
+
+/**
+ * Pad the last block, drain the pipeline and read back the IV.
+ *
+ * @param ctx Streaming context.
+ * @param[out] output Output buffer.
+ * @param[out] output_len Number of bytes written to `output`.
+ * @param[out] iv Buffer for the final IV (ignored in ECB mode).
+ * @return Result of the operation.
+ */
+static status_t aes_stream_finish(aes_ctx_t *ctx, otcrypto_byte_buf_t output,
+                                  size_t *output_len,
+                                  otcrypto_word32_buf_t iv) {
+  *output_len = 0;
+  if (output.data == NULL && output.len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  if (ctx->mode != kOtcryptoAesModeEcb &&
+      (iv.data == NULL || iv.len != kAesBlockNumWords)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Encryption with padding always ends with one padded block, which may be
+  // entirely padding; otherwise the input must have been whole blocks. As in
+  // `otcrypto_aes`, decryption does not check or strip the padding.
+  if (ctx->operation == kOtcryptoAesOperationEncrypt &&
+      ctx->padding != kOtcryptoAesPaddingNull) {
+    HARDENED_TRY(aes_padding_apply(ctx->padding, ctx->partial_len,
+                                   &ctx->partial));
+    HARDENED_TRY(aes_stream_block(ctx, &ctx->partial, output, output_len));
+    ctx->partial_len = 0;
+  } else if (ctx->partial_len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Retrieve the output of the blocks still in the pipeline.
+  if (*output_len + ctx->blocks_in_flight * kAesBlockNumBytes > output.len) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  aes_block_t block_out;
+  for (; launder32(ctx->blocks_in_flight) > 0; ctx->blocks_in_flight--) {
+    HARDENED_TRY(aes_update(&block_out, /*src=*/NULL));
+    // TODO(#17711) Change to `hardened_memcpy`.
+    memcpy(&output.data[*output_len], block_out.data, kAesBlockNumBytes);
+    *output_len += kAesBlockNumBytes;
+  }
+  HARDENED_CHECK_EQ(ctx->blocks_in_flight, 0);
+
+  // Deinitialize the AES block and update the IV (in ECB mode, skip the IV).
+  if (ctx->mode == launder32(kAesCipherModeEcb)) {
+    HARDENED_TRY(aes_end(NULL));
+  } else {
+    aes_block_t aes_iv;
+    HARDENED_TRY(aes_end(&aes_iv));
+    hardened_memcpy(iv.data, aes_iv.data, kAesBlockNumWords);
+  }
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_aes_final(otcrypto_aes_context_t *ctx,
+                                     otcrypto_byte_buf_t cipher_output,
+                                     size_t *output_bytes_written,
+                                     otcrypto_word32_buf_t iv) {
+  if (ctx == NULL || output_bytes_written == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  aes_ctx_t *aes_ctx = (aes_ctx_t *)ctx->data;
+  HARDENED_TRY(aes_stream_active_check(aes_ctx));
+  status_t result =
+      aes_stream_finish(aes_ctx, cipher_output, output_bytes_written, iv);
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue) {
+    // Release the hardware anyway; the operation cannot be resumed.
+    HARDENED_TRY(aes_stream_abort(aes_ctx));
+    return result;
+  }
+
+  aes_ctx->active = kHardenedBoolFalse;
+  hardened_memshred(aes_ctx->partial.data, ARRAYSIZE(aes_ctx->partial.data));
+  // In case the key was sideloaded, clear it.
+  if (launder32(aes_ctx->sideload) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(aes_ctx->sideload, kHardenedBoolTrue);
+    return keymgr_sideload_clear_aes();
+  }
+  return OTCRYPTO_OK;
+}
@@ -208,6 +208,8 @@ static status_t load_key_if_sideloaded(const aes_key_t key) {
     return OTCRYPTO_BAD_ARGS;
   }
   HARDENED_CHECK_EQ(key.sideload, kHardenedBoolTrue);
+  // Do not replace the key of a reserved AES operation.
+  HARDENED_TRY(aes_reservation_check());
   keymgr_diversification_t diversification;
   HARDENED_TRY(keyblob_buffer_to_keymgr_diversification(
       key.key_shares[0], kOtcryptoKeyModeAesGcm, &diversification));
@@ -211,6 +211,96 @@ otcrypto_status_t otcrypto_drbg_manual_generate(
                   drbg_output);
 }
 
+/**
+ * State of the generate operation started by `generate_async_start`.
+ */
+static struct {
+  /**
+   * Whether an operation has been started and not finalized.
+   */
+  hardened_bool_t active;
+  /**
+   * Number of words requested.
+   */
+  size_t len;
+  /**
+   * Whether to check FIPS hardware flags.
+   */
+  hardened_bool_t fips_check;
+} async_generate = {
+    .active = kHardenedBoolFalse,
+    .len = 0,
+    .fips_check = kHardenedBoolTrue,
+};
+
+/**
+ * Common function for starting asynchronous random-bit generation.
+ *
+ * @param fips_check Whether to check FIPS hardware flags
+ * @param additional_input Additional input to DRBG
+ * @param len Number of words to generate
+ * @return Result status; OK or error
+ */
+static otcrypto_status_t generate_async_start(
+    hardened_bool_t fips_check, otcrypto_const_byte_buf_t additional_input,
+    size_t len) {
+  if (additional_input.len != 0 && additional_input.data == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Any operation that was still in flight is discarded by the driver.
+  async_generate.active = kHardenedBoolFalse;
+  if (len != 0) {
+    entropy_seed_material_t seed_material;
+    HARDENED_TRY(seed_material_construct(additional_input, &seed_material));
+    HARDENED_TRY(entropy_csrng_generate_start(&seed_material, len));
+  }
+
+  async_generate.len = len;
+  async_generate.fips_check = fips_check;
+  async_generate.active = kHardenedBoolTrue;
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_drbg_generate_async_start(
+    otcrypto_const_byte_buf_t additional_input, size_t len) {
+  // Ensure the entropy complex is initialized.
+  HARDENED_TRY(entropy_complex_check());
+
+  return generate_async_start(/*fips_check=*/kHardenedBoolTrue,
+                              additional_input, len);
+}
+
+otcrypto_status_t otcrypto_drbg_manual_generate_async_start(
+    otcrypto_const_byte_buf_t additional_input, size_t len) {
+  return generate_async_start(/*fips_check=*/kHardenedBoolFalse,
+                              additional_input, len);
+}
+
+otcrypto_status_t otcrypto_drbg_generate_async_finalize(
+    otcrypto_word32_buf_t drbg_output) {
+  if (launder32(async_generate.active) != kHardenedBoolTrue) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(async_generate.active, kHardenedBoolTrue);
+  if (drbg_output.len != async_generate.len ||
+      (drbg_output.len != 0 && drbg_output.data == NULL)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  async_generate.active = kHardenedBoolFalse;
+  if (drbg_output.len == 0) {
+    return OTCRYPTO_OK;
+  }
+
+  if (async_generate.fips_check != kHardenedBoolFalse) {
+    // Randomize destination buffer.
+    hardened_memshred(drbg_output.data, drbg_output.len);
+  }
+  HARDENED_TRY(entropy_csrng_generate_data_get(
+      drbg_output.data, drbg_output.len, async_generate.fips_check));
+  return OTCRYPTO_OK;
+}
+
 otcrypto_status_t otcrypto_drbg_uninstantiate(void) {
   return entropy_csrng_uninstantiate();
 }
@@ -6,6 +6,7 @@
 
 #include "sw/device/lib/base/hardened_memory.h"
 #include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/aes.h"
 #include "sw/device/lib/crypto/drivers/entropy.h"
 #include "sw/device/lib/crypto/impl/aes_kwp/aes_kwp.h"
 #include "sw/device/lib/crypto/impl/integrity.h"
@@ -147,7 +148,9 @@ static status_t aes_kwp_key_construct(const otcrypto_blinded_key_t *key_kek,
   aes_key->mode = kAesCipherModeEcb;
 
   if (key_kek->config.hw_backed == kHardenedBoolTrue) {
-    // Call keymgr to sideload the key into AES.
+    // Call keymgr to sideload the key into AES, unless that would replace the
+    // key of a reserved AES operation.
+    HARDENED_TRY(aes_reservation_check());
     keymgr_diversification_t diversification;
     HARDENED_TRY(keyblob_to_keymgr_diversification(key_kek, &diversification));
     HARDENED_TRY(keymgr_generate_key_aes(diversification));
@@ -14,34 +14,34 @@
 // Module ID for status codes.
 #define MODULE_ID MAKE_MODULE_ID('k', 'm', 'c')
 
-otcrypto_status_t otcrypto_kmac(otcrypto_blinded_key_t *key,
-                                otcrypto_const_byte_buf_t input_message,
-                                otcrypto_const_byte_buf_t customization_string,
-                                size_t required_output_len,
-                                otcrypto_word32_buf_t tag) {
-  // TODO (#16410) Revisit/complete error checks
-
-  // Check for null pointers.
-  if (key == NULL || key->keyblob == NULL || tag.data == NULL) {
-    return OTCRYPTO_BAD_ARGS;
-  }
-
-  // Check for null input message with nonzero length.
-  if (input_message.data == NULL && input_message.len != 0) {
-    return OTCRYPTO_BAD_ARGS;
-  }
-
-  // Check for null customization string with nonzero length.
-  if (customization_string.data == NULL && customization_string.len != 0) {
-    return OTCRYPTO_BAD_ARGS;
-  }
-
-  // Ensure that tag buffer length and `required_output_len` match each other.
-  if (required_output_len != tag.len * sizeof(uint32_t) ||
-      required_output_len == 0) {
-    return OTCRYPTO_BAD_ARGS;
-  }
-
+/**
+ * Internal representation of `otcrypto_kmac_context_t`.
+ */
+typedef struct kmac_stream_ctx {
+  // Streaming state of the KMAC driver.
+  kmac_ctx_t kmac;
+  // Whether the key is sideloaded and must be cleared at the end.
+  hardened_bool_t hw_backed;
+} kmac_stream_ctx_t;
+
+// Ensure that the KMAC context is large enough for the internal struct.
+static_assert(
+    sizeof(otcrypto_kmac_context_t) == sizeof(kmac_stream_ctx_t),
+    "`otcrypto_kmac_context_t` must be the same size as `kmac_stream_ctx_t`.");
+
+/**
+ * Check a KMAC key and make it available to the KMAC driver.
+ *
+ * For hardware-backed keys, this generates the sideloaded key; the caller must
+ * clear it afterwards with `keymgr_sideload_clear_kmac`.
+ *
+ * @param key Pointer to the blinded key struct with key shares.
+ * @param[out] kmac_key Driver representation of the key.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t kmac_key_prepare(otcrypto_blinded_key_t *key,
+                                 kmac_blinded_key_t *kmac_key) {
   // Ensure the entropy complex is initialized.
   HARDENED_TRY(entropy_complex_check());
 
@@ -56,17 +56,17 @@ otcrypto_status_t otcrypto_kmac(otcrypto_blinded_key_t *key,
   }
   HARDENED_CHECK_EQ(integrity_blinded_key_check(key), kHardenedBoolTrue);
 
-  kmac_blinded_key_t kmac_key = {
-      .share0 = NULL,
-      .share1 = NULL,
-      .hw_backed = key->config.hw_backed,
-      .len = key_len,
-  };
+  kmac_key->share0 = NULL;
+  kmac_key->share1 = NULL;
+  kmac_key->hw_backed = key->config.hw_backed;
+  kmac_key->len = key_len;
 
   if (key->config.hw_backed == kHardenedBoolTrue) {
     if (key_len != kKmacSideloadKeyLength / 8) {
       return OTCRYPTO_BAD_ARGS;
     }
+    // The key manager needs the KMAC block to generate the key.
+    HARDENED_TRY(kmac_stream_idle_check());
     // Configure keymgr with diversification input and then generate the
     // sideload key.
     keymgr_diversification_t diversification;
@@ -82,11 +82,45 @@ otcrypto_status_t otcrypto_kmac(otcrypto_blinded_key_t *key,
     if (key->keyblob_length != 2 * key->config.key_length) {
       return OTCRYPTO_BAD_ARGS;
     }
-    HARDENED_TRY(keyblob_to_shares(key, &kmac_key.share0, &kmac_key.share1));
+    HARDENED_TRY(keyblob_to_shares(key, &kmac_key->share0, &kmac_key->share1));
   } else {
     return OTCRYPTO_BAD_ARGS;
   }
 
+  return OTCRYPTO_OK;
+}
+
+otcrypto_status_t otcrypto_kmac(otcrypto_blinded_key_t *key,
+                                otcrypto_const_byte_buf_t input_message,
+                                otcrypto_const_byte_buf_t customization_string,
+                                size_t required_output_len,
+                                otcrypto_word32_buf_t tag) {
+  // TODO (#16410) Revisit/complete error checks
+
+  // Check for null pointers.
+  if (key == NULL || key->keyblob == NULL || tag.data == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check for null input message with nonzero length.
+  if (input_message.data == NULL && input_message.len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check for null customization string with nonzero length.
+  if (customization_string.data == NULL && customization_string.len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Ensure that tag buffer length and `required_output_len` match each other.
+  if (required_output_len != tag.len * sizeof(uint32_t) ||
+      required_output_len == 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_blinded_key_t kmac_key;
+  HARDENED_TRY(kmac_key_prepare(key, &kmac_key));
+
   switch (key->config.key_mode) {
     case kOtcryptoKeyModeKmac128:
       HARDENED_TRY(kmac_kmac_128(
@@ -112,3 +146,97 @@ otcrypto_status_t otcrypto_kmac(otcrypto_blinded_key_t *key,
 
   return OTCRYPTO_OK;
 }
+
+otcrypto_status_t otcrypto_kmac_init(
+    otcrypto_blinded_key_t *key,
+    otcrypto_const_byte_buf_t customization_string,
+    size_t required_output_len, otcrypto_kmac_context_t *ctx) {
+  // Check for null pointers.
+  if (key == NULL || key->keyblob == NULL || ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Check for null customization string with nonzero length.
+  if (customization_string.data == NULL && customization_string.len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // The tag is returned in whole words.
+  if (required_output_len == 0 ||
+      required_output_len % sizeof(uint32_t) != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_mode_t mode;
+  switch (key->config.key_mode) {
+    case kOtcryptoKeyModeKmac128:
+      mode = kKmacModeKmac128;
+      break;
+    case kOtcryptoKeyModeKmac256:
+      mode = kKmacModeKmac256;
+      break;
+    default:
+      return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_blinded_key_t kmac_key;
+  HARDENED_TRY(kmac_key_prepare(key, &kmac_key));
+
+  kmac_stream_ctx_t *kmac_ctx = (kmac_stream_ctx_t *)ctx->data;
+  kmac_ctx->hw_backed = key->config.hw_backed;
+  status_t result = kmac_stream_kmac_init(
+      &kmac_ctx->kmac, mode, &kmac_key, customization_string.data,
+      customization_string.len, required_output_len / sizeof(uint32_t));
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue &&
+      key->config.hw_backed == kHardenedBoolTrue) {
+    // Do not leave the sideloaded key behind if the operation did not start.
+    HARDENED_TRY(keymgr_sideload_clear_kmac());
+  }
+  return result;
+}
+
+otcrypto_status_t otcrypto_kmac_update(
+    otcrypto_kmac_context_t *ctx, otcrypto_const_byte_buf_t input_message) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_stream_ctx_t *kmac_ctx = (kmac_stream_ctx_t *)ctx->data;
+  status_t result = kmac_stream_update(&kmac_ctx->kmac, input_message.data,
+                                       input_message.len);
+  if (launder32(OT_UNSIGNED(result.value)) != kHardenedBoolTrue &&
+      kmac_ctx->hw_backed == kHardenedBoolTrue) {
+    // The driver has abandoned the operation; clear the sideloaded key too.
+    HARDENED_TRY(keymgr_sideload_clear_kmac());
+  }
+  return result;
+}
+
+otcrypto_status_t otcrypto_kmac_final(otcrypto_kmac_context_t *ctx,
+                                      otcrypto_word32_buf_t tag) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_stream_ctx_t *kmac_ctx = (kmac_stream_ctx_t *)ctx->data;
+  hardened_bool_t hw_backed = kmac_ctx->hw_backed;
+  status_t result;
+  if (tag.data == NULL) {
+    // Release the hardware anyway; the caller cannot resume this operation.
+    HARDENED_TRY(kmac_stream_abort(&kmac_ctx->kmac));
+    result = OTCRYPTO_BAD_ARGS;
+  } else {
+    // The driver checks the tag length against the length given at init.
+    result = kmac_stream_final(&kmac_ctx->kmac,
+                               /*masked_digest=*/kHardenedBoolFalse, tag.data,
+                               tag.len);
+  }
+
+  if (hw_backed == kHardenedBoolTrue) {
+    HARDENED_TRY(keymgr_sideload_clear_kmac());
+  } else if (hw_backed != kHardenedBoolFalse) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  kmac_ctx->hw_backed = kHardenedBoolFalse;
+  return result;
+}
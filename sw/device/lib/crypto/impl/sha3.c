@@ -13,6 +13,21 @@
 // Module ID for status codes.
 #define MODULE_ID MAKE_MODULE_ID('s', 'h', '3')
 
+/**
+ * Internal representation of `otcrypto_sha3_context_t`.
+ */
+typedef struct sha3_ctx {
+  // Streaming state of the KMAC driver.
+  kmac_ctx_t kmac;
+  // Hash mode, reported in the output digests.
+  otcrypto_hash_mode_t mode;
+} sha3_ctx_t;
+
+// Ensure that the hash context is large enough for the internal struct.
+static_assert(
+    sizeof(otcrypto_sha3_context_t) == sizeof(sha3_ctx_t),
+    "`otcrypto_sha3_context_t` must be the same size as `sha3_ctx_t`.");
+
 otcrypto_status_t otcrypto_sha3_224(otcrypto_const_byte_buf_t message,
                                     otcrypto_hash_digest_t *digest) {
   if (launder32(digest->len) != kKmacSha3224DigestWords) {
@@ -98,3 +113,116 @@ otcrypto_status_t otcrypto_cshake256(
                          function_name_string.len, customization_string.data,
                          customization_string.len, digest->data, digest->len);
 }
+
+otcrypto_status_t otcrypto_sha3_init(otcrypto_hash_mode_t hash_mode,
+                                     otcrypto_sha3_context_t *ctx) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_mode_t mode;
+  switch (hash_mode) {
+    case kOtcryptoHashModeSha3_224:
+      mode = kKmacModeSha3_224;
+      break;
+    case kOtcryptoHashModeSha3_256:
+      mode = kKmacModeSha3_256;
+      break;
+    case kOtcryptoHashModeSha3_384:
+      mode = kKmacModeSha3_384;
+      break;
+    case kOtcryptoHashModeSha3_512:
+      mode = kKmacModeSha3_512;
+      break;
+    case kOtcryptoHashXofModeShake128:
+      mode = kKmacModeShake128;
+      break;
+    case kOtcryptoHashXofModeShake256:
+      mode = kKmacModeShake256;
+      break;
+    default:
+      // Unrecognized or unsupported hash mode.
+      return OTCRYPTO_BAD_ARGS;
+  }
+
+  sha3_ctx_t *sha3_ctx = (sha3_ctx_t *)ctx->data;
+  sha3_ctx->mode = hash_mode;
+  return kmac_stream_hash_init(&sha3_ctx->kmac, mode);
+}
+
+otcrypto_status_t otcrypto_cshake_init(
+    otcrypto_hash_mode_t hash_mode,
+    otcrypto_const_byte_buf_t function_name_string,
+    otcrypto_const_byte_buf_t customization_string,
+    otcrypto_sha3_context_t *ctx) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  if (function_name_string.data == NULL && function_name_string.len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  if (customization_string.data == NULL && customization_string.len != 0) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  kmac_mode_t mode;
+  switch (hash_mode) {
+    case kOtcryptoHashXofModeCshake128:
+      mode = kKmacModeCshake128;
+      break;
+    case kOtcryptoHashXofModeCshake256:
+      mode = kKmacModeCshake256;
+      break;
+    default:
+      // Unrecognized or unsupported hash mode.
+      return OTCRYPTO_BAD_ARGS;
+  }
+
+  sha3_ctx_t *sha3_ctx = (sha3_ctx_t *)ctx->data;
+  sha3_ctx->mode = hash_mode;
+  return kmac_stream_cshake_init(
+      &sha3_ctx->kmac, mode, function_name_string.data,
+      function_name_string.len, customization_string.data,
+      customization_string.len);
+}
+
+otcrypto_status_t otcrypto_sha3_update(otcrypto_sha3_context_t *ctx,
+                                       otcrypto_const_byte_buf_t message) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  sha3_ctx_t *sha3_ctx = (sha3_ctx_t *)ctx->data;
+  return kmac_stream_update(&sha3_ctx->kmac, message.data, message.len);
+}
+
+otcrypto_status_t otcrypto_sha3_squeeze(otcrypto_sha3_context_t *ctx,
+                                        otcrypto_hash_digest_t *digest) {
+  if (ctx == NULL || digest == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  sha3_ctx_t *sha3_ctx = (sha3_ctx_t *)ctx->data;
+  digest->mode = sha3_ctx->mode;
+  return kmac_stream_squeeze(&sha3_ctx->kmac, digest->data, digest->len);
+}
+
+otcrypto_status_t otcrypto_sha3_final(otcrypto_sha3_context_t *ctx,
+                                      otcrypto_hash_digest_t *digest) {
+  if (ctx == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  sha3_ctx_t *sha3_ctx = (sha3_ctx_t *)ctx->data;
+  if (digest == NULL) {
+    // Release the hardware anyway; the caller cannot resume this operation.
+    HARDENED_TRY(kmac_stream_abort(&sha3_ctx->kmac));
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // The driver checks the digest length against the mode.
+  digest->mode = sha3_ctx->mode;
+  return kmac_stream_final(&sha3_ctx->kmac,
+                           /*masked_digest=*/kHardenedBoolFalse, digest->data,
+                           digest->len);
+}
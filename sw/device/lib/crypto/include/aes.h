@@ -16,6 +16,15 @@
 extern "C" {
 #endif  // __cplusplus
 
+enum {
+  /**
+   * The size of the publicly exposed AES context in words.
+   * We assert that this value matches the size of the internal context
+   * struct.
+   */
+  kOtcryptoAesCtxStructWords = 11,
+};
+
 /**
  * Enum to define AES mode of operation.
  *
@@ -60,6 +69,16 @@ typedef enum otcrypto_aes_padding {
   kOtcryptoAesPaddingNull = 0x8ce,
 } otcrypto_aes_padding_t;
 
+/**
+ * Context for a streaming AES operation.
+ *
+ * Representation is internal to the AES implementation and subject to
+ * change; initialize with #otcrypto_aes_init.
+ */
+typedef struct otcrypto_aes_context {
+  uint32_t data[kOtcryptoAesCtxStructWords];
+} otcrypto_aes_context_t;
+
 /**
  * Get the number of blocks needed for the plaintext length and padding mode.
  *
@@ -110,6 +129,90 @@ otcrypto_status_t otcrypto_aes(otcrypto_blinded_key_t *key,
                                otcrypto_aes_padding_t aes_padding,
                                otcrypto_byte_buf_t cipher_output);
 
+/**
+ * Starts a streaming AES operation.
+ *
+ * The order of operations is:
+ *   - `otcrypto_aes_init()` called once
+ *   - `otcrypto_aes_update()` called zero or more times
+ *   - `otcrypto_aes_final()` called once
+ *
+ * The key is loaded once and the AES block stays configured between calls, so
+ * the block is reserved for this context until `otcrypto_aes_final()`. While
+ * it is reserved, other AES, AES-GCM and AES-KWP operations return
+ * `kOtcryptoStatusValueAsyncIncomplete`; at most one streaming AES context can
+ * be active at a time. `otcrypto_aes_final()` always releases the block, and
+ * so does `otcrypto_aes_update()` if it returns an error (the operation is
+ * then abandoned). Once the operation has ended, further update and final
+ * calls on the context return `kOtcryptoStatusValueBadArgs` without touching
+ * the AES block.
+ *
+ * Padding is applied by `otcrypto_aes_final()` as in `otcrypto_aes()`, so the
+ * total output has the length given by
+ * `otcrypto_aes_padded_plaintext_length()`. For decryption, the total input
+ * must be a multiple of the block size and the padding is not removed.
+ *
+ * @param key Pointer to the blinded key struct with key shares.
+ * @param iv Initialization vector, used for CBC, CFB, OFB, CTR modes. May be
+ *           NULL if mode is ECB.
+ * @param aes_mode Required AES mode of operation.
+ * @param aes_operation Required AES operation (encrypt or decrypt).
+ * @param aes_padding Padding scheme to be used for the data.
+ * @param[out] ctx Context object for the operation.
+ * @return Result of the initialization operation.
+ */
+otcrypto_status_t otcrypto_aes_init(otcrypto_blinded_key_t *key,
+                                    otcrypto_const_word32_buf_t iv,
+                                    otcrypto_aes_mode_t aes_mode,
+                                    otcrypto_aes_operation_t aes_operation,
+                                    otcrypto_aes_padding_t aes_padding,
+                                    otcrypto_aes_context_t *ctx);
+
+/**
+ * Processes more data in a streaming AES operation.
+ *
+ * Input of any length is accepted; bytes that do not complete a block are
+ * kept in the context. To keep the hardware busy, the output lags the input
+ * by up to two blocks, which are returned by later calls.
+ *
+ * The caller should allocate space for the output and set the `len` field
+ * accordingly. The number of bytes written is at most the number of full
+ * blocks completed by this call, so rounding the input length up to the next
+ * block boundary is always enough. Returns an error if `cipher_output` is not
+ * long enough.
+ *
+ * @param ctx Context object for the operation, updated in place.
+ * @param cipher_input Input data to be ciphered.
+ * @param[out] cipher_output Output data.
+ * @param[out] output_bytes_written Number of bytes written to `cipher_output`.
+ * @return Result of the update operation.
+ */
+otcrypto_status_t otcrypto_aes_update(otcrypto_aes_context_t *ctx,
+                                      otcrypto_const_byte_buf_t cipher_input,
+                                      otcrypto_byte_buf_t cipher_output,
+                                      size_t *output_bytes_written);
+
+/**
+ * Finishes a streaming AES operation.
+ *
+ * Applies the padding (for encryption) and returns the remaining output,
+ * which is at most three blocks. For modes other than ECB, the final IV is
+ * written to `iv` so that a later operation can continue the chain.
+ *
+ * Releases the AES block, also on error. The context should not be used
+ * after this operation.
+ *
+ * @param ctx Context object for the operation.
+ * @param[out] cipher_output Output data.
+ * @param[out] output_bytes_written Number of bytes written to `cipher_output`.
+ * @param[out] iv Buffer for the final IV (ignored if mode is ECB).
+ * @return Result of the final operation.
+ */
+otcrypto_status_t otcrypto_aes_final(otcrypto_aes_context_t *ctx,
+                                     otcrypto_byte_buf_t cipher_output,
+                                     size_t *output_bytes_written,
+                                     otcrypto_word32_buf_t iv);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
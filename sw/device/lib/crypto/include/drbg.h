@@ -120,6 +120,49 @@ otcrypto_status_t otcrypto_drbg_manual_generate(
     otcrypto_const_byte_buf_t additional_input,
     otcrypto_word32_buf_t drbg_output);
 
+/**
+ * Starts asynchronous random-bit generation.
+ *
+ * Sends the generate request to the hardware and returns without waiting for
+ * the output, so that the caller can do other work while it is generated.
+ * Collect the output with `otcrypto_drbg_generate_async_finalize`.
+ *
+ * See `otcrypto_drbg_generate` for requirements on input values. Only one
+ * asynchronous generate operation may be in flight; starting a new one, or
+ * any other DRBG operation, discards the output of the previous one.
+ *
+ * @param additional_input Pointer to the additional data.
+ * @param len Number of 32-bit words to generate.
+ * @return Result of the asynchronous DRBG generate start operation.
+ */
+otcrypto_status_t otcrypto_drbg_generate_async_start(
+    otcrypto_const_byte_buf_t additional_input, size_t len);
+
+/**
+ * Starts asynchronous random-bit generation without FIPS checks.
+ *
+ * Like `otcrypto_drbg_generate_async_start`, but the output is not checked for
+ * FIPS compatibility, as in `otcrypto_drbg_manual_generate`.
+ *
+ * @param additional_input Pointer to the additional data.
+ * @param len Number of 32-bit words to generate.
+ * @return Result of the asynchronous DRBG generate start operation.
+ */
+otcrypto_status_t otcrypto_drbg_manual_generate_async_start(
+    otcrypto_const_byte_buf_t additional_input, size_t len);
+
+/**
+ * Finalizes asynchronous random-bit generation.
+ *
+ * May block until the output is available. The length of `drbg_output` must
+ * match the length passed to the `_start` function.
+ *
+ * @param[out] drbg_output Pointer to the generated pseudo random bits.
+ * @return Result of the asynchronous DRBG generate finalize operation.
+ */
+otcrypto_status_t otcrypto_drbg_generate_async_finalize(
+    otcrypto_word32_buf_t drbg_output);
+
 /**
  * Uninstantiates DRBG and clears the context.
  *
@@ -18,6 +18,29 @@
 extern "C" {
 #endif  // __cplusplus
 
+enum {
+  /**
+   * The size of the publicly exposed KMAC context in words.
+   * We assert that this value matches the size of the internal context
+   * struct.
+   */
+  kOtcryptoKmacCtxStructWords = 6,
+};
+
+/**
+ * Opaque KMAC context.
+ *
+ * Representation is internal to the KMAC implementation; initialize with
+ * #otcrypto_kmac_init.
+ *
+ * Like #otcrypto_sha3_context_t, a streaming KMAC operation reserves the
+ * KMAC hardware block from init until #otcrypto_kmac_final, which always
+ * releases it. An error from #otcrypto_kmac_update also ends the operation.
+ */
+typedef struct otcrypto_kmac_context {
+  uint32_t data[kOtcryptoKmacCtxStructWords];
+} otcrypto_kmac_context_t;
+
 /**
  * Performs the KMAC function on the input data.
  *
@@ -53,6 +76,51 @@ otcrypto_status_t otcrypto_kmac(otcrypto_blinded_key_t *key,
                                 size_t required_output_len,
                                 otcrypto_word32_buf_t tag);
 
+/**
+ * Start a streaming KMAC operation.
+ *
+ * The key and customization string requirements are the same as for
+ * #otcrypto_kmac. KMAC binds the output length into the tag, so
+ * `required_output_len` must be fixed here; it must be a multiple of the word
+ * size and match the `len` of the tag buffer passed to #otcrypto_kmac_final.
+ *
+ * @param key Pointer to the blinded key struct with key shares.
+ * @param customization_string Customization string.
+ * @param required_output_len Required output length, in bytes.
+ * @param[out] ctx Initialized context object.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_kmac_init(
+    otcrypto_blinded_key_t *key,
+    otcrypto_const_byte_buf_t customization_string,
+    size_t required_output_len, otcrypto_kmac_context_t *ctx);
+
+/**
+ * Add more data to a streaming KMAC operation.
+ *
+ * @param ctx Initialized context object.
+ * @param input_message Input message data.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_kmac_update(otcrypto_kmac_context_t *ctx,
+                                       otcrypto_const_byte_buf_t input_message);
+
+/**
+ * Finish a streaming KMAC operation.
+ *
+ * Releases the KMAC hardware block (and clears a sideloaded key), also on
+ * error. The context data should not be used after this operation.
+ *
+ * @param ctx Initialized context object.
+ * @param[out] tag Output authentication tag.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_kmac_final(otcrypto_kmac_context_t *ctx,
+                                      otcrypto_word32_buf_t tag);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -18,6 +18,34 @@
 extern "C" {
 #endif  // __cplusplus
 
+enum {
+  /**
+   * The size of the publicly exposed SHA-3 context in words.
+   * We assert that this value matches the size of the internal context
+   * struct.
+   */
+  kOtcryptoSha3CtxStructWords = 6,
+};
+
+/**
+ * Opaque SHA-3, SHAKE or cSHAKE context.
+ *
+ * Representation is internal to the hash implementation; initialize
+ * with #otcrypto_sha3_init or #otcrypto_cshake_init.
+ *
+ * The KMAC hardware block cannot save its state, so it stays reserved for a
+ * streaming operation from init until #otcrypto_sha3_final, which always
+ * releases it (also when it returns an error). An error from
+ * #otcrypto_sha3_update or #otcrypto_sha3_squeeze also ends the operation and
+ * releases the block. While it is reserved, every other SHA-3, SHAKE, cSHAKE
+ * or KMAC call returns `kOtcryptoStatusValueAsyncIncomplete`, and key manager
+ * operations that use the block stall; at most one streaming context can be
+ * active at a time.
+ */
+typedef struct otcrypto_sha3_context {
+  uint32_t data[kOtcryptoSha3CtxStructWords];
+} otcrypto_sha3_context_t;
+
 /**
  * One-shot SHA3-224 hash computation.
  *
@@ -158,6 +186,87 @@ otcrypto_status_t otcrypto_cshake256(
     otcrypto_const_byte_buf_t customization_string,
     otcrypto_hash_digest_t *digest);
 
+/**
+ * Start a streaming SHA3 or SHAKE operation.
+ *
+ * Reserves the KMAC hardware block; see #otcrypto_sha3_context_t.
+ *
+ * @param hash_mode Desired mode (must be a SHA-3 or SHAKE mode).
+ * @param[out] ctx Initialized context object.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_sha3_init(otcrypto_hash_mode_t hash_mode,
+                                     otcrypto_sha3_context_t *ctx);
+
+/**
+ * Start a streaming cSHAKE operation.
+ *
+ * Reserves the KMAC hardware block; see #otcrypto_sha3_context_t.
+ *
+ * @param hash_mode Desired mode (must be a cSHAKE mode).
+ * @param function_name_string Function name parameter (may be empty).
+ * @param customization_string Customization parameter (may be empty).
+ * @param[out] ctx Initialized context object.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_cshake_init(
+    otcrypto_hash_mode_t hash_mode,
+    otcrypto_const_byte_buf_t function_name_string,
+    otcrypto_const_byte_buf_t customization_string,
+    otcrypto_sha3_context_t *ctx);
+
+/**
+ * Add more data to a streaming SHA3, SHAKE or cSHAKE operation.
+ *
+ * Must not be called after #otcrypto_sha3_squeeze.
+ *
+ * @param ctx Initialized context object.
+ * @param message Input message data.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_sha3_update(otcrypto_sha3_context_t *ctx,
+                                       otcrypto_const_byte_buf_t message);
+
+/**
+ * Squeeze more output from a streaming SHAKE or cSHAKE operation.
+ *
+ * The first call ends the input. Successive calls continue the same output
+ * stream, so the concatenated outputs equal the one-shot output of the total
+ * length. The caller should allocate space for the `digest` buffer and set the
+ * `len` field; the `mode` field is set by this function.
+ *
+ * The KMAC block remains reserved; call #otcrypto_sha3_final to release it.
+ *
+ * @param ctx Initialized context object.
+ * @param[out] digest Next part of the output.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_sha3_squeeze(otcrypto_sha3_context_t *ctx,
+                                        otcrypto_hash_digest_t *digest);
+
+/**
+ * Finish a streaming SHA3, SHAKE or cSHAKE operation.
+ *
+ * The caller should allocate space for the `digest` buffer and set the `len`
+ * field. For SHA3 modes, the length must match the mode. For SHAKE and
+ * cSHAKE, this returns the next `len` words of output (`len` may be 0 after
+ * #otcrypto_sha3_squeeze). The `mode` field is set by this function.
+ *
+ * Releases the KMAC hardware block, also on error. The context data should not
+ * be used after this operation.
+ *
+ * @param ctx Initialized context object.
+ * @param[out] digest Resulting digest.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+otcrypto_status_t otcrypto_sha3_final(otcrypto_sha3_context_t *ctx,
+                                      otcrypto_hash_digest_t *digest);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
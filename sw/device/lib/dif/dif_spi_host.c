@@ -5,7 +5,6 @@
 #include "sw/device/lib/dif/dif_spi_host.h"
 
 #include <assert.h>
-#include <stdalign.h>
 #include <stddef.h>
 
 #include "sw/device/lib/base/bitfield.h"
@@ -131,103 +130,117 @@ static void wait_ready(const dif_spi_host_t *spi_host) {
   } while (!ready);
 }
 
-static void wait_tx_fifo(const dif_spi_host_t *spi_host) {
+/**
+ * Waits for space in the transmit FIFO.
+ *
+ * @return The number of free transmit FIFO entries.
+ */
+static uint32_t wait_tx_fifo(const dif_spi_host_t *spi_host) {
   uint32_t txqd;
   do {
     uint32_t reg =
         mmio_region_read32(spi_host->base_addr, SPI_HOST_STATUS_REG_OFFSET);
     txqd = bitfield_field32_read(reg, SPI_HOST_STATUS_TXQD_FIELD);
-  } while (txqd == SPI_HOST_PARAM_TX_DEPTH);
+  } while (txqd >= SPI_HOST_PARAM_TX_DEPTH);
+  return SPI_HOST_PARAM_TX_DEPTH - txqd;
 }
 
-static void wait_rx_fifo(const dif_spi_host_t *spi_host) {
+/**
+ * Waits for data in the receive FIFO.
+ *
+ * @return The number of words in the receive FIFO.
+ */
+static uint32_t wait_rx_fifo(const dif_spi_host_t *spi_host) {
   uint32_t rxqd;
   do {
     uint32_t reg =
         mmio_region_read32(spi_host->base_addr, SPI_HOST_STATUS_REG_OFFSET);
     rxqd = bitfield_field32_read(reg, SPI_HOST_STATUS_RXQD_FIELD);
   } while (rxqd == 0);
+  return rxqd;
 }
 
-static inline void tx_fifo_write8(const dif_spi_host_t *spi_host,
-                                  uintptr_t srcaddr) {
-  uint8_t *src = (uint8_t *)srcaddr;
-  wait_tx_fifo(spi_host);
-  mmio_region_write8(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET, *src);
-}
-
-static inline void tx_fifo_write32(const dif_spi_host_t *spi_host,
-                                   uintptr_t srcaddr) {
-  wait_tx_fifo(spi_host);
-  uint32_t val = read_32((const void *)srcaddr);
-  mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET, val);
-}
-
-dif_result_t dif_spi_host_fifo_write(const dif_spi_host_t *spi_host,
-                                     const void *src, uint16_t len) {
-  uintptr_t ptr = (uintptr_t)src;
-  if (spi_host == NULL || (src == NULL && len > 0)) {
-    return kDifBadArg;
+/**
+ * Loads a little-endian word from a possibly misaligned buffer.
+ */
+static inline uint32_t load_word(const uint8_t *ptr) {
+  if (misalignment32_of((uintptr_t)ptr) == 0) {
+    return read_32(ptr);
   }
+  uint32_t val;
+  memcpy(&val, ptr, sizeof(val));
+  return val;
+}
 
-  // If the pointer starts mis-aligned, write until we are aligned.
-  while (misalignment32_of(ptr) && len > 0) {
-    tx_fifo_write8(spi_host, ptr);
-    ptr += 1;
-    len -= 1;
+/**
+ * Stores a little-endian word to a possibly misaligned buffer.
+ */
+static inline void store_word(uint32_t val, uint8_t *ptr) {
+  if (misalignment32_of((uintptr_t)ptr) == 0) {
+    write_32(val, ptr);
+  } else {
+    memcpy(ptr, &val, sizeof(val));
   }
+}
 
-  // Write complete 32-bit words to the fifo.
-  while (len > 3) {
-    tx_fifo_write32(spi_host, ptr);
-    ptr += 4;
-    len -= 4;
+/**
+ * Writes one transmit FIFO entry from `buf`.
+ *
+ * Whole words are written with a single 32-bit access regardless of the
+ * alignment of `buf`; only a trailing partial word is written byte by byte.
+ *
+ * @return The number of bytes consumed from `buf`.
+ */
+static inline size_t tx_fifo_push(const dif_spi_host_t *spi_host,
+                                  const uint8_t *buf, size_t len) {
+  if (len >= sizeof(uint32_t)) {
+    mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                        load_word(buf));
+    return sizeof(uint32_t);
   }
+  mmio_region_write8(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET, *buf);
+  return 1;
+}
 
-  // Clean up any leftover bytes.
-  while (len > 0) {
-    tx_fifo_write8(spi_host, ptr);
-    ptr += 1;
-    len -= 1;
+/**
+ * Reads one receive FIFO word into `buf`.
+ *
+ * The receive FIFO is always read as 32-bit words; if fewer than four bytes
+ * remain, the rest of the word is discarded.
+ *
+ * @return The number of bytes written to `buf`.
+ */
+static inline size_t rx_fifo_pop(const dif_spi_host_t *spi_host, uint8_t *buf,
+                                 size_t len) {
+  uint32_t val =
+      mmio_region_read32(spi_host->base_addr, SPI_HOST_RXDATA_REG_OFFSET);
+  if (len >= sizeof(uint32_t)) {
+    store_word(val, buf);
+    return sizeof(uint32_t);
   }
-
-  return kDifOk;
+  memcpy(buf, &val, len);
+  return len;
 }
 
-typedef struct queue {
-  int32_t length;
-  uint8_t alignas(uint64_t) data[8];
-} queue_t;
-
-static void enqueue_byte(queue_t *queue, uint8_t data) {
-  queue->data[queue->length++] = data;
-}
+dif_result_t dif_spi_host_fifo_write(const dif_spi_host_t *spi_host,
+                                     const void *src, uint16_t len) {
+  if (spi_host == NULL || (src == NULL && len > 0)) {
+    return kDifBadArg;
+  }
 
-static void enqueue_word(queue_t *queue, uint32_t data) {
-  if (queue->length % (int32_t)sizeof(uint32_t) == 0) {
-    write_32(data, queue->data + queue->length);
-    queue->length += 4;
-  } else {
-    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
-      enqueue_byte(queue, (uint8_t)data);
-      data >>= 8;
+  // Fill as many FIFO entries as are free for each status read.
+  const uint8_t *ptr = src;
+  size_t remaining = len;
+  while (remaining > 0) {
+    for (uint32_t space = wait_tx_fifo(spi_host); space > 0 && remaining > 0;
+         --space) {
+      size_t written = tx_fifo_push(spi_host, ptr, remaining);
+      ptr += written;
+      remaining -= written;
     }
   }
-}
 
-static uint8_t dequeue_byte(queue_t *queue) {
-  uint8_t val = queue->data[0];
-  uint64_t qword = read_64(queue->data);
-  write_64(qword >> 8, queue->data);
-  queue->length -= 1;
-  return val;
-}
-
-static uint32_t dequeue_word(queue_t *queue) {
-  uint32_t val = read_32(queue->data);
-  write_32(read_32(queue->data + sizeof(uint32_t)), queue->data);
-  queue->length -= 4;
-  return val;
+  return kDifOk;
 }
 
 dif_result_t dif_spi_host_fifo_read(const dif_spi_host_t *spi_host, void *dst,
@@ -236,48 +249,16 @@ dif_result_t dif_spi_host_fifo_read(const dif_spi_host_t *spi_host, void *dst,
     return kDifBadArg;
   }
 
-  uintptr_t ptr = (uintptr_t)dst;
-  // We always have to read from the RXFIFO as a 32-bit word.  We use a
-  // two-word queue to handle destination and length mis-alignments.
-  queue_t queue = {0};
-
-  // If the buffer is misaligned, write a byte at a time until we reach
-  // alignment.
-  while (misalignment32_of(ptr) && len > 0) {
-    if (queue.length < 1) {
-      wait_rx_fifo(spi_host);
-      enqueue_word(&queue, mmio_region_read32(spi_host->base_addr,
-                                              SPI_HOST_RXDATA_REG_OFFSET));
+  // Drain as many words as are available for each status read.
+  uint8_t *ptr = dst;
+  size_t remaining = len;
+  while (remaining > 0) {
+    for (uint32_t words = wait_rx_fifo(spi_host); words > 0 && remaining > 0;
+         --words) {
+      size_t read = rx_fifo_pop(spi_host, ptr, remaining);
+      ptr += read;
+      remaining -= read;
     }
-    uint8_t *p = (uint8_t *)ptr;
-    *p = dequeue_byte(&queue);
-    ptr += 1;
-    len -= 1;
-  }
-
-  // While we can write complete words to memory, operate on 4 bytes at a time.
-  while (len > 3) {
-    if (queue.length < 4) {
-      wait_rx_fifo(spi_host);
-      enqueue_word(&queue, mmio_region_read32(spi_host->base_addr,
-                                              SPI_HOST_RXDATA_REG_OFFSET));
-    }
-    write_32(dequeue_word(&queue), (void *)ptr);
-    ptr += 4;
-    len -= 4;
-  }
-
-  // Finish up any left over buffer a byte at a time.
-  while (len > 0) {
-    if (queue.length < 1) {
-      wait_rx_fifo(spi_host);
-      enqueue_word(&queue, mmio_region_read32(spi_host->base_addr,
-                                              SPI_HOST_RXDATA_REG_OFFSET));
-    }
-    uint8_t *p = (uint8_t *)ptr;
-    *p = dequeue_byte(&queue);
-    ptr += 1;
-    len -= 1;
   }
 
   return kDifOk;
@@ -305,22 +286,32 @@ static void issue_opcode(const dif_spi_host_t *spi_host,
                     last_segment);
 }
 
-static void issue_address(const dif_spi_host_t *spi_host,
-                          dif_spi_host_segment_t *segment, bool last_segment) {
-  wait_tx_fifo(spi_host);
+/**
+ * Returns the transmit FIFO word for an address segment.
+ *
+ * @param segment An address segment.
+ * @param[out] length The number of address bytes on the wire.
+ * @return The address in wire (big-endian) order.
+ */
+static uint32_t address_word(const dif_spi_host_segment_t *segment,
+                             uint16_t *length) {
   // The address appears on the wire in big-endian order.
   uint32_t address = bitfield_byteswap32(segment->address.address);
-  uint16_t length;
   if (segment->address.mode == kDifSpiHostAddrMode4b) {
-    length = 4;
-    mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
-                        address);
-  } else {
-    length = 3;
-    address >>= 8;
-    mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
-                        address);
+    *length = 4;
+    return address;
   }
+  *length = 3;
+  return address >> 8;
+}
+
+static void issue_address(const dif_spi_host_t *spi_host,
+                          dif_spi_host_segment_t *segment, bool last_segment) {
+  wait_tx_fifo(spi_host);
+  uint16_t length;
+  uint32_t address = address_word(segment, &length);
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                      address);
   write_command_reg(spi_host, length, segment->address.width,
                     kDifSpiHostDirectionTx, last_segment);
 }
@@ -438,6 +429,251 @@ dif_result_t dif_spi_host_transaction(const dif_spi_host_t *spi_host,
   return kDifOk;
 }
 
+/**
+ * Position of a pipelined transaction in the data of one FIFO.
+ */
+typedef struct spi_host_cursor {
+  /** Index of the segment whose data is being moved. */
+  size_t index;
+  /** Number of bytes of that segment already moved. */
+  size_t offset;
+} spi_host_cursor_t;
+
+/**
+ * Returns whether `segment` puts data in the transmit FIFO, and if so, the
+ * data phase buffer (NULL for opcodes, addresses and external buffers).
+ */
+static bool segment_tx_data(const dif_spi_host_segment_t *segment,
+                            const uint8_t **buf, size_t *len) {
+  *buf = NULL;
+  *len = 0;
+  switch (segment->type) {
+    case kDifSpiHostSegmentTypeOpcode:
+    case kDifSpiHostSegmentTypeAddress:
+      return true;
+    case kDifSpiHostSegmentTypeTx:
+      *buf = segment->tx.buf;
+      *len = segment->tx.length;
+      return true;
+    case kDifSpiHostSegmentTypeBidirectional:
+      *buf = segment->bidir.txbuf;
+      *len = segment->bidir.length;
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Returns whether `segment` puts data in the receive FIFO, and if so, the
+ * data phase buffer (NULL for external buffers).
+ */
+static bool segment_rx_data(const dif_spi_host_segment_t *segment,
+                            uint8_t **buf, size_t *len) {
+  *buf = NULL;
+  *len = 0;
+  switch (segment->type) {
+    case kDifSpiHostSegmentTypeRx:
+      *buf = segment->rx.buf;
+      *len = segment->rx.length;
+      return true;
+    case kDifSpiHostSegmentTypeBidirectional:
+      *buf = segment->bidir.rxbuf;
+      *len = segment->bidir.length;
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Checks that the segment list can be pipelined.
+ *
+ * A data phase with a NULL buffer is serviced by another agent (e.g. a DMA
+ * controller in hardware-handshake mode), which must see the FIFO contents of
+ * that segment only, so no later segment may use the same FIFO.
+ */
+static dif_result_t check_segments(const dif_spi_host_segment_t *segments,
+                                   size_t length) {
+  bool tx_external = false;
+  bool rx_external = false;
+  for (size_t i = 0; i < length; ++i) {
+    const dif_spi_host_segment_t *segment = &segments[i];
+    if (segment->type > kDifSpiHostSegmentTypeBidirectional) {
+      return kDifBadArg;
+    }
+    const uint8_t *txbuf;
+    uint8_t *rxbuf;
+    size_t len;
+    if (segment_tx_data(segment, &txbuf, &len)) {
+      if (tx_external) {
+        return kDifBadArg;
+      }
+      tx_external = len > 0 && txbuf == NULL;
+    }
+    if (segment_rx_data(segment, &rxbuf, &len)) {
+      if (rx_external) {
+        return kDifBadArg;
+      }
+      rx_external = len > 0 && rxbuf == NULL;
+    }
+  }
+  return kDifOk;
+}
+
+/**
+ * Writes the COMMAND register for `segment` without touching the FIFOs.
+ */
+static void issue_command(const dif_spi_host_t *spi_host,
+                          const dif_spi_host_segment_t *segment,
+                          bool last_segment) {
+  switch (segment->type) {
+    case kDifSpiHostSegmentTypeOpcode:
+      write_command_reg(spi_host, 1, segment->opcode.width,
+                        kDifSpiHostDirectionTx, last_segment);
+      break;
+    case kDifSpiHostSegmentTypeAddress: {
+      uint16_t length;
+      address_word(segment, &length);
+      write_command_reg(spi_host, length, segment->address.width,
+                        kDifSpiHostDirectionTx, last_segment);
+      break;
+    }
+    case kDifSpiHostSegmentTypeDummy:
+      // See `issue_dummy()`: a zero-length dummy segment is not programmed.
+      if (segment->dummy.length > 0) {
+        write_command_reg(spi_host, (uint16_t)segment->dummy.length,
+                          segment->dummy.width, kDifSpiHostDirectionDummy,
+                          last_segment);
+      }
+      break;
+    case kDifSpiHostSegmentTypeTx:
+      write_command_reg(spi_host, (uint16_t)segment->tx.length,
+                        segment->tx.width, kDifSpiHostDirectionTx,
+                        last_segment);
+      break;
+    case kDifSpiHostSegmentTypeRx:
+      write_command_reg(spi_host, (uint16_t)segment->rx.length,
+                        segment->rx.width, kDifSpiHostDirectionRx,
+                        last_segment);
+      break;
+    case kDifSpiHostSegmentTypeBidirectional:
+      write_command_reg(spi_host, (uint16_t)segment->bidir.length,
+                        segment->bidir.width, kDifSpiHostDirectionBidirectional,
+                        last_segment);
+      break;
+    default:
+      // Rejected by `check_segments()`.
+      break;
+  }
+}
+
+/**
+ * Fills up to `space` transmit FIFO entries from the segments at `cursor`.
+ */
+static void tx_advance(const dif_spi_host_t *spi_host,
+                       const dif_spi_host_segment_t *segments, size_t length,
+                       spi_host_cursor_t *cursor, uint32_t space) {
+  for (; cursor->index < length; cursor->index += 1, cursor->offset = 0) {
+    const dif_spi_host_segment_t *segment = &segments[cursor->index];
+    const uint8_t *buf;
+    size_t len;
+    if (!segment_tx_data(segment, &buf, &len)) {
+      continue;
+    }
+    if (space == 0) {
+      return;
+    }
+    switch (segment->type) {
+      case kDifSpiHostSegmentTypeOpcode:
+        mmio_region_write8(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                           segment->opcode.opcode);
+        space -= 1;
+        break;
+      case kDifSpiHostSegmentTypeAddress: {
+        uint16_t unused;
+        mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                            address_word(segment, &unused));
+        space -= 1;
+        break;
+      }
+      default:
+        // External buffers are left to their agent.
+        if (buf == NULL) {
+          break;
+        }
+        for (; space > 0 && cursor->offset < len; --space) {
+          cursor->offset += tx_fifo_push(spi_host, buf + cursor->offset,
+                                         len - cursor->offset);
+        }
+        if (cursor->offset < len) {
+          return;
+        }
+        break;
+    }
+  }
+}
+
+/**
+ * Drains up to `words` receive FIFO words into the segments at `cursor`.
+ */
+static void rx_advance(const dif_spi_host_t *spi_host,
+                       const dif_spi_host_segment_t *segments, size_t length,
+                       spi_host_cursor_t *cursor, uint32_t words) {
+  for (; cursor->index < length; cursor->index += 1, cursor->offset = 0) {
+    uint8_t *buf;
+    size_t len;
+    // External buffers are left to their agent.
+    if (!segment_rx_data(&segments[cursor->index], &buf, &len) ||
+        buf == NULL) {
+      continue;
+    }
+    for (; words > 0 && cursor->offset < len; --words) {
+      cursor->offset +=
+          rx_fifo_pop(spi_host, buf + cursor->offset, len - cursor->offset);
+    }
+    if (cursor->offset < len) {
+      return;
+    }
+  }
+}
+
+dif_result_t dif_spi_host_transaction_pipelined(
+    const dif_spi_host_t *spi_host, uint32_t csid,
+    const dif_spi_host_segment_t *segments, size_t length) {
+  if (spi_host == NULL || segments == NULL) {
+    return kDifBadArg;
+  }
+  DIF_RETURN_IF_ERROR(check_segments(segments, length));
+
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_CSID_REG_OFFSET, csid);
+
+  // Each status read can queue one command, fill the free transmit FIFO
+  // entries and drain the available receive FIFO words. Commands therefore
+  // run ahead of the data phases, and neither FIFO can stall the controller
+  // while the CPU is busy with the other one.
+  size_t next_command = 0;
+  spi_host_cursor_t tx = {0};
+  spi_host_cursor_t rx = {0};
+  while (next_command < length || tx.index < length || rx.index < length) {
+    uint32_t reg =
+        mmio_region_read32(spi_host->base_addr, SPI_HOST_STATUS_REG_OFFSET);
+    if (next_command < length &&
+        bitfield_bit32_read(reg, SPI_HOST_STATUS_READY_BIT)) {
+      issue_command(spi_host, &segments[next_command],
+                    next_command == length - 1);
+      next_command += 1;
+    }
+    uint32_t txqd = bitfield_field32_read(reg, SPI_HOST_STATUS_TXQD_FIELD);
+    uint32_t space =
+        txqd < SPI_HOST_PARAM_TX_DEPTH ? SPI_HOST_PARAM_TX_DEPTH - txqd : 0;
+    tx_advance(spi_host, segments, length, &tx, space);
+    rx_advance(spi_host, segments, length, &rx,
+               bitfield_field32_read(reg, SPI_HOST_STATUS_RXQD_FIELD));
+  }
+  return kDifOk;
+}
+
 dif_result_t dif_spi_host_event_set_enabled(const dif_spi_host_t *spi_host,
                                             dif_spi_host_events_t event,
                                             bool enable) {
@@ -228,6 +228,32 @@ dif_result_t dif_spi_host_transaction(const dif_spi_host_t *spi_host,
                                       dif_spi_host_segment_t *segments,
                                       size_t length);
 
+/**
+ * Runs a SPI Host transaction with the command queue kept ahead of the data.
+ *
+ * Unlike `dif_spi_host_transaction()`, which moves the data of each segment in
+ * turn, this queues each command as soon as the command FIFO has room and
+ * services both data FIFOs together, a batch of words per status read. This
+ * keeps the bus busy across segment boundaries and allows segments whose data
+ * exceeds the FIFO depths to be mixed freely.
+ *
+ * A `tx`, `rx` or `bidir` data buffer may be NULL, in which case the CPU does
+ * not touch the FIFO for that segment and another agent, e.g. a DMA
+ * controller in hardware-handshake mode, must move the data. Such a segment
+ * must be the last one to use its FIFO. The function returns once every
+ * command has been queued and all CPU-serviced data has been moved.
+ *
+ * @param spi_host A SPI Host handle.
+ * @param csid The chip-select ID of the SPI target.
+ * @param segments The SPI segments to send in this transaction.
+ * @param length The number of SPI segments in this transaction.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_host_transaction_pipelined(
+    const dif_spi_host_t *spi_host, uint32_t csid,
+    const dif_spi_host_segment_t *segments, size_t length);
+
 typedef enum dif_spi_host_events {
   /**
    * Enable IRQ to be fired when `STATUS.RXFULL` goes high.
@@ -468,7 +468,6 @@ TEST_F(FifoTest, AlignedWrite) {
 
   EXPECT_TXQD(0);
   EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 1);
-  EXPECT_TXQD(0);
   EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 2);
 
   EXPECT_DIF_OK(dif_spi_host_fifo_write(&spi_host_, buffer, sizeof(buffer)));
@@ -480,30 +479,34 @@ struct Aligned {
   uint8_t *get() { return &value[0]; }
 };
 
-// Checks that a misaligned source buffer is written as bytes into the
-// transmit FIFO until alignment is reached and then written as 32-bit words.
+// Checks that a misaligned source buffer is written as 32-bit words into the
+// transmit FIFO, with only the trailing partial word written as bytes.
 TEST_F(FifoTest, MisalignedWrite) {
   // We'll intentionally mis-align the buffer by 1 when calling
   // dif_spi_host_fifo_write.
-  Aligned<9, 4> buffer = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+  Aligned<10, 4> buffer = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
 
-  // Because of the misalignment, expect three byte writes.
-  EXPECT_TXQD(0);
-  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 1);
   EXPECT_TXQD(0);
-  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 2);
-  EXPECT_TXQD(0);
-  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 3);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x04030201);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x08070605);
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 9);
 
-  // Then a word write when we reach alignment.
-  EXPECT_TXQD(0);
-  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x07060504);
+  EXPECT_DIF_OK(dif_spi_host_fifo_write(&spi_host_, buffer.get() + 1, 9));
+}
 
-  // Then a byte write to finish the buffer.
-  EXPECT_TXQD(0);
-  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 8);
+// Checks that the transmit FIFO is filled up to its free space on each status
+// read.
+TEST_F(FifoTest, WriteWaitsForSpace) {
+  uint32_t buffer[] = {1, 2, 3};
 
-  EXPECT_DIF_OK(dif_spi_host_fifo_write(&spi_host_, buffer.get() + 1, 8));
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH - 1);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 1);
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH);
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH - 2);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 2);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 3);
+
+  EXPECT_DIF_OK(dif_spi_host_fifo_write(&spi_host_, buffer, sizeof(buffer)));
 }
 
 // Checks that an aligned destination buffer receives the contents of the
@@ -513,7 +516,6 @@ TEST_F(FifoTest, AlignedRead) {
 
   EXPECT_RXQD(2);
   EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 1);
-  EXPECT_RXQD(1);
   EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 2);
 
   EXPECT_DIF_OK(dif_spi_host_fifo_read(&spi_host_, buffer, sizeof(buffer)));
@@ -527,8 +529,9 @@ TEST_F(FifoTest, MisalignedRead) {
   // dif_spi_host_fifo_read.
   Aligned<9, 4> buffer{};
 
-  EXPECT_RXQD(2);
+  EXPECT_RXQD(1);
   EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x04030201);
+  EXPECT_RXQD(0);
   EXPECT_RXQD(1);
   EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x08070605);
 
@@ -536,6 +539,141 @@ TEST_F(FifoTest, MisalignedRead) {
   EXPECT_THAT(buffer.value, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8));
 }
 
+// Checks that the unused bytes of the last receive FIFO word are discarded.
+TEST_F(FifoTest, PartialRead) {
+  Aligned<6, 4> buffer{};
+
+  EXPECT_RXQD(2);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x04030201);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x08070605);
+
+  EXPECT_DIF_OK(dif_spi_host_fifo_read(&spi_host_, buffer.get(), 6));
+  EXPECT_THAT(buffer.value, ElementsAre(1, 2, 3, 4, 5, 6));
+}
+
+class PipelinedTest : public SpiHostTest {
+ protected:
+  void ExpectStatus(bool ready, uint32_t txqd, uint32_t rxqd) {
+    EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET,
+                  {
+                      {SPI_HOST_STATUS_READY_BIT, ready},
+                      {SPI_HOST_STATUS_TXQD_OFFSET, txqd},
+                      {SPI_HOST_STATUS_RXQD_OFFSET, rxqd},
+                  });
+  }
+};
+
+// Checks that a flash read queues all commands before draining the data.
+TEST_F(PipelinedTest, ReadOp) {
+  uint32_t buf[2];
+  dif_spi_host_segment_t segments[3];
+  segments[0].type = kDifSpiHostSegmentTypeOpcode;
+  segments[0].opcode = {.width = kDifSpiHostWidthStandard, .opcode = 0x03};
+  segments[1].type = kDifSpiHostSegmentTypeAddress;
+  segments[1].address = {.width = kDifSpiHostWidthStandard,
+                         .mode = kDifSpiHostAddrMode3b,
+                         .address = 0x112233};
+  segments[2].type = kDifSpiHostSegmentTypeRx;
+  segments[2].rx = {
+      .width = kDifSpiHostWidthQuad, .buf = buf, .length = sizeof(buf)};
+
+  EXPECT_WRITE32(SPI_HOST_CSID_REG_OFFSET, 1);
+  ExpectStatus(/*ready=*/true, /*txqd=*/0, /*rxqd=*/0);
+  EXPECT_COMMAND_REG(/*length=*/1, /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/false);
+  // The opcode and address are written to the FIFO in one batch.
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 0x03);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x332211);
+  ExpectStatus(/*ready=*/true, /*txqd=*/1, /*rxqd=*/0);
+  EXPECT_COMMAND_REG(/*length=*/3, /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/false);
+  ExpectStatus(/*ready=*/true, /*txqd=*/0, /*rxqd=*/0);
+  EXPECT_COMMAND_REG(/*length=*/sizeof(buf), /*width=*/kDifSpiHostWidthQuad,
+                     /*direction=*/kDifSpiHostDirectionRx, /*last=*/true);
+  ExpectStatus(/*ready=*/true, /*txqd=*/0, /*rxqd=*/2);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0xaaaaaaaa);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0xbbbbbbbb);
+
+  EXPECT_DIF_OK(dif_spi_host_transaction_pipelined(&spi_host_, 1, segments,
+                                                   ARRAYSIZE(segments)));
+  EXPECT_THAT(buf, ElementsAre(0xaaaaaaaa, 0xbbbbbbbb));
+}
+
+// Checks that receive data is drained while a later transmit segment is still
+// being written.
+TEST_F(PipelinedTest, InterleavedRxTx) {
+  uint32_t rxbuf[1];
+  uint32_t txbuf[2] = {0x11111111, 0x22222222};
+  dif_spi_host_segment_t segments[2];
+  segments[0].type = kDifSpiHostSegmentTypeRx;
+  segments[0].rx = {
+      .width = kDifSpiHostWidthStandard, .buf = rxbuf, .length = sizeof(rxbuf)};
+  segments[1].type = kDifSpiHostSegmentTypeTx;
+  segments[1].tx = {
+      .width = kDifSpiHostWidthStandard, .buf = txbuf, .length = sizeof(txbuf)};
+
+  EXPECT_WRITE32(SPI_HOST_CSID_REG_OFFSET, 0);
+  ExpectStatus(/*ready=*/true, /*txqd=*/SPI_HOST_PARAM_TX_DEPTH - 1,
+               /*rxqd=*/0);
+  EXPECT_COMMAND_REG(/*length=*/sizeof(rxbuf),
+                     /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionRx, /*last=*/false);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x11111111);
+  ExpectStatus(/*ready=*/false, /*txqd=*/SPI_HOST_PARAM_TX_DEPTH, /*rxqd=*/1);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x33333333);
+  ExpectStatus(/*ready=*/true, /*txqd=*/0, /*rxqd=*/0);
+  EXPECT_COMMAND_REG(/*length=*/sizeof(txbuf),
+                     /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/true);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x22222222);
+
+  EXPECT_DIF_OK(dif_spi_host_transaction_pipelined(&spi_host_, 0, segments,
+                                                   ARRAYSIZE(segments)));
+  EXPECT_THAT(rxbuf, ElementsAre(0x33333333));
+}
+
+// Checks that a data phase without a buffer is left to another agent.
+TEST_F(PipelinedTest, ExternalRx) {
+  dif_spi_host_segment_t segments[2];
+  segments[0].type = kDifSpiHostSegmentTypeOpcode;
+  segments[0].opcode = {.width = kDifSpiHostWidthStandard, .opcode = 0x0b};
+  segments[1].type = kDifSpiHostSegmentTypeRx;
+  segments[1].rx = {
+      .width = kDifSpiHostWidthStandard, .buf = nullptr, .length = 1024};
+
+  EXPECT_WRITE32(SPI_HOST_CSID_REG_OFFSET, 0);
+  ExpectStatus(/*ready=*/true, /*txqd=*/0, /*rxqd=*/0);
+  EXPECT_COMMAND_REG(/*length=*/1, /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/false);
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 0x0b);
+  ExpectStatus(/*ready=*/true, /*txqd=*/0, /*rxqd=*/4);
+  EXPECT_COMMAND_REG(/*length=*/1024, /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionRx, /*last=*/true);
+
+  EXPECT_DIF_OK(dif_spi_host_transaction_pipelined(&spi_host_, 0, segments,
+                                                   ARRAYSIZE(segments)));
+}
+
+// Checks that nothing may follow an externally serviced data phase in the
+// same FIFO.
+TEST_F(PipelinedTest, BadExternalOrder) {
+  uint8_t buf[4];
+  dif_spi_host_segment_t segments[2];
+  segments[0].type = kDifSpiHostSegmentTypeRx;
+  segments[0].rx = {
+      .width = kDifSpiHostWidthStandard, .buf = nullptr, .length = 4};
+  segments[1].type = kDifSpiHostSegmentTypeRx;
+  segments[1].rx = {
+      .width = kDifSpiHostWidthStandard, .buf = buf, .length = sizeof(buf)};
+
+  EXPECT_DIF_BADARG(dif_spi_host_transaction_pipelined(&spi_host_, 0, segments,
+                                                       ARRAYSIZE(segments)));
+  EXPECT_DIF_BADARG(
+      dif_spi_host_transaction_pipelined(nullptr, 0, segments, 1));
+  EXPECT_DIF_BADARG(
+      dif_spi_host_transaction_pipelined(&spi_host_, 0, nullptr, 1));
+}
+
 class EventEnableRegTest : public SpiHostTest {
  protected:
   static constexpr std::array<std::array<uint32_t, 2>, 6> kEventsMap{{
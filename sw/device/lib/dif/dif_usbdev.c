@@ -206,10 +206,42 @@ static uint32_t get_buffer_addr(uint8_t buffer_id, size_t offset) {
          (buffer_id * USBDEV_BUFFER_ENTRY_SIZE_BYTES) + offset;
 }
 
+/**
+ * Pops the entry at the front of the RX FIFO, which must not be empty.
+ */
+static void rx_fifo_pop(const dif_usbdev_t *usbdev,
+                        dif_usbdev_rx_packet_info_t *info,
+                        dif_usbdev_buffer_t *buffer) {
+  // Read fifo entry
+  const uint32_t fifo_entry =
+      mmio_region_read32(usbdev->base_addr, USBDEV_RXFIFO_REG_OFFSET);
+  // Init packet info
+  *info = (dif_usbdev_rx_packet_info_t){
+      .endpoint =
+          (uint8_t)bitfield_field32_read(fifo_entry, USBDEV_RXFIFO_EP_FIELD),
+      .is_setup = bitfield_bit32_read(fifo_entry, USBDEV_RXFIFO_SETUP_BIT),
+      .length =
+          (uint8_t)bitfield_field32_read(fifo_entry, USBDEV_RXFIFO_SIZE_FIELD),
+  };
+  // Init buffer struct
+  *buffer = (dif_usbdev_buffer_t){
+      .id = (uint8_t)bitfield_field32_read(fifo_entry,
+                                           USBDEV_RXFIFO_BUFFER_FIELD),
+      .offset = 0,
+      .remaining_bytes = info->length,
+      .type = kDifUsbdevBufferTypeRead,
+  };
+}
+
 /**
  * USBDEV DIF library functions.
  */
 
+extern uint32_t dif_usbdev_buffer_view_read32(
+    const dif_usbdev_buffer_view_t *view, size_t index);
+extern void dif_usbdev_buffer_view_write32(const dif_usbdev_buffer_view_t *view,
+                                           size_t index, uint32_t value);
+
 dif_result_t dif_usbdev_configure(const dif_usbdev_t *usbdev,
                                   dif_usbdev_buffer_pool_t *buffer_pool,
                                   dif_usbdev_config_t config) {
@@ -431,25 +463,30 @@ dif_result_t dif_usbdev_recv(const dif_usbdev_t *usbdev,
     return kDifUnavailable;
   }
 
-  // Read fifo entry
-  const uint32_t fifo_entry =
-      mmio_region_read32(usbdev->base_addr, USBDEV_RXFIFO_REG_OFFSET);
-  // Init packet info
-  *info = (dif_usbdev_rx_packet_info_t){
-      .endpoint =
-          (uint8_t)bitfield_field32_read(fifo_entry, USBDEV_RXFIFO_EP_FIELD),
-      .is_setup = bitfield_bit32_read(fifo_entry, USBDEV_RXFIFO_SETUP_BIT),
-      .length =
-          (uint8_t)bitfield_field32_read(fifo_entry, USBDEV_RXFIFO_SIZE_FIELD),
-  };
-  // Init buffer struct
-  *buffer = (dif_usbdev_buffer_t){
-      .id = (uint8_t)bitfield_field32_read(fifo_entry,
-                                           USBDEV_RXFIFO_BUFFER_FIELD),
-      .offset = 0,
-      .remaining_bytes = info->length,
-      .type = kDifUsbdevBufferTypeRead,
-  };
+  rx_fifo_pop(usbdev, info, buffer);
+  return kDifOk;
+}
+
+dif_result_t dif_usbdev_recv_batch(const dif_usbdev_t *usbdev,
+                                   dif_usbdev_rx_packet_info_t *packet_info,
+                                   dif_usbdev_buffer_t *buffers,
+                                   size_t max_packets, size_t *num_packets) {
+  if (usbdev == NULL || packet_info == NULL || buffers == NULL ||
+      num_packets == NULL) {
+    return kDifBadArg;
+  }
+
+  uint32_t fifo_status =
+      mmio_region_read32(usbdev->base_addr, USBDEV_USBSTAT_REG_OFFSET);
+  size_t depth =
+      bitfield_field32_read(fifo_status, USBDEV_USBSTAT_RX_DEPTH_FIELD);
+  if (depth > max_packets) {
+    depth = max_packets;
+  }
+  for (size_t i = 0; i < depth; ++i) {
+    rx_fifo_pop(usbdev, &packet_info[i], &buffers[i]);
+  }
+  *num_packets = depth;
 
   return kDifOk;
 }
@@ -577,6 +614,53 @@ dif_result_t dif_usbdev_buffer_write(const dif_usbdev_t *usbdev,
   return kDifOk;
 }
 
+dif_result_t dif_usbdev_buffer_view(const dif_usbdev_t *usbdev,
+                                    const dif_usbdev_buffer_t *buffer,
+                                    dif_usbdev_buffer_view_t *view) {
+  if (usbdev == NULL || buffer == NULL || view == NULL ||
+      (buffer->type != kDifUsbdevBufferTypeRead &&
+       buffer->type != kDifUsbdevBufferTypeWrite) ||
+      misalignment32_of(buffer->offset)) {
+    return kDifBadArg;
+  }
+
+  *view = (dif_usbdev_buffer_view_t){
+      .base_addr = usbdev->base_addr,
+      .offset = (ptrdiff_t)get_buffer_addr(buffer->id, buffer->offset),
+      .len = buffer->remaining_bytes,
+  };
+
+  return kDifOk;
+}
+
+dif_result_t dif_usbdev_buffer_advance(const dif_usbdev_t *usbdev,
+                                       dif_usbdev_buffer_pool_t *buffer_pool,
+                                       dif_usbdev_buffer_t *buffer,
+                                       size_t len) {
+  if (usbdev == NULL || buffer_pool == NULL || buffer == NULL ||
+      (buffer->type != kDifUsbdevBufferTypeRead &&
+       buffer->type != kDifUsbdevBufferTypeWrite) ||
+      len > buffer->remaining_bytes) {
+    return kDifBadArg;
+  }
+
+  buffer->offset += (uint8_t)len;
+  buffer->remaining_bytes -= (uint8_t)len;
+
+  // Write buffers are handed to the hardware by `dif_usbdev_send`; read
+  // buffers go back to the pool once fully consumed.
+  if (buffer->type == kDifUsbdevBufferTypeWrite ||
+      buffer->remaining_bytes > 0) {
+    return kDifOk;
+  }
+
+  if (!buffer_pool_add(buffer_pool, buffer->id)) {
+    return kDifError;
+  }
+  buffer->type = kDifUsbdevBufferTypeStale;
+  return kDifOk;
+}
+
 dif_result_t dif_usbdev_send(const dif_usbdev_t *usbdev, uint8_t endpoint,
                              dif_usbdev_buffer_t *buffer) {
   if (usbdev == NULL || !is_valid_endpoint(endpoint) || buffer == NULL ||
@@ -649,6 +733,36 @@ dif_result_t dif_usbdev_clear_tx_status(const dif_usbdev_t *usbdev,
   return kDifOk;
 }
 
+dif_result_t dif_usbdev_clear_tx_status_batch(
+    const dif_usbdev_t *usbdev, dif_usbdev_buffer_pool_t *buffer_pool,
+    uint16_t endpoints) {
+  if (usbdev == NULL || buffer_pool == NULL ||
+      (endpoints >> USBDEV_NUM_ENDPOINTS) != 0) {
+    return kDifBadArg;
+  }
+
+  for (uint8_t endpoint = 0; endpoint < USBDEV_NUM_ENDPOINTS; ++endpoint) {
+    if (!bitfield_bit32_read(endpoints, endpoint)) {
+      continue;
+    }
+    uint32_t config_in_reg_offset =
+        kEndpointHwInfos[endpoint].config_in_reg_offset;
+    uint32_t config_in_reg_val =
+        mmio_region_read32(usbdev->base_addr, (ptrdiff_t)config_in_reg_offset);
+    uint8_t buffer = (uint8_t)bitfield_field32_read(
+        config_in_reg_val, USBDEV_CONFIGIN_0_BUFFER_0_FIELD);
+
+    mmio_region_write32(usbdev->base_addr, (ptrdiff_t)config_in_reg_offset,
+                        1u << USBDEV_CONFIGIN_0_PEND_0_BIT);
+    if (!buffer_pool_add(buffer_pool, buffer)) {
+      return kDifError;
+    }
+  }
+  // Clear all of the IN_SENT bits (rw1c) at once.
+  mmio_region_write32(usbdev->base_addr, USBDEV_IN_SENT_REG_OFFSET, endpoints);
+  return kDifOk;
+}
+
 dif_result_t dif_usbdev_get_tx_status(const dif_usbdev_t *usbdev,
                                       uint8_t endpoint,
                                       dif_usbdev_tx_status_t *status) {
@@ -370,6 +370,27 @@ dif_result_t dif_usbdev_recv(const dif_usbdev_t *usbdev,
                              dif_usbdev_rx_packet_info_t *packet_info,
                              dif_usbdev_buffer_t *buffer);
 
+/**
+ * Get up to `max_packets` packets from the front of the RX FIFO.
+ *
+ * This is equivalent to calling `dif_usbdev_recv` until the RX FIFO is empty
+ * or `max_packets` packets have been received, but reads the FIFO status only
+ * once.
+ *
+ * @param usbdev A USB device.
+ * @param[out] packet_info Packet information, one entry per packet.
+ * @param[out] buffers Buffers that hold the packet payloads.
+ * @param max_packets Capacity of `packet_info` and `buffers`.
+ * @param[out] num_packets Number of packets received; zero if the RX FIFO was
+ *                         empty.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_usbdev_recv_batch(const dif_usbdev_t *usbdev,
+                                   dif_usbdev_rx_packet_info_t *packet_info,
+                                   dif_usbdev_buffer_t *buffers,
+                                   size_t max_packets, size_t *num_packets);
+
 /**
  * Read incoming packet payload.
  *
@@ -481,6 +502,102 @@ dif_result_t dif_usbdev_buffer_write(const dif_usbdev_t *usbdev,
                                      const uint8_t *src, size_t src_len,
                                      size_t *bytes_written);
 
+/**
+ * A word-aligned view of the payload in a USB device buffer.
+ *
+ * The packet buffer is memory-mapped, so callers that generate or check
+ * payloads word by word can work on it in place with
+ * `dif_usbdev_buffer_view_read32` and `dif_usbdev_buffer_view_write32`,
+ * instead of staging packets in RAM and copying them with
+ * `dif_usbdev_buffer_read` / `dif_usbdev_buffer_write`.
+ *
+ * The packet buffer only supports 32-bit accesses. When writing, bytes beyond
+ * the packet length in the final word are ignored by the hardware.
+ */
+typedef struct dif_usbdev_buffer_view {
+  /**
+   * Register region of the USB device.
+   */
+  mmio_region_t base_addr;
+  /**
+   * Offset of the first word of the view from `base_addr`.
+   */
+  ptrdiff_t offset;
+  /**
+   * For read buffers: number of payload bytes not yet consumed.
+   * For write buffers: number of bytes that can still be written.
+   */
+  size_t len;
+} dif_usbdev_buffer_view_t;
+
+/**
+ * Get a view of the unconsumed part of a buffer.
+ *
+ * The view starts at the current offset of `buffer`, which must be a multiple
+ * of four bytes. Once done with the view, clients should call
+ * `dif_usbdev_buffer_advance` to record how many bytes they read or wrote.
+ *
+ * @param usbdev A USB device.
+ * @param buffer A buffer provided by `dif_usbdev_recv` or
+ *               `dif_usbdev_buffer_request`.
+ * @param[out] view View of the buffer.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_usbdev_buffer_view(const dif_usbdev_t *usbdev,
+                                    const dif_usbdev_buffer_t *buffer,
+                                    dif_usbdev_buffer_view_t *view);
+
+/**
+ * Read a word of a buffer view.
+ *
+ * @param view A buffer view.
+ * @param index Index of the word within the view.
+ * @return The word.
+ */
+inline uint32_t dif_usbdev_buffer_view_read32(
+    const dif_usbdev_buffer_view_t *view, size_t index) {
+  return mmio_region_read32(
+      view->base_addr,
+      view->offset + (ptrdiff_t)(index * sizeof(uint32_t)));
+}
+
+/**
+ * Write a word of a buffer view.
+ *
+ * @param view A buffer view.
+ * @param index Index of the word within the view.
+ * @param value The word.
+ */
+inline void dif_usbdev_buffer_view_write32(const dif_usbdev_buffer_view_t *view,
+                                           size_t index, uint32_t value) {
+  mmio_region_write32(view->base_addr,
+                      view->offset + (ptrdiff_t)(index * sizeof(uint32_t)),
+                      value);
+}
+
+/**
+ * Consume bytes of a buffer that were accessed through a view.
+ *
+ * For read buffers this behaves like `dif_usbdev_buffer_read` without the
+ * copy: the buffer is returned to the free buffer pool once the entire packet
+ * payload has been consumed. For write buffers, this extends the payload that
+ * `dif_usbdev_send` will transmit.
+ *
+ * See also: `dif_usbdev_buffer_view`.
+ *
+ * @param usbdev A USB device.
+ * @param buffer_pool A USB device buffer pool.
+ * @param buffer A buffer provided by `dif_usbdev_recv` or
+ *               `dif_usbdev_buffer_request`.
+ * @param len Number of bytes read from or written to the buffer.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_usbdev_buffer_advance(const dif_usbdev_t *usbdev,
+                                       dif_usbdev_buffer_pool_t *buffer_pool,
+                                       dif_usbdev_buffer_t *buffer, size_t len);
+
 /**
  * Mark a packet ready for transmission from an endpoint.
  *
@@ -550,6 +667,25 @@ dif_result_t dif_usbdev_clear_tx_status(const dif_usbdev_t *usbdev,
                                         dif_usbdev_buffer_pool_t *buffer_pool,
                                         uint8_t endpoint);
 
+/**
+ * Clear the TX state of several endpoints and restore their buffers to the
+ * pool.
+ *
+ * This is equivalent to calling `dif_usbdev_clear_tx_status` for each endpoint
+ * in `endpoints`, but acknowledges all of them with a single write, so it is
+ * the cheaper way to retire the set of endpoints reported by
+ * `dif_usbdev_get_tx_sent`. The same restrictions apply.
+ *
+ * @param usbdev A USB device.
+ * @param buffer_pool A USB device buffer pool.
+ * @param endpoints A bitmap of IN endpoint numbers.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_usbdev_clear_tx_status_batch(
+    const dif_usbdev_t *usbdev, dif_usbdev_buffer_pool_t *buffer_pool,
+    uint16_t endpoints);
+
 /**
  * Status of an outgoing packet.
  */
@@ -90,6 +90,24 @@ TEST_F(UsbdevTest, NullArgsTest) {
                                             /*src_len=*/1, &size_arg));
   EXPECT_DIF_BADARG(dif_usbdev_buffer_write(&usbdev_, &buffer, &uint8_arg,
                                             /*src_len=*/1, nullptr));
+  dif_usbdev_buffer_view_t view;
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_view(nullptr, &buffer, &view));
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_view(&usbdev_, nullptr, &view));
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_view(&usbdev_, &buffer, nullptr));
+  EXPECT_DIF_BADARG(
+      dif_usbdev_buffer_advance(nullptr, &buffer_pool, &buffer, /*len=*/0));
+  EXPECT_DIF_BADARG(
+      dif_usbdev_buffer_advance(&usbdev_, nullptr, &buffer, /*len=*/0));
+  EXPECT_DIF_BADARG(
+      dif_usbdev_buffer_advance(&usbdev_, &buffer_pool, nullptr, /*len=*/0));
+  EXPECT_DIF_BADARG(dif_usbdev_recv_batch(nullptr, &packet_info, &buffer,
+                                          /*max_packets=*/1, &size_arg));
+  EXPECT_DIF_BADARG(dif_usbdev_recv_batch(&usbdev_, nullptr, &buffer,
+                                          /*max_packets=*/1, &size_arg));
+  EXPECT_DIF_BADARG(dif_usbdev_recv_batch(&usbdev_, &packet_info, nullptr,
+                                          /*max_packets=*/1, &size_arg));
+  EXPECT_DIF_BADARG(dif_usbdev_recv_batch(&usbdev_, &packet_info, &buffer,
+                                          /*max_packets=*/1, nullptr));
   EXPECT_DIF_BADARG(dif_usbdev_send(nullptr, /*endpoint=*/0, &buffer));
   EXPECT_DIF_BADARG(dif_usbdev_send(&usbdev_, /*endpoint=*/0, nullptr));
   EXPECT_DIF_BADARG(dif_usbdev_get_tx_sent(nullptr, &uint16_arg));
@@ -98,6 +116,10 @@ TEST_F(UsbdevTest, NullArgsTest) {
       dif_usbdev_clear_tx_status(nullptr, &buffer_pool, /*endpoint=*/0));
   EXPECT_DIF_BADARG(
       dif_usbdev_clear_tx_status(&usbdev_, nullptr, /*endpoint=*/0));
+  EXPECT_DIF_BADARG(dif_usbdev_clear_tx_status_batch(nullptr, &buffer_pool,
+                                                     /*endpoints=*/1));
+  EXPECT_DIF_BADARG(
+      dif_usbdev_clear_tx_status_batch(&usbdev_, nullptr, /*endpoints=*/1));
   EXPECT_DIF_BADARG(
       dif_usbdev_get_tx_status(nullptr, /*endpoint=*/0, &tx_status));
   EXPECT_DIF_BADARG(
@@ -818,6 +840,152 @@ TEST_F(UsbdevTest, InPacket) {
       dif_usbdev_clear_tx_status(&usbdev_, &buffer_pool, /*endpoint=*/5));
 }
 
+TEST_F(UsbdevTest, BufferView) {
+  dif_usbdev_buffer_pool_t buffer_pool;
+  dif_usbdev_config_t phy_config = {
+      .have_differential_receiver = kDifToggleEnabled,
+      .use_tx_d_se0 = kDifToggleDisabled,
+      .single_bit_eop = kDifToggleDisabled,
+      .pin_flip = kDifToggleDisabled,
+      .clock_sync_signals = kDifToggleEnabled,
+  };
+  EXPECT_WRITE32(USBDEV_PHY_CONFIG_REG_OFFSET,
+                 {
+                     {USBDEV_PHY_CONFIG_USE_DIFF_RCVR_BIT, 1},
+                     {USBDEV_PHY_CONFIG_TX_USE_D_SE0_BIT, 0},
+                     {USBDEV_PHY_CONFIG_EOP_SINGLE_BIT_BIT, 0},
+                     {USBDEV_PHY_CONFIG_PINFLIP_BIT, 0},
+                     {USBDEV_PHY_CONFIG_USB_REF_DISABLE_BIT, 0},
+                 });
+  EXPECT_DIF_OK(dif_usbdev_configure(&usbdev_, &buffer_pool, phy_config));
+  int8_t top = buffer_pool.top;
+
+  // Write a packet in place, in two parts.
+  dif_usbdev_buffer_t buffer;
+  dif_usbdev_buffer_view_t view;
+  EXPECT_DIF_OK(dif_usbdev_buffer_request(&usbdev_, &buffer_pool, &buffer));
+  EXPECT_DIF_OK(dif_usbdev_buffer_view(&usbdev_, &buffer, &view));
+  EXPECT_EQ(view.len, 64);
+  EXPECT_WRITE32(USBDEV_BUFFER_REG_OFFSET + buffer.id * 64, 0x03020100);
+  dif_usbdev_buffer_view_write32(&view, 0, 0x03020100);
+  EXPECT_DIF_OK(
+      dif_usbdev_buffer_advance(&usbdev_, &buffer_pool, &buffer, /*len=*/4));
+  EXPECT_DIF_OK(dif_usbdev_buffer_view(&usbdev_, &buffer, &view));
+  EXPECT_EQ(view.len, 60);
+  EXPECT_WRITE32(USBDEV_BUFFER_REG_OFFSET + buffer.id * 64 + 4, 0x0504);
+  dif_usbdev_buffer_view_write32(&view, 0, 0x0504);
+  EXPECT_DIF_OK(
+      dif_usbdev_buffer_advance(&usbdev_, &buffer_pool, &buffer, /*len=*/2));
+  EXPECT_EQ(buffer.offset, 6);
+  EXPECT_EQ(buffer.type, kDifUsbdevBufferTypeWrite);
+  // Views must start on a word boundary.
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_view(&usbdev_, &buffer, &view));
+  // Cannot advance past the end of the buffer.
+  EXPECT_DIF_BADARG(
+      dif_usbdev_buffer_advance(&usbdev_, &buffer_pool, &buffer, /*len=*/59));
+  EXPECT_DIF_OK(dif_usbdev_buffer_return(&usbdev_, &buffer_pool, &buffer));
+  EXPECT_EQ(buffer_pool.top, top);
+
+  // Receive two packets with one status read, and check one in place. Take
+  // a buffer from the pool to stand in for the one handed to the hardware.
+  EXPECT_DIF_OK(dif_usbdev_buffer_request(&usbdev_, &buffer_pool, &buffer));
+  top = buffer_pool.top;
+  dif_usbdev_rx_packet_info_t packet_info[3];
+  dif_usbdev_buffer_t buffers[3];
+  size_t num_packets;
+  EXPECT_READ32(USBDEV_USBSTAT_REG_OFFSET, {{USBDEV_USBSTAT_RX_DEPTH_OFFSET, 2},
+                                            {USBDEV_USBSTAT_RX_EMPTY_BIT, 0}});
+  EXPECT_READ32(USBDEV_RXFIFO_REG_OFFSET, {{USBDEV_RXFIFO_EP_OFFSET, 1},
+                                           {USBDEV_RXFIFO_SIZE_OFFSET, 6},
+                                           {USBDEV_RXFIFO_BUFFER_OFFSET, 3}});
+  EXPECT_READ32(USBDEV_RXFIFO_REG_OFFSET, {{USBDEV_RXFIFO_EP_OFFSET, 2},
+                                           {USBDEV_RXFIFO_SETUP_BIT, 1},
+                                           {USBDEV_RXFIFO_SIZE_OFFSET, 8},
+                                           {USBDEV_RXFIFO_BUFFER_OFFSET, 4}});
+  EXPECT_DIF_OK(dif_usbdev_recv_batch(&usbdev_, packet_info, buffers,
+                                      ARRAYSIZE(buffers), &num_packets));
+  EXPECT_EQ(num_packets, 2);
+  EXPECT_EQ(packet_info[0].endpoint, 1);
+  EXPECT_EQ(packet_info[0].length, 6);
+  EXPECT_FALSE(packet_info[0].is_setup);
+  EXPECT_EQ(buffers[0].id, 3);
+  EXPECT_EQ(packet_info[1].endpoint, 2);
+  EXPECT_EQ(packet_info[1].length, 8);
+  EXPECT_TRUE(packet_info[1].is_setup);
+  EXPECT_EQ(buffers[1].id, 4);
+  EXPECT_EQ(buffers[1].type, kDifUsbdevBufferTypeRead);
+
+  EXPECT_DIF_OK(dif_usbdev_buffer_view(&usbdev_, &buffers[0], &view));
+  EXPECT_EQ(view.len, 6);
+  EXPECT_READ32(USBDEV_BUFFER_REG_OFFSET + 3 * 64 + 4, 0x0504);
+  EXPECT_EQ(dif_usbdev_buffer_view_read32(&view, 1), 0x0504);
+  EXPECT_DIF_OK(
+      dif_usbdev_buffer_advance(&usbdev_, &buffer_pool, &buffers[0], 6));
+  // Fully consumed read buffers go back to the pool.
+  EXPECT_EQ(buffers[0].type, kDifUsbdevBufferTypeStale);
+  EXPECT_EQ(buffer_pool.top, top + 1);
+  EXPECT_EQ(buffer_pool.buffers[buffer_pool.top], 3);
+
+  // The batch is limited by the caller's capacity.
+  EXPECT_READ32(USBDEV_USBSTAT_REG_OFFSET,
+                {{USBDEV_USBSTAT_RX_DEPTH_OFFSET, 5}});
+  EXPECT_READ32(USBDEV_RXFIFO_REG_OFFSET, {{USBDEV_RXFIFO_BUFFER_OFFSET, 5}});
+  EXPECT_DIF_OK(dif_usbdev_recv_batch(&usbdev_, packet_info, buffers,
+                                      /*max_packets=*/1, &num_packets));
+  EXPECT_EQ(num_packets, 1);
+
+  // An empty RX FIFO yields no packets.
+  EXPECT_READ32(USBDEV_USBSTAT_REG_OFFSET, {{USBDEV_USBSTAT_RX_EMPTY_BIT, 1}});
+  EXPECT_DIF_OK(dif_usbdev_recv_batch(&usbdev_, packet_info, buffers,
+                                      ARRAYSIZE(buffers), &num_packets));
+  EXPECT_EQ(num_packets, 0);
+}
+
+TEST_F(UsbdevTest, ClearTxStatusBatch) {
+  dif_usbdev_buffer_pool_t buffer_pool;
+  dif_usbdev_config_t phy_config = {
+      .have_differential_receiver = kDifToggleEnabled,
+      .use_tx_d_se0 = kDifToggleDisabled,
+      .single_bit_eop = kDifToggleDisabled,
+      .pin_flip = kDifToggleDisabled,
+      .clock_sync_signals = kDifToggleEnabled,
+  };
+  EXPECT_WRITE32(USBDEV_PHY_CONFIG_REG_OFFSET,
+                 {
+                     {USBDEV_PHY_CONFIG_USE_DIFF_RCVR_BIT, 1},
+                     {USBDEV_PHY_CONFIG_TX_USE_D_SE0_BIT, 0},
+                     {USBDEV_PHY_CONFIG_EOP_SINGLE_BIT_BIT, 0},
+                     {USBDEV_PHY_CONFIG_PINFLIP_BIT, 0},
+                     {USBDEV_PHY_CONFIG_USB_REF_DISABLE_BIT, 0},
+                 });
+  EXPECT_DIF_OK(dif_usbdev_configure(&usbdev_, &buffer_pool, phy_config));
+
+  dif_usbdev_buffer_t buffer_a, buffer_b;
+  EXPECT_DIF_OK(dif_usbdev_buffer_request(&usbdev_, &buffer_pool, &buffer_a));
+  EXPECT_DIF_OK(dif_usbdev_buffer_request(&usbdev_, &buffer_pool, &buffer_b));
+  int8_t top = buffer_pool.top;
+
+  EXPECT_READ32(USBDEV_CONFIGIN_3_REG_OFFSET,
+                {{USBDEV_CONFIGIN_3_BUFFER_3_OFFSET, buffer_a.id}});
+  EXPECT_WRITE32(USBDEV_CONFIGIN_3_REG_OFFSET,
+                 {{USBDEV_CONFIGIN_3_PEND_3_BIT, 1}});
+  EXPECT_READ32(USBDEV_CONFIGIN_5_REG_OFFSET,
+                {{USBDEV_CONFIGIN_5_BUFFER_5_OFFSET, buffer_b.id}});
+  EXPECT_WRITE32(USBDEV_CONFIGIN_5_REG_OFFSET,
+                 {{USBDEV_CONFIGIN_5_PEND_5_BIT, 1}});
+  EXPECT_WRITE32(USBDEV_IN_SENT_REG_OFFSET, {{USBDEV_IN_SENT_SENT_3_BIT, 1},
+                                             {USBDEV_IN_SENT_SENT_5_BIT, 1}});
+  EXPECT_DIF_OK(dif_usbdev_clear_tx_status_batch(&usbdev_, &buffer_pool,
+                                                 (1u << 3) | (1u << 5)));
+  EXPECT_EQ(buffer_pool.top, top + 2);
+  EXPECT_EQ(buffer_pool.buffers[top + 1], buffer_a.id);
+  EXPECT_EQ(buffer_pool.buffers[top + 2], buffer_b.id);
+
+  // Endpoints beyond the last one are rejected.
+  EXPECT_DIF_BADARG(dif_usbdev_clear_tx_status_batch(
+      &usbdev_, &buffer_pool, 1u << USBDEV_NUM_ENDPOINTS));
+}
+
 TEST_F(UsbdevTest, DeviceAddresses) {
   uint8_t address = 101;
   EXPECT_READ32(USBDEV_USBCTRL_REG_OFFSET,
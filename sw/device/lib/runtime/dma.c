@@ -0,0 +1,301 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/runtime/dma.h"
+
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/memory.h"
+
+#define MODULE_ID MAKE_MODULE_ID('d', 'm', 's')
+
+enum {
+  kDmaSha256DigestWords = 8,
+};
+
+/**
+ * DMA engine, or NULL if operations run on the CPU.
+ */
+static const dif_dma_t *dma_dev;
+
+/**
+ * SHA2-256 fallback for buffers the DMA engine cannot hash.
+ */
+static dma_sha256_fn_t sha256_fallback;
+
+/**
+ * The operation whose transfer is currently programmed into the DMA engine.
+ */
+static dma_op_t *volatile in_flight;
+
+static bool is_word_aligned(uintptr_t value) {
+  return (value & (sizeof(uint32_t) - 1)) == 0;
+}
+
+static bool entry_is_word_aligned(const dma_sg_entry_t *entry) {
+  return is_word_aligned((uintptr_t)entry->dest) &&
+         is_word_aligned((uintptr_t)entry->src) && is_word_aligned(entry->len);
+}
+
+/**
+ * Clears the DMA status bits.
+ *
+ * The DMA interrupts are status-type interrupts that follow the `done`,
+ * `chunk_done` and `error` bits, so this also acknowledges them.
+ */
+static status_t clear_status(void) {
+  TRY(dif_dma_status_write(dma_dev, kDifDmaStatusDone | kDifDmaStatusAborted |
+                                        kDifDmaStatusError |
+                                        kDifDmaStatusChunkDone));
+  return OK_STATUS();
+}
+
+/**
+ * Drops zero-length entries from the front of `op`, which the hardware
+ * rejects.
+ */
+static void skip_empty_entries(dma_op_t *op) {
+  while (op->count > 0 && op->entries->len == 0) {
+    ++op->entries;
+    --op->count;
+  }
+}
+
+/**
+ * Marks `op` as complete and runs its callback.
+ */
+static status_t complete(dma_op_t *op, status_t result) {
+  if (in_flight == op) {
+    in_flight = NULL;
+  }
+  op->result = result;
+  op->done = true;
+  if (op->callback != NULL) {
+    op->callback(op->ctx, result);
+  }
+  return result;
+}
+
+/**
+ * Runs all remaining entries of `op` on the CPU.
+ */
+static status_t run_on_cpu(dma_op_t *op) {
+  for (; op->count > 0; ++op->entries, --op->count) {
+    memcpy(op->entries->dest, op->entries->src, op->entries->len);
+  }
+  if (op->digest != NULL) {
+    if (sha256_fallback == NULL) {
+      return FAILED_PRECONDITION();
+    }
+    // Hash the destination: with a single entry it holds the same bytes as
+    // the source, and it is what the caller will go on to use.
+    TRY(sha256_fallback((const uint8_t *)op->single.dest, op->single.len,
+                        op->digest));
+  }
+  return OK_STATUS();
+}
+
+/**
+ * Programs and starts the transfer for the first remaining entry of `op`.
+ */
+static status_t start_entry(dma_op_t *op) {
+  const dma_sg_entry_t *entry = op->entries;
+  bool from_fifo = op->handshake != 0;
+  dif_dma_transaction_t transaction = {
+      .source = {.address = (uintptr_t)entry->src,
+                 .asid = kDifDmaOpentitanInternalBus},
+      .destination = {.address = (uintptr_t)entry->dest,
+                      .asid = kDifDmaOpentitanInternalBus},
+      // A FIFO is read from the same address for every word.
+      .src_config = {.wrap = from_fifo, .increment = !from_fifo},
+      .dst_config = {.wrap = false, .increment = true},
+      .total_size = entry->len,
+      .chunk_size = from_fifo ? op->chunk_size : entry->len,
+      .width = entry_is_word_aligned(entry) ? kDifDmaTransWidth4Bytes
+                                            : kDifDmaTransWidth1Byte,
+  };
+  TRY(clear_status());
+  if (from_fifo) {
+    TRY(dif_dma_handshake_irq_enable(dma_dev, op->handshake));
+    TRY(dif_dma_configure(dma_dev, transaction));
+    TRY(dif_dma_handshake_enable(dma_dev));
+  } else {
+    TRY(dif_dma_handshake_disable(dma_dev));
+    TRY(dif_dma_configure(dma_dev, transaction));
+  }
+  TRY(dif_dma_start(dma_dev, op->digest != NULL ? kDifDmaSha256Opcode
+                                                : kDifDmaCopyOpcode));
+  return OK_STATUS();
+}
+
+/**
+ * Starts `op`, either on the DMA engine or, if that is not possible, on the
+ * CPU.
+ */
+static status_t start(dma_op_t *op, bool use_dma) {
+  if (in_flight != NULL) {
+    return UNAVAILABLE();
+  }
+  op->done = false;
+  op->result = OK_STATUS();
+
+  // A zero-length hash still has to produce the digest of the empty message,
+  // which the CPU fallback does.
+  if (op->digest == NULL) {
+    skip_empty_entries(op);
+  }
+  if (!use_dma || dma_dev == NULL || op->count == 0 ||
+      op->entries->len == 0) {
+    return complete(op, run_on_cpu(op));
+  }
+
+  in_flight = op;
+  status_t result = start_entry(op);
+  if (!status_ok(result)) {
+    return complete(op, result);
+  }
+  return OK_STATUS();
+}
+
+status_t dma_service_init(const dif_dma_t *dma, dma_sha256_fn_t sha256) {
+  if (in_flight != NULL) {
+    return FAILED_PRECONDITION();
+  }
+  dma_dev = dma;
+  sha256_fallback = sha256;
+  if (dma_dev != NULL) {
+    TRY(clear_status());
+  }
+  return OK_STATUS();
+}
+
+status_t dma_memcpy(dma_op_t *op, void *dest, const void *src, size_t len) {
+  op->single = (dma_sg_entry_t){.dest = dest, .src = src, .len = len};
+  op->entries = &op->single;
+  op->count = 1;
+  op->digest = NULL;
+  op->handshake = 0;
+  return start(op, /*use_dma=*/true);
+}
+
+status_t dma_memcpy_and_sha256(dma_op_t *op, void *dest, const void *src,
+                               size_t len, uint32_t digest[8]) {
+  op->single = (dma_sg_entry_t){.dest = dest, .src = src, .len = len};
+  op->entries = &op->single;
+  op->count = 1;
+  op->digest = digest;
+  op->handshake = 0;
+  // Inline hashing only supports 32-bit transfers.
+  return start(op, entry_is_word_aligned(&op->single));
+}
+
+status_t dma_memcpy_sg(dma_op_t *op, const dma_sg_entry_t *entries,
+                       size_t count) {
+  op->single = (dma_sg_entry_t){0};
+  op->entries = entries;
+  op->count = count;
+  op->digest = NULL;
+  op->handshake = 0;
+  return start(op, /*use_dma=*/true);
+}
+
+status_t dma_fifo_read(dma_op_t *op, void *dest, uintptr_t fifo, size_t len,
+                       size_t chunk_size, uint32_t trigger) {
+  // There is no CPU fallback: only the DMA engine can follow the handshake.
+  if (dma_dev == NULL) {
+    return FAILED_PRECONDITION();
+  }
+  if (len == 0 || chunk_size == 0 || trigger == 0 ||
+      !is_word_aligned((uintptr_t)dest) || !is_word_aligned(chunk_size) ||
+      len % chunk_size != 0) {
+    return INVALID_ARGUMENT();
+  }
+  op->single =
+      (dma_sg_entry_t){.dest = dest, .src = (const void *)fifo, .len = len};
+  op->entries = &op->single;
+  op->count = 1;
+  op->digest = NULL;
+  op->handshake = trigger;
+  op->chunk_size = chunk_size;
+  return start(op, /*use_dma=*/true);
+}
+
+/**
+ * Checks the DMA status and, if the current entry is finished, starts the next
+ * one or completes `op`.
+ */
+static status_t advance(dma_op_t *op) {
+  dif_dma_status_t status;
+  TRY(dif_dma_status_get(dma_dev, &status));
+  if (status & kDifDmaStatusError) {
+    dif_dma_error_code_t error;
+    TRY(dif_dma_error_code_get(dma_dev, &error));
+    TRY(clear_status());
+    return INTERNAL((int32_t)error);
+  }
+  if (!(status & kDifDmaStatusDone)) {
+    return OK_STATUS();
+  }
+  if (op->digest != NULL) {
+    // The digest is written shortly after `done` is set. Wait for it rather
+    // than return: the interrupt stays asserted until `done` is cleared, so
+    // returning from `dma_service_irq()` would only re-enter it.
+    if (!(status & kDifDmaStatusSha2DigestValid)) {
+      TRY(dif_dma_status_poll(dma_dev, kDifDmaStatusSha2DigestValid));
+    }
+    TRY(dif_dma_sha2_digest_get(dma_dev, kDifDmaSha256Opcode, op->digest));
+    // The digest registers hold the SHA2-256 state words; swap them so the
+    // digest reads as the standard byte string, as the HMAC driver does.
+    for (size_t i = 0; i < kDmaSha256DigestWords; ++i) {
+      op->digest[i] = bitfield_byteswap32(op->digest[i]);
+    }
+  }
+
+  TRY(clear_status());
+  ++op->entries;
+  --op->count;
+  skip_empty_entries(op);
+  if (op->count > 0) {
+    return start_entry(op);
+  }
+  if (op->handshake != 0) {
+    TRY(dif_dma_handshake_disable(dma_dev));
+  }
+  complete(op, OK_STATUS());
+  return OK_STATUS();
+}
+
+status_t dma_poll(dma_op_t *op, bool *done) {
+  if (!op->done) {
+    if (in_flight != op) {
+      *done = false;
+      return FAILED_PRECONDITION();
+    }
+    status_t result = advance(op);
+    if (!status_ok(result)) {
+      complete(op, result);
+    }
+  }
+  *done = op->done;
+  return op->done ? op->result : OK_STATUS();
+}
+
+status_t dma_wait(dma_op_t *op) {
+  bool done = false;
+  while (true) {
+    status_t result = dma_poll(op, &done);
+    if (done || !status_ok(result)) {
+      return result;
+    }
+  }
+}
+
+void dma_service_irq(void) {
+  dma_op_t *op = in_flight;
+  if (op == NULL) {
+    return;
+  }
+  bool done;
+  // Errors are reported to the operation's callback and `dma_poll()`.
+  OT_DISCARD(status_ok(dma_poll(op, &done)));
+}
@@ -0,0 +1,231 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_RUNTIME_DMA_H_
+#define OPENTITAN_SW_DEVICE_LIB_RUNTIME_DMA_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/dif/dif_dma.h"
+
+/**
+ * @file
+ * @brief DMA-backed memory copy and hashing service.
+ *
+ * Offloads bulk copies (and copies with an inline SHA2-256 digest) to the DMA
+ * engine, so that the CPU can do other work, or sleep, while data moves.
+ *
+ * Operations are asynchronous: a `dma_*` call starts the transfer and returns
+ * immediately. Completion is observed either by polling with `dma_poll()` /
+ * `dma_wait()`, or by calling `dma_service_irq()` from the DMA interrupt
+ * handler, in which case the operation's callback is invoked from interrupt
+ * context. An operation should be advanced from one place only: when
+ * `dma_service_irq()` is in use, wait for `dma_op_t::done` (e.g. with
+ * `ATOMIC_WAIT_FOR_INTERRUPT()`) rather than calling `dma_poll()`. There is a
+ * single DMA channel, so only one operation may be in flight at a time.
+ *
+ * When the service is initialized without a DMA handle (e.g. on a top without
+ * a DMA engine), every operation runs synchronously on the CPU with `memcpy()`
+ * and the configured SHA2-256 fallback, and is complete on return.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * A SHA2-256 implementation used when the DMA engine cannot hash a buffer.
+ *
+ * The digest must be produced in the same byte order as `dma_op_t::digest`,
+ * which matches `hmac_hash_sha256()` in the cryptolib HMAC driver.
+ */
+typedef status_t (*dma_sha256_fn_t)(const uint8_t *msg, size_t len,
+                                    uint32_t *digest);
+
+/**
+ * Completion callback.
+ *
+ * @param ctx The `ctx` field of the completed operation.
+ * @param result The final status of the operation.
+ */
+typedef void (*dma_callback_t)(void *ctx, status_t result);
+
+/**
+ * One entry of a scatter-gather list.
+ */
+typedef struct dma_sg_entry {
+  void *dest;
+  const void *src;
+  size_t len;
+} dma_sg_entry_t;
+
+/**
+ * State of one DMA operation.
+ *
+ * Callers set `callback` and `ctx` (or zero them) before starting the
+ * operation, and must keep the struct alive until it completes. The remaining
+ * fields are private to the service.
+ */
+typedef struct dma_op {
+  /**
+   * Called once when the operation completes; may be NULL.
+   */
+  dma_callback_t callback;
+  void *ctx;
+
+  /** Remaining scatter-gather entries, starting with the one in flight. */
+  const dma_sg_entry_t *entries;
+  size_t count;
+  /** Storage for `entries` when the operation is a single copy. */
+  dma_sg_entry_t single;
+  /** Where to write the SHA2-256 digest, or NULL for a plain copy. */
+  uint32_t *digest;
+  /**
+   * LSIO trigger mask for hardware-handshake transfers from a peripheral
+   * FIFO, or zero for memory-to-memory copies.
+   */
+  uint32_t handshake;
+  /** Bytes moved per handshake request. */
+  size_t chunk_size;
+  /** Final status; only meaningful once `done` is set. */
+  status_t result;
+  volatile bool done;
+} dma_op_t;
+
+/**
+ * Initializes the service.
+ *
+ * The caller is responsible for initializing the DIF and programming the DMA
+ * enabled memory range to cover every buffer passed to this service.
+ *
+ * @param dma A DMA handle, or NULL to run every operation on the CPU.
+ * @param sha256 SHA2-256 implementation used when the DMA engine is absent or
+ *        cannot hash a buffer; may be NULL if `dma_memcpy_and_sha256()` is not
+ *        used.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t dma_service_init(const dif_dma_t *dma, dma_sha256_fn_t sha256);
+
+/**
+ * Starts copying `len` bytes from `src` to `dest`.
+ *
+ * Word-aligned buffers are moved with 32-bit transfers; anything else falls
+ * back to byte transfers.
+ *
+ * @param op Operation state.
+ * @param dest Destination buffer.
+ * @param src Source buffer; must not overlap `dest`.
+ * @param len Number of bytes to copy.
+ * @return `UNAVAILABLE` if another operation is in flight, otherwise the
+ *         result of starting the transfer.
+ */
+OT_WARN_UNUSED_RESULT
+status_t dma_memcpy(dma_op_t *op, void *dest, const void *src, size_t len);
+
+/**
+ * Starts copying `len` bytes from `src` to `dest` while computing the
+ * SHA2-256 digest of the data.
+ *
+ * The DMA engine can only hash with 32-bit transfers, so `dest`, `src` and
+ * `len` must all be word-aligned for the copy to be offloaded; otherwise the
+ * operation runs on the CPU.
+ *
+ * The digest is written in standard byte order: viewed as bytes, `digest` is
+ * the 32-byte SHA2-256 output.
+ *
+ * @param op Operation state.
+ * @param dest Destination buffer.
+ * @param src Source buffer; must not overlap `dest`.
+ * @param len Number of bytes to copy and hash.
+ * @param[out] digest Digest, written when the operation completes.
+ * @return `UNAVAILABLE` if another operation is in flight, otherwise the
+ *         result of starting the transfer.
+ */
+OT_WARN_UNUSED_RESULT
+status_t dma_memcpy_and_sha256(dma_op_t *op, void *dest, const void *src,
+                               size_t len, uint32_t digest[8]);
+
+/**
+ * Starts copying each entry of a scatter-gather list in turn.
+ *
+ * Each entry is a separate DMA transfer; the next one is started from
+ * `dma_poll()` or `dma_service_irq()` when the previous one completes.
+ * Zero-length entries are skipped. The list must stay alive until the
+ * operation completes.
+ *
+ * @param op Operation state.
+ * @param entries Scatter-gather list.
+ * @param count Number of entries in `entries`.
+ * @return `UNAVAILABLE` if another operation is in flight, otherwise the
+ *         result of starting the first transfer.
+ */
+OT_WARN_UNUSED_RESULT
+status_t dma_memcpy_sg(dma_op_t *op, const dma_sg_entry_t *entries,
+                       size_t count);
+
+/**
+ * Starts draining `len` bytes from a peripheral receive FIFO into `dest`.
+ *
+ * The DMA engine runs in hardware-handshake mode: it moves `chunk_size` bytes
+ * from the FIFO data register each time the peripheral raises its LSIO
+ * trigger, e.g. when the receive FIFO reaches its watermark. The caller
+ * configures the watermark to match `chunk_size` and starts the peripheral
+ * side of the transfer, e.g. with a `dif_spi_host_transaction_pipelined()`
+ * receive segment without a buffer.
+ *
+ * @param op Operation state.
+ * @param dest Destination buffer; must be word-aligned.
+ * @param fifo Address of the FIFO data register.
+ * @param len Number of bytes to receive; a multiple of `chunk_size`.
+ * @param chunk_size Bytes per handshake request; a non-zero multiple of four.
+ * @param trigger LSIO trigger mask of the peripheral.
+ * @return `UNAVAILABLE` if another operation is in flight,
+ *         `FAILED_PRECONDITION` if the service has no DMA engine,
+ *         `INVALID_ARGUMENT` for bad alignment, otherwise the result of
+ *         starting the transfer.
+ */
+OT_WARN_UNUSED_RESULT
+status_t dma_fifo_read(dma_op_t *op, void *dest, uintptr_t fifo, size_t len,
+                       size_t chunk_size, uint32_t trigger);
+
+/**
+ * Advances an operation without blocking.
+ *
+ * @param op Operation state.
+ * @param[out] done Set to true once the operation has completed.
+ * @return The final status of the operation if it has completed, otherwise
+ *         `OK_STATUS()`.
+ */
+OT_WARN_UNUSED_RESULT
+status_t dma_poll(dma_op_t *op, bool *done);
+
+/**
+ * Spins until an operation completes.
+ *
+ * @param op Operation state.
+ * @return The final status of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t dma_wait(dma_op_t *op);
+
+/**
+ * Advances the operation in flight, if any.
+ *
+ * Call this from the handler for the DMA `dma_done` and `dma_error`
+ * interrupts. These are status-type interrupts, which this acknowledges by
+ * clearing the DMA status once the event is handled. The caller remains
+ * responsible for completing the interrupt at the PLIC.
+ */
+void dma_service_irq(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_RUNTIME_DMA_H_
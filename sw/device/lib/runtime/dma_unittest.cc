@@ -0,0 +1,296 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/runtime/dma.h"
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/base/mock_mmio.h"
+#include "sw/device/lib/dif/dif_test_base.h"
+
+extern "C" {
+#include "dma_regs.h"  // Generated.
+}  // extern "C"
+
+namespace dma_unittest {
+namespace {
+using mock_mmio::MmioTest;
+
+// Bits written to STATUS to clear it and acknowledge the DMA interrupts.
+constexpr uint32_t kStatusClear =
+    (1u << DMA_STATUS_DONE_BIT) | (1u << DMA_STATUS_ABORTED_BIT) |
+    (1u << DMA_STATUS_ERROR_BIT) | (1u << DMA_STATUS_CHUNK_DONE_BIT);
+
+struct CallbackLog {
+  int calls = 0;
+  status_t result = {0};
+};
+
+void OnDone(void *ctx, status_t result) {
+  auto *log = static_cast<CallbackLog *>(ctx);
+  ++log->calls;
+  log->result = result;
+}
+
+class DmaServiceTest : public testing::Test, public MmioTest {
+ protected:
+  DmaServiceTest() {
+    EXPECT_DIF_OK(dif_dma_init(dev().region(), &dma_));
+    EXPECT_WRITE32(DMA_STATUS_REG_OFFSET, kStatusClear);
+    EXPECT_TRUE(status_ok(dma_service_init(&dma_, nullptr)));
+    op_.callback = OnDone;
+    op_.ctx = &log_;
+  }
+
+  // Expects a memory-to-memory transfer of `entry` to be programmed and
+  // started.
+  void ExpectStart(const dma_sg_entry_t &entry,
+                   dif_dma_transaction_width_t width,
+                   dif_dma_transaction_opcode_t opcode) {
+    uint64_t src = reinterpret_cast<uintptr_t>(entry.src);
+    uint64_t dest = reinterpret_cast<uintptr_t>(entry.dest);
+    EXPECT_WRITE32(DMA_STATUS_REG_OFFSET, kStatusClear);
+    EXPECT_READ32(DMA_CONTROL_REG_OFFSET, 0);
+    EXPECT_WRITE32(DMA_CONTROL_REG_OFFSET, 0);
+    EXPECT_WRITE32(DMA_SRC_ADDR_LO_REG_OFFSET, src & UINT32_MAX);
+    EXPECT_WRITE32(DMA_SRC_ADDR_HI_REG_OFFSET, src >> 32);
+    EXPECT_WRITE32(DMA_DST_ADDR_LO_REG_OFFSET, dest & UINT32_MAX);
+    EXPECT_WRITE32(DMA_DST_ADDR_HI_REG_OFFSET, dest >> 32);
+    EXPECT_WRITE32(DMA_SRC_CONFIG_REG_OFFSET,
+                   {{DMA_SRC_CONFIG_INCREMENT_BIT, true}});
+    EXPECT_WRITE32(DMA_DST_CONFIG_REG_OFFSET,
+                   {{DMA_DST_CONFIG_INCREMENT_BIT, true}});
+    EXPECT_WRITE32(
+        DMA_ADDR_SPACE_ID_REG_OFFSET,
+        {
+            {DMA_ADDR_SPACE_ID_SRC_ASID_OFFSET, kDifDmaOpentitanInternalBus},
+            {DMA_ADDR_SPACE_ID_DST_ASID_OFFSET, kDifDmaOpentitanInternalBus},
+        });
+    EXPECT_WRITE32(DMA_CHUNK_DATA_SIZE_REG_OFFSET, entry.len);
+    EXPECT_WRITE32(DMA_TOTAL_DATA_SIZE_REG_OFFSET, entry.len);
+    EXPECT_WRITE32(DMA_TRANSFER_WIDTH_REG_OFFSET, width);
+    EXPECT_READ32(DMA_CONTROL_REG_OFFSET, 0);
+    EXPECT_WRITE32(DMA_CONTROL_REG_OFFSET,
+                   {
+                       {DMA_CONTROL_OPCODE_OFFSET, opcode},
+                       {DMA_CONTROL_INITIAL_TRANSFER_BIT, true},
+                       {DMA_CONTROL_GO_BIT, true},
+                   });
+  }
+
+  dif_dma_t dma_;
+  dma_op_t op_ = {};
+  CallbackLog log_;
+};
+
+TEST_F(DmaServiceTest, IrqWithoutOperation) {
+  // Nothing is in flight, so the handler must not touch the hardware.
+  dma_service_irq();
+}
+
+TEST_F(DmaServiceTest, IrqIgnoresBusyEngine) {
+  alignas(uint32_t) uint8_t src[8] = {0};
+  alignas(uint32_t) uint8_t dest[8] = {0};
+  dma_sg_entry_t entry = {dest, src, sizeof(src)};
+
+  ExpectStart(entry, kDifDmaTransWidth4Bytes, kDifDmaCopyOpcode);
+  EXPECT_TRUE(status_ok(dma_memcpy(&op_, dest, src, sizeof(src))));
+
+  EXPECT_READ32(DMA_STATUS_REG_OFFSET, {{DMA_STATUS_BUSY_BIT, true}});
+  dma_service_irq();
+  EXPECT_FALSE(op_.done);
+
+  EXPECT_READ32(DMA_STATUS_REG_OFFSET, {{DMA_STATUS_DONE_BIT, true}});
+  EXPECT_WRITE32(DMA_STATUS_REG_OFFSET, kStatusClear);
+  dma_service_irq();
+  EXPECT_TRUE(op_.done);
+  EXPECT_EQ(log_.calls, 1);
+  EXPECT_TRUE(status_ok(log_.result));
+}
+
+TEST_F(DmaServiceTest, IrqAdvancesChainAndSkipsEmptyEntries) {
+  alignas(uint32_t) uint8_t src[8] = {0};
+  alignas(uint32_t) uint8_t dest[8] = {0};
+  const dma_sg_entry_t entries[] = {
+      {dest, src, 0},         {dest, src, 4}, {&dest[4], &src[4], 0},
+      {&dest[4], &src[4], 3}, {dest, src, 0},
+  };
+
+  ExpectStart(entries[1], kDifDmaTransWidth4Bytes, kDifDmaCopyOpcode);
+  EXPECT_TRUE(status_ok(dma_memcpy_sg(&op_, entries, ARRAYSIZE(entries))));
+
+  // The empty entry between the two transfers is skipped.
+  EXPECT_READ32(DMA_STATUS_REG_OFFSET, {{DMA_STATUS_DONE_BIT, true}});
+  EXPECT_WRITE32(DMA_STATUS_REG_OFFSET, kStatusClear);
+  ExpectStart(entries[3], kDifDmaTransWidth1Byte, kDifDmaCopyOpcode);
+  dma_service_irq();
+  EXPECT_FALSE(op_.done);
+  EXPECT_EQ(log_.calls, 0);
+
+  // So is the empty entry at the end.
+  EXPECT_READ32(DMA_STATUS_REG_OFFSET, {{DMA_STATUS_DONE_BIT, true}});
+  EXPECT_WRITE32(DMA_STATUS_REG_OFFSET, kStatusClear);
+  dma_service_irq();
+  EXPECT_TRUE(op_.done);
+  EXPECT_EQ(log_.calls, 1);
+  EXPECT_TRUE(status_ok(log_.result));
+
+  dma_service_irq();
+  EXPECT_EQ(log_.calls, 1);
+}
+
+TEST_F(DmaServiceTest, IrqWaitsForDigest) {
+  alignas(uint32_t) uint8_t src[8] = {0};
+  alignas(uint32_t) uint8_t dest[8] = {0};
+  uint32_t digest[8] = {0};
+  dma_sg_entry_t entry = {dest, src, sizeof(src)};
+
+  ExpectStart(entry, kDifDmaTransWidth4Bytes, kDifDmaSha256Opcode);
+  EXPECT_TRUE(status_ok(
+      dma_memcpy_and_sha256(&op_, dest, src, sizeof(src), digest)));
+
+  // `done` is set before the digest. The handler waits for the digest and
+  // only then clears the status, which acknowledges the interrupt.
+  EXPECT_READ32(DMA_STATUS_REG_OFFSET, {{DMA_STATUS_DONE_BIT, true}});
+  EXPECT_READ32(DMA_STATUS_REG_OFFSET, {{DMA_STATUS_DONE_BIT, true}});
+  EXPECT_READ32(DMA_STATUS_REG_OFFSET,
+                {
+                    {DMA_STATUS_DONE_BIT, true},
+                    {DMA_STATUS_SHA2_DIGEST_VALID_BIT, true},
+                });
+  for (uint32_t i = 0; i < ARRAYSIZE(digest); ++i) {
+    EXPECT_READ32(DMA_SHA2_DIGEST_0_REG_OFFSET + i * sizeof(uint32_t),
+                  0x00010203 + i * 0x04040404);
+  }
+  EXPECT_WRITE32(DMA_STATUS_REG_OFFSET, kStatusClear);
+  dma_service_irq();
+
+  EXPECT_TRUE(op_.done);
+  EXPECT_EQ(log_.calls, 1);
+  EXPECT_TRUE(status_ok(log_.result));
+  for (uint32_t i = 0; i < ARRAYSIZE(digest); ++i) {
+    EXPECT_EQ(digest[i], bitfield_byteswap32(0x00010203 + i * 0x04040404));
+  }
+}
+
+TEST_F(DmaServiceTest, IrqReportsError) {
+  alignas(uint32_t) uint8_t src[4] = {0};
+  alignas(uint32_t) uint8_t dest[4] = {0};
+  dma_sg_entry_t entry = {dest, src, sizeof(src)};
+
+  ExpectStart(entry, kDifDmaTransWidth4Bytes, kDifDmaCopyOpcode);
+  EXPECT_TRUE(status_ok(dma_memcpy(&op_, dest, src, sizeof(src))));
+
+  EXPECT_READ32(DMA_STATUS_REG_OFFSET, {{DMA_STATUS_ERROR_BIT, true}});
+  EXPECT_READ32(DMA_ERROR_CODE_REG_OFFSET,
+                {{DMA_ERROR_CODE_SRC_ADDR_ERROR_BIT, true}});
+  EXPECT_WRITE32(DMA_STATUS_REG_OFFSET, kStatusClear);
+  dma_service_irq();
+
+  EXPECT_TRUE(op_.done);
+  EXPECT_EQ(log_.calls, 1);
+  EXPECT_EQ(status_err(log_.result), kInternal);
+
+  // The failed operation is no longer in flight.
+  dma_service_irq();
+  EXPECT_EQ(log_.calls, 1);
+}
+
+TEST_F(DmaServiceTest, FifoReadBadArgs) {
+  alignas(uint32_t) uint8_t dest[16] = {0};
+  uintptr_t fifo = 0x1000;
+  uint32_t trigger = 1u << 3;
+
+  EXPECT_EQ(status_err(dma_fifo_read(&op_, dest, fifo, 0, 4, trigger)),
+            kInvalidArgument);
+  EXPECT_EQ(status_err(dma_fifo_read(&op_, dest, fifo, 16, 0, trigger)),
+            kInvalidArgument);
+  EXPECT_EQ(status_err(dma_fifo_read(&op_, dest, fifo, 16, 4, 0)),
+            kInvalidArgument);
+  EXPECT_EQ(status_err(dma_fifo_read(&op_, &dest[1], fifo, 8, 4, trigger)),
+            kInvalidArgument);
+  EXPECT_EQ(status_err(dma_fifo_read(&op_, dest, fifo, 12, 6, trigger)),
+            kInvalidArgument);
+  EXPECT_EQ(status_err(dma_fifo_read(&op_, dest, fifo, 12, 8, trigger)),
+            kInvalidArgument);
+  EXPECT_EQ(log_.calls, 0);
+}
+
+TEST_F(DmaServiceTest, FifoReadWithoutDma) {
+  alignas(uint32_t) uint8_t dest[16] = {0};
+
+  // There is no CPU fallback for a handshake transfer.
+  EXPECT_TRUE(status_ok(dma_service_init(nullptr, nullptr)));
+  EXPECT_EQ(status_err(dma_fifo_read(&op_, dest, 0x1000, sizeof(dest), 4,
+                                     1u << 3)),
+            kFailedPrecondition);
+  EXPECT_EQ(log_.calls, 0);
+}
+
+TEST_F(DmaServiceTest, FifoRead) {
+  alignas(uint32_t) uint8_t dest[16] = {0};
+  uintptr_t fifo = 0x1000;
+  uint32_t trigger = 1u << 3;
+  uint64_t dest_addr = reinterpret_cast<uintptr_t>(dest);
+
+  EXPECT_WRITE32(DMA_STATUS_REG_OFFSET, kStatusClear);
+  EXPECT_WRITE32(DMA_HANDSHAKE_INTR_ENABLE_REG_OFFSET, trigger);
+  EXPECT_WRITE32(DMA_SRC_ADDR_LO_REG_OFFSET, fifo);
+  EXPECT_WRITE32(DMA_SRC_ADDR_HI_REG_OFFSET, 0);
+  EXPECT_WRITE32(DMA_DST_ADDR_LO_REG_OFFSET, dest_addr & UINT32_MAX);
+  EXPECT_WRITE32(DMA_DST_ADDR_HI_REG_OFFSET, dest_addr >> 32);
+  // The FIFO data register is read over and over.
+  EXPECT_WRITE32(DMA_SRC_CONFIG_REG_OFFSET,
+                 {{DMA_SRC_CONFIG_WRAP_BIT, true}});
+  EXPECT_WRITE32(DMA_DST_CONFIG_REG_OFFSET,
+                 {{DMA_DST_CONFIG_INCREMENT_BIT, true}});
+  EXPECT_WRITE32(
+      DMA_ADDR_SPACE_ID_REG_OFFSET,
+      {
+          {DMA_ADDR_SPACE_ID_SRC_ASID_OFFSET, kDifDmaOpentitanInternalBus},
+          {DMA_ADDR_SPACE_ID_DST_ASID_OFFSET, kDifDmaOpentitanInternalBus},
+      });
+  EXPECT_WRITE32(DMA_CHUNK_DATA_SIZE_REG_OFFSET, 4);
+  EXPECT_WRITE32(DMA_TOTAL_DATA_SIZE_REG_OFFSET, sizeof(dest));
+  EXPECT_WRITE32(DMA_TRANSFER_WIDTH_REG_OFFSET, kDifDmaTransWidth4Bytes);
+  EXPECT_READ32(DMA_CONTROL_REG_OFFSET, 0);
+  EXPECT_WRITE32(DMA_CONTROL_REG_OFFSET,
+                 {{DMA_CONTROL_HARDWARE_HANDSHAKE_ENABLE_BIT, true}});
+  EXPECT_READ32(DMA_CONTROL_REG_OFFSET,
+                {{DMA_CONTROL_HARDWARE_HANDSHAKE_ENABLE_BIT, true}});
+  EXPECT_WRITE32(DMA_CONTROL_REG_OFFSET,
+                 {
+                     {DMA_CONTROL_OPCODE_OFFSET, kDifDmaCopyOpcode},
+                     {DMA_CONTROL_HARDWARE_HANDSHAKE_ENABLE_BIT, true},
+                     {DMA_CONTROL_INITIAL_TRANSFER_BIT, true},
+                     {DMA_CONTROL_GO_BIT, true},
+                 });
+  EXPECT_TRUE(
+      status_ok(dma_fifo_read(&op_, dest, fifo, sizeof(dest), 4, trigger)));
+  EXPECT_FALSE(op_.done);
+
+  // A second operation cannot start while the read is in flight.
+  dma_op_t other = {};
+  EXPECT_EQ(status_err(dma_fifo_read(&other, dest, fifo, sizeof(dest), 4,
+                                     trigger)),
+            kUnavailable);
+
+  // Completion turns the handshake off again.
+  EXPECT_READ32(DMA_STATUS_REG_OFFSET, {{DMA_STATUS_DONE_BIT, true}});
+  EXPECT_WRITE32(DMA_STATUS_REG_OFFSET, kStatusClear);
+  EXPECT_READ32(DMA_CONTROL_REG_OFFSET,
+                {{DMA_CONTROL_HARDWARE_HANDSHAKE_ENABLE_BIT, true}});
+  EXPECT_WRITE32(DMA_CONTROL_REG_OFFSET, 0);
+  dma_service_irq();
+
+  EXPECT_TRUE(op_.done);
+  EXPECT_EQ(log_.calls, 1);
+  EXPECT_TRUE(status_ok(log_.result));
+}
+
+}  // namespace
+}  // namespace dma_unittest
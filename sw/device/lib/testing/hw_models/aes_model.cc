@@ -0,0 +1,235 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/hw_models/aes_model.h"
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/bitfield.h"
+
+#include "aes_regs.h"  // Generated.
+
+extern "C" {
+#include "hw/ip/aes/model/aes.h"
+}  // extern "C"
+
+namespace hw_models {
+namespace {
+
+enum {
+  kBlockWords = 4,
+  kAllWords = (1 << kBlockWords) - 1,
+};
+
+bool InBlock(uint32_t offset, uint32_t base) {
+  return offset >= base && offset < base + kBlockWords * sizeof(uint32_t);
+}
+
+}  // namespace
+
+AesModel::AesModel() {
+  SetResetValue(AES_CTRL_SHADOWED_REG_OFFSET, AES_CTRL_SHADOWED_REG_RESVAL);
+  SetResetValue(AES_CTRL_AUX_SHADOWED_REG_OFFSET,
+                AES_CTRL_AUX_SHADOWED_REG_RESVAL);
+  SetResetValue(AES_CTRL_AUX_REGWEN_REG_OFFSET, AES_CTRL_AUX_REGWEN_REG_RESVAL);
+}
+
+bool AesModel::Encrypt() {
+  return bitfield_field32_read(Reg(AES_CTRL_SHADOWED_REG_OFFSET),
+                               AES_CTRL_SHADOWED_OPERATION_FIELD) ==
+         AES_CTRL_SHADOWED_OPERATION_VALUE_AES_ENC;
+}
+
+std::vector<uint8_t> AesModel::Key() {
+  if (bitfield_bit32_read(Reg(AES_CTRL_SHADOWED_REG_OFFSET),
+                          AES_CTRL_SHADOWED_SIDELOAD_BIT)) {
+    return sideload_key_;
+  }
+  size_t key_bytes = 0;
+  switch (bitfield_field32_read(Reg(AES_CTRL_SHADOWED_REG_OFFSET),
+                                AES_CTRL_SHADOWED_KEY_LEN_FIELD)) {
+    case AES_CTRL_SHADOWED_KEY_LEN_VALUE_AES_128:
+      key_bytes = 16;
+      break;
+    case AES_CTRL_SHADOWED_KEY_LEN_VALUE_AES_192:
+      key_bytes = 24;
+      break;
+    case AES_CTRL_SHADOWED_KEY_LEN_VALUE_AES_256:
+      key_bytes = 32;
+      break;
+    default:
+      ADD_FAILURE() << "AesModel: invalid key_len";
+      break;
+  }
+  std::vector<uint8_t> key;
+  for (size_t i = 0; i < key_bytes; i += sizeof(uint32_t)) {
+    uint32_t word = Reg(AES_KEY_SHARE0_0_REG_OFFSET + i) ^
+                    Reg(AES_KEY_SHARE1_0_REG_OFFSET + i);
+    for (size_t j = 0; j < sizeof(uint32_t); ++j) {
+      key.push_back(static_cast<uint8_t>(word >> (8 * j)));
+    }
+  }
+  return key;
+}
+
+AesModel::Block AesModel::ReadBlock(uint32_t offset) {
+  Block block;
+  for (size_t i = 0; i < block.size(); i += sizeof(uint32_t)) {
+    uint32_t word = Reg(offset + i);
+    for (size_t j = 0; j < sizeof(uint32_t); ++j) {
+      block[i + j] = static_cast<uint8_t>(word >> (8 * j));
+    }
+  }
+  return block;
+}
+
+void AesModel::WriteBlock(uint32_t offset, const Block &block) {
+  for (size_t i = 0; i < block.size(); i += sizeof(uint32_t)) {
+    Reg(offset + i) = static_cast<uint32_t>(block[i]) |
+                      static_cast<uint32_t>(block[i + 1]) << 8 |
+                      static_cast<uint32_t>(block[i + 2]) << 16 |
+                      static_cast<uint32_t>(block[i + 3]) << 24;
+  }
+}
+
+uint32_t AesModel::Read32(uint32_t offset) {
+  if (offset == AES_STATUS_REG_OFFSET) {
+    uint32_t status = 0;
+    status = bitfield_bit32_write(status, AES_STATUS_IDLE_BIT, !input_pending_);
+    status = bitfield_bit32_write(status, AES_STATUS_STALL_BIT, input_pending_);
+    status = bitfield_bit32_write(status, AES_STATUS_OUTPUT_VALID_BIT,
+                                  output_valid_);
+    status = bitfield_bit32_write(status, AES_STATUS_INPUT_READY_BIT,
+                                  !input_pending_);
+    return status;
+  }
+  if (InBlock(offset, AES_DATA_OUT_0_REG_OFFSET)) {
+    uint32_t value = Reg(offset);
+    data_out_read_ |= 1u << ((offset - AES_DATA_OUT_0_REG_OFFSET) / 4);
+    if (data_out_read_ == kAllWords) {
+      data_out_read_ = 0;
+      output_valid_ = false;
+      MaybeProcess();
+    }
+    return value;
+  }
+  return MmioModel::Read32(offset);
+}
+
+void AesModel::Write32(uint32_t offset, uint32_t value) {
+  if (InBlock(offset, AES_DATA_IN_0_REG_OFFSET)) {
+    Reg(offset) = value;
+    data_in_written_ |= 1u << ((offset - AES_DATA_IN_0_REG_OFFSET) / 4);
+    if (data_in_written_ == kAllWords) {
+      data_in_written_ = 0;
+      input_pending_ = true;
+      MaybeProcess();
+    }
+    return;
+  }
+  if (offset == AES_TRIGGER_REG_OFFSET) {
+    Trigger(value);
+    return;
+  }
+  MmioModel::Write32(offset, value);
+}
+
+void AesModel::Trigger(uint32_t trigger) {
+  if (bitfield_bit32_read(trigger, AES_TRIGGER_KEY_IV_DATA_IN_CLEAR_BIT)) {
+    // Hardware overwrites these with pseudo-random data; zeros are
+    // indistinguishable for software.
+    for (uint32_t i = 0; i < AES_KEY_SHARE0_MULTIREG_COUNT; ++i) {
+      Reg(AES_KEY_SHARE0_0_REG_OFFSET + i * sizeof(uint32_t)) = 0;
+      Reg(AES_KEY_SHARE1_0_REG_OFFSET + i * sizeof(uint32_t)) = 0;
+    }
+    WriteBlock(AES_IV_0_REG_OFFSET, Block{});
+    WriteBlock(AES_DATA_IN_0_REG_OFFSET, Block{});
+    data_in_written_ = 0;
+    input_pending_ = false;
+  }
+  if (bitfield_bit32_read(trigger, AES_TRIGGER_DATA_OUT_CLEAR_BIT)) {
+    WriteBlock(AES_DATA_OUT_0_REG_OFFSET, Block{});
+    data_out_read_ = 0;
+    output_valid_ = false;
+  }
+  if (bitfield_bit32_read(trigger, AES_TRIGGER_START_BIT)) {
+    Process();
+  }
+}
+
+void AesModel::MaybeProcess() {
+  bool manual = bitfield_bit32_read(Reg(AES_CTRL_SHADOWED_REG_OFFSET),
+                                    AES_CTRL_SHADOWED_MANUAL_OPERATION_BIT);
+  if (input_pending_ && !output_valid_ && !manual) {
+    Process();
+  }
+}
+
+void AesModel::Process() {
+  std::vector<uint8_t> key = Key();
+  int key_len = static_cast<int>(key.size());
+  Block in = ReadBlock(AES_DATA_IN_0_REG_OFFSET);
+  Block iv = ReadBlock(AES_IV_0_REG_OFFSET);
+  Block out;
+  Block next_iv = iv;
+  Block keystream;
+
+  uint32_t mode = bitfield_field32_read(Reg(AES_CTRL_SHADOWED_REG_OFFSET),
+                                        AES_CTRL_SHADOWED_MODE_FIELD);
+  switch (mode) {
+    case AES_CTRL_SHADOWED_MODE_VALUE_AES_ECB:
+      if (Encrypt()) {
+        aes_encrypt_block(in.data(), key.data(), key_len, out.data());
+      } else {
+        aes_decrypt_block(in.data(), key.data(), key_len, out.data());
+      }
+      break;
+    case AES_CTRL_SHADOWED_MODE_VALUE_AES_CBC:
+      if (Encrypt()) {
+        Block x;
+        for (size_t i = 0; i < x.size(); ++i) {
+          x[i] = in[i] ^ iv[i];
+        }
+        aes_encrypt_block(x.data(), key.data(), key_len, out.data());
+        next_iv = out;
+      } else {
+        aes_decrypt_block(in.data(), key.data(), key_len, out.data());
+        for (size_t i = 0; i < out.size(); ++i) {
+          out[i] ^= iv[i];
+        }
+        next_iv = in;
+      }
+      break;
+    case AES_CTRL_SHADOWED_MODE_VALUE_AES_CFB:
+    case AES_CTRL_SHADOWED_MODE_VALUE_AES_OFB:
+    case AES_CTRL_SHADOWED_MODE_VALUE_AES_CTR:
+      // The stream modes always run the cipher forwards.
+      aes_encrypt_block(iv.data(), key.data(), key_len, keystream.data());
+      for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = in[i] ^ keystream[i];
+      }
+      if (mode == AES_CTRL_SHADOWED_MODE_VALUE_AES_CFB) {
+        next_iv = Encrypt() ? out : in;
+      } else if (mode == AES_CTRL_SHADOWED_MODE_VALUE_AES_OFB) {
+        next_iv = keystream;
+      } else {
+        // The counter is the whole IV, as a big-endian 128-bit integer.
+        for (size_t i = next_iv.size(); i > 0; --i) {
+          if (++next_iv[i - 1] != 0) {
+            break;
+          }
+        }
+      }
+      break;
+    default:
+      ADD_FAILURE() << "AesModel: invalid mode 0x" << std::hex << mode;
+      break;
+  }
+
+  WriteBlock(AES_DATA_OUT_0_REG_OFFSET, out);
+  WriteBlock(AES_IV_0_REG_OFFSET, next_iv);
+  input_pending_ = false;
+  output_valid_ = true;
+}
+
+}  // namespace hw_models
@@ -0,0 +1,68 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_AES_MODEL_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_AES_MODEL_H_
+
+#include <array>
+#include <stdint.h>
+#include <vector>
+
+#include "sw/device/lib/testing/hw_models/mmio_model.h"
+
+namespace hw_models {
+
+/**
+ * Functional model of the AES block.
+ *
+ * Models ECB, CBC, CFB, OFB and CTR in both directions for all three key
+ * lengths, using the reference cipher in `hw/ip/aes/model`. The key is the XOR
+ * of the two key share registers, or the value passed to `SetSideloadKey`
+ * when `CTRL.sideload` is set. The `IV` registers are updated after every
+ * block the same way the hardware updates them, so software can read back the
+ * chaining value.
+ *
+ * As in hardware, a block is processed once all four `DATA_IN` registers have
+ * been written and the previous output has been read, or on `TRIGGER.start`
+ * in manual mode. Processing completes immediately.
+ */
+class AesModel : public MmioModel {
+ public:
+  AesModel();
+
+  uint32_t Read32(uint32_t offset) override;
+  void Write32(uint32_t offset, uint32_t value) override;
+
+  /**
+   * Sets the key presented on the keymgr sideload interface.
+   */
+  void SetSideloadKey(const std::vector<uint8_t> &key) { sideload_key_ = key; }
+
+ private:
+  using Block = std::array<uint8_t, 16>;
+
+  void Trigger(uint32_t trigger);
+  void MaybeProcess();
+  void Process();
+  bool Encrypt();
+  std::vector<uint8_t> Key();
+  Block ReadBlock(uint32_t offset);
+  void WriteBlock(uint32_t offset, const Block &block);
+
+  /**
+   * Bitmap of the `DATA_IN` registers written since the last block started.
+   */
+  uint32_t data_in_written_ = 0;
+  /**
+   * Bitmap of the `DATA_OUT` registers read since the last block completed.
+   */
+  uint32_t data_out_read_ = 0;
+  bool input_pending_ = false;
+  bool output_valid_ = false;
+  std::vector<uint8_t> sideload_key_;
+};
+
+}  // namespace hw_models
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_AES_MODEL_H_
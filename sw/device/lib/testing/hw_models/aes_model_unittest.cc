@@ -0,0 +1,151 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/hw_models/aes_model.h"
+
+#include <array>
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/mock_abs_mmio.h"
+#include "sw/device/lib/crypto/drivers/aes.h"
+#include "sw/device/lib/crypto/impl/status.h"
+#include "sw/device/lib/testing/hw_models/mmio_model.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+
+namespace hw_models {
+namespace {
+
+// Key, IV and plaintext from NIST SP 800-38A, appendix F.
+constexpr std::array<uint8_t, 16> kKey = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+};
+constexpr std::array<uint8_t, 32> kPlaintext = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+    0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03,
+    0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+};
+
+class AesModelTest : public testing::Test {
+ protected:
+  AesModelTest() {
+    bus_.Attach(TOP_EARLGREY_AES_BASE_ADDR, TOP_EARLGREY_AES_SIZE_BYTES,
+                &aes_);
+    bus_.Bind(mmio_);
+  }
+
+  /**
+   * Runs `in` through the AES driver, one block at a time with the output of
+   * each block read back while the next one is written, as the cryptolib
+   * does.
+   */
+  std::vector<uint8_t> Run(aes_cipher_mode_t mode, bool encrypt,
+                           const uint8_t *iv_bytes, const uint8_t *in,
+                           size_t len) {
+    aes_key_t key = {
+        .mode = mode,
+        .sideload = kHardenedBoolFalse,
+        .key_len = kKey.size() / sizeof(uint32_t),
+        .key_shares = {key_share0_.data(), key_share1_.data()},
+    };
+    aes_block_t iv = {0};
+    if (iv_bytes != nullptr) {
+      memcpy(iv.data, iv_bytes, sizeof(iv.data));
+    }
+    if (encrypt) {
+      EXPECT_TRUE(status_ok(aes_encrypt_begin(key, &iv)));
+    } else {
+      EXPECT_TRUE(status_ok(aes_decrypt_begin(key, &iv)));
+    }
+
+    size_t blocks = len / sizeof(aes_block_t);
+    std::vector<aes_block_t> out(blocks);
+    for (size_t i = 0; i <= blocks; ++i) {
+      aes_block_t src;
+      if (i < blocks) {
+        memcpy(src.data, in + i * sizeof(src), sizeof(src));
+      }
+      EXPECT_TRUE(status_ok(aes_update(i == 0 ? nullptr : &out[i - 1],
+                                       i == blocks ? nullptr : &src)));
+    }
+    EXPECT_TRUE(status_ok(aes_end(nullptr)));
+
+    std::vector<uint8_t> bytes(len);
+    memcpy(bytes.data(), out.data(), len);
+    return bytes;
+  }
+
+  void SetUp() override {
+    // Split the key into two random-looking shares.
+    for (size_t i = 0; i < key_share0_.size(); ++i) {
+      uint32_t word;
+      memcpy(&word, &kKey[i * sizeof(word)], sizeof(word));
+      key_share1_[i] = 0x9e3779b9 * static_cast<uint32_t>(i + 1);
+      key_share0_[i] = word ^ key_share1_[i];
+    }
+  }
+
+  std::array<uint32_t, 4> key_share0_;
+  std::array<uint32_t, 4> key_share1_;
+  rom_test::NiceMockAbsMmio mmio_;
+  AesModel aes_;
+  FunctionalMmio bus_;
+};
+
+TEST_F(AesModelTest, Ecb) {
+  constexpr std::array<uint8_t, 32> kCiphertext = {
+      0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60, 0xa8, 0x9e, 0xca,
+      0xf3, 0x24, 0x66, 0xef, 0x97, 0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9,
+      0x69, 0x9d, 0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf,
+  };
+  EXPECT_EQ(Run(kAesCipherModeEcb, true, nullptr, kPlaintext.data(),
+                kPlaintext.size()),
+            std::vector<uint8_t>(kCiphertext.begin(), kCiphertext.end()));
+  EXPECT_EQ(Run(kAesCipherModeEcb, false, nullptr, kCiphertext.data(),
+                kCiphertext.size()),
+            std::vector<uint8_t>(kPlaintext.begin(), kPlaintext.end()));
+}
+
+TEST_F(AesModelTest, Cbc) {
+  constexpr std::array<uint8_t, 16> kIv = {
+      0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+      0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  };
+  constexpr std::array<uint8_t, 32> kCiphertext = {
+      0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e,
+      0x9b, 0x12, 0xe9, 0x19, 0x7d, 0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72,
+      0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+  };
+  EXPECT_EQ(Run(kAesCipherModeCbc, true, kIv.data(), kPlaintext.data(),
+                kPlaintext.size()),
+            std::vector<uint8_t>(kCiphertext.begin(), kCiphertext.end()));
+  EXPECT_EQ(Run(kAesCipherModeCbc, false, kIv.data(), kCiphertext.data(),
+                kCiphertext.size()),
+            std::vector<uint8_t>(kPlaintext.begin(), kPlaintext.end()));
+}
+
+TEST_F(AesModelTest, Ctr) {
+  // The counter wraps from `...feff` to `...ff00` after the first block.
+  constexpr std::array<uint8_t, 16> kIv = {
+      0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+      0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff,
+  };
+  constexpr std::array<uint8_t, 32> kCiphertext = {
+      0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68,
+      0x64, 0x99, 0x0d, 0xb6, 0xce, 0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70,
+      0xfd, 0xff, 0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+  };
+  EXPECT_EQ(Run(kAesCipherModeCtr, true, kIv.data(), kPlaintext.data(),
+                kPlaintext.size()),
+            std::vector<uint8_t>(kCiphertext.begin(), kCiphertext.end()));
+  EXPECT_EQ(Run(kAesCipherModeCtr, false, kIv.data(), kCiphertext.data(),
+                kCiphertext.size()),
+            std::vector<uint8_t>(kPlaintext.begin(), kPlaintext.end()));
+}
+
+}  // namespace
+}  // namespace hw_models
@@ -0,0 +1,259 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/hw_models/flash_ctrl_model.h"
+
+#include <algorithm>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/bitfield.h"
+
+#include "flash_ctrl_regs.h"  // Generated.
+
+namespace hw_models {
+namespace {
+
+constexpr uint32_t kErasedWord = UINT32_MAX;
+
+enum {
+  kNumBanks = FLASH_CTRL_PARAM_REG_NUM_BANKS,
+  kBankBytes = FLASH_CTRL_PARAM_BYTES_PER_BANK,
+  kPageBytes = FLASH_CTRL_PARAM_BYTES_PER_PAGE,
+  kWindowBytes = FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES,
+  kDataWords = kNumBanks * kBankBytes / sizeof(uint32_t),
+};
+
+constexpr uint32_t kInfoPages[] = {
+    FLASH_CTRL_PARAM_NUM_INFOS0,
+    FLASH_CTRL_PARAM_NUM_INFOS1,
+    FLASH_CTRL_PARAM_NUM_INFOS2,
+};
+
+/**
+ * Converts a flash byte address to a word index into the storage of an info
+ * partition, which holds `pages` pages per bank.
+ *
+ * Returns `SIZE_MAX` if the address is not in the partition.
+ */
+size_t InfoIndex(uint32_t addr, uint32_t pages) {
+  uint32_t bank = addr / kBankBytes;
+  uint32_t page = (addr % kBankBytes) / kPageBytes;
+  if (bank >= kNumBanks || page >= pages) {
+    return SIZE_MAX;
+  }
+  return ((bank * pages + page) * kPageBytes + addr % kPageBytes) /
+         sizeof(uint32_t);
+}
+
+}  // namespace
+
+FlashCtrlModel::FlashCtrlModel()
+    : data_(kDataWords, kErasedWord), mem_(this) {
+  for (size_t i = 0; i < 3; ++i) {
+    info_[i].assign(kNumBanks * kInfoPages[i] * kPageBytes / sizeof(uint32_t),
+                    kErasedWord);
+  }
+  SetResetValue(FLASH_CTRL_INTR_STATE_REG_OFFSET,
+                FLASH_CTRL_INTR_STATE_REG_RESVAL);
+  SetResetValue(FLASH_CTRL_STATUS_REG_OFFSET, FLASH_CTRL_STATUS_REG_RESVAL);
+}
+
+void FlashCtrlModel::Preload(uint32_t addr, const void *data, size_t len) {
+  ASSERT_EQ(addr % sizeof(uint32_t), 0);
+  ASSERT_EQ(len % sizeof(uint32_t), 0);
+  ASSERT_LE(addr + len, data_.size() * sizeof(uint32_t));
+  memcpy(&data_[addr / sizeof(uint32_t)], data, len);
+}
+
+std::vector<uint32_t> &FlashCtrlModel::Partition(uint32_t control) {
+  if (!bitfield_bit32_read(control, FLASH_CTRL_CONTROL_PARTITION_SEL_BIT)) {
+    return data_;
+  }
+  uint32_t info_sel =
+      bitfield_field32_read(control, FLASH_CTRL_CONTROL_INFO_SEL_FIELD);
+  if (info_sel >= 3) {
+    ADD_FAILURE() << "FlashCtrlModel: invalid info_sel " << info_sel;
+    info_sel = 0;
+  }
+  return info_[info_sel];
+}
+
+uint32_t FlashCtrlModel::Read32(uint32_t offset) {
+  switch (offset) {
+    case FLASH_CTRL_RD_FIFO_REG_OFFSET: {
+      if (rd_fifo_.empty()) {
+        ADD_FAILURE() << "FlashCtrlModel: read from empty RD_FIFO";
+        return 0;
+      }
+      uint32_t word = rd_fifo_.front();
+      rd_fifo_.pop_front();
+      return word;
+    }
+    case FLASH_CTRL_STATUS_REG_OFFSET: {
+      uint32_t status = Reg(offset);
+      status = bitfield_bit32_write(status, FLASH_CTRL_STATUS_RD_EMPTY_BIT,
+                                    rd_fifo_.empty());
+      return status;
+    }
+    default:
+      return MmioModel::Read32(offset);
+  }
+}
+
+void FlashCtrlModel::Write32(uint32_t offset, uint32_t value) {
+  switch (offset) {
+    case FLASH_CTRL_CONTROL_REG_OFFSET:
+      Reg(offset) = value;
+      if (bitfield_bit32_read(value, FLASH_CTRL_CONTROL_START_BIT)) {
+        Start(value);
+      }
+      break;
+    case FLASH_CTRL_PROG_FIFO_REG_OFFSET:
+      Program(value);
+      break;
+    case FLASH_CTRL_INTR_STATE_REG_OFFSET:
+    case FLASH_CTRL_ERR_CODE_REG_OFFSET:
+      // rw1c.
+      Reg(offset) &= ~value;
+      break;
+    default:
+      MmioModel::Write32(offset, value);
+      break;
+  }
+}
+
+void FlashCtrlModel::Done(uint32_t err_code_bit, bool err) {
+  uint32_t op_status =
+      bitfield_bit32_write(0, FLASH_CTRL_OP_STATUS_DONE_BIT, true);
+  if (err) {
+    op_status = bitfield_bit32_write(op_status, FLASH_CTRL_OP_STATUS_ERR_BIT,
+                                     true);
+    Reg(FLASH_CTRL_ERR_CODE_REG_OFFSET) |= 1u << err_code_bit;
+  }
+  Reg(FLASH_CTRL_OP_STATUS_REG_OFFSET) = op_status;
+  Reg(FLASH_CTRL_INTR_STATE_REG_OFFSET) |= 1u
+                                           << FLASH_CTRL_INTR_STATE_OP_DONE_BIT;
+}
+
+void FlashCtrlModel::Start(uint32_t control) {
+  uint32_t addr = Reg(FLASH_CTRL_ADDR_REG_OFFSET) & ~3u;
+  uint32_t words =
+      bitfield_field32_read(control, FLASH_CTRL_CONTROL_NUM_FIELD) + 1;
+  bool is_info =
+      bitfield_bit32_read(control, FLASH_CTRL_CONTROL_PARTITION_SEL_BIT);
+  uint32_t info_sel =
+      bitfield_field32_read(control, FLASH_CTRL_CONTROL_INFO_SEL_FIELD);
+  std::vector<uint32_t> &part = Partition(control);
+  if (info_sel >= 3) {
+    // Already reported by `Partition()`.
+    info_sel = 0;
+  }
+  auto index = [&](uint32_t a) -> size_t {
+    if (is_info) {
+      return InfoIndex(a, kInfoPages[info_sel]);
+    }
+    return a / sizeof(uint32_t) < part.size() ? a / sizeof(uint32_t)
+                                              : SIZE_MAX;
+  };
+
+  switch (bitfield_field32_read(control, FLASH_CTRL_CONTROL_OP_FIELD)) {
+    case FLASH_CTRL_CONTROL_OP_VALUE_READ: {
+      bool err = false;
+      for (uint32_t i = 0; i < words; ++i) {
+        size_t idx = index(addr + i * sizeof(uint32_t));
+        err |= idx == SIZE_MAX;
+        // Failed reads still return data so that software does not stall.
+        rd_fifo_.push_back(idx == SIZE_MAX ? 0 : part[idx]);
+      }
+      Done(FLASH_CTRL_ERR_CODE_RD_ERR_BIT, err);
+      break;
+    }
+    case FLASH_CTRL_CONTROL_OP_VALUE_PROG:
+      prog_control_ = control;
+      prog_addr_ = addr;
+      prog_remaining_ = words;
+      prog_err_bit_ = -1;
+      Reg(FLASH_CTRL_OP_STATUS_REG_OFFSET) = 0;
+      if (addr / kWindowBytes !=
+          (addr + words * sizeof(uint32_t) - 1) / kWindowBytes) {
+        // The hardware rejects the whole operation, but still drains the
+        // FIFO.
+        prog_err_bit_ = FLASH_CTRL_ERR_CODE_PROG_WIN_ERR_BIT;
+      }
+      break;
+    case FLASH_CTRL_CONTROL_OP_VALUE_ERASE: {
+      bool bank =
+          bitfield_bit32_read(control, FLASH_CTRL_CONTROL_ERASE_SEL_BIT);
+      uint32_t size = bank ? kBankBytes : kPageBytes;
+      uint32_t start = addr & ~(size - 1);
+      if (bank && is_info) {
+        // A bank erase with an info partition selected erases the data
+        // partition of the bank as well as its pages of that info partition.
+        size_t first = InfoIndex(start, kInfoPages[info_sel]);
+        std::fill(part.begin() + first,
+                  part.begin() + first +
+                      kInfoPages[info_sel] * kPageBytes / sizeof(uint32_t),
+                  kErasedWord);
+        std::fill(data_.begin() + start / sizeof(uint32_t),
+                  data_.begin() + (start + size) / sizeof(uint32_t),
+                  kErasedWord);
+        Done(0, false);
+        break;
+      }
+      size_t first = index(start);
+      if (first == SIZE_MAX) {
+        Done(FLASH_CTRL_ERR_CODE_OP_ERR_BIT, true);
+        break;
+      }
+      std::fill(part.begin() + first,
+                part.begin() + first + size / sizeof(uint32_t), kErasedWord);
+      Done(0, false);
+      break;
+    }
+    default:
+      Done(FLASH_CTRL_ERR_CODE_OP_ERR_BIT, true);
+      break;
+  }
+}
+
+void FlashCtrlModel::Program(uint32_t value) {
+  if (prog_remaining_ == 0) {
+    ADD_FAILURE() << "FlashCtrlModel: write to PROG_FIFO with no operation";
+    return;
+  }
+  --prog_remaining_;
+  if (prog_err_bit_ < 0) {
+    std::vector<uint32_t> &part = Partition(prog_control_);
+    size_t idx = prog_addr_ / sizeof(uint32_t);
+    if (bitfield_bit32_read(prog_control_,
+                            FLASH_CTRL_CONTROL_PARTITION_SEL_BIT)) {
+      uint32_t info_sel = bitfield_field32_read(
+          prog_control_, FLASH_CTRL_CONTROL_INFO_SEL_FIELD);
+      idx = InfoIndex(prog_addr_, kInfoPages[info_sel < 3 ? info_sel : 0]);
+    } else if (idx >= part.size()) {
+      idx = SIZE_MAX;
+    }
+    if (idx == SIZE_MAX) {
+      prog_err_bit_ = FLASH_CTRL_ERR_CODE_PROG_ERR_BIT;
+    } else {
+      part[idx] &= value;
+      prog_addr_ += sizeof(uint32_t);
+    }
+  }
+  if (prog_remaining_ == 0) {
+    Done(prog_err_bit_ < 0 ? 0 : prog_err_bit_, prog_err_bit_ >= 0);
+  }
+}
+
+uint32_t FlashCtrlModel::MemWindow::Read32(uint32_t offset) {
+  return flash_->data_[offset / sizeof(uint32_t)];
+}
+
+void FlashCtrlModel::MemWindow::Write32(uint32_t offset, uint32_t value) {
+  ADD_FAILURE() << "FlashCtrlModel: write to read-only memory window at 0x"
+                << std::hex << offset;
+}
+
+}  // namespace hw_models
@@ -0,0 +1,91 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_FLASH_CTRL_MODEL_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_FLASH_CTRL_MODEL_H_
+
+#include <deque>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "sw/device/lib/testing/hw_models/mmio_model.h"
+
+namespace hw_models {
+
+/**
+ * Functional model of the flash controller and the flash array behind it.
+ *
+ * Models read, program and page/bank erase operations through the FIFOs for
+ * the data partition and all info partitions, and direct reads of the data
+ * partition through the memory window returned by `mem()`. As on real flash,
+ * programming can only clear bits, so programming a word that is not erased
+ * ANDs the new value into it. Programs that cross a program window, and
+ * accesses outside the flash, fail with the same `ERR_CODE` bits as the
+ * hardware.
+ *
+ * Memory protection regions, scrambling, ECC and the initialization sequence
+ * are not modelled: the corresponding registers behave as plain storage.
+ * Operations complete immediately.
+ */
+class FlashCtrlModel : public MmioModel {
+ public:
+  FlashCtrlModel();
+
+  uint32_t Read32(uint32_t offset) override;
+  void Write32(uint32_t offset, uint32_t value) override;
+
+  /**
+   * Model of the read-only flash memory window, to be attached at
+   * `TOP_EARLGREY_FLASH_CTRL_MEM_BASE_ADDR`.
+   */
+  MmioModel *mem() { return &mem_; }
+
+  /**
+   * Backdoor write of the data partition, e.g. to preload an image.
+   *
+   * @param addr Byte offset into the data partition.
+   * @param data Data to write.
+   * @param len Number of bytes; must be a multiple of four.
+   */
+  void Preload(uint32_t addr, const void *data, size_t len);
+
+ private:
+  class MemWindow : public MmioModel {
+   public:
+    explicit MemWindow(FlashCtrlModel *flash) : flash_(flash) {}
+    uint32_t Read32(uint32_t offset) override;
+    void Write32(uint32_t offset, uint32_t value) override;
+
+   private:
+    FlashCtrlModel *flash_;
+  };
+
+  void Start(uint32_t control);
+  void Program(uint32_t value);
+  void Done(uint32_t err_code_bit, bool err);
+  /**
+   * Returns the storage of the partition selected by `control`.
+   */
+  std::vector<uint32_t> &Partition(uint32_t control);
+
+  std::vector<uint32_t> data_;
+  std::vector<uint32_t> info_[3];
+  std::deque<uint32_t> rd_fifo_;
+  /**
+   * State of the program operation in progress.
+   */
+  uint32_t prog_control_ = 0;
+  uint32_t prog_addr_ = 0;
+  uint32_t prog_remaining_ = 0;
+  /**
+   * `ERR_CODE` bit to report when the program operation completes, or -1.
+   */
+  int prog_err_bit_ = -1;
+  MemWindow mem_;
+};
+
+}  // namespace hw_models
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_FLASH_CTRL_MODEL_H_
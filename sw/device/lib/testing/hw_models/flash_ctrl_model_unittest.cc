@@ -0,0 +1,115 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/hw_models/flash_ctrl_model.h"
+
+#include <array>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/mock_abs_mmio.h"
+#include "sw/device/lib/testing/hw_models/mmio_model.h"
+#include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/error.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+
+namespace hw_models {
+namespace {
+using ::testing::Each;
+using ::testing::ElementsAreArray;
+
+class FlashCtrlModelTest : public testing::Test {
+ protected:
+  FlashCtrlModelTest() {
+    bus_.Attach(TOP_EARLGREY_FLASH_CTRL_CORE_BASE_ADDR,
+                TOP_EARLGREY_FLASH_CTRL_CORE_SIZE_BYTES, &flash_);
+    bus_.Attach(TOP_EARLGREY_FLASH_CTRL_MEM_BASE_ADDR,
+                TOP_EARLGREY_FLASH_CTRL_MEM_SIZE_BYTES, flash_.mem());
+    bus_.Bind(mmio_);
+  }
+
+  rom_test::NiceMockAbsMmio mmio_;
+  FlashCtrlModel flash_;
+  FunctionalMmio bus_;
+};
+
+TEST_F(FlashCtrlModelTest, DataWriteReadErase) {
+  // Two and a half program windows, starting in the middle of one.
+  constexpr uint32_t kAddr = 0x10000 + 40;
+  std::vector<uint32_t> data(40);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = 0x01020304 * static_cast<uint32_t>(i + 1);
+  }
+  ASSERT_EQ(flash_ctrl_data_write(kAddr, data.size(), data.data()), kErrorOk);
+
+  std::vector<uint32_t> read(data.size());
+  ASSERT_EQ(flash_ctrl_data_read(kAddr, read.size(), read.data()), kErrorOk);
+  EXPECT_THAT(read, ElementsAreArray(data));
+
+  // The same data is visible through the memory window.
+  EXPECT_EQ(abs_mmio_read32(TOP_EARLGREY_FLASH_CTRL_MEM_BASE_ADDR + kAddr),
+            data[0]);
+
+  EXPECT_EQ(flash_ctrl_data_erase_verify(kAddr, kFlashCtrlEraseTypePage),
+            kErrorFlashCtrlDataEraseVerify);
+  ASSERT_EQ(flash_ctrl_data_erase(kAddr, kFlashCtrlEraseTypePage), kErrorOk);
+  EXPECT_EQ(flash_ctrl_data_erase_verify(kAddr, kFlashCtrlEraseTypePage),
+            kErrorOk);
+  ASSERT_EQ(flash_ctrl_data_read(kAddr, read.size(), read.data()), kErrorOk);
+  EXPECT_THAT(read, Each(kFlashCtrlErasedWord));
+}
+
+TEST_F(FlashCtrlModelTest, ProgramClearsBits) {
+  constexpr uint32_t kAddr = 0x800;
+  uint32_t word = 0xff00ff00;
+  ASSERT_EQ(flash_ctrl_data_write(kAddr, 1, &word), kErrorOk);
+  word = 0x0ff00ff0;
+  ASSERT_EQ(flash_ctrl_data_write(kAddr, 1, &word), kErrorOk);
+  ASSERT_EQ(flash_ctrl_data_read(kAddr, 1, &word), kErrorOk);
+  EXPECT_EQ(word, 0x0f000f00);
+}
+
+TEST_F(FlashCtrlModelTest, InfoPage) {
+  std::array<uint32_t, 8> data = {1, 2, 3, 4, 5, 6, 7, 8};
+  ASSERT_EQ(flash_ctrl_info_write(&kFlashCtrlInfoPageBootData1, 0x100,
+                                  data.size(), data.data()),
+            kErrorOk);
+  std::array<uint32_t, 8> read;
+  ASSERT_EQ(flash_ctrl_info_read(&kFlashCtrlInfoPageBootData1, 0x100,
+                                 read.size(), read.data()),
+            kErrorOk);
+  EXPECT_THAT(read, ElementsAreArray(data));
+
+  // Other pages and the data partition are unaffected.
+  ASSERT_EQ(flash_ctrl_info_read(&kFlashCtrlInfoPageBootData0, 0x100,
+                                 read.size(), read.data()),
+            kErrorOk);
+  EXPECT_THAT(read, Each(kFlashCtrlErasedWord));
+  ASSERT_EQ(flash_ctrl_data_read(kFlashCtrlInfoPageBootData1.base_addr + 0x100,
+                                 read.size(), read.data()),
+            kErrorOk);
+  EXPECT_THAT(read, Each(kFlashCtrlErasedWord));
+
+  ASSERT_EQ(flash_ctrl_info_erase(&kFlashCtrlInfoPageBootData1,
+                                  kFlashCtrlEraseTypePage),
+            kErrorOk);
+  ASSERT_EQ(flash_ctrl_info_read(&kFlashCtrlInfoPageBootData1, 0x100,
+                                 read.size(), read.data()),
+            kErrorOk);
+  EXPECT_THAT(read, Each(kFlashCtrlErasedWord));
+}
+
+TEST_F(FlashCtrlModelTest, OutOfRange) {
+  uint32_t word;
+  EXPECT_EQ(flash_ctrl_data_read(TOP_EARLGREY_FLASH_CTRL_MEM_SIZE_BYTES, 1,
+                                 &word),
+            kErrorFlashCtrlDataRead);
+  flash_ctrl_error_code_t error_code;
+  flash_ctrl_error_code_get(&error_code);
+  EXPECT_TRUE(error_code.rd_err);
+}
+
+}  // namespace
+}  // namespace hw_models
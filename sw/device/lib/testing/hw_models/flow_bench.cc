@@ -0,0 +1,109 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Native benchmarks of whole driver flows running against the functional
+// models. Each benchmark checks its result, so it also runs as a regular test;
+// timings are printed and recorded as test properties.
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/mock_abs_mmio.h"
+#include "sw/device/lib/testing/hw_models/flash_ctrl_model.h"
+#include "sw/device/lib/testing/hw_models/hmac_model.h"
+#include "sw/device/lib/testing/hw_models/mmio_model.h"
+#include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
+#include "sw/device/silicon_creator/lib/error.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+
+namespace hw_models {
+namespace {
+using ::testing::ElementsAreArray;
+
+constexpr uint32_t kImageAddr = 0x10000;
+// Size of a ROM_EXT slot.
+constexpr size_t kImageWords = 64 * 1024 / sizeof(uint32_t);
+constexpr int kIterations = 8;
+
+class FlowBench : public testing::TestWithParam<uint32_t> {
+ protected:
+  FlowBench() : image_(kImageWords) {
+    bus_.Attach(TOP_EARLGREY_FLASH_CTRL_CORE_BASE_ADDR,
+                TOP_EARLGREY_FLASH_CTRL_CORE_SIZE_BYTES, &flash_);
+    bus_.Attach(TOP_EARLGREY_FLASH_CTRL_MEM_BASE_ADDR,
+                TOP_EARLGREY_FLASH_CTRL_MEM_SIZE_BYTES, flash_.mem());
+    bus_.Attach(TOP_EARLGREY_HMAC_BASE_ADDR, TOP_EARLGREY_HMAC_SIZE_BYTES,
+                &hmac_);
+    bus_.Bind(mmio_);
+
+    uint32_t x = 0x2545f491;
+    for (uint32_t &word : image_) {
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+      word = x;
+    }
+    flash_.Preload(kImageAddr, image_.data(), image_.size() * sizeof(uint32_t));
+  }
+
+  /**
+   * Reports the mean time per iteration of `fn` in microseconds.
+   */
+  template <typename Fn>
+  void Measure(const std::string &name, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+      fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    int64_t us =
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() /
+        kIterations;
+    printf("%s: %lld us per 64 KiB image\n", name.c_str(),
+           static_cast<long long>(us));
+    RecordProperty(name, std::to_string(us));
+  }
+
+  std::vector<uint32_t> image_;
+  rom_test::NiceMockAbsMmio mmio_;
+  FlashCtrlModel flash_;
+  HmacModel hmac_;
+  FunctionalMmio bus_;
+};
+
+// Reads a ROM_EXT-sized image through the flash controller FIFO in chunks of
+// the given number of words and hashes it, as the ROM_EXT does for images it
+// cannot hash in place.
+TEST_P(FlowBench, FlashReadDigest) {
+  const uint32_t chunk_words = GetParam();
+  hmac_digest_t expected;
+  hmac_sha256(image_.data(), image_.size() * sizeof(uint32_t), &expected);
+
+  hmac_digest_t digest;
+  std::vector<uint32_t> buf(chunk_words);
+  Measure("flash_read_digest_" + std::to_string(chunk_words), [&] {
+    hmac_sha256_init();
+    for (uint32_t i = 0; i < kImageWords; i += chunk_words) {
+      ASSERT_EQ(flash_ctrl_data_read(kImageAddr + i * sizeof(uint32_t),
+                                     chunk_words, buf.data()),
+                kErrorOk);
+      hmac_sha256_update_words(buf.data(), chunk_words);
+    }
+    hmac_sha256_process();
+    hmac_sha256_final(&digest);
+  });
+  EXPECT_THAT(digest.digest, ElementsAreArray(expected.digest));
+}
+
+// 8 words is one flash program window, 512 words one page.
+INSTANTIATE_TEST_SUITE_P(ChunkWords, FlowBench, testing::Values(8, 64, 512));
+
+}  // namespace
+}  // namespace hw_models
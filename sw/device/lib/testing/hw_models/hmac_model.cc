@@ -0,0 +1,312 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/hw_models/hmac_model.h"
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/bitfield.h"
+
+#include "hmac_regs.h"  // Generated.
+
+namespace hw_models {
+namespace {
+
+constexpr std::array<uint32_t, 8> kSha256Iv = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+constexpr uint32_t kSha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+enum {
+  kBlockBytes = 64,
+  kDigestWords = 8,
+  kDigestRegs = 16,
+  kKeyRegs = 16,
+};
+
+uint32_t Rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+}  // namespace
+
+HmacModel::HmacModel() : h_(kSha256Iv) {
+  SetResetValue(HMAC_CFG_REG_OFFSET, HMAC_CFG_REG_RESVAL);
+}
+
+bool HmacModel::Enabled(uint32_t bit) {
+  return bitfield_bit32_read(Reg(HMAC_CFG_REG_OFFSET), bit);
+}
+
+uint32_t HmacModel::Read32(uint32_t offset) {
+  if (offset >= HMAC_DIGEST_0_REG_OFFSET &&
+      offset < HMAC_DIGEST_0_REG_OFFSET + kDigestRegs * sizeof(uint32_t)) {
+    uint32_t i = (offset - HMAC_DIGEST_0_REG_OFFSET) / sizeof(uint32_t);
+    if (i >= kDigestWords) {
+      return 0;
+    }
+    return Enabled(HMAC_CFG_DIGEST_SWAP_BIT) ? __builtin_bswap32(h_[i])
+                                             : h_[i];
+  }
+  switch (offset) {
+    case HMAC_STATUS_REG_OFFSET:
+      // Commands complete immediately, so the block is always idle and the
+      // FIFO always drained.
+      return 1u << HMAC_STATUS_HMAC_IDLE_BIT | 1u << HMAC_STATUS_FIFO_EMPTY_BIT;
+    case HMAC_MSG_LENGTH_LOWER_REG_OFFSET:
+      return static_cast<uint32_t>(msg_bits_);
+    case HMAC_MSG_LENGTH_UPPER_REG_OFFSET:
+      return static_cast<uint32_t>(msg_bits_ >> 32);
+    default:
+      return MmioModel::Read32(offset);
+  }
+}
+
+void HmacModel::Write32(uint32_t offset, uint32_t value) {
+  if (offset >= HMAC_MSG_FIFO_REG_OFFSET &&
+      offset < HMAC_MSG_FIFO_REG_OFFSET + HMAC_MSG_FIFO_SIZE_BYTES) {
+    if (Enabled(HMAC_CFG_ENDIAN_SWAP_BIT)) {
+      value = __builtin_bswap32(value);
+    }
+    for (int i = 0; i < 4; ++i) {
+      Push(static_cast<uint8_t>(value >> (8 * i)));
+    }
+    return;
+  }
+  if (offset >= HMAC_DIGEST_0_REG_OFFSET &&
+      offset < HMAC_DIGEST_0_REG_OFFSET + kDigestWords * sizeof(uint32_t)) {
+    uint32_t i = (offset - HMAC_DIGEST_0_REG_OFFSET) / sizeof(uint32_t);
+    h_[i] = Enabled(HMAC_CFG_DIGEST_SWAP_BIT) ? __builtin_bswap32(value)
+                                              : value;
+    return;
+  }
+  switch (offset) {
+    case HMAC_INTR_STATE_REG_OFFSET:
+      // rw1c.
+      Reg(offset) &= ~value;
+      break;
+    case HMAC_CFG_REG_OFFSET:
+      Configure(value);
+      break;
+    case HMAC_CMD_REG_OFFSET:
+      Command(value);
+      break;
+    case HMAC_WIPE_SECRET_REG_OFFSET:
+      h_.fill(value);
+      for (uint32_t i = 0; i < kKeyRegs; ++i) {
+        Reg(HMAC_KEY_0_REG_OFFSET + i * sizeof(uint32_t)) = value;
+      }
+      break;
+    case HMAC_MSG_LENGTH_LOWER_REG_OFFSET:
+      msg_bits_ = (msg_bits_ & ~uint64_t{UINT32_MAX}) | value;
+      break;
+    case HMAC_MSG_LENGTH_UPPER_REG_OFFSET:
+      msg_bits_ = (msg_bits_ & UINT32_MAX) | uint64_t{value} << 32;
+      break;
+    default:
+      MmioModel::Write32(offset, value);
+      break;
+  }
+}
+
+void HmacModel::Write8(uint32_t offset, uint8_t value) {
+  if (offset >= HMAC_MSG_FIFO_REG_OFFSET &&
+      offset < HMAC_MSG_FIFO_REG_OFFSET + HMAC_MSG_FIFO_SIZE_BYTES) {
+    Push(value);
+    return;
+  }
+  MmioModel::Write8(offset, value);
+}
+
+void HmacModel::Configure(uint32_t cfg) {
+  bool was_enabled = Enabled(HMAC_CFG_SHA_EN_BIT);
+  Reg(HMAC_CFG_REG_OFFSET) = cfg;
+  if (was_enabled && !Enabled(HMAC_CFG_SHA_EN_BIT)) {
+    // Disabling the engine clears the digest.
+    h_.fill(0);
+  }
+  uint32_t digest_size = bitfield_field32_read(cfg, HMAC_CFG_DIGEST_SIZE_FIELD);
+  if (Enabled(HMAC_CFG_SHA_EN_BIT) &&
+      digest_size != HMAC_CFG_DIGEST_SIZE_VALUE_SHA2_256) {
+    ADD_FAILURE() << "HmacModel only models SHA2-256, got digest_size=0x"
+                  << std::hex << digest_size;
+  }
+}
+
+void HmacModel::Command(uint32_t cmd) {
+  if (bitfield_bit32_read(cmd, HMAC_CMD_HASH_START_BIT)) {
+    Start();
+  }
+  if (bitfield_bit32_read(cmd, HMAC_CMD_HASH_CONTINUE_BIT)) {
+    // The partial block is held in the FIFO, so it must still match the
+    // restored message length.
+    if (block_.size() != (msg_bits_ / 8) % kBlockBytes) {
+      if (msg_bits_ % (8 * kBlockBytes) == 0) {
+        block_.clear();
+      } else {
+        ADD_FAILURE() << "HmacModel cannot continue from an unaligned length";
+      }
+    }
+  }
+  if (bitfield_bit32_read(cmd, HMAC_CMD_HASH_PROCESS_BIT)) {
+    Process();
+    Reg(HMAC_INTR_STATE_REG_OFFSET) |= 1u << HMAC_INTR_STATE_HMAC_DONE_BIT;
+  }
+  if (bitfield_bit32_read(cmd, HMAC_CMD_HASH_STOP_BIT)) {
+    // Full blocks are compressed as soon as they are pushed, so the digest
+    // registers already hold the intermediate state.
+    Reg(HMAC_INTR_STATE_REG_OFFSET) |= 1u << HMAC_INTR_STATE_HMAC_DONE_BIT;
+  }
+}
+
+void HmacModel::Push(uint8_t byte) {
+  if (!Enabled(HMAC_CFG_SHA_EN_BIT)) {
+    // Hardware drops the write and raises an error.
+    Reg(HMAC_INTR_STATE_REG_OFFSET) |= 1u << HMAC_INTR_STATE_HMAC_ERR_BIT;
+    return;
+  }
+  msg_bits_ += 8;
+  block_.push_back(byte);
+  if (block_.size() == kBlockBytes) {
+    Compress(block_.data());
+    block_.clear();
+  }
+}
+
+std::array<uint8_t, 64> HmacModel::KeyBlock(uint8_t pad) {
+  uint32_t key_length = bitfield_field32_read(Reg(HMAC_CFG_REG_OFFSET),
+                                              HMAC_CFG_KEY_LENGTH_FIELD);
+  size_t key_words = 0;
+  switch (key_length) {
+    case HMAC_CFG_KEY_LENGTH_VALUE_KEY_128:
+      key_words = 4;
+      break;
+    case HMAC_CFG_KEY_LENGTH_VALUE_KEY_256:
+      key_words = 8;
+      break;
+    case HMAC_CFG_KEY_LENGTH_VALUE_KEY_384:
+      key_words = 12;
+      break;
+    case HMAC_CFG_KEY_LENGTH_VALUE_KEY_512:
+      key_words = 16;
+      break;
+    default:
+      ADD_FAILURE() << "HmacModel: unsupported key_length=0x" << std::hex
+                    << key_length;
+      break;
+  }
+  std::array<uint8_t, 64> block;
+  block.fill(pad);
+  for (size_t i = 0; i < key_words; ++i) {
+    uint32_t word = Reg(HMAC_KEY_0_REG_OFFSET + i * sizeof(uint32_t));
+    // Without `key_swap` each key register is a big-endian word.
+    if (!Enabled(HMAC_CFG_KEY_SWAP_BIT)) {
+      word = __builtin_bswap32(word);
+    }
+    for (size_t j = 0; j < 4; ++j) {
+      block[i * 4 + j] ^= static_cast<uint8_t>(word >> (8 * j));
+    }
+  }
+  return block;
+}
+
+void HmacModel::Start() {
+  h_ = kSha256Iv;
+  block_.clear();
+  msg_bits_ = 0;
+  if (Enabled(HMAC_CFG_HMAC_EN_BIT)) {
+    Compress(KeyBlock(0x36).data());
+  }
+}
+
+void HmacModel::Process() {
+  uint64_t total_bits = msg_bits_;
+  if (Enabled(HMAC_CFG_HMAC_EN_BIT)) {
+    total_bits += 8 * kBlockBytes;
+  }
+  std::vector<uint8_t> tail = block_;
+  tail.push_back(0x80);
+  while (tail.size() % kBlockBytes != kBlockBytes - 8) {
+    tail.push_back(0);
+  }
+  for (int i = 7; i >= 0; --i) {
+    tail.push_back(static_cast<uint8_t>(total_bits >> (8 * i)));
+  }
+  for (size_t i = 0; i < tail.size(); i += kBlockBytes) {
+    Compress(&tail[i]);
+  }
+  block_.clear();
+
+  if (Enabled(HMAC_CFG_HMAC_EN_BIT)) {
+    // Outer hash: H((K ^ opad) || inner digest).
+    uint8_t outer[kBlockBytes] = {0};
+    for (size_t i = 0; i < kDigestWords; ++i) {
+      for (size_t j = 0; j < 4; ++j) {
+        outer[i * 4 + j] = static_cast<uint8_t>(h_[i] >> (24 - 8 * j));
+      }
+    }
+    outer[32] = 0x80;
+    uint64_t outer_bits = 8 * (kBlockBytes + 32);
+    for (int i = 0; i < 8; ++i) {
+      outer[kBlockBytes - 1 - i] = static_cast<uint8_t>(outer_bits >> (8 * i));
+    }
+    h_ = kSha256Iv;
+    Compress(KeyBlock(0x5c).data());
+    Compress(outer);
+  }
+}
+
+void HmacModel::Compress(const uint8_t *block) {
+  uint32_t w[64];
+  for (int i = 0; i < 16; ++i) {
+    w[i] = static_cast<uint32_t>(block[4 * i]) << 24 |
+           static_cast<uint32_t>(block[4 * i + 1]) << 16 |
+           static_cast<uint32_t>(block[4 * i + 2]) << 8 |
+           static_cast<uint32_t>(block[4 * i + 3]);
+  }
+  for (int i = 16; i < 64; ++i) {
+    uint32_t s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+  uint32_t a = h_[0], b = h_[1], c = h_[2], d = h_[3];
+  uint32_t e = h_[4], f = h_[5], g = h_[6], h = h_[7];
+  for (int i = 0; i < 64; ++i) {
+    uint32_t s1 = Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25);
+    uint32_t ch = (e & f) ^ (~e & g);
+    uint32_t t1 = h + s1 + ch + kSha256K[i] + w[i];
+    uint32_t s0 = Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22);
+    uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+    uint32_t t2 = s0 + maj;
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  h_[0] += a;
+  h_[1] += b;
+  h_[2] += c;
+  h_[3] += d;
+  h_[4] += e;
+  h_[5] += f;
+  h_[6] += g;
+  h_[7] += h;
+}
+
+}  // namespace hw_models
@@ -0,0 +1,61 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_HMAC_MODEL_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_HMAC_MODEL_H_
+
+#include <array>
+#include <stdint.h>
+#include <vector>
+
+#include "sw/device/lib/testing/hw_models/mmio_model.h"
+
+namespace hw_models {
+
+/**
+ * Functional model of the HMAC block.
+ *
+ * Models SHA2-256 and HMAC-SHA256, including the byte/word message FIFO, the
+ * `endian_swap`, `digest_swap` and `key_swap` options, and the `stop` /
+ * `continue` commands used to save and restore an in-progress hash through
+ * the digest and message-length registers. Commands complete immediately, so
+ * `hmac_done` is raised as soon as `process` or `stop` is written.
+ *
+ * SHA2-384/512 digest sizes are not modelled and are reported as failures.
+ */
+class HmacModel : public MmioModel {
+ public:
+  HmacModel();
+
+  uint32_t Read32(uint32_t offset) override;
+  void Write32(uint32_t offset, uint32_t value) override;
+  void Write8(uint32_t offset, uint8_t value) override;
+
+ private:
+  void Configure(uint32_t cfg);
+  void Command(uint32_t cmd);
+  void Push(uint8_t byte);
+  void Compress(const uint8_t *block);
+  void Start();
+  void Process();
+  bool Enabled(uint32_t bit);
+  std::array<uint8_t, 64> KeyBlock(uint8_t pad);
+
+  /**
+   * Intermediate hash value, as SHA-256 words.
+   */
+  std::array<uint32_t, 8> h_;
+  /**
+   * Bytes of the current, incomplete block.
+   */
+  std::vector<uint8_t> block_;
+  /**
+   * Number of message bits written to the FIFO since `start`.
+   */
+  uint64_t msg_bits_ = 0;
+};
+
+}  // namespace hw_models
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_HMAC_MODEL_H_
@@ -0,0 +1,147 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/hw_models/hmac_model.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/abs_mmio.h"
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/mock_abs_mmio.h"
+#include "sw/device/lib/testing/hw_models/mmio_model.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
+
+#include "hmac_regs.h"  // Generated.
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+
+namespace hw_models {
+namespace {
+using ::testing::ElementsAreArray;
+
+// SHA-256("abc"), as the little-endian words returned by `hmac_sha256_final`.
+constexpr std::array<uint32_t, 8> kAbcDigest = {
+    0xf20015ad, 0xb410ff61, 0x96177a9c, 0xb00361a3,
+    0x5dae2223, 0x414140de, 0x8f01cfea, 0xba7816bf,
+};
+
+// SHA-256 of one million 'a' characters (FIPS 180-2, appendix B.3).
+constexpr std::array<uint32_t, 8> kMillionADigest = {
+    0xc7112cd0, 0x046d39cc, 0xa497200e, 0xf1809a48,
+    0x84d73e67, 0x81a1c7e2, 0x9914fb92, 0xcdc76e5c,
+};
+
+class HmacModelTest : public testing::Test {
+ protected:
+  HmacModelTest() {
+    bus_.Attach(TOP_EARLGREY_HMAC_BASE_ADDR, TOP_EARLGREY_HMAC_SIZE_BYTES,
+                &hmac_);
+    bus_.Bind(mmio_);
+  }
+
+  rom_test::NiceMockAbsMmio mmio_;
+  HmacModel hmac_;
+  FunctionalMmio bus_;
+};
+
+TEST_F(HmacModelTest, Sha256) {
+  hmac_digest_t digest;
+  hmac_sha256("abc", 3, &digest);
+  EXPECT_THAT(digest.digest, ElementsAreArray(kAbcDigest));
+}
+
+TEST_F(HmacModelTest, Sha256BigEndianDigest) {
+  hmac_sha256_configure(/*big_endian_digest=*/true);
+  hmac_sha256_start();
+  hmac_sha256_update("abc", 3);
+  hmac_sha256_process();
+  hmac_digest_t digest;
+  hmac_sha256_final(&digest);
+  for (size_t i = 0; i < kAbcDigest.size(); ++i) {
+    EXPECT_EQ(digest.digest[i],
+              __builtin_bswap32(kAbcDigest[kAbcDigest.size() - 1 - i]));
+  }
+}
+
+TEST_F(HmacModelTest, Sha256Streaming) {
+  // Feed the message in odd-sized, misaligned chunks to exercise both the
+  // byte and word paths of `hmac_sha256_update`.
+  std::string buf(1000000 + 1, 'a');
+  const char *msg = buf.data() + 1;
+  size_t remaining = 1000000;
+  hmac_sha256_init();
+  for (size_t chunk = 1; remaining > 0; chunk = chunk * 3 % 4093 + 1) {
+    size_t len = chunk < remaining ? chunk : remaining;
+    hmac_sha256_update(msg, len);
+    msg += len;
+    remaining -= len;
+  }
+  hmac_sha256_process();
+  hmac_digest_t digest;
+  hmac_sha256_final(&digest);
+  EXPECT_THAT(digest.digest, ElementsAreArray(kMillionADigest));
+}
+
+TEST_F(HmacModelTest, SaveRestore) {
+  std::vector<uint8_t> msg(256);
+  for (size_t i = 0; i < msg.size(); ++i) {
+    msg[i] = static_cast<uint8_t>(i);
+  }
+  hmac_digest_t expected;
+  hmac_sha256(msg.data(), msg.size(), &expected);
+
+  // Interrupt the hash after two blocks and run another hash in between.
+  hmac_sha256_init();
+  hmac_sha256_update(msg.data(), 128);
+  hmac_context_t ctx;
+  hmac_sha256_save(&ctx);
+
+  hmac_digest_t other;
+  hmac_sha256("abc", 3, &other);
+  EXPECT_THAT(other.digest, ElementsAreArray(kAbcDigest));
+
+  hmac_sha256_restore(&ctx);
+  hmac_sha256_update(msg.data() + 128, msg.size() - 128);
+  hmac_sha256_process();
+  hmac_digest_t digest;
+  hmac_sha256_final(&digest);
+  EXPECT_THAT(digest.digest, ElementsAreArray(expected.digest));
+}
+
+TEST_F(HmacModelTest, HmacSha256) {
+  // RFC 4231, test case 2: key "Jefe", zero-padded to 256 bits.
+  constexpr std::array<uint32_t, 8> kExpected = {
+      0x5bdcc146, 0xbf60754e, 0x6a042426, 0x089575c7,
+      0x5a003f08, 0x9d273983, 0x9dec58b9, 0x64ec3843,
+  };
+  uint32_t base = TOP_EARLGREY_HMAC_BASE_ADDR;
+  uint32_t cfg = 0;
+  cfg = bitfield_bit32_write(cfg, HMAC_CFG_HMAC_EN_BIT, true);
+  cfg = bitfield_bit32_write(cfg, HMAC_CFG_SHA_EN_BIT, true);
+  cfg = bitfield_bit32_write(cfg, HMAC_CFG_DIGEST_SWAP_BIT, true);
+  cfg = bitfield_field32_write(cfg, HMAC_CFG_DIGEST_SIZE_FIELD,
+                               HMAC_CFG_DIGEST_SIZE_VALUE_SHA2_256);
+  cfg = bitfield_field32_write(cfg, HMAC_CFG_KEY_LENGTH_FIELD,
+                               HMAC_CFG_KEY_LENGTH_VALUE_KEY_256);
+  abs_mmio_write32(base + HMAC_CFG_REG_OFFSET, cfg);
+  abs_mmio_write32(base + HMAC_KEY_0_REG_OFFSET, 0x4a656665);
+  for (uint32_t i = 1; i < 8; ++i) {
+    abs_mmio_write32(base + HMAC_KEY_0_REG_OFFSET + i * sizeof(uint32_t), 0);
+  }
+  hmac_sha256_start();
+  hmac_sha256_update("what do ya want for nothing?", 28);
+  hmac_sha256_process();
+
+  std::array<uint32_t, 8> digest;
+  hmac_sha256_final_truncated(digest.data(), digest.size());
+  for (size_t i = 0; i < digest.size(); ++i) {
+    digest[i] = __builtin_bswap32(digest[i]);
+  }
+  EXPECT_THAT(digest, ElementsAreArray(kExpected));
+}
+
+}  // namespace
+}  // namespace hw_models
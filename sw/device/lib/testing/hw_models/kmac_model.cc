@@ -0,0 +1,333 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/hw_models/kmac_model.h"
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/bitfield.h"
+
+#include "kmac_regs.h"  // Generated.
+
+namespace hw_models {
+namespace {
+
+constexpr uint64_t kRoundConstants[24] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a,
+    0x8000000080008000, 0x000000000000808b, 0x0000000080000001,
+    0x8000000080008081, 0x8000000000008009, 0x000000000000008a,
+    0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+    0x000000008000808b, 0x800000000000008b, 0x8000000000008089,
+    0x8000000000008003, 0x8000000000008002, 0x8000000000000080,
+    0x000000000000800a, 0x800000008000000a, 0x8000000080008081,
+    0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+};
+
+constexpr int kRotations[25] = {
+    0,  1,  62, 28, 27, 36, 44, 6,  55, 20, 3,  10, 43,
+    25, 39, 41, 45, 15, 21, 8,  18, 2,  61, 56, 14,
+};
+
+enum {
+  kStateShareBytes = KMAC_STATE_SIZE_BYTES / 2,
+  kPrefixBytes = KMAC_PREFIX_MULTIREG_COUNT * sizeof(uint32_t),
+};
+
+uint64_t Rotl(uint64_t x, int n) { return n == 0 ? x : x << n | x >> (64 - n); }
+
+/**
+ * `left_encode` from NIST SP 800-185, section 2.3.1.
+ */
+std::vector<uint8_t> LeftEncode(uint64_t value) {
+  std::vector<uint8_t> out;
+  do {
+    out.insert(out.begin(), static_cast<uint8_t>(value));
+    value >>= 8;
+  } while (value != 0);
+  out.insert(out.begin(), static_cast<uint8_t>(out.size()));
+  return out;
+}
+
+}  // namespace
+
+KmacModel::KmacModel() {
+  SetResetValue(KMAC_CFG_REGWEN_REG_OFFSET, KMAC_CFG_REGWEN_REG_RESVAL);
+}
+
+bool KmacModel::CfgBit(uint32_t bit) {
+  return bitfield_bit32_read(Reg(KMAC_CFG_SHADOWED_REG_OFFSET), bit);
+}
+
+size_t KmacModel::RateBytes() {
+  switch (bitfield_field32_read(Reg(KMAC_CFG_SHADOWED_REG_OFFSET),
+                                KMAC_CFG_SHADOWED_KSTRENGTH_FIELD)) {
+    case KMAC_CFG_SHADOWED_KSTRENGTH_VALUE_L128:
+      return 168;
+    case KMAC_CFG_SHADOWED_KSTRENGTH_VALUE_L224:
+      return 144;
+    case KMAC_CFG_SHADOWED_KSTRENGTH_VALUE_L256:
+      return 136;
+    case KMAC_CFG_SHADOWED_KSTRENGTH_VALUE_L384:
+      return 104;
+    case KMAC_CFG_SHADOWED_KSTRENGTH_VALUE_L512:
+      return 72;
+    default:
+      ADD_FAILURE() << "KmacModel: invalid kstrength";
+      return 136;
+  }
+}
+
+std::vector<uint8_t> KmacModel::Key() {
+  if (CfgBit(KMAC_CFG_SHADOWED_SIDELOAD_BIT)) {
+    return sideload_key_;
+  }
+  size_t key_bytes = 0;
+  switch (bitfield_field32_read(Reg(KMAC_KEY_LEN_REG_OFFSET),
+                                KMAC_KEY_LEN_LEN_FIELD)) {
+    case KMAC_KEY_LEN_LEN_VALUE_KEY128:
+      key_bytes = 16;
+      break;
+    case KMAC_KEY_LEN_LEN_VALUE_KEY192:
+      key_bytes = 24;
+      break;
+    case KMAC_KEY_LEN_LEN_VALUE_KEY256:
+      key_bytes = 32;
+      break;
+    case KMAC_KEY_LEN_LEN_VALUE_KEY384:
+      key_bytes = 48;
+      break;
+    case KMAC_KEY_LEN_LEN_VALUE_KEY512:
+      key_bytes = 64;
+      break;
+    default:
+      ADD_FAILURE() << "KmacModel: invalid key_len";
+      break;
+  }
+  std::vector<uint8_t> key;
+  for (size_t i = 0; i < key_bytes; i += sizeof(uint32_t)) {
+    uint32_t word = Reg(KMAC_KEY_SHARE0_0_REG_OFFSET + i) ^
+                    Reg(KMAC_KEY_SHARE1_0_REG_OFFSET + i);
+    for (size_t j = 0; j < sizeof(uint32_t); ++j) {
+      key.push_back(static_cast<uint8_t>(word >> (8 * j)));
+    }
+  }
+  return key;
+}
+
+uint32_t KmacModel::Read32(uint32_t offset) {
+  if (offset >= KMAC_STATE_REG_OFFSET &&
+      offset < KMAC_STATE_REG_OFFSET + KMAC_STATE_SIZE_BYTES) {
+    uint32_t byte = offset - KMAC_STATE_REG_OFFSET;
+    if (byte >= kStateShareBytes || byte >= sizeof(lanes_)) {
+      return 0;
+    }
+    uint64_t lane = lanes_[byte / sizeof(uint64_t)];
+    uint32_t word = static_cast<uint32_t>(lane >> (8 * (byte % 8)));
+    return CfgBit(KMAC_CFG_SHADOWED_STATE_ENDIANNESS_BIT)
+               ? __builtin_bswap32(word)
+               : word;
+  }
+  if (offset == KMAC_STATUS_REG_OFFSET) {
+    uint32_t status = 1u << KMAC_STATUS_FIFO_EMPTY_BIT;
+    switch (state_) {
+      case State::kIdle:
+        return status | 1u << KMAC_STATUS_SHA3_IDLE_BIT;
+      case State::kAbsorb:
+        return status | 1u << KMAC_STATUS_SHA3_ABSORB_BIT;
+      case State::kSqueeze:
+        return status | 1u << KMAC_STATUS_SHA3_SQUEEZE_BIT;
+    }
+  }
+  return MmioModel::Read32(offset);
+}
+
+void KmacModel::Write32(uint32_t offset, uint32_t value) {
+  if (offset >= KMAC_MSG_FIFO_REG_OFFSET &&
+      offset < KMAC_MSG_FIFO_REG_OFFSET + KMAC_MSG_FIFO_SIZE_BYTES) {
+    if (CfgBit(KMAC_CFG_SHADOWED_MSG_ENDIANNESS_BIT)) {
+      value = __builtin_bswap32(value);
+    }
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+      Absorb(static_cast<uint8_t>(value >> (8 * i)));
+    }
+    return;
+  }
+  switch (offset) {
+    case KMAC_INTR_STATE_REG_OFFSET:
+      // rw1c.
+      Reg(offset) &= ~value;
+      break;
+    case KMAC_CMD_REG_OFFSET:
+      Command(value);
+      break;
+    default:
+      MmioModel::Write32(offset, value);
+      break;
+  }
+}
+
+void KmacModel::Write8(uint32_t offset, uint8_t value) {
+  if (offset >= KMAC_MSG_FIFO_REG_OFFSET &&
+      offset < KMAC_MSG_FIFO_REG_OFFSET + KMAC_MSG_FIFO_SIZE_BYTES) {
+    Absorb(value);
+    return;
+  }
+  MmioModel::Write8(offset, value);
+}
+
+void KmacModel::Command(uint32_t cmd) {
+  uint32_t op = bitfield_field32_read(cmd, KMAC_CMD_CMD_FIELD);
+  State expected = State::kIdle;
+  switch (op) {
+    case 0:
+      return;
+    case KMAC_CMD_CMD_VALUE_START:
+      expected = State::kIdle;
+      break;
+    case KMAC_CMD_CMD_VALUE_PROCESS:
+      expected = State::kAbsorb;
+      break;
+    case KMAC_CMD_CMD_VALUE_RUN:
+    case KMAC_CMD_CMD_VALUE_DONE:
+      expected = State::kSqueeze;
+      break;
+    default:
+      ADD_FAILURE() << "KmacModel: invalid command 0x" << std::hex << op;
+      return;
+  }
+  if (state_ != expected) {
+    // Hardware reports a software command sequence error.
+    Reg(KMAC_INTR_STATE_REG_OFFSET) |= 1u << KMAC_INTR_STATE_KMAC_ERR_BIT;
+    return;
+  }
+  switch (op) {
+    case KMAC_CMD_CMD_VALUE_START:
+      Start();
+      break;
+    case KMAC_CMD_CMD_VALUE_PROCESS:
+      Process();
+      break;
+    case KMAC_CMD_CMD_VALUE_RUN:
+      Permute();
+      break;
+    case KMAC_CMD_CMD_VALUE_DONE:
+      lanes_.fill(0);
+      pos_ = 0;
+      state_ = State::kIdle;
+      break;
+  }
+}
+
+void KmacModel::Start() {
+  lanes_.fill(0);
+  pos_ = 0;
+  state_ = State::kAbsorb;
+  uint32_t mode = bitfield_field32_read(Reg(KMAC_CFG_SHADOWED_REG_OFFSET),
+                                        KMAC_CFG_SHADOWED_MODE_FIELD);
+  if (mode != KMAC_CFG_SHADOWED_MODE_VALUE_CSHAKE) {
+    return;
+  }
+  // The prefix registers hold `encode_string(N) || encode_string(S)`; the
+  // hardware absorbs all of them, relying on `bytepad` to zero-fill.
+  std::vector<uint8_t> prefix;
+  for (size_t i = 0; i < kPrefixBytes; i += sizeof(uint32_t)) {
+    uint32_t word = Reg(KMAC_PREFIX_0_REG_OFFSET + i);
+    for (size_t j = 0; j < sizeof(uint32_t); ++j) {
+      prefix.push_back(static_cast<uint8_t>(word >> (8 * j)));
+    }
+  }
+  AbsorbPadded(prefix);
+  if (CfgBit(KMAC_CFG_SHADOWED_KMAC_EN_BIT)) {
+    std::vector<uint8_t> key = Key();
+    std::vector<uint8_t> encoded = LeftEncode(key.size() * 8);
+    encoded.insert(encoded.end(), key.begin(), key.end());
+    AbsorbPadded(encoded);
+  }
+}
+
+void KmacModel::Process() {
+  uint32_t mode = bitfield_field32_read(Reg(KMAC_CFG_SHADOWED_REG_OFFSET),
+                                        KMAC_CFG_SHADOWED_MODE_FIELD);
+  uint8_t pad = 0;
+  switch (mode) {
+    case KMAC_CFG_SHADOWED_MODE_VALUE_SHA3:
+      pad = 0x06;
+      break;
+    case KMAC_CFG_SHADOWED_MODE_VALUE_SHAKE:
+      pad = 0x1f;
+      break;
+    case KMAC_CFG_SHADOWED_MODE_VALUE_CSHAKE:
+      pad = 0x04;
+      break;
+    default:
+      ADD_FAILURE() << "KmacModel: invalid mode";
+      break;
+  }
+  lanes_[pos_ / 8] ^= uint64_t{pad} << (8 * (pos_ % 8));
+  size_t last = RateBytes() - 1;
+  lanes_[last / 8] ^= uint64_t{0x80} << (8 * (last % 8));
+  Permute();
+  pos_ = 0;
+  state_ = State::kSqueeze;
+  Reg(KMAC_INTR_STATE_REG_OFFSET) |= 1u << KMAC_INTR_STATE_KMAC_DONE_BIT;
+}
+
+void KmacModel::Absorb(uint8_t byte) {
+  if (state_ != State::kAbsorb) {
+    Reg(KMAC_INTR_STATE_REG_OFFSET) |= 1u << KMAC_INTR_STATE_KMAC_ERR_BIT;
+    return;
+  }
+  lanes_[pos_ / 8] ^= uint64_t{byte} << (8 * (pos_ % 8));
+  if (++pos_ == RateBytes()) {
+    Permute();
+    pos_ = 0;
+  }
+}
+
+void KmacModel::AbsorbPadded(const std::vector<uint8_t> &bytes) {
+  // `bytepad(bytes, rate)` from NIST SP 800-185, section 2.3.3.
+  std::vector<uint8_t> padded = LeftEncode(RateBytes());
+  padded.insert(padded.end(), bytes.begin(), bytes.end());
+  while (padded.size() % RateBytes() != 0) {
+    padded.push_back(0);
+  }
+  for (uint8_t byte : padded) {
+    Absorb(byte);
+  }
+}
+
+void KmacModel::Permute() {
+  uint64_t *a = lanes_.data();
+  for (int round = 0; round < 24; ++round) {
+    // Theta.
+    uint64_t c[5], d[5];
+    for (int x = 0; x < 5; ++x) {
+      c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+    }
+    for (int x = 0; x < 5; ++x) {
+      d[x] = c[(x + 4) % 5] ^ Rotl(c[(x + 1) % 5], 1);
+    }
+    for (int i = 0; i < 25; ++i) {
+      a[i] ^= d[i % 5];
+    }
+    // Rho and pi.
+    uint64_t b[25];
+    for (int x = 0; x < 5; ++x) {
+      for (int y = 0; y < 5; ++y) {
+        b[y + 5 * ((2 * x + 3 * y) % 5)] =
+            Rotl(a[x + 5 * y], kRotations[x + 5 * y]);
+      }
+    }
+    // Chi.
+    for (int y = 0; y < 5; ++y) {
+      for (int x = 0; x < 5; ++x) {
+        a[x + 5 * y] = b[x + 5 * y] ^
+                       (~b[(x + 1) % 5 + 5 * y] & b[(x + 2) % 5 + 5 * y]);
+      }
+    }
+    // Iota.
+    a[0] ^= kRoundConstants[round];
+  }
+}
+
+}  // namespace hw_models
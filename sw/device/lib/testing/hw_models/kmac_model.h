@@ -0,0 +1,75 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_KMAC_MODEL_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_KMAC_MODEL_H_
+
+#include <array>
+#include <stdint.h>
+#include <vector>
+
+#include "sw/device/lib/testing/hw_models/mmio_model.h"
+
+namespace hw_models {
+
+/**
+ * Functional model of the KMAC block.
+ *
+ * Models SHA3, SHAKE, cSHAKE and KMAC at every strength the `kstrength` field
+ * selects, with keys coming either from the key share registers or from the
+ * keymgr sideload interface (see `SetSideloadKey`). The Keccak state is kept
+ * unmasked: share 0 of the `STATE` window holds the state and share 1 reads
+ * as zero, which software cannot distinguish from a masked state since it
+ * only ever reads the XOR of both shares.
+ *
+ * Commands complete immediately and entropy configuration is accepted but
+ * ignored.
+ */
+class KmacModel : public MmioModel {
+ public:
+  KmacModel();
+
+  uint32_t Read32(uint32_t offset) override;
+  void Write32(uint32_t offset, uint32_t value) override;
+  void Write8(uint32_t offset, uint8_t value) override;
+
+  /**
+   * Sets the key presented on the keymgr sideload interface.
+   *
+   * Used instead of the key share registers when `CFG.sideload` is set.
+   */
+  void SetSideloadKey(const std::vector<uint8_t> &key) { sideload_key_ = key; }
+
+ private:
+  enum class State {
+    kIdle,
+    kAbsorb,
+    kSqueeze,
+  };
+
+  void Command(uint32_t cmd);
+  void Start();
+  void Process();
+  void Absorb(uint8_t byte);
+  void AbsorbPadded(const std::vector<uint8_t> &bytes);
+  void Permute();
+  bool CfgBit(uint32_t bit);
+  size_t RateBytes();
+  std::vector<uint8_t> Key();
+
+  /**
+   * Keccak state, as 25 little-endian lanes.
+   */
+  std::array<uint64_t, 25> lanes_{};
+  /**
+   * Byte position within the rate of the next absorbed byte.
+   */
+  size_t pos_ = 0;
+  State state_ = State::kIdle;
+  std::vector<uint8_t> sideload_key_;
+};
+
+}  // namespace hw_models
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_KMAC_MODEL_H_
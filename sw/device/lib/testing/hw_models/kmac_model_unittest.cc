@@ -0,0 +1,120 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/hw_models/kmac_model.h"
+
+#include <array>
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/mock_abs_mmio.h"
+#include "sw/device/lib/testing/hw_models/mmio_model.h"
+#include "sw/device/silicon_creator/lib/drivers/kmac.h"
+#include "sw/device/silicon_creator/lib/error.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+
+namespace hw_models {
+namespace {
+using ::testing::ElementsAreArray;
+
+class KmacModelTest : public testing::Test {
+ protected:
+  KmacModelTest() {
+    bus_.Attach(TOP_EARLGREY_KMAC_BASE_ADDR, TOP_EARLGREY_KMAC_SIZE_BYTES,
+                &kmac_);
+    bus_.Bind(mmio_);
+  }
+
+  rom_test::NiceMockAbsMmio mmio_;
+  KmacModel kmac_;
+  FunctionalMmio bus_;
+};
+
+TEST_F(KmacModelTest, Shake256Empty) {
+  // SHAKE256(""), first 256 bits.
+  constexpr std::array<uint32_t, 8> kExpected = {
+      0x2bddb946, 0x138da80b, 0xeb3f3b23, 0x24eb3e74,
+      0xea52cd3f, 0x821bb862, 0x64270cb5, 0x2f76d56e,
+  };
+  ASSERT_EQ(kmac_shake256_configure(), kErrorOk);
+  ASSERT_EQ(kmac_shake256_start(), kErrorOk);
+  kmac_shake256_squeeze_start();
+  std::array<uint32_t, 8> out;
+  ASSERT_EQ(kmac_shake256_squeeze_end(out.data(), out.size()), kErrorOk);
+  EXPECT_THAT(out, ElementsAreArray(kExpected));
+}
+
+TEST_F(KmacModelTest, Shake256MultiBlock) {
+  // Absorb and squeeze more than one rate's worth (136 bytes) of data, split
+  // across byte- and word-sized writes, and check that the result does not
+  // depend on how the message was split.
+  std::vector<uint8_t> msg(1000);
+  for (size_t i = 0; i < msg.size(); ++i) {
+    msg[i] = static_cast<uint8_t>(i * 7);
+  }
+  std::array<uint32_t, 80> expected;
+  ASSERT_EQ(kmac_shake256_configure(), kErrorOk);
+  ASSERT_EQ(kmac_shake256_start(), kErrorOk);
+  kmac_shake256_absorb(msg.data(), msg.size());
+  kmac_shake256_squeeze_start();
+  ASSERT_EQ(kmac_shake256_squeeze_end(expected.data(), expected.size()),
+            kErrorOk);
+
+  std::array<uint32_t, 80> out;
+  ASSERT_EQ(kmac_shake256_start(), kErrorOk);
+  kmac_shake256_absorb(msg.data(), 3);
+  kmac_shake256_absorb(msg.data() + 3, 501);
+  kmac_shake256_absorb(msg.data() + 504, msg.size() - 504);
+  kmac_shake256_squeeze_start();
+  ASSERT_EQ(kmac_shake256_squeeze_end(out.data(), out.size()), kErrorOk);
+  EXPECT_THAT(out, ElementsAreArray(expected));
+}
+
+TEST_F(KmacModelTest, Kmac256) {
+  // NIST SP 800-185 KMAC sample #6: KMAC256 with a 256-bit key, a 200-byte
+  // message, customization string "My Tagged Application" and a 512-bit
+  // output.
+  constexpr std::array<uint8_t, 64> kExpected = {
+      0xb5, 0x86, 0x18, 0xf7, 0x1f, 0x92, 0xe1, 0xd5, 0x6c, 0x1b, 0x8c,
+      0x55, 0xdd, 0xd7, 0xcd, 0x18, 0x8b, 0x97, 0xb4, 0xca, 0x4d, 0x99,
+      0x83, 0x1e, 0xb2, 0x69, 0x9a, 0x83, 0x7d, 0xa2, 0xe4, 0xd9, 0x70,
+      0xfb, 0xac, 0xfd, 0xe5, 0x00, 0x33, 0xae, 0xa5, 0x85, 0xf1, 0xa2,
+      0x70, 0x85, 0x10, 0xc3, 0x2d, 0x07, 0x88, 0x08, 0x01, 0xbd, 0x18,
+      0x28, 0x98, 0xfe, 0x47, 0x68, 0x76, 0xfc, 0x89, 0x65,
+  };
+  std::array<uint32_t, 8> key;
+  for (size_t i = 0; i < key.size(); ++i) {
+    uint32_t b = static_cast<uint32_t>(0x40 + 4 * i);
+    key[i] = b | (b + 1) << 8 | (b + 2) << 16 | (b + 3) << 24;
+  }
+  std::vector<uint8_t> msg(200);
+  for (size_t i = 0; i < msg.size(); ++i) {
+    msg[i] = static_cast<uint8_t>(i);
+  }
+  const char kCustomization[] = "My Tagged Application";
+
+  ASSERT_EQ(kmac_kmac256_sw_configure(), kErrorOk);
+  ASSERT_EQ(kmac_kmac256_sw_key(key.data(), key.size()), kErrorOk);
+  kmac_kmac256_set_prefix(kCustomization, sizeof(kCustomization) - 1);
+  ASSERT_EQ(kmac_kmac256_start(), kErrorOk);
+  kmac_kmac256_absorb(msg.data(), msg.size());
+  std::array<uint32_t, 16> out;
+  ASSERT_EQ(kmac_kmac256_final(out.data(), out.size()), kErrorOk);
+  EXPECT_EQ(memcmp(out.data(), kExpected.data(), kExpected.size()), 0);
+}
+
+TEST_F(KmacModelTest, CommandSequenceError) {
+  ASSERT_EQ(kmac_shake256_configure(), kErrorOk);
+  // Squeezing without starting is a software error, which the driver reports
+  // when it next polls the status.
+  kmac_shake256_squeeze_start();
+  std::array<uint32_t, 8> out;
+  EXPECT_EQ(kmac_shake256_squeeze_end(out.data(), out.size()),
+            kErrorKmacInvalidStatus);
+}
+
+}  // namespace
+}  // namespace hw_models
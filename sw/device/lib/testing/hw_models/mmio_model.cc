@@ -0,0 +1,103 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/hw_models/mmio_model.h"
+
+#include "gtest/gtest.h"
+
+namespace hw_models {
+
+uint32_t MmioModel::Read32(uint32_t offset) { return regs_[offset]; }
+
+void MmioModel::Write32(uint32_t offset, uint32_t value) {
+  regs_[offset] = value;
+}
+
+uint8_t MmioModel::Read8(uint32_t offset) {
+  uint32_t shift = (offset & 3) * 8;
+  return static_cast<uint8_t>(Read32(offset & ~3u) >> shift);
+}
+
+void MmioModel::Write8(uint32_t offset, uint8_t value) {
+  uint32_t word_offset = offset & ~3u;
+  uint32_t shift = (offset & 3) * 8;
+  uint32_t word = Read32(word_offset);
+  word &= ~(0xffu << shift);
+  word |= static_cast<uint32_t>(value) << shift;
+  Write32(word_offset, word);
+}
+
+void MmioModel::SetResetValue(uint32_t offset, uint32_t value) {
+  regs_[offset] = value;
+}
+
+void FunctionalMmio::Attach(uint32_t base, uint32_t size, MmioModel *model) {
+  mappings_.push_back({base, size, model});
+}
+
+const FunctionalMmio::Mapping *FunctionalMmio::Decode(uint32_t addr) const {
+  for (const Mapping &m : mappings_) {
+    if (addr >= m.base && addr - m.base < m.size) {
+      return &m;
+    }
+  }
+  ADD_FAILURE() << "Access to unmapped address 0x" << std::hex << addr;
+  return nullptr;
+}
+
+uint32_t FunctionalMmio::Read32(uint32_t addr) {
+  const Mapping *m = Decode(addr);
+  return m == nullptr ? 0 : m->model->Read32(addr - m->base);
+}
+
+void FunctionalMmio::Write32(uint32_t addr, uint32_t value) {
+  const Mapping *m = Decode(addr);
+  if (m != nullptr) {
+    m->model->Write32(addr - m->base, value);
+  }
+}
+
+uint8_t FunctionalMmio::Read8(uint32_t addr) {
+  const Mapping *m = Decode(addr);
+  return m == nullptr ? 0 : m->model->Read8(addr - m->base);
+}
+
+void FunctionalMmio::Write8(uint32_t addr, uint8_t value) {
+  const Mapping *m = Decode(addr);
+  if (m != nullptr) {
+    m->model->Write8(addr - m->base, value);
+  }
+}
+
+void FunctionalMmio::Bind(rom_test::internal::MockAbsMmio &mock) {
+  using ::testing::_;
+  using ::testing::Invoke;
+  Bind32(mock);
+  ON_CALL(mock, Read8(_)).WillByDefault(Invoke(this, &FunctionalMmio::Read8));
+  ON_CALL(mock, Write8(_, _))
+      .WillByDefault(Invoke(this, &FunctionalMmio::Write8));
+  ON_CALL(mock, Write8Shadowed(_, _))
+      .WillByDefault(Invoke(this, &FunctionalMmio::Write8));
+}
+
+void FunctionalMmio::Bind(mock_mmio::MockDevice &dev, uint32_t base) {
+  using ::testing::_;
+  using ::testing::Invoke;
+  ON_CALL(dev, Read32(_)).WillByDefault(Invoke([this, base](ptrdiff_t offset) {
+    return Read32(base + static_cast<uint32_t>(offset));
+  }));
+  ON_CALL(dev, Write32(_, _))
+      .WillByDefault(Invoke([this, base](ptrdiff_t offset, uint32_t value) {
+        Write32(base + static_cast<uint32_t>(offset), value);
+      }));
+  ON_CALL(dev, Read8(_)).WillByDefault(Invoke([this, base](ptrdiff_t offset) {
+    return Read8(base + static_cast<uint32_t>(offset));
+  }));
+  ON_CALL(dev, Write8(_, _))
+      .WillByDefault(Invoke([this, base](ptrdiff_t offset, uint8_t value) {
+        Write8(base + static_cast<uint32_t>(offset), value);
+      }));
+}
+
+}  // namespace hw_models
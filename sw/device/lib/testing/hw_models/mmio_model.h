@@ -0,0 +1,141 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_MMIO_MODEL_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_MMIO_MODEL_H_
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "sw/device/lib/base/mock_abs_mmio.h"
+#include "sw/device/lib/base/mock_mmio.h"
+
+namespace hw_models {
+
+/**
+ * Behavioural model of a memory-mapped peripheral.
+ *
+ * Subclasses override `Read32` / `Write32` for the registers they model and
+ * defer to this base class for everything else, which behaves like plain
+ * read/write storage initialized from `SetResetValue`.
+ *
+ * All offsets are relative to the base address the model is attached at.
+ */
+class MmioModel {
+ public:
+  virtual ~MmioModel() = default;
+
+  virtual uint32_t Read32(uint32_t offset);
+  virtual void Write32(uint32_t offset, uint32_t value);
+
+  /**
+   * Byte accesses.
+   *
+   * The default implementation is a read-modify-write of the containing word;
+   * FIFO windows that accept byte writes must override `Write8`.
+   */
+  virtual uint8_t Read8(uint32_t offset);
+  virtual void Write8(uint32_t offset, uint8_t value);
+
+ protected:
+  /**
+   * Sets the value a register reads as before it is first written.
+   */
+  void SetResetValue(uint32_t offset, uint32_t value);
+
+  /**
+   * Direct access to the backing storage of a register.
+   */
+  uint32_t &Reg(uint32_t offset) { return regs_[offset]; }
+
+ private:
+  std::unordered_map<uint32_t, uint32_t> regs_;
+};
+
+/**
+ * A bus of functional models behind the `abs_mmio` API.
+ *
+ * Unlike `rom_test::MockAbsMmio`, which checks exact register sequences, this
+ * routes every access to a model that computes real results, so that whole
+ * flows (e.g. hashing a ROM_EXT image) can run natively and be benchmarked.
+ *
+ * Usage:
+ *
+ *     rom_test::NiceMockAbsMmio abs_mmio;
+ *     hw_models::HmacModel hmac;
+ *     hw_models::FunctionalMmio bus;
+ *     bus.Attach(TOP_EARLGREY_HMAC_BASE_ADDR, TOP_EARLGREY_HMAC_SIZE_BYTES,
+ *                &hmac);
+ *     bus.Bind(abs_mmio);
+ *
+ * DIF-based code, which goes through `mmio_region_t`, is served by binding a
+ * `testing::NiceMock<mock_mmio::MockDevice>` per peripheral instead.
+ *
+ * Accesses that do not hit an attached model are reported as test failures.
+ */
+class FunctionalMmio {
+ public:
+  /**
+   * Maps `model` at `[base, base + size)`.
+   */
+  void Attach(uint32_t base, uint32_t size, MmioModel *model);
+
+  uint32_t Read32(uint32_t addr);
+  void Write32(uint32_t addr, uint32_t value);
+  uint8_t Read8(uint32_t addr);
+  void Write8(uint32_t addr, uint8_t value);
+
+  /**
+   * Installs this bus as the default action of an `abs_mmio` mock.
+   *
+   * The mock should be a `rom_test::NiceMockAbsMmio`; a strict mock rejects
+   * calls that have no explicit expectation.
+   */
+  void Bind(rom_test::internal::MockAbsMmio &mock);
+
+  /**
+   * Installs this bus as the default action of a `mock_mmio::MockDevice`,
+   * whose offsets are taken relative to `base`.
+   *
+   * The device should be a `testing::NiceMock<mock_mmio::MockDevice>`.
+   */
+  void Bind(mock_mmio::MockDevice &dev, uint32_t base);
+
+  /**
+   * Installs this bus as the default action of any mock with `Read32`,
+   * `Write32` and `Write32Shadowed` methods, e.g. a
+   * `testing::NiceMock<rom_test::internal::MockSecMmio>`.
+   */
+  template <typename Mock>
+  void Bind32(Mock &mock) {
+    using ::testing::_;
+    using ::testing::Invoke;
+    ON_CALL(mock, Read32(_))
+        .WillByDefault(Invoke(this, &FunctionalMmio::Read32));
+    ON_CALL(mock, Write32(_, _))
+        .WillByDefault(Invoke(this, &FunctionalMmio::Write32));
+    ON_CALL(mock, Write32Shadowed(_, _))
+        .WillByDefault(Invoke(this, &FunctionalMmio::Write32));
+  }
+
+ private:
+  struct Mapping {
+    uint32_t base;
+    uint32_t size;
+    MmioModel *model;
+  };
+
+  /**
+   * Finds the model that decodes `addr`, or returns null.
+   */
+  const Mapping *Decode(uint32_t addr) const;
+
+  std::vector<Mapping> mappings_;
+};
+
+}  // namespace hw_models
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_HW_MODELS_MMIO_MODEL_H_
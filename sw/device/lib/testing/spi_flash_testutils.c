@@ -313,8 +313,8 @@ status_t spi_flash_testutils_read_op(dif_spi_host_t *spih, uint8_t opcode,
               },
       },
   };
-  TRY(dif_spi_host_transaction(spih, /*csid=*/0, transaction,
-                               ARRAYSIZE(transaction)));
+  TRY(dif_spi_host_transaction_pipelined(spih, /*csid=*/0, transaction,
+                                         ARRAYSIZE(transaction)));
   return OK_STATUS();
 }
 
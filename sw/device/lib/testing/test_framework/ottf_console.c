@@ -38,11 +38,19 @@ enum {
    * SPI device console configuration parameters.
    */
   kSpiDeviceRxCommitWait = 63,  // clock cycles
+  /**
+   * Size of the UART console receive ring buffer. Must be a power of two.
+   */
+  kRxRingSize = 256,  // bytes
   /**
    * Flow control parameters.
+   *
+   * The watermarks apply to the number of bytes received but not yet consumed,
+   * i.e. the receive ring buffer plus the RX FIFO. The space above the high
+   * watermark must absorb whatever the host sends before it acts on `Pause`.
    */
-  kFlowControlLowWatermark = 4,   // bytes
-  kFlowControlHighWatermark = 8,  // bytes
+  kFlowControlLowWatermark = kRxRingSize / 4,       // bytes
+  kFlowControlHighWatermark = kRxRingSize * 3 / 4,  // bytes
   kFlowControlRxWatermark = kDifUartWatermarkByte8,
   /**
    * HART PLIC Target.
@@ -58,14 +66,25 @@ static dif_uart_t ottf_console_uart;
 
 // Function pointer to the currently active data sink.
 static sink_func_ptr sink;
-// Function pointer to a function that retrieves a single character.
-static status_t (*getc)(void *);
+// Function pointer to a function that retrieves the available characters.
+static status_t (*getbuf)(void *, char *, size_t);
 
 // The `flow_control_state` and `flow_control_irqs` variables are shared between
 // the interrupt service handler and user code.
 static volatile ottf_console_flow_control_t flow_control_state;
 static volatile uint32_t flow_control_irqs;
 
+// Bytes drained from the UART RX FIFO but not yet read by the console user.
+// The ring is filled by the RX watermark ISR and, with the UART interrupts
+// disabled, by `uart_getbuf`; it is only emptied by `uart_getbuf`. The indices
+// are free-running and wrap modulo `kRxRingSize`.
+static uint8_t rx_ring[kRxRingSize];
+static volatile uint32_t rx_ring_head;
+static volatile uint32_t rx_ring_tail;
+
+static_assert((kRxRingSize & (kRxRingSize - 1)) == 0,
+              "kRxRingSize must be a power of two");
+
 void *ottf_console_get(void) {
   switch (kOttfTestConfig.console.type) {
     case kOttfConsoleSpiDevice:
@@ -75,14 +94,63 @@ void *ottf_console_get(void) {
   }
 }
 
-static status_t uart_getc(void *io) {
+static status_t manage_flow_control(const dif_uart_t *uart,
+                                    ottf_console_flow_control_t ctrl);
+static status_t rx_watermark_irq_sync(const dif_uart_t *uart);
+
+/**
+ * Moves as many bytes as fit from the UART RX FIFO into the receive ring.
+ *
+ * Must be called from the ISR or with the UART interrupts disabled.
+ */
+static status_t rx_ring_fill(const dif_uart_t *uart) {
+  uint32_t head = rx_ring_head;
+  uint32_t used = head - rx_ring_tail;
+  while (used < kRxRingSize) {
+    uint32_t offset = head & (kRxRingSize - 1);
+    size_t space = kRxRingSize - used;
+    if (space > kRxRingSize - offset) {
+      space = kRxRingSize - offset;
+    }
+    size_t read;
+    TRY(dif_uart_bytes_receive(uart, space, &rx_ring[offset], &read));
+    if (read == 0) {
+      break;
+    }
+    head += read;
+    used += read;
+  }
+  rx_ring_head = head;
+  return OK_STATUS();
+}
+
+static status_t uart_getbuf(void *io, char *buf, size_t len) {
   const dif_uart_t *uart = (const dif_uart_t *)io;
-  uint8_t byte;
-  TRY(dif_uart_byte_receive_polled(uart, &byte));
-  TRY(ottf_console_flow_control(uart, kOttfConsoleFlowControlAuto));
-  return OK_STATUS(byte);
+  size_t n = 0;
+  while (n == 0) {
+    dif_uart_irq_enable_snapshot_t snapshot;
+    TRY(dif_uart_irq_disable_all(uart, &snapshot));
+    status_t s = rx_ring_fill(uart);
+    uint32_t tail = rx_ring_tail;
+    while (n < len && tail != rx_ring_head) {
+      buf[n++] = (char)rx_ring[tail & (kRxRingSize - 1)];
+      ++tail;
+    }
+    rx_ring_tail = tail;
+    if (status_ok(s)) {
+      s = manage_flow_control(uart, kOttfConsoleFlowControlAuto);
+    }
+    TRY(dif_uart_irq_restore_all(uart, &snapshot));
+    TRY(rx_watermark_irq_sync(uart));
+    TRY(s);
+  }
+  return OK_STATUS((int32_t)n);
 }
 
+// Upload currently being consumed by `spi_device_getbuf`.
+static upload_info_t spi_device_upload;
+static size_t spi_device_upload_index;
+
 /*
  * The user of this function needs to be aware of the following:
  * 1. The exact amount of data expected to be sent from the host side must be
@@ -90,18 +158,23 @@ static status_t uart_getc(void *io) {
  * 2. Characters should be retrieved from the console as soon as they become
  * available. Failure to do so may result in an SPI transaction timeout.
  */
-static status_t spi_device_getc(void *io) {
-  static size_t index = 0;
-  static upload_info_t info = {0};
+static status_t spi_device_getbuf(void *io, char *buf, size_t len) {
   dif_spi_device_handle_t *spi_device = (dif_spi_device_handle_t *)io;
-  if (index == info.data_len) {
-    memset(&info, 0, sizeof(upload_info_t));
-    CHECK_STATUS_OK(spi_device_testutils_wait_for_upload(spi_device, &info));
-    index = 0;
+  if (spi_device_upload_index == spi_device_upload.data_len) {
+    memset(&spi_device_upload, 0, sizeof(upload_info_t));
+    CHECK_STATUS_OK(
+        spi_device_testutils_wait_for_upload(spi_device, &spi_device_upload));
+    spi_device_upload_index = 0;
     CHECK_DIF_OK(dif_spi_device_set_flash_status_registers(spi_device, 0x00));
   }
 
-  return OK_STATUS(info.data[index++]);
+  size_t n = spi_device_upload.data_len - spi_device_upload_index;
+  if (n > len) {
+    n = len;
+  }
+  memcpy(buf, &spi_device_upload.data[spi_device_upload_index], n);
+  spi_device_upload_index += n;
+  return OK_STATUS((int32_t)n);
 }
 
 static void spi_device_wait_for_sync(dif_spi_device_handle_t *spi_device) {
@@ -140,12 +213,12 @@ void ottf_console_init(void) {
 
       ottf_console_configure_uart(base_addr);
       sink = get_uart_sink();
-      getc = uart_getc;
+      getbuf = uart_getbuf;
       break;
     case (kOttfConsoleSpiDevice):
       ottf_console_configure_spi_device(base_addr);
       sink = get_spi_device_sink();
-      getc = spi_device_getc;
+      getbuf = spi_device_getbuf;
       break;
     default:
       CHECK(false, "unsupported OTTF console interface.");
@@ -326,9 +399,10 @@ static status_t manage_flow_control(const dif_uart_t *uart,
   if (ctrl == kOttfConsoleFlowControlAuto) {
     uint32_t avail;
     TRY(dif_uart_rx_bytes_available(uart, &avail));
+    avail += rx_ring_head - rx_ring_tail;
     if (avail < kFlowControlLowWatermark &&
         flow_control_state != kOttfConsoleFlowControlResume) {
-      // Enable RX watermark interrupt when RX FIFO level is below the
+      // Enable RX watermark interrupt when the receive level is below the
       // watermark.
       CHECK_DIF_OK(dif_uart_irq_set_enabled(uart, kDifUartIrqRxWatermark,
                                             kDifToggleEnabled));
@@ -337,7 +411,8 @@ static status_t manage_flow_control(const dif_uart_t *uart,
                flow_control_state != kOttfConsoleFlowControlPause) {
       ctrl = kOttfConsoleFlowControlPause;
       // RX watermark interrupt is status type, so disable the interrupt whilst
-      // RX FIFO is above the watermark to avoid an inifite loop of ISRs.
+      // the ring buffer may be too full to drain the RX FIFO to avoid an
+      // inifite loop of ISRs.
       CHECK_DIF_OK(dif_uart_irq_set_enabled(uart, kDifUartIrqRxWatermark,
                                             kDifToggleDisabled));
     } else {
@@ -350,12 +425,32 @@ static status_t manage_flow_control(const dif_uart_t *uart,
   return OK_STATUS((int32_t)flow_control_state);
 }
 
+/**
+ * Sets the RX watermark interrupt enable to match the flow control state.
+ *
+ * `manage_flow_control` toggles the enable when it sends `Pause` or `Resume`.
+ * Callers that run it with the UART interrupts disabled restore their snapshot
+ * afterwards, which would undo that change, so they call this once the
+ * interrupts are restored.
+ */
+static status_t rx_watermark_irq_sync(const dif_uart_t *uart) {
+  if (flow_control_state == kOttfConsoleFlowControlNone) {
+    return OK_STATUS();
+  }
+  dif_toggle_t enable = flow_control_state == kOttfConsoleFlowControlPause
+                            ? kDifToggleDisabled
+                            : kDifToggleEnabled;
+  TRY(dif_uart_irq_set_enabled(uart, kDifUartIrqRxWatermark, enable));
+  return OK_STATUS();
+}
+
 bool ottf_console_flow_control_isr(uint32_t *exc_info) {
   dif_uart_t *uart = (dif_uart_t *)ottf_console_get();
   flow_control_irqs += 1;
   bool rx;
   CHECK_DIF_OK(dif_uart_irq_is_pending(uart, kDifUartIrqRxWatermark, &rx));
   if (rx) {
+    rx_ring_fill(uart);
     manage_flow_control(uart, kOttfConsoleFlowControlAuto);
     CHECK_DIF_OK(dif_uart_irq_acknowledge(uart, kDifUartIrqRxWatermark));
     return true;
@@ -371,6 +466,7 @@ status_t ottf_console_flow_control(const dif_uart_t *uart,
   CHECK_DIF_OK(dif_uart_irq_disable_all(uart, &snapshot));
   status_t s = manage_flow_control(uart, ctrl);
   CHECK_DIF_OK(dif_uart_irq_restore_all(uart, &snapshot));
+  CHECK_STATUS_OK(rx_watermark_irq_sync(uart));
   return s;
 }
 
@@ -412,4 +508,12 @@ status_t ottf_console_putbuf(void *io, const char *buf, size_t len) {
   return OK_STATUS((int32_t)len);
 }
 
-status_t ottf_console_getc(void *io) { return getc(io); }
+status_t ottf_console_getc(void *io) {
+  char ch;
+  TRY(getbuf(io, &ch, 1));
+  return OK_STATUS((uint8_t)ch);
+}
+
+status_t ottf_console_getbuf(void *io, char *buf, size_t len) {
+  return getbuf(io, buf, len);
+}
@@ -68,9 +68,10 @@ status_t ottf_console_flow_control(const dif_uart_t *uart,
  * Enable flow control for the OTTF console.
  *
  * Enables flow control on the UART associated with the OTTF console. Flow
- * control is managed by enabling the RX watermark IRQ and sending a `Pause`
- * (aka XOFF) when the RX FIFO depth reaches 16 bytes.  A `Resume` (aka XON) is
- * sent when the RX FIFO has been drained to 4 bytes.
+ * control is managed by enabling the RX watermark IRQ, whose handler drains
+ * the RX FIFO into a receive ring buffer, and sending a `Pause` (aka XOFF)
+ * when the unread data reaches three quarters of the ring buffer. A `Resume`
+ * (aka XON) is sent when it has been drained to a quarter.
  *
  * This function configures UART interrupts at the PLIC and enables interrupts
  * at the CPU.
@@ -126,4 +127,20 @@ status_t ottf_console_putbuf(void *io, const char *buf, size_t len);
  */
 status_t ottf_console_getc(void *io);
 
+/**
+ * Get the characters that are available from the OTTF console.
+ *
+ * Blocks until at least one character has been received, then returns
+ * without waiting for more. On a UART console, characters are drained from
+ * the RX FIFO into a ring buffer by the RX watermark interrupt (when flow
+ * control is enabled) or by this function, and flow control is re-evaluated
+ * once per call rather than per character.
+ *
+ * @param io An IO context.
+ * @param buf The buffer to receive the characters.
+ * @param len The size of `buf`; must be at least one.
+ * @return The number of characters written to `buf`, or an error.
+ */
+status_t ottf_console_getbuf(void *io, char *buf, size_t len);
+
 #endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_CONSOLE_H_
@@ -29,6 +29,10 @@ extern "C" {
 /**
  * Initializes and returns a ujson context linked to the OTTF console.
  *
+ * The context reads the console in bulk and may read ahead of the value being
+ * parsed, so a test should create one context and use it for all its console
+ * input.
+ *
  * @return An initialized ujson_t context.
  */
 ujson_t ujson_ottf_console(void);
@@ -13,6 +13,12 @@
 
 #define USBDEV_BASE_ADDR TOP_EARLGREY_USBDEV_BASE_ADDR
 
+enum {
+  // Maximum number of received packets collected per read of the RX FIFO
+  // status; the RX FIFO has 8 entries.
+  kUsbTestutilsRxBatch = 8,
+};
+
 static dif_usbdev_t usbdev;
 static dif_usbdev_buffer_pool_t buffer_pool;
 
@@ -105,13 +111,12 @@ status_t usb_testutils_poll(usb_testutils_ctx_t *ctx) {
     uint16_t sentep;
     TRY(dif_usbdev_get_tx_sent(ctx->dev, &sentep));
     TRC_C('a' + sentep);
+    // Free up the buffers of all completed endpoints at once
+    TRY(dif_usbdev_clear_tx_status_batch(ctx->dev, ctx->buffer_pool, sentep));
     unsigned ep = 0u;
     while (sentep && ep < USBDEV_NUM_ENDPOINTS) {
       if (sentep & (1u << ep)) {
-        // Free up the buffer and optionally callback
-        TRY(dif_usbdev_clear_tx_status(ctx->dev, ctx->buffer_pool,
-                                       (uint8_t)ep));
-
+        // Optionally callback
         // If we have a larger transfer in progress, continue with that
         usb_testutils_transfer_t *transfer = &ctx->in[ep].transfer;
         usb_testutils_xfr_result_t res = kUsbTestutilsXfrResultOk;
@@ -147,24 +152,37 @@ status_t usb_testutils_poll(usb_testutils_ctx_t *ctx) {
     // TODO: we run the risk of starving the IN side here if the rx_callback(s)
     // are time-consuming
     while (true) {
-      bool is_empty;
-      TRY(dif_usbdev_status_get_rx_fifo_empty(ctx->dev, &is_empty));
-      if (is_empty) {
+      // Collect everything in the RX FIFO with a single status read
+      dif_usbdev_rx_packet_info_t packet_info[kUsbTestutilsRxBatch];
+      dif_usbdev_buffer_t buffer[kUsbTestutilsRxBatch];
+      size_t num_packets;
+      TRY(dif_usbdev_recv_batch(ctx->dev, packet_info, buffer,
+                                kUsbTestutilsRxBatch, &num_packets));
+      if (num_packets == 0) {
         break;
       }
 
-      dif_usbdev_rx_packet_info_t packet_info;
-      dif_usbdev_buffer_t buffer;
-      TRY(dif_usbdev_recv(ctx->dev, &packet_info, &buffer));
-
-      unsigned ep = packet_info.endpoint;
-      if (ctx->out[ep].rx_callback) {
-        TRY(ctx->out[ep].rx_callback(ctx->out[ep].ep_ctx, packet_info, buffer));
-      } else {
-        // Note: this could happen following endpoint removal
-        TRC_S("USB: unexpected RX ");
-        TRC_I(ep, 8);
-        TRY(dif_usbdev_buffer_return(ctx->dev, ctx->buffer_pool, &buffer));
+      for (size_t i = 0; i < num_packets; i++) {
+        unsigned ep = packet_info[i].endpoint;
+        if (ctx->out[ep].rx_callback) {
+          status_t result = ctx->out[ep].rx_callback(
+              ctx->out[ep].ep_ctx, packet_info[i], buffer[i]);
+          if (!status_ok(result)) {
+            // Return the buffers of the packets that will not be delivered,
+            // so that they are not lost to the pool.
+            for (size_t j = i + 1; j < num_packets; j++) {
+              TRY(dif_usbdev_buffer_return(ctx->dev, ctx->buffer_pool,
+                                           &buffer[j]));
+            }
+            return result;
+          }
+        } else {
+          // Note: this could happen following endpoint removal
+          TRC_S("USB: unexpected RX ");
+          TRC_I(ep, 8);
+          TRY(dif_usbdev_buffer_return(ctx->dev, ctx->buffer_pool,
+                                       &buffer[i]));
+        }
       }
     }
   }
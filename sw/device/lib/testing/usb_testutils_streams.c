@@ -14,6 +14,7 @@
 
 #include "sw/device/lib/testing/usb_testutils_streams.h"
 
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/runtime/print.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 #include "sw/device/lib/testing/usb_testutils_controlep.h"
@@ -32,16 +33,26 @@
 static const enum {
   kReadMethodNone = 0u,  // Just discard the data; do not read it from usbdev
   kReadMethodStandard,   // Use standard dif_usbdev_buffer_read() function
-  kReadMethodFaster      // Faster implementation
-} read_method = kReadMethodStandard;
+  kReadMethodFaster      // Check data in place in the packet buffer
+} read_method =
+#if USBUTILS_MEM_FASTER
+    kReadMethodFaster;
+#else
+    kReadMethodStandard;
+#endif
 
 /**
  * Write method to be employed
  */
 static const enum {
   kWriteMethodStandard = 1u,  // Use standard dif_usbdev_buffer_write() function
-  kWriteMethodFaster          // Faster implementation
-} write_method = kWriteMethodStandard;
+  kWriteMethodFaster          // Generate data in place in the packet buffer
+} write_method =
+#if USBUTILS_MEM_FASTER
+    kWriteMethodFaster;
+#else
+    kWriteMethodStandard;
+#endif
 
 /**
  * Diagnostic logging; expensive
@@ -134,10 +145,21 @@ static uint8_t buffer_sig_create(usb_testutils_streams_ctx_t *ctx,
   size_t bytes_written;
   switch (write_method) {
 #if USBUTILS_MEM_FASTER
-    case kWriteMethodFaster:
-      // TODO: integrate faster transfers to/from USB device packet buffer
-      // memory.
-      OT_FALLTHROUGH_INTENDED;
+    case kWriteMethodFaster: {
+      // The signature is whole words, so store it straight into the packet
+      // buffer.
+      uint32_t words[sizeof(sig) / sizeof(uint32_t)];
+      memcpy(words, &sig, sizeof(sig));
+      dif_usbdev_buffer_view_t view;
+      CHECK_DIF_OK(dif_usbdev_buffer_view(ctx->usbdev->dev, buf, &view));
+      CHECK(view.len >= sizeof(sig));
+      for (size_t i = 0; i < ARRAYSIZE(words); i++) {
+        dif_usbdev_buffer_view_write32(&view, i, words[i]);
+      }
+      CHECK_DIF_OK(dif_usbdev_buffer_advance(
+          ctx->usbdev->dev, ctx->usbdev->buffer_pool, buf, sizeof(sig)));
+      bytes_written = sizeof(sig);
+    } break;
 #endif
     default:
       CHECK_DIF_OK(dif_usbdev_buffer_write(
@@ -235,6 +257,48 @@ static bool buffer_sig_check(usb_testutils_streams_ctx_t *ctx,
   return true;
 }
 
+#if USBUTILS_MEM_FASTER
+// Fill a buffer with LFSR-generated data, writing it straight into the packet
+// buffer a word at a time rather than staging it in RAM
+static void buffer_fill_in_place(usb_testutils_streams_ctx_t *ctx,
+                                 usbdev_stream_t *s, dif_usbdev_buffer_t *buf,
+                                 uint8_t num_bytes) {
+  usb_testutils_ctx_t *usbdev = ctx->usbdev;
+
+  if (s->generating) {
+    dif_usbdev_buffer_view_t view;
+    CHECK_DIF_OK(dif_usbdev_buffer_view(usbdev->dev, buf, &view));
+
+    // Bytes are packed little-endian; any bytes beyond the end of the packet
+    // in the final word are ignored by the hardware
+    uint8_t lfsr = s->tx.lfsr;
+    uint32_t word = 0u;
+    unsigned shift = 0u;
+    size_t idx = 0u;
+    for (unsigned n = 0u; n < num_bytes; n++) {
+      word |= (uint32_t)lfsr << shift;
+      lfsr = LFSR_ADVANCE(lfsr);
+      shift += 8u;
+      if (shift == 32u) {
+        dif_usbdev_buffer_view_write32(&view, idx++, word);
+        word = 0u;
+        shift = 0u;
+      }
+    }
+    if (shift) {
+      dif_usbdev_buffer_view_write32(&view, idx, word);
+    }
+
+    // Update the LFSR for the next packet
+    s->tx.lfsr = lfsr;
+  }
+
+  CHECK_DIF_OK(dif_usbdev_buffer_advance(usbdev->dev, usbdev->buffer_pool, buf,
+                                         num_bytes));
+  s->tx.bytes += num_bytes;
+}
+#endif
+
 // Fill a buffer with LFSR-generated data
 static void buffer_fill(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
                         dif_usbdev_buffer_t *buf, uint8_t num_bytes) {
@@ -243,6 +307,14 @@ static void buffer_fill(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
   CHECK(num_bytes <= buf->remaining_bytes);
   CHECK(num_bytes <= sizeof(data));
 
+#if USBUTILS_MEM_FASTER
+  // Traffic logging needs the data in RAM
+  if (write_method == kWriteMethodFaster && !(s->verbose && log_traffic)) {
+    buffer_fill_in_place(ctx, s, buf, num_bytes);
+    return;
+  }
+#endif
+
   if (s->generating) {
     // Emit LFSR-generated byte stream; keep this brief so that we can
     // reduce our latency in responding to USB events (usb_testutils employs
@@ -268,21 +340,88 @@ static void buffer_fill(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
   }
 
   size_t bytes_written;
-  switch (write_method) {
+  CHECK_DIF_OK(dif_usbdev_buffer_write(ctx->usbdev->dev, buf, data, num_bytes,
+                                       &bytes_written));
+  CHECK(bytes_written == num_bytes);
+  s->tx.bytes += bytes_written;
+}
+
 #if USBUTILS_MEM_FASTER
-    case kWriteMethodFaster:
-      // TODO: integrate faster transfers to/from USB device packet buffer
-      // memory.
+// Check the contents of a received buffer in place, reading the packet buffer
+// a word at a time rather than first copying it into RAM
+static void buffer_check_in_place(usb_testutils_streams_ctx_t *ctx,
+                                  usbdev_stream_t *s, uint8_t len,
+                                  dif_usbdev_buffer_t *buf) {
+  usb_testutils_ctx_t *usbdev = ctx->usbdev;
+  dif_usbdev_buffer_view_t view;
+  CHECK_DIF_OK(dif_usbdev_buffer_view(usbdev->dev, buf, &view));
+  CHECK(view.len == len);
+
+  // Byte offset of LFSR-generated byte stream
+  size_t offset = 0U;
+
+  switch (s->xfr_type) {
+    case kUsbTransferTypeIsochronous: {
+      // The signature is whole words at the start of the packet; the packet
+      // buffer is always large enough to read it, and a short packet fails
+      // the length check
+      uint32_t words[sizeof(usbdev_stream_sig_t) / sizeof(uint32_t)];
+      for (size_t i = 0U; i < ARRAYSIZE(words); i++) {
+        words[i] = dif_usbdev_buffer_view_read32(&view, i);
+      }
+      usbdev_stream_sig_t sig;
+      memcpy(&sig, words, sizeof(sig));
+      bool ok = buffer_sig_check(ctx, s, &sig, len);
+      CHECK(ok, "S%u: Received packet invalid", s->id);
+
+      offset = sizeof(sig);
+    }  // no break
       OT_FALLTHROUGH_INTENDED;
-#endif
+    case kUsbTransferTypeInterrupt:
+      OT_FALLTHROUGH_INTENDED;
+    case kUsbTransferTypeBulk: {
+      uint8_t rxtx_lfsr = s->rxtx_lfsr;
+      uint8_t rx_lfsr = s->rx_lfsr;
+
+      for (size_t pos = offset; pos < len; pos += sizeof(uint32_t)) {
+        uint32_t word =
+            dif_usbdev_buffer_view_read32(&view, pos / sizeof(uint32_t));
+        size_t n = len - pos;
+        if (n > sizeof(uint32_t)) {
+          n = sizeof(uint32_t);
+        }
+        for (size_t k = 0U; k < n; k++) {
+          // Received data should be the XOR of two LFSR-generated PRND streams
+          // - ours on the transmission side, and that of the DPI model
+          uint8_t expected = rxtx_lfsr ^ rx_lfsr;
+          uint8_t actual = (uint8_t)(word >> (k * 8U));
+          CHECK(expected == actual,
+                "S%u: Unexpected received data 0x%02x : (LFSRs 0x%02x 0x%02x)",
+                s->id, actual, rxtx_lfsr, rx_lfsr);
+
+          rxtx_lfsr = LFSR_ADVANCE(rxtx_lfsr);
+          rx_lfsr = LFSR_ADVANCE(rx_lfsr);
+        }
+      }
+
+      // Update the LFSRs for the next packet
+      s->rxtx_lfsr = rxtx_lfsr;
+      s->rx_lfsr = rx_lfsr;
+
+      // Update the count of LFSR bytes received
+      s->rx_bytes += len - offset;
+    } break;
+
     default:
-      CHECK_DIF_OK(dif_usbdev_buffer_write(ctx->usbdev->dev, buf, data,
-                                           num_bytes, &bytes_written));
-      CHECK(bytes_written == num_bytes);
+      CHECK(s->xfr_type == kUsbTransferTypeControl);
       break;
   }
-  s->tx.bytes += bytes_written;
+
+  // Consuming the whole packet returns the buffer to the pool
+  CHECK_DIF_OK(
+      dif_usbdev_buffer_advance(usbdev->dev, usbdev->buffer_pool, buf, len));
 }
+#endif
 
 // Check the contents of a received buffer
 static void buffer_check(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
@@ -291,6 +430,15 @@ static void buffer_check(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
   usb_testutils_ctx_t *usbdev = ctx->usbdev;
   uint8_t len = packet_info.length;
 
+#if USBUTILS_MEM_FASTER
+  // Traffic logging needs the data in RAM
+  if (len > 0 && read_method == kReadMethodFaster &&
+      !(s->verbose && log_traffic)) {
+    buffer_check_in_place(ctx, s, len, &buf);
+    return;
+  }
+#endif
+
   if (len > 0) {
     alignas(uint32_t) uint8_t data[USBDEV_MAX_PACKET_SIZE];
 
@@ -302,18 +450,8 @@ static void buffer_check(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
     //        pool.
 
     size_t bytes_read;
-    switch (read_method) {
-#if USBUTILS_MEM_FASTER
-      // Faster read performance using custom routine
-      case kReadMethodFaster:
-        // TODO: faster read method not yet integrated, defaulting to standard
-        OT_FALLTHROUGH_INTENDED;
-#endif
-      default:
-        CHECK_DIF_OK(dif_usbdev_buffer_read(usbdev->dev, usbdev->buffer_pool,
-                                            &buf, data, len, &bytes_read));
-        break;
-    }
+    CHECK_DIF_OK(dif_usbdev_buffer_read(usbdev->dev, usbdev->buffer_pool, &buf,
+                                        data, len, &bytes_read));
     CHECK(bytes_read == len);
 
     if (s->verbose && log_traffic) {
@@ -455,10 +593,17 @@ static status_t strm_rx(void *cb_v, dif_usbdev_rx_packet_info_t packet_info,
 
       switch (read_method) {
 #if USBUTILS_MEM_FASTER
-        // Faster read performance using custom routine
-        case kReadMethodFaster:
-          // TODO: faster read method not yet integrated, defaulting to standard
-          OT_FALLTHROUGH_INTENDED;
+        // Read the words in place, without the copying loop of the DIF
+        case kReadMethodFaster: {
+          dif_usbdev_buffer_view_t view;
+          TRY(dif_usbdev_buffer_view(usbdev->dev, &buf, &view));
+          uint32_t *words = (uint32_t *)data;
+          for (size_t i = 0U; i * sizeof(uint32_t) < len; i++) {
+            words[i] = dif_usbdev_buffer_view_read32(&view, i);
+          }
+          TRY(dif_usbdev_buffer_advance(usbdev->dev, usbdev->buffer_pool, &buf,
+                                        len));
+        } break;
 #endif
         //  Use the standard interface
         default:
@@ -63,6 +63,19 @@ UJSON_SERDE_STRUCT(Rect, rect, STRUCT_RECT);
     field(k, int32_t, 3, 5)
 UJSON_SERDE_STRUCT(Matrix, matrix, STRUCT_MATRIX);
 
+// Byte arrays may instead be encoded as a single hex or base64 string, which
+// is far more compact than an array of numbers.  The fields are declared with
+// the `ujson_hex_t` or `ujson_base64_t` byte type:
+// struct Blob {
+//     uint8_t hex[8];
+//     uint8_t base64[10];
+// } blob;
+// serializes as `{"hex":"0001020304050607","base64":"AAECAwQFBgcICQ=="}`.
+#define STRUCT_BLOB(field, string) \
+    field(hex, ujson_hex_t, 8) \
+    field(base64, ujson_base64_t, 10)
+UJSON_SERDE_STRUCT(Blob, blob, STRUCT_BLOB);
+
 /////////////////////////////////////////////////////////////////////////////
 // Automatic generation of enums with serialize/deserialize functions:
 //
@@ -125,6 +125,31 @@ TEST(Derive, MatrixDeserialize) {
   EXPECT_EQ(memcmp(&m, &expected, sizeof(m)), 0);
 }
 
+TEST(Derive, BlobSerialize) {
+  blob b = {
+      {0, 1, 2, 3, 4, 5, 6, 7},
+      {0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+  };
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  EXPECT_TRUE(status_ok(ujson_serialize_blob(&uj, &b)));
+  EXPECT_EQ(
+      ss.Sink(),
+      R"json({"hex":"0001020304050607","base64":"AAECAwQFBgcICQ=="})json");
+}
+
+TEST(Derive, BlobDeserialize) {
+  blob expected = {
+      {0xde, 0xad, 0xbe, 0xef, 0, 0, 0, 0},
+      {'f', 'o', 'o', 'b', 'a', 'r', 0, 0, 0, 0},
+  };
+  blob b{};
+  SourceSink ss(R"json({"base64":"Zm9vYmFy","hex":"deadbeef"})json");
+  ujson_t uj = ss.UJson();
+  EXPECT_TRUE(status_ok(ujson_deserialize_blob(&uj, &b)));
+  EXPECT_EQ(memcmp(&b, &expected, sizeof(b)), 0);
+}
+
 TEST(Derive, DirectionSerialize) {
   direction d = kDirectionEast;
   SourceSink ss;
@@ -104,6 +104,20 @@ mod test {
         Ok(())
     }
 
+    #[test]
+    fn test_blob() -> Result<()> {
+        let before = example::Blob {
+            hex: [0xde, 0xad, 0xbe, 0xef, 0, 1, 2, 3].into(),
+            base64: [b'f', b'o', b'o', b'b', b'a', b'r', 0, 0, 0, 0xff].into(),
+        };
+        let json = serde_json::to_string(&before)?;
+        assert!(json.contains(r#""hex":"deadbeef00010203""#));
+        let after = roundtrip("blob", &json, true)?;
+        let after = serde_json::from_str::<example::Blob>(&after)?;
+        assert_eq!(before, after);
+        Ok(())
+    }
+
     #[test]
     fn test_direction() -> Result<()> {
         let before = example::Direction::North;
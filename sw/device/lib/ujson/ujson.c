@@ -22,6 +22,13 @@ ujson_t ujson_init(void *context, status_t (*getc)(void *),
   return u;
 }
 
+ujson_t ujson_init_getbuf(void *context,
+                          status_t (*getbuf)(void *, char *, size_t),
+                          status_t (*putbuf)(void *, const char *, size_t)) {
+  ujson_t u = UJSON_INIT_GETBUF(context, getbuf, putbuf);
+  return u;
+}
+
 void ujson_crc32_reset(ujson_t *uj) { crc32_init(&uj->crc32); }
 
 uint32_t ujson_crc32_finish(ujson_t *uj) { return crc32_finish(&uj->crc32); }
@@ -44,6 +51,19 @@ status_t ujson_getc(ujson_t *uj) {
   if (buffer >= 0) {
     uj->buffer = -1;
     return OK_STATUS(buffer);
+  } else if (uj->getbuf != NULL) {
+    if (uj->lookahead_pos >= uj->lookahead_len) {
+      size_t n = TRY(uj->getbuf(uj->io_context, uj->lookahead,
+                                sizeof(uj->lookahead)));
+      if (n == 0 || n > sizeof(uj->lookahead)) {
+        return INTERNAL();
+      }
+      uj->lookahead_pos = 0;
+      uj->lookahead_len = (uint8_t)n;
+    }
+    uint8_t ch = (uint8_t)uj->lookahead[uj->lookahead_pos++];
+    crc32_add8(&uj->crc32, ch);
+    return OK_STATUS(ch);
   } else {
     status_t s = uj->getc(uj->io_context);
     if (!status_err(s)) {
@@ -78,8 +98,7 @@ static status_t consume_whitespace(ujson_t *uj) {
   return OK_STATUS(ch);
 }
 
-static status_t consume_hexdigit(ujson_t *uj) {
-  int ch = TRY(ujson_getc(uj));
+static status_t hexdigit_value(int ch) {
   if (ch >= '0' && ch <= '9') {
     return OK_STATUS(ch - '0');
   } else if (ch >= 'A' && ch <= 'F') {
@@ -91,6 +110,11 @@ static status_t consume_hexdigit(ujson_t *uj) {
   }
 }
 
+static status_t consume_hexdigit(ujson_t *uj) {
+  int ch = TRY(ujson_getc(uj));
+  return hexdigit_value(ch);
+}
+
 static status_t consume_hex(ujson_t *uj) {
   int a = TRY(consume_hexdigit(uj));
   int b = TRY(consume_hexdigit(uj));
@@ -426,3 +450,117 @@ status_t ujson_serialize_status_t(ujson_t *uj, const status_t *value) {
   base_fprintf(out, "%!r", *value);
   return OK_STATUS();
 }
+
+status_t ujson_serialize_hex(ujson_t *uj, const uint8_t *buf, size_t len) {
+  char out[64];
+  TRY(ujson_putbuf(uj, "\"", 1));
+  while (len > 0) {
+    size_t n = 0;
+    for (; n < sizeof(out) && len > 0; ++buf, --len) {
+      out[n++] = hex[*buf >> 4];
+      out[n++] = hex[*buf & 0xf];
+    }
+    TRY(ujson_putbuf(uj, out, n));
+  }
+  TRY(ujson_putbuf(uj, "\"", 1));
+  return OK_STATUS();
+}
+
+status_t ujson_deserialize_hex(ujson_t *uj, uint8_t *buf, size_t len) {
+  int32_t n = 0;
+  TRY(ujson_consume(uj, '"'));
+  while (true) {
+    int ch = TRY(ujson_getc(uj));
+    if (ch == '"') {
+      break;
+    }
+    int hi = TRY(hexdigit_value(ch));
+    int lo = TRY(consume_hexdigit(uj));
+    if (len > 0) {
+      *buf++ = (uint8_t)(hi << 4 | lo);
+      --len;
+      n++;
+    }
+  }
+  return OK_STATUS(n);
+}
+
+static const char base64[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static status_t base64_value(int ch) {
+  if (ch >= 'A' && ch <= 'Z') {
+    return OK_STATUS(ch - 'A');
+  } else if (ch >= 'a' && ch <= 'z') {
+    return OK_STATUS(ch - 'a' + 26);
+  } else if (ch >= '0' && ch <= '9') {
+    return OK_STATUS(ch - '0' + 52);
+  } else if (ch == '+') {
+    return OK_STATUS(62);
+  } else if (ch == '/') {
+    return OK_STATUS(63);
+  } else {
+    return OUT_OF_RANGE();
+  }
+}
+
+status_t ujson_serialize_base64(ujson_t *uj, const uint8_t *buf, size_t len) {
+  char out[64];
+  size_t n = 0;
+  TRY(ujson_putbuf(uj, "\"", 1));
+  while (len > 0) {
+    uint32_t group = (uint32_t)buf[0] << 16;
+    if (len > 1) {
+      group |= (uint32_t)buf[1] << 8;
+    }
+    if (len > 2) {
+      group |= buf[2];
+    }
+    out[n++] = base64[(group >> 18) & 0x3f];
+    out[n++] = base64[(group >> 12) & 0x3f];
+    out[n++] = len > 1 ? base64[(group >> 6) & 0x3f] : '=';
+    out[n++] = len > 2 ? base64[group & 0x3f] : '=';
+    size_t consumed = len < 3 ? len : 3;
+    buf += consumed;
+    len -= consumed;
+    if (n == sizeof(out) || len == 0) {
+      TRY(ujson_putbuf(uj, out, n));
+      n = 0;
+    }
+  }
+  TRY(ujson_putbuf(uj, "\"", 1));
+  return OK_STATUS();
+}
+
+status_t ujson_deserialize_base64(ujson_t *uj, uint8_t *buf, size_t len) {
+  int32_t n = 0;
+  uint32_t acc = 0;
+  int bits = 0;
+  bool padding = false;
+  TRY(ujson_consume(uj, '"'));
+  while (true) {
+    int ch = TRY(ujson_getc(uj));
+    if (ch == '"') {
+      break;
+    }
+    if (ch == '=') {
+      padding = true;
+      continue;
+    }
+    if (padding) {
+      // Data after padding.
+      return OUT_OF_RANGE();
+    }
+    acc = acc << 6 | (uint32_t)TRY(base64_value(ch));
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      if (len > 0) {
+        *buf++ = (uint8_t)(acc >> bits);
+        --len;
+        n++;
+      }
+    }
+  }
+  return OK_STATUS(n);
+}
@@ -11,6 +11,13 @@
 extern "C" {
 #endif
 
+enum {
+  /**
+   * Size of the read-ahead buffer used when input is read with `getbuf`.
+   */
+  kUjsonLookaheadLen = 32,
+};
+
 /**
  * Input/Output context for ujson.
  */
@@ -21,8 +28,25 @@ typedef struct ujson {
   status_t (*putbuf)(void *, const char *, size_t);
   /** A pointer to an IO function for reading data from the input. */
   status_t (*getc)(void *);
+  /**
+   * An optional pointer to an IO function for reading several characters at
+   * once. When present, it is used instead of `getc`.
+   *
+   * The function must block until at least one character is available and
+   * then return, as the status value, the number of characters stored into
+   * the buffer (at most the requested length). It must not wait for more
+   * characters than are already available, since the parser cannot know how
+   * long the next message is.
+   */
+  status_t (*getbuf)(void *, char *, size_t);
   /** An internal single character buffer for ungetting a character. */
   int16_t buffer;
+  /** Read position in `lookahead`. */
+  uint8_t lookahead_pos;
+  /** Number of valid characters in `lookahead`. */
+  uint8_t lookahead_len;
+  /** Characters read with `getbuf` but not yet consumed by the parser. */
+  char lookahead[kUjsonLookaheadLen];
   /** Holds the rolling CRC32 of characters that are sent and received.*/
   uint32_t crc32;
 } ujson_t;
@@ -36,6 +60,15 @@ typedef struct ujson {
     .buffer = -1,                            \
     .crc32 = UINT32_MAX,                     \
   }
+
+#define UJSON_INIT_GETBUF(context_, getbuf_, putbuf_) \
+  {                                                   \
+    .io_context = (void*)(context_),                  \
+    .putbuf = (putbuf_),                              \
+    .getbuf = (getbuf_),                              \
+    .buffer = -1,                                     \
+    .crc32 = UINT32_MAX,                              \
+  }
 // clang-format on
 
 /**
@@ -49,6 +82,24 @@ typedef struct ujson {
 ujson_t ujson_init(void *context, status_t (*getc)(void *),
                    status_t (*putbuf)(void *, const char *, size_t));
 
+/**
+ * Initializes and returns a ujson context that reads its input in bulk.
+ *
+ * Input is fetched with `getbuf` into a small read-ahead buffer inside the
+ * context, so the parser does not call into the IO layer for every
+ * character. Because characters following the current value may already
+ * have been read into that buffer, the same context should be used for the
+ * whole input stream.
+ *
+ * @param context An IO context for the `getbuf` and `putbuf` functions.
+ * @param getbuf A function to read the available input into a buffer.
+ * @param putbuf A function to write a buffer to the output.
+ * @return An initialized ujson_t context.
+ */
+ujson_t ujson_init_getbuf(void *context,
+                          status_t (*getbuf)(void *, char *, size_t),
+                          status_t (*putbuf)(void *, const char *, size_t));
+
 /**
  * Gets a single character from the input.
  *
@@ -229,6 +280,64 @@ status_t ujson_serialize_bool(ujson_t *uj, const bool *value);
  */
 status_t ujson_serialize_status_t(ujson_t *uj, const status_t *value);
 
+/**
+ * Byte types that select a compact encoding for byte-array struct fields.
+ *
+ * Declaring a `ujson_serde` struct field as `field(data, ujson_hex_t, 256)`
+ * or `field(data, ujson_base64_t, 256)` produces a `uint8_t`-compatible
+ * array that is serialized as a single hex or base64 string instead of an
+ * array of decimal numbers. Such fields must be one-dimensional arrays; a
+ * scalar or nested declaration fails to compile.
+ */
+typedef uint8_t ujson_hex_t;
+typedef uint8_t ujson_base64_t;
+
+/**
+ * Serialize a byte buffer as a lowercase hex string.
+ *
+ * @param uj A ujson IO context.
+ * @param buf The bytes to serialize.
+ * @param len The number of bytes in `buf`.
+ * @return OK or an error.
+ */
+status_t ujson_serialize_hex(ujson_t *uj, const uint8_t *buf, size_t len);
+
+/**
+ * Deserialize a hex string into a byte buffer.
+ *
+ * If the input decodes to more than `len` bytes, the buffer receives the
+ * first `len` bytes and the rest of the string is consumed. Bytes past the
+ * end of a shorter input are left untouched.
+ *
+ * @param uj A ujson IO context.
+ * @param buf A buffer to write the bytes into.
+ * @param len The length of the buffer.
+ * @return The number of bytes written to `buf`, or an error.
+ */
+status_t ujson_deserialize_hex(ujson_t *uj, uint8_t *buf, size_t len);
+
+/**
+ * Serialize a byte buffer as a padded, standard-alphabet base64 string.
+ *
+ * @param uj A ujson IO context.
+ * @param buf The bytes to serialize.
+ * @param len The number of bytes in `buf`.
+ * @return OK or an error.
+ */
+status_t ujson_serialize_base64(ujson_t *uj, const uint8_t *buf, size_t len);
+
+/**
+ * Deserialize a base64 string into a byte buffer.
+ *
+ * Handles excess and missing input like `ujson_deserialize_hex`.
+ *
+ * @param uj A ujson IO context.
+ * @param buf A buffer to write the bytes into.
+ * @param len The length of the buffer.
+ * @return The number of bytes written to `buf`, or an error.
+ */
+status_t ujson_deserialize_base64(ujson_t *uj, uint8_t *buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,18 @@
 // that do not have a symbolic name.
 #define RUST_ENUM_INTVALUE IntValue
 
+// Byte types that serialize a whole array field as one string (see
+// `ujson_hex_t` in ujson.h). `ujson_is_bytes(type_)` expands to 1 for these
+// types and 0 otherwise; `ujson_bytes_codec_<type>` names the encoding.
+// Fields of these types must be one-dimensional arrays.
+// clang-format off
+#define ujson_is_bytes(type_) OT_CHECK(OT_PRIMITIVE_CAT(ujson_bytes_probe_, type_))
+#define ujson_bytes_probe_ujson_hex_t OT_PROBE(~)
+#define ujson_bytes_probe_ujson_base64_t OT_PROBE(~)
+#define ujson_bytes_codec_ujson_hex_t hex
+#define ujson_bytes_codec_ujson_base64_t base64
+// clang-format on
+
 #ifndef RUST_PREPROCESSOR_EMIT
 #include <stdint.h>
 
@@ -42,6 +54,13 @@
     ) /*endif*/
 
 #define ujson_struct_field(name_, type_, ...) \
+    OT_IIF(ujson_is_bytes(type_)) \
+    ( /*then*/ \
+        static_assert(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__) == 1, \
+                      #type_ " field " #name_ \
+                      " must be a one-dimensional array"); \
+    , /*else*/ \
+    ) /*endif*/ \
     OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
     ( /*then*/ \
         type_ name_; \
@@ -94,6 +113,11 @@
 #define ujson_ser_field(name_, type_, ...) { \
         TRY(ujson_serialize_string(uj, #name_)); \
         TRY(ujson_putbuf(uj, ":", 1)); \
+        OT_IIF(ujson_is_bytes(type_)) \
+        ( /*then*/ \
+            TRY(OT_CAT(ujson_serialize_, ujson_bytes_codec_##type_)( \
+                    uj, (const uint8_t*)&self->name_, sizeof(self->name_))); \
+        , /*else*/ \
         OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
         ( /*then*/ \
             TRY(ujson_serialize_##type_(uj, &self->name_)); \
@@ -102,6 +126,7 @@
             OT_EVAL(ujson_ser_loop( \
                     TRY(ujson_serialize_##type_(uj, p++)), __VA_ARGS__)) \
         ) /*endif*/ \
+        ) /*endif*/ \
         if (--nfield) TRY(ujson_putbuf(uj, ",", 1)); \
     }
 
@@ -179,6 +204,11 @@
 
 #define ujson_de_field(name_, type_, ...) \
     else if (ujson_streq(key, #name_)) { \
+        OT_IIF(ujson_is_bytes(type_)) \
+        ( /*then*/ \
+            TRY(OT_CAT(ujson_deserialize_, ujson_bytes_codec_##type_)( \
+                    uj, (uint8_t*)&self->name_, sizeof(self->name_))); \
+        , /*else*/ \
         OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
         ( /*then*/ \
             TRY(ujson_deserialize_##type_(uj, &self->name_)); \
@@ -187,6 +217,7 @@
             OT_EVAL(ujson_de_loop(1, \
                 TRY(ujson_deserialize_##type_(uj, p++)), __VA_ARGS__)) \
         ) /*endif*/ \
+        ) /*endif*/ \
     }
 
 #define ujson_de_string(name_, size_, ...) \
@@ -49,13 +49,26 @@ use opentitanlib::test_utils::status::status_t;
         arrayvec::ArrayVec<OT_OBSTRUCT(ujson_struct_field_array_indirect)()(t_, __VA_ARGS__), sz_> \
     ) /*endif*/
 
+#define ujson_rust_bytes_with_hex "opentitanlib::util::serde::hex_bytes"
+#define ujson_rust_bytes_with_base64 "opentitanlib::util::serde::base64_bytes"
+
+#define ujson_struct_field_bytes(name_, type_, ...) \
+    rust_attr[serde(with = OT_CAT(ujson_rust_bytes_with_, \
+                                  ujson_bytes_codec_##type_))] \
+    pub name_: ujson_struct_field_array(u8, __VA_ARGS__),
+
 #define ujson_struct_field(name_, type_, ...) \
+    OT_IIF(ujson_is_bytes(type_)) \
+    ( /*then*/ \
+        ujson_struct_field_bytes(name_, type_, ##__VA_ARGS__) \
+    , /*else*/ \
     pub OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
     ( /*then*/ \
         name_: type_ \
     , /*else*/ \
         name_: OT_EVAL(ujson_struct_field_array(type_, __VA_ARGS__)) \
-    ) /*endif*/,
+    ) /*endif*/, \
+    ) /*endif*/
 
 #define ujson_struct_string(name_, size_, ...) \
     ujson_struct_field(name_, String, ##__VA_ARGS__)
@@ -4,6 +4,7 @@
 
 #include "sw/device/lib/ujson/ujson.h"
 
+#include <cstring>
 #include <gtest/gtest.h>
 #include <string>
 
@@ -28,6 +29,43 @@ TEST(UJson, GetC) {
   EXPECT_EQ(status_err(ujson_getc(&uj)), kResourceExhausted);
 }
 
+TEST(UJson, GetBuf) {
+  SourceSink ss("abc123");
+  ujson_t uj = ss.UJsonGetBuf(/*chunk=*/4);
+
+  EXPECT_EQ(ujson_getc(&uj).value, 'a');
+  EXPECT_EQ(ujson_getc(&uj).value, 'b');
+  EXPECT_EQ(ujson_getc(&uj).value, 'c');
+  EXPECT_EQ(status_err(ujson_ungetc(&uj, 'd')), kOk);
+  EXPECT_EQ(ujson_getc(&uj).value, 'd');
+  EXPECT_EQ(ujson_getc(&uj).value, '1');
+  EXPECT_EQ(ujson_getc(&uj).value, '2');
+  EXPECT_EQ(ujson_getc(&uj).value, '3');
+  EXPECT_EQ(status_err(ujson_getc(&uj)), kResourceExhausted);
+}
+
+TEST(UJson, GetBufCrcMatchesGetC) {
+  const std::string input =
+      "\"a quoted string that is longer than the lookahead buffer\" 12345";
+  SourceSink ss_getc(input);
+  SourceSink ss_getbuf(input);
+  ujson_t uj_getc = ss_getc.UJson();
+  ujson_t uj_getbuf = ss_getbuf.UJsonGetBuf();
+
+  char str[80];
+  uint32_t a, b;
+  EXPECT_TRUE(status_ok(ujson_parse_qs(&uj_getc, str, sizeof(str))));
+  EXPECT_TRUE(status_ok(ujson_parse_qs(&uj_getbuf, str, sizeof(str))));
+  EXPECT_EQ(std::string(str),
+            "a quoted string that is longer than the lookahead buffer");
+  // The CRC only covers consumed characters, not the read-ahead ones.
+  EXPECT_EQ(ujson_crc32_finish(&uj_getc), ujson_crc32_finish(&uj_getbuf));
+  EXPECT_TRUE(status_ok(ujson_deserialize_uint32_t(&uj_getc, &a)));
+  EXPECT_TRUE(status_ok(ujson_deserialize_uint32_t(&uj_getbuf, &b)));
+  EXPECT_EQ(a, 12345);
+  EXPECT_EQ(b, 12345);
+}
+
 TEST(UJson, PutBuf) {
   SourceSink ss;
   ujson_t uj = ss.UJson();
@@ -117,6 +155,120 @@ TEST(UJson, ParseBoolean) {
   EXPECT_FALSE(status_ok(s));
 }
 
+TEST(UJson, SerializeHex) {
+  SourceSink ss;
+  ujson uj = ss.UJson();
+  const uint8_t buf[] = {0x00, 0x01, 0xab, 0xff};
+
+  EXPECT_TRUE(status_ok(ujson_serialize_hex(&uj, buf, sizeof(buf))));
+  EXPECT_EQ(ss.Sink(), R"json("0001abff")json");
+
+  ss.Reset();
+  EXPECT_TRUE(status_ok(ujson_serialize_hex(&uj, buf, 0)));
+  EXPECT_EQ(ss.Sink(), R"json("")json");
+}
+
+TEST(UJson, DeserializeHex) {
+  SourceSink ss(R"json( "0001ABff")json");
+  ujson uj = ss.UJson();
+  uint8_t buf[6] = {0};
+  const uint8_t expected[6] = {0x00, 0x01, 0xab, 0xff, 0x00, 0x00};
+
+  status_t s = ujson_deserialize_hex(&uj, buf, sizeof(buf));
+  EXPECT_EQ(status_err(s), kOk);
+  EXPECT_EQ(s.value, 4);
+  EXPECT_EQ(memcmp(buf, expected, sizeof(buf)), 0);
+
+  // Excess input is consumed and dropped.
+  ss.Reset(R"json("0102030405060708",)json");
+  s = ujson_deserialize_hex(&uj, buf, 2);
+  EXPECT_EQ(status_err(s), kOk);
+  EXPECT_EQ(s.value, 2);
+  EXPECT_EQ(buf[0], 1);
+  EXPECT_EQ(buf[1], 2);
+  EXPECT_EQ(buf[2], 0xab);
+  EXPECT_EQ(status_err(ujson_consume(&uj, ',')), kOk);
+
+  ss.Reset(R"json("0g")json");
+  EXPECT_EQ(status_err(ujson_deserialize_hex(&uj, buf, sizeof(buf))),
+            kOutOfRange);
+  ss.Reset(R"json("012")json");
+  EXPECT_EQ(status_err(ujson_deserialize_hex(&uj, buf, sizeof(buf))),
+            kOutOfRange);
+}
+
+TEST(UJson, SerializeBase64) {
+  SourceSink ss;
+  ujson uj = ss.UJson();
+  const uint8_t buf[] = "foobar";
+
+  // RFC 4648 test vectors.
+  const char *expected[] = {
+      R"json("")json",         R"json("Zg==")json",
+      R"json("Zm8=")json",     R"json("Zm9v")json",
+      R"json("Zm9vYg==")json", R"json("Zm9vYmE=")json",
+      R"json("Zm9vYmFy")json",
+  };
+  for (size_t i = 0; i < 7; ++i) {
+    ss.Reset();
+    EXPECT_TRUE(status_ok(ujson_serialize_base64(&uj, buf, i)));
+    EXPECT_EQ(ss.Sink(), expected[i]);
+  }
+}
+
+TEST(UJson, DeserializeBase64) {
+  const char *input[] = {
+      R"json("")json",         R"json("Zg==")json",
+      R"json("Zm8=")json",     R"json("Zm9v")json",
+      R"json("Zm9vYg==")json", R"json("Zm9vYmE=")json",
+      R"json("Zm9vYmFy")json",
+  };
+  for (size_t i = 0; i < 7; ++i) {
+    SourceSink ss(input[i]);
+    ujson uj = ss.UJson();
+    char buf[8] = {0};
+    status_t s = ujson_deserialize_base64(&uj, (uint8_t *)buf, sizeof(buf));
+    EXPECT_EQ(status_err(s), kOk);
+    EXPECT_EQ(s.value, i);
+    EXPECT_EQ(std::string(buf), std::string("foobar", i));
+  }
+
+  SourceSink ss(R"json("Zg=a")json");
+  ujson uj = ss.UJson();
+  uint8_t buf[4];
+  EXPECT_EQ(status_err(ujson_deserialize_base64(&uj, buf, sizeof(buf))),
+            kOutOfRange);
+  ss.Reset(R"json("Z*==")json");
+  EXPECT_EQ(status_err(ujson_deserialize_base64(&uj, buf, sizeof(buf))),
+            kOutOfRange);
+}
+
+TEST(UJson, BytesRoundtrip) {
+  uint8_t before[300];
+  for (size_t i = 0; i < sizeof(before); ++i) {
+    before[i] = static_cast<uint8_t>(i * 7);
+  }
+  SourceSink ss;
+  ujson uj = ss.UJson();
+  uint8_t after[sizeof(before)];
+
+  EXPECT_TRUE(status_ok(ujson_serialize_hex(&uj, before, sizeof(before))));
+  std::string json = ss.Sink();
+  EXPECT_EQ(json.size(), 2 * sizeof(before) + 2);
+  ss.Reset(json);
+  EXPECT_TRUE(status_ok(ujson_deserialize_hex(&uj, after, sizeof(after))));
+  EXPECT_EQ(memcmp(before, after, sizeof(before)), 0);
+
+  ss.Reset();
+  memset(after, 0, sizeof(after));
+  EXPECT_TRUE(status_ok(ujson_serialize_base64(&uj, before, sizeof(before))));
+  json = ss.Sink();
+  EXPECT_EQ(json.size(), 4 * sizeof(before) / 3 + 2);
+  ss.Reset(json);
+  EXPECT_TRUE(status_ok(ujson_deserialize_base64(&uj, after, sizeof(after))));
+  EXPECT_EQ(memcmp(before, after, sizeof(before)), 0);
+}
+
 #define INT(type_, str_, value_)                                  \
   do {                                                            \
     SourceSink ss(str_);                                          \
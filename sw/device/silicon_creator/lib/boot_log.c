@@ -5,7 +5,9 @@
 #include "sw/device/silicon_creator/lib/boot_log.h"
 
 #include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/silicon_creator/lib/drivers/hmac.h"
+#include "sw/device/silicon_creator/lib/drivers/ibex.h"
 
 static void boot_log_digest_compute(const boot_log_t *boot_log,
                                     hmac_digest_t *digest) {
@@ -90,3 +92,31 @@ void boot_log_check_or_init(boot_log_t *boot_log, uint32_t rom_ext_slot,
   boot_log_digest_update(boot_log);
   return;
 }
+
+void boot_log_profile_init(boot_log_profile_t *profile) {
+  memset(profile, 0, sizeof(*profile));
+  profile->identifier = kBootLogProfileIdentifier;
+}
+
+void boot_log_profile_rotate(boot_log_profile_t *profile,
+                             boot_log_profile_t *prev) {
+  if (profile->identifier == kBootLogProfileIdentifier) {
+    *prev = *profile;
+  } else {
+    boot_log_profile_init(prev);
+  }
+  boot_log_profile_init(profile);
+}
+
+void boot_log_profile_mark(boot_log_profile_t *profile,
+                           boot_log_milestone_t milestone) {
+  uint32_t mcycle = ibex_mcycle32();
+  if (profile->identifier != kBootLogProfileIdentifier) {
+    boot_log_profile_init(profile);
+  }
+  boot_log_profile_entry_t *entry =
+      &profile->entries[profile->count % kBootLogProfileEntries];
+  entry->milestone = milestone;
+  entry->mcycle = mcycle;
+  ++profile->count;
+}
@@ -81,6 +81,91 @@ enum {
   kBootLogIdentifier = 0x474f4c42,
 };
 
+/**
+ * Boot milestones recorded by the boot profiler.
+ *
+ * Values are ASCII "FourCC" tags so that they are recognizable in a raw dump
+ * of the retention SRAM. The first letter is the boot stage (`R` for ROM, `X`
+ * for ROM_EXT).
+ */
+typedef enum boot_log_milestone {
+  /** ROM: initialization done, including OTP reads ("RINI"). */
+  kBootLogMilestoneRomInit = 0x494e4952,
+  /** ROM: secure boot keys loaded from OTP ("RKEY"). */
+  kBootLogMilestoneRomKeyLoad = 0x59454b52,
+  /** ROM: ROM_EXT measured by HMAC ("RHMC"). */
+  kBootLogMilestoneRomMeasure = 0x434d4852,
+  /** ROM: SPHINCS+ signature verified ("RSPX"). */
+  kBootLogMilestoneRomSpxVerify = 0x58505352,
+  /** ROM: ECDSA signature verified ("RECD"). */
+  kBootLogMilestoneRomEcdsaVerify = 0x44434552,
+  /** ROM: jumping to ROM_EXT ("RJMP"). */
+  kBootLogMilestoneRomJump = 0x504d4a52,
+  /** ROM_EXT: entered ("XINI"). */
+  kBootLogMilestoneRomExtInit = 0x494e4958,
+  /** ROM_EXT: owner keyring loaded ("XKEY"). */
+  kBootLogMilestoneRomExtKeyLoad = 0x59454b58,
+  /** ROM_EXT: owner firmware measured by HMAC ("XHMC"). */
+  kBootLogMilestoneRomExtMeasure = 0x434d4858,
+  /** ROM_EXT: owner firmware signatures verified ("XVFY"). */
+  kBootLogMilestoneRomExtVerify = 0x59465658,
+  /** ROM_EXT: DICE certificates checked or updated ("XDCE"). */
+  kBootLogMilestoneRomExtDice = 0x45434458,
+  /** ROM_EXT: jumping to the owner firmware ("XJMP"). */
+  kBootLogMilestoneRomExtJump = 0x504d4a58,
+} boot_log_milestone_t;
+
+enum {
+  /**
+   * Boot profile identifier value (ASCII "BPRF").
+   */
+  kBootLogProfileIdentifier = 0x46525042,
+  /**
+   * Number of entries in the boot profile ring.
+   */
+  kBootLogProfileEntries = 16,
+};
+
+/**
+ * A boot profile entry: the `mcycle` count at which a milestone was reached.
+ */
+typedef struct boot_log_profile_entry {
+  /** Milestone (boot_log_milestone_t). */
+  uint32_t milestone;
+  /** Low 32 bits of `mcycle`, i.e. CPU cycles since reset. */
+  uint32_t mcycle;
+} boot_log_profile_entry_t;
+
+/**
+ * The boot profile records when each boot stage reached its milestones.
+ *
+ * Milestones are only recorded by ROM and ROM_EXT builds with
+ * `--define boot_profile=true`, which defines `OT_BOOT_PROFILE`; otherwise the
+ * profile stays empty.
+ *
+ * It lives in the retention SRAM next to the `boot_log`. Unlike the
+ * `boot_log`, it is not covered by a digest: it is diagnostic data, and is
+ * appended to throughout boot, where re-hashing at every milestone would
+ * distort the very timings it records.
+ */
+typedef struct boot_log_profile {
+  /** Identifier (`BPRF`). */
+  uint32_t identifier;
+  /**
+   * Number of milestones recorded since reset. Milestone `i` is stored at
+   * `entries[i % kBootLogProfileEntries]`, so only the last
+   * `kBootLogProfileEntries` are kept.
+   */
+  uint32_t count;
+  /** Ring of recorded milestones. */
+  boot_log_profile_entry_t entries[kBootLogProfileEntries];
+} boot_log_profile_t;
+
+OT_ASSERT_MEMBER_OFFSET(boot_log_profile_t, identifier, 0);
+OT_ASSERT_MEMBER_OFFSET(boot_log_profile_t, count, 4);
+OT_ASSERT_MEMBER_OFFSET(boot_log_profile_t, entries, 8);
+OT_ASSERT_SIZE(boot_log_profile_t, 136);
+
 /**
  * Updates the digest of the boot_log.
  *
@@ -114,6 +199,36 @@ rom_error_t boot_log_check(const boot_log_t *boot_log);
 void boot_log_check_or_init(boot_log_t *boot_log, uint32_t rom_ext_slot,
                             const chip_info_t *info);
 
+/**
+ * Clears the boot profile.
+ *
+ * @param profile A buffer that holds the boot profile.
+ */
+void boot_log_profile_init(boot_log_profile_t *profile);
+
+/**
+ * Saves the boot profile of the previous boot and clears the current one.
+ *
+ * The previous profile is cleared instead if `profile` has not been
+ * initialized, e.g. after the retention SRAM has been reset.
+ *
+ * @param profile A buffer that holds the boot profile.
+ * @param prev A buffer that receives the profile of the previous boot.
+ */
+void boot_log_profile_rotate(boot_log_profile_t *profile,
+                             boot_log_profile_t *prev);
+
+/**
+ * Records that a milestone has been reached at the current `mcycle` count.
+ *
+ * The profile is cleared first if it has not been initialized.
+ *
+ * @param profile A buffer that holds the boot profile.
+ * @param milestone The milestone that has been reached.
+ */
+void boot_log_profile_mark(boot_log_profile_t *profile,
+                           boot_log_milestone_t milestone);
+
 #ifdef __cplusplus
 }
 #endif
@@ -171,5 +171,79 @@ TEST_F(BootLogTest, BootLogCheckFailure) {
   EXPECT_EQ(expected_chip_version, boot_log.chip_version);
 }
 
+TEST(BootLogProfileTest, Init) {
+  boot_log_profile_t profile;
+  std::memset(&profile, 0xa5, sizeof(profile));
+  boot_log_profile_init(&profile);
+  EXPECT_EQ(profile.identifier, kBootLogProfileIdentifier);
+  EXPECT_EQ(profile.count, 0);
+  for (size_t i = 0; i < kBootLogProfileEntries; ++i) {
+    EXPECT_EQ(profile.entries[i].milestone, 0);
+    EXPECT_EQ(profile.entries[i].mcycle, 0);
+  }
+}
+
+TEST(BootLogProfileTest, Rotate) {
+  boot_log_profile_t profile;
+  boot_log_profile_t prev;
+  boot_log_profile_init(&profile);
+  boot_log_profile_mark(&profile, kBootLogMilestoneRomInit);
+  boot_log_profile_mark(&profile, kBootLogMilestoneRomExtJump);
+  std::memset(&prev, 0xa5, sizeof(prev));
+  boot_log_profile_rotate(&profile, &prev);
+  EXPECT_EQ(prev.identifier, kBootLogProfileIdentifier);
+  EXPECT_EQ(prev.count, 2);
+  EXPECT_EQ(prev.entries[0].milestone, kBootLogMilestoneRomInit);
+  EXPECT_EQ(prev.entries[1].milestone, kBootLogMilestoneRomExtJump);
+  EXPECT_EQ(profile.identifier, kBootLogProfileIdentifier);
+  EXPECT_EQ(profile.count, 0);
+}
+
+TEST(BootLogProfileTest, RotateUninitialized) {
+  // After the retention SRAM has been reset there is no previous boot.
+  boot_log_profile_t profile;
+  boot_log_profile_t prev;
+  std::memset(&profile, 0, sizeof(profile));
+  std::memset(&prev, 0xa5, sizeof(prev));
+  boot_log_profile_rotate(&profile, &prev);
+  EXPECT_EQ(prev.identifier, kBootLogProfileIdentifier);
+  EXPECT_EQ(prev.count, 0);
+  EXPECT_EQ(prev.entries[0].milestone, 0);
+  EXPECT_EQ(profile.identifier, kBootLogProfileIdentifier);
+  EXPECT_EQ(profile.count, 0);
+}
+
+TEST(BootLogProfileTest, Mark) {
+  boot_log_profile_t profile;
+  boot_log_profile_init(&profile);
+  boot_log_profile_mark(&profile, kBootLogMilestoneRomInit);
+  boot_log_profile_mark(&profile, kBootLogMilestoneRomJump);
+  EXPECT_EQ(profile.count, 2);
+  EXPECT_EQ(profile.entries[0].milestone, kBootLogMilestoneRomInit);
+  EXPECT_EQ(profile.entries[1].milestone, kBootLogMilestoneRomJump);
+  EXPECT_LE(profile.entries[0].mcycle, profile.entries[1].mcycle);
+}
+
+TEST(BootLogProfileTest, MarkUninitialized) {
+  boot_log_profile_t profile;
+  std::memset(&profile, 0xa5, sizeof(profile));
+  boot_log_profile_mark(&profile, kBootLogMilestoneRomExtInit);
+  EXPECT_EQ(profile.identifier, kBootLogProfileIdentifier);
+  EXPECT_EQ(profile.count, 1);
+  EXPECT_EQ(profile.entries[0].milestone, kBootLogMilestoneRomExtInit);
+}
+
+TEST(BootLogProfileTest, Wrap) {
+  boot_log_profile_t profile;
+  boot_log_profile_init(&profile);
+  for (size_t i = 0; i < kBootLogProfileEntries; ++i) {
+    boot_log_profile_mark(&profile, kBootLogMilestoneRomInit);
+  }
+  boot_log_profile_mark(&profile, kBootLogMilestoneRomExtJump);
+  EXPECT_EQ(profile.count, kBootLogProfileEntries + 1);
+  EXPECT_EQ(profile.entries[0].milestone, kBootLogMilestoneRomExtJump);
+  EXPECT_EQ(profile.entries[1].milestone, kBootLogMilestoneRomInit);
+}
+
 }  // namespace
 }  // namespace boot_log_unittest
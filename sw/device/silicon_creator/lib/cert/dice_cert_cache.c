@@ -0,0 +1,79 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/cert/dice_cert_cache.h"
+
+#include <stddef.h>
+
+#include "sw/device/lib/base/hardened_memory.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/silicon_creator/lib/drivers/kmac.h"
+
+/**
+ * Compute the tag of a cache entry.
+ *
+ * The message starts with the index magic value so that it can never be
+ * mistaken for an owner page, which shares the KMAC key.
+ *
+ * @param slot The certificate the entry belongs to.
+ * @param entry The entry to tag; its `tag` field is not read.
+ * @param[out] tag The computed tag.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t entry_tag(dice_cert_cache_slot_t slot,
+                             const dice_cert_cache_entry_t *entry,
+                             uint32_t *tag) {
+  const uint32_t header[2] = {kDiceCertCacheMagic, slot};
+  HARDENED_RETURN_IF_ERROR(kmac_kmac256_start());
+  kmac_kmac256_absorb(header, sizeof(header));
+  kmac_kmac256_absorb(entry, offsetof(dice_cert_cache_entry_t, tag));
+  return kmac_kmac256_final(tag, kDiceCertCacheTagWords);
+}
+
+rom_error_t dice_cert_cache_lookup(const dice_cert_cache_t *cache,
+                                   dice_cert_cache_slot_t slot,
+                                   const hmac_digest_t *inputs_digest,
+                                   hmac_digest_t *pubkey_id,
+                                   ecdsa_p256_public_key_t *pubkey,
+                                   hardened_bool_t *hit) {
+  *hit = kHardenedBoolFalse;
+  const dice_cert_cache_entry_t *entry = &cache->entries[slot];
+  if (cache->magic != kDiceCertCacheMagic ||
+      memcmp(&entry->inputs_digest, inputs_digest,
+             sizeof(entry->inputs_digest)) != 0) {
+    return kErrorOk;
+  }
+
+  uint32_t tag[kDiceCertCacheTagWords];
+  HARDENED_RETURN_IF_ERROR(entry_tag(slot, entry, tag));
+  if (hardened_memeq(entry->tag, tag, kDiceCertCacheTagWords) !=
+      kHardenedBoolTrue) {
+    return kErrorOk;
+  }
+  *pubkey_id = entry->pubkey_id;
+  *pubkey = entry->pubkey;
+  *hit = kHardenedBoolTrue;
+  return kErrorOk;
+}
+
+rom_error_t dice_cert_cache_update(dice_cert_cache_t *cache,
+                                   dice_cert_cache_slot_t slot,
+                                   const dice_cert_cache_entry_t *entry,
+                                   hardened_bool_t *changed) {
+  dice_cert_cache_entry_t tagged = *entry;
+  HARDENED_RETURN_IF_ERROR(entry_tag(slot, &tagged, tagged.tag));
+
+  *changed = kHardenedBoolFalse;
+  if (cache->magic != kDiceCertCacheMagic) {
+    memset(cache, 0, sizeof(*cache));
+    cache->magic = kDiceCertCacheMagic;
+    *changed = kHardenedBoolTrue;
+  }
+  if (memcmp(&cache->entries[slot], &tagged, sizeof(tagged)) != 0) {
+    cache->entries[slot] = tagged;
+    *changed = kHardenedBoolTrue;
+  }
+  return kErrorOk;
+}
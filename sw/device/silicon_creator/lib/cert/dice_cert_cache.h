@@ -0,0 +1,152 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_CERT_DICE_CERT_CACHE_H_
+#define OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_CERT_DICE_CERT_CACHE_H_
+
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
+#include "sw/device/silicon_creator/lib/error.h"
+#include "sw/device/silicon_creator/lib/sigverify/ecdsa_p256_key.h"
+
+#include "flash_ctrl_regs.h"  // Generated.
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+enum {
+  /**
+   * Magic value of a populated certificate cache index ("DCC1").
+   */
+  kDiceCertCacheMagic = 0x31434344,
+  /**
+   * Size of the tag of a cache entry in words.
+   */
+  kDiceCertCacheTagWords = 8,
+};
+
+/**
+ * Certificates whose subject keys are tracked by the cache index.
+ */
+typedef enum dice_cert_cache_slot {
+  kDiceCertCacheSlotCdi0 = 0,
+  kDiceCertCacheSlotCdi1 = 1,
+  kDiceCertCacheSlotCount = 2,
+} dice_cert_cache_slot_t;
+
+/**
+ * One entry of the certificate cache index.
+ *
+ * The subject key of a DICE certificate is a deterministic function of the
+ * keymgr state, which is in turn a function of the inputs hashed into
+ * `inputs_digest`. When the digest of the current inputs matches, the stored
+ * certificate can be checked against the cached key without deriving it
+ * through OTBN.
+ *
+ * The index lives in a flash page that other stages can write, so every
+ * entry carries a KMAC tag keyed with the keymgr sealing key that
+ * `ownership_seal_init()` sideloads to KMAC. The key is bound to the device
+ * secrets, so only this device's ROM_EXT can produce a valid tag, and an
+ * entry is only used once its tag has been checked.
+ */
+typedef struct dice_cert_cache_entry {
+  /**
+   * SHA2-256 digest of every input to the certificate and its key derivation.
+   */
+  hmac_digest_t inputs_digest;
+  /**
+   * Subject public key ID derived from these inputs.
+   */
+  hmac_digest_t pubkey_id;
+  /**
+   * Subject public key derived from these inputs.
+   */
+  ecdsa_p256_public_key_t pubkey;
+  /**
+   * KMAC-256 tag over the certificate slot and the fields above.
+   */
+  uint32_t tag[kDiceCertCacheTagWords];
+} dice_cert_cache_entry_t;
+
+/**
+ * Certificate cache index, stored at the end of the DICE certificate page.
+ */
+typedef struct dice_cert_cache {
+  uint32_t magic;
+  uint32_t reserved;
+  dice_cert_cache_entry_t entries[kDiceCertCacheSlotCount];
+} dice_cert_cache_t;
+
+enum {
+  /**
+   * Size of the cache index at the end of the DICE certificate page.
+   */
+  kDiceCertCacheSizeBytes = 328,
+  /**
+   * Number of bytes of the DICE certificate page available to TLV objects.
+   *
+   * Personalization firmware must not place certificates past this offset.
+   */
+  kDiceCertsRegionSizeBytes =
+      FLASH_CTRL_PARAM_BYTES_PER_PAGE - kDiceCertCacheSizeBytes,
+};
+
+static_assert(sizeof(dice_cert_cache_t) == kDiceCertCacheSizeBytes,
+              "Unexpected size for dice_cert_cache_t");
+static_assert(kDiceCertsRegionSizeBytes % sizeof(uint64_t) == 0,
+              "The cache index must start on a flash word boundary");
+
+/**
+ * Look up the subject key for `inputs_digest` in the cache index.
+ *
+ * The tag of a matching entry is checked before the key is returned; an entry
+ * with a bad tag is a miss. KMAC must have been configured by
+ * `ownership_seal_init()`.
+ *
+ * @param cache The cache index.
+ * @param slot The certificate to look up.
+ * @param inputs_digest Digest of the current certificate inputs.
+ * @param[out] pubkey_id The cached subject public key ID, on a hit.
+ * @param[out] pubkey The cached subject public key, on a hit.
+ * @param[out] hit kHardenedBoolTrue on a hit.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t dice_cert_cache_lookup(const dice_cert_cache_t *cache,
+                                   dice_cert_cache_slot_t slot,
+                                   const hmac_digest_t *inputs_digest,
+                                   hmac_digest_t *pubkey_id,
+                                   ecdsa_p256_public_key_t *pubkey,
+                                   hardened_bool_t *hit);
+
+/**
+ * Record a freshly derived subject key in the cache index.
+ *
+ * Computes the tag of the entry and stores it. An index without a valid magic
+ * value is reset first. KMAC must have been configured by
+ * `ownership_seal_init()`.
+ *
+ * @param cache The cache index.
+ * @param slot The certificate to update.
+ * @param entry The inputs digest and the key derived from them; the `tag`
+ *        field is ignored.
+ * @param[out] changed kHardenedBoolTrue if the index changed and must be
+ *        written back.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t dice_cert_cache_update(dice_cert_cache_t *cache,
+                                   dice_cert_cache_slot_t slot,
+                                   const dice_cert_cache_entry_t *entry,
+                                   hardened_bool_t *changed);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_CERT_DICE_CERT_CACHE_H_
@@ -0,0 +1,175 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/cert/dice_cert_cache.h"
+
+#include <cstring>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_kmac.h"
+#include "sw/device/silicon_creator/lib/error.h"
+
+namespace dice_cert_cache_unittest {
+namespace {
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Return;
+
+class DiceCertCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    std::memset(&cache_, 0, sizeof(cache_));
+    for (size_t i = 0; i < ARRAYSIZE(entry_.inputs_digest.digest); ++i) {
+      entry_.inputs_digest.digest[i] = 0x11111111 * (i + 1);
+      entry_.pubkey_id.digest[i] = 0xa0a0a0a0 ^ i;
+    }
+    for (size_t i = 0; i < ARRAYSIZE(entry_.pubkey.x); ++i) {
+      entry_.pubkey.x[i] = 0x1000 + i;
+      entry_.pubkey.y[i] = 0x2000 + i;
+    }
+
+    // Stand-in for the keyed KMAC: an FNV-1a hash of the absorbed message, so
+    // that any change to the tagged bytes changes the tag.
+    EXPECT_CALL(kmac_, Shake256Start()).Times(AnyNumber()).WillRepeatedly([&] {
+      message_.clear();
+      return kErrorOk;
+    });
+    EXPECT_CALL(kmac_, Shake256Absorb(_, _))
+        .Times(AnyNumber())
+        .WillRepeatedly([&](const uint8_t *data, size_t len) {
+          message_.insert(message_.end(), data, data + len);
+        });
+    EXPECT_CALL(kmac_, Kmac256Final(_, kDiceCertCacheTagWords))
+        .Times(AnyNumber())
+        .WillRepeatedly([&](uint32_t *tag, size_t len) {
+          uint32_t h = 0x811c9dc5;
+          for (size_t i = 0; i < len; ++i) {
+            for (uint8_t byte : message_) {
+              h = (h ^ byte) * 0x01000193;
+            }
+            tag[i] = h;
+          }
+          return kErrorOk;
+        });
+  }
+
+  hardened_bool_t Lookup(dice_cert_cache_slot_t slot,
+                         const hmac_digest_t &inputs) {
+    hardened_bool_t hit;
+    EXPECT_EQ(dice_cert_cache_lookup(&cache_, slot, &inputs, &pubkey_id_,
+                                     &pubkey_, &hit),
+              kErrorOk);
+    return hit;
+  }
+
+  hardened_bool_t Update(dice_cert_cache_slot_t slot) {
+    hardened_bool_t changed;
+    EXPECT_EQ(dice_cert_cache_update(&cache_, slot, &entry_, &changed),
+              kErrorOk);
+    return changed;
+  }
+
+  dice_cert_cache_t cache_;
+  dice_cert_cache_entry_t entry_ = {};
+  hmac_digest_t pubkey_id_ = {};
+  ecdsa_p256_public_key_t pubkey_ = {};
+  std::vector<uint8_t> message_;
+  rom_test::MockKmac kmac_;
+};
+
+TEST_F(DiceCertCacheTest, Hit) {
+  EXPECT_EQ(Update(kDiceCertCacheSlotCdi1), kHardenedBoolTrue);
+
+  EXPECT_EQ(Lookup(kDiceCertCacheSlotCdi1, entry_.inputs_digest),
+            kHardenedBoolTrue);
+  EXPECT_EQ(std::memcmp(&pubkey_id_, &entry_.pubkey_id, sizeof(pubkey_id_)),
+            0);
+  EXPECT_EQ(std::memcmp(&pubkey_, &entry_.pubkey, sizeof(pubkey_)), 0);
+}
+
+TEST_F(DiceCertCacheTest, MissOnDifferentInputs) {
+  EXPECT_EQ(Update(kDiceCertCacheSlotCdi0), kHardenedBoolTrue);
+
+  hmac_digest_t inputs = entry_.inputs_digest;
+  inputs.digest[7] ^= 1;
+  EXPECT_EQ(Lookup(kDiceCertCacheSlotCdi0, inputs), kHardenedBoolFalse);
+  // The other slot is empty.
+  EXPECT_EQ(Lookup(kDiceCertCacheSlotCdi1, entry_.inputs_digest),
+            kHardenedBoolFalse);
+
+  // Nothing is returned on a miss.
+  const hmac_digest_t kZeroId = {};
+  const ecdsa_p256_public_key_t kZeroKey = {};
+  EXPECT_EQ(std::memcmp(&pubkey_id_, &kZeroId, sizeof(pubkey_id_)), 0);
+  EXPECT_EQ(std::memcmp(&pubkey_, &kZeroKey, sizeof(pubkey_)), 0);
+}
+
+TEST_F(DiceCertCacheTest, MissOnBadTag) {
+  EXPECT_EQ(Update(kDiceCertCacheSlotCdi0), kHardenedBoolTrue);
+
+  // A key substituted in flash without a matching tag is never returned.
+  cache_.entries[kDiceCertCacheSlotCdi0].pubkey.x[0] ^= 1;
+  EXPECT_EQ(Lookup(kDiceCertCacheSlotCdi0, entry_.inputs_digest),
+            kHardenedBoolFalse);
+  cache_.entries[kDiceCertCacheSlotCdi0].pubkey.x[0] ^= 1;
+  cache_.entries[kDiceCertCacheSlotCdi0].pubkey_id.digest[3] ^= 1;
+  EXPECT_EQ(Lookup(kDiceCertCacheSlotCdi0, entry_.inputs_digest),
+            kHardenedBoolFalse);
+  cache_.entries[kDiceCertCacheSlotCdi0].pubkey_id.digest[3] ^= 1;
+
+  // Nor is an entry moved to another slot.
+  cache_.entries[kDiceCertCacheSlotCdi1] =
+      cache_.entries[kDiceCertCacheSlotCdi0];
+  EXPECT_EQ(Lookup(kDiceCertCacheSlotCdi1, entry_.inputs_digest),
+            kHardenedBoolFalse);
+  EXPECT_EQ(Lookup(kDiceCertCacheSlotCdi0, entry_.inputs_digest),
+            kHardenedBoolTrue);
+}
+
+TEST_F(DiceCertCacheTest, KmacError) {
+  EXPECT_EQ(Update(kDiceCertCacheSlotCdi0), kHardenedBoolTrue);
+
+  EXPECT_CALL(kmac_, Shake256Start()).WillOnce(Return(kErrorKmacInvalidStatus));
+  hardened_bool_t hit;
+  EXPECT_EQ(dice_cert_cache_lookup(&cache_, kDiceCertCacheSlotCdi0,
+                                   &entry_.inputs_digest, &pubkey_id_,
+                                   &pubkey_, &hit),
+            kErrorKmacInvalidStatus);
+  EXPECT_EQ(hit, kHardenedBoolFalse);
+}
+
+TEST_F(DiceCertCacheTest, StaleIndex) {
+  // An index without the magic value, e.g. an erased page or one written by
+  // older firmware, never hits, even if an entry happens to match.
+  EXPECT_EQ(Update(kDiceCertCacheSlotCdi0), kHardenedBoolTrue);
+  for (uint32_t magic : {0u, UINT32_MAX, kDiceCertCacheMagic ^ 1u}) {
+    cache_.magic = magic;
+    EXPECT_EQ(Lookup(kDiceCertCacheSlotCdi0, entry_.inputs_digest),
+              kHardenedBoolFalse);
+  }
+
+  // Updating a stale index resets the other entries.
+  cache_.entries[kDiceCertCacheSlotCdi1] =
+      cache_.entries[kDiceCertCacheSlotCdi0];
+  EXPECT_EQ(Update(kDiceCertCacheSlotCdi0), kHardenedBoolTrue);
+  EXPECT_EQ(cache_.magic, kDiceCertCacheMagic);
+  EXPECT_EQ(Lookup(kDiceCertCacheSlotCdi0, entry_.inputs_digest),
+            kHardenedBoolTrue);
+  EXPECT_EQ(Lookup(kDiceCertCacheSlotCdi1, entry_.inputs_digest),
+            kHardenedBoolFalse);
+}
+
+TEST_F(DiceCertCacheTest, UpdateOnlyReportsChanges) {
+  EXPECT_EQ(Update(kDiceCertCacheSlotCdi0), kHardenedBoolTrue);
+  EXPECT_EQ(Update(kDiceCertCacheSlotCdi0), kHardenedBoolFalse);
+
+  entry_.pubkey.y[0] ^= 1;
+  EXPECT_EQ(Update(kDiceCertCacheSlotCdi0), kHardenedBoolTrue);
+}
+
+}  // namespace
+}  // namespace dice_cert_cache_unittest
@@ -13,6 +13,7 @@
 #include "sw/device/silicon_creator/lib/base/static_dice_cdi_0.h"
 #include "sw/device/silicon_creator/lib/base/util.h"
 #include "sw/device/silicon_creator/lib/cert/dice.h"
+#include "sw/device/silicon_creator/lib/cert/dice_cert_cache.h"
 #include "sw/device/silicon_creator/lib/dbg_print.h"
 #include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
 #include "sw/device/silicon_creator/lib/drivers/kmac.h"
@@ -95,6 +96,12 @@ typedef struct dice_chain {
    */
   hardened_bool_t cert_valid;
 
+  /**
+   * Digest of the inputs of the certificate being processed, used to look up
+   * and update the cache index.
+   */
+  hmac_digest_t inputs_digest;
+
 } dice_chain_t;
 
 static dice_chain_t dice_chain;
@@ -104,12 +111,23 @@ cert_key_id_pair_t dice_chain_cdi_0_key_ids = (cert_key_id_pair_t){
     .cert = &static_dice_cdi_0.cdi_0_pubkey_id,
 };
 
+// Get the size of the part of `data` that holds TLV objects. The end of the
+// DICE certificate page is reserved for the certificate cache index.
+OT_WARN_UNUSED_RESULT
+static size_t dice_chain_get_region_size(void) {
+  if (dice_chain.info_page == &kFlashCtrlInfoPageDiceCerts) {
+    return kDiceCertsRegionSizeBytes;
+  }
+  return sizeof(dice_chain.data);
+}
+
 // Get the size of the remaining tail space that is not processed yet.
 OT_WARN_UNUSED_RESULT
 OT_NOINLINE
 static size_t dice_chain_get_tail_size(void) {
-  HARDENED_CHECK_GE(sizeof(dice_chain.data), dice_chain.tail_offset);
-  return sizeof(dice_chain.data) - dice_chain.tail_offset;
+  size_t region_size = dice_chain_get_region_size();
+  HARDENED_CHECK_GE(region_size, dice_chain.tail_offset);
+  return region_size - dice_chain.tail_offset;
 }
 
 // Get the pointer to the remaining tail space that is not processed yet.
@@ -141,7 +159,7 @@ static void dice_chain_next_cert_obj(void) {
   dice_chain.tail_offset += cert_size;
 
   // Post-check for the buffer boundary.
-  HARDENED_CHECK_LE(dice_chain.tail_offset, sizeof(dice_chain.data));
+  HARDENED_CHECK_LE(dice_chain.tail_offset, dice_chain_get_region_size());
 
   dice_chain_reset_cert_obj();
 }
@@ -260,6 +278,64 @@ static rom_error_t dice_chain_push_cert(const char *name, const uint8_t *cert,
   return kErrorOk;
 }
 
+// Get the cache index of the buffered DICE certificate page.
+static dice_cert_cache_t *dice_chain_cache_get(void) {
+  HARDENED_CHECK_EQ((uintptr_t)dice_chain.info_page,
+                    (uintptr_t)&kFlashCtrlInfoPageDiceCerts);
+  return (dice_cert_cache_t *)&dice_chain.data[kDiceCertsRegionSizeBytes];
+}
+
+/**
+ * Derive the subject key for the current certificate through OTBN and record
+ * it in the cache index.
+ *
+ * @param slot The certificate to derive the key for.
+ * @param key The keymgr key to generate.
+ * @return errors encountered during the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t dice_chain_subject_keygen(dice_cert_cache_slot_t slot,
+                                             sc_keymgr_ecc_key_t key) {
+  HARDENED_RETURN_IF_ERROR(otbn_boot_cert_ecc_p256_keygen(
+      key, &dice_chain.subject_pubkey_id, &dice_chain.subject_pubkey));
+  dice_cert_cache_entry_t entry = {
+      .inputs_digest = dice_chain.inputs_digest,
+      .pubkey_id = dice_chain.subject_pubkey_id,
+      .pubkey = dice_chain.subject_pubkey,
+  };
+  hardened_bool_t changed;
+  HARDENED_RETURN_IF_ERROR(
+      dice_cert_cache_update(dice_chain_cache_get(), slot, &entry, &changed));
+  if (changed == kHardenedBoolTrue) {
+    dice_chain.data_dirty = kHardenedBoolTrue;
+  }
+  return kErrorOk;
+}
+
+/**
+ * Load the subject key for the current certificate from the cache index, or
+ * derive it on a miss.
+ *
+ * Cached entries are only returned once their tag has been checked, so a hit
+ * is as good as a freshly derived key.
+ *
+ * @param slot The certificate to load the key for.
+ * @param key The keymgr key to generate on a cache miss.
+ * @return errors encountered during the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t dice_chain_subject_key_load(dice_cert_cache_slot_t slot,
+                                               sc_keymgr_ecc_key_t key) {
+  hardened_bool_t hit;
+  HARDENED_RETURN_IF_ERROR(dice_cert_cache_lookup(
+      dice_chain_cache_get(), slot, &dice_chain.inputs_digest,
+      &dice_chain.subject_pubkey_id, &dice_chain.subject_pubkey, &hit));
+  if (hit == kHardenedBoolTrue) {
+    return kErrorOk;
+  }
+  return dice_chain_subject_keygen(slot, key);
+}
+
 rom_error_t dice_chain_attestation_silicon(void) {
   // Initialize the entropy complex and KMAC for key manager operations.
   // Note: `OTCRYPTO_OK.value` is equal to `kErrorOk` but we cannot add a static
@@ -307,19 +383,37 @@ rom_error_t dice_chain_attestation_creator(
       /*sealing_binding=*/&seal_binding_value,
       /*attest_binding=*/rom_ext_measurement,
       rom_ext_manifest->max_key_version));
-  HARDENED_RETURN_IF_ERROR(otbn_boot_cert_ecc_p256_keygen(
-      kDiceKeyCdi0, &static_dice_cdi_0.cdi_0_pubkey_id,
-      &static_dice_cdi_0.cdi_0_pubkey));
 
   // Switch page for the device generated CDI_0.
   RETURN_IF_ERROR(dice_chain_load_flash(&kFlashCtrlInfoPageDiceCerts));
 
+  // The CDI_0 key is derived from the UDS key and the ROM_EXT bindings. The
+  // UDS key ID stands in for the creator secrets, which change along with it.
+  hmac_sha256_init();
+  hmac_sha256_update("CDI_0", /*len=*/6);
+  hmac_sha256_update(&static_dice_cdi_0.uds_pubkey_id,
+                     sizeof(static_dice_cdi_0.uds_pubkey_id));
+  hmac_sha256_update(rom_ext_measurement, sizeof(*rom_ext_measurement));
+  hmac_sha256_update(&seal_binding_value, sizeof(seal_binding_value));
+  hmac_sha256_update(&rom_ext_manifest->max_key_version,
+                     sizeof(rom_ext_manifest->max_key_version));
+  hmac_sha256_update(&rom_ext_manifest->security_version,
+                     sizeof(rom_ext_manifest->security_version));
+  hmac_sha256_process();
+  hmac_sha256_final(&dice_chain.inputs_digest);
+  HARDENED_RETURN_IF_ERROR(
+      dice_chain_subject_key_load(kDiceCertCacheSlotCdi0, kDiceKeyCdi0));
+  static_dice_cdi_0.cdi_0_pubkey_id = dice_chain.subject_pubkey_id;
+  static_dice_cdi_0.cdi_0_pubkey = dice_chain.subject_pubkey;
+
   // Seek to skip previous objects.
   RETURN_IF_ERROR(dice_chain_skip_cert_obj("UDS", /*name_size=*/4));
 
   // Check if the current CDI_0 cert is valid.
   RETURN_IF_ERROR(dice_chain_load_cert_obj("CDI_0", /*name_size=*/6));
-  if (dice_chain.cert_valid == kHardenedBoolFalse) {
+  if (dice_chain.cert_valid == kHardenedBoolFalse ||
+      dice_chain.cert_obj.cert_body_size >
+          sizeof(static_dice_cdi_0.cert_data)) {
     // Update the cert page buffer.
     static_dice_cdi_0.cert_size = sizeof(static_dice_cdi_0.cert_data);
     HARDENED_RETURN_IF_ERROR(dice_cdi_0_cert_build(
@@ -328,12 +422,20 @@ rom_error_t dice_chain_attestation_creator(
         &static_dice_cdi_0.cdi_0_pubkey, static_dice_cdi_0.cert_data,
         &static_dice_cdi_0.cert_size));
   } else {
+    // Hand the stored cert over to the owner stage as if it had been built.
+    memcpy(static_dice_cdi_0.cert_data, dice_chain.cert_obj.cert_body_p,
+           dice_chain.cert_obj.cert_body_size);
+    static_dice_cdi_0.cert_size = dice_chain.cert_obj.cert_body_size;
     // Replace UDS with CDI_0 key for endorsing next stage cert.
     HARDENED_RETURN_IF_ERROR(otbn_boot_attestation_key_save(
         kDiceKeyCdi0.keygen_seed_idx, kDiceKeyCdi0.type,
         *kDiceKeyCdi0.keymgr_diversifier));
   }
 
+  // Persist the cache index if a new CDI_0 key was derived. The owner stage
+  // runs from a separate image and only sees the index through flash.
+  RETURN_IF_ERROR(dice_chain_flush_flash());
+
   sc_keymgr_sw_binding_unlock_wait();
 
   return kErrorOk;
@@ -396,7 +498,7 @@ static rom_error_t dice_chain_attestation_check_cdi_0(void) {
 rom_error_t dice_chain_attestation_owner(
     const manifest_t *owner_manifest, keymgr_binding_value_t *bl0_measurement,
     hmac_digest_t *owner_measurement, keymgr_binding_value_t *sealing_binding,
-    owner_app_domain_t key_domain) {
+    const hmac_digest_t *owner_history, owner_app_domain_t key_domain) {
   // Handles the certificates from the immutable rom_ext first.
   RETURN_IF_ERROR(dice_chain_attestation_check_uds());
   RETURN_IF_ERROR(dice_chain_attestation_check_cdi_0());
@@ -423,8 +525,26 @@ rom_error_t dice_chain_attestation_owner(
       /*sealing_binding=*/sealing_binding,
       /*attest_binding=*/(keymgr_binding_value_t *)&attest_measurement,
       owner_manifest->max_key_version));
-  HARDENED_RETURN_IF_ERROR(otbn_boot_cert_ecc_p256_keygen(
-      kDiceKeyCdi1, &dice_chain.subject_pubkey_id, &dice_chain.subject_pubkey));
+
+  // The CDI_1 key is derived from the CDI_0 key, the owner bindings and the
+  // owner secret. The ownership history is rotated along with the secret.
+  hmac_sha256_init();
+  hmac_sha256_update("CDI_1", /*len=*/6);
+  hmac_sha256_update(&static_dice_cdi_0.cdi_0_pubkey_id,
+                     sizeof(static_dice_cdi_0.cdi_0_pubkey_id));
+  hmac_sha256_update(owner_history, sizeof(*owner_history));
+  hmac_sha256_update(&attest_measurement, sizeof(attest_measurement));
+  hmac_sha256_update(owner_measurement, sizeof(*owner_measurement));
+  hmac_sha256_update(sealing_binding, sizeof(*sealing_binding));
+  hmac_sha256_update(&owner_manifest->max_key_version,
+                     sizeof(owner_manifest->max_key_version));
+  hmac_sha256_update(&owner_manifest->security_version,
+                     sizeof(owner_manifest->security_version));
+  hmac_sha256_update(&key_domain, sizeof(key_domain));
+  hmac_sha256_process();
+  hmac_sha256_final(&dice_chain.inputs_digest);
+  HARDENED_RETURN_IF_ERROR(
+      dice_chain_subject_key_load(kDiceCertCacheSlotCdi1, kDiceKeyCdi1));
 
   // Check if the current CDI_1 cert is valid.
   RETURN_IF_ERROR(dice_chain_load_cert_obj("CDI_1", /*name_size=*/6));
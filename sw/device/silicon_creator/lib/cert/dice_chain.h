@@ -35,6 +35,11 @@ rom_error_t dice_chain_attestation_silicon(void);
 /**
  * Check the CDI_0 certificate and regenerate if invalid.
  *
+ * The CDI_0 public key is reused from the certificate cache index when the
+ * ROM_EXT bindings are unchanged since the last boot and the entry's tag
+ * checks out, in which case OTBN key generation is skipped. The cache tags
+ * are keyed by KMAC, which must have been set up by `ownership_seal_init()`.
+ *
  * @param rom_ext_measurement Pointer to the measurements to attest.
  * @param rom_ext_manifest Pointer to the current rom_ext manifest.
  * @return errors encountered during the operation.
@@ -47,11 +52,16 @@ rom_error_t dice_chain_attestation_creator(
 /**
  * Check the CDI_1 certificate and regenerate if invalid.
  *
+ * As for CDI_0, OTBN key generation is skipped when the owner bindings and
+ * secret are unchanged since the last boot.
+ *
  * @param owner_manifest Pointer to the owner SW manifest to be boot.
  * @param bl0_measurement Pointer to the measurement of the owner firmware.
  * @param owner_measurement Pointer to the measurement of the owner config.
  * @param sealing_binding Pointer to the owner's sealing diversification
  *        constant.
+ * @param owner_history Pointer to the ownership history digest, which changes
+ *        whenever the owner secret does.
  * @param key_domain Domain of the Owner SW signing key.
  * @return errors encountered during the operation.
  */
@@ -59,7 +69,7 @@ OT_WARN_UNUSED_RESULT
 rom_error_t dice_chain_attestation_owner(
     const manifest_t *owner_manifest, keymgr_binding_value_t *bl0_measurement,
     hmac_digest_t *owner_measurement, keymgr_binding_value_t *sealing_binding,
-    owner_app_domain_t key_domain);
+    const hmac_digest_t *owner_history, owner_app_domain_t key_domain);
 
 /**
  * Write back the certificate chain to flash if changed.
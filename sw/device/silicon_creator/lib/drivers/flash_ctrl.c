@@ -181,6 +181,12 @@ static rom_error_t wait_for_done(rom_error_t error) {
   return kErrorOk;
 }
 
+/**
+ * Error to report for the operation started by a `flash_ctrl_*_start()`
+ * function.
+ */
+static rom_error_t pending_error = kErrorOk;
+
 /**
  * Writes data to the given partition.
  *
@@ -414,6 +420,59 @@ rom_error_t flash_ctrl_data_erase(uint32_t addr,
   return wait_for_done(kErrorFlashCtrlDataErase);
 }
 
+void flash_ctrl_data_erase_start(uint32_t addr,
+                                 flash_ctrl_erase_type_t erase_type) {
+  transaction_start((transaction_params_t){
+      .addr = addr,
+      .op_type = FLASH_CTRL_CONTROL_OP_VALUE_ERASE,
+      .erase_type = erase_type,
+      .partition = kFlashCtrlPartitionData,
+      // Does not apply to erase transactions.
+      .word_count = 1,
+  });
+  pending_error = kErrorFlashCtrlDataErase;
+}
+
+uint32_t flash_ctrl_data_write_start(uint32_t addr, uint32_t word_count,
+                                     const void *data) {
+  enum {
+    kWindowWordCount = FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t)
+  };
+  // Program operations can't cross window boundaries.
+  uint32_t window_word_count =
+      kWindowWordCount - ((addr / sizeof(uint32_t)) % kWindowWordCount);
+  if (word_count > window_word_count) {
+    word_count = window_word_count;
+  }
+  transaction_start((transaction_params_t){
+      .addr = addr,
+      .op_type = FLASH_CTRL_CONTROL_OP_VALUE_PROG,
+      .partition = kFlashCtrlPartitionData,
+      .word_count = word_count,
+      // Does not apply to program transactions.
+      .erase_type = kFlashCtrlEraseTypePage,
+  });
+  fifo_write(word_count, data);
+  pending_error = kErrorFlashCtrlDataWrite;
+  return word_count;
+}
+
+rom_error_t flash_ctrl_poll(hardened_bool_t *done) {
+  uint32_t op_status =
+      abs_mmio_read32(flash_ctrl_core_base() + FLASH_CTRL_OP_STATUS_REG_OFFSET);
+  if (!bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_DONE_BIT)) {
+    *done = kHardenedBoolFalse;
+    return kErrorOk;
+  }
+  abs_mmio_write32(flash_ctrl_core_base() + FLASH_CTRL_OP_STATUS_REG_OFFSET,
+                   0u);
+  *done = kHardenedBoolTrue;
+  if (bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_ERR_BIT)) {
+    return pending_error;
+  }
+  return kErrorOk;
+}
+
 rom_error_t flash_ctrl_data_erase_verify(uint32_t addr,
                                          flash_ctrl_erase_type_t erase_type) {
   static_assert(__builtin_popcount(FLASH_CTRL_PARAM_BYTES_PER_BANK) == 1,
@@ -419,6 +419,48 @@ OT_WARN_UNUSED_RESULT
 rom_error_t flash_ctrl_data_erase(uint32_t addr,
                                   flash_ctrl_erase_type_t erase_type);
 
+/**
+ * Starts erasing a data partition page or bank without waiting for it to
+ * complete.
+ *
+ * Call `flash_ctrl_poll()` until the operation completes before starting
+ * another flash controller operation. This allows the caller to do other work,
+ * e.g. keep receiving data, during the erase.
+ *
+ * @param addr Address that falls within the bank or page being deleted.
+ * @param erase_type Whether to erase a page or a bank.
+ */
+void flash_ctrl_data_erase_start(uint32_t addr,
+                                 flash_ctrl_erase_type_t erase_type);
+
+/**
+ * Starts writing data to the data partition without waiting for it to
+ * complete.
+ *
+ * A single program operation cannot cross a flash program window, so at most
+ * the words up to the end of the window containing `addr` are written. Call
+ * `flash_ctrl_poll()` until the operation completes, then continue with the
+ * remaining words.
+ *
+ * @param addr Full byte address to write to.
+ * @param word_count Number of bus words to write.
+ * @param data Data to write.
+ * @return Number of words this operation writes.
+ */
+OT_WARN_UNUSED_RESULT
+uint32_t flash_ctrl_data_write_start(uint32_t addr, uint32_t word_count,
+                                     const void *data);
+
+/**
+ * Checks whether the operation started by `flash_ctrl_data_erase_start()` or
+ * `flash_ctrl_data_write_start()` is complete.
+ *
+ * @param[out] done `kHardenedBoolTrue` once the operation is complete.
+ * @return The result of the operation once it is complete, `kErrorOk` before.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_poll(hardened_bool_t *done);
+
 /**
  * Verifies that a data partition page or bank was erased.
  *
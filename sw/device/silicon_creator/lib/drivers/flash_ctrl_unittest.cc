@@ -418,6 +418,45 @@ TEST_F(TransferTest, ProgAcrossWindows) {
             kErrorOk);
 }
 
+TEST_F(TransferTest, EraseDataPageStartPoll) {
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_ERASE, 0x01234567,
+                      1);
+  flash_ctrl_data_erase_start(0x01234567, kFlashCtrlEraseTypePage);
+
+  hardened_bool_t done;
+  ExpectWaitForDone(false, false);
+  EXPECT_EQ(flash_ctrl_poll(&done), kErrorOk);
+  EXPECT_EQ(done, kHardenedBoolFalse);
+
+  ExpectWaitForDone(true, true);
+  EXPECT_EQ(flash_ctrl_poll(&done), kErrorFlashCtrlDataErase);
+  EXPECT_EQ(done, kHardenedBoolTrue);
+}
+
+TEST_F(TransferTest, ProgDataStartStopsAtWindow) {
+  static const uint32_t kWinWords =
+      FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t);
+  std::vector<uint32_t> many_words(kWinWords);
+  for (uint32_t i = 0; i < many_words.size(); ++i) {
+    many_words[i] = i;
+  }
+
+  // Starting half way into a window only programs up to its end.
+  const uint32_t addr = FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / 2;
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG, addr,
+                      kWinWords / 2);
+  ExpectProgData(std::vector<uint32_t>(many_words.begin(),
+                                       many_words.begin() + kWinWords / 2));
+  EXPECT_EQ(
+      flash_ctrl_data_write_start(addr, many_words.size(), &many_words.front()),
+      kWinWords / 2);
+
+  hardened_bool_t done;
+  ExpectWaitForDone(true, false);
+  EXPECT_EQ(flash_ctrl_poll(&done), kErrorOk);
+  EXPECT_EQ(done, kHardenedBoolTrue);
+}
+
 TEST_F(TransferTest, TransferInternalError) {
   ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_READ, 0x01234567,
                       words_.size());
@@ -29,6 +29,10 @@ rom_error_t flash_ctrl_info_read(const flash_ctrl_info_page_t *info_page,
                                             data);
 }
 
+void flash_ctrl_info_lock(const flash_ctrl_info_page_t *info_page) {
+  MockFlashCtrl::Instance().InfoLock(info_page);
+}
+
 rom_error_t flash_ctrl_data_write(uint32_t addr, uint32_t word_count,
                                   const void *data) {
   return MockFlashCtrl::Instance().DataWrite(addr, word_count, data);
@@ -46,6 +50,20 @@ rom_error_t flash_ctrl_data_erase(uint32_t addr,
   return MockFlashCtrl::Instance().DataErase(addr, erase_type);
 }
 
+void flash_ctrl_data_erase_start(uint32_t addr,
+                                 flash_ctrl_erase_type_t erase_type) {
+  MockFlashCtrl::Instance().DataEraseStart(addr, erase_type);
+}
+
+uint32_t flash_ctrl_data_write_start(uint32_t addr, uint32_t word_count,
+                                     const void *data) {
+  return MockFlashCtrl::Instance().DataWriteStart(addr, word_count, data);
+}
+
+rom_error_t flash_ctrl_poll(hardened_bool_t *done) {
+  return MockFlashCtrl::Instance().Poll(done);
+}
+
 rom_error_t flash_ctrl_data_erase_verify(uint32_t addr,
                                          flash_ctrl_erase_type_t erase_type) {
   return MockFlashCtrl::Instance().DataEraseVerify(addr, erase_type);
@@ -0,0 +1,57 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/drivers/mock_kmac.h"
+
+namespace rom_test {
+extern "C" {
+rom_error_t kmac_keymgr_configure(void) {
+  return MockKmac::Instance().KeymgrConfigure();
+}
+
+rom_error_t kmac_kmac256_sw_configure(void) {
+  return MockKmac::Instance().Kmac256SwConfigure();
+}
+
+rom_error_t kmac_kmac256_hw_configure(void) {
+  return MockKmac::Instance().Kmac256HwConfigure();
+}
+
+rom_error_t kmac_shake256_configure(void) {
+  return MockKmac::Instance().Shake256Configure();
+}
+
+rom_error_t kmac_shake256_start(void) {
+  return MockKmac::Instance().Shake256Start();
+}
+
+void kmac_shake256_absorb(const uint8_t *in, size_t inlen) {
+  MockKmac::Instance().Shake256Absorb(in, inlen);
+}
+
+void kmac_shake256_absorb_words(const uint32_t *in, size_t inlen) {
+  MockKmac::Instance().Shake256AbsorbWords(in, inlen);
+}
+
+void kmac_shake256_squeeze_start(void) {
+  MockKmac::Instance().Shake256SqueezeStart();
+}
+
+rom_error_t kmac_shake256_squeeze_end(uint32_t *out, size_t outlen) {
+  return MockKmac::Instance().Shake256SqueezeEnd(out, outlen);
+}
+
+rom_error_t kmac_kmac256_sw_key(const uint32_t *key, size_t len) {
+  return MockKmac::Instance().Kmac256SwKey(key, len);
+}
+
+void kmac_kmac256_set_prefix(const void *prefix, size_t len) {
+  MockKmac::Instance().Kmac256SetPrefix(prefix, len);
+}
+
+rom_error_t kmac_kmac256_final(uint32_t *result, size_t rlen) {
+  return MockKmac::Instance().Kmac256Final(result, rlen);
+}
+}  // extern "C"
+}  // namespace rom_test
@@ -0,0 +1,40 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_DRIVERS_MOCK_KMAC_H_
+#define OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_DRIVERS_MOCK_KMAC_H_
+
+#include "sw/device/lib/base/global_mock.h"
+#include "sw/device/silicon_creator/lib/drivers/kmac.h"
+#include "sw/device/silicon_creator/testing/rom_test.h"
+
+namespace rom_test {
+namespace internal {
+
+/**
+ * Mock class for kmac.c.
+ */
+class MockKmac : public global_mock::GlobalMock<MockKmac> {
+ public:
+  MOCK_METHOD(rom_error_t, KeymgrConfigure, ());
+  MOCK_METHOD(rom_error_t, Kmac256SwConfigure, ());
+  MOCK_METHOD(rom_error_t, Kmac256HwConfigure, ());
+  MOCK_METHOD(rom_error_t, Shake256Configure, ());
+  MOCK_METHOD(rom_error_t, Shake256Start, ());
+  MOCK_METHOD(void, Shake256Absorb, (const uint8_t *, size_t));
+  MOCK_METHOD(void, Shake256AbsorbWords, (const uint32_t *, size_t));
+  MOCK_METHOD(void, Shake256SqueezeStart, ());
+  MOCK_METHOD(rom_error_t, Shake256SqueezeEnd, (uint32_t *, size_t));
+  MOCK_METHOD(rom_error_t, Kmac256SwKey, (const uint32_t *, size_t));
+  MOCK_METHOD(void, Kmac256SetPrefix, (const void *, size_t));
+  MOCK_METHOD(rom_error_t, Kmac256Final, (uint32_t *, size_t));
+};
+
+}  // namespace internal
+
+using MockKmac = testing::StrictMock<internal::MockKmac>;
+
+}  // namespace rom_test
+
+#endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_DRIVERS_MOCK_KMAC_H_
@@ -256,6 +256,31 @@ rom_error_t sc_otbn_dmem_read(size_t num_words, const sc_otbn_addr_t src,
 OT_WARN_UNUSED_RESULT
 rom_error_t sc_otbn_execute(void);
 
+/**
+ * Starts the execution of the application loaded into OTBN.
+ *
+ * Unlike `sc_otbn_execute`, this function returns as soon as the EXECUTE
+ * command has been issued, so that Ibex can do other work while OTBN runs.
+ * Every successful call must be paired with `sc_otbn_execute_finish`, and
+ * DMEM must not be accessed in between.
+ *
+ * If OTBN is busy when this function is called, it blocks until OTBN is idle
+ * before issuing the command.
+ *
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sc_otbn_execute_start(void);
+
+/**
+ * Waits for an execution started by `sc_otbn_execute_start` to complete.
+ *
+ * @return Result of the operation; `kErrorOtbnExecutionFailed` if OTBN
+ * reported an error or did not return to idle.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sc_otbn_execute_finish(void);
+
 /**
  * Blocks until OTBN is idle.
  *
@@ -59,5 +59,12 @@ rom_error_t retention_sram_check_version(void) {
   return kErrorOk;
 }
 
+#ifdef OT_PLATFORM_RV32
 // Extern declarations for the inline functions in the header.
 extern retention_sram_t *retention_sram_get(void);
+#else
+retention_sram_t *retention_sram_get(void) {
+  static retention_sram_t retention_sram;
+  return &retention_sram;
+}
+#endif
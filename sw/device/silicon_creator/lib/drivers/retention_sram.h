@@ -17,6 +17,30 @@
 extern "C" {
 #endif
 
+enum {
+  /**
+   * Owner page validation cache identifier value (ASCII "OPVC").
+   */
+  kRetentionSramOwnerPageCacheIdentifier = 0x4356504f,
+};
+
+/**
+ * Owner page validation cache.
+ *
+ * The ROM_EXT records a validation tag for each owner page whose signature it
+ * has verified, so that it can skip the signature check while the page stays
+ * the same across warm boots.  A tag is a MAC computed with the ownership
+ * sealing key, which later boot stages cannot derive, so a stale or forged
+ * entry can only cause the signature to be checked again.
+ */
+typedef struct retention_sram_owner_page_cache {
+  /** Identifier (`OPVC`). */
+  uint32_t identifier;
+  /** Validation tag of each owner page, or zero if there is none. */
+  uint32_t tag[2][8];
+} retention_sram_owner_page_cache_t;
+OT_ASSERT_SIZE(retention_sram_owner_page_cache_t, 68);
+
 /**
  * Retention SRAM silicon creator area.
  */
@@ -49,12 +73,33 @@ typedef struct retention_sram_creator {
    * - We can add additional members at the end (growing up into reserved
    *   space) without affecting the layout of other structures.
    */
-  uint32_t reserved[(2044 - (sizeof(uint32_t)          // reset_reason
-                             + sizeof(boot_svc_msg_t)  // boot services message
-                             + sizeof(boot_log_t)      // boot_log
-                             + sizeof(rom_error_t)     // last_shutdown_reason
+  uint32_t reserved[(2044 - (sizeof(uint32_t)              // reset_reason
+                             + sizeof(boot_svc_msg_t)      // boot_svc_msg
+                             + sizeof(boot_log_profile_t)  // boot_profile_prev
+                             + sizeof(retention_sram_owner_page_cache_t)
+                             + sizeof(boot_log_profile_t)  // boot_profile
+                             + sizeof(boot_log_t)          // boot_log
+                             + sizeof(rom_error_t)         // shutdown_reason
                              )) /
                     sizeof(uint32_t)];
+  /**
+   * Boot profile of the previous boot.
+   *
+   * The ROM moves `boot_profile` here on every reset that keeps the retention
+   * SRAM, so that the boot before a reset into rescue mode can be read back.
+   */
+  boot_log_profile_t boot_profile_prev;
+  /**
+   * Owner page validation cache.
+   */
+  retention_sram_owner_page_cache_t owner_page_cache;
+  /**
+   * Boot profile area.
+   *
+   * Cycle counts at which ROM and ROM_EXT reached their boot milestones. The
+   * ROM clears it on every boot, after saving it to `boot_profile_prev`.
+   */
+  boot_log_profile_t boot_profile;
   /**
    * Boot log area.
    *
@@ -73,6 +118,9 @@ typedef struct retention_sram_creator {
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, reset_reasons, 0);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, boot_svc_msg, 4);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, reserved, 260);
+OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, boot_profile_prev, 1572);
+OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, owner_page_cache, 1708);
+OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, boot_profile, 1776);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, boot_log, 1912);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, last_shutdown_reason, 2040);
 OT_ASSERT_SIZE(boot_svc_msg_t, 256);
@@ -152,6 +200,7 @@ enum {
  *
  * @return A pointer to the retention SRAM.
  */
+#ifdef OT_PLATFORM_RV32
 OT_WARN_UNUSED_RESULT
 inline retention_sram_t *retention_sram_get(void) {
   // NOTE: this assumes that the retention SRAM is always using the name
@@ -159,6 +208,11 @@ inline retention_sram_t *retention_sram_get(void) {
   return (retention_sram_t *)dt_sram_ctrl_reg_block(kDtSramCtrlRetAon,
                                                     kDtSramCtrlRegBlockRam);
 }
+#else
+// Off-target tests have no retention SRAM, so this returns a static buffer.
+OT_WARN_UNUSED_RESULT
+retention_sram_t *retention_sram_get(void);
+#endif
 
 /**
  * Clear the retention SRAM by setting every word to 0.
@@ -270,10 +270,9 @@ rom_error_t otbn_boot_attestation_endorse(const hmac_digest_t *digest,
   return kErrorOk;
 }
 
-rom_error_t otbn_boot_sigverify(const ecdsa_p256_public_key_t *key,
-                                const ecdsa_p256_signature_t *sig,
-                                const hmac_digest_t *digest,
-                                uint32_t *recovered_r) {
+rom_error_t otbn_boot_sigverify_start(const ecdsa_p256_public_key_t *key,
+                                      const ecdsa_p256_signature_t *sig,
+                                      const hmac_digest_t *digest) {
   // Write the mode.
   uint32_t mode = kOtbnBootModeSigverify;
   HARDENED_RETURN_IF_ERROR(
@@ -295,9 +294,15 @@ rom_error_t otbn_boot_sigverify(const ecdsa_p256_public_key_t *key,
   HARDENED_RETURN_IF_ERROR(sc_otbn_dmem_write(kEcdsaP256SignatureComponentWords,
                                               sig->s, kOtbnVarBootS));
 
-  // Start the OTBN routine.
-  HARDENED_RETURN_IF_ERROR(sc_otbn_execute());
+  // Start the OTBN routine (does not wait for OTBN to be done).
+  HARDENED_RETURN_IF_ERROR(sc_otbn_execute_start());
   SEC_MMIO_WRITE_INCREMENT(kScOtbnSecMmioExecute);
+  return kErrorOk;
+}
+
+rom_error_t otbn_boot_sigverify_finish(uint32_t *recovered_r) {
+  // Wait for the OTBN routine to complete.
+  HARDENED_RETURN_IF_ERROR(sc_otbn_execute_finish());
 
   // Check if the signature passed basic checks.
   uint32_t ok;
@@ -316,3 +321,11 @@ rom_error_t otbn_boot_sigverify(const ecdsa_p256_public_key_t *key,
   return sc_otbn_dmem_read(kEcdsaP256SignatureComponentWords, kOtbnVarBootXr,
                            recovered_r);
 }
+
+rom_error_t otbn_boot_sigverify(const ecdsa_p256_public_key_t *key,
+                                const ecdsa_p256_signature_t *sig,
+                                const hmac_digest_t *digest,
+                                uint32_t *recovered_r) {
+  HARDENED_RETURN_IF_ERROR(otbn_boot_sigverify_start(key, sig, digest));
+  return otbn_boot_sigverify_finish(recovered_r);
+}
@@ -200,6 +200,40 @@ rom_error_t otbn_boot_sigverify(const ecdsa_p256_public_key_t *key,
                                 const hmac_digest_t *digest,
                                 uint32_t *recovered_r);
 
+/**
+ * Starts an ECDSA-P256 signature verification on OTBN without waiting for it.
+ *
+ * This is the first half of `otbn_boot_sigverify`; it loads the inputs into
+ * DMEM and starts OTBN, so that the caller can do other work (e.g. SPHINCS+
+ * verification) while OTBN computes. A successful call must be followed by
+ * `otbn_boot_sigverify_finish` before OTBN is used again.
+ *
+ * Expects the OTBN boot-services program to already be loaded; see
+ * `otbn_boot_app_load`.
+ *
+ * @param key An ECDSA-P256 public key.
+ * @param sig An ECDSA-P256 signature.
+ * @param digest Message digest to check against.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t otbn_boot_sigverify_start(const ecdsa_p256_public_key_t *key,
+                                      const ecdsa_p256_signature_t *sig,
+                                      const hmac_digest_t *digest);
+
+/**
+ * Waits for a verification started by `otbn_boot_sigverify_start` and returns
+ * the recovered `r` value.
+ *
+ * As with `otbn_boot_sigverify`, the caller is responsible for comparing the
+ * recovered `r` value against the signature.
+ *
+ * @param[out] recovered_r Buffer for the recovered `r` value.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t otbn_boot_sigverify_finish(uint32_t *recovered_r);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
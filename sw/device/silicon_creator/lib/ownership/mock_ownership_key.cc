@@ -26,6 +26,10 @@ rom_error_t ownership_seal_check(size_t page) {
   return MockOwnershipKey::Instance().seal_check(page);
 }
 
+rom_error_t ownership_seal_check_tag(size_t page, uint32_t *tag) {
+  return MockOwnershipKey::Instance().seal_check_tag(page, tag);
+}
+
 rom_error_t ownership_secret_new() {
   return MockOwnershipKey::Instance().secret_new();
 }
@@ -79,6 +79,36 @@ void owner_config_default(owner_config_t *config) {
   config->sram_exec = kOwnerSramExecModeDisabledLocked;
 }
 
+uint32_t owner_application_key_id(const owner_application_key_t *key) {
+  uint32_t id = key->data.id;
+  if ((key->key_alg & kOwnershipKeyAlgCategoryMask) ==
+      kOwnershipKeyAlgCategoryHybrid) {
+    // The ID of a hybrid key is the xor of the IDs of each key.
+    id ^= key->data.hybrid.spx.data[0];
+  }
+  return id;
+}
+
+/**
+ * Add a key to the keyring, keeping `keyring->order` sorted by key ID.
+ */
+static void owner_keyring_add(owner_application_keyring_t *keyring,
+                              const owner_application_key_t *key) {
+  size_t n = keyring->length;
+  uint32_t id = owner_application_key_id(key);
+  keyring->key[n] = key;
+  keyring->id[n] = id;
+  // Insert after any keys with the same ID so that lookups find the first key
+  // added, as a linear scan would.
+  size_t pos = n;
+  while (pos > 0 && keyring->id[keyring->order[pos - 1]] > id) {
+    keyring->order[pos] = keyring->order[pos - 1];
+    --pos;
+  }
+  keyring->order[pos] = (uint8_t)n;
+  keyring->length = n + 1;
+}
+
 rom_error_t owner_block_parse(const owner_block_t *block,
                               owner_config_t *config,
                               owner_application_keyring_t *keyring) {
@@ -112,8 +142,7 @@ rom_error_t owner_block_parse(const owner_block_t *block,
           return kErrorOwnershipAPPKVersion;
 
         if (keyring->length < ARRAYSIZE(keyring->key)) {
-          keyring->key[keyring->length++] =
-              (const owner_application_key_t *)item;
+          owner_keyring_add(keyring, (const owner_application_key_t *)item);
         }
         break;
       case kTlvTagFlashConfig:
@@ -303,18 +332,21 @@ rom_error_t owner_block_info_apply(const owner_flash_info_config_t *info) {
 
 rom_error_t owner_keyring_find_key(const owner_application_keyring_t *keyring,
                                    uint32_t key_id, size_t *index) {
-  for (size_t i = 0; i < keyring->length; ++i) {
-    uint32_t id = keyring->key[i]->data.id;
-    if ((keyring->key[i]->key_alg & kOwnershipKeyAlgCategoryMask) ==
-        kOwnershipKeyAlgCategoryHybrid) {
-      // The ID of a hybrid key is the xor of the IDs of each key.
-      id ^= keyring->key[i]->data.hybrid.spx.data[0];
-    }
-    if (id == key_id) {
-      *index = i;
-      return kErrorOk;
+  // Find the first entry of `order` whose ID is not less than `key_id`.
+  size_t lo = 0;
+  size_t hi = keyring->length;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (keyring->id[keyring->order[mid]] < key_id) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
     }
   }
+  if (lo < keyring->length && keyring->id[keyring->order[lo]] == key_id) {
+    *index = keyring->order[lo];
+    return kErrorOk;
+  }
   return kErrorOwnershipKeyNotFound;
 }
 
@@ -47,15 +47,30 @@ typedef struct owner_config {
   const owner_rescue_config_t *rescue;
 } owner_config_t;
 
+enum {
+  /** The maximum number of application keys in a keyring. */
+  kOwnerApplicationKeyringMax = 16,
+};
+
 /**
  * The application keyring collects application keys from the owner config
  * block.
+ *
+ * Key IDs are computed once, when a key is added, and `order` indexes the keys
+ * by ID so that `owner_keyring_find_key()` can binary search it.
  */
 typedef struct owner_application_keyring {
   /** The number of application keys found. */
   size_t length;
   /** Pointers to the application keys. */
-  const owner_application_key_t *key[16];
+  const owner_application_key_t *key[kOwnerApplicationKeyringMax];
+  /** The ID of each key (see `owner_application_key_id()`). */
+  uint32_t id[kOwnerApplicationKeyringMax];
+  /**
+   * Indices into `key`, sorted by ID.  Keys with the same ID are kept in the
+   * order in which they were added.
+   */
+  uint8_t order[kOwnerApplicationKeyringMax];
 } owner_application_keyring_t;
 
 /**
@@ -128,6 +143,28 @@ rom_error_t owner_block_flash_apply(const owner_flash_config_t *flash,
  */
 rom_error_t owner_block_info_apply(const owner_flash_info_config_t *info);
 
+/**
+ * Compute the ID of an application key.
+ *
+ * The ID is the first word of the key material.  For hybrid keys, it is the
+ * xor of the IDs of the ECDSA and SPX keys.
+ *
+ * @param key The application key.
+ * @return The key ID.
+ */
+uint32_t owner_application_key_id(const owner_application_key_t *key);
+
+/**
+ * Find an application key by ID.
+ *
+ * If several keys have the same ID, the one that was added to the keyring first
+ * is returned.
+ *
+ * @param keyring The keyring to search.
+ * @param key_id The ID of the key.
+ * @param index The index of the key in `keyring->key`.
+ * @return kErrorOk if found, kErrorOwnershipKeyNotFound otherwise.
+ */
 rom_error_t owner_keyring_find_key(const owner_application_keyring_t *keyring,
                                    uint32_t key_id, size_t *index);
 
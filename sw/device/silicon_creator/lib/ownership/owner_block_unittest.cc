@@ -470,6 +470,64 @@ TEST_F(OwnerBlockTest, ParseBlockDupRescue) {
   EXPECT_EQ(error, kErrorOwnershipDuplicateItem);
 }
 
+TEST_F(OwnerBlockTest, KeyringFindKey) {
+  struct {
+    uint32_t key_alg;
+    uint32_t id;
+    uint32_t spx_id;
+  } keys[] = {
+      {kOwnershipKeyAlgEcdsaP256, 0x30, 0},
+      {kOwnershipKeyAlgEcdsaP256, 0x10, 0},
+      // A hybrid key with ID 0x20.
+      {kOwnershipKeyAlgHybridSpxPure, 0x55, 0x55 ^ 0x20},
+      {kOwnershipKeyAlgEcdsaP256, 0x20, 0},
+      {kOwnershipKeyAlgSpxPure, 0x05, 0},
+  };
+  owner_block_t block;
+  memset(&block, 0x5a, sizeof(block));
+  block.header = {
+      .tag = kTlvTagOwner,
+      .length = sizeof(owner_block_t),
+      .version = {0, 0},
+  };
+  const uint16_t len =
+      offsetof(owner_application_key_t, data) + sizeof(hybrid_key_t);
+  for (size_t i = 0; i < ARRAYSIZE(keys); ++i) {
+    owner_application_key_t key{};
+    key.header = {
+        .tag = kTlvTagApplicationKey,
+        .length = len,
+        .version = {0, 0},
+    };
+    key.key_alg = keys[i].key_alg;
+    key.data.hybrid.ecdsa.x[0] = keys[i].id;
+    key.data.hybrid.spx.data[0] = keys[i].spx_id;
+    memcpy(&block.data[i * len], &key, len);
+  }
+
+  owner_config_t config;
+  owner_application_keyring_t keyring{};
+  EXPECT_EQ(owner_block_parse(&block, &config, &keyring), kErrorOk);
+  ASSERT_EQ(keyring.length, ARRAYSIZE(keys));
+
+  size_t index;
+  EXPECT_EQ(owner_keyring_find_key(&keyring, 0x05, &index), kErrorOk);
+  EXPECT_EQ(index, 4);
+  EXPECT_EQ(owner_keyring_find_key(&keyring, 0x10, &index), kErrorOk);
+  EXPECT_EQ(index, 1);
+  // Both key 2 and key 3 have ID 0x20; the first one wins.
+  EXPECT_EQ(owner_keyring_find_key(&keyring, 0x20, &index), kErrorOk);
+  EXPECT_EQ(index, 2);
+  EXPECT_EQ(owner_keyring_find_key(&keyring, 0x30, &index), kErrorOk);
+  EXPECT_EQ(index, 0);
+  EXPECT_EQ(owner_keyring_find_key(&keyring, 0x55, &index),
+            kErrorOwnershipKeyNotFound);
+  EXPECT_EQ(owner_keyring_find_key(&keyring, 0x00, &index),
+            kErrorOwnershipKeyNotFound);
+  EXPECT_EQ(owner_keyring_find_key(&keyring, 0xffffffff, &index),
+            kErrorOwnershipKeyNotFound);
+}
+
 struct TagError {
   tlv_tag_t tag;
   rom_error_t expect;
@@ -13,6 +13,7 @@
 #include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
 #include "sw/device/silicon_creator/lib/drivers/hmac.h"
 #include "sw/device/silicon_creator/lib/drivers/lifecycle.h"
+#include "sw/device/silicon_creator/lib/drivers/retention_sram.h"
 #include "sw/device/silicon_creator/lib/error.h"
 #include "sw/device/silicon_creator/lib/ownership/ecdsa.h"
 #include "sw/device/silicon_creator/lib/ownership/owner_block.h"
@@ -41,20 +42,42 @@ static owner_page_status_t owner_page_validity_check(size_t page) {
     }
   }
 
-  rom_error_t sealed = ownership_seal_check(page);
+  uint32_t tag[ARRAYSIZE(owner_page[0].seal)];
+  rom_error_t sealed = ownership_seal_check_tag(page, tag);
   if (sealed == kErrorOk) {
     HARDENED_CHECK_EQ(sealed, kErrorOk);
     return kOwnerPageStatusSealed;
   }
 
+  // If the signature on this exact page was verified on an earlier boot since
+  // the last power-on, skip the signature check.
+  retention_sram_owner_page_cache_t *cache =
+      &retention_sram_get()->creator.owner_page_cache;
+  if (cache->identifier != kRetentionSramOwnerPageCacheIdentifier) {
+    memset(cache, 0, sizeof(*cache));
+    cache->identifier = kRetentionSramOwnerPageCacheIdentifier;
+  }
+  hardened_bool_t tag_valid = sealed == kErrorOwnershipInvalidInfoPage
+                                  ? kHardenedBoolTrue
+                                  : kHardenedBoolFalse;
+  if (tag_valid == kHardenedBoolTrue &&
+      hardened_memeq(cache->tag[page], tag, ARRAYSIZE(tag)) ==
+          kHardenedBoolTrue) {
+    return kOwnerPageStatusSigned;
+  }
+
   hardened_bool_t result = ownership_key_validate(page, kOwnershipKeyOwner,
                                                   &owner_page[page].signature,
                                                   &owner_page[page], sig_len);
   if (result == kHardenedBoolFalse) {
     // If the page is bad, destroy the RAM copy.
     memset(&owner_page[page], 0x5a, sizeof(owner_page[0]));
+    memset(cache->tag[page], 0, sizeof(cache->tag[page]));
     return kOwnerPageStatusInvalid;
   }
+  if (tag_valid == kHardenedBoolTrue) {
+    memcpy(cache->tag[page], tag, sizeof(tag));
+  }
   return kOwnerPageStatusSigned;
 }
 
@@ -159,7 +182,7 @@ static rom_error_t unlocked_init(boot_data_t *bootdata, owner_config_t *config,
   if (owner_block_page1_valid_for_transfer(bootdata) == kHardenedBoolTrue) {
     // If we passed the validity test for Owner Page 1, test parse the config.
     owner_config_t testcfg;
-    owner_application_keyring_t testring;
+    owner_application_keyring_t testring = {0};
     rom_error_t result = owner_block_parse(&owner_page[1], &testcfg, &testring);
     if (result == kErrorOk) {
       // Parse the configuration and add its keys to the keyring.
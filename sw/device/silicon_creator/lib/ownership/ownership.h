@@ -11,6 +11,10 @@
 #include "sw/device/silicon_creator/lib/ownership/datatypes.h"
 #include "sw/device/silicon_creator/lib/ownership/owner_block.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
 /**
  * Initialize the owner pages from flash
  */
@@ -37,4 +41,8 @@ rom_error_t ownership_flash_lockdown(boot_data_t *bootdata,
  */
 void ownership_pages_lockdown(boot_data_t *bootdata, hardened_bool_t rescue);
 
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
 #endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_OWNERSHIP_OWNERSHIP_H_
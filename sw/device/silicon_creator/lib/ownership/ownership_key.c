@@ -82,6 +82,24 @@ rom_error_t ownership_seal_check(size_t page) {
   return kErrorOwnershipInvalidInfoPage;
 }
 
+rom_error_t ownership_seal_check_tag(size_t page, uint32_t *tag) {
+  owner_block_t *data = &owner_page[page];
+  uint32_t check[ARRAYSIZE(data->seal)];
+  HARDENED_RETURN_IF_ERROR(seal_generate(data, check));
+  hardened_bool_t result =
+      hardened_memeq(data->seal, check, ARRAYSIZE(data->seal));
+  if (result == kHardenedBoolTrue) {
+    // kErrorOk; see `ownership_seal_check()`.
+    return (rom_error_t)result;
+  }
+  // The tag input is much shorter than the sealed part of a page, so a tag can
+  // never be mistaken for a seal.
+  HARDENED_RETURN_IF_ERROR(kmac_kmac256_start());
+  kmac_kmac256_absorb(check, sizeof(check));
+  HARDENED_RETURN_IF_ERROR(kmac_kmac256_final(tag, ARRAYSIZE(data->seal)));
+  return kErrorOwnershipInvalidInfoPage;
+}
+
 static void reverse(void *buf, size_t len) {
   char *x = (char *)buf;
   char *y = x + len - 1;
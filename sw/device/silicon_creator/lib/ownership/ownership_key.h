@@ -81,6 +81,23 @@ rom_error_t ownership_seal_page(size_t page);
  */
 rom_error_t ownership_seal_check(size_t page);
 
+/**
+ * Check the seal on an ownership page and, if the page is not sealed, compute
+ * its validation tag.
+ *
+ * The validation tag is a MAC, under the sealing key, of the seal the page
+ * would have if it were sealed.  It identifies the page contents without
+ * revealing that seal, so it may be stored where later boot stages can read
+ * it.
+ *
+ * @param page Owner page on which to check the seal.
+ * @param tag Validation tag of the page; only written if the page is not
+ *            sealed.
+ * @return kErrorOk if the page is sealed, kErrorOwnershipInvalidInfoPage if it
+ *         is not, or another error code.
+ */
+rom_error_t ownership_seal_check_tag(size_t page, uint32_t *tag);
+
 /**
  * Replace the owner secret with new entropy and update the ownership history.
  *
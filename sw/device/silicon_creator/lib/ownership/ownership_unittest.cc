@@ -0,0 +1,203 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/ownership/ownership.h"
+
+#include <array>
+#include <stdint.h>
+#include <string.h>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/global_mock.h"
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/silicon_creator/lib/boot_data.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_lifecycle.h"
+#include "sw/device/silicon_creator/lib/drivers/retention_sram.h"
+#include "sw/device/silicon_creator/lib/error.h"
+#include "sw/device/silicon_creator/lib/ownership/datatypes.h"
+#include "sw/device/silicon_creator/lib/ownership/mock_ownership_key.h"
+#include "sw/device/silicon_creator/lib/ownership/owner_block.h"
+#include "sw/device/silicon_creator/testing/rom_test.h"
+
+namespace ownership_unittest {
+// `ownership_init` logs the ownership state; discard the output.
+extern "C" void uart_putchar(uint8_t c) {}
+
+namespace {
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Return;
+using ::testing::SetArrayArgument;
+
+using tag_t = std::array<uint32_t, 8>;
+
+constexpr tag_t kTag0 = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17};
+constexpr tag_t kTag1 = {0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27};
+
+class OwnershipInitTest : public rom_test::RomTest {
+ protected:
+  void SetUp() override {
+    memset(owner_page, 0, sizeof(owner_page));
+    memset(cache_, 0, sizeof(*cache_));
+  }
+
+  /**
+   * Expects `ownership_init` to configure the owner info pages.
+   */
+  void ExpectConfigure() {
+    EXPECT_CALL(flash_ctrl_, InfoPermsSet(&kFlashCtrlInfoPageOwnerSlot0, _));
+    EXPECT_CALL(flash_ctrl_, InfoCfgSet(&kFlashCtrlInfoPageOwnerSlot0, _));
+    EXPECT_CALL(flash_ctrl_, InfoPermsSet(&kFlashCtrlInfoPageOwnerSlot1, _));
+    EXPECT_CALL(flash_ctrl_, InfoCfgSet(&kFlashCtrlInfoPageOwnerSlot1, _));
+    EXPECT_CALL(flash_ctrl_, InfoCfgSet(&kFlashCtrlInfoPageOwnerSecret, _));
+  }
+
+  /**
+   * Expects owner page `page` to be read and found not sealed, with
+   * validation tag `tag`.
+   */
+  void ExpectPage(size_t page, const tag_t &tag) {
+    EXPECT_CALL(flash_ctrl_, InfoRead(_, 0, _, &owner_page[page]))
+        .WillOnce(Return(kErrorOk));
+    EXPECT_CALL(lifecycle_, DeviceId(_));
+    EXPECT_CALL(ownership_key_, seal_check_tag(page, _))
+        .WillOnce(DoAll(SetArrayArgument<1>(tag.begin(), tag.end()),
+                        Return(kErrorOwnershipInvalidInfoPage)));
+  }
+
+  /**
+   * Like `ExpectPage()`, but also expects the signature on the page to be
+   * checked, with the given result.
+   */
+  void ExpectPageVerified(size_t page, const tag_t &tag,
+                          hardened_bool_t result) {
+    ExpectPage(page, tag);
+    EXPECT_CALL(ownership_key_, validate(page, kOwnershipKeyOwner, _, _, _))
+        .WillOnce(Return(result));
+  }
+
+  void Init() {
+    // Recovery skips the owner configuration, which this test does not model.
+    EXPECT_EQ(ownership_init(&bootdata_, &config_, &keyring_),
+              kErrorOwnershipNoOwner);
+  }
+
+  bool Cached(size_t page, const tag_t &tag) {
+    return memcmp(cache_->tag[page], tag.data(), sizeof(cache_->tag[page])) ==
+           0;
+  }
+
+  boot_data_t bootdata_ = {
+      .ownership_state = kOwnershipStateRecovery,
+  };
+  owner_config_t config_;
+  owner_application_keyring_t keyring_ = {0};
+  retention_sram_owner_page_cache_t *cache_ =
+      &retention_sram_get()->creator.owner_page_cache;
+
+  rom_test::MockFlashCtrl flash_ctrl_;
+  rom_test::MockLifecycle lifecycle_;
+  rom_test::MockOwnershipKey ownership_key_;
+};
+
+// Tests that a verified page is not verified again while its tag is cached.
+TEST_F(OwnershipInitTest, CacheHit) {
+  ExpectConfigure();
+  ExpectPageVerified(0, kTag0, kHardenedBoolTrue);
+  ExpectPageVerified(1, kTag1, kHardenedBoolTrue);
+  Init();
+  EXPECT_EQ(cache_->identifier, kRetentionSramOwnerPageCacheIdentifier);
+  EXPECT_TRUE(Cached(0, kTag0));
+  EXPECT_TRUE(Cached(1, kTag1));
+  EXPECT_EQ(owner_page_valid[0], kOwnerPageStatusSigned);
+  EXPECT_EQ(owner_page_valid[1], kOwnerPageStatusSigned);
+
+  // The next boot finds both tags in the cache: the StrictMock fails the test
+  // if a signature is checked again.
+  ExpectConfigure();
+  ExpectPage(0, kTag0);
+  ExpectPage(1, kTag1);
+  Init();
+  EXPECT_EQ(owner_page_valid[0], kOwnerPageStatusSigned);
+  EXPECT_EQ(owner_page_valid[1], kOwnerPageStatusSigned);
+}
+
+// Tests that a page with a different tag is verified again.
+TEST_F(OwnershipInitTest, CacheMissOnChangedPage) {
+  ExpectConfigure();
+  ExpectPageVerified(0, kTag0, kHardenedBoolTrue);
+  ExpectPageVerified(1, kTag1, kHardenedBoolTrue);
+  Init();
+
+  tag_t tag = kTag1;
+  tag[7] ^= 1;
+  ExpectConfigure();
+  ExpectPage(0, kTag0);
+  ExpectPageVerified(1, tag, kHardenedBoolTrue);
+  Init();
+  EXPECT_TRUE(Cached(0, kTag0));
+  EXPECT_TRUE(Cached(1, tag));
+}
+
+// Tests that a page failing verification invalidates its cache entry.
+TEST_F(OwnershipInitTest, CacheInvalidatedOnBadSignature) {
+  ExpectConfigure();
+  ExpectPageVerified(0, kTag0, kHardenedBoolTrue);
+  ExpectPageVerified(1, kTag1, kHardenedBoolTrue);
+  Init();
+
+  tag_t tag = kTag0;
+  tag[0] ^= 1;
+  ExpectConfigure();
+  ExpectPageVerified(0, tag, kHardenedBoolFalse);
+  ExpectPage(1, kTag1);
+  Init();
+  EXPECT_EQ(owner_page_valid[0], kOwnerPageStatusInvalid);
+  EXPECT_EQ(owner_page_valid[1], kOwnerPageStatusSigned);
+  EXPECT_TRUE(Cached(0, tag_t{}));
+  EXPECT_TRUE(Cached(1, kTag1));
+
+  // The original page is no longer cached and must be verified again.
+  ExpectConfigure();
+  ExpectPageVerified(0, kTag0, kHardenedBoolTrue);
+  ExpectPage(1, kTag1);
+  Init();
+  EXPECT_TRUE(Cached(0, kTag0));
+}
+
+// Tests that a cache without the identifier is reset and never hits.
+TEST_F(OwnershipInitTest, CacheResetOnBadIdentifier) {
+  memcpy(cache_->tag[0], kTag0.data(), sizeof(cache_->tag[0]));
+  memcpy(cache_->tag[1], kTag1.data(), sizeof(cache_->tag[1]));
+  cache_->identifier = kRetentionSramOwnerPageCacheIdentifier ^ 1;
+
+  ExpectConfigure();
+  ExpectPageVerified(0, kTag0, kHardenedBoolTrue);
+  ExpectPageVerified(1, kTag1, kHardenedBoolFalse);
+  Init();
+  EXPECT_EQ(cache_->identifier, kRetentionSramOwnerPageCacheIdentifier);
+  EXPECT_TRUE(Cached(0, kTag0));
+  EXPECT_TRUE(Cached(1, tag_t{}));
+}
+
+// Tests that a sealed page neither consults nor updates the cache.
+TEST_F(OwnershipInitTest, SealedPageBypassesCache) {
+  ExpectConfigure();
+  for (size_t page = 0; page < 2; ++page) {
+    EXPECT_CALL(flash_ctrl_, InfoRead(_, 0, _, &owner_page[page]))
+        .WillOnce(Return(kErrorOk));
+    EXPECT_CALL(lifecycle_, DeviceId(_));
+    EXPECT_CALL(ownership_key_, seal_check_tag(page, _))
+        .WillOnce(Return(kErrorOk));
+  }
+  Init();
+  EXPECT_EQ(owner_page_valid[0], kOwnerPageStatusSealed);
+  EXPECT_EQ(owner_page_valid[1], kOwnerPageStatusSealed);
+  EXPECT_EQ(cache_->identifier, 0);
+}
+
+}  // namespace
+}  // namespace ownership_unittest
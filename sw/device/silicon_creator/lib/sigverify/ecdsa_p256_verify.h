@@ -39,6 +39,39 @@ rom_error_t sigverify_ecdsa_p256_verify(const ecdsa_p256_signature_t *signature,
                                         const hmac_digest_t *act_digest,
                                         uint32_t *flash_exec);
 
+/**
+ * Starts an ECDSA-P256 signature verification on OTBN.
+ *
+ * Returns without waiting for OTBN, so that the caller can verify other
+ * signatures in the meantime. A successful call must be followed by
+ * `sigverify_ecdsa_p256_finish`. `sigverify_ecdsa_p256_verify` is equivalent
+ * to calling the two back to back.
+ *
+ * @param signature The signature to verify, little endian.
+ * @param key The public key to use for verification, little endian.
+ * @param act_digest The actual digest of the signed message.
+ * @param[out] flash_exec The partial value to write to the flash_ctrl EXEC
+ * register; invalidated if this function fails.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sigverify_ecdsa_p256_start(const ecdsa_p256_signature_t *signature,
+                                       const ecdsa_p256_public_key_t *key,
+                                       const hmac_digest_t *act_digest,
+                                       uint32_t *flash_exec);
+
+/**
+ * Completes a verification started by `sigverify_ecdsa_p256_start`.
+ *
+ * @param signature The signature passed to `sigverify_ecdsa_p256_start`.
+ * @param[out] flash_exec The partial value to write to the flash_ctrl EXEC
+ * register.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sigverify_ecdsa_p256_finish(const ecdsa_p256_signature_t *signature,
+                                        uint32_t *flash_exec);
+
 /**
  * Transforms `kSigverifyEcdsaSuccess` into `kErrorOk`.
  *
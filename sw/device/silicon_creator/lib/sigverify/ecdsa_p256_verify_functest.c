@@ -2,6 +2,7 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 #include "sw/device/lib/testing/test_framework/ottf_main.h"
 #include "sw/device/silicon_creator/lib/otbn_boot_services.h"
@@ -112,6 +113,20 @@ rom_error_t ecdsa_p256_verify_negative_test(void) {
   return kErrorOk;
 }
 
+rom_error_t ecdsa_p256_start_finish_test(void) {
+  uint32_t flash_exec = 0;
+  RETURN_IF_ERROR(sigverify_ecdsa_p256_start(&kEcdsaSignature, &kEcdsaKey,
+                                             &digest, &flash_exec));
+  // Use the HMAC block while OTBN is busy, as secure boot does for SPX+.
+  hmac_digest_t other_digest;
+  hmac_sha256(kTestMessage, kTestMessageLen, &other_digest);
+  rom_error_t result =
+      sigverify_ecdsa_p256_finish(&kEcdsaSignature, &flash_exec);
+  CHECK(flash_exec == kSigverifyEcdsaSuccess);
+  CHECK(memcmp(&other_digest, &digest, sizeof(digest)) == 0);
+  return result;
+}
+
 bool test_main(void) {
   CHECK(otbn_boot_app_load() == kErrorOk);
 
@@ -120,5 +135,6 @@ bool test_main(void) {
 
   EXECUTE_TEST(result, ecdsa_p256_verify_ok_test);
   EXECUTE_TEST(result, ecdsa_p256_verify_negative_test);
+  EXECUTE_TEST(result, ecdsa_p256_start_finish_test);
   return status_ok(result);
 }
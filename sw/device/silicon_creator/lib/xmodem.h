@@ -5,11 +5,22 @@
 #ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_XMODEM_H_
 #define OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_XMODEM_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sw/device/lib/base/hardened.h"
 #include "sw/device/silicon_creator/lib/error.h"
 
+/**
+ * Computes the CRC-16 used by Xmodem-CRC (polynomial 0x1021).
+ *
+ * @param crc The CRC of the preceding data, or zero to start a new CRC.
+ * @param buf Data to add to the CRC.
+ * @param len Length of `buf` in bytes.
+ * @return The updated CRC.
+ */
+uint16_t xmodem_crc16(uint16_t crc, const void *buf, size_t len);
+
 /**
  * Send the Xmodem-CRC start sequence.
  *
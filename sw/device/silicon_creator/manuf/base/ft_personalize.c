@@ -29,6 +29,7 @@
 #include "sw/device/silicon_creator/lib/cert/cdi_1.h"  // Generated.
 #include "sw/device/silicon_creator/lib/cert/cert.h"
 #include "sw/device/silicon_creator/lib/cert/dice.h"
+#include "sw/device/silicon_creator/lib/cert/dice_cert_cache.h"
 #include "sw/device/silicon_creator/lib/cert/uds.h"  // Generated.
 #include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
 #include "sw/device/silicon_creator/lib/drivers/hmac.h"
@@ -358,6 +359,19 @@ static void compute_keymgr_owner_binding(manuf_certgen_inputs_t *inputs) {
   sealing_binding_value.data[0] = kOwnerAppDomainProd;
 }
 
+/**
+ * Number of bytes of `page` that can hold certificates.
+ *
+ * The end of the DICE certificate page holds the certificate cache index
+ * maintained by the ROM_EXT, which must not be overwritten.
+ */
+static size_t cert_page_capacity(const flash_ctrl_info_page_t *page) {
+  if (page == &kFlashCtrlInfoPageDiceCerts) {
+    return kDiceCertsRegionSizeBytes;
+  }
+  return FLASH_CTRL_PARAM_BYTES_PER_PAGE;
+}
+
 /**
  * Read a certificate from the passed in location in a flash INFO page and hash
  * its contents on the existing sha256 hashing stream. Determine the actual
@@ -389,7 +403,7 @@ static status_t hash_certificate(const flash_ctrl_info_page_t *page,
               obj_size, page->base_addr, offset);
     return DATA_LOSS();
   }
-  if ((obj_size + offset) > FLASH_CTRL_PARAM_BYTES_PER_PAGE) {
+  if ((obj_size + offset) > cert_page_capacity(page)) {
     LOG_ERROR("Cert size overflow (%d + %d) page %x:%x", obj_size, offset,
               page->base_addr, offset);
     return DATA_LOSS();
@@ -671,7 +685,8 @@ static status_t write_cert_to_flash_info_page(
     const cert_flash_info_layout_t *layout, perso_tlv_cert_obj_t *block,
     uint8_t *cert_data, uint32_t page_offset, uint32_t cert_write_size_bytes,
     uint32_t cert_write_size_words) {
-  if ((page_offset + cert_write_size_bytes) > FLASH_CTRL_PARAM_BYTES_PER_PAGE) {
+  if ((page_offset + cert_write_size_bytes) >
+      cert_page_capacity(layout->info_page)) {
     LOG_ERROR("%s %s certificate did not fit into the info page.",
               layout->group_name, block->name);
     return OUT_OF_RANGE();
@@ -101,6 +101,16 @@ uint32_t flash_ecc_exc_handler_en;
 // A check value for the reset reason.
 uint32_t reset_reason_check;
 
+/**
+ * Records a boot milestone in the boot profile.
+ */
+static void rom_profile_mark(boot_log_milestone_t milestone) {
+#ifdef OT_BOOT_PROFILE
+  boot_log_profile_mark(&retention_sram_get()->creator.boot_profile,
+                        milestone);
+#endif
+}
+
 static inline bool rom_console_enabled(void) {
   return otp_read32(OTP_CTRL_PARAM_OWNER_SW_CFG_ROM_BANNER_EN_OFFSET) !=
          kHardenedBoolFalse;
@@ -249,6 +259,8 @@ static rom_error_t rom_init(void) {
   boot_log->chip_version = kChipInfo.scm_revision;
   boot_log->retention_ram_initialized =
       reset_reasons & reset_mask ? kHardenedBoolTrue : kHardenedBoolFalse;
+  boot_log_profile_rotate(&retention_sram_get()->creator.boot_profile,
+                          &retention_sram_get()->creator.boot_profile_prev);
 
   // Always store the retention RAM version so the ROM_EXT can depend on its
   // accuracy even after scrambling.
@@ -293,6 +305,7 @@ static rom_error_t rom_init(void) {
   sec_mmio_check_values(rnd_uint32());
   sec_mmio_check_counters(/*expected_check_count=*/1);
 
+  rom_profile_mark(kBootLogMilestoneRomInit);
   CFI_FUNC_COUNTER_INCREMENT(rom_counters, kCfiRomInit, 2);
   return kErrorOk;
 }
@@ -358,6 +371,7 @@ static rom_error_t rom_verify(const manifest_t *manifest,
   } else {
     HARDENED_CHECK_EQ(sigverify_spx_en, kSigverifySpxDisabledOtp);
   }
+  rom_profile_mark(kBootLogMilestoneRomKeyLoad);
 
   // Measure ROM_EXT and portions of manifest via SHA256 digest.
   // Initialize ROM_EXT measurement in .static_critical with garbage.
@@ -386,33 +400,34 @@ static rom_error_t rom_verify(const manifest_t *manifest,
                 "Unexpected ROM_EXT digest size.");
   memcpy(&boot_measurements.rom_ext, &act_digest,
          sizeof(boot_measurements.rom_ext));
+  rom_profile_mark(kBootLogMilestoneRomMeasure);
 
   CFI_FUNC_COUNTER_INCREMENT(rom_counters, kCfiRomVerify, 2);
 
   /**
    * Verify the ECDSA/SPX+ signatures of ROM_EXT.
    *
-   * We swap the order of signature verifications randomly.
+   * ECDSA runs on OTBN, so we start it first and verify the SPX+ signature on
+   * Ibex and HMAC while OTBN computes. OTBN is always waited on, even if SPX+
+   * verification fails, and we check the two results in a random order.
    */
   *flash_exec = 0;
+  HARDENED_RETURN_IF_ERROR(sigverify_ecdsa_p256_start(
+      &manifest->ecdsa_signature, ecdsa_key, &act_digest, flash_exec));
+  rom_error_t spx_error = sigverify_spx_verify(
+      spx_signature, spx_key, spx_config, lc_state, &usage_constraints_from_hw,
+      sizeof(usage_constraints_from_hw), anti_rollback, anti_rollback_len,
+      digest_region.start, digest_region.length, &act_digest, flash_exec);
+  rom_profile_mark(kBootLogMilestoneRomSpxVerify);
+  rom_error_t ecdsa_error =
+      sigverify_ecdsa_p256_finish(&manifest->ecdsa_signature, flash_exec);
+  rom_profile_mark(kBootLogMilestoneRomEcdsaVerify);
   if (rnd_uint32() < 0x80000000) {
-    HARDENED_RETURN_IF_ERROR(sigverify_ecdsa_p256_verify(
-        &manifest->ecdsa_signature, ecdsa_key, &act_digest, flash_exec));
-
-    return sigverify_spx_verify(
-        spx_signature, spx_key, spx_config, lc_state,
-        &usage_constraints_from_hw, sizeof(usage_constraints_from_hw),
-        anti_rollback, anti_rollback_len, digest_region.start,
-        digest_region.length, &act_digest, flash_exec);
+    HARDENED_RETURN_IF_ERROR(ecdsa_error);
+    return spx_error;
   } else {
-    HARDENED_RETURN_IF_ERROR(sigverify_spx_verify(
-        spx_signature, spx_key, spx_config, lc_state,
-        &usage_constraints_from_hw, sizeof(usage_constraints_from_hw),
-        anti_rollback, anti_rollback_len, digest_region.start,
-        digest_region.length, &act_digest, flash_exec));
-
-    return sigverify_ecdsa_p256_verify(&manifest->ecdsa_signature, ecdsa_key,
-                                       &act_digest, flash_exec);
+    HARDENED_RETURN_IF_ERROR(spx_error);
+    return ecdsa_error;
   }
 }
 
@@ -716,6 +731,7 @@ static rom_error_t rom_boot(const manifest_t *manifest, uint32_t flash_exec) {
   }
 
   // Jump to ROM_EXT.
+  rom_profile_mark(kBootLogMilestoneRomJump);
   ((rom_ext_entry_point *)entry_point)();
   return kErrorRomBootFailed;
 }
@@ -9,6 +9,8 @@
 #include "sw/device/silicon_creator/lib/boot_data.h"
 #include "sw/device/silicon_creator/lib/dbg_print.h"
 #include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
+#include "sw/device/silicon_creator/lib/drivers/ibex.h"
 #include "sw/device/silicon_creator/lib/drivers/lifecycle.h"
 #include "sw/device/silicon_creator/lib/drivers/retention_sram.h"
 #include "sw/device/silicon_creator/lib/drivers/rstmgr.h"
@@ -151,6 +153,10 @@ static void validate_mode(uint32_t mode, rescue_state_t *state,
       dbg_printf("ok: wait after upload\r\n");
       state->reboot = false;
       goto exitproc;
+    case kRescueModeWindowed:
+      dbg_printf("ok: windowed transfer for firmware\r\n");
+      state->windowed = true;
+      goto exitproc;
 #ifdef ROM_EXT_KLOBBER_ALLOWED
     case kRescueModeKlobber:
       ownership_erase();
@@ -220,10 +226,28 @@ static rom_error_t handle_send_modes(rescue_state_t *state,
 
   const retention_sram_t *rr = retention_sram_get();
   switch (state->mode) {
-    case kRescueModeBootLog:
-      HARDENED_RETURN_IF_ERROR(xmodem_send(iohandle, &rr->creator.boot_log,
-                                           sizeof(rr->creator.boot_log)));
+    case kRescueModeBootLog: {
+      // The boot profiles of this and of the previous boot follow the boot log
+      // so that older hosts, which only parse the boot log, keep working.
+      // Entering rescue mode usually takes a reset, so the previous profile is
+      // normally the one of interest.
+      static_assert(sizeof(rr->creator.boot_log) +
+                            sizeof(rr->creator.boot_profile) +
+                            sizeof(rr->creator.boot_profile_prev) <=
+                        sizeof(state->data),
+                    "Boot log and profiles must fit in the rescue buffer");
+      uint8_t *data = state->data;
+      memcpy(data, &rr->creator.boot_log, sizeof(rr->creator.boot_log));
+      data += sizeof(rr->creator.boot_log);
+      memcpy(data, &rr->creator.boot_profile, sizeof(rr->creator.boot_profile));
+      data += sizeof(rr->creator.boot_profile);
+      memcpy(data, &rr->creator.boot_profile_prev,
+             sizeof(rr->creator.boot_profile_prev));
+      data += sizeof(rr->creator.boot_profile_prev);
+      HARDENED_RETURN_IF_ERROR(
+          xmodem_send(iohandle, state->data, (size_t)(data - state->data)));
       break;
+    }
     case kRescueModeBootSvcRsp:
       HARDENED_RETURN_IF_ERROR(xmodem_send(iohandle, &rr->creator.boot_svc_msg,
                                            sizeof(rr->creator.boot_svc_msg)));
@@ -314,6 +338,476 @@ static rom_error_t handle_recv_modes(rescue_state_t *state,
   return kErrorOk;
 }
 
+/**
+ * Constants used by the windowed firmware transfer.
+ *
+ * See the "Windowed firmware transfer" section of `doc/rescue.md` for a
+ * description of the protocol.
+ */
+enum {
+  kWindowStart = 'W',
+  kWindowPlan = 0x01,
+  kWindowData = 0x02,
+  kWindowEof = 0x04,
+  kWindowStatus = 0x16,
+  kWindowCancel = 0x18,
+  kWindowDigestSize = 8,
+  // Number of page buffers, and therefore of frames the host may send ahead.
+  kWindowBuffers = 2,
+  // Silence, in milliseconds, after which the device reports its status.
+  kWindowTimeout = 1000,
+  // Consecutive silent periods after which the device gives up.
+  kWindowMaxIdle = 10,
+};
+
+static_assert(kRescueWindowMaxPages * kRescueBlockSize >=
+                  FLASH_CTRL_PARAM_BYTES_PER_BANK,
+              "The window plan must cover a flash bank");
+static_assert(kRescueWindowMaxPages * kWindowDigestSize <= kRescueBlockSize,
+              "The page digests must fit in the rescue buffer");
+
+typedef enum window_op {
+  kWindowOpNone,
+  kWindowOpErase,
+  kWindowOpProgram,
+} window_op_t;
+
+typedef struct window {
+  // Flash address of the first image page.
+  uint32_t base;
+  // Number of pages in the image.
+  uint32_t pages;
+  // Next page the device expects from the host, or `pages` when done.
+  uint32_t next;
+  // Value of `next` for which a negative status was last sent.
+  uint32_t nak_next;
+  // Page buffers, in reception order starting at `head`.
+  uint8_t *buf[kWindowBuffers];
+  uint32_t buf_page[kWindowBuffers];
+  uint32_t head;
+  uint32_t full;
+  // Flash operation in flight.
+  window_op_t op;
+  // Next page to erase ahead of programming.
+  uint32_t erase_page;
+  // Number of erased pages waiting to be programmed.
+  uint32_t erased;
+  // Words of the oldest buffer already programmed, or being programmed.
+  uint32_t prog_word;
+  uint32_t prog_count;
+  // Receive parser state for the frame in progress.
+  uint32_t rx_count;
+  uint8_t rx_hdr[2];
+  uint8_t *rx_buf;
+  uint16_t rx_crc;
+  uint16_t rx_frame_crc;
+  // Whether the last frame was good. While it is not, the parser may be
+  // scanning page data for the start of the next frame, so cancel characters
+  // are ignored.
+  bool synced;
+  // Consecutive cancel characters received between frames.
+  uint32_t cancels;
+} window_t;
+
+static bool window_planned(const rescue_state_t *state, uint32_t page) {
+  return (state->window_plan[page / 32] >> (page % 32)) & 1;
+}
+
+/**
+ * Returns the first page at or after `page` that the plan says to write.
+ */
+static uint32_t window_plan_next(const rescue_state_t *state,
+                                 const window_t *w, uint32_t page) {
+  while (page < w->pages && !window_planned(state, page)) {
+    ++page;
+  }
+  return page;
+}
+
+static void window_put(const void *data, size_t len) {
+  uart_write(data, len);
+}
+
+static void window_put_crc(uint16_t crc) {
+  uint8_t bytes[2] = {(uint8_t)(crc >> 8), (uint8_t)crc};
+  window_put(bytes, sizeof(bytes));
+}
+
+/**
+ * Reports the next page the device expects and how many pages the host may
+ * send from there.
+ */
+static void window_status(window_t *w, bool ack) {
+  uint8_t status[] = {
+      kWindowStatus,
+      ack ? 0 : 1,
+      (uint8_t)w->next,
+      (uint8_t)(w->next >> 8),
+      (uint8_t)(kWindowBuffers - w->full),
+  };
+  window_put(status, sizeof(status));
+}
+
+/**
+ * Sends a negative status, at most once for each value of `next`.
+ */
+static void window_nak(window_t *w) {
+  if (w->nak_next != w->next) {
+    w->nak_next = w->next;
+    window_status(w, false);
+  }
+}
+
+/**
+ * Receives the transfer plan and replies with the pages that differ from the
+ * current flash contents.
+ */
+static rom_error_t window_plan(rescue_state_t *state, window_t *w) {
+  uint8_t len_bytes[4];
+  if (uart_read(len_bytes, sizeof(len_bytes), kWindowTimeout) !=
+      sizeof(len_bytes)) {
+    return kErrorXModemTimeoutPacket;
+  }
+  uint16_t crc = xmodem_crc16(0, len_bytes, sizeof(len_bytes));
+  uint32_t len = read_32(len_bytes);
+  // Checked again below; bounds the reads before the CRC is known.
+  if (len > kRescueWindowMaxPages * kRescueBlockSize) {
+    xmodem_cancel(iohandle);
+    return kErrorRescueImageTooBig;
+  }
+  w->pages = (len + kRescueBlockSize - 1) / kRescueBlockSize;
+  size_t digests_len = w->pages * kWindowDigestSize;
+  uint8_t crc_bytes[2];
+  if (uart_read(state->data, digests_len, kWindowTimeout) != digests_len ||
+      uart_read(crc_bytes, sizeof(crc_bytes), kWindowTimeout) !=
+          sizeof(crc_bytes)) {
+    return kErrorXModemTimeoutData;
+  }
+  crc = xmodem_crc16(crc, state->data, digests_len);
+  if (crc != (uint16_t)(crc_bytes[0] << 8 | crc_bytes[1])) {
+    return kErrorXModemCrc;
+  }
+  if (len == 0 || len > state->flash_limit - state->flash_start) {
+    xmodem_cancel(iohandle);
+    return kErrorRescueImageTooBig;
+  }
+
+  flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
+      .read = kMultiBitBool4True,
+      .write = kMultiBitBool4True,
+      .erase = kMultiBitBool4True,
+  });
+  w->base = (state->mode == kRescueModeFirmwareSlotB ? kFlashBankSize : 0) +
+            state->flash_start;
+  memset(state->window_plan, 0, sizeof(state->window_plan));
+  hmac_sha256_configure(/*big_endian_digest=*/true);
+  for (uint32_t page = 0; page < w->pages; ++page) {
+    // A page that cannot be read, e.g. because of an ECC error, is resent
+    // rather than aborting the transfer that would rewrite it.
+    if (flash_ctrl_data_read(w->base + page * kRescueBlockSize,
+                             sizeof(state->window_data) / sizeof(uint32_t),
+                             state->window_data) != kErrorOk) {
+      state->window_plan[page / 32] |= 1u << (page % 32);
+      continue;
+    }
+    hmac_sha256_start();
+    hmac_sha256_update_words((const uint32_t *)state->window_data,
+                             sizeof(state->window_data) / sizeof(uint32_t));
+    hmac_sha256_process();
+    uint32_t digest[kWindowDigestSize / sizeof(uint32_t)];
+    hmac_sha256_final_truncated(digest, ARRAYSIZE(digest));
+    if (memcmp(digest, &state->data[page * kWindowDigestSize],
+               kWindowDigestSize) != 0) {
+      state->window_plan[page / 32] |= 1u << (page % 32);
+    }
+  }
+
+  uint8_t header[] = {kWindowPlan, (uint8_t)w->pages,
+                      (uint8_t)(w->pages >> 8)};
+  size_t plan_len = (w->pages + 7) / 8;
+  window_put(header, sizeof(header));
+  window_put(state->window_plan, plan_len);
+  crc = xmodem_crc16(0, &header[1], sizeof(header) - 1);
+  window_put_crc(xmodem_crc16(crc, state->window_plan, plan_len));
+  return kErrorOk;
+}
+
+/**
+ * Advances the flash pipeline by at most one operation without blocking.
+ *
+ * Programs the oldest received page once it has been erased, and otherwise
+ * erases the next planned pages ahead of their data arriving.
+ *
+ * @param[out] freed Set when a page buffer becomes free.
+ */
+static rom_error_t window_flash(window_t *w, const rescue_state_t *state,
+                                bool *freed) {
+  if (w->op != kWindowOpNone) {
+    hardened_bool_t done;
+    HARDENED_RETURN_IF_ERROR(flash_ctrl_poll(&done));
+    if (done != kHardenedBoolTrue) {
+      return kErrorOk;
+    }
+    if (w->op == kWindowOpErase) {
+      ++w->erased;
+    } else {
+      w->prog_word += w->prog_count;
+      if (w->prog_word == kRescueBlockSize / sizeof(uint32_t)) {
+        w->prog_word = 0;
+        w->head = (w->head + 1) % kWindowBuffers;
+        --w->full;
+        --w->erased;
+        *freed = true;
+      }
+    }
+    w->op = kWindowOpNone;
+  }
+
+  // Pages are received, erased and programmed in the same order, so the
+  // oldest buffer always holds the oldest erased page.
+  if (w->full > 0 && w->erased > 0) {
+    uint32_t page = w->buf_page[w->head];
+    w->prog_count = flash_ctrl_data_write_start(
+        w->base + page * kRescueBlockSize + w->prog_word * sizeof(uint32_t),
+        kRescueBlockSize / sizeof(uint32_t) - w->prog_word,
+        w->buf[w->head] + w->prog_word * sizeof(uint32_t));
+    w->op = kWindowOpProgram;
+  } else if (w->erase_page < w->pages && w->erased < kWindowBuffers) {
+    flash_ctrl_data_erase_start(w->base + w->erase_page * kRescueBlockSize,
+                                kFlashCtrlEraseTypePage);
+    w->erase_page = window_plan_next(state, w, w->erase_page + 1);
+    w->op = kWindowOpErase;
+  }
+  return kErrorOk;
+}
+
+/**
+ * Handles a complete data frame.
+ */
+static void window_frame_done(window_t *w, const rescue_state_t *state) {
+  uint32_t page = (uint32_t)w->rx_hdr[0] | (uint32_t)w->rx_hdr[1] << 8;
+  if (w->rx_crc != w->rx_frame_crc) {
+    w->synced = false;
+    if (page == w->next) {
+      // Most likely the retransmission asked for by the last negative status,
+      // so the host needs to hear about this one too.
+      w->nak_next = UINT32_MAX;
+    }
+    window_nak(w);
+    return;
+  }
+  w->synced = true;
+  if (page < w->next) {
+    // A retransmission of a page we already have.
+    return;
+  }
+  if (w->rx_buf == NULL || page != w->next) {
+    window_nak(w);
+    return;
+  }
+  w->buf_page[(w->head + w->full) % kWindowBuffers] = page;
+  ++w->full;
+  w->next = window_plan_next(state, w, page + 1);
+  window_status(w, true);
+}
+
+/**
+ * Feeds received bytes to the frame parser.
+ *
+ * @return `kErrorXModemEndOfFile` when the host has sent every page and ended
+ * the transfer, `kErrorXModemCancel` if it cancelled, `kErrorOk` otherwise.
+ */
+static rom_error_t window_rx(window_t *w, const rescue_state_t *state,
+                             const uint8_t *bytes, size_t len) {
+  while (len > 0) {
+    if (w->rx_count == 0) {
+      uint8_t ch = *bytes++;
+      --len;
+      if (ch != kWindowCancel) {
+        w->cancels = 0;
+      }
+      switch (ch) {
+        case kWindowData:
+          w->rx_count = 1;
+          w->rx_crc = 0;
+          break;
+        case kWindowEof:
+          if (w->next == w->pages) {
+            return kErrorXModemEndOfFile;
+          }
+          window_nak(w);
+          break;
+        case kWindowCancel:
+          if (w->synced && ++w->cancels >= 2) {
+            return kErrorXModemCancel;
+          }
+          break;
+        default:
+          // Unknown character: do nothing.
+          break;
+      }
+      continue;
+    }
+
+    // Byte offsets within the frame, counting the start byte.
+    enum {
+      kDataStart = 3,
+      kCrcStart = kDataStart + kRescueBlockSize,
+      kFrameEnd = kCrcStart + 2,
+    };
+    if (w->rx_count < kDataStart) {
+      w->rx_hdr[w->rx_count - 1] = *bytes;
+      w->rx_crc = xmodem_crc16(w->rx_crc, bytes, 1);
+      ++bytes;
+      --len;
+      if (++w->rx_count == kDataStart) {
+        if (((uint32_t)w->rx_hdr[0] | (uint32_t)w->rx_hdr[1] << 8) >=
+            w->pages) {
+          // Not a frame start after all: resume scanning.
+          w->rx_count = 0;
+          w->synced = false;
+          continue;
+        }
+        // Only keep the page if there is room for it. Otherwise the frame is
+        // still parsed so that the stream stays in sync.
+        w->rx_buf = w->full < kWindowBuffers
+                        ? w->buf[(w->head + w->full) % kWindowBuffers]
+                        : NULL;
+      }
+    } else if (w->rx_count < kCrcStart) {
+      size_t offset = w->rx_count - kDataStart;
+      size_t n = kRescueBlockSize - offset;
+      if (n > len) {
+        n = len;
+      }
+      if (w->rx_buf != NULL) {
+        memcpy(&w->rx_buf[offset], bytes, n);
+      }
+      w->rx_crc = xmodem_crc16(w->rx_crc, bytes, n);
+      w->rx_count += n;
+      bytes += n;
+      len -= n;
+    } else {
+      if (w->rx_count == kCrcStart) {
+        w->rx_frame_crc = (uint16_t)(*bytes << 8);
+      } else {
+        w->rx_frame_crc |= *bytes;
+      }
+      ++bytes;
+      --len;
+      if (++w->rx_count == kFrameEnd) {
+        w->rx_count = 0;
+        window_frame_done(w, state);
+      }
+    }
+  }
+  return kErrorOk;
+}
+
+/**
+ * Erases the pages of the rescue region after the end of the image, so that
+ * the region holds nothing but the new image.
+ */
+static rom_error_t window_erase_tail(const rescue_state_t *state,
+                                     const window_t *w) {
+  uint32_t limit = w->base - state->flash_start + state->flash_limit;
+  for (uint32_t addr = w->base + w->pages * kRescueBlockSize; addr < limit;
+       addr += kRescueBlockSize) {
+    if (flash_ctrl_data_erase_verify(addr, kFlashCtrlEraseTypePage) !=
+        kErrorOk) {
+      HARDENED_RETURN_IF_ERROR(
+          flash_ctrl_data_erase(addr, kFlashCtrlEraseTypePage));
+    }
+  }
+  return kErrorOk;
+}
+
+/**
+ * Receives a firmware image with the windowed transfer protocol.
+ *
+ * Pages that already hold the right contents are not transferred, and the
+ * flash pages for the remaining ones are erased and programmed while the next
+ * page is being received.
+ *
+ * The return values mirror `xmodem_recv_frame()`: `kErrorXModemEndOfFile`
+ * once the image has been written, `kErrorXModemTimeoutStart` if the host did
+ * not start a transfer and `kErrorXModemUnknown` for any other character
+ * received instead of a transfer plan.
+ */
+static rom_error_t window_recv_firmware(rescue_state_t *state,
+                                        uint8_t *unknown_rx) {
+  uint8_t ch;
+  if (uart_read(&ch, sizeof(ch), kWindowTimeout) != sizeof(ch)) {
+    uart_putchar(kWindowStart);
+    return kErrorXModemTimeoutStart;
+  }
+  if (ch != kWindowPlan) {
+    *unknown_rx = ch;
+    return kErrorXModemUnknown;
+  }
+  hardened_bool_t allow =
+      owner_rescue_command_allowed(state->config, state->mode);
+  if (allow != kHardenedBoolTrue) {
+    xmodem_cancel(iohandle);
+    return kErrorRescueBadMode;
+  }
+  window_t w = {
+      .buf = {state->data, state->window_data},
+      .nak_next = UINT32_MAX,
+      .synced = true,
+  };
+  HARDENED_RETURN_IF_ERROR(window_plan(state, &w));
+  w.next = window_plan_next(state, &w, 0);
+  w.erase_page = w.next;
+
+  uint64_t timeout = ibex_time_to_cycles(kWindowTimeout * 1000);
+  uint64_t deadline = ibex_mcycle() + timeout;
+  uint32_t idle = 0;
+  while (true) {
+    bool freed = false;
+    HARDENED_RETURN_IF_ERROR(window_flash(&w, state, &freed));
+    if (freed) {
+      window_status(&w, true);
+    }
+
+    uint8_t rx[64];
+    size_t n = uart_read(rx, sizeof(rx), 0);
+    if (n > 0) {
+      rom_error_t result = window_rx(&w, state, rx, n);
+      if (result == kErrorXModemEndOfFile) {
+        break;
+      }
+      HARDENED_RETURN_IF_ERROR(result);
+      deadline = ibex_mcycle() + timeout;
+      idle = 0;
+    } else if (ibex_mcycle() > deadline) {
+      if (++idle >= kWindowMaxIdle) {
+        xmodem_cancel(iohandle);
+        return kErrorXModemTimeoutData;
+      }
+      if (w.rx_count != 0) {
+        // Bytes of the last frame were lost; drop it and ask for it again.
+        // After a silence the next byte starts a frame again.
+        w.rx_count = 0;
+        w.synced = true;
+        w.nak_next = UINT32_MAX;
+        window_nak(&w);
+      } else {
+        window_status(&w, true);
+      }
+      deadline = ibex_mcycle() + timeout;
+    }
+  }
+
+  // Drain the pipeline: all pages are received but not necessarily written.
+  while (w.full > 0 || w.op != kWindowOpNone) {
+    bool freed = false;
+    HARDENED_RETURN_IF_ERROR(window_flash(&w, state, &freed));
+  }
+  HARDENED_RETURN_IF_ERROR(window_erase_tail(state, &w));
+  return kErrorXModemEndOfFile;
+}
+
 static rom_error_t protocol(rescue_state_t *state, boot_data_t *bootdata) {
   rom_error_t result;
   size_t rxlen;
@@ -321,15 +815,25 @@ static rom_error_t protocol(rescue_state_t *state, boot_data_t *bootdata) {
   uint32_t next_mode = 0;
 
   state->reboot = true;
+  state->windowed = false;
   validate_mode(kRescueModeFirmware, &rescue_state, bootdata);
 
   xmodem_recv_start(iohandle);
   while (true) {
     HARDENED_RETURN_IF_ERROR(handle_send_modes(&rescue_state, bootdata));
-    result = xmodem_recv_frame(iohandle, state->frame,
-                               state->data + state->offset, &rxlen, &command);
+    bool windowed = state->windowed &&
+                    (state->mode == kRescueModeFirmware ||
+                     state->mode == kRescueModeFirmwareSlotB);
+    if (windowed) {
+      result = window_recv_firmware(state, &command);
+    } else {
+      result = xmodem_recv_frame(iohandle, state->frame,
+                                 state->data + state->offset, &rxlen, &command);
+    }
     if (state->frame == 1 && result == kErrorXModemTimeoutStart) {
-      xmodem_recv_start(iohandle);
+      if (!windowed) {
+        xmodem_recv_start(iohandle);
+      }
       continue;
     }
     switch (result) {
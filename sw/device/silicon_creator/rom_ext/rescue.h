@@ -46,6 +46,8 @@ typedef enum {
   kRescueModeReboot = 0x5245424f,
   /** `WAIT` */
   kRescueModeWait = 0x57414954,
+  /** `WNDW` */
+  kRescueModeWindowed = 0x574e4457,
 } rescue_mode_t;
 
 typedef enum {
@@ -63,10 +65,19 @@ typedef enum {
   kRescueBaud1M50 = 0x30354d31,
 } rescue_baud_t;
 
+enum {
+  // Size of the data blocks handled by the rescue protocol: one flash page.
+  kRescueBlockSize = 2048,
+  // Maximum number of image pages in a windowed transfer: one flash bank.
+  kRescueWindowMaxPages = 256,
+};
+
 typedef struct RescueState {
   rescue_mode_t mode;
   // Whether to reboot automatically after an xmodem upload.
   bool reboot;
+  // Whether to receive firmware with the windowed transfer protocol.
+  bool windowed;
   // Current xmodem frame.
   uint32_t frame;
   // Current data offset.
@@ -79,7 +90,12 @@ typedef struct RescueState {
   // Rescue configuration.
   const owner_rescue_config_t *config;
   // Data buffer to hold xmodem upload data.
-  uint8_t data[2048];
+  uint8_t data[kRescueBlockSize];
+  // Second page buffer, used by windowed transfers to receive one page while
+  // programming another.
+  uint8_t window_data[kRescueBlockSize];
+  // Bitmap of the image pages a windowed transfer must write.
+  uint32_t window_plan[kRescueWindowMaxPages / 32];
 } rescue_state_t;
 
 rom_error_t rescue_protocol(boot_data_t *bootdata,
@@ -139,6 +139,38 @@ void rom_ext_check_rom_expectations(void) {
   sec_mmio_check_values(rnd_uint32());
 }
 
+/**
+ * Records a boot milestone in the boot profile.
+ */
+static void rom_ext_profile_mark(boot_log_milestone_t milestone) {
+#ifdef OT_BOOT_PROFILE
+  boot_log_profile_mark(&retention_sram_get()->creator.boot_profile,
+                        milestone);
+#endif
+}
+
+/**
+ * Prints the boot profile of this boot to the console.
+ *
+ * Called after the last milestone so that the UART does not skew the
+ * timings. The host can also read the profile, and that of the previous
+ * boot, over the rescue protocol.
+ */
+static void rom_ext_profile_print(void) {
+#ifdef OT_BOOT_PROFILE
+  const boot_log_profile_t *profile =
+      &retention_sram_get()->creator.boot_profile;
+  uint32_t count = profile->count;
+  uint32_t i = count > kBootLogProfileEntries ? count - kBootLogProfileEntries
+                                              : 0;
+  for (; i < count; ++i) {
+    const boot_log_profile_entry_t *entry =
+        &profile->entries[i % kBootLogProfileEntries];
+    dbg_printf("profile: %C %u\r\n", entry->milestone, entry->mcycle);
+  }
+#endif
+}
+
 OT_WARN_UNUSED_RESULT
 static rom_error_t rom_ext_init(boot_data_t *boot_data) {
   sec_mmio_next_stage_init();
@@ -161,6 +193,7 @@ static rom_error_t rom_ext_init(boot_data_t *boot_data) {
   // Get the boot_data record
   HARDENED_RETURN_IF_ERROR(boot_data_read(lc_state, boot_data));
 
+  rom_ext_profile_mark(kBootLogMilestoneRomExtInit);
   return kErrorOk;
 }
 
@@ -305,6 +338,7 @@ static rom_error_t rom_ext_verify(const manifest_t *manifest,
   }
 
   RETURN_IF_ERROR(owner_keyring_find_key(&keyring, key_id, &verify_key));
+  rom_ext_profile_mark(kBootLogMilestoneRomExtKeyLoad);
   uint32_t key_alg = keyring.key[verify_key]->key_alg;
 
   dbg_printf("verify: key=%u;%C;%C\r\n", verify_key, key_alg,
@@ -333,6 +367,7 @@ static rom_error_t rom_ext_verify(const manifest_t *manifest,
   static_assert(sizeof(boot_measurements.bl0) == sizeof(act_digest),
                 "Unexpected BL0 digest size.");
   memcpy(&boot_measurements.bl0, &act_digest, sizeof(boot_measurements.bl0));
+  rom_ext_profile_mark(kBootLogMilestoneRomExtMeasure);
 
   uint32_t flash_exec = 0;
   if (key_alg == kOwnershipKeyAlgEcdsaP256) {
@@ -341,17 +376,21 @@ static rom_error_t rom_ext_verify(const manifest_t *manifest,
                                        &act_digest, &flash_exec);
   } else if ((key_alg & kOwnershipKeyAlgCategoryMask) ==
              kOwnershipKeyAlgCategoryHybrid) {
-    // Hybrid signatures check both ECDSA and SPX+ signatures.
-    // TODO: as a future optimization, start the ECDSA verify operation on
-    // OTBN and compute the SPX+ verify in parallel on Ibex.
-    HARDENED_RETURN_IF_ERROR(sigverify_ecdsa_p256_verify(
+    // Hybrid signatures check both ECDSA and SPX+ signatures. Start the ECDSA
+    // verify operation on OTBN and compute the SPX+ verify on Ibex while OTBN
+    // is busy. OTBN is always waited on, even if SPX+ verification fails.
+    HARDENED_RETURN_IF_ERROR(sigverify_ecdsa_p256_start(
         &manifest->ecdsa_signature, &keyring.key[verify_key]->data.hybrid.ecdsa,
         &act_digest, &flash_exec));
-    return rom_ext_spx_verify(
+    rom_error_t spx_error = rom_ext_spx_verify(
         &ext_spx_signature->signature,
         &keyring.key[verify_key]->data.hybrid.spx, key_alg,
         &usage_constraints_from_hw, sizeof(usage_constraints_from_hw), NULL, 0,
         digest_region.start, digest_region.length, &act_digest);
+    rom_error_t ecdsa_error =
+        sigverify_ecdsa_p256_finish(&manifest->ecdsa_signature, &flash_exec);
+    HARDENED_RETURN_IF_ERROR(ecdsa_error);
+    return spx_error;
   } else {
     // TODO: consider whether an SPX+-only verify is sufficent.
     return kErrorOwnershipInvalidAlgorithm;
@@ -404,13 +443,22 @@ static rom_error_t rom_ext_boot(boot_data_t *boot_data, boot_log_t *boot_log,
     memset(&sealing_binding, 0x55, sizeof(sealing_binding));
   }
 
+  // The ownership history is updated whenever the owner secret is rotated, so
+  // it tells the DICE certificate cache when the CDI_1 key has changed. It
+  // cannot be read before the first ownership transfer on FPGA.
+  hmac_digest_t owner_history;
+  if (ownership_history_get(&owner_history) != kErrorOk) {
+    memset(&owner_history, 0, sizeof(owner_history));
+  }
+
   // Generate CDI_1 attestation keys and certificate.
   HARDENED_RETURN_IF_ERROR(dice_chain_attestation_owner(
       manifest, &boot_measurements.bl0, &owner_measurement, &sealing_binding,
-      key->key_domain));
+      &owner_history, key->key_domain));
 
   // Write the DICE certs to flash if they have been updated.
   HARDENED_RETURN_IF_ERROR(dice_chain_flush_flash());
+  rom_ext_profile_mark(kBootLogMilestoneRomExtDice);
 
   // Remove write and erase access to the certificate pages before handing over
   // execution to the owner firmware (owner firmware can still read).
@@ -501,6 +549,8 @@ static rom_error_t rom_ext_boot(boot_data_t *boot_data, boot_log_t *boot_log,
                                    TOP_EARLGREY_OTP_CTRL_CORE_BASE_ADDR);
   // Jump to OWNER entry point.
   dbg_printf("entry: 0x%x\r\n", (unsigned int)entry_point);
+  rom_ext_profile_mark(kBootLogMilestoneRomExtJump);
+  rom_ext_profile_print();
   ((owner_stage_entry_point *)entry_point)();
 
   return kErrorRomExtBootFailed;
@@ -663,6 +713,7 @@ static rom_error_t rom_ext_try_next_stage(boot_data_t *boot_data,
   rom_error_t slot[2] = {0, 0};
   for (size_t i = 0; i < ARRAYSIZE(manifests.ordered); ++i) {
     error = rom_ext_verify(manifests.ordered[i], boot_data);
+    rom_ext_profile_mark(kBootLogMilestoneRomExtVerify);
     slot[i] = error;
     if (error != kErrorOk) {
       continue;
@@ -220,6 +220,175 @@ static status_t run_decrypt(const aes_test_t *test, bool streaming) {
   return OK_STATUS();
 }
 
+/**
+ * Run AES with the streaming context API for the given test vector.
+ *
+ * Feeds the input in unaligned chunks so that partial blocks are carried over
+ * between updates and the output lags the input.
+ *
+ * @param test Test vector to run.
+ * @param operation Encrypt or decrypt.
+ */
+static status_t run_context(const aes_test_t *test,
+                            otcrypto_aes_operation_t operation) {
+  // Chunk sizes used to split the input.
+  static const size_t kChunkLens[] = {5, 17, 1, 32};
+
+  // Determine the key configuration.
+  otcrypto_key_config_t config = make_key_config(test);
+
+  // Construct blinded key from the key and testing mask.
+  uint32_t keyblob[keyblob_num_words(config)];
+  TRY(keyblob_from_key_and_mask(test->key, kKeyMask, config, keyblob));
+  otcrypto_blinded_key_t key = {
+      .config = config,
+      .keyblob_length = sizeof(keyblob),
+      .keyblob = keyblob,
+  };
+  key.checksum = integrity_blinded_checksum(&key);
+
+  // Calculate the size of the padded plaintext.
+  size_t padded_len_bytes;
+  TRY(otcrypto_aes_padded_plaintext_length(test->plaintext_len, test->padding,
+                                           &padded_len_bytes));
+
+  const unsigned char *input;
+  size_t input_len;
+  const unsigned char *exp_output;
+  size_t exp_output_len;
+  if (operation == kOtcryptoAesOperationEncrypt) {
+    input = (const unsigned char *)test->plaintext;
+    input_len = test->plaintext_len;
+    exp_output = (const unsigned char *)test->exp_ciphertext;
+    exp_output_len = padded_len_bytes;
+  } else {
+    input = (const unsigned char *)test->exp_ciphertext;
+    input_len = padded_len_bytes;
+    // Padding is not removed, so only check the real plaintext.
+    exp_output = (const unsigned char *)test->plaintext;
+    exp_output_len = test->plaintext_len;
+  }
+
+  otcrypto_aes_context_t ctx;
+  TRY(otcrypto_aes_init(
+      &key,
+      (otcrypto_const_word32_buf_t){.data = test->iv, .len = kAesBlockWords},
+      test->mode, operation, test->padding, &ctx));
+
+  // The AES block is reserved until final, so one-shot calls are refused.
+  uint32_t iv_data[kAesBlockWords];
+  memcpy(iv_data, test->iv, kAesBlockBytes);
+  otcrypto_word32_buf_t iv = {.data = iv_data, .len = kAesBlockWords};
+  uint32_t block_data[kAesBlockWords];
+  status_t result = otcrypto_aes(
+      &key, iv, test->mode, operation,
+      (otcrypto_const_byte_buf_t){.data = input, .len = kAesBlockBytes},
+      kOtcryptoAesPaddingNull,
+      (otcrypto_byte_buf_t){.data = (unsigned char *)block_data,
+                            .len = sizeof(block_data)});
+  TRY_CHECK(status_err(result) == kUnavailable);
+
+  uint32_t output_data[padded_len_bytes / sizeof(uint32_t)];
+  unsigned char *output = (unsigned char *)output_data;
+  size_t output_len = 0;
+  size_t offset = 0;
+  for (size_t i = 0; offset < input_len; i++) {
+    size_t chunk_len = kChunkLens[i % ARRAYSIZE(kChunkLens)];
+    if (chunk_len > input_len - offset) {
+      chunk_len = input_len - offset;
+    }
+    size_t written;
+    TRY(otcrypto_aes_update(
+        &ctx, (otcrypto_const_byte_buf_t){.data = &input[offset],
+                                          .len = chunk_len},
+        (otcrypto_byte_buf_t){.data = &output[output_len],
+                              .len = sizeof(output_data) - output_len},
+        &written));
+    offset += chunk_len;
+    output_len += written;
+  }
+
+  size_t written;
+  TRY(otcrypto_aes_final(
+      &ctx,
+      (otcrypto_byte_buf_t){.data = &output[output_len],
+                            .len = sizeof(output_data) - output_len},
+      &written, iv));
+  output_len += written;
+
+  TRY_CHECK(output_len == padded_len_bytes);
+  TRY_CHECK_ARRAYS_EQ(output, exp_output, exp_output_len);
+  return OK_STATUS();
+}
+
+/**
+ * Check that an abandoned streaming context cannot end another operation.
+ *
+ * Context `a` is abandoned by an update with no room for output; context `b`
+ * then reserves the block. Further calls on `a` must be rejected without
+ * releasing the reservation held by `b`.
+ */
+static status_t context_abort_test(void) {
+  otcrypto_key_config_t config = make_key_config(test);
+  uint32_t keyblob[keyblob_num_words(config)];
+  TRY(keyblob_from_key_and_mask(test->key, kKeyMask, config, keyblob));
+  otcrypto_blinded_key_t key = {
+      .config = config,
+      .keyblob_length = sizeof(keyblob),
+      .keyblob = keyblob,
+  };
+  key.checksum = integrity_blinded_checksum(&key);
+  otcrypto_const_word32_buf_t init_iv = {.data = test->iv,
+                                         .len = kAesBlockWords};
+
+  // Three blocks fill the pipeline, so the third one needs output space.
+  uint32_t input_data[3 * kAesBlockWords] = {0};
+  otcrypto_const_byte_buf_t input = {
+      .data = (const unsigned char *)input_data, .len = sizeof(input_data)};
+  uint32_t output_data[3 * kAesBlockWords];
+  otcrypto_byte_buf_t output = {.data = (unsigned char *)output_data,
+                                .len = sizeof(output_data)};
+  uint32_t iv_data[kAesBlockWords];
+  otcrypto_word32_buf_t iv = {.data = iv_data, .len = kAesBlockWords};
+  size_t written;
+
+  otcrypto_aes_context_t a, b;
+  TRY(otcrypto_aes_init(&key, init_iv, test->mode,
+                        kOtcryptoAesOperationEncrypt, kOtcryptoAesPaddingNull,
+                        &a));
+  status_t result = otcrypto_aes_update(
+      &a, input, (otcrypto_byte_buf_t){.data = output.data, .len = 0},
+      &written);
+  TRY_CHECK(status_err(result) == kInvalidArgument);
+
+  TRY(otcrypto_aes_init(&key, init_iv, test->mode,
+                        kOtcryptoAesOperationEncrypt, kOtcryptoAesPaddingNull,
+                        &b));
+  result = otcrypto_aes_update(&a, input, output, &written);
+  TRY_CHECK(status_err(result) == kInvalidArgument);
+  result = otcrypto_aes_final(&a, output, &written, iv);
+  TRY_CHECK(status_err(result) == kInvalidArgument);
+
+  // `b` still holds the block, so one-shot calls are still refused.
+  result = otcrypto_aes(&key, iv, test->mode, kOtcryptoAesOperationEncrypt,
+                        input, kOtcryptoAesPaddingNull, output);
+  TRY_CHECK(status_err(result) == kUnavailable);
+
+  TRY(otcrypto_aes_update(&b, input, output, &written));
+  size_t output_len = written;
+  TRY(otcrypto_aes_final(
+      &b,
+      (otcrypto_byte_buf_t){.data = &output.data[output_len],
+                            .len = output.len - output_len},
+      &written, iv));
+  TRY_CHECK(output_len + written == sizeof(output_data));
+
+  // A finished context is rejected as well.
+  result = otcrypto_aes_final(&b, output, &written, iv);
+  TRY_CHECK(status_err(result) == kInvalidArgument);
+  return OK_STATUS();
+}
+
 /**
  * Test one-shot AES encryption.
  */
@@ -248,6 +417,20 @@ static status_t decrypt_streaming_test(void) {
   return run_decrypt(test, /*streaming=*/true);
 }
 
+/**
+ * Test AES encryption with the streaming context API.
+ */
+static status_t encrypt_context_test(void) {
+  return run_context(test, kOtcryptoAesOperationEncrypt);
+}
+
+/**
+ * Test AES decryption with the streaming context API.
+ */
+static status_t decrypt_context_test(void) {
+  return run_context(test, kOtcryptoAesOperationDecrypt);
+}
+
 OTTF_DEFINE_TEST_CONFIG();
 
 bool test_main(void) {
@@ -263,8 +446,12 @@ bool test_main(void) {
     EXECUTE_TEST(result, decrypt_test);
     EXECUTE_TEST(result, encrypt_streaming_test);
     EXECUTE_TEST(result, decrypt_streaming_test);
+    EXECUTE_TEST(result, encrypt_context_test);
+    EXECUTE_TEST(result, decrypt_context_test);
     LOG_INFO("Finished AES test %d.", i + 1);
   }
+  test = &kAesTests[0];
+  EXECUTE_TEST(result, context_abort_test);
 
   return status_ok(result);
 }
@@ -0,0 +1,262 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/hmac.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/drivers/otbn_queue.h"
+#include "sw/device/lib/crypto/impl/ecc/p256.h"
+#include "sw/device/lib/dif/dif_rv_plic.h"
+#include "sw/device/lib/runtime/irq.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/entropy_testutils.h"
+#include "sw/device/lib/testing/profile.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+
+enum {
+  /* Number of signing requests in a batch. */
+  kNumRequests = 4,
+  /* Size of each request message in bytes. */
+  kRequestBytes = 2048,
+};
+
+/**
+ * A request to sign the SHA2-256 digest of a message.
+ */
+typedef struct sign_request {
+  const uint8_t *msg;
+  size_t len;
+  uint32_t digest[kP256ScalarWords];
+  p256_ecdsa_signature_t signature;
+} sign_request_t;
+
+static p256_masked_scalar_t private_key;
+static p256_point_t public_key;
+static uint8_t messages[kNumRequests][kRequestBytes];
+static sign_request_t requests[kNumRequests];
+static otbn_job_t jobs[kNumRequests];
+
+static dif_rv_plic_t plic;
+
+/**
+ * Number of OTBN `done` interrupts handled.
+ */
+static volatile uint32_t irq_count;
+
+/**
+ * Advances the queue on the OTBN `done` interrupt.
+ */
+void ottf_external_isr(uint32_t *exc_info) {
+  dif_rv_plic_irq_id_t irq_id;
+  CHECK_DIF_OK(
+      dif_rv_plic_irq_claim(&plic, kTopEarlgreyPlicTargetIbex0, &irq_id));
+  CHECK(irq_id == kTopEarlgreyPlicIrqIdOtbnDone, "Unexpected IRQ %d", irq_id);
+  otbn_queue_irq();
+  ++irq_count;
+  CHECK_DIF_OK(
+      dif_rv_plic_irq_complete(&plic, kTopEarlgreyPlicTargetIbex0, irq_id));
+}
+
+static status_t sign_prepare(void *ctx) {
+  sign_request_t *req = ctx;
+  return hmac_hash_sha256(req->msg, req->len, req->digest);
+}
+
+static status_t sign_start(void *ctx) {
+  sign_request_t *req = ctx;
+  return p256_ecdsa_sign_start(req->digest, &private_key);
+}
+
+static status_t sign_finalize(void *ctx) {
+  sign_request_t *req = ctx;
+  return p256_ecdsa_sign_finalize(&req->signature);
+}
+
+static status_t prepare_fail(void *ctx) { return OTCRYPTO_BAD_ARGS; }
+
+static status_t setup(void) {
+  TRY(p256_keygen_start());
+  TRY(p256_keygen_finalize(&private_key, &public_key));
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    for (size_t j = 0; j < kRequestBytes; ++j) {
+      messages[i][j] = (uint8_t)(i * 31 + j);
+    }
+    requests[i] = (sign_request_t){.msg = messages[i], .len = kRequestBytes};
+  }
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Checks that every request holds a valid signature, and clears it.
+ */
+static status_t check_signatures(void) {
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    hardened_bool_t result = kHardenedBoolFalse;
+    TRY(p256_ecdsa_verify_start(&requests[i].signature, requests[i].digest,
+                                &public_key));
+    TRY(p256_ecdsa_verify_finalize(&requests[i].signature, &result));
+    TRY_CHECK(result == kHardenedBoolTrue);
+    memset(&requests[i].signature, 0, sizeof(requests[i].signature));
+  }
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Signs every request in turn, without the queue.
+ */
+static status_t sign_sequential(uint32_t *cycles) {
+  uint64_t t_start = profile_start();
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    TRY(sign_prepare(&requests[i]));
+    TRY(sign_start(&requests[i]));
+    TRY(sign_finalize(&requests[i]));
+  }
+  *cycles = profile_end(t_start);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Signs every request through the queue.
+ */
+static status_t sign_queued(uint32_t *cycles) {
+  uint64_t t_start = profile_start();
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    jobs[i] = (otbn_job_t){
+        .prepare = sign_prepare,
+        .start = sign_start,
+        .finalize = sign_finalize,
+        .ctx = &requests[i],
+    };
+    TRY(otbn_queue_submit(&jobs[i]));
+  }
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    TRY(otbn_queue_wait(&jobs[i]));
+  }
+  *cycles = profile_end(t_start);
+  return OTCRYPTO_OK;
+}
+
+static status_t queue_cycles_test(void) {
+  TRY(otbn_resident_app_policy_set(kHardenedBoolTrue));
+
+  uint32_t cycles_sequential;
+  TRY(sign_sequential(&cycles_sequential));
+  TRY(check_signatures());
+
+  uint32_t cycles_queued;
+  TRY(sign_queued(&cycles_queued));
+  TRY(check_signatures());
+  TRY(otbn_resident_app_policy_set(kHardenedBoolFalse));
+
+  LOG_INFO("%d signatures, sequential: %u cycles", kNumRequests,
+           cycles_sequential);
+  LOG_INFO("%d signatures, queued: %u cycles", kNumRequests, cycles_queued);
+  TRY_CHECK(cycles_queued < cycles_sequential);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Checks that a failing job reports its error and does not hold up the jobs
+ * behind it.
+ */
+static status_t queue_error_test(void) {
+  jobs[0] = (otbn_job_t){
+      .prepare = sign_prepare,
+      .start = sign_start,
+      .finalize = sign_finalize,
+      .ctx = &requests[0],
+  };
+  jobs[1] = (otbn_job_t){
+      .prepare = prepare_fail,
+      .start = sign_start,
+      .finalize = sign_finalize,
+      .ctx = &requests[1],
+  };
+  jobs[2] = jobs[0];
+  jobs[2].ctx = &requests[2];
+  for (size_t i = 0; i < 3; ++i) {
+    TRY(otbn_queue_submit(&jobs[i]));
+  }
+
+  TRY(otbn_queue_wait(&jobs[2]));
+  TRY_CHECK(otbn_job_done(&jobs[0]) == kHardenedBoolTrue);
+  TRY_CHECK(otbn_job_done(&jobs[1]) == kHardenedBoolTrue);
+  TRY(otbn_queue_wait(&jobs[0]));
+  TRY_CHECK(!status_ok(otbn_queue_wait(&jobs[1])));
+
+  hardened_bool_t result = kHardenedBoolFalse;
+  TRY(p256_ecdsa_verify_start(&requests[2].signature, requests[2].digest,
+                              &public_key));
+  TRY(p256_ecdsa_verify_finalize(&requests[2].signature, &result));
+  TRY_CHECK(result == kHardenedBoolTrue);
+
+  TRY_CHECK(otbn_queue_submit(&(otbn_job_t){.prepare = sign_prepare}).value ==
+            OTCRYPTO_BAD_ARGS.value);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Checks that the queue advances from the OTBN `done` interrupt, with jobs
+ * submitted while earlier ones run.
+ */
+static status_t queue_irq_test(void) {
+  TRY(dif_rv_plic_init(mmio_region_from_addr(TOP_EARLGREY_RV_PLIC_BASE_ADDR),
+                       &plic));
+  TRY(dif_rv_plic_irq_set_priority(&plic, kTopEarlgreyPlicIrqIdOtbnDone, 1));
+  TRY(dif_rv_plic_irq_set_enabled(&plic, kTopEarlgreyPlicIrqIdOtbnDone,
+                                  kTopEarlgreyPlicTargetIbex0,
+                                  kDifToggleEnabled));
+  TRY(dif_rv_plic_target_set_threshold(&plic, kTopEarlgreyPlicTargetIbex0, 0));
+  irq_count = 0;
+  otbn_queue_irq_enable(true);
+  irq_global_ctrl(true);
+  irq_external_ctrl(true);
+
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    jobs[i] = (otbn_job_t){
+        .prepare = sign_prepare,
+        .start = sign_start,
+        .finalize = sign_finalize,
+        .ctx = &requests[i],
+    };
+    TRY(otbn_queue_submit(&jobs[i]));
+  }
+  ATOMIC_WAIT_FOR_INTERRUPT(otbn_job_done(&jobs[kNumRequests - 1]) ==
+                            kHardenedBoolTrue);
+
+  irq_external_ctrl(false);
+  otbn_queue_irq_enable(false);
+  TRY(dif_rv_plic_irq_set_enabled(&plic, kTopEarlgreyPlicIrqIdOtbnDone,
+                                  kTopEarlgreyPlicTargetIbex0,
+                                  kDifToggleDisabled));
+
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    TRY_CHECK(otbn_job_done(&jobs[i]) == kHardenedBoolTrue);
+    TRY(otbn_queue_wait(&jobs[i]));
+  }
+  TRY_CHECK(irq_count > 0);
+  TRY(check_signatures());
+  return OTCRYPTO_OK;
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  CHECK_STATUS_OK(entropy_testutils_auto_mode_init());
+  CHECK_STATUS_OK(setup());
+
+  status_t test_result = OK_STATUS();
+  EXECUTE_TEST(test_result, queue_cycles_test);
+  EXECUTE_TEST(test_result, queue_error_test);
+  EXECUTE_TEST(test_result, queue_irq_test);
+  if (!status_ok(test_result)) {
+    LOG_INFO("OTBN error bits: 0x%08x", otbn_err_bits_get());
+    LOG_INFO("OTBN instruction count: 0x%08x", otbn_instruction_count_get());
+  }
+  return status_ok(test_result);
+}
@@ -0,0 +1,180 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/impl/integrity.h"
+#include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/ecc_p256.h"
+#include "sw/device/lib/crypto/include/sha2.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/entropy_testutils.h"
+#include "sw/device/lib/testing/profile.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+enum {
+  /* Number of 32-bit words in a P-256 public key. */
+  kP256PublicKeyWords = 512 / 32,
+  /* Number of 32-bit words in a P-256 signature. */
+  kP256SignatureWords = 512 / 32,
+  /* Number of bytes in a P-256 private key. */
+  kP256PrivateKeyBytes = 256 / 8,
+  /* Number of back-to-back verifications to time in each mode. */
+  kNumVerifications = 4,
+};
+
+// Message
+static const char kMessage[] = "test message";
+
+static const otcrypto_key_config_t kPrivateKeyConfig = {
+    .version = kOtcryptoLibVersion1,
+    .key_mode = kOtcryptoKeyModeEcdsaP256,
+    .key_length = kP256PrivateKeyBytes,
+    .hw_backed = kHardenedBoolFalse,
+    .security_level = kOtcryptoKeySecurityLevelLow,
+};
+
+static uint32_t pk[kP256PublicKeyWords];
+static otcrypto_unblinded_key_t public_key = {
+    .key_mode = kOtcryptoKeyModeEcdsaP256,
+    .key_length = sizeof(pk),
+    .key = pk,
+};
+static uint32_t sig[kP256SignatureWords];
+static uint32_t msg_digest_data[256 / 32];
+static otcrypto_hash_digest_t msg_digest = {
+    .data = msg_digest_data,
+    .len = ARRAYSIZE(msg_digest_data),
+};
+
+/**
+ * Generates a keypair and a signature to verify repeatedly.
+ */
+static status_t setup(void) {
+  uint32_t keyblob[keyblob_num_words(kPrivateKeyConfig)];
+  otcrypto_blinded_key_t private_key = {
+      .config = kPrivateKeyConfig,
+      .keyblob_length = sizeof(keyblob),
+      .keyblob = keyblob,
+  };
+  TRY(otcrypto_ecdsa_p256_keygen(&private_key, &public_key));
+
+  otcrypto_const_byte_buf_t msg = {
+      .len = sizeof(kMessage) - 1,
+      .data = (unsigned char *)&kMessage,
+  };
+  TRY(otcrypto_sha2_256(msg, &msg_digest));
+
+  TRY(otcrypto_ecdsa_p256_sign(
+      &private_key, msg_digest,
+      (otcrypto_word32_buf_t){.data = sig, .len = ARRAYSIZE(sig)}));
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Runs `kNumVerifications` verifications back to back.
+ *
+ * @param[out] cycles Total number of cycles spent verifying.
+ */
+static status_t verify_loop(uint32_t *cycles) {
+  uint64_t t_start = profile_start();
+  for (size_t i = 0; i < kNumVerifications; ++i) {
+    hardened_bool_t result = kHardenedBoolFalse;
+    TRY(otcrypto_ecdsa_p256_verify(
+        &public_key, msg_digest,
+        (otcrypto_const_word32_buf_t){.data = sig, .len = ARRAYSIZE(sig)},
+        &result));
+    TRY_CHECK(result == kHardenedBoolTrue);
+  }
+  *cycles = profile_end(t_start);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Runs one verification of `sig`, which may have been corrupted.
+ *
+ * @param[out] result Result of the verification.
+ * @param[out] cycles Number of cycles spent verifying.
+ */
+static status_t verify_once(hardened_bool_t *result, uint32_t *cycles) {
+  uint64_t t_start = profile_start();
+  TRY(otcrypto_ecdsa_p256_verify(
+      &public_key, msg_digest,
+      (otcrypto_const_word32_buf_t){.data = sig, .len = ARRAYSIZE(sig)},
+      result));
+  *cycles = profile_end(t_start);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Checks that a resident app is reloaded after being invalidated or after its
+ * IMEM is wiped, and that a corrupted signature is still rejected when the app
+ * is resident.
+ */
+static status_t resident_negative_test(void) {
+  TRY(otbn_resident_app_policy_set(kHardenedBoolTrue));
+  otbn_resident_app_invalidate();
+
+  // After invalidation, the first run must reload the app, which takes longer
+  // than the following run with the app resident.
+  sig[0] ^= 1;
+  hardened_bool_t result = kHardenedBoolTrue;
+  uint32_t cycles_reload;
+  TRY(verify_once(&result, &cycles_reload));
+  sig[0] ^= 1;
+  TRY_CHECK(result == kHardenedBoolFalse);
+
+  // The previous run must not leave anything behind that affects this one.
+  uint32_t cycles_resident;
+  TRY(verify_once(&result, &cycles_resident));
+  TRY_CHECK(result == kHardenedBoolTrue);
+  TRY_CHECK(cycles_resident < cycles_reload);
+
+  // Wiping IMEM behind the driver's back must also force a reload; running
+  // the wiped IMEM would fail.
+  TRY(otbn_imem_sec_wipe());
+  TRY(verify_once(&result, &cycles_reload));
+  TRY_CHECK(result == kHardenedBoolTrue);
+  TRY_CHECK(cycles_resident < cycles_reload);
+
+  TRY(otbn_resident_app_policy_set(kHardenedBoolFalse));
+  return OTCRYPTO_OK;
+}
+
+static status_t resident_app_cycles_test(void) {
+  uint32_t cycles_reload;
+  TRY(otbn_resident_app_policy_set(kHardenedBoolFalse));
+  TRY(verify_loop(&cycles_reload));
+
+  uint32_t cycles_resident;
+  TRY(otbn_resident_app_policy_set(kHardenedBoolTrue));
+  TRY(verify_loop(&cycles_resident));
+  TRY(otbn_resident_app_policy_set(kHardenedBoolFalse));
+
+  LOG_INFO("%d verifications with reload: %u cycles", kNumVerifications,
+           cycles_reload);
+  LOG_INFO("%d verifications with resident app: %u cycles", kNumVerifications,
+           cycles_resident);
+  TRY_CHECK(cycles_resident < cycles_reload);
+  LOG_INFO("Saved %u cycles per verification",
+           (cycles_reload - cycles_resident) / kNumVerifications);
+  return OTCRYPTO_OK;
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  CHECK_STATUS_OK(entropy_testutils_auto_mode_init());
+  CHECK_STATUS_OK(setup());
+
+  status_t test_result = OK_STATUS();
+  EXECUTE_TEST(test_result, resident_app_cycles_test);
+  EXECUTE_TEST(test_result, resident_negative_test);
+  if (!status_ok(test_result)) {
+    LOG_INFO("OTBN error bits: 0x%08x", otbn_err_bits_get());
+    LOG_INFO("OTBN instruction count: 0x%08x", otbn_instruction_count_get());
+  }
+  return status_ok(test_result);
+}
@@ -0,0 +1,259 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/impl/integrity.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/kmac.h"
+#include "sw/device/lib/crypto/include/sha3.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+#define MODULE_ID MAKE_MODULE_ID('t', 's', 't')
+
+enum {
+  // Length of the test message in bytes.
+  kMessageBytes = 301,
+  // Length of the XOF output in words (more than one SHAKE128 block).
+  kXofWords = 50,
+  // Length of the KMAC tag in words.
+  kTagWords = 8,
+};
+
+// Chunk sizes used to split the message; deliberately unaligned.
+static const size_t kChunkSizes[] = {1, 7, 64, 135, 0, 94};
+
+static uint8_t message[kMessageBytes];
+
+// Function name and customization string for cSHAKE and KMAC.
+static const uint8_t kFunctionName[] = {'O', 'T'};
+static const uint8_t kCustomization[] = {'s', 't', 'r', 'e', 'a', 'm'};
+
+// KMAC128 key, as two shares.
+static uint32_t kmac_keyblob[] = {
+    0x0f0e0d0c, 0x0b0a0908, 0x07060504, 0x03020100,
+    0x1a2b3c4d, 0x5e6f7081, 0x92a3b4c5, 0xd6e7f809,
+};
+
+static otcrypto_blinded_key_t kmac_key = {
+    .config =
+        {
+            .version = kOtcryptoLibVersion1,
+            .key_mode = kOtcryptoKeyModeKmac128,
+            .key_length = 128 / 8,
+            .hw_backed = kHardenedBoolFalse,
+            .security_level = kOtcryptoKeySecurityLevelLow,
+        },
+    .keyblob_length = sizeof(kmac_keyblob),
+    .keyblob = kmac_keyblob,
+};
+
+/**
+ * Feed `message` to a streaming SHA-3 context in uneven chunks.
+ */
+static status_t sha3_update_chunked(otcrypto_sha3_context_t *ctx) {
+  size_t offset = 0;
+  for (size_t i = 0; i < ARRAYSIZE(kChunkSizes); i++) {
+    otcrypto_const_byte_buf_t chunk = {
+        .data = &message[offset],
+        .len = kChunkSizes[i],
+    };
+    TRY(otcrypto_sha3_update(ctx, chunk));
+    offset += kChunkSizes[i];
+  }
+  TRY_CHECK(offset == kMessageBytes);
+  return OK_STATUS();
+}
+
+/**
+ * Check that streaming SHA3-256 matches the one-shot digest.
+ */
+static status_t sha3_256_stream_test(void) {
+  uint32_t exp_data[256 / 32];
+  otcrypto_hash_digest_t exp_digest = {
+      .data = exp_data,
+      .len = ARRAYSIZE(exp_data),
+  };
+  TRY(otcrypto_sha3_256(
+      (otcrypto_const_byte_buf_t){.data = message, .len = kMessageBytes},
+      &exp_digest));
+
+  otcrypto_sha3_context_t ctx;
+  TRY(otcrypto_sha3_init(kOtcryptoHashModeSha3_256, &ctx));
+  TRY(sha3_update_chunked(&ctx));
+  uint32_t act_data[256 / 32];
+  otcrypto_hash_digest_t act_digest = {
+      .data = act_data,
+      .len = ARRAYSIZE(act_data),
+  };
+  TRY(otcrypto_sha3_final(&ctx, &act_digest));
+
+  TRY_CHECK(act_digest.mode == kOtcryptoHashModeSha3_256);
+  TRY_CHECK_ARRAYS_EQ(act_data, exp_data, ARRAYSIZE(exp_data));
+  return OK_STATUS();
+}
+
+/**
+ * Check that incrementally squeezed SHAKE128 output matches the one-shot
+ * output, including across a Keccak block boundary.
+ */
+static status_t shake128_squeeze_test(void) {
+  uint32_t exp_data[kXofWords];
+  otcrypto_hash_digest_t exp_digest = {
+      .data = exp_data,
+      .len = ARRAYSIZE(exp_data),
+  };
+  TRY(otcrypto_shake128(
+      (otcrypto_const_byte_buf_t){.data = message, .len = kMessageBytes},
+      &exp_digest));
+
+  otcrypto_sha3_context_t ctx;
+  TRY(otcrypto_sha3_init(kOtcryptoHashXofModeShake128, &ctx));
+  TRY(sha3_update_chunked(&ctx));
+
+  // Squeeze in three parts: 3 words, 45 words (crossing the 42-word rate) and
+  // the last 2 words from the final call.
+  uint32_t act_data[kXofWords];
+  otcrypto_hash_digest_t part = {.data = act_data, .len = 3};
+  TRY(otcrypto_sha3_squeeze(&ctx, &part));
+  part.data = &act_data[3];
+  part.len = 45;
+  TRY(otcrypto_sha3_squeeze(&ctx, &part));
+  part.data = &act_data[48];
+  part.len = 2;
+  TRY(otcrypto_sha3_final(&ctx, &part));
+
+  TRY_CHECK(part.mode == kOtcryptoHashXofModeShake128);
+  TRY_CHECK_ARRAYS_EQ(act_data, exp_data, ARRAYSIZE(exp_data));
+  return OK_STATUS();
+}
+
+/**
+ * Check that streaming cSHAKE256 matches the one-shot output.
+ */
+static status_t cshake256_stream_test(void) {
+  otcrypto_const_byte_buf_t function_name = {
+      .data = kFunctionName,
+      .len = sizeof(kFunctionName),
+  };
+  otcrypto_const_byte_buf_t customization = {
+      .data = kCustomization,
+      .len = sizeof(kCustomization),
+  };
+
+  uint32_t exp_data[kXofWords];
+  otcrypto_hash_digest_t exp_digest = {
+      .data = exp_data,
+      .len = ARRAYSIZE(exp_data),
+  };
+  TRY(otcrypto_cshake256(
+      (otcrypto_const_byte_buf_t){.data = message, .len = kMessageBytes},
+      function_name, customization, &exp_digest));
+
+  otcrypto_sha3_context_t ctx;
+  TRY(otcrypto_cshake_init(kOtcryptoHashXofModeCshake256, function_name,
+                           customization, &ctx));
+  TRY(sha3_update_chunked(&ctx));
+  uint32_t act_data[kXofWords];
+  otcrypto_hash_digest_t act_digest = {
+      .data = act_data,
+      .len = ARRAYSIZE(act_data),
+  };
+  TRY(otcrypto_sha3_final(&ctx, &act_digest));
+
+  TRY_CHECK_ARRAYS_EQ(act_data, exp_data, ARRAYSIZE(exp_data));
+  return OK_STATUS();
+}
+
+/**
+ * Check that streaming KMAC128 matches the one-shot tag.
+ */
+static status_t kmac128_stream_test(void) {
+  otcrypto_const_byte_buf_t customization = {
+      .data = kCustomization,
+      .len = sizeof(kCustomization),
+  };
+  kmac_key.checksum = integrity_blinded_checksum(&kmac_key);
+
+  uint32_t exp_data[kTagWords];
+  TRY(otcrypto_kmac(
+      &kmac_key,
+      (otcrypto_const_byte_buf_t){.data = message, .len = kMessageBytes},
+      customization, sizeof(exp_data),
+      (otcrypto_word32_buf_t){.data = exp_data, .len = ARRAYSIZE(exp_data)}));
+
+  otcrypto_kmac_context_t ctx;
+  kmac_key.checksum = integrity_blinded_checksum(&kmac_key);
+  TRY(otcrypto_kmac_init(&kmac_key, customization, sizeof(exp_data), &ctx));
+  size_t offset = 0;
+  for (size_t i = 0; i < ARRAYSIZE(kChunkSizes); i++) {
+    TRY(otcrypto_kmac_update(
+        &ctx, (otcrypto_const_byte_buf_t){.data = &message[offset],
+                                          .len = kChunkSizes[i]}));
+    offset += kChunkSizes[i];
+  }
+  uint32_t act_data[kTagWords];
+  TRY(otcrypto_kmac_final(&ctx, (otcrypto_word32_buf_t){
+                                    .data = act_data,
+                                    .len = ARRAYSIZE(act_data),
+                                }));
+
+  TRY_CHECK_ARRAYS_EQ(act_data, exp_data, ARRAYSIZE(exp_data));
+  return OK_STATUS();
+}
+
+/**
+ * Check that an active stream locks out other KMAC block users, and that
+ * final releases the block.
+ */
+static status_t lock_test(void) {
+  otcrypto_sha3_context_t ctx;
+  TRY(otcrypto_sha3_init(kOtcryptoHashModeSha3_256, &ctx));
+
+  // One-shot operations and a second stream must be refused.
+  uint32_t digest_data[256 / 32];
+  otcrypto_hash_digest_t digest = {
+      .data = digest_data,
+      .len = ARRAYSIZE(digest_data),
+  };
+  otcrypto_const_byte_buf_t empty = {.data = NULL, .len = 0};
+  status_t result = otcrypto_sha3_256(empty, &digest);
+  TRY_CHECK(status_err(result) == kUnavailable);
+  otcrypto_sha3_context_t ctx2;
+  result = otcrypto_sha3_init(kOtcryptoHashModeSha3_256, &ctx2);
+  TRY_CHECK(status_err(result) == kUnavailable);
+
+  // A context that does not hold the lock must be rejected.
+  result = otcrypto_sha3_update(&ctx2, empty);
+  TRY_CHECK(status_err(result) == kInvalidArgument);
+
+  // A wrong digest length fails, but still releases the block.
+  digest.len = 1;
+  result = otcrypto_sha3_final(&ctx, &digest);
+  TRY_CHECK(status_err(result) == kInvalidArgument);
+  digest.len = ARRAYSIZE(digest_data);
+  TRY(otcrypto_sha3_256(empty, &digest));
+  return OK_STATUS();
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  status_t test_result = OK_STATUS();
+  CHECK_STATUS_OK(entropy_complex_init());
+
+  for (size_t i = 0; i < kMessageBytes; i++) {
+    message[i] = (uint8_t)(i * 7 + 3);
+  }
+
+  EXECUTE_TEST(test_result, sha3_256_stream_test);
+  EXECUTE_TEST(test_result, shake128_squeeze_test);
+  EXECUTE_TEST(test_result, cshake256_stream_test);
+  EXECUTE_TEST(test_result, kmac128_stream_test);
+  EXECUTE_TEST(test_result, lock_test);
+  return status_ok(test_result);
+}
@@ -0,0 +1,112 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "dt/dt_dma.h"
+#include "dt/dt_pinmux.h"
+#include "dt/dt_spi_host.h"
+#include "hw/top_darjeeling/sw/autogen/top_darjeeling.h"
+#include "sw/device/lib/arch/device.h"
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/dif/dif_dma.h"
+#include "sw/device/lib/dif/dif_pinmux.h"
+#include "sw/device/lib/dif/dif_spi_host.h"
+#include "sw/device/lib/runtime/dma.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/dma_testutils.h"
+#include "sw/device/lib/testing/pinmux_testutils.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+#include "spi_host_regs.h"  // Generated.
+
+// Streams a SPI host receive transaction into memory with `dma_fifo_read()`.
+//
+// The transfer is driven by `chip_sw_dma_spi_hw_handshake_vseq`, which plays
+// back TX_SIZE bytes from the SPI agent and backdoors their digest, as for
+// `dma_inline_hashing`.
+
+// The TX_SIZE must be in sync with the data size in spi_device_dma_seq.sv
+#define TX_SIZE 512
+#define CHUNK_SIZE 32 * 4  // Half the SPI host FIFO size
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  // LSIO trigger of SPI host 0.
+  kSpiHost0Trigger = 1u << 1,
+  kDigestWords = 8,
+};
+
+// Expected digest value gets backdoor'ed from the hardware
+static volatile const uint32_t kShaDigestExpData[16];
+static volatile const uint8_t kShaMode;
+
+static uint8_t received_data[TX_SIZE] __attribute__((aligned(4)));
+static uint8_t copied_data[TX_SIZE] __attribute__((aligned(4)));
+
+static dif_spi_host_t spi_host;
+static dif_pinmux_t pinmux;
+static dif_dma_t dma;
+
+bool test_main(void) {
+  CHECK_DIF_OK(dif_pinmux_init_from_dt(kDtPinmuxAon, &pinmux));
+  pinmux_testutils_init(&pinmux);
+  setup_pads_spi_host0(&pinmux);
+
+  CHECK_DIF_OK(dif_dma_init_from_dt(kDtDma, &dma));
+  CHECK_DIF_OK(dif_dma_memory_range_set(&dma, TOP_DARJEELING_RAM_MAIN_BASE_ADDR,
+                                        TOP_DARJEELING_RAM_MAIN_SIZE_BYTES));
+  CHECK_STATUS_OK(dma_service_init(&dma, /*sha256=*/NULL));
+
+  // The RX watermark raises the handshake once a chunk is available.
+  CHECK_DIF_OK(dif_spi_host_init_from_dt((dt_spi_host_t)0, &spi_host));
+  init_spi_host(&spi_host, (uint32_t)kClockFreqHiSpeedPeripheralHz,
+                CHUNK_SIZE / 4);
+
+  // DV sync message
+  LOG_INFO("spi host configuration complete");
+
+  CHECK(kShaMode == kDifDmaSha256Opcode,
+        "Run with +sha_mode=0 so that the digest is SHA2-256");
+
+  // Arm the DMA engine before the transaction fills the FIFO.
+  uint64_t start = ibex_mcycle_read();
+  dma_op_t op = {0};
+  CHECK_STATUS_OK(dma_fifo_read(
+      &op, received_data,
+      TOP_DARJEELING_SPI_HOST0_BASE_ADDR + SPI_HOST_RXDATA_REG_OFFSET, TX_SIZE,
+      CHUNK_SIZE, kSpiHost0Trigger));
+
+  // The receive segment has no buffer: the CPU queues the command and leaves
+  // the RX FIFO to the DMA engine.
+  dif_spi_host_segment_t segment = {
+      .type = kDifSpiHostSegmentTypeRx,
+      .rx = {.width = kDifSpiHostWidthStandard, .buf = NULL, .length = TX_SIZE},
+  };
+  CHECK_DIF_OK(dif_spi_host_transaction_pipelined(&spi_host, /*csid=*/0,
+                                                  &segment, 1));
+  CHECK_STATUS_OK(dma_wait(&op));
+  uint64_t cycles = ibex_mcycle_read() - start;
+  LOG_INFO("dma_fifo_read: %u bytes in %u cycles", (uint32_t)TX_SIZE,
+           (uint32_t)cycles);
+
+  // Hash the received data on the way through a second, memory-to-memory,
+  // transfer. This also checks that the handshake was disabled on completion.
+  uint32_t digest[kDigestWords];
+  CHECK_STATUS_OK(
+      dma_memcpy_and_sha256(&op, copied_data, received_data, TX_SIZE, digest));
+  CHECK_STATUS_OK(dma_wait(&op));
+  CHECK_ARRAYS_EQ(copied_data, received_data, TX_SIZE);
+
+  // The expected digest is in the order of the DMA digest registers, which the
+  // service swaps to the standard byte order.
+  for (size_t i = 0; i < kDigestWords; ++i) {
+    CHECK(digest[i] == bitfield_byteswap32(kShaDigestExpData[i]),
+          "Digest mismatch at word %u", (uint32_t)i);
+  }
+
+  return true;
+}
@@ -0,0 +1,181 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "dt/dt_dma.h"
+#include "dt/dt_hmac.h"
+#include "hw/top_darjeeling/sw/autogen/top_darjeeling.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/dif/dif_dma.h"
+#include "sw/device/lib/dif/dif_hmac.h"
+#include "sw/device/lib/runtime/dma.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/hmac_testutils.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  kMaxSize = 4096,
+  kDigestWords = 8,
+};
+
+static const size_t kSizes[] = {64, 512, kMaxSize};
+
+static uint8_t src[kMaxSize + sizeof(uint32_t)] __attribute__((aligned(4)));
+static uint8_t dest[kMaxSize + sizeof(uint32_t)] __attribute__((aligned(4)));
+
+static dif_dma_t dma;
+static dif_hmac_t hmac;
+
+/**
+ * SHA2-256 on the HMAC block, producing the digest in the same byte order as
+ * the DMA service.
+ */
+static status_t hmac_sha256(const uint8_t *msg, size_t len, uint32_t *digest) {
+  static const dif_hmac_transaction_t kConfig = {
+      .message_endianness = kDifHmacEndiannessLittle,
+      .digest_endianness = kDifHmacEndiannessBig,
+      .digest_size = kDifSHA256,
+  };
+  TRY(dif_hmac_mode_sha256_start(&hmac, kConfig));
+  TRY(hmac_testutils_push_message(&hmac, (const char *)msg, len));
+  TRY(dif_hmac_process(&hmac));
+  dif_hmac_digest_t result;
+  TRY(hmac_testutils_finish_polled(&hmac, &result));
+  // The DIF returns the digest least-significant word first.
+  for (size_t i = 0; i < kDigestWords; ++i) {
+    digest[i] = result.digest[kDigestWords - 1 - i];
+  }
+  return OK_STATUS();
+}
+
+static void fill(uint8_t *buf, size_t len, uint8_t seed) {
+  for (size_t i = 0; i < len; ++i) {
+    buf[i] = (uint8_t)(seed + i * 7);
+  }
+}
+
+static void memcpy_perf(size_t len) {
+  fill(src, len, (uint8_t)len);
+
+  memset(dest, 0, len);
+  uint64_t start = ibex_mcycle_read();
+  memcpy(dest, src, len);
+  uint64_t cpu_cycles = ibex_mcycle_read() - start;
+  CHECK_ARRAYS_EQ(dest, src, len);
+
+  memset(dest, 0, len);
+  dma_op_t op = {0};
+  start = ibex_mcycle_read();
+  CHECK_STATUS_OK(dma_memcpy(&op, dest, src, len));
+  CHECK_STATUS_OK(dma_wait(&op));
+  uint64_t dma_cycles = ibex_mcycle_read() - start;
+  CHECK_ARRAYS_EQ(dest, src, len);
+
+  LOG_INFO("copy %u bytes: memcpy %u cycles, dma_memcpy %u cycles",
+           (uint32_t)len, (uint32_t)cpu_cycles, (uint32_t)dma_cycles);
+}
+
+static void sha256_perf(size_t len) {
+  fill(src, len, (uint8_t)~len);
+
+  uint32_t expected[kDigestWords];
+  uint64_t start = ibex_mcycle_read();
+  CHECK_STATUS_OK(hmac_sha256(src, len, expected));
+  uint64_t hmac_cycles = ibex_mcycle_read() - start;
+
+  memset(dest, 0, len);
+  uint32_t digest[kDigestWords] = {0};
+  dma_op_t op = {0};
+  start = ibex_mcycle_read();
+  CHECK_STATUS_OK(dma_memcpy_and_sha256(&op, dest, src, len, digest));
+  CHECK_STATUS_OK(dma_wait(&op));
+  uint64_t dma_cycles = ibex_mcycle_read() - start;
+  CHECK_ARRAYS_EQ(dest, src, len);
+  CHECK_ARRAYS_EQ(digest, expected, kDigestWords);
+
+  LOG_INFO("hash %u bytes: hmac %u cycles, dma_memcpy_and_sha256 %u cycles",
+           (uint32_t)len, (uint32_t)hmac_cycles, (uint32_t)dma_cycles);
+}
+
+static void on_done(void *ctx, status_t result) {
+  CHECK_STATUS_OK(result);
+  ++*(uint32_t *)ctx;
+}
+
+static void sg_test(void) {
+  fill(src, kMaxSize, 0x5a);
+  memset(dest, 0, kMaxSize);
+  // Reverse the order of three blocks, one of which is unaligned.
+  const dma_sg_entry_t entries[] = {
+      {.dest = &dest[0], .src = &src[2048], .len = 2048},
+      {.dest = &dest[2048], .src = &src[1024], .len = 1024},
+      {.dest = &dest[3072], .src = &src[1], .len = 1023},
+  };
+  uint32_t calls = 0;
+  dma_op_t op = {.callback = on_done, .ctx = &calls};
+  CHECK_STATUS_OK(dma_memcpy_sg(&op, entries, ARRAYSIZE(entries)));
+  CHECK_STATUS_OK(dma_wait(&op));
+  CHECK(calls == 1, "callback ran %u times", calls);
+  for (size_t i = 0; i < ARRAYSIZE(entries); ++i) {
+    CHECK_ARRAYS_EQ((uint8_t *)entries[i].dest, (uint8_t *)entries[i].src,
+                    entries[i].len);
+  }
+}
+
+static void unaligned_test(void) {
+  enum { kLen = 257 };
+  fill(src, kLen + 1, 0x11);
+
+  uint32_t expected[kDigestWords];
+  CHECK_STATUS_OK(hmac_sha256(&src[1], kLen, expected));
+
+  // Unaligned copies use byte transfers; unaligned hashes run on the CPU.
+  dma_op_t op = {0};
+  CHECK_STATUS_OK(dma_memcpy(&op, &dest[3], &src[1], kLen));
+  CHECK_STATUS_OK(dma_wait(&op));
+  CHECK_ARRAYS_EQ(&dest[3], &src[1], kLen);
+
+  uint32_t digest[kDigestWords] = {0};
+  CHECK_STATUS_OK(
+      dma_memcpy_and_sha256(&op, &dest[3], &src[1], kLen, digest));
+  CHECK(op.done, "CPU fallback should complete synchronously");
+  CHECK_STATUS_OK(dma_wait(&op));
+  CHECK_ARRAYS_EQ(digest, expected, kDigestWords);
+}
+
+static void cpu_fallback_test(void) {
+  CHECK_STATUS_OK(dma_service_init(NULL, hmac_sha256));
+  fill(src, kMaxSize, 0x33);
+
+  uint32_t expected[kDigestWords];
+  CHECK_STATUS_OK(hmac_sha256(src, kMaxSize, expected));
+
+  uint32_t digest[kDigestWords] = {0};
+  dma_op_t op = {0};
+  CHECK_STATUS_OK(dma_memcpy_and_sha256(&op, dest, src, kMaxSize, digest));
+  CHECK(op.done, "CPU fallback should complete synchronously");
+  CHECK_ARRAYS_EQ(dest, src, kMaxSize);
+  CHECK_ARRAYS_EQ(digest, expected, kDigestWords);
+}
+
+bool test_main(void) {
+  CHECK_DIF_OK(dif_dma_init_from_dt(kDtDma, &dma));
+  CHECK_DIF_OK(dif_hmac_init_from_dt((dt_hmac_t)0, &hmac));
+  CHECK_DIF_OK(dif_dma_memory_range_set(&dma, TOP_DARJEELING_RAM_MAIN_BASE_ADDR,
+                                        TOP_DARJEELING_RAM_MAIN_SIZE_BYTES));
+  CHECK_STATUS_OK(dma_service_init(&dma, hmac_sha256));
+
+  for (size_t i = 0; i < ARRAYSIZE(kSizes); ++i) {
+    memcpy_perf(kSizes[i]);
+    sha256_perf(kSizes[i]);
+  }
+  sg_test();
+  unaligned_test();
+  cpu_fallback_test();
+  return true;
+}
@@ -25,6 +25,11 @@ pub struct VerilatorOpts {
     #[arg(long, required = false)]
     verilator_args: Vec<String>,
 
+    /// Let the simulation's TCP servers pick free ports, so that several
+    /// simulations can run side by side.
+    #[arg(long)]
+    verilator_ephemeral_ports: bool,
+
     /// Verilator startup timeout.
     #[arg(long, value_parser = parse_duration, default_value = "60s")]
     verilator_timeout: Duration,
@@ -37,6 +42,7 @@ pub fn create(args: &VerilatorOpts) -> Result<Box<dyn Transport>> {
         flash_images: args.verilator_flash.clone(),
         otp_image: args.verilator_otp.clone(),
         extra_args: args.verilator_args.clone(),
+        ephemeral_ports: args.verilator_ephemeral_ports,
         timeout: args.verilator_timeout,
     };
     Ok(Box::new(Verilator::from_options(options)?))
@@ -94,3 +94,90 @@ impl BootLog {
         digest[..] == buf[..Self::HASH_LEN]
     }
 }
+
+/// A single boot milestone recorded in the boot profile.
+#[derive(Debug, Default, Serialize, Annotate)]
+pub struct BootProfileEntry {
+    /// The milestone tag (e.g. 'RINI' for ROM initialization complete).
+    pub milestone: String,
+    /// The value of `mcycle` when the milestone was reached.
+    pub mcycle: u32,
+}
+
+/// The BootProfile records the cycle count at which the ROM and ROM_EXT
+/// reached each of their boot milestones.
+#[derive(Debug, Default, Serialize, Annotate)]
+pub struct BootProfile {
+    /// A tag that identifies this struct as the boot profile ('BPRF').
+    #[annotate(format=hex)]
+    pub identifier: u32,
+    /// The total number of milestones recorded.
+    pub count: u32,
+    /// The recorded milestones, oldest first.
+    pub entries: Vec<BootProfileEntry>,
+}
+
+impl TryFrom<&[u8]> for BootProfile {
+    type Error = ChipDataError;
+    fn try_from(buf: &[u8]) -> std::result::Result<Self, Self::Error> {
+        if buf.len() < Self::SIZE {
+            return Err(ChipDataError::BadSize(Self::SIZE, buf.len()));
+        }
+        let mut reader = std::io::Cursor::new(buf);
+        let mut val = BootProfile {
+            identifier: reader.read_u32::<LittleEndian>()?,
+            count: reader.read_u32::<LittleEndian>()?,
+            ..Default::default()
+        };
+        if val.identifier != Self::IDENTIFIER {
+            return Err(ChipDataError::BadIdentifier(val.identifier));
+        }
+        let mut raw = [0u32; Self::ENTRIES * 2];
+        reader.read_u32_into::<LittleEndian>(&mut raw)?;
+        // The entries form a ring buffer; once it has wrapped, the oldest
+        // entry is the one that would be overwritten next.
+        let count = val.count as usize;
+        let (first, len) = if count > Self::ENTRIES {
+            (count % Self::ENTRIES, Self::ENTRIES)
+        } else {
+            (0, count)
+        };
+        for i in 0..len {
+            let index = (first + i) % Self::ENTRIES;
+            let milestone = raw[index * 2].to_le_bytes();
+            val.entries.push(BootProfileEntry {
+                milestone: String::from_utf8_lossy(&milestone).into_owned(),
+                mcycle: raw[index * 2 + 1],
+            });
+        }
+        Ok(val)
+    }
+}
+
+impl BootProfile {
+    pub const SIZE: usize = 136;
+    const IDENTIFIER: u32 = 0x46525042;
+    const ENTRIES: usize = 16;
+}
+
+/// The boot profiles sent after the boot log by the rescue protocol.
+#[derive(Debug, Default, Serialize, Annotate)]
+pub struct BootProfiles {
+    /// The profile of the current boot, i.e. the one that entered rescue mode.
+    pub current: BootProfile,
+    /// The profile of the boot before the last reset, if the ROM kept it.
+    pub previous: Option<BootProfile>,
+}
+
+impl TryFrom<&[u8]> for BootProfiles {
+    type Error = ChipDataError;
+    fn try_from(buf: &[u8]) -> std::result::Result<Self, Self::Error> {
+        let current = BootProfile::try_from(buf)?;
+        // Older ROM_EXTs only send the current profile.
+        let previous = match buf.get(BootProfile::SIZE..) {
+            Some(prev) if !prev.is_empty() => Some(BootProfile::try_from(prev)?),
+            _ => None,
+        };
+        Ok(BootProfiles { current, previous })
+    }
+}
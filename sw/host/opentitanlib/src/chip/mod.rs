@@ -25,4 +25,6 @@ pub enum ChipDataError {
     BadSlot(boot_svc::BootSlot),
     #[error("invalid digest")]
     InvalidDigest,
+    #[error("bad identifier: {0:x}")]
+    BadIdentifier(u32),
 }
@@ -40,6 +40,7 @@ with_unknown! {
         GetOwnerPage1 = u32::from_be_bytes(*b"OPG1"),
         GetDeviceId = u32::from_be_bytes(*b"OTID"),
         Wait = u32::from_be_bytes(*b"WAIT"),
+        Windowed = u32::from_be_bytes(*b"WNDW"),
     }
 }
 
@@ -5,6 +5,7 @@
 use thiserror::Error;
 
 pub mod serial;
+pub mod window;
 pub mod xmodem;
 
 #[derive(Debug, Error)]
@@ -7,10 +7,11 @@ use std::rc::Rc;
 use std::time::Duration;
 
 use crate::app::TransportWrapper;
-use crate::chip::boot_log::BootLog;
+use crate::chip::boot_log::{BootLog, BootProfiles};
 use crate::chip::boot_svc::{BootSlot, BootSvc, OwnershipActivateRequest, OwnershipUnlockRequest};
 use crate::chip::device_id::DeviceId;
 use crate::io::uart::Uart;
+use crate::rescue::window::Window;
 use crate::rescue::xmodem::Xmodem;
 use crate::rescue::RescueError;
 use crate::uart::console::UartConsole;
@@ -19,6 +20,7 @@ pub struct RescueSerial {
     uart: Rc<dyn Uart>,
     reset_delay: Duration,
     enter_delay: Duration,
+    windowed: bool,
 }
 
 impl RescueSerial {
@@ -36,6 +38,7 @@ impl RescueSerial {
     pub const OT_ID: [u8; 4] = *b"OTID";
     pub const ERASE_OWNER: [u8; 4] = *b"KLBR";
     pub const WAIT: [u8; 4] = *b"WAIT";
+    pub const WINDOWED: [u8; 4] = *b"WNDW";
 
     const BAUD_115K: [u8; 4] = *b"115K";
     const BAUD_230K: [u8; 4] = *b"230K";
@@ -49,9 +52,18 @@ impl RescueSerial {
             uart,
             reset_delay: Duration::from_millis(50),
             enter_delay: Duration::from_secs(5),
+            windowed: false,
         }
     }
 
+    /// Use the windowed transfer instead of Xmodem-CRC for firmware uploads.
+    ///
+    /// Only ROM_EXTs that implement the `WNDW` mode accept it.
+    pub fn with_windowed(mut self, windowed: bool) -> Self {
+        self.windowed = windowed;
+        self
+    }
+
     pub fn enter(&self, transport: &TransportWrapper, reset_target: bool) -> Result<()> {
         log::info!("Setting serial break to trigger rescue mode.");
         self.uart.set_break(true)?;
@@ -127,13 +139,20 @@ impl RescueSerial {
     }
 
     pub fn update_firmware(&self, slot: BootSlot, image: &[u8]) -> Result<()> {
+        if self.windowed {
+            self.set_mode(Self::WINDOWED)?;
+        }
         self.set_mode(if slot == BootSlot::SlotB {
             Self::RESCUE_B
         } else {
             Self::RESCUE
         })?;
-        let xm = Xmodem::new();
-        xm.send(&*self.uart, image)?;
+        if self.windowed {
+            Window::new().send(&*self.uart, image)?;
+        } else {
+            let xm = Xmodem::new();
+            xm.send(&*self.uart, image)?;
+        }
         Ok(())
     }
 
@@ -150,6 +169,13 @@ impl RescueSerial {
         Ok(BootLog::try_from(blog.as_slice())?)
     }
 
+    pub fn get_boot_profile(&self) -> Result<BootProfiles> {
+        // The boot profiles are sent immediately after the boot log.
+        let blog = self.get_raw(Self::BOOT_LOG)?;
+        let profiles = blog.get(BootLog::SIZE..).unwrap_or_default();
+        Ok(BootProfiles::try_from(profiles)?)
+    }
+
     pub fn get_boot_svc(&self) -> Result<BootSvc> {
         let bsvc = self.get_raw(Self::BOOT_SVC_RSP)?;
         Ok(BootSvc::try_from(bsvc.as_slice())?)
@@ -0,0 +1,322 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+//! Sender for the rescue protocol's windowed firmware transfer.
+//!
+//! The host first sends a plan with a digest of every page of the image.  The
+//! device replies with the pages whose flash contents differ, and the host then
+//! streams only those pages, keeping up to the device's advertised credit of
+//! pages in flight so that the device can erase and program flash while the
+//! next page is on the wire.  See the "Windowed firmware transfer" section of
+//! `sw/device/silicon_creator/rom_ext/doc/rescue.md`.
+
+use anyhow::Result;
+use sha2::{Digest, Sha256};
+use std::time::Duration;
+use thiserror::Error;
+
+use crate::io::uart::Uart;
+
+#[derive(Debug, Error)]
+pub enum WindowError {
+    #[error("Cancelled")]
+    Cancelled,
+    #[error("Exhausted retries: {0}")]
+    ExhaustedRetries(usize),
+    #[error("Timed out waiting for {0}")]
+    Timeout(&'static str),
+    #[error("Bad plan reply: {0}")]
+    BadPlan(String),
+}
+
+/// Status report from the device.
+#[derive(Debug, Clone, Copy)]
+struct Status {
+    ack: bool,
+    next: usize,
+    credit: usize,
+}
+
+/// What the device sent while the host waited for a status report.
+enum Reply {
+    Status(Status),
+    /// The final acknowledgement after the end of the transfer.
+    Done,
+    Timeout,
+}
+
+#[derive(Debug)]
+pub struct Window {
+    /// Errors in a row, without the device making progress, before giving up.
+    pub max_errors: usize,
+    /// How long to wait for the device before retransmitting.
+    pub timeout: Duration,
+    /// How long to wait for the device to finish writing flash after the last
+    /// page.
+    pub finish_timeout: Duration,
+}
+
+impl Default for Window {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Window {
+    const START: u8 = b'W';
+    const PLAN: u8 = 0x01;
+    const DATA: u8 = 0x02;
+    const EOF: u8 = 0x04;
+    const ACK: u8 = 0x06;
+    const NAK: u8 = 0x15;
+    const STATUS: u8 = 0x16;
+    const CAN: u8 = 0x18;
+    const POLYNOMIAL: u16 = 0x1021;
+    const PAGE_SIZE: usize = 2048;
+    const DIGEST_SIZE: usize = 8;
+    /// Pages the device can buffer before it reports its credit.
+    const INITIAL_CREDIT: usize = 2;
+
+    pub fn new() -> Self {
+        Window {
+            max_errors: 16,
+            timeout: Duration::from_secs(3),
+            finish_timeout: Duration::from_secs(30),
+        }
+    }
+
+    fn crc16(crc: u16, buf: &[u8]) -> u16 {
+        let mut crc = crc;
+        for byte in buf {
+            crc ^= (*byte as u16) << 8;
+            for _bit in 0..8 {
+                let msb = crc & 0x8000 != 0;
+                crc <<= 1;
+                if msb {
+                    crc ^= Self::POLYNOMIAL;
+                }
+            }
+        }
+        crc
+    }
+
+    fn read_exact(&self, uart: &dyn Uart, buf: &mut [u8], what: &'static str) -> Result<()> {
+        let mut total = 0;
+        while total < buf.len() {
+            let n = uart.read_timeout(&mut buf[total..], self.timeout)?;
+            if n == 0 {
+                return Err(WindowError::Timeout(what).into());
+            }
+            total += n;
+        }
+        Ok(())
+    }
+
+    /// Sends `image` to the device, which must already be in the windowed
+    /// firmware rescue mode.
+    pub fn send(&self, uart: &dyn Uart, image: &[u8]) -> Result<()> {
+        let pages = image
+            .chunks(Self::PAGE_SIZE)
+            .map(|chunk| {
+                let mut page = chunk.to_vec();
+                page.resize(Self::PAGE_SIZE, 0xff);
+                page
+            })
+            .collect::<Vec<_>>();
+        self.send_start(uart)?;
+        let plan = self.send_plan(uart, image.len(), &pages)?;
+        log::info!(
+            "Sending {} of {} pages; the rest are unchanged.",
+            plan.len(),
+            pages.len()
+        );
+        self.send_pages(uart, &pages, &plan)
+    }
+
+    fn send_start(&self, uart: &dyn Uart) -> Result<()> {
+        let mut ch = 0u8;
+        let mut cancels = 0usize;
+        // Wait for the device to ask for a plan.
+        loop {
+            if uart.read_timeout(std::slice::from_mut(&mut ch), self.timeout)? == 0 {
+                return Err(WindowError::Timeout("start").into());
+            }
+            match ch {
+                Self::START => return Ok(()),
+                Self::CAN => {
+                    cancels += 1;
+                    if cancels >= 2 {
+                        return Err(WindowError::Cancelled.into());
+                    }
+                }
+                _ => {
+                    let p = ch as char;
+                    log::info!("Unknown byte received while waiting for start: {p:?} ({ch:#x?})");
+                }
+            }
+        }
+    }
+
+    /// Sends the plan and returns the indices of the pages the device needs.
+    fn send_plan(&self, uart: &dyn Uart, len: usize, pages: &[Vec<u8>]) -> Result<Vec<usize>> {
+        let mut frame = vec![Self::PLAN];
+        frame.extend_from_slice(&u32::try_from(len)?.to_le_bytes());
+        for page in pages {
+            frame.extend_from_slice(&Sha256::digest(page)[..Self::DIGEST_SIZE]);
+        }
+        let crc = Self::crc16(0, &frame[1..]);
+        frame.extend_from_slice(&crc.to_be_bytes());
+
+        let mut errors = 0usize;
+        let mut cancels = 0usize;
+        uart.write(&frame)?;
+        loop {
+            // The device hashes its flash before replying, which takes a while.
+            let mut ch = 0u8;
+            if uart.read_timeout(std::slice::from_mut(&mut ch), self.finish_timeout)? == 0 {
+                return Err(WindowError::Timeout("plan").into());
+            }
+            match ch {
+                Self::PLAN => break,
+                Self::NAK => {
+                    log::info!("Plan got NAK.  Retrying.");
+                    errors += 1;
+                    if errors >= self.max_errors {
+                        return Err(WindowError::ExhaustedRetries(errors).into());
+                    }
+                    uart.write(&frame)?;
+                }
+                Self::CAN => {
+                    cancels += 1;
+                    if cancels >= 2 {
+                        return Err(WindowError::Cancelled.into());
+                    }
+                }
+                // Start characters sent before the plan was seen.
+                _ => {}
+            }
+        }
+
+        let mut count = [0u8; 2];
+        self.read_exact(uart, &mut count, "plan")?;
+        let count = u16::from_le_bytes(count) as usize;
+        if count != pages.len() {
+            return Err(
+                WindowError::BadPlan(format!("{count} pages, expected {}", pages.len())).into(),
+            );
+        }
+        let mut bitmap = vec![0u8; count.div_ceil(8)];
+        let mut crc = [0u8; 2];
+        self.read_exact(uart, &mut bitmap, "plan")?;
+        self.read_exact(uart, &mut crc, "plan")?;
+        let expected = Self::crc16(Self::crc16(0, &(count as u16).to_le_bytes()), &bitmap);
+        if u16::from_be_bytes(crc) != expected {
+            return Err(WindowError::BadPlan("bad CRC".into()).into());
+        }
+        Ok((0..count)
+            .filter(|i| bitmap[i / 8] & (1 << (i % 8)) != 0)
+            .collect())
+    }
+
+    fn data_frame(index: usize, page: &[u8]) -> Vec<u8> {
+        let mut frame = Vec::with_capacity(5 + page.len());
+        frame.push(Self::DATA);
+        frame.extend_from_slice(&(index as u16).to_le_bytes());
+        frame.extend_from_slice(page);
+        let crc = Self::crc16(0, &frame[1..]);
+        frame.extend_from_slice(&crc.to_be_bytes());
+        frame
+    }
+
+    /// Reads the next status report.
+    fn read_status(&self, uart: &dyn Uart, eof_sent: bool) -> Result<Reply> {
+        let timeout = if eof_sent {
+            self.finish_timeout
+        } else {
+            self.timeout
+        };
+        let mut cancels = 0usize;
+        loop {
+            let mut ch = 0u8;
+            if uart.read_timeout(std::slice::from_mut(&mut ch), timeout)? == 0 {
+                return Ok(Reply::Timeout);
+            }
+            match ch {
+                Self::STATUS => {
+                    let mut buf = [0u8; 4];
+                    self.read_exact(uart, &mut buf, "status")?;
+                    return Ok(Reply::Status(Status {
+                        ack: buf[0] == 0,
+                        next: u16::from_le_bytes([buf[1], buf[2]]) as usize,
+                        credit: buf[3] as usize,
+                    }));
+                }
+                Self::ACK if eof_sent => return Ok(Reply::Done),
+                Self::CAN => {
+                    cancels += 1;
+                    if cancels >= 2 {
+                        return Err(WindowError::Cancelled.into());
+                    }
+                }
+                _ => log::info!("Expected status. Got {ch:#x}."),
+            }
+        }
+    }
+
+    fn send_pages(&self, uart: &dyn Uart, pages: &[Vec<u8>], plan: &[usize]) -> Result<()> {
+        // Positions in `plan` of the next page the device expects and of the
+        // next page to send.
+        let mut acked = 0usize;
+        let mut sent = 0usize;
+        let mut credit = Self::INITIAL_CREDIT;
+        let mut last = None;
+        let mut errors = 0usize;
+        let mut eof_sent = false;
+        loop {
+            while sent < plan.len() && sent < acked + credit {
+                log::info!("Sending page {}", plan[sent]);
+                uart.write(&Self::data_frame(plan[sent], &pages[plan[sent]]))?;
+                sent += 1;
+            }
+            if acked == plan.len() && !eof_sent {
+                uart.write(&[Self::EOF])?;
+                eof_sent = true;
+            }
+
+            let status = match self.read_status(uart, eof_sent)? {
+                Reply::Status(status) => status,
+                Reply::Done => return Ok(()),
+                Reply::Timeout => {
+                    log::info!("Timed out waiting for status.  Retrying.");
+                    errors += 1;
+                    sent = acked;
+                    eof_sent = false;
+                    if errors >= self.max_errors {
+                        return Err(WindowError::ExhaustedRetries(errors).into());
+                    }
+                    continue;
+                }
+            };
+            let progress = plan.partition_point(|&page| page < status.next);
+            if progress > acked {
+                errors = 0;
+            }
+            // A repeated status means the device has heard nothing since, so
+            // anything still in flight was lost.
+            let stalled = last == Some((status.next, status.credit)) && sent > progress;
+            if !status.ack || stalled {
+                log::info!("Resending from page {}.", status.next);
+                errors += 1;
+                sent = progress;
+                eof_sent = false;
+                if errors >= self.max_errors {
+                    return Err(WindowError::ExhaustedRetries(errors).into());
+                }
+            }
+            acked = progress;
+            credit = status.credit;
+            last = Some((status.next, status.credit));
+        }
+    }
+}
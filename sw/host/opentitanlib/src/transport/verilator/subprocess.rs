@@ -5,7 +5,9 @@
 use anyhow::{anyhow, ensure, Result};
 use regex::Regex;
 use std::io::ErrorKind;
+use std::path::PathBuf;
 use std::process::{Child, Command, Stdio};
+use std::sync::atomic::{AtomicUsize, Ordering};
 use std::sync::{Arc, Mutex};
 use std::time::{Duration, Instant};
 
@@ -23,6 +25,9 @@ pub struct Options {
     pub otp_image: String,
     /// Any extra arguments to verilator.
     pub extra_args: Vec<String>,
+    /// Have the simulation's TCP servers listen on ports picked by the kernel,
+    /// so that several simulations can run side by side.
+    pub ephemeral_ports: bool,
     /// Timeout for starting verilator.
     pub timeout: Duration,
 }
@@ -30,9 +35,14 @@ pub struct Options {
 pub struct Subprocess {
     child: Child,
     accumulated_output: Arc<Mutex<String>>,
+    rendezvous: PathBuf,
 }
 
 impl Subprocess {
+    /// Environment variable through which the DPI models find the rendezvous
+    /// file; see `hw/dv/dpi/common/tcp_server/tcp_server.h`.
+    const RENDEZVOUS_ENV: &'static str = "DPI_RENDEZVOUS_FILE";
+
     /// Starts a verilator [`Subprocess`] based on [`Options`].
     pub fn from_options(options: Options) -> Result<Self> {
         let mut command = Command::new(&options.executable);
@@ -56,9 +66,26 @@ impl Subprocess {
         if !options.otp_image.is_empty() {
             args.push(format!("--meminit=otp,{}", options.otp_image));
         }
+        if options.ephemeral_ports {
+            args.push("+dmidpi_port=0".to_owned());
+            args.push("+jtagdpi_port=0".to_owned());
+        }
         args.extend_from_slice(&options.extra_args);
         command.args(&args[..]);
 
+        // The DPI models record the ports they listen on in this file.
+        static COUNT: AtomicUsize = AtomicUsize::new(0);
+        let rendezvous = std::env::temp_dir().join(format!(
+            "verilator-{}-{}.rendezvous",
+            std::process::id(),
+            COUNT.fetch_add(1, Ordering::Relaxed)
+        ));
+        match std::fs::remove_file(&rendezvous) {
+            Err(error) if error.kind() != ErrorKind::NotFound => return Err(error.into()),
+            _ => {}
+        }
+        command.env(Self::RENDEZVOUS_ENV, &rendezvous);
+
         log::info!("CWD: {:?}", std::env::current_dir());
         log::info!(
             "Spawning verilator: {:?} {:?}",
@@ -81,6 +108,7 @@ impl Subprocess {
         Ok(Subprocess {
             child,
             accumulated_output: accumulator,
+            rendezvous,
         })
     }
 
@@ -110,6 +138,24 @@ impl Subprocess {
         Err(anyhow!("Timed out"))
     }
 
+    /// Finds the port that the simulation's TCP server `name` listens on.
+    pub fn tcp_port(&self, name: &str, deadline: Instant) -> Result<u16> {
+        while deadline > Instant::now() {
+            // Each line of the rendezvous file is "tcp <name> <port>".
+            if let Ok(contents) = std::fs::read_to_string(&self.rendezvous) {
+                for line in contents.lines() {
+                    if let ["tcp", n, port] = line.split(' ').collect::<Vec<_>>()[..] {
+                        if n == name {
+                            return Ok(port.parse()?);
+                        }
+                    }
+                }
+            }
+            std::thread::sleep(Duration::from_millis(50));
+        }
+        Err(anyhow!("Timed out"))
+    }
+
     /// Kill the verilator subprocess.
     pub fn kill(&mut self) -> Result<()> {
         match self.child.kill() {
@@ -119,6 +165,12 @@ impl Subprocess {
     }
 }
 
+impl Drop for Subprocess {
+    fn drop(&mut self) {
+        let _ = std::fs::remove_file(&self.rendezvous);
+    }
+}
+
 #[cfg(test)]
 mod test {
     use super::*;
@@ -130,6 +182,7 @@ mod test {
             flash_images: vec!["/dev/null:1".to_owned()],
             otp_image: "".to_owned(),
             extra_args: vec!["abc 123 def 456".to_owned()],
+            ephemeral_ports: false,
             timeout: Duration::from_secs(5),
         };
         Subprocess::from_options(options)
@@ -145,6 +198,26 @@ mod test {
         Ok(())
     }
 
+    #[test]
+    fn test_tcp_port() -> Result<()> {
+        let options = Options {
+            executable: "/bin/sh".to_owned(),
+            rom_image: "".to_owned(),
+            flash_images: vec![],
+            otp_image: "".to_owned(),
+            extra_args: vec![
+                "-c".to_owned(),
+                "printf 'tcp jtag0 1\\ntcp dmi0 45197\\n' >> \"$DPI_RENDEZVOUS_FILE\"".to_owned(),
+            ],
+            ephemeral_ports: false,
+            timeout: Duration::from_secs(5),
+        };
+        let subprocess = Subprocess::from_options(options)?;
+        let deadline = Instant::now() + Duration::from_secs(5);
+        assert_eq!(subprocess.tcp_port("dmi0", deadline)?, 45197);
+        Ok(())
+    }
+
     #[test]
     fn test_kill() -> Result<()> {
         let mut subprocess = echo_subprocess()?;
@@ -11,7 +11,9 @@ use std::cell::RefCell;
 use std::rc::Rc;
 use std::time::{Duration, Instant};
 
+use crate::debug::openocd::OpenOcdJtagChain;
 use crate::io::gpio::{GpioError, GpioPin};
+use crate::io::jtag::{JtagChain, JtagParams};
 use crate::io::uart::Uart;
 use crate::transport::common::uart::SerialPortUart;
 use crate::transport::verilator::gpio::{GpioInner, VerilatorGpioPin};
@@ -23,6 +25,10 @@ use crate::util::parse_int::ParseInt;
 
 const UART_BAUD: u32 = 40;
 
+/// Port that the simulated JTAG interface listens on unless the simulation
+/// was asked to pick one; see `util/openocd/interface/sim-jtagdpi.cfg`.
+const DEFAULT_JTAG_PORT: u16 = 44853;
+
 pub(crate) struct Inner {
     uart: Option<Rc<dyn Uart>>,
     pub gpio: GpioInner,
@@ -35,6 +41,9 @@ pub struct Verilator {
     pub spi_file: String,
     pub gpio_read_file: String,
     pub gpio_write_file: String,
+    /// Port of the simulated JTAG interface, if the simulation was asked to
+    /// pick it. Otherwise the interface listens on `DEFAULT_JTAG_PORT`.
+    pub jtag_port: Option<u16>,
 
     inner: Rc<RefCell<Inner>>,
 }
@@ -54,11 +63,17 @@ impl Verilator {
         });
 
         let deadline = Instant::now() + options.timeout;
+        let ephemeral_ports = options.ephemeral_ports;
         let subprocess = Subprocess::from_options(options)?;
         let gpio_rd = subprocess.find(&GPIO_RD, deadline)?;
         let gpio_wr = subprocess.find(&GPIO_WR, deadline)?;
         let uart = subprocess.find(&UART, deadline)?;
         let spi = subprocess.find(&SPI, deadline)?;
+        let jtag_port = if ephemeral_ports {
+            Some(subprocess.tcp_port("dmi0", deadline)?)
+        } else {
+            None
+        };
 
         log::info!("Verilator started with the following interfaces:");
         log::info!("gpio_read = {}", gpio_rd);
@@ -66,6 +81,9 @@ impl Verilator {
         let gpio = GpioInner::new(&gpio_rd, &gpio_wr)?;
         log::info!("uart = {}", uart);
         log::info!("spi = {}", spi);
+        if let Some(port) = jtag_port {
+            log::info!("jtag port = {}", port);
+        }
 
         Ok(Verilator {
             subprocess: Some(subprocess),
@@ -73,6 +91,7 @@ impl Verilator {
             spi_file: spi,
             gpio_read_file: gpio_rd,
             gpio_write_file: gpio_wr,
+            jtag_port,
             inner: Rc::new(RefCell::new(Inner { uart: None, gpio })),
         })
     }
@@ -95,7 +114,21 @@ impl Drop for Verilator {
 
 impl Transport for Verilator {
     fn capabilities(&self) -> Result<Capabilities> {
-        Ok(Capabilities::new(Capability::UART | Capability::GPIO))
+        Ok(Capabilities::new(
+            Capability::UART | Capability::GPIO | Capability::JTAG,
+        ))
+    }
+
+    fn jtag(&self, opts: &JtagParams) -> Result<Box<dyn JtagChain + '_>> {
+        // The simulation speaks OpenOCD's remote_bitbang protocol.
+        let port = self.jtag_port.unwrap_or(DEFAULT_JTAG_PORT);
+        Ok(Box::new(OpenOcdJtagChain::new(
+            &format!(
+                "adapter driver remote_bitbang; remote_bitbang_port {port}; \
+                 remote_bitbang_host localhost;"
+            ),
+            opts,
+        )?))
     }
 
     fn uart(&self, instance: &str) -> Result<Rc<dyn Uart>> {
@@ -69,3 +69,64 @@ where
     }
     deserializer.deserialize_any(StringOrStruct(PhantomData))
 }
+
+/// Serialize a byte container as a single hex string.
+///
+/// For use with `#[serde(with = "opentitanlib::util::serde::hex_bytes")]` on
+/// fields such as `ArrayVec<u8, N>`.  This is the encoding used by ujson
+/// fields declared with the `ujson_hex_t` type.
+pub mod hex_bytes {
+    use serde::{de, Deserialize, Deserializer, Serializer};
+
+    pub fn serialize<T, S>(bytes: &T, serializer: S) -> Result<S::Ok, S::Error>
+    where
+        T: AsRef<[u8]>,
+        S: Serializer,
+    {
+        serializer.serialize_str(&hex::encode(bytes))
+    }
+
+    pub fn deserialize<'de, T, D>(deserializer: D) -> Result<T, D::Error>
+    where
+        T: for<'a> TryFrom<&'a [u8]>,
+        D: Deserializer<'de>,
+    {
+        let s = String::deserialize(deserializer)?;
+        let bytes = hex::decode(s).map_err(de::Error::custom)?;
+        T::try_from(&bytes)
+            .map_err(|_| de::Error::invalid_length(bytes.len(), &"a shorter byte string"))
+    }
+}
+
+/// Serialize a byte container as a single padded base64 string.
+///
+/// For use with `#[serde(with = "opentitanlib::util::serde::base64_bytes")]`
+/// on fields such as `ArrayVec<u8, N>`.  This is the encoding used by ujson
+/// fields declared with the `ujson_base64_t` type.
+pub mod base64_bytes {
+    use base64ct::{Base64, Encoding};
+    use serde::{de, ser, Deserialize, Deserializer, Serializer};
+
+    pub fn serialize<T, S>(bytes: &T, serializer: S) -> Result<S::Ok, S::Error>
+    where
+        T: AsRef<[u8]>,
+        S: Serializer,
+    {
+        let bytes = bytes.as_ref();
+        let mut buf = vec![0u8; Base64::encoded_len(bytes)];
+        let s = Base64::encode(bytes, &mut buf).map_err(ser::Error::custom)?;
+        serializer.serialize_str(s)
+    }
+
+    pub fn deserialize<'de, T, D>(deserializer: D) -> Result<T, D::Error>
+    where
+        T: for<'a> TryFrom<&'a [u8]>,
+        D: Deserializer<'de>,
+    {
+        let s = String::deserialize(deserializer)?;
+        let mut buf = vec![0u8; s.len() / 4 * 3 + 3];
+        let bytes = Base64::decode(&s, &mut buf).map_err(de::Error::custom)?;
+        T::try_from(bytes)
+            .map_err(|_| de::Error::invalid_length(bytes.len(), &"a shorter byte string"))
+    }
+}
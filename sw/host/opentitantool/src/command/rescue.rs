@@ -62,6 +62,12 @@ pub struct Firmware {
         help = "Reset the target to enter rescue mode"
     )]
     reset_target: bool,
+    #[arg(
+        long,
+        default_value_t = false,
+        help = "Only send changed pages, using the windowed transfer protocol"
+    )]
+    windowed: bool,
     #[arg(value_name = "FILE")]
     filename: PathBuf,
 }
@@ -92,7 +98,7 @@ impl CommandDispatch for Firmware {
         };
         let uart = self.params.create(transport)?;
         let mut prev_baudrate = 0u32;
-        let rescue = RescueSerial::new(Rc::clone(&uart));
+        let rescue = RescueSerial::new(Rc::clone(&uart)).with_windowed(self.windowed);
         rescue.enter(transport, self.reset_target)?;
         if let Some(rate) = self.rate {
             prev_baudrate = uart.get_baudrate()?;
@@ -152,6 +158,33 @@ impl CommandDispatch for GetBootLog {
     }
 }
 
+#[derive(Debug, Args)]
+pub struct GetBootProfile {
+    #[command(flatten)]
+    params: UartParams,
+    #[arg(
+        long,
+        default_value_t = true,
+        action = clap::ArgAction::Set,
+        help = "Reset the target to enter rescue mode"
+    )]
+    reset_target: bool,
+}
+
+impl CommandDispatch for GetBootProfile {
+    fn run(
+        &self,
+        _context: &dyn Any,
+        transport: &TransportWrapper,
+    ) -> Result<Option<Box<dyn Annotate>>> {
+        let uart = self.params.create(transport)?;
+        let rescue = RescueSerial::new(uart);
+        rescue.enter(transport, self.reset_target)?;
+        let data = rescue.get_boot_profile()?;
+        Ok(Some(Box::new(data)))
+    }
+}
+
 #[derive(Debug, Args)]
 pub struct GetBootSvc {
     #[command(flatten)]
@@ -502,6 +535,7 @@ pub enum RescueCommand {
     BootSvc(BootSvcCommand),
     EraseOwner(EraseOwner),
     GetBootLog(GetBootLog),
+    GetBootProfile(GetBootProfile),
     GetDeviceId(GetDeviceId),
     Firmware(Firmware),
     SetOwnerConfig(SetOwnerConfig),
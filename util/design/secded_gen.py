@@ -40,22 +40,44 @@ COPYRIGHT = """// Copyright lowRISC contributors (OpenTitan project).
 C_SRC_TOP = """
 #include "secded_enc.h"
 
-#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
-// Calculates even parity for a 64-bit word
-static uint8_t calc_parity(uint64_t word, bool invert) {
-  bool parity = false;
+// The check bits are computed a byte at a time: entry [i][b] of an encode
+// table holds the check bits contributed by value `b` in byte `i` of the data
+// word. The codes are linear, so the check bits of a word are the XOR of the
+// contributions of its bytes. Inverted codes share the tables of the plain
+// codes and XOR a constant into the result, as the RTL does.
+static inline uint8_t encode(const uint8_t (*table)[256], const uint8_t *bytes,
+                             size_t len) {
+  uint8_t ecc = 0;
+  for (size_t i = 0; i < len; ++i) {
+    ecc ^= table[i][bytes[i]];
+  }
+  return ecc;
+}
 
-  while (word) {
-    if (word & 1) {
-      parity = !parity;
+// Flips the data bit whose column of the parity check matrix matches
+// `syndrome`, if there is one.
+static void correct(uint8_t *bytes, uint8_t syndrome, const uint8_t *columns,
+                    size_t k) {
+  for (size_t i = 0; i < k; ++i) {
+    if (columns[i] == syndrome) {
+      bytes[i / 8] ^= (uint8_t)(1 << (i % 8));
+      return;
     }
-
-    word >>= 1;
   }
+}
 
-  return parity ^ invert;
+// Error flags for a non-zero Hsiao syndrome: odd weight is a single error.
+static inline uint8_t hsiao_err(uint8_t syndrome) {
+  return __builtin_parity(syndrome) ? 1 : 2;
+}
+
+// Error flags for a non-zero Hamming syndrome of `m` bits: the last bit is
+// the overall parity.
+static inline uint8_t hamming_err(uint8_t syndrome, unsigned m) {
+  return (syndrome >> (m - 1)) & 1 ? 1 : 2;
 }
 """
 
@@ -63,15 +85,24 @@ C_H_TOP = """
 #ifndef OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 #define OPENTITAN_HW_IP_PRIM_DV_PRIM_SECDED_SECDED_ENC_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif  // __cplusplus
 
-// Integrity encode functions for varying bit widths matching the functionality
-// of the RTL modules of the same name. Each takes an array of bytes in
-// little-endian order and returns the calculated integrity bits.
+// Integrity functions for varying bit widths matching the functionality of the
+// RTL modules of the same name. Each data word is an array of bytes in
+// little-endian order.
+//
+// - `enc_*` returns the calculated integrity bits.
+// - `dec_*` corrects a single-bit error in `bytes` in place and returns the
+//   RTL `err_o` value: bit 0 flags a single (corrected) error and bit 1 an
+//   uncorrectable error.
+// - `*_buf` process `count` consecutive data words and integrity bytes. The
+//   decoder returns the OR of every word's `err_o` and, if `err` is not NULL,
+//   stores each of them there.
 
 """
 
@@ -664,6 +695,7 @@ def generate(cfgs, args):
         f.write(f"// util/design/secded_gen.py from {SECDED_CFG_FILE}\n")
         f.write(C_H_TOP)
 
+    c_tables = set()
     for cfg in cfgs['cfgs']:
         log.debug("Working on {}".format(cfg))
         k = cfg['k']
@@ -676,10 +708,19 @@ def generate(cfgs, args):
         # write out rtl files
         write_enc_dec_files(n, k, m, codes, suffix, args.outdir, codetype)
 
-        # write out C files, only hsiao codes are supported
-        if codetype in ["hsiao", "inv_hsiao"]:
-            write_c_files(n, k, m, codes, suffix, c_src_filename, c_h_filename,
-                          codetype)
+        # write out C files; inverted codes share the tables of the plain
+        # code of the same size.
+        if m > 8:
+            log.warning(f"Cannot generate C encoder for m = {m}."
+                        " The tool has no support for m > 8 for C encoder "
+                        "generation")
+        else:
+            table_key = (k, m, codetype.replace("inv_", ""))
+            if table_key not in c_tables:
+                c_tables.add(table_key)
+                write_c_tables(k, m, codes, codetype, c_src_filename)
+            write_c_files(n, k, m, codes, suffix, c_src_filename,
+                          c_h_filename, codetype)
 
         # write out all-zero word values for all codes
         pkg_type_str += print_pkg_allzero(n, k, m, codes, suffix, codetype)
@@ -845,65 +886,145 @@ def write_inc_file(outdir, inc_str):
         f.write(outstr)
 
 
-def bytes_to_c_type(num_bytes):
-    if num_bytes == 1:
-        return 'uint8_t'
-    elif num_bytes <= 2:
-        return 'uint16_t'
-    elif num_bytes <= 4:
-        return 'uint32_t'
-    elif num_bytes <= 8:
-        return 'uint64_t'
+def c_wrap_call(prefix, args, suffix):
+    """Formats `prefix(args...)suffix` as clang-format would.
 
-    return None
+    Arguments are bin-packed and aligned after the open parenthesis, so the
+    generated code stays stable when clang-format is not available.
+    """
+    cont = " " * (len(prefix) + 1)
+    lines = [prefix + "("]
+    for i, arg in enumerate(args):
+        last = i + 1 == len(args)
+        piece = arg + (")" + suffix if last else ",")
+        if len(lines[-1]) + len(piece) > 80:
+            lines.append(cont)
+        lines[-1] += piece + ("" if last else " ")
+    return "\n".join(line.rstrip() for line in lines) + "\n"
+
+
+def c_byte_table(name, rows):
+    """Formats a `uint8_t [len(rows)][256]` initializer."""
+    out = f"static const uint8_t {name}[{len(rows)}][256] = {{\n"
+    for row in rows:
+        vals = [f"0x{v:02x}" for v in row]
+        chunks = [vals[i:i + 12] for i in range(0, len(vals), 12)]
+        lines = [", ".join(chunk) for chunk in chunks]
+        out += "    {" + ",\n     ".join(lines) + "},\n"
+    out += "};\n"
+    return out
+
+
+def c_hex_array(name, vals):
+    """Formats a one-dimensional `uint8_t` initializer."""
+    vals = [f"0x{v:02x}" for v in vals]
+    out = f"static const uint8_t {name}[{len(vals)}] = {{\n"
+    for i in range(0, len(vals), 12):
+        out += "    " + ", ".join(vals[i:i + 12]) + ",\n"
+    out += "};\n"
+    return out
+
+
+def rtl_encode(k, m, codes, dataword):
+    """Computes the check bits of `dataword` as the RTL encoder does.
+
+    The check bits are computed in order over the partially encoded word, so
+    that Hamming codes, whose last check bit also covers the others, come out
+    right. Inversion is not applied.
+    """
+    word = dataword
+    for j, mask in enumerate(calc_bitmasks(k, m, codes, False)):
+        word |= (bin(word & mask).count("1") & 1) << (k + j)
+    return word >> k
 
 
-def write_c_files(n, k, m, codes, suffix, c_src_filename, c_h_filename,
-                  codetype):
+def write_c_tables(k, m, codes, codetype, c_src_filename):
+    """Writes the encode and syndrome tables shared by a code and its
+    inverted variant."""
     in_bytes = math.ceil(k / 8)
-    out_bytes = math.ceil(m / 8)
-
-    if (k > 64):
-        log.warning(f"Cannot generate C encoder for k = {k}."
-                    " The tool has no support for k > 64 for C encoder "
-                    "generation")
-        return
+    base = "Hamming" if codetype in ["hamming", "inv_hamming"] else "Hsiao"
+    n = k + m
+    rows = []
+    for i in range(in_bytes):
+        rows.append([rtl_encode(k, m, codes, (b << (8 * i)) & ((1 << k) - 1))
+                     for b in range(256)])
+    with open(c_src_filename, "a") as f:
+        f.write("\n")
+        f.write(c_byte_table(f"kEnc{base}{n}_{k}", rows))
+        f.write("\n")
+        f.write(c_hex_array(f"kCols{base}{n}_{k}",
+                            [calc_syndrome(codes[i]) for i in range(k)]))
 
-    in_type = bytes_to_c_type(in_bytes)
-    out_type = bytes_to_c_type(out_bytes)
 
-    assert in_type
-    assert out_type
-    assert codetype in ["hsiao", "inv_hsiao"]
-    invert = (codetype == "inv_hsiao")
+def write_c_files(n, k, m, codes, suffix, c_src_filename, c_h_filename,
+                  codetype):
+    in_bytes = math.ceil(k / 8)
+    hamming = codetype in ["hamming", "inv_hamming"]
+    base = "Hamming" if hamming else "Hsiao"
+    table = f"kEnc{base}{n}_{k}"
+    cols = f"kCols{base}{n}_{k}"
+    # Selectively invert parity bits (see print_enc function).
+    inv_mask = 0
+    if codetype in ["inv_hsiao", "inv_hamming"]:
+        for j in range(m):
+            inv_mask += (j % 2) << j
+    name = f"secded{suffix}_{n}_{k}"
+
+    src = "\n"
+    src += f"uint8_t enc_{name}(const uint8_t bytes[{in_bytes}]) {{\n"
+    if inv_mask:
+        src += (f"  return encode({table}, bytes, {in_bytes}) ^ "
+                f"0x{inv_mask:x};\n")
+    else:
+        src += f"  return encode({table}, bytes, {in_bytes});\n"
+    src += "}\n\n"
+
+    src += f"uint8_t dec_{name}(uint8_t bytes[{in_bytes}], uint8_t ecc) {{\n"
+    src += f"  uint8_t syndrome = enc_{name}(bytes) ^ ecc;\n"
+    src += "  if (syndrome == 0) {\n    return 0;\n  }\n"
+    if hamming:
+        low_mask = (1 << (m - 1)) - 1
+        src += ("  // The last check bit also covers the other check bits.\n")
+        src += (f"  syndrome ^= (uint8_t)(__builtin_parity(syndrome & "
+                f"0x{low_mask:x}) << {m - 1});\n")
+    src += f"  correct(bytes, syndrome, {cols}, {k});\n"
+    if hamming:
+        src += f"  return hamming_err(syndrome, {m});\n"
+    else:
+        src += "  return hsiao_err(syndrome);\n"
+    src += "}\n\n"
+
+    src += c_wrap_call(f"void enc_{name}_buf",
+                       ["const uint8_t *data", "uint8_t *ecc", "size_t count"],
+                       " {")
+    src += "  for (size_t i = 0; i < count; ++i) {\n"
+    src += f"    ecc[i] = enc_{name}(&data[{in_bytes} * i]);\n"
+    src += "  }\n}\n\n"
+
+    src += c_wrap_call(f"uint8_t dec_{name}_buf",
+                       ["uint8_t *data", "const uint8_t *ecc", "size_t count",
+                        "uint8_t *err"],
+                       " {")
+    src += "  uint8_t all = 0;\n"
+    src += "  for (size_t i = 0; i < count; ++i) {\n"
+    src += f"    uint8_t word_err = dec_{name}(&data[{in_bytes} * i], ecc[i]);\n"
+    src += "    if (err != NULL) {\n      err[i] = word_err;\n    }\n"
+    src += "    all |= word_err;\n"
+    src += "  }\n  return all;\n}\n"
 
     with open(c_src_filename, "a") as f:
-        # Write out function prototype in src
-        f.write(f"\n{out_type} enc_secded{suffix}_{n}_{k}"
-                f"(const uint8_t bytes[{in_bytes}]) {{\n")
-
-        # Form a single word from the incoming byte data
-        f.write(f"{in_type} word = ")
-        f.write(" | ".join(
-                [f"(({in_type})bytes[{i}] << {i*8})" for i in range(in_bytes)]))
-        f.write(";\n\n")
-
-        # AND the word with the codes, calculating parity of each and combine
-        # into a single word of integrity bits
-        f.write("return ")
-        parity_bit_masks = enumerate(calc_bitmasks(k, m, codes, False))
-        # Add ECC bit inversion if needed (see print_enc function).
-        f.write(" | ".join(
-                [f"(calc_parity(word & 0x{mask:x}, "
-                 f"{'true' if invert and (par_bit % 2) else 'false'}) << {par_bit})"
-                 for par_bit, mask in parity_bit_masks]))
-
-        f.write(";\n}\n")
+        f.write(src)
 
     with open(c_h_filename, "a") as f:
-        # Write out function declaration in header
-        f.write(f"{out_type} enc_secded{suffix}_{n}_{k}"
-                f"(const uint8_t bytes[{in_bytes}]);\n")
+        # Write out function declarations in header
+        f.write(f"uint8_t enc_{name}(const uint8_t bytes[{in_bytes}]);\n")
+        f.write(f"uint8_t dec_{name}(uint8_t bytes[{in_bytes}], uint8_t ecc);\n")
+        f.write(c_wrap_call(f"void enc_{name}_buf",
+                            ["const uint8_t *data", "uint8_t *ecc",
+                             "size_t count"], ";"))
+        f.write(c_wrap_call(f"uint8_t dec_{name}_buf",
+                            ["uint8_t *data", "const uint8_t *ecc",
+                             "size_t count", "uint8_t *err"], ";"))
 
 
 def format_c_files(c_src_filename, c_h_filename):